@@ -339,6 +339,7 @@ async def _build_dimmer(config):
     cg.add(var.set_ramp_time_ms(config[CONF_RAMP_TIME].total_milliseconds))
     cg.add(var.set_min_brightness(config[CONF_MIN_BRIGHTNESS]))
     cg.add(var.set_max_brightness(config[CONF_MAX_BRIGHTNESS]))
+    cg.add_define("USE_CFX_DIMMER")
     await _add_lights(var, config, _segment_light_ids())
     return var
 
@@ -99,6 +99,7 @@ void CFXDimmer::finalize_release_(DimmerReleaseAction action,
   this->ramp_start_brightness_.clear();
   this->ramp_durations_ms_.clear();
   this->ramp_manual_.clear();
+  this->clear_ramp_previews_();
   this->gesture_.reset();
 
   if (action == DimmerReleaseAction::TURN_OFF) {
@@ -123,6 +124,7 @@ void CFXDimmer::finalize_directional_release_(uint32_t released_at_ms) {
   this->ramp_start_brightness_.clear();
   this->ramp_durations_ms_.clear();
   this->ramp_manual_.clear();
+  this->clear_ramp_previews_();
   this->gesture_.reset();
 }
 
@@ -258,6 +260,7 @@ void CFXDimmer::finish_ramp_() {
   for (auto *state : this->lights_) {
     this->apply_brightness_(state, target, 0);
   }
+  this->clear_ramp_previews_();
   this->ramp_start_brightness_.clear();
   this->ramp_durations_ms_.clear();
   this->ramp_manual_.clear();
@@ -314,6 +317,7 @@ void CFXDimmer::freeze_ramp_(uint32_t now) {
     publish_light_ramp_duration_hint(state, 0);
     this->apply_brightness_(state, frozen_brightness[i], 0);
   }
+  this->clear_ramp_previews_();
   this->ramping_ = false;
   this->ramp_finished_ = true;
   this->ramp_start_brightness_.clear();
@@ -322,17 +326,32 @@ void CFXDimmer::freeze_ramp_(uint32_t now) {
 }
 
 void CFXDimmer::service_manual_ramp_(uint32_t now) {
-  if (this->last_ramp_update_ms_ != 0 &&
-      (now - this->last_ramp_update_ms_) < RAMP_UPDATE_INTERVAL_MS) {
-    return;
+  // The running effect reads the preview on its next frame without going
+  // through LightCall validation, listeners or a sync send. The zero
+  // transition commit keeps remote_values, HA and followers roughly in step.
+  const bool commit =
+      this->last_ramp_update_ms_ == 0 ||
+      (now - this->last_ramp_update_ms_) >= RAMP_COMMIT_INTERVAL_MS;
+  if (commit) {
+    this->last_ramp_update_ms_ = now;
   }
-  this->last_ramp_update_ms_ = now;
   for (size_t i = 0; i < this->lights_.size(); i++) {
     if (i >= this->ramp_manual_.size() || !this->ramp_manual_[i]) {
       continue;
     }
-    this->apply_brightness_(this->lights_[i],
-                            this->ramp_current_brightness_(i, now), 0);
+    publish_light_preview_brightness(this->lights_[i],
+                                     this->ramp_current_brightness_(i, now),
+                                     now + RAMP_PREVIEW_HOLD_MS);
+    if (commit) {
+      this->apply_brightness_(this->lights_[i],
+                              this->ramp_current_brightness_(i, now), 0);
+    }
+  }
+}
+
+void CFXDimmer::clear_ramp_previews_() {
+  for (auto *state : this->lights_) {
+    clear_light_preview_brightness(state);
   }
 }
 
@@ -566,7 +585,7 @@ bool CFXDimmer::target_has_effect_(light::LightState *state) const {
   if (state == nullptr || !state->remote_values.is_on()) {
     return false;
   }
-  return state->get_effect_name() != "None";
+  return light_renders_preview(state);
 }
 
 float CFXDimmer::clamp_brightness_(float value) const {
@@ -55,7 +55,10 @@ class CFXDimmer : public Component {
   };
 
   static constexpr uint32_t MIN_RAMP_TRANSITION_MS = 50;
-  static constexpr uint32_t RAMP_UPDATE_INTERVAL_MS = 50;
+  // Effect-backed holds render from the preview channel every loop and only
+  // commit a real LightCall on this cadence, plus once at release.
+  static constexpr uint32_t RAMP_COMMIT_INTERVAL_MS = 500;
+  static constexpr uint32_t RAMP_PREVIEW_HOLD_MS = 250;
   static constexpr uint32_t POST_ACTION_QUIET_MS = 350;
   static constexpr float RAMP_MEASURED_EDGE_EPSILON = 0.005f;
   static constexpr float RAMP_MEASURED_EDGE_PROGRESS = 0.98f;
@@ -71,6 +74,7 @@ class CFXDimmer : public Component {
   void finish_ramp_();
   void freeze_ramp_(uint32_t now);
   void service_manual_ramp_(uint32_t now);
+  void clear_ramp_previews_();
   void apply_brightness_(light::LightState *state, float brightness,
                          uint32_t transition_ms);
   void apply_color_values_(light::LightCall &call, light::LightState *state,
@@ -88,6 +92,7 @@ class CFXDimmer : public Component {
                                  uint32_t now, float &measured) const;
   float freeze_brightness_(light::LightState *state, size_t index,
                            uint32_t now) const;
+  // Running a ChimeraFX effect, which renders the ramp preview every frame.
   bool target_has_effect_(light::LightState *state) const;
   float clamp_brightness_(float value) const;
   void emit_sync_ramp_(float brightness, uint32_t ramp_ms, bool pressed);
@@ -20,9 +20,20 @@ struct CFXDimmerTimingEntry {
   uint32_t ramp_end_ms{0};
   bool has_ramp_duration{false};
   uint16_t ramp_ms{0};
+  // Hold-to-dim preview for effect lights: the brightness the current frame
+  // should render, ahead of the last committed LightCall. Expires on its own
+  // if the dimmer stops refreshing it.
+  bool has_preview{false};
+  float preview_brightness{0.0f};
+  uint32_t preview_until_ms{0};
+  // A ChimeraFX effect is running on the light and reads the preview.
+  bool renders_preview{false};
 };
 
 inline std::array<CFXDimmerTimingEntry, 8> CFX_DIMMER_TIMING_HINTS{};
+// Number of entries with has_preview set, so frames skip the table scan
+// when no hold is in progress.
+inline uint8_t CFX_DIMMER_PREVIEW_COUNT{0};
 
 inline uint16_t clamp_timing_ms_(uint32_t value) {
   return value > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(value);
@@ -83,6 +94,62 @@ inline void clear_light_timing_hint(light::LightState *light) {
   }
 }
 
+inline void publish_light_preview_brightness(light::LightState *light,
+                                             float brightness,
+                                             uint32_t valid_until_ms) {
+  if (auto *entry = find_or_create_light_timing_entry_(light);
+      entry != nullptr) {
+    if (!entry->has_preview) {
+      entry->has_preview = true;
+      CFX_DIMMER_PREVIEW_COUNT++;
+    }
+    entry->preview_brightness = brightness;
+    entry->preview_until_ms = valid_until_ms;
+  }
+}
+
+inline void clear_light_preview_brightness(light::LightState *light) {
+  if (auto *entry = find_light_timing_entry_(light);
+      entry != nullptr && entry->has_preview) {
+    entry->has_preview = false;
+    entry->preview_until_ms = 0;
+    CFX_DIMMER_PREVIEW_COUNT--;
+  }
+}
+
+// Set by ChimeraFX effects from start() / stop(). Only these lights get a
+// preview-driven hold; any other effect ramps through LightCall transitions.
+inline void set_light_renders_preview(light::LightState *light, bool renders) {
+  auto *entry = renders ? find_or_create_light_timing_entry_(light)
+                        : find_light_timing_entry_(light);
+  if (entry != nullptr) {
+    entry->renders_preview = renders;
+  }
+}
+
+inline bool light_renders_preview(light::LightState *light) {
+  auto *entry = find_light_timing_entry_(light);
+  return entry != nullptr && entry->renders_preview;
+}
+
+// Frame path: leaves `brightness` untouched unless a fresh preview exists.
+inline bool read_light_preview_brightness(light::LightState *light,
+                                          uint32_t now, float &brightness) {
+  if (CFX_DIMMER_PREVIEW_COUNT == 0) {
+    return false;
+  }
+  auto *entry = find_light_timing_entry_(light);
+  if (entry == nullptr || !entry->has_preview) {
+    return false;
+  }
+  if (static_cast<int32_t>(entry->preview_until_ms - now) < 0) {
+    clear_light_preview_brightness(light);
+    return false;
+  }
+  brightness = entry->preview_brightness;
+  return true;
+}
+
 inline CFXDimmerTimingHint capture_light_timing_hint(light::LightState *light,
                                                      uint32_t now) {
   CFXDimmerTimingHint hint;
@@ -8,7 +8,22 @@
 
 #include "CFXRunner.h"
 #include "cfx_compat.h"
+#include "cfx_gamma.h"
+#include "cfx_particles.h"
 #include "cfx_utils.h"
+#ifdef USE_CFX_PROFILER
+#include "cfx_profiler.h"
+#endif
+#ifdef USE_CFX_TRACE
+#include "cfx_trace.h"
+#endif
+// Present only when cfx_sync is part of the build.
+#if __has_include("../cfx_sync/cfx_sync_group_clock.h")
+#include "../cfx_sync/cfx_sync_group_clock.h"
+#define CFX_HAS_SYNC_GROUP_CLOCK 1
+#else
+#define CFX_HAS_SYNC_GROUP_CLOCK 0
+#endif
 
 // ESP-IDF heap diagnostics (for production monitoring)
 #include "esp_heap_caps.h"
@@ -20,13 +35,6 @@
 #include <cstdint>
 #include <vector>
 
-// File-local macro: maps bare `instance` → per-core slot.
-// Defined here (not in CFXRunner.h) so it only affects this translation unit.
-// No outer parens — `esphome::chimera_fx::instance` expands to
-// `esphome::chimera_fx::instance_per_core[xPortGetCoreID()]` which is valid;
-// with outer parens it would expand to `esphome::chimera_fx::(...)` which is not.
-#define instance instance_per_core[xPortGetCoreID()]
-
 // Global time provider for FastLED timing functions.
 // Must be in global scope to match the extern declaration in FastLED_Stub.h.
 uint32_t get_millis() {
@@ -38,102 +46,54 @@ namespace esphome {
 namespace chimera_fx {
 
 CFXRunner *instance_per_core[2] = {nullptr, nullptr};
-
-static constexpr float CFX_DEFAULT_GAMMA = 2.8f;
-static const uint8_t CFX_DEFAULT_GAMMA_LUT[256] CFX_PROGMEM = {
-      0,   0,   0,   0,   1,   1,   2,   2,   3,   3,   4,   5,   5,   6,   6,   7,
-      8,   8,   9,   9,  10,  11,  11,  12,  13,  13,  14,  15,  16,  16,  17,  18,
-     19,  19,  20,  21,  22,  22,  23,  24,  25,  25,  26,  27,  28,  29,  29,  30,
-     31,  32,  33,  34,  34,  35,  36,  37,  38,  39,  40,  40,  41,  42,  43,  44,
-     45,  46,  47,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  58,
-     59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,
-     75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,
-     91,  92,  93,  94,  95,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106,
-    107, 108, 109, 110, 111, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123,
-    124, 125, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 139, 140, 141,
-    142, 143, 144, 145, 146, 147, 149, 150, 151, 152, 153, 154, 155, 157, 158, 159,
-    160, 161, 162, 163, 164, 166, 167, 168, 169, 170, 171, 173, 174, 175, 176, 177,
-    178, 180, 181, 182, 183, 184, 185, 187, 188, 189, 190, 191, 192, 194, 195, 196,
-    197, 198, 200, 201, 202, 203, 204, 206, 207, 208, 209, 210, 212, 213, 214, 215,
-    216, 218, 219, 220, 221, 222, 224, 225, 226, 227, 229, 230, 231, 232, 233, 235,
-    236, 237, 238, 240, 241, 242, 243, 245, 246, 247, 248, 250, 251, 252, 253, 255};
-
-struct CFXGammaCacheEntry {
-  bool valid{false};
-  float gamma{CFX_DEFAULT_GAMMA};
-  uint8_t lut[256]{};
-};
-
-static CFXGammaCacheEntry g_gamma_lut_cache[4];
-
-static void build_gamma_lut_(uint8_t *dest, float gamma) {
-  const float power = 3.5f / gamma;
-  for (int i = 0; i < 256; i++) {
-    dest[i] = (uint8_t)(powf((float)i / 255.0f, power) * 255.0f);
-  }
-}
-
-static const uint8_t *get_cached_gamma_lut_(float gamma) {
-  for (auto &entry : g_gamma_lut_cache) {
-    if (entry.valid && fabsf(entry.gamma - gamma) <= 0.01f) {
-      return entry.lut;
-    }
-  }
-  for (auto &entry : g_gamma_lut_cache) {
-    if (!entry.valid) {
-      build_gamma_lut_(entry.lut, gamma);
-      entry.gamma = gamma;
-      entry.valid = true;
-      return entry.lut;
-    }
-  }
-  return nullptr;
-}
+SpanSplitFn span_split_hook = nullptr;
 
 // Forward declarations
-uint16_t mode_running_lights(void);
-uint16_t mode_running_dual(void);
-uint16_t mode_saw(void);
-uint16_t mode_blink(void);
-uint16_t mode_blink_rainbow(void);
-uint16_t mode_strobe(void);
-uint16_t mode_strobe_rainbow(void);
-uint16_t mode_multi_strobe(void);
-uint16_t mode_sparkle(void);
-uint16_t mode_flash_sparkle(void);
-uint16_t mode_hyper_sparkle(void);
-uint16_t mode_exploding_fireworks(void);
-uint16_t mode_popcorn(void);
-uint16_t mode_drip(void);
-uint16_t mode_dropping_time(void);
-uint16_t mode_heartbeat_center(void);
-uint16_t mode_kaleidos(void);
-uint16_t mode_follow_me(void);
-uint16_t mode_follow_us(void);
-uint16_t mode_cfx_horizon_sweep(void);
-uint16_t mode_separator(void);
-uint16_t mode_collider(void);
-uint16_t mode_hydro_pulse(void);
-uint16_t mode_dropping_fill(void);
-uint16_t mode_moire_shift(void);
-uint16_t mode_resonance_fill(void);
-uint16_t mode_telemetry(void);
-uint16_t mode_interference(void);
-uint16_t mode_eclipse(void);
-uint16_t mode_lithograph(void);
-uint16_t mode_tidal_surge(void);
+uint16_t mode_running_lights(RenderContext &ctx);
+uint16_t mode_running_dual(RenderContext &ctx);
+uint16_t mode_saw(RenderContext &ctx);
+uint16_t mode_blink(RenderContext &ctx);
+uint16_t mode_blink_rainbow(RenderContext &ctx);
+uint16_t mode_strobe(RenderContext &ctx);
+uint16_t mode_strobe_rainbow(RenderContext &ctx);
+uint16_t mode_multi_strobe(RenderContext &ctx);
+uint16_t mode_sparkle(RenderContext &ctx);
+uint16_t mode_flash_sparkle(RenderContext &ctx);
+uint16_t mode_hyper_sparkle(RenderContext &ctx);
+uint16_t mode_exploding_fireworks(RenderContext &ctx);
+uint16_t mode_popcorn(RenderContext &ctx);
+uint16_t mode_drip(RenderContext &ctx);
+uint16_t mode_dropping_time(RenderContext &ctx);
+uint16_t mode_heartbeat_center(RenderContext &ctx);
+uint16_t mode_kaleidos(RenderContext &ctx);
+uint16_t mode_follow_me(RenderContext &ctx);
+uint16_t mode_follow_us(RenderContext &ctx);
+uint16_t mode_cfx_horizon_sweep(RenderContext &ctx);
+uint16_t mode_separator(RenderContext &ctx);
+uint16_t mode_collider(RenderContext &ctx);
+uint16_t mode_hydro_pulse(RenderContext &ctx);
+uint16_t mode_dropping_fill(RenderContext &ctx);
+uint16_t mode_moire_shift(RenderContext &ctx);
+uint16_t mode_resonance_fill(RenderContext &ctx);
+uint16_t mode_telemetry(RenderContext &ctx);
+uint16_t mode_interference(RenderContext &ctx);
+uint16_t mode_eclipse(RenderContext &ctx);
+uint16_t mode_lithograph(RenderContext &ctx);
+uint16_t mode_tidal_surge(RenderContext &ctx);
 
 // (get_millis is defined globally before the namespace - see top of file)
 
 // Constructor
 CFXRunner::CFXRunner(esphome::light::AddressableLight *light) {
   target_light = light;
-  // CFX-004: instance = this removed; use InstanceGuard in service()
+  // CFX-004: instance = this removed. Effects get the runner through
+  // RenderContext; InstanceGuard in service() only serves the FastLED shims.
   _mode = FX_MODE_STATIC;
   _name = "CFX";
   frame_time = 0;
 
   // Initialize Segment defaults
+  _segment.runner = this;
   _segment.start = 0;
   _segment.stop = light->size();
   _segment.mode = FX_MODE_STATIC;
@@ -154,10 +114,10 @@ CFXRunner::CFXRunner(esphome::light::AddressableLight *light) {
 
 // === Gamma Correction Helpers ===
 
-// Re-calculate the LUT based on the new gamma value
+// Point the runner at the baked table for its gamma
 // Goal: Output = Input^5.6 (Perceptually correct for effects)
 // Input is linear 0-255.
-// We want: Lut[i] = ( (i/255)^(5.6/Gamma) ) * 255
+// Lut[i] = ( (i/255)^(3.5/Gamma) ) * 255, baked at build time (cfx_gamma.h)
 void CFXRunner::setGamma(float g) {
   if (g < 0.1f)
     g = 1.0f; // Safety
@@ -165,46 +125,10 @@ void CFXRunner::setGamma(float g) {
     return;
   _gamma = g;
 
-  if (g > (CFX_DEFAULT_GAMMA - 0.01f) && g < (CFX_DEFAULT_GAMMA + 0.01f)) {
-    if (_dynamic_lut != nullptr) {
-      free(_dynamic_lut);
-      _dynamic_lut = nullptr;
-    }
-    _lut = CFX_DEFAULT_GAMMA_LUT;
-    return;
-  }
-
-  const uint8_t *cached_lut = get_cached_gamma_lut_(g);
-  if (cached_lut != nullptr) {
-    if (_dynamic_lut != nullptr) {
-      free(_dynamic_lut);
-      _dynamic_lut = nullptr;
-    }
-    _lut = cached_lut;
-    return;
-  }
-
-  if (_dynamic_lut == nullptr) {
-    _dynamic_lut = (uint8_t *)malloc(256);
-    if (_dynamic_lut == nullptr) {
-      ESP_LOGW("CFX", "Gamma LUT allocation failed; using default 2.8 table");
-      _gamma = CFX_DEFAULT_GAMMA;
-      _lut = CFX_DEFAULT_GAMMA_LUT;
-      return;
-    }
-  }
-  _lut = _dynamic_lut;
-  build_gamma_lut_(_dynamic_lut, _gamma);
-}
-
-void CFXRunner::prewarmGamma(float g) {
-  if (g < 0.1f)
-    g = 1.0f;
-  if (g > (CFX_DEFAULT_GAMMA - 0.01f) &&
-      g < (CFX_DEFAULT_GAMMA + 0.01f)) {
-    return;
-  }
-  get_cached_gamma_lut_(g);
+  float baked = g;
+  _lut = cfx_gamma_lut(g, &baked);
+  if (fabsf(baked - g) > 0.01f)
+    ESP_LOGW("CFX", "Gamma %.2f has no baked table; using %.2f", g, baked);
 }
 
 // Adjust a "floor" brightness value (e.g. Breath effect minimum)
@@ -257,237 +181,170 @@ uint8_t CFXRunner::getSubFactor(uint8_t factor) {
   return (uint8_t)std::max(1, std::min(255, new_factor));
 }
 
-void Segment::setPixelColor(int n, uint32_t c) {
-  if (n < 0 || n >= (int)virtualLength()) // CFX-001: use virtualLength() — half-strip when mirror active
-    return;
-
-  if (!instance || !instance->target_light)
-    return;
-
-  int light_size = instance->target_light->size();
-
-  uint8_t r = CFX_R(c);
-  uint8_t g = CFX_G(c);
-  uint8_t b = CFX_B(c);
-  uint8_t w = CFX_W(c);
-
-  // Apply native force_white BEFORE hitting the ESPHome gamma cache
-  if (instance->force_white_active_)
-    cfx::apply_force_white(r, g, b, w);
-
-  // CFX-BRIGHTNESS FIX: ESPHome's AddressableLight wrapper expects effects 
-  // to bake their own brightness before returning the buffer.
-  // We only do this if bake_brightness_ is enabled (Segments).
-  if (instance->bake_brightness_ && instance->global_brightness_ < 0.999f && instance->global_brightness_ >= 0.0f) {
-    float bri = instance->global_brightness_;
-    r = (uint8_t)(r * bri);
-    g = (uint8_t)(g * bri);
-    b = (uint8_t)(b * bri);
-    w = (uint8_t)(w * bri);
-  }
-
-
-  esphome::Color esphome_color(r, g, b, w);
-
-  int offset = (light_size == (int)physicalLength()) ? 0 : start;
-  int global_index = mirror ? (offset + length() - 1 - n) : (offset + n);
-
-  if (global_index >= 0 && global_index < light_size) {
-    (*instance->target_light)[global_index] = esphome_color;
-  }
-}
-
 uint32_t Segment::getPixelColor(int n) {
-  if (n < 0 || n >= length())
-    return 0;
-
-  if (!instance || !instance->target_light)
+  if (n < 0 || n >= (int)_pixelsLen)
     return 0;
-  int light_size = instance->target_light->size();
-  int offset = (light_size == length()) ? 0 : start;
-
-  // Apply mirror (inversion) if enabled
-  int global_index = mirror ? (offset + length() - 1 - n) : (offset + n);
-
-  if (global_index >= 0 && global_index < light_size) {
-    esphome::Color c = (*instance->target_light)[global_index].get();
-    return RGBW32(c.r, c.g, c.b, c.w);
-  }
-  return 0;
+  return pixels[n];
 }
 
 void Segment::fill(uint32_t c) {
-  if (!instance || !instance->target_light)
-    return;
-
-  int len = length();
-  int light_size = instance->target_light->size();
-  int offset = (light_size == len) ? 0 : start;
-
-  // Optimized tight loop: Resolve pointers once
-  esphome::light::AddressableLight &light = *instance->target_light;
-
-  uint8_t r = CFX_R(c);
-  uint8_t g = CFX_G(c);
-  uint8_t b = CFX_B(c);
-  uint8_t w = CFX_W(c);
-
-  // Apply native force_white BEFORE hitting the ESPHome gamma cache
-  if (instance->force_white_active_)
-    cfx::apply_force_white(r, g, b, w);
-
-  // CFX-BRIGHTNESS FIX: ESPHome's AddressableLight wrapper expects effects 
-  // to bake their own brightness before returning the buffer.
-  // We only do this if bake_brightness_ is enabled (Segments).
-  if (instance->bake_brightness_ && instance->global_brightness_ < 0.999f && instance->global_brightness_ >= 0.0f) {
-    float bri = instance->global_brightness_;
-    r = (uint8_t)(r * bri);
-    g = (uint8_t)(g * bri);
-    b = (uint8_t)(b * bri);
-    w = (uint8_t)(w * bri);
-  }
-
-
-  esphome::Color esphome_color(r, g, b, w);
-
-  for (int i = 0; i < len; i++) {
-    int global_index = mirror ? (offset + len - 1 - i) : (offset + i);
-    if (global_index >= 0 && global_index < light_size) {
-      light[global_index] = esphome_color;
-    }
-  }
+  for (int i = 0; i < (int)_pixelsLen; i++)
+    pixels[i] = c;
+  markDirty(0, _pixelsLen);
 }
 
 void Segment::fadeToBlackBy(uint8_t fadeBy) {
-  if (!instance || !instance->target_light)
+  if (!runner || !pixels)
     return;
 
   // GAMMA CORRECTION for Fade Speed
   // A raw "fadeBy" of 10 creates a very different decay curve at Gamma 1.0
   // vs 2.8. We adjust it so the visual decay SPEED is constant.
-  uint8_t adjustedFade = instance->getFadeFactor(255 - fadeBy);
-  // Invert back: We calculated retention, now we want fade amount
-  // Wait, getFadeFactor takes "Retention" (0=Black, 255=Full).
-  // fadeBy is "Amount to subtract" (10 = subtract 10/256).
-  // Retention = 255 - fadeBy.
-  // NewRetention = getFadeFactor(Retention).
-  // NewFadeBy = 255 - NewRetention.
-
+  // getFadeFactor takes "Retention" (0=Black, 255=Full), so convert fadeBy
+  // (amount to subtract) to a retention, correct it, and scale by that.
   uint8_t retention = 255 - fadeBy;
-  uint8_t newRetention = instance->getFadeFactor(retention);
-  uint8_t effectiveFade = 255 - newRetention;
+  uint8_t keep = runner->getFadeFactor(retention);
 
-  int len = length();
-  int light_size = instance->target_light->size();
-  int offset = (light_size == len) ? 0 : start;
-  esphome::light::AddressableLight &light = *instance->target_light;
-
-  for (int i = 0; i < len; i++) {
-    int global_index = mirror ? (offset + len - 1 - i) : (offset + i);
-    if (global_index >= 0 && global_index < light_size) {
-      // Read directly from ESPHome buffer for speed
-      esphome::Color c = light[global_index].get();
-      // Use standard bit math with Gamma-Corrected effectiveFade
-      c.r = (c.r * (255 - effectiveFade)) >> 8;
-      c.g = (c.g * (255 - effectiveFade)) >> 8;
-      c.b = (c.b * (255 - effectiveFade)) >> 8;
-      c.w = (c.w * (255 - effectiveFade)) >> 8;
-      light[global_index] = c;
+  int lo = -1, hi = -1;
+  for (int i = 0; i < (int)_pixelsLen; i++) {
+    uint32_t c = pixels[i];
+    if (c != 0) { // trails are mostly black
+      pixels[i] = cfx::scale_rgbw32(c, keep);
+      if (lo < 0)
+        lo = i;
+      hi = i;
     }
   }
+  if (lo >= 0)
+    markDirty(lo, hi + 1);
 }
 
 void Segment::blur(uint8_t blur_amount) {
-  if (!instance || !instance->target_light)
+  // Deepest budget degradation drops blur passes (see budgetLevel()).
+  if (!pixels || (runner != nullptr && runner->budgetLevel() >= 2))
     return;
 
   uint8_t keep = 255 - blur_amount;
   uint8_t seep = blur_amount >> 1;
 
-  // Create a temp buffer to avoid propagating changes directionally
-  // For small strips this is fine. For large strips, we might want to optimize
-  // by just keeping "previous" pixel value.
-  // WLED approach: blur1d modifies in-place but effectively propagates.
-  // Let's stick to simple in-place for now (WLED compat).
-
-  int len = length();
-  int light_size = instance->target_light->size();
-  int offset = (light_size == len) ? 0 : start;
-  int limit_start = offset;
-  int limit_stop = offset + len;
-  esphome::light::AddressableLight &light = *instance->target_light;
-
+  // WLED approach: blur1d modifies in-place, so the left neighbour is the
+  // already-blurred value. Neighbours are clamped to the segment edges.
+  // Blur Kernel: (C*keep + (L+R)*seep) / 256, two channels per multiply.
+  // L+R fits a 16-bit lane (<= 510) and keep + 2*seep <= 256 keeps the sum
+  // below 2^16, so lanes never carry into each other.
+  constexpr uint32_t M = cfx::RGBW32_EVEN;
+  int len = _pixelsLen;
+  uint32_t left = pixels[0];
+  int lo = -1, hi = -1;
   for (int i = 0; i < len; i++) {
-    int global_index = mirror ? (offset + len - 1 - i) : (offset + i);
-    if (global_index < 0 || global_index >= light_size)
-      continue;
-
-    // Get current color
-    esphome::Color c = light[global_index].get();
+    uint32_t c = pixels[i];
+    uint32_t right = (i + 1 < len) ? pixels[i + 1] : c;
 
-    // Get neighbors (respecting mirror direction context)
-    // Local left/right translate to absolute neighbors depending on mirror
-    int left_index = mirror ? (global_index + 1) : (global_index - 1);
-    int right_index = mirror ? (global_index - 1) : (global_index + 1);
+    uint32_t even = ((c & M) * keep + ((left & M) + (right & M)) * seep) >> 8;
+    uint32_t odd = ((c >> 8) & M) * keep +
+                   (((left >> 8) & M) + ((right >> 8) & M)) * seep;
 
-    // Clamp to segment boundaries
-    if (mirror) {
-      if (left_index >= limit_stop)
-        left_index = global_index;
-      if (right_index < limit_start)
-        right_index = global_index;
-    } else {
-      if (left_index < limit_start)
-        left_index = global_index;
-      if (right_index >= limit_stop)
-        right_index = global_index;
-    }
-
-    esphome::Color left = c;
-    if (left_index >= 0 && left_index < light_size) {
-      left = light[left_index].get();
+    left = (even & M) | (odd & ~M);
+    if (left != c) {
+      if (lo < 0)
+        lo = i;
+      hi = i;
     }
+    pixels[i] = left;
+  }
+  if (lo >= 0)
+    markDirty(lo, hi + 1);
+}
 
-    esphome::Color right = c;
-    if (right_index >= 0 && right_index < light_size) {
-      right = light[right_index].get();
-    }
+void Segment::subtractive_fade_val(uint8_t fade_amt) {
+  int lo = -1, hi = -1;
+  for (int i = 0; i < (int)_pixelsLen; i++) {
+    uint32_t c = pixels[i];
+    if (c != 0) { // trails are mostly black
+      pixels[i] = cfx::qsub_rgbw32(c, fade_amt);
+      if (lo < 0)
+        lo = i;
+      hi = i;
+    }
+  }
+  if (lo >= 0)
+    markDirty(lo, hi + 1);
+}
 
-    // Blur Kernel: (C*keep + (L+R)*seep) / 256
-    uint8_t r =
-        ((uint16_t)c.r * keep + (uint16_t)(left.r + right.r) * seep) >> 8;
-    uint8_t g =
-        ((uint16_t)c.g * keep + (uint16_t)(left.g + right.g) * seep) >> 8;
-    uint8_t b =
-        ((uint16_t)c.b * keep + (uint16_t)(left.b + right.b) * seep) >> 8;
-    uint8_t w =
-        ((uint16_t)c.w * keep + (uint16_t)(left.w + right.w) * seep) >> 8;
+// Scratch size for effects that compute a row in chunks and hand each chunk
+// to Segment::writeSpan().
+static constexpr int SPAN_CHUNK = 32;
 
-    light[global_index] = esphome::Color(r, g, b, w);
+// Clips [start, start + count) to [0, len). Returns the clipped count and
+// adjusts start; 0 means nothing to do.
+static inline int clip_range(int &start, int count, int len) {
+  if (start < 0) {
+    count += start;
+    start = 0;
   }
+  if (count > len - start)
+    count = len - start;
+  return count > 0 ? count : 0;
 }
 
-void Segment::subtractive_fade_val(uint8_t fade_amt) {
-  if (!instance || !instance->target_light)
-    return;
-  int len = length();
-  int light_size = instance->target_light->size();
-  int offset = (light_size == len) ? 0 : start;
-  esphome::light::AddressableLight &light = *instance->target_light;
+void Segment::fillRange(int start, int count, uint32_t c) {
+  count = clip_range(start, count, _pixelsLen);
+  uint32_t *dst = pixels + start;
+  for (int i = 0; i < count; i++)
+    dst[i] = c;
+  if (count > 0)
+    markDirty(start, start + count);
+}
 
-  for (int i = 0; i < len; i++) {
-    int global_index = mirror ? (offset + len - 1 - i) : (offset + i);
-    if (global_index < 0 || global_index >= light_size)
-      continue;
+void Segment::writeSpan(int start, const uint32_t *src, int count,
+                        bool reverse) {
+  if (src == nullptr)
+    return;
+  const int first = start;
+  const int total = count;
+  count = clip_range(start, count, _pixelsLen);
+  if (count == 0)
+    return;
+  const int skipped = start - first;
+  uint32_t *dst = pixels + start;
+  markDirty(start, start + count);
+  if (!reverse) {
+    memcpy(dst, src + skipped, (size_t)count * sizeof(uint32_t));
+    return;
+  }
+  // src[k] lands at first + total - 1 - k.
+  const uint32_t *s = src + (total - 1 - skipped);
+  for (int i = 0; i < count; i++)
+    dst[i] = *s--;
+}
 
-    esphome::Color c = light[global_index].get();
-    uint8_t r = (c.r > fade_amt) ? (c.r - fade_amt) : 0;
-    uint8_t g = (c.g > fade_amt) ? (c.g - fade_amt) : 0;
-    uint8_t b = (c.b > fade_amt) ? (c.b - fade_amt) : 0;
-    uint8_t w = (c.w > fade_amt) ? (c.w - fade_amt) : 0;
+void Segment::scaleRange(int start, int count, uint8_t scale) {
+  count = clip_range(start, count, _pixelsLen);
+  uint32_t *px = pixels + start;
+  for (int i = 0; i < count; i++)
+    px[i] = cfx::scale_rgbw32(px[i], scale);
+  if (count > 0)
+    markDirty(start, start + count);
+}
 
-    light[global_index] = esphome::Color(r, g, b, w);
-  }
+void Segment::copyRange(int dst, int src, int count) {
+  if (count <= 0 || dst == src)
+    return;
+  int len = _pixelsLen;
+  // Trim so both source and destination stay inside the segment.
+  int lo = std::min(dst, src);
+  if (lo < 0) {
+    dst -= lo;
+    src -= lo;
+    count += lo;
+  }
+  int hi = std::max(dst, src);
+  if (count > len - hi)
+    count = len - hi;
+  if (count <= 0)
+    return;
+  memmove(pixels + dst, pixels + src, (size_t)count * sizeof(uint32_t));
+  markDirty(dst, dst + count);
 }
 
 void Segment::fade_out_smooth(uint8_t fade_amt) {
@@ -702,6 +559,11 @@ static uint32_t *activeSolidPalette() {
   return PaletteSolidPerCore[xPortGetCoreID()];
 }
 
+// Either core's buffer; a range check avoids reading the core ID per pixel.
+static bool isSolidPalette(const uint32_t *palette) {
+  return palette >= PaletteSolidPerCore[0] && palette < PaletteSolidPerCore[2];
+}
+
 // Fill PaletteSolid with current color
 static void fillSolidPalette(uint32_t color) {
   uint32_t *palette = activeSolidPalette();
@@ -713,7 +575,8 @@ static void fillSolidPalette(uint32_t color) {
 // Palette Lookup Function
 // Index 0 = "Default" is special (use effect preset), handled by caller
 // Actual palettes start at index 1
-static const uint32_t *getPaletteByIndex(uint8_t palette_index) {
+static const uint32_t *getPaletteByIndex(const CFXRunner *runner,
+                                         uint8_t palette_index) {
   switch (palette_index) {
   case 0: // "Default" - use effect preset (caller handles this)
     return PaletteRainbow; // Fallback if caller doesn't handle
@@ -765,9 +628,9 @@ static const uint32_t *getPaletteByIndex(uint8_t palette_index) {
     return PaletteTwilight; // CFX-019: PaletteTwilight defined at CFXRunner.cpp:566
   case 254:
     // Smart Random (generated on switch)
-    // Needs instance to access the buffer
-    if (instance)
-      return instance->_currentRandomPaletteBuffer;
+    // Needs the runner to access the buffer
+    if (runner)
+      return runner->_currentRandomPaletteBuffer;
     return PaletteRainbow;
   case 255:
     // Solid color mode - caller must call fillSolidPalette first
@@ -780,8 +643,7 @@ static const uint32_t *getPaletteByIndex(uint8_t palette_index) {
 
 // Simple Linear Interpolation Palette Lookup (Updated for dynamic palettes)
 // Uses cfx_pgm_read_dword for PROGMEM/Flash compatibility
-static CRGBW ColorFromPalette(const uint32_t *palette, uint8_t index,
-                              uint8_t brightness) {
+static uint32_t palette_lerp(const uint32_t *palette, uint8_t index) {
   uint8_t i = index >> 4;   // 0-15
   uint8_t f = index & 0x0F; // Fraction 0-15
 
@@ -806,13 +668,71 @@ static CRGBW ColorFromPalette(const uint32_t *palette, uint8_t index,
   uint8_t g = (uint8_t)std::max(0, (int)g1 + ((((int)g2 - (int)g1) * f) >> 4));
   uint8_t b = (uint8_t)std::max(0, (int)b1 + ((((int)b2 - (int)b1) * f) >> 4));
 
-  // Apply brightness
-  w = (w * brightness) >> 8;
-  r = (r * brightness) >> 8;
-  g = (g * brightness) >> 8;
-  b = (b * brightness) >> 8;
+  return RGBW32(r, g, b, w);
+}
+
+// Segment::color_from_palette() flavour: 8-bit color_blend between stops.
+static uint32_t palette_blend(const uint32_t *palette, uint8_t index) {
+  uint8_t i = index >> 4;
+  uint8_t blendAmt = (index & 0x0F) << 4; // Scale 0-15 -> 0-240
+  return color_blend(palette[i], palette[(i + 1) & 0x0F], blendAmt);
+}
+
+const uint32_t *CFXRunner::rebuildPalette(const uint32_t *src) {
+  for (int i = 0; i < 256; i++)
+    _palette_lut.entries[i] = palette_lerp(src, (uint8_t)i);
+  _palette_lut.src = src;
+  _palette_lut.gen = paletteGeneration(src);
+  return _palette_lut.entries;
+}
+
+const uint32_t *CFXRunner::rebuildPaletteBlend(const uint32_t *src) {
+  for (int i = 0; i < 256; i++)
+    _palette_blend_lut.entries[i] = palette_blend(src, (uint8_t)i);
+  _palette_blend_lut.src = src;
+  _palette_blend_lut.gen = paletteGeneration(src);
+  return _palette_blend_lut.entries;
+}
+
+// Builds the palette expansion ahead of a span kernel, so the kernel's
+// ColorFromPalette() lookups only read the runner's cache.
+static void primePalette(CFXRunner *runner, const uint32_t *palette) {
+  if (runner != nullptr && !isSolidPalette(palette))
+    runner->expandPalette(palette);
+}
+
+// A cross-core handoff costs a task wake and a semaphore round trip; below
+// this many LEDs the whole span renders faster inline.
+static constexpr uint16_t CFX_SPAN_SPLIT_MIN_LEDS = 512;
+
+// Runs `kernel` over the whole segment. Long strips are halved across both
+// cores when the scheduler has Core 0 free. The split is 64-aligned so
+// kernels that batch pixels (noise rows) keep the same chunking.
+static void renderSpans(const RenderContext &ctx, SpanKernelFn kernel,
+                        const void *frame) {
+  const uint16_t len = std::min<uint16_t>(ctx.len, ctx.seg->_pixelsLen);
+  const uint16_t split = (len / 2) & ~63u;
+  if (len < CFX_SPAN_SPLIT_MIN_LEDS || span_split_hook == nullptr ||
+      !span_split_hook(ctx, kernel, frame, split, len))
+    kernel(ctx, frame, 0, len);
+  ctx.seg->markDirty(0, len);
+}
 
-  return CRGBW(r, g, b, w);
+static CRGBW ColorFromPalette(CFXRunner *runner, const uint32_t *palette,
+                              uint8_t index, uint8_t brightness) {
+  uint32_t c;
+  if (isSolidPalette(palette)) {
+    // Uniform by construction (fillSolidPalette), and rewritten every frame,
+    // so it is never cached: every stop lerps to itself.
+    c = palette[0];
+  } else if (runner != nullptr) {
+    c = runner->expandPalette(palette)[index];
+  } else {
+    c = palette_lerp(palette, index);
+  }
+  // Always applied, even at 255: callers are tuned to the (x * 255) >> 8
+  // result.
+  return CRGBW(cfx::scale_rgbw32(c, brightness));
 }
 
 static uint32_t mix32(uint32_t x) {
@@ -1029,7 +949,8 @@ struct AuroraWave {
 // Uses _segment.call (increments every frame at ~17ms) with 15 frames per half-cycle
 // → ~240ms per half/cycle, 3 blinks = ~1.4s total.
 #define SEP_FRAMES_PER_HALF 15
-uint16_t mode_separator(void) {
+uint16_t mode_separator(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
@@ -1053,7 +974,8 @@ uint16_t mode_separator(void) {
   return FRAMETIME;
 }
 
-uint16_t mode_static(void) {
+uint16_t mode_static(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
@@ -1062,11 +984,11 @@ uint16_t mode_static(void) {
     // This allows users to display a stationary palette pattern.
     uint16_t len = instance->_segment.length();
     const uint32_t *active_palette =
-        getPaletteByIndex(instance->_segment.palette);
+        getPaletteByIndex(instance, instance->_segment.palette);
 
     for (int i = 0; i < len; i++) {
       uint8_t colorIndex = (i * 255) / (len > 1 ? len - 1 : 1);
-      CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
+      CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
       instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
     }
   } else {
@@ -1078,7 +1000,8 @@ uint16_t mode_static(void) {
   return FRAMETIME; // Refresh rate
 }
 
-uint16_t mode_cfx_horizon_sweep(void) {
+uint16_t mode_cfx_horizon_sweep(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
@@ -1101,27 +1024,43 @@ uint16_t mode_cfx_horizon_sweep(void) {
 
   if (instance->_segment.palette != 255 && instance->_segment.palette != 0) {
     const uint32_t *active_palette =
-        getPaletteByIndex(instance->_segment.palette);
-
-    for (int i = 0; i < len; i++) {
-      int s_idx = i / section_len;
-      int i_rel = i % section_len;
+        getPaletteByIndex(instance, instance->_segment.palette);
+    Segment &seg = instance->_segment;
+    const int denom = section_len > 1 ? section_len - 1 : 1;
+
+    // Sections only come in two orientations, so render the first section
+    // of each and copy it into the remaining sections of the same kind.
+    int rendered[2] = {-1, -1};
+    uint32_t span[SPAN_CHUNK];
+    for (int s_idx = 0; s_idx < sections; s_idx++) {
+      int s_start = s_idx * section_len;
+      if (s_start >= len)
+        break;
+      int s_count = std::min<int>(section_len, len - s_start);
 
       // Invert odd sections for "Curtain" symmetry (0->1, 2<-1, 2->3, 4<-3)
       bool reverse_in_section = (s_idx % 2 != 0);
       if (mirror)
         reverse_in_section = !reverse_in_section;
 
-      uint8_t colorIndex;
-      if (reverse_in_section) {
-        colorIndex =
-            255 - ((i_rel * 255) / (section_len > 1 ? section_len - 1 : 1));
-      } else {
-        colorIndex = (i_rel * 255) / (section_len > 1 ? section_len - 1 : 1);
+      int &src = rendered[reverse_in_section ? 1 : 0];
+      if (src >= 0) {
+        seg.copyRange(s_start, src, s_count);
+        continue;
+      }
+      src = s_start;
+
+      for (int c0 = 0; c0 < s_count; c0 += SPAN_CHUNK) {
+        int n = std::min<int>(SPAN_CHUNK, s_count - c0);
+        for (int k = 0; k < n; k++) {
+          uint8_t colorIndex = ((c0 + k) * 255) / denom;
+          if (reverse_in_section)
+            colorIndex = 255 - colorIndex;
+          CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
+          span[k] = RGBW32(c.r, c.g, c.b, c.w);
+        }
+        seg.writeSpan(s_start + c0, span, n);
       }
-
-      CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
-      instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
     }
   } else {
     instance->_segment.fill(instance->_segment.colors[0]);
@@ -1130,7 +1069,8 @@ uint16_t mode_cfx_horizon_sweep(void) {
   return FRAMETIME;
 }
 
-uint16_t mode_aurora(void) {
+uint16_t mode_aurora(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   // === FRAME DIAGNOSTICS (enabled with CFX_FRAME_DIAGNOSTICS) ===
   static cfx::FrameDiagnostics aurora_diag;
   aurora_diag.frame_start();
@@ -1162,7 +1102,7 @@ uint16_t mode_aurora(void) {
   if (!instance->_segment.allocateData(sizeof(AuroraWave) * W_MAX_COUNT)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(sizeof(AuroraWave) * W_MAX_COUNT)); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
 
   // CFX-013 FIX: allocateData() already zeroes fresh allocations via memset.
@@ -1200,8 +1140,9 @@ uint16_t mode_aurora(void) {
         if (i < active_count) {
           uint8_t colorIndex = hw_random8();
           const uint32_t *active_palette =
-              getPaletteByIndex(instance->_segment.palette);
-          CRGBW color = ColorFromPalette(active_palette, colorIndex, 255);
+              getPaletteByIndex(instance, instance->_segment.palette);
+          CRGBW color =
+              ColorFromPalette(instance, active_palette, colorIndex, 255);
           waves[i].init(instance->_segment.length(), color);
         }
       }
@@ -1210,8 +1151,9 @@ uint16_t mode_aurora(void) {
       if (i < active_count) {
         uint8_t colorIndex = hw_random8();
         const uint32_t *active_palette =
-            getPaletteByIndex(instance->_segment.palette);
-        CRGBW color = ColorFromPalette(active_palette, colorIndex, 255);
+            getPaletteByIndex(instance, instance->_segment.palette);
+        CRGBW color =
+            ColorFromPalette(instance, active_palette, colorIndex, 255);
         waves[i].init(instance->_segment.length(), color);
       }
     }
@@ -1252,13 +1194,14 @@ uint16_t mode_aurora(void) {
 // VIRTUAL RESOLUTION UPDATE:
 // Simulates fire on a fixed 60-pixel grid to ensure identical behavior on any
 // strip length, then scales output to actual length.
-uint16_t mode_fire_2012(void) {
+uint16_t mode_fire_2012(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // 1. Define Virtual Grid
   const int VIRTUAL_HEIGHT = 60;
@@ -1267,7 +1210,7 @@ uint16_t mode_fire_2012(void) {
   if (!instance->_segment.allocateData(VIRTUAL_HEIGHT)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(VIRTUAL_HEIGHT)); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
   uint8_t *heat = instance->_segment.data;
 
@@ -1339,13 +1282,14 @@ uint16_t mode_fire_2012(void) {
   return FRAMETIME;
 }
 
-uint16_t mode_fire_dual(void) {
+uint16_t mode_fire_dual(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // 1. Define Virtual Grid
   const int VIRTUAL_HEIGHT = 60;
@@ -1354,7 +1298,7 @@ uint16_t mode_fire_dual(void) {
   if (!instance->_segment.allocateData(VIRTUAL_HEIGHT)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(VIRTUAL_HEIGHT)); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
   uint8_t *heat = instance->_segment.data;
 
@@ -1565,8 +1509,9 @@ static CRGB pacifica_cache_color(uint8_t cache_id, uint8_t index) {
 // Helper: WLED-EXACT wave layer function
 // This matches WLED's pacifica_one_layer() precisely
 [[maybe_unused]] static void pacifica_one_layer_wled(
-    CRGB &c, uint16_t i, uint8_t cache_id, uint16_t cistart,
-    uint16_t wavescale, uint8_t bri, uint16_t ioff) {
+    RenderContext &ctx, CRGB &c, uint16_t i, uint8_t cache_id,
+    uint16_t cistart, uint16_t wavescale, uint8_t bri, uint16_t ioff) {
+  CFXRunner *const instance = ctx.runner;
   // WLED EXACT: unsigned ci = cistart;
   unsigned ci = cistart;
   // WLED EXACT: unsigned waveangle = ioff;
@@ -1689,81 +1634,52 @@ static CRGB pacifica_cache_color(uint8_t cache_id, uint8_t index) {
   c.b = qadd8(c.b, layer.b);
 }
 
-// --- Ocean Effect ---
-// Inspired by WLED's Pacifica, optimized for long strips and ambient
-// lighting. Uses bidirectional wave interference with collision-based
-// whitecaps.
-uint16_t mode_ocean() {
-  // === FRAME DIAGNOSTICS (enabled with CFX_FRAME_DIAGNOSTICS) ===
-  static cfx::FrameDiagnostics ocean_diag;
-  ocean_diag.frame_start();
-  ocean_diag.maybe_log("Ocean");
-
-  if (!instance)
-    return 350;
-
-  int len = instance->_segment.length();
-  uint8_t speed = instance->_segment.speed;
-
-  // Time base - uniform for all pixels (no position-dependent acceleration)
-  uint32_t now = cfx_millis();
-  uint32_t t = (now * (speed + 1)) >> 7;
-
-  // === WAVE POSITIONS (time-based, moves independently of strip position)
-  // === Forward waves (move from start to end)
-  uint16_t fwd1_pos = (t * 5); // Slow forward
-  uint16_t fwd2_pos = (t * 7); // Medium forward
-
-  // Backward waves (move from end to start)
-  uint16_t bwd1_pos = -(t * 6); // Slow backward
-  uint16_t bwd2_pos = -(t * 9); // Medium backward
-
-  // BOOSTED layer brightness for low global brightness visibility
-  // Higher values = more visible at low brightness settings
-  uint8_t bri1 = 140 + ((sin8((t >> 3) & 0xFF) * 80) >> 8); // 140-220
-  uint8_t bri2 = 130 + ((sin8((t >> 4) & 0xFF) * 70) >> 8); // 130-200
-  uint8_t bri3 = 120 + ((sin8((t >> 5) & 0xFF) * 60) >> 8); // 120-180
-  uint8_t bri4 = 100 + ((sin8((t >> 6) & 0xFF) * 50) >> 8); // 100-150
-
-  // Whitecap base
-  uint8_t wave_threshold = (t >> 2) & 0xFF;
+struct OceanFrame {
+  uint16_t fwd1_pos, fwd2_pos, bwd1_pos, bwd2_pos;
+  uint8_t bri1, bri2, bri3, bri4;
+  uint8_t wave_threshold;
+};
 
-  for (int i = 0; i < len; i++) {
+static void ocean_span(const RenderContext &ctx, const void *frame,
+                       uint16_t begin, uint16_t end) {
+  const auto &f = *static_cast<const OceanFrame *>(frame);
+  CFXRunner *const runner = ctx.runner;
+  for (int i = begin; i < end; i++) {
     // Spatial position scaled to wave space
     uint16_t spatial = i * 256;
 
     // === CALCULATE 4 WAVE PHASES AT THIS PIXEL ===
-    uint8_t idx1 = ((spatial >> 1) + fwd1_pos) >> 8;
-    uint8_t idx2 = ((spatial >> 2) + fwd2_pos) >> 8;
-    uint8_t idx3 = ((spatial >> 1) + bwd1_pos) >> 8;
-    uint8_t idx4 = ((spatial >> 2) + bwd2_pos) >> 8;
+    uint8_t idx1 = ((spatial >> 1) + f.fwd1_pos) >> 8;
+    uint8_t idx2 = ((spatial >> 2) + f.fwd2_pos) >> 8;
+    uint8_t idx3 = ((spatial >> 1) + f.bwd1_pos) >> 8;
+    uint8_t idx4 = ((spatial >> 2) + f.bwd2_pos) >> 8;
 
     // BRIGHTER base ocean color for low brightness visibility
     CRGB c = CRGB(16, 48, 64);
 
     // Layer 1 (palette 1, forward)
     CRGB layer1 = pacifica_cache_color(1, idx1);
-    c.r = qadd8(c.r, scale8(layer1.r, bri1));
-    c.g = qadd8(c.g, scale8(layer1.g, bri1));
-    c.b = qadd8(c.b, scale8(layer1.b, bri1));
+    c.r = qadd8(c.r, scale8(layer1.r, f.bri1));
+    c.g = qadd8(c.g, scale8(layer1.g, f.bri1));
+    c.b = qadd8(c.b, scale8(layer1.b, f.bri1));
 
     // Layer 2 (palette 2, forward)
     CRGB layer2 = pacifica_cache_color(2, idx2);
-    c.r = qadd8(c.r, scale8(layer2.r, bri2));
-    c.g = qadd8(c.g, scale8(layer2.g, bri2));
-    c.b = qadd8(c.b, scale8(layer2.b, bri2));
+    c.r = qadd8(c.r, scale8(layer2.r, f.bri2));
+    c.g = qadd8(c.g, scale8(layer2.g, f.bri2));
+    c.b = qadd8(c.b, scale8(layer2.b, f.bri2));
 
     // Layer 3 (palette 3, backward)
     CRGB layer3 = pacifica_cache_color(3, idx3);
-    c.r = qadd8(c.r, scale8(layer3.r, bri3));
-    c.g = qadd8(c.g, scale8(layer3.g, bri3));
-    c.b = qadd8(c.b, scale8(layer3.b, bri3));
+    c.r = qadd8(c.r, scale8(layer3.r, f.bri3));
+    c.g = qadd8(c.g, scale8(layer3.g, f.bri3));
+    c.b = qadd8(c.b, scale8(layer3.b, f.bri3));
 
     // Layer 4 (palette 3, backward different freq)
     CRGB layer4 = pacifica_cache_color(3, idx4);
-    c.r = qadd8(c.r, scale8(layer4.r, bri4));
-    c.g = qadd8(c.g, scale8(layer4.g, bri4));
-    c.b = qadd8(c.b, scale8(layer4.b, bri4));
+    c.r = qadd8(c.r, scale8(layer4.r, f.bri4));
+    c.g = qadd8(c.g, scale8(layer4.g, f.bri4));
+    c.b = qadd8(c.b, scale8(layer4.b, f.bri4));
 
     // === COLLISION WHITECAPS (ambient-friendly) ===
     uint8_t fwd_bright = (layer1.b + layer2.b) >> 1;
@@ -1779,7 +1695,7 @@ uint16_t mode_ocean() {
 
     // Additional whitecaps on very bright areas
     uint8_t l = (c.r + c.g + c.b) / 3;
-    uint8_t threshold = scale8(sin8(wave_threshold + (i * 7)), 20) + 45;
+    uint8_t threshold = scale8(sin8(f.wave_threshold + (i * 7)), 20) + 45;
     if (l > threshold) {
       uint8_t overage = l - threshold;
       c.r = qadd8(c.r, overage >> 1);
@@ -1800,32 +1716,170 @@ uint16_t mode_ocean() {
     // GAMMA CORRECTION: Apply gamma to final linear output to simulate
     // "deep ocean" contrast which was previously provided by the driver's
     // gamma correction.
-    instance->_segment.setPixelColor(i, RGBW32(instance->applyGamma(c.r),
-                                               instance->applyGamma(c.g),
-                                               instance->applyGamma(c.b), 0));
+    ctx.pixels[i] = RGBW32(runner->applyGamma(c.r), runner->applyGamma(c.g),
+                           runner->applyGamma(c.b), 0);
   }
+}
+
+// --- Ocean Effect ---
+// Inspired by WLED's Pacifica, optimized for long strips and ambient
+// lighting. Uses bidirectional wave interference with collision-based
+// whitecaps.
+uint16_t mode_ocean(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
+  // === FRAME DIAGNOSTICS (enabled with CFX_FRAME_DIAGNOSTICS) ===
+  static cfx::FrameDiagnostics ocean_diag;
+  ocean_diag.frame_start();
+  ocean_diag.maybe_log("Ocean");
+
+  if (!instance)
+    return 350;
+
+  uint8_t speed = instance->_segment.speed;
+
+  // Time base - uniform for all pixels (no position-dependent acceleration)
+  uint32_t now = cfx_millis();
+  uint32_t t = cfx::scale_time(now, speed + 1, 7);
+
+  // === WAVE POSITIONS (time-based, moves independently of strip position)
+  // === Forward waves (move from start to end)
+  uint16_t fwd1_pos = (t * 5); // Slow forward
+  uint16_t fwd2_pos = (t * 7); // Medium forward
+
+  // Backward waves (move from end to start)
+  uint16_t bwd1_pos = -(t * 6); // Slow backward
+  uint16_t bwd2_pos = -(t * 9); // Medium backward
+
+  // BOOSTED layer brightness for low global brightness visibility
+  // Higher values = more visible at low brightness settings
+  uint8_t bri1 = 140 + ((sin8((t >> 3) & 0xFF) * 80) >> 8); // 140-220
+  uint8_t bri2 = 130 + ((sin8((t >> 4) & 0xFF) * 70) >> 8); // 130-200
+  uint8_t bri3 = 120 + ((sin8((t >> 5) & 0xFF) * 60) >> 8); // 120-180
+  uint8_t bri4 = 100 + ((sin8((t >> 6) & 0xFF) * 50) >> 8); // 100-150
+
+  // Whitecap base
+  uint8_t wave_threshold = (t >> 2) & 0xFF;
+
+  const OceanFrame frame{fwd1_pos, fwd2_pos, bwd1_pos, bwd2_pos, bri1,
+                         bri2,     bri3,     bri4,     wave_threshold};
+  renderSpans(ctx, ocean_span, &frame);
 
   return FRAMETIME;
 }
 
+struct PlasmaFrame {
+  uint8_t *prevColors; // per-pixel smoothing state, span-local writes
+  const uint32_t *palette;
+  uint8_t spatialScale;
+  int8_t thisPhase;
+  int8_t thatPhase;
+  uint8_t blendSpeed;
+  uint8_t intensity;
+  uint16_t width; // matrix columns, 0 on a strip
+};
+
+static inline void plasma_pixel(const RenderContext &ctx, const PlasmaFrame &f,
+                                int i, uint8_t spatialPhase) {
+  // Color index from interfering waves - both use SAME spatial base
+  uint8_t colorInput = (spatialPhase + f.thisPhase) & 0xFF;
+  uint8_t targetIndex =
+      sin8(colorInput) + ((cos8_t(colorInput + 64) - 128) >> 1);
+
+  // Temporal smoothing: blend toward target for liquid feel
+  uint8_t prevIndex = f.prevColors[i];
+  int16_t diff = (int16_t)targetIndex - (int16_t)prevIndex;
+  int16_t step = (diff * f.blendSpeed) >> 8;
+  if (step == 0 && diff != 0)
+    step = (diff > 0) ? 1 : -1;
+  uint8_t smoothIndex = prevIndex + step;
+  f.prevColors[i] = smoothIndex;
+
+  // === BRIGHTNESS MODULATION controlled by INTENSITY slider ===
+  // Low intensity = deep voids (high contrast, can reach near-black)
+  // High intensity = uniform brightness (fills in voids)
+  uint8_t intensity = f.intensity;
+
+  uint8_t briInput = (spatialPhase * 2 + f.thatPhase + 64) & 0xFF;
+  uint8_t rawBri = sin8(briInput);
+
+  // Apply gamma correction to rawBri for deep contrast curve
+  // REMOVED dim8_video (x^2) to soften the curve because x^3.5 is steep
+  // enough. This widens the blocks and reduces the "void" effect.
+  uint8_t gammaBri = rawBri;
+
+  // Calculate contrast depth from intensity with SHIFTED QUADRATIC curve
+  // Shifted so intensity=128 (default) gives same fill as intensity=90
+  // would This provides more voids at the default setting
+  int16_t shifted = (int16_t)intensity - 38; // Shift down by 38
+  if (shifted < 0)
+    shifted = 0;
+  uint8_t fillAmount = ((uint16_t)shifted * shifted) >> 8; // Quadratic: 0-185
+
+  // Start from gammaBri, add fillAmount to bring up the lows
+  // At intensity=0-38: brightness = gammaBri (deep voids)
+  // At intensity=128: brightness = gammaBri + ~12% fill (visible voids)
+  // At intensity=255: brightness = ~185 fill (mostly uniform)
+  uint16_t brightness16 = gammaBri + ((fillAmount * (255 - gammaBri)) >> 8);
+
+  // Very low floor of 8 (3%) to prevent true black but allow deep voids
+  // THEN APPLY GAMMA to the whole thing to crush the floor at Gamma 1.0
+  uint8_t brightness = (brightness16 < 8) ? 8 : (uint8_t)brightness16;
+  brightness = ctx.runner->applyGamma(brightness);
+
+  // Get color from palette with gamma-corrected brightness
+  CRGBW c =
+      ColorFromPalette(ctx.runner, f.palette, smoothIndex, brightness);
+  ctx.pixels[i] = RGBW32(c.r, c.g, c.b, c.w);
+}
+
+static void plasma_span(const RenderContext &ctx, const void *frame,
+                        uint16_t begin, uint16_t end) {
+  const auto &f = *static_cast<const PlasmaFrame *>(frame);
+  // === UNIFIED spatial phase - single value for all calculations ===
+  // This creates cohesive color pools without "dual pattern" artifacts
+  for (int i = begin; i < end; i++)
+    plasma_pixel(ctx, f, i, (i * f.spatialScale) & 0xFF);
+}
+
+// Matrix: the spatial phase is the mean of one wave per axis, each drifting
+// with its own phase. Matrix sides are short next to a strip, so the axes
+// run at four times the strip's spatial rate.
+static void plasma_span_2d(const RenderContext &ctx, const void *frame,
+                           uint16_t begin, uint16_t end) {
+  const auto &f = *static_cast<const PlasmaFrame *>(frame);
+  const uint8_t rate = f.spatialScale * 4;
+  int x = begin % f.width;
+  int y = begin / f.width;
+  for (int i = begin; i < end; i++) {
+    const uint8_t wx = sin8((uint8_t)(x * rate + f.thisPhase));
+    const uint8_t wy = sin8((uint8_t)(y * rate - f.thatPhase));
+    plasma_pixel(ctx, f, i, (uint8_t)((wx + wy) >> 1));
+    if (++x == f.width) {
+      x = 0;
+      y++;
+    }
+  }
+}
+
 // --- Plasma Effect (ID 101) ---
 // Ported from WLED FX.cpp by Andrew Tuline
 // Smooth, liquid organic effect using wave mixing
 // Fixed: Drastically reduced spatial freq (wide gradients) + slow temporal
 // drift
-uint16_t mode_plasma(void) {
+uint16_t mode_plasma(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // Allocate storage for previous color indices (for temporal smoothing)
   if (!instance->_segment.allocateData(len)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(len)); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
   uint8_t *prevColors = instance->_segment.data;
 
@@ -1865,82 +1919,79 @@ uint16_t mode_plasma(void) {
   // Get active palette
   const uint32_t *active_palette;
   if (instance->_segment.palette == 0) {
-    active_palette = getPaletteByIndex(7); // Party palette default
+    active_palette = getPaletteByIndex(instance, 7); // Party palette default
   } else {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   }
+  primePalette(instance, active_palette);
 
-  for (int i = 0; i < len; i++) {
-    // === UNIFIED spatial phase - single value for all calculations ===
-    // This creates cohesive color pools without "dual pattern" artifacts
-    uint8_t spatialPhase = (i * spatialScale) & 0xFF;
-
-    // Color index from interfering waves - both use SAME spatial base
-    uint8_t colorInput = (spatialPhase + thisPhase) & 0xFF;
-    uint8_t targetIndex =
-        sin8(colorInput) + ((cos8_t(colorInput + 64) - 128) >> 1);
-
-    // Temporal smoothing: blend toward target for liquid feel
-    uint8_t prevIndex = prevColors[i];
-    int16_t diff = (int16_t)targetIndex - (int16_t)prevIndex;
-    int16_t step = (diff * blendSpeed) >> 8;
-    if (step == 0 && diff != 0)
-      step = (diff > 0) ? 1 : -1;
-    uint8_t smoothIndex = prevIndex + step;
-    prevColors[i] = smoothIndex;
-
-    // === BRIGHTNESS MODULATION controlled by INTENSITY slider ===
-    // Low intensity = deep voids (high contrast, can reach near-black)
-    // High intensity = uniform brightness (fills in voids)
-    uint8_t intensity = instance->_segment.intensity;
-
-    uint8_t briInput = (spatialPhase * 2 + thatPhase + 64) & 0xFF;
-    uint8_t rawBri = sin8(briInput);
-
-    // Apply gamma correction to rawBri for deep contrast curve
-    // REMOVED dim8_video (x^2) to soften the curve because x^3.5 is steep
-    // enough. This widens the blocks and reduces the "void" effect.
-    uint8_t gammaBri = rawBri;
-
-    // Calculate contrast depth from intensity with SHIFTED QUADRATIC curve
-    // Shifted so intensity=128 (default) gives same fill as intensity=90
-    // would This provides more voids at the default setting
-    int16_t shifted = (int16_t)intensity - 38; // Shift down by 38
-    if (shifted < 0)
-      shifted = 0;
-    uint8_t fillAmount = ((uint16_t)shifted * shifted) >> 8; // Quadratic: 0-185
-
-    // Start from gammaBri, add fillAmount to bring up the lows
-    // At intensity=0-38: brightness = gammaBri (deep voids)
-    // At intensity=128: brightness = gammaBri + ~12% fill (visible voids)
-    // At intensity=255: brightness = ~185 fill (mostly uniform)
-    uint16_t brightness16 = gammaBri + ((fillAmount * (255 - gammaBri)) >> 8);
-
-    // Very low floor of 8 (3%) to prevent true black but allow deep voids
-    // THEN APPLY GAMMA to the whole thing to crush the floor at Gamma 1.0
-    uint8_t brightness = (brightness16 < 8) ? 8 : (uint8_t)brightness16;
-    brightness = instance->applyGamma(brightness);
-
-    // Get color from palette with gamma-corrected brightness
-    CRGBW c = ColorFromPalette(active_palette, smoothIndex, brightness);
-    instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
-  }
+  const bool grid = instance->_segment.is2D();
+  const PlasmaFrame frame{prevColors,  active_palette, spatialScale,
+                          thisPhase,   thatPhase,      blendSpeed,
+                          instance->_segment.intensity,
+                          (uint16_t)(grid ? instance->_segment.virtualWidth()
+                                          : 0)};
+  renderSpans(ctx, grid ? plasma_span_2d : plasma_span, &frame);
 
   instance->_segment.call++;
   return FRAMETIME;
 }
 
+struct PrideFrame {
+  const uint32_t *palette;
+  uint16_t hue16;
+  uint16_t hueinc16;
+  uint8_t saturation;
+};
+
+static void pride_2015_span(const RenderContext &ctx, const void *frame,
+                            uint16_t begin, uint16_t end) {
+  const auto &f = *static_cast<const PrideFrame *>(frame);
+  // Hue accumulates per pixel; jump straight to this span's first pixel.
+  uint16_t hue16 = f.hue16 + (uint16_t)(begin * f.hueinc16);
+  for (int i = begin; i < end; i++) {
+    // Accumulate hue
+    hue16 += f.hueinc16;
+    uint8_t hue8 = hue16 >> 8;
+
+    // Get color at full brightness
+    CRGBW c = ColorFromPalette(ctx.runner, f.palette, hue8, 255);
+
+    // Apply saturation (blend toward white at low intensity)
+    if (f.saturation < 255) {
+      uint8_t white_blend = 255 - f.saturation;
+      c.r = c.r + ((255 - c.r) * white_blend >> 8);
+      c.g = c.g + ((255 - c.g) * white_blend >> 8);
+      c.b = c.b + ((255 - c.b) * white_blend >> 8);
+    }
+
+    // Blend with existing for smooth transitions
+    uint32_t existing = ctx.pixels[i];
+    uint8_t er = (existing >> 16) & 0xFF;
+    uint8_t eg = (existing >> 8) & 0xFF;
+    uint8_t eb = existing & 0xFF;
+
+    uint8_t blend = 64;
+    uint8_t nr = er + (((int16_t)(c.r - er) * blend) >> 8);
+    uint8_t ng = eg + (((int16_t)(c.g - eg) * blend) >> 8);
+    uint8_t nb = eb + (((int16_t)(c.b - eb) * blend) >> 8);
+
+    ctx.pixels[i] = RGBW32(nr, ng, nb, c.w);
+  }
+}
+
 // --- Colorwaves Effect (ID 63, formerly Pride 2015) ---
 // Ported from WLED FX.cpp mode_colorwaves_pride_base(true)
 // Author: Mark Kriegsman
 // Modified: Uniform brightness, intensity controls saturation
-uint16_t mode_pride_2015(void) {
+uint16_t mode_pride_2015(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // WLED formula: duration = 10 + speed
   // At 60fps vs WLED's 42fps, we're 1.4x faster, so use 70%
@@ -1965,8 +2016,9 @@ uint16_t mode_pride_2015(void) {
   if (instance->_segment.palette == 0) {
     active_palette = PaletteRainbow;
   } else {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   }
+  primePalette(instance, active_palette);
 
   // Intensity controls saturation (same as Colorloop)
   // 0 = white, 128 = default full saturation, 255 = pure colors
@@ -1977,36 +2029,8 @@ uint16_t mode_pride_2015(void) {
     saturation = intensity * 2;
   }
 
-  // Process all pixels - UNIFORM BRIGHTNESS (no banding)
-  for (int i = 0; i < len; i++) {
-    // Accumulate hue
-    hue16 += hueinc16;
-    uint8_t hue8 = hue16 >> 8;
-
-    // Get color at full brightness
-    CRGBW c = ColorFromPalette(active_palette, hue8, 255);
-
-    // Apply saturation (blend toward white at low intensity)
-    if (saturation < 255) {
-      uint8_t white_blend = 255 - saturation;
-      c.r = c.r + ((255 - c.r) * white_blend >> 8);
-      c.g = c.g + ((255 - c.g) * white_blend >> 8);
-      c.b = c.b + ((255 - c.b) * white_blend >> 8);
-    }
-
-    // Blend with existing for smooth transitions
-    uint32_t existing = instance->_segment.getPixelColor(i);
-    uint8_t er = (existing >> 16) & 0xFF;
-    uint8_t eg = (existing >> 8) & 0xFF;
-    uint8_t eb = existing & 0xFF;
-
-    uint8_t blend = 64;
-    uint8_t nr = er + (((int16_t)(c.r - er) * blend) >> 8);
-    uint8_t ng = eg + (((int16_t)(c.g - eg) * blend) >> 8);
-    uint8_t nb = eb + (((int16_t)(c.b - eb) * blend) >> 8);
-
-    instance->_segment.setPixelColor(i, RGBW32(nr, ng, nb, c.w));
-  }
+  const PrideFrame frame{active_palette, hue16, hueinc16, saturation};
+  renderSpans(ctx, pride_2015_span, &frame);
 
   // Save state
 
@@ -2019,13 +2043,14 @@ uint16_t mode_pride_2015(void) {
 // --- Breathe Effect (ID 2) ---
 // Does the "standby-breathing" of well known i-Devices
 // Author: WLED Team
-uint16_t mode_breath(void) {
+uint16_t mode_breath(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // === WLED-FAITHFUL TIMING using centralized helper ===
   // Use segment.step as per-instance timing state (avoids static variable
@@ -2070,8 +2095,9 @@ uint16_t mode_breath(void) {
     } else {
       // Use palette color as foreground (0-19)
       const uint32_t *active_palette =
-          getPaletteByIndex(instance->_segment.palette);
-      CRGBW c = ColorFromPalette(active_palette, (i * 256 / len), 255);
+          getPaletteByIndex(instance, instance->_segment.palette);
+      CRGBW c =
+          ColorFromPalette(instance, active_palette, (i * 256 / len), 255);
       fgR = c.r;
       fgG = c.g;
       fgB = c.b;
@@ -2101,13 +2127,14 @@ uint16_t mode_breath(void) {
 // --- Dissolve Effect (ID 18) ---
 // Fill -> Hold ON -> Dissolve Out -> Hold OFF cycle
 // Uses SHADOW BITMASK for persistence (hardware buffer cleared every frame)
-uint16_t mode_dissolve(void) {
+uint16_t mode_dissolve(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // Shadow buffer size: 1 bit per pixel, rounded up to bytes
   uint16_t shadow_size = (len + 7) / 8;
@@ -2117,7 +2144,7 @@ uint16_t mode_dissolve(void) {
   if (!instance->_segment.allocateData(shadow_size)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(shadow_size)); // CFX-007
-    return mode_static();            // Allocation failed
+    return mode_static(ctx);            // Allocation failed
   }
 
   // Reset state on fresh allocation (allocateData zeros memory for us)
@@ -2290,7 +2317,7 @@ uint16_t mode_dissolve(void) {
       fillSolidPalette(instance->_segment.colors[0]);
       active_palette = activeSolidPalette();
     } else {
-      active_palette = getPaletteByIndex(instance->_segment.palette);
+      active_palette = getPaletteByIndex(instance, instance->_segment.palette);
     }
   }
 
@@ -2343,7 +2370,7 @@ uint16_t mode_dissolve(void) {
         instance->_segment.setPixelColor(i, RGBW32(col.r, col.g, col.b, col.w));
       } else {
         uint8_t hue = (i * 255 / len);
-        CRGBW col = ColorFromPalette(active_palette, hue, 255);
+        CRGBW col = ColorFromPalette(instance, active_palette, hue, 255);
         instance->_segment.setPixelColor(i, RGBW32(col.r, col.g, col.b, col.w));
       }
     } else {
@@ -2373,13 +2400,14 @@ uint16_t mode_dissolve(void) {
 // --- Juggle Effect (ID 64) ---
 // Eight colored dots weaving in and out of sync
 // Author: FastLED DemoReel100
-uint16_t mode_juggle(void) {
+uint16_t mode_juggle(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // Fade to black (trail effect)
   // Fix: Old formula was too fast (short tail) and hit 0 at high intensity
@@ -2397,7 +2425,7 @@ uint16_t mode_juggle(void) {
   if (instance->_segment.palette == 0) {
     active_palette = PaletteRainbow;
   } else {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   }
 
   // 8 bouncing dots
@@ -2416,7 +2444,7 @@ uint16_t mode_juggle(void) {
       c = CRGBW((col >> 16) & 0xFF, (col >> 8) & 0xFF, col & 0xFF,
                 (col >> 24) & 0xFF);
     } else {
-      c = ColorFromPalette(active_palette, dothue, 255);
+      c = ColorFromPalette(instance, active_palette, dothue, 255);
     }
 
     // Additive blend
@@ -2436,20 +2464,21 @@ uint16_t mode_juggle(void) {
 
 // --- Flow Effect (ID 110) ---
 // Best of both worlds from Palette and Spot effects. By Aircoookie
-uint16_t mode_flow(void) {
+uint16_t mode_flow(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // Get palette
   const uint32_t *active_palette;
   if (instance->_segment.palette == 0) {
     active_palette = PaletteRainbow;
   } else {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   }
 
   // === WLED-FAITHFUL TIMING ===
@@ -2474,7 +2503,7 @@ uint16_t mode_flow(void) {
 
   // Fill background with counter-colored palette
   uint8_t bgIndex = (uint8_t)(256 - counter);
-  CRGBW bgColor = ColorFromPalette(active_palette, bgIndex, 255);
+  CRGBW bgColor = ColorFromPalette(instance, active_palette, bgIndex, 255);
   for (int i = 0; i < len; i++) {
     instance->_segment.setPixelColor(
         i, RGBW32(bgColor.r, bgColor.g, bgColor.b, bgColor.w));
@@ -2486,7 +2515,7 @@ uint16_t mode_flow(void) {
     for (int i = 0; i < zoneLen; i++) {
       uint8_t colorIndex = (i * 255 / zoneLen) - (uint8_t)counter;
       int led = (z & 0x01) ? i : (zoneLen - 1) - i;
-      CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
+      CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
       instance->_segment.setPixelColor(pos + led, RGBW32(c.r, c.g, c.b, c.w));
     }
   }
@@ -2496,13 +2525,14 @@ uint16_t mode_flow(void) {
 
 // --- Phased Effect (ID 105) ---
 // Continuous Moiré interference pattern using opposing sub-pixel sine waves
-uint16_t mode_phased(void) {
+uint16_t mode_phased(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   uint16_t len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   uint8_t speed = instance->_segment.speed;
   uint8_t intensity = instance->_segment.intensity;
@@ -2524,7 +2554,7 @@ uint16_t mode_phased(void) {
   const uint32_t *active_palette =
       instance->_segment.palette == 0
           ? PaletteRainbow
-          : getPaletteByIndex(instance->_segment.palette);
+          : getPaletteByIndex(instance, instance->_segment.palette);
 
   // Determine starting color index (drifts slowly over time)
   uint8_t color_idx_start = (instance->now >> 6) & 0xFF;
@@ -2554,7 +2584,8 @@ uint16_t mode_phased(void) {
     // the strip)
     uint8_t colorIndex = color_idx_start + ((i * 255) / len);
 
-    CRGBW c = ColorFromPalette(active_palette, colorIndex, (uint8_t)bri);
+    CRGBW c =
+        ColorFromPalette(instance, active_palette, colorIndex, (uint8_t)bri);
     instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
   }
 
@@ -2582,13 +2613,14 @@ static inline uint8_t triwave8(uint8_t in) {
   return out;
 }
 
-uint16_t mode_ripple(void) {
+uint16_t mode_ripple(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   uint32_t delta = instance->frame_time;
   if (delta < 1)
@@ -2604,7 +2636,7 @@ uint16_t mode_ripple(void) {
   if (!instance->_segment.allocateData(dataSize)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(dataSize)); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
 
   RippleState *ripples = (RippleState *)instance->_segment.data;
@@ -2644,7 +2676,7 @@ uint16_t mode_ripple(void) {
 
   const uint32_t *active_palette = nullptr;
   if (instance->_segment.palette != 0) {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   } else {
     active_palette = PaletteRainbow;
   }
@@ -2713,7 +2745,8 @@ uint16_t mode_ripple(void) {
       uint32_t c = instance->_segment.colors[0];
       col = c;
     } else {
-      CRGBW c = ColorFromPalette(active_palette, ripples[i].color, 255);
+      CRGBW c =
+          ColorFromPalette(instance, active_palette, ripples[i].color, 255);
       col = RGBW32(c.r, c.g, c.b, c.w);
     }
 
@@ -2789,13 +2822,14 @@ uint16_t mode_ripple(void) {
 // --- Meteor Effect (ID 76) ---
 // Meteor with random decay trail
 // Simplified version (no allocateData)
-uint16_t mode_meteor(void) {
+uint16_t mode_meteor(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // Get palette - WLED default is solid color, not Fire
   const uint32_t *active_palette = nullptr;
@@ -2807,7 +2841,7 @@ uint16_t mode_meteor(void) {
   } else if (instance->_segment.palette == 255) {
     use_solid_color = true;
   } else {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   }
 
   // === WLED-FAITHFUL TIMING ===
@@ -2827,9 +2861,13 @@ uint16_t mode_meteor(void) {
   // if (hw_random8() <= 255 - SEGMENT.intensity) { scale8(trail,
   // 128+random(127)) } High intensity = fewer pixels decay = longer trail
   // Low intensity = more pixels decay = shorter trail
+  uint8_t gate[64];
   for (int i = 0; i < len; i++) {
-    // Probability check: higher intensity = fewer pixels decay per frame
-    if (hw_random8() <= 255 - instance->_segment.intensity) {
+    // Probability check: higher intensity = fewer pixels decay per frame.
+    // Gate bytes are drawn in bulk, one stream word per four pixels.
+    if ((i & 63) == 0)
+      cfx::random_fill(gate, std::min<int>(sizeof(gate), len - i));
+    if (gate[i & 63] <= 255 - instance->_segment.intensity) {
       uint32_t c = instance->_segment.getPixelColor(i);
       uint8_t r = (c >> 16) & 0xFF;
       uint8_t g = (c >> 8) & 0xFF;
@@ -2873,7 +2911,7 @@ uint16_t mode_meteor(void) {
       // Reverted to this state as "Static Peak" was too flat.
       // 1. Dynamic Indexing: Brings back rich colors for Ocean/Rainbow.
       uint8_t colorIndex = (index * 10) + (instance->now >> 4);
-      CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
+      CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
 
       // 2. White Energy Boost (Universal)
       // Inject white to guarantee visibility for all palettes.
@@ -2888,16 +2926,63 @@ uint16_t mode_meteor(void) {
   return FRAMETIME;
 }
 
+struct NoisePalFrame {
+  const CRGBPalette16 *palette;
+  uint16_t scale;
+  uint16_t noise_y;
+  uint16_t width; // matrix columns, 0 on a strip
+};
+
+// Noise is sampled in row batches so lattice hashes are shared per cell.
+static void noisepal_span(const RenderContext &ctx, const void *frame,
+                          uint16_t begin, uint16_t end) {
+  const auto &f = *static_cast<const NoisePalFrame *>(frame);
+  uint16_t noise_x = f.scale * begin;
+  uint16_t noise_y = f.noise_y + f.scale * begin;
+  uint8_t indices[64];
+  for (int i = begin; i < end; i += sizeof(indices)) {
+    uint16_t n = (uint16_t)std::min<int>(sizeof(indices), end - i);
+    cfx::inoise8_line(indices, n, noise_x, noise_y, f.scale, f.scale);
+    for (uint16_t j = 0; j < n; j++) {
+      CRGB c = ColorFromPalette(*f.palette, indices[j], 255, LINEARBLEND);
+      ctx.pixels[i + j] = RGBW32(c.r, c.g, c.b, 0);
+    }
+    noise_x += f.scale * n;
+    noise_y += f.scale * n;
+  }
+}
+
+// Matrix: x and y walk the noise plane, batched along each row.
+static void noisepal_span_2d(const RenderContext &ctx, const void *frame,
+                             uint16_t begin, uint16_t end) {
+  const auto &f = *static_cast<const NoisePalFrame *>(frame);
+  uint8_t indices[64];
+  for (int i = begin; i < end;) {
+    const int x = i % f.width;
+    const int y = i / f.width;
+    const uint16_t n = (uint16_t)std::min<int>(
+        sizeof(indices), std::min<int>(end - i, f.width - x));
+    cfx::inoise8_line(indices, n, f.scale * x, f.noise_y + f.scale * y,
+                      f.scale, 0);
+    for (uint16_t j = 0; j < n; j++) {
+      CRGB c = ColorFromPalette(*f.palette, indices[j], 255, LINEARBLEND);
+      ctx.pixels[i + j] = RGBW32(c.r, c.g, c.b, 0);
+    }
+    i += n;
+  }
+}
+
 // --- Noise Pal Effect (ID 107) ---
 // Slow noise palette by Andrew Tuline. WLED-faithful port.
 // Uses true 2D Perlin noise + dynamic palette generation/blending.
-uint16_t mode_noisepal(void) {
+uint16_t mode_noisepal(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // Allocate space for 2 CRGBPalette16: current (palettes[0]) + target
   // (palettes[1])
@@ -2905,7 +2990,7 @@ uint16_t mode_noisepal(void) {
   if (!instance->_segment.allocateData(dataSize)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(dataSize)); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
   CRGBPalette16 *palettes =
       reinterpret_cast<CRGBPalette16 *>(instance->_segment.data);
@@ -2946,7 +3031,8 @@ uint16_t mode_noisepal(void) {
         palettes[0].entries[i] = blend(dim, c, ramp);
       }
     } else {
-      const uint32_t *user_pal = getPaletteByIndex(instance->_segment.palette);
+      const uint32_t *user_pal =
+          getPaletteByIndex(instance, instance->_segment.palette);
       // Convert uint32_t palette to CRGBPalette16
       for (int i = 0; i < 16; i++) {
         palettes[0].entries[i] = CRGB(user_pal[i]);
@@ -2955,15 +3041,11 @@ uint16_t mode_noisepal(void) {
   }
 
   // Render: Perlin noise mapped to palette â€” WLED exact
-  uint16_t noise_x = 0;
-  uint16_t noise_y = instance->_segment.aux0;
-  for (int i = 0; i < len; i++) {
-    uint8_t index = inoise8(noise_x, noise_y);
-    CRGB c = ColorFromPalette(palettes[0], index, 255, LINEARBLEND);
-    instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, 0));
-    noise_x += scale;
-    noise_y += scale;
-  }
+  const bool grid = instance->_segment.is2D();
+  const NoisePalFrame frame{
+      &palettes[0], (uint16_t)scale, instance->_segment.aux0,
+      (uint16_t)(grid ? instance->_segment.virtualWidth() : 0)};
+  renderSpans(ctx, grid ? noisepal_span_2d : noisepal_span, &frame);
 
   // Organic Y-axis drift â€” WLED exact
   instance->_segment.aux0 += beatsin8_t(10, 1, 4);
@@ -2972,8 +3054,9 @@ uint16_t mode_noisepal(void) {
 }
 
 // --- Chase 2 (ID 28) ---
-static uint16_t chase(uint32_t color1, uint32_t color2, uint32_t color3,
-                      bool do_palette) {
+static uint16_t chase(RenderContext &ctx, uint32_t color1, uint32_t color2,
+                      uint32_t color3, bool do_palette) {
+  CFXRunner *const instance = ctx.runner;
   uint32_t len = instance->_segment.length();
   uint32_t speed = instance->_segment.speed;
 
@@ -2989,9 +3072,14 @@ static uint16_t chase(uint32_t color1, uint32_t color2, uint32_t color3,
   // Smooth cubic speed mapping. Max ~350 pixels/sec.
   float s = (float)speed / 255.0f;
   float pps = 2.0f + (s * s * s) * 350.0f;
-  float offset = (instance->now * pps) / 1000.0f;
+  // Integrated per frame: a float now * pps stops resolving sub-pixel steps
+  // after a few hours of uptime. Wrapped to the cycle, which is the strip.
+  instance->_segment.phase.advance(instance->frame_time,
+                                   (uint32_t)(pps * 65.536f));
+  float offset =
+      (float)instance->_segment.phase.wrap(len << 16) / 65536.0f;
 
-  instance->current_leading_pixel = (int32_t)fmodf(offset, (float)len);
+  instance->current_leading_pixel = (int32_t)offset;
 
   // Aliasing fade zone (0.6px minimum to prevent integer snaps at low
   // speeds)
@@ -3053,11 +3141,12 @@ static uint16_t chase(uint32_t color1, uint32_t color2, uint32_t color3,
   return FRAMETIME;
 }
 
-uint16_t mode_chase_color(void) {
+uint16_t mode_chase_color(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   bool do_palette =
       (instance->_segment.palette != 255 && instance->_segment.palette != 0);
 
-  return chase(instance->_segment.colors[1],
+  return chase(ctx, instance->_segment.colors[1],
                (instance->_segment.colors[2]) ? instance->_segment.colors[2]
                                               : instance->_segment.colors[0],
                instance->_segment.colors[0], do_palette);
@@ -3066,13 +3155,14 @@ uint16_t mode_chase_color(void) {
 // --- BPM Effect (ID 68) ---
 // Rhythmic pulsing bands of light synchronized to a precision global master
 // beat.
-uint16_t mode_bpm(void) {
+uint16_t mode_bpm(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   uint16_t len = instance->_segment.length();
   if (len == 0)
-    return mode_static();
+    return mode_static(ctx);
 
   uint8_t speed = instance->_segment.speed;
   uint8_t intensity = instance->_segment.intensity;
@@ -3105,7 +3195,7 @@ uint16_t mode_bpm(void) {
   uint32_t spatial_offset = instance->_segment.step >> 6;
 
   int center = len / 2;
-  const uint32_t *pal = getPaletteByIndex(instance->_segment.palette);
+  const uint32_t *pal = getPaletteByIndex(instance, instance->_segment.palette);
   bool is_solid = (instance->_segment.palette == 255);
   uint32_t solid_color = is_solid ? instance->_segment.colors[0] : 0;
 
@@ -3129,7 +3219,7 @@ uint16_t mode_bpm(void) {
     if (is_solid) {
       c = solid_color;
     } else {
-      CRGBW pal_c = ColorFromPalette(pal, color_idx, 255);
+      CRGBW pal_c = ColorFromPalette(instance, pal, color_idx, 255);
       c = RGBW32(pal_c.r, pal_c.g, pal_c.b, pal_c.w);
     }
 
@@ -3147,7 +3237,8 @@ uint16_t mode_bpm(void) {
 
 // --- Glitter (ID 87) ---
 // Two-pass: Inverted Palette Background + Random White Sparks (No Fading)
-uint16_t mode_glitter(void) {
+uint16_t mode_glitter(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
@@ -3157,8 +3248,8 @@ uint16_t mode_glitter(void) {
   // Rainbow if none selected or if default/0 is selected)
   const uint32_t *active_palette =
       (instance->_segment.palette == 0)
-          ? getPaletteByIndex(4) // Force Rainbow (ID 4) as default
-          : getPaletteByIndex(instance->_segment.palette);
+          ? getPaletteByIndex(instance, 4) // Force Rainbow (ID 4) as default
+          : getPaletteByIndex(instance, instance->_segment.palette);
 
   // Time base for scrolling
   // Speed factor: standard WLED-like scaling
@@ -3173,7 +3264,7 @@ uint16_t mode_glitter(void) {
     uint8_t colorIndex = (i * 255 / len) - (counter >> 8);
 
     // Render from palette
-    CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
+    CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
     instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
   }
 
@@ -3193,7 +3284,8 @@ uint16_t mode_glitter(void) {
 
 // --- Chase Multi (ID 54) ---
 // Simplified to 2-band chase: primary color + palette
-uint16_t mode_chase_multi(void) {
+uint16_t mode_chase_multi(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   uint32_t speed = instance->_segment.speed;
   uint32_t len = instance->_segment.length();
 
@@ -3207,10 +3299,16 @@ uint16_t mode_chase_multi(void) {
   float s = (float)speed / 255.0f;
   float pps = 2.0f + (s * s * s) * 350.0f;
 
-  // Convert time to infinite physical pixel offset distance
-  float offset = (instance->now * pps) / 1000.0f;
+  // Integrated per frame (see chase(ctx)); the pattern only needs the offset
+  // modulo one cycle, the leading pixel modulo the strip.
+  instance->_segment.phase.advance(instance->frame_time,
+                                   (uint32_t)(pps * 65.536f));
+  float offset = (float)instance->_segment.phase.wrap(
+                     (uint32_t)(cycle_size * 65536.0f)) /
+                 65536.0f;
 
-  instance->current_leading_pixel = (int32_t)fmodf(offset, (float)len);
+  instance->current_leading_pixel =
+      (int32_t)(instance->_segment.phase.wrap(len << 16) >> 16);
 
   // Anti-aliasing fade zone to eliminate integer strobe jitter
   float w_half = width * 0.45f;
@@ -3275,7 +3373,8 @@ uint16_t mode_chase_multi(void) {
 // --- Percent Effect (ID 98) ---
 // Linear meter/progress bar based on Intensity (0-255 mapped to 0-100%)
 // Palette support: Solid (default), Rainbow, etc.
-uint16_t mode_percent(void) {
+uint16_t mode_percent(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   uint16_t len = instance->_segment.length();
   uint8_t percent = instance->_segment.intensity;
   // Map 0-255 to 0-len
@@ -3284,7 +3383,7 @@ uint16_t mode_percent(void) {
   const uint32_t *active_palette =
       (instance->_segment.palette == 0)
           ? activeSolidPalette() // Default to Solid
-          : getPaletteByIndex(instance->_segment.palette);
+          : getPaletteByIndex(instance, instance->_segment.palette);
 
   // Behavior:
   // If palette is Solid (255), use Primary Color.
@@ -3295,33 +3394,28 @@ uint16_t mode_percent(void) {
     active_palette = activeSolidPalette();
   }
 
-  for (int i = 0; i < len; i++) {
-    if (i < lit_len) {
-      // Lit portion
-      // Map palette to the *lit* length? Or whole length?
-      // "Meter" usually implies the color matches the position.
-      // Let's map palette to the WHOLE length, so green is always at 0, red
-      // always at 100 (if using heatmap)
-      CRGBW c = ColorFromPalette(active_palette, (i * 255) / len, 255);
-      instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
-    } else {
-      // Unlit portion
-      instance->_segment.setPixelColor(i, 0);
+  // Lit portion: map the palette to the WHOLE length, so green is always at
+  // 0 and red always at 100 (if using heatmap). "Meter" implies the color
+  // matches the position.
+  Segment &seg = instance->_segment;
+  uint32_t span[SPAN_CHUNK];
+  for (int c0 = 0; c0 < lit_len; c0 += SPAN_CHUNK) {
+    int n = std::min<int>(SPAN_CHUNK, lit_len - c0);
+    for (int k = 0; k < n; k++) {
+      CRGBW c =
+          ColorFromPalette(instance, active_palette, ((c0 + k) * 255) / len,
+                           255);
+      span[k] = RGBW32(c.r, c.g, c.b, c.w);
     }
+    seg.writeSpan(c0, span, n);
   }
+  // Unlit portion
+  seg.fillRange(lit_len, len - lit_len, 0);
 
   // Speed > 0: Add a subtle breathing effect to the lit portion
-  if (instance->_segment.speed > 0) {
-    uint8_t bri = beatsin88_t(instance->_segment.speed << 8, 200, 255);
-    for (int i = 0; i < lit_len; i++) {
-      uint32_t c = instance->_segment.getPixelColor(i);
-      // Scale brightness
-      uint8_t r = scale8(CFX_R(c), bri);
-      uint8_t g = scale8(CFX_G(c), bri);
-      uint8_t b = scale8(CFX_B(c), bri);
-      uint8_t w = scale8(CFX_W(c), bri);
-      instance->_segment.setPixelColor(i, RGBW32(r, g, b, w));
-    }
+  if (seg.speed > 0) {
+    uint8_t bri = beatsin88_t(seg.speed << 8, 200, 255);
+    seg.scaleRange(0, lit_len, bri);
   }
 
   return FRAMETIME;
@@ -3329,7 +3423,8 @@ uint16_t mode_percent(void) {
 
 // --- Percent Center Effect (ID 152) ---
 // Bi-directional meter from center based on Intensity
-uint16_t mode_percent_center(void) {
+uint16_t mode_percent_center(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   uint16_t len = instance->_segment.length();
   uint16_t center = len / 2;
   uint8_t percent = instance->_segment.intensity;
@@ -3340,41 +3435,36 @@ uint16_t mode_percent_center(void) {
   const uint32_t *active_palette =
       (instance->_segment.palette == 0)
           ? activeSolidPalette()
-          : getPaletteByIndex(instance->_segment.palette);
+          : getPaletteByIndex(instance, instance->_segment.palette);
 
   if (instance->_segment.palette == 0 || instance->_segment.palette == 255) {
     fillSolidPalette(instance->_segment.colors[0]);
     active_palette = activeSolidPalette();
   }
 
-  for (int i = 0; i < len; i++) {
-    int dist = abs(i - center);
-    if (dist <= lit_radius) {
-      // Lit
-      // Map palette from center (0) to edge (255)
-      // Or strip-linear? Strip-linear looks more Percent-like usually.
-      // Let's do strip-linear so it looks like a single bar revealed from
-      // center.
-      CRGBW c = ColorFromPalette(active_palette, (i * 255) / len, 255);
-      instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
-    } else {
-      instance->_segment.setPixelColor(i, 0);
+  // Lit window [center - radius, center + radius], strip-linear palette so
+  // it looks like a single bar revealed from center.
+  Segment &seg = instance->_segment;
+  int lit_start = center - lit_radius;
+  int lit_end = std::min<int>(len, center + lit_radius + 1);
+  uint32_t span[SPAN_CHUNK];
+  for (int c0 = lit_start; c0 < lit_end; c0 += SPAN_CHUNK) {
+    int n = std::min<int>(SPAN_CHUNK, lit_end - c0);
+    for (int k = 0; k < n; k++) {
+      CRGBW c =
+          ColorFromPalette(instance, active_palette, ((c0 + k) * 255) / len,
+                           255);
+      span[k] = RGBW32(c.r, c.g, c.b, c.w);
     }
+    seg.writeSpan(c0, span, n);
   }
+  seg.fillRange(0, lit_start, 0);
+  seg.fillRange(lit_end, len - lit_end, 0);
 
   // Breathing
-  if (instance->_segment.speed > 0) {
-    uint8_t bri = beatsin88_t(instance->_segment.speed << 8, 200, 255);
-    for (int i = 0; i < len; i++) {
-      if (abs(i - center) <= lit_radius) {
-        uint32_t c = instance->_segment.getPixelColor(i);
-        uint8_t r = scale8(CFX_R(c), bri);
-        uint8_t g = scale8(CFX_G(c), bri);
-        uint8_t b = scale8(CFX_B(c), bri);
-        uint8_t w = scale8(CFX_W(c), bri);
-        instance->_segment.setPixelColor(i, RGBW32(r, g, b, w));
-      }
-    }
+  if (seg.speed > 0) {
+    uint8_t bri = beatsin88_t(seg.speed << 8, 200, 255);
+    seg.scaleRange(lit_start, lit_end - lit_start, bri);
   }
 
   return FRAMETIME;
@@ -3382,20 +3472,21 @@ uint16_t mode_percent_center(void) {
 
 // --- Sunrise Effect (ID 104) ---
 // Gradual sunrise/sunset simulation
-uint16_t mode_sunrise(void) {
+uint16_t mode_sunrise(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // Get palette (default is Fire/Heat)
   const uint32_t *active_palette;
   if (instance->_segment.palette == 0) {
     active_palette = PaletteHeatColors; // Fire palette for sunrise
   } else {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   }
 
   // Calculate stage (0-65535) based on speed
@@ -3429,7 +3520,7 @@ uint16_t mode_sunrise(void) {
     wave = (wave >> 8) + ((wave * instance->_segment.intensity) >> 15);
 
     uint8_t colorIndex = (wave > 240) ? 240 : wave;
-    CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
+    CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
 
     instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
     instance->_segment.setPixelColor(len - i - 1, RGBW32(c.r, c.g, c.b, c.w));
@@ -3447,7 +3538,8 @@ uint16_t mode_sunrise(void) {
  * Refactored: Hybrid Fade (Exponential + Subtractive) & Tuned Density.
  * Matches WLED's "snappy" feel but fixes the stuck-pixel floor issue.
  */
-uint16_t mode_sparkle(void) {
+uint16_t mode_sparkle(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   // 1. Initialization
   if (instance->_segment.reset) {
     instance->_segment.fill(instance->_segment.colors[1]);
@@ -3533,7 +3625,8 @@ uint16_t mode_sparkle(void) {
  * Inverted: Background is lit (primary color or full palette), sparkles are
  * black (or secondary). Intensity controls sparkle density.
  */
-uint16_t mode_flash_sparkle(void) {
+uint16_t mode_flash_sparkle(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   int len = instance->_segment.length();
 
   if (instance->_segment.reset) {
@@ -3547,11 +3640,12 @@ uint16_t mode_flash_sparkle(void) {
   if (instance->_segment.palette == 0 || instance->_segment.palette == 255) {
     instance->_segment.fill(instance->_segment.colors[0]);
   } else {
-    const uint32_t *pal = getPaletteByIndex(instance->_segment.palette);
+    const uint32_t *pal =
+        getPaletteByIndex(instance, instance->_segment.palette);
     for (int i = 0; i < len; i++) {
       // Map pixel position to palette index 0-255
       uint8_t palIdx = (uint8_t)((i * 255) / (len - 1 > 0 ? len - 1 : 1));
-      CRGBW c = ColorFromPalette(pal, palIdx, 255);
+      CRGBW c = ColorFromPalette(instance, pal, palIdx, 255);
       instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
     }
   }
@@ -3571,7 +3665,8 @@ uint16_t mode_flash_sparkle(void) {
  * Intense, fast sparkles.
  * Matches Sparkle logic but Higher Density/Speed.
  */
-uint16_t mode_hyper_sparkle(void) {
+uint16_t mode_hyper_sparkle(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   uint32_t delta = instance->frame_time;
 
   if (instance->_segment.reset) {
@@ -3645,7 +3740,8 @@ struct EnergyData {
 // 2: Energy Spikes - Localized white-hot eruptions during high chaos. Phase
 // 3: Contrast & Size Refinement - Hue-gating and 5-LED bloom. Phase 4:
 // Scaling & Exit Refinement - Proportional blooms and linear exit.
-uint16_t mode_energy(void) {
+uint16_t mode_energy(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
   uint16_t len = instance->_segment.length();
@@ -3738,7 +3834,7 @@ uint16_t mode_energy(void) {
   }
 
   // Force Rainbow Palette
-  const uint32_t *active_palette = getPaletteByIndex(4);
+  const uint32_t *active_palette = getPaletteByIndex(instance, 4);
 
   // --- Phase 4: Proportional Bloom Logic ---
   uint16_t spark_radius = (len / 60);
@@ -3752,7 +3848,7 @@ uint16_t mode_energy(void) {
     if (i < (int)progress - (int)head_len || finished) {
       uint8_t index = ((i * spatial_mult) / (len ? len : 1)) + counter;
       // --- Phase 4: 80% Background Dimming ---
-      CRGBW c = ColorFromPalette(active_palette, index, 205);
+      CRGBW c = ColorFromPalette(instance, active_palette, index, 205);
       rainbow_32 = RGBW32(c.r, c.g, c.b, c.w);
     } else if (i <= (int)progress) {
       rainbow_32 = RGBW32(255, 255, 255, 255);
@@ -3808,7 +3904,8 @@ struct ChaosData {
   bool intro_done;
 };
 
-uint16_t mode_chaos_theory(void) {
+uint16_t mode_chaos_theory(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
@@ -3943,7 +4040,7 @@ uint16_t mode_chaos_theory(void) {
     }
 
     // Use 205 (80%) brightness to match Energy's background depth exactly
-    CRGBW c = ColorFromPalette(active_palette, index, 205);
+    CRGBW c = ColorFromPalette(instance, active_palette, index, 205);
     instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
   }
 
@@ -4043,7 +4140,8 @@ uint16_t mode_chaos_theory(void) {
 }
 
 // Intensity controls saturation (blends with white)
-uint16_t mode_rainbow(void) {
+uint16_t mode_rainbow(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
@@ -4059,10 +4157,10 @@ uint16_t mode_rainbow(void) {
   // Get color from palette (Rainbow as default)
   const uint32_t *active_palette =
       (instance->_segment.palette == 0)
-          ? getPaletteByIndex(4) // Rainbow palette
-          : getPaletteByIndex(instance->_segment.palette);
+          ? getPaletteByIndex(instance, 4) // Rainbow palette
+          : getPaletteByIndex(instance, instance->_segment.palette);
 
-  CRGBW c = ColorFromPalette(active_palette, counter, 255);
+  CRGBW c = ColorFromPalette(instance, active_palette, counter, 255);
 
   // Intensity < 128: blend with white (reduce saturation)
   if (instance->_segment.intensity < 128) {
@@ -4077,14 +4175,30 @@ uint16_t mode_rainbow(void) {
   return FRAMETIME;
 }
 
+struct RainbowCycleFrame {
+  const uint32_t *palette;
+  uint32_t counter;
+  uint16_t spatial_mult;
+};
+
+static void rainbow_cycle_span(const RenderContext &ctx, const void *frame,
+                               uint16_t begin, uint16_t end) {
+  const auto &f = *static_cast<const RainbowCycleFrame *>(frame);
+  const int len = ctx.len;
+  for (int i = begin; i < end; i++) {
+    uint8_t index = ((i * f.spatial_mult) / len) + f.counter;
+    CRGBW c = ColorFromPalette(ctx.runner, f.palette, index, 255);
+    ctx.pixels[i] = RGBW32(c.r, c.g, c.b, c.w);
+  }
+}
+
 // ID 9: Rainbow - Per-pixel rainbow across strip
 // Intensity controls spatial density (exponential scaling)
-uint16_t mode_rainbow_cycle(void) {
+uint16_t mode_rainbow_cycle(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
-  int len = instance->_segment.length();
-
   // === WLED-FAITHFUL TIMING using centralized helper ===
   // Use segment.step as per-instance timing state (avoids static variable
   // cross-contamination)
@@ -4100,15 +4214,12 @@ uint16_t mode_rainbow_cycle(void) {
   // Get palette (Rainbow as default)
   const uint32_t *active_palette =
       (instance->_segment.palette == 0)
-          ? getPaletteByIndex(4) // Rainbow palette
-          : getPaletteByIndex(instance->_segment.palette);
+          ? getPaletteByIndex(instance, 4) // Rainbow palette
+          : getPaletteByIndex(instance, instance->_segment.palette);
+  primePalette(instance, active_palette);
 
-  for (int i = 0; i < len; i++) {
-    uint8_t index = ((i * spatial_mult) / len) + counter;
-    CRGBW c = ColorFromPalette(active_palette, index, 255);
-
-    instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
-  }
+  const RainbowCycleFrame frame{active_palette, counter, spatial_mult};
+  renderSpans(ctx, rainbow_cycle_span, &frame);
 
   return FRAMETIME;
 }
@@ -4117,13 +4228,14 @@ uint16_t mode_rainbow_cycle(void) {
 // Simplified twinkle: fade all toward black, spawn only on dark pixels
 // NO allocateData - avoids freeze issue
 // Speed = Fade speed, Intensity = Spawn rate
-uint16_t mode_colortwinkle(void) {
+uint16_t mode_colortwinkle(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   int len = instance->_segment.length();
   if (len <= 0)
-    return mode_static();
+    return mode_static(ctx);
 
   // Handle Reset
   if (instance->_segment.reset) {
@@ -4144,8 +4256,8 @@ uint16_t mode_colortwinkle(void) {
   // Get palette - use Rainbow (index 4) as default when palette=0
   const uint32_t *active_palette =
       (instance->_segment.palette == 0)
-          ? getPaletteByIndex(4) // Rainbow palette default
-          : getPaletteByIndex(instance->_segment.palette);
+          ? getPaletteByIndex(instance, 4) // Rainbow palette default
+          : getPaletteByIndex(instance, instance->_segment.palette);
 
   // Step 1: Fade ALL pixels toward black using linear subtraction (qsub8)
   // Logic: Linear fade ensures pixels strictly reach zero, avoiding "floor
@@ -4171,7 +4283,7 @@ uint16_t mode_colortwinkle(void) {
     // avoid deadlocks
     if (hw_random8() <= intensity) {
       int i = hw_random16(0, len);
-      CRGBW c = ColorFromPalette(active_palette, hw_random8(), 255);
+      CRGBW c = ColorFromPalette(instance, active_palette, hw_random8(), 255);
       instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
     }
   }
@@ -4186,13 +4298,14 @@ uint16_t mode_colortwinkle(void) {
 //
 // Based on WLED mode_larson_scanner() by Aircoookie
 // Explicit trail rendering â€” gamma-aware, with direction-change memory
-uint16_t mode_scanner_internal(bool dualMode) {
+uint16_t mode_scanner_internal(RenderContext &ctx, bool dualMode) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   uint16_t len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // State layout:
   //   aux0  = direction (0=forward, 1=backward)
@@ -4211,7 +4324,7 @@ uint16_t mode_scanner_internal(bool dualMode) {
     if (!instance->_segment.allocateData(4)) {
       ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
                (size_t)(4)); // CFX-007
-      return mode_static();
+      return mode_static(ctx);
     }
     instance->_segment.data[0] = 0; // old_dir
     instance->_segment.data[1] = 0; // old_pos low
@@ -4223,7 +4336,7 @@ uint16_t mode_scanner_internal(bool dualMode) {
   // Ensure data is allocated
   if (instance->_segment.data == nullptr) {
     ESP_LOGW("CFX", "%s: data is null (allocateData failed earlier)", __func__);
-    return mode_static();
+    return mode_static(ctx);
   }
 
   // 2. Movement: WLED speed mapping
@@ -4388,31 +4501,36 @@ uint16_t mode_scanner_internal(bool dualMode) {
 
 // Wrapper for single scanner (ID 40)
 // Wrapper for single scanner (ID 40)
-uint16_t mode_scanner_internal(bool dual);
-uint16_t mode_scanner(void) { return mode_scanner_internal(false); }
+uint16_t mode_scanner_internal(RenderContext &ctx, bool dual);
+uint16_t mode_scanner(RenderContext &ctx) {
+  return mode_scanner_internal(ctx, false);
+}
 
 // Dual Scanner (ID 60)
 // Two scanners moving in opposite directions
-uint16_t mode_scanner_dual(void) { return mode_scanner_internal(true); }
+uint16_t mode_scanner_dual(RenderContext &ctx) {
+  return mode_scanner_internal(ctx, true);
+}
 
 // (Duplicate scanner implementation removed)
 
 // Mode Table
 // --- Service Loop with Switch Dispatch ---
-uint16_t mode_bouncing_balls(void);
-uint16_t mode_color_wipe(void);
-uint16_t mode_color_wipe_random(void);
-uint16_t mode_color_sweep(void);
-uint16_t mode_color_sweep(void);
-uint16_t mode_strobe(void);
-uint16_t mode_percent(void);
-uint16_t mode_percent_center(void);
-uint16_t mode_fluid_rain(void);
+uint16_t mode_bouncing_balls(RenderContext &ctx);
+uint16_t mode_color_wipe(RenderContext &ctx);
+uint16_t mode_color_wipe_random(RenderContext &ctx);
+uint16_t mode_color_sweep(RenderContext &ctx);
+uint16_t mode_color_sweep(RenderContext &ctx);
+uint16_t mode_strobe(RenderContext &ctx);
+uint16_t mode_percent(RenderContext &ctx);
+uint16_t mode_percent_center(RenderContext &ctx);
+uint16_t mode_fluid_rain(RenderContext &ctx);
 
 // --- Heartbeat Effect (ID 100) ---
 // Replicates WLED logic with framerate-independent decay and gamma
 // correction
-uint16_t mode_heartbeat(void) {
+uint16_t mode_heartbeat(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
@@ -4500,8 +4618,9 @@ uint16_t mode_heartbeat(void) {
     } else {
       // Palette mapping
       const uint32_t *active_palette =
-          getPaletteByIndex(instance->_segment.palette);
-      CRGBW c = ColorFromPalette(active_palette, (i * 255) / len, 255);
+          getPaletteByIndex(instance, instance->_segment.palette);
+      CRGBW c =
+          ColorFromPalette(instance, active_palette, (i * 255) / len, 255);
       colorPulse = RGBW32(c.r, c.g, c.b, c.w);
     }
 
@@ -4512,6 +4631,277 @@ uint16_t mode_heartbeat(void) {
   return FRAMETIME;
 }
 
+void CFXRunner::setLayout(const CFXLayout *layout) {
+  _layout = layout;
+  free(_layout_lut);
+  free(_layout_first);
+  _layout_lut = nullptr;
+  _layout_first = nullptr;
+  _layout_lut_len = 0;
+  _segment.width = 0;
+  _segment.height = 0;
+  _segment._layoutLen = 0;
+  refreshLayout();
+}
+
+// Compiles the layout for the current segment length and mirror state. The
+// mirror is folded into the table, so commitFrame() never looks at it.
+void CFXRunner::refreshLayout() {
+  if (_layout == nullptr)
+    return;
+  const uint16_t leds = _segment.physicalLength();
+  if (_layout_lut != nullptr && _layout_lut_len == leds &&
+      _layout_lut_mirror == _segment.mirror)
+    return;
+  if (_layout_lut_len != leds || _layout_lut == nullptr) {
+    free(_layout_lut);
+    _layout_lut = leds > 0 ? (uint16_t *)malloc(leds * sizeof(uint16_t))
+                           : nullptr;
+    if (_layout_lut == nullptr) {
+      ESP_LOGW("CFX", "%s: layout table alloc (%u px) failed, using linear",
+               _name, (unsigned)leds);
+      _layout = nullptr;
+      _layout_lut_len = 0;
+      _segment.width = 0;
+      _segment.height = 0;
+      _segment._layoutLen = 0;
+      return;
+    }
+    _layout_lut_len = leds;
+  }
+  _layout_lut_mirror = _segment.mirror;
+  const CFXLayoutShape shape =
+      cfx_layout_build(*_layout, leds, _segment.mirror, _layout_lut);
+  _segment.width = shape.width;
+  _segment.height = shape.height;
+  _segment._layoutLen = shape.length;
+
+  // Inverse table for code drawing by logical pixel straight onto the light
+  // (intros and outros, see cfx_layout_view.h).
+  free(_layout_first);
+  _layout_first = (uint16_t *)malloc((shape.length + 1) * sizeof(uint16_t));
+  if (_layout_first == nullptr)
+    return;
+  for (uint16_t k = 0; k <= shape.length; k++)
+    _layout_first[k] = UINT16_MAX;
+  for (uint16_t p = leds; p-- > 0;)
+    _layout_first[_layout_lut[p]] = p;
+}
+
+// Size the segment working buffer to the current segment length. A fresh
+// buffer is seeded from the light so effects that fade or blur the previous
+// frame start from what is actually on the strip.
+bool CFXRunner::prepareFrame() {
+  refreshLayout();
+  uint16_t len = _segment.length();
+  if (!_arena_claimed) {
+    _arena_claimed = true;
+    _segment.arena = CFXDataArenaPool::get().claim(
+        target_light, _segment.start, getModeDataMaxBytes(len));
+  }
+  if (_segment.pixels && _segment._pixelsLen == len && !_seed_pending)
+    return true;
+
+  if (!_segment.allocatePixels(len)) {
+    ESP_LOGW("CFX", "%s: frame buffer alloc (%u px) failed", _name,
+             (unsigned)len);
+    return false;
+  }
+  _seed_pending = false;
+  _committed_full = true;
+
+  if (target_light == nullptr)
+    return true;
+  int light_size = target_light->size();
+  if (_layout != nullptr) {
+    // LEDs sharing a pixel (folds) all seed it; gaps land in the blank slot.
+    const int leds = _layout_lut_len;
+    const int offset = (light_size == leds) ? 0 : _segment.start;
+    const int end = std::min(leds, light_size - offset);
+    for (int p = 0; p < end; p++) {
+      esphome::Color c = (*target_light)[offset + p].get();
+      _segment.pixels[_layout_lut[p]] = RGBW32(c.r, c.g, c.b, c.w);
+    }
+    _segment.pixels[len] = 0;
+    return true;
+  }
+  int offset = (light_size == (int)len) ? 0 : _segment.start;
+  for (int i = 0; i < (int)len; i++) {
+    int global_index =
+        _segment.mirror ? (offset + len - 1 - i) : (offset + i);
+    if (global_index >= 0 && global_index < light_size) {
+      esphome::Color c = (*target_light)[global_index].get();
+      _segment.pixels[i] = RGBW32(c.r, c.g, c.b, c.w);
+    }
+  }
+  return true;
+}
+
+// Copy the working buffer to the light. Offset and mirror are resolved once
+// per frame (through the gather table when a layout is set); force-white and
+// the brightness bake once per pixel.
+void CFXRunner::commitFrame() {
+  if (target_light == nullptr || _segment.pixels == nullptr)
+    return;
+
+  esphome::light::AddressableLight &light = *target_light;
+  const uint16_t *map = _layout != nullptr ? _layout_lut : nullptr;
+  int len = _segment._pixelsLen;
+  // LEDs written: one per logical pixel, or every LED of a laid-out segment.
+  const int leds = map != nullptr ? (int)_layout_lut_len : len;
+  int light_size = light.size();
+  int offset = (light_size == leds) ? 0 : _segment.start;
+  int first = _segment.mirror ? (offset + len - 1) : offset;
+  int step = _segment.mirror ? -1 : 1;
+
+  // CFX-BRIGHTNESS FIX: ESPHome's AddressableLight wrapper expects effects
+  // to bake their own brightness before returning the buffer.
+  // We only do this if bake_brightness_ is enabled (Segments).
+  const bool force_white = force_white_active_;
+  const bool bake = bake_brightness_ && global_brightness_ < 0.999f &&
+                    global_brightness_ >= 0.0f;
+  if (bake && _bake_lut_bri != global_brightness_) {
+    const float bri = global_brightness_;
+    for (int v = 0; v < 256; v++)
+      _bake_lut[v] = (uint8_t)(v * bri);
+    _bake_lut_bri = bri;
+  }
+  const uint8_t *lut = _bake_lut;
+
+  // Governor delta: largest fingerprint change against the last committed
+  // frame. A new or resized buffer counts as a full change.
+  uint8_t *prev = nullptr;
+  uint8_t max_delta = 0;
+  if (_governor.enabled()) {
+    if (_governor_prev_len != leds) {
+      free(_governor_prev);
+      _governor_prev = (uint8_t *)malloc(leds);
+      _governor_prev_len = _governor_prev != nullptr ? leds : 0;
+      max_delta = 255;
+      if (_governor_prev != nullptr)
+        memset(_governor_prev, 0, leds);
+    }
+    prev = _governor_prev;
+  }
+
+  auto put = [&](int i, int global_index, uint32_t c) {
+    uint8_t r = CFX_R(c);
+    uint8_t g = CFX_G(c);
+    uint8_t b = CFX_B(c);
+    uint8_t w = CFX_W(c);
+
+    // Apply native force_white BEFORE hitting the ESPHome gamma cache
+    if (force_white)
+      cfx::apply_force_white(r, g, b, w);
+
+    if (bake) {
+      r = lut[r];
+      g = lut[g];
+      b = lut[b];
+      w = lut[w];
+    }
+
+    if (prev != nullptr) {
+      const uint8_t fp = cfx::FrameGovernor::fingerprint(r, g, b, w);
+      const uint8_t d = fp > prev[i] ? fp - prev[i] : prev[i] - fp;
+      if (d > max_delta)
+        max_delta = d;
+      prev[i] = fp;
+    }
+
+    light[global_index] = esphome::Color(r, g, b, w);
+  };
+
+  if (map != nullptr) {
+    // One gather per LED; gaps read the blank slot past the logical pixels.
+    const int end = std::min(leds, light_size - offset);
+    for (int p = 0; p < end; p++)
+      put(p, offset + p, _segment.pixels[map[p]]);
+  } else {
+    for (int i = 0; i < len; i++) {
+      int global_index = first + i * step;
+      if (global_index < 0 || global_index >= light_size)
+        continue;
+      put(i, global_index, _segment.pixels[i]);
+    }
+  }
+
+  if (_governor.enabled())
+    _governor.observe(prev != nullptr ? max_delta : 255);
+
+  // Every commit rewrites the whole segment, but pixels the effect left
+  // alone come out byte-identical unless the bake, force-white or mapping
+  // changed, so only the written span is reported to the output.
+  uint32_t sig = (uint32_t)offset;
+  sig = sig * 31u + (uint32_t)len;
+  sig = sig * 31u + (uint32_t)(uintptr_t)_layout;
+  sig = sig * 31u + (uint32_t)light_size;
+  sig = sig * 31u + (_segment.mirror ? 1u : 0u) + (force_white ? 2u : 0u) +
+        (bake ? 4u : 0u);
+  if (bake) {
+    uint32_t bri;
+    memcpy(&bri, &_bake_lut_bri, sizeof(bri));
+    sig = sig * 31u + bri;
+  }
+  if (sig != _commit_sig || _state == STATE_INTRO) {
+    _commit_sig = sig;
+    _committed_full = true;
+  } else if (_segment.dirty_lo < _segment.dirty_hi) {
+    // A layout scatters logical spans, so any write reports the segment.
+    int lo = map != nullptr        ? offset
+             : _segment.mirror ? first - (int)_segment.dirty_hi + 1
+                               : first + (int)_segment.dirty_lo;
+    int hi = map != nullptr ? offset + leds
+                            : lo + (int)(_segment.dirty_hi - _segment.dirty_lo);
+    lo = std::max(lo, 0);
+    hi = std::min(hi, light_size);
+    if (lo < hi) {
+      _committed_lo = std::min(_committed_lo, (uint16_t)lo);
+      _committed_hi = std::max(_committed_hi, (uint16_t)hi);
+    }
+  }
+  _segment.clearDirty();
+}
+
+bool CFXRunner::takeCommittedRange(uint16_t &lo, uint16_t &hi) {
+  const bool partial = !_committed_full;
+  const bool any = _committed_lo < _committed_hi;
+  lo = any ? _committed_lo : 0;
+  hi = any ? _committed_hi : 0;
+  _committed_full = false;
+  _committed_lo = UINT16_MAX;
+  _committed_hi = 0;
+  return partial;
+}
+
+// Everything outside the effect that changes what it draws. A change wakes
+// the governor before the next frame renders, so control changes never wait
+// out a held interval.
+uint32_t CFXRunner::governorInputs() const {
+  uint32_t h = _mode;
+  h = h * 31u + _segment.speed;
+  h = h * 31u + _segment.intensity;
+  h = h * 31u + _segment.palette;
+  h = h * 31u + (_segment.mirror ? 1u : 0u) + (force_white_active_ ? 2u : 0u);
+  for (uint32_t c : _segment.colors)
+    h = h * 31u + c;
+  uint32_t bri;
+  memcpy(&bri, &global_brightness_, sizeof(bri));
+  h = h * 31u + bri;
+  return h;
+}
+
+// The arena claim stays with the first frame: the outgoing effect still holds
+// this segment's slot until its stop(), so claiming here would take a second
+// slot per segment and can run the pool dry on a multi-light sequence.
+bool CFXRunner::prestage() {
+  refreshLayout();
+  if (!_segment.allocatePixels(_segment.length()))
+    return false;
+  _seed_pending = true;
+  return true;
+}
+
 void CFXRunner::service() {
   // CFX-004: Use RAII guard to set global instance pointer for this service call
   InstanceGuard guard(this);
@@ -4529,6 +4919,35 @@ void CFXRunner::service() {
     return;
   }
 
+  if (!prepareFrame()) {
+    return;
+  }
+
+  // Adaptive cadence: on a held tick the light keeps the previous frame and
+  // the timebase is left alone, so the next render sees the whole gap as
+  // one frame delta. Intros always render.
+  _frame_held = false;
+  _governor.setEnabled(_adaptive_frame_rate &&
+                       !(getModeDescriptor(_mode).flags & CFX_MODE_FULL_RATE));
+  if (_governor.enabled()) {
+    const uint32_t inputs = governorInputs();
+    if (inputs != _governor_inputs || _state == STATE_INTRO) {
+      _governor_inputs = inputs;
+      _governor.wake();
+    }
+    _frame_held = !_governor.due();
+    if (_frame_held)
+      return;
+  }
+
+  // Frame budget (see budget_level_): a held tick keeps the last frame the
+  // same way the governor does. Intros always render.
+  if (budget_hold_ && _state != STATE_INTRO) {
+    budget_hold_ = false;
+    _frame_held = true;
+    return;
+  }
+
   // Globally initialize PaletteSolid with the latest selected color.
   // Any effect resolving getPaletteByIndex(255) needs this freshly
   // populated, especially for Pure W channel support in legacy C routines
@@ -4538,10 +4957,23 @@ void CFXRunner::service() {
   // Start frame diagnostics (measures time since last call)
   diagnostics.frame_start();
 
-  uint32_t real_now = cfx_millis();
-  // Calculate frame time (delta) from real clock
-  frame_time = real_now - _last_frame;
-  _last_frame = real_now;
+  // Frame delta in whole ms from the 64-bit clock; the deltas always sum to
+  // the timeline, so 'now' never drifts from real elapsed time.
+  const uint64_t now_us = cfx_micros_64();
+  frame_time = (uint16_t)_timebase.advance(now_us);
+  // A synced light keeps its timeline on the group clock. Slewing at most
+  // 1 ms per frame stays invisible; the same amount goes into frame_time so
+  // Phase-based effects move with the timeline.
+#if CFX_HAS_SYNC_GROUP_CLOCK
+  uint64_t group_elapsed_us;
+  if (group_clock_key != nullptr &&
+      esphome::cfx_sync::CFXSyncGroupClock::get().timeline_us(
+          group_clock_key, now_us, group_elapsed_us)) {
+    const int32_t slew_ms = _timebase.follow(
+        group_elapsed_us, GROUP_CLOCK_STEP_US, GROUP_CLOCK_MAX_SLEW_MS);
+    frame_time = (uint16_t)std::max<int32_t>(0, frame_time + slew_ms);
+  }
+#endif
 
   // Increment call counter for effect initialization logic
   _segment.call++;
@@ -4554,12 +4986,8 @@ void CFXRunner::service() {
   // --- VIRTUAL TIME TRACKING ---
   // Tracks elapsed time purely during active runner service.
   // Resettable via reset() to ensure animations start from T=0.
-  _virtual_now += (float)
-      frame_time; // CFX-009: was cast to double; now float to match HW FPU
-  _accum_ms += (float)frame_time;
-
   // Sync 'now' to virtual timeline for all child effects
-  now = (uint32_t)_virtual_now;
+  now = _timebase.now_ms();
 
   // --- INTRO LOGIC ---
   if (_state == STATE_INTRO) {
@@ -4569,399 +4997,51 @@ void CFXRunner::service() {
       // We let the next loop iteration handle the main effect start to
       // ensure clean state.
     }
-    diagnostics.record_service_us(cfx_micros() - service_start_us);
+    commitFrame();
+    const uint32_t service_us = cfx_micros() - service_start_us;
+    noteServiceCost(service_us);
+    diagnostics.record_service_us(service_us);
+#ifdef USE_CFX_PROFILER
+    CFXProfiler::get().record_stage(CFX_STAGE_INOUT, service_us);
+#endif
+#ifdef USE_CFX_TRACE
+    CFXTrace::get().span(CFX_TRACE_RENDER, service_start_us, service_us, _mode);
+#endif
     return;
   }
 
-  // Dispatch via Switch for reliability
-  switch (_mode) {
-  case FX_MODE_RAINBOW: // 8
-    mode_rainbow();
-    break;
-  case FX_MODE_CHASE_COLOR: // 28
-    mode_chase_color();
-    break;
-  case FX_MODE_CHASE_MULTI: // 54
-    mode_chase_multi();
-    break;
-  case FX_MODE_BPM: // 68
-    mode_bpm();
-    break;
-  case FX_MODE_GLITTER: // 87
-    mode_glitter();
-    break;
-  case FX_MODE_RAINBOW_CYCLE: // 9
-    mode_rainbow_cycle();
-    break;
-  case FX_MODE_AURORA: // 38
-    mode_aurora();
-    break;
-  case FX_MODE_SCANNER: // 40
-    mode_scanner();
-    break;
-  case FX_MODE_SCANNER_DUAL: // 60
-    mode_scanner_dual();
-    break;
-  case FX_MODE_FIRE_2012: // 66
-    mode_fire_2012();
-    break;
-  case FX_MODE_FIRE_DUAL: // 153
-    mode_fire_dual();
-    break;
-  case FX_MODE_COLORTWINKLE: // 74
-    mode_colortwinkle();
-    break;
-  case FX_MODE_PLASMA: // 97
-    mode_plasma();
-    break;
-  case FX_MODE_OCEAN: // 101 (was Pacifica)
-    mode_ocean();
-    break;
-  case FX_MODE_PRIDE_2015: // 63
-    mode_pride_2015();
-    break;
-  case FX_MODE_BREATH: // 2
-    mode_breath();
-    break;
-  case FX_MODE_HEARTBEAT: // 100
-    mode_heartbeat();
-    break;
-  case FX_MODE_DISSOLVE: // 18
-    mode_dissolve();
-    break;
-  case FX_MODE_JUGGLE: // 64
-    mode_juggle();
-    break;
-  case FX_MODE_RIPPLE: // 79
-    mode_ripple();
-    break;
-  case FX_MODE_HEARTBEAT_CENTER: // 154
-    mode_heartbeat_center();
-    break;
-  case FX_MODE_PHASED: // 105
-    mode_phased();
-    break;
-  case FX_MODE_FLOW: // 110
-    mode_flow();
-    break;
-  case FX_MODE_METEOR: // 76
-    mode_meteor();
-    break;
-  case FX_MODE_SPARKLE: // 20
-    mode_sparkle();
-    break;
-  case FX_MODE_FLASH_SPARKLE: // 21
-    mode_flash_sparkle();
-    break;
-  case FX_MODE_HYPER_SPARKLE: // 22
-    mode_hyper_sparkle();
-    break;
-  case FX_MODE_NOISEPAL: // 107
-    mode_noisepal();
-    break;
-  case FX_MODE_COLOR_WIPE: // 3
-    mode_color_wipe();
-    break;
-  case FX_MODE_COLOR_WIPE_RANDOM: // 4
-    mode_color_wipe_random();
-    break;
-  case FX_MODE_COLOR_SWEEP: // 6
-    mode_color_sweep();
-    break;
-  case FX_MODE_SUNRISE: // 104
-    mode_sunrise();
-    break;
-  case FX_MODE_BOUNCINGBALLS: // 91
-    mode_bouncing_balls();
-    break;
-  case FX_MODE_BLINK: // 1
-    mode_blink();
-    break;
-  case FX_MODE_STROBE: // 23
-    mode_strobe();
-    break;
-  case FX_MODE_STROBE_RAINBOW: // 24
-    mode_strobe_rainbow();
-    break;
-  case FX_MODE_MULTI_STROBE: // 25
-    mode_multi_strobe();
-    break;
-  case FX_MODE_BLINK_RAINBOW: // 26
-    mode_blink_rainbow();
-    break;
-  case FX_MODE_RUNNING_LIGHTS: // 15
-    mode_running_lights();
-    break;
-  case FX_MODE_SAW: // 16
-    mode_saw();
-    break;
-  case FX_MODE_RUNNING_DUAL: // 52
-    mode_running_dual();
-    break;
-  case FX_MODE_PERCENT: // 98
-    mode_percent();
-    break;
-  case FX_MODE_PERCENT_CENTER: // 152
-    mode_percent_center();
-    break;
-  case FX_MODE_EXPLODING_FIREWORKS: // 90
-    mode_exploding_fireworks();
-    break;
-  case FX_MODE_POPCORN: // 95
-    mode_popcorn();
-    break;
-  case FX_MODE_DRIP: // 96
-    mode_drip();
-    break;
-  case FX_MODE_DROPPING_TIME: // 151
-    mode_dropping_time();
-    break;
-  case FX_MODE_KALEIDOS: // 155
-    mode_kaleidos();
-    break;
-  case FX_MODE_FOLLOW_ME: // 156
-    mode_follow_me();
-    break;
-  case FX_MODE_FOLLOW_US: // 157
-    mode_follow_us();
-    break;
-  case FX_MODE_ENERGY: // 158
-    mode_energy();
-    break;
-  case FX_MODE_CHAOS_THEORY: // 159
-    mode_chaos_theory();
-    break;
-  case FX_MODE_FLUID_RAIN: // 160
-    mode_fluid_rain();
-    break;
-  case FX_MODE_SEPARATOR: // 185 — turn off immediately, no animation
-    mode_separator();
-    break;
-  case FX_MODE_HORIZON_SWEEP:        // 161
-  case FX_MODE_CENTER_SWEEP:         // 162
-  case FX_MODE_GLITTER_SWEEP:        // 163
-  case FX_MODE_TWIN_PULSE_SWEEP:     // 165
-  case FX_MODE_TRANSMISSION:         // 166
-  case FX_MODE_FOUR_TIMES_THE_CHARM: // 167
-    mode_cfx_horizon_sweep();
-    break;
-  case FX_MODE_COLLIDER: // 164
-    mode_collider();
-    break;
-  case FX_MODE_HYDRO_PULSE: // 168
-    mode_hydro_pulse();
-    break;
-  case FX_MODE_DROPPING_FILL: // 169
-    mode_dropping_fill();
-    break;
-  case FX_MODE_MOIRE_SHIFT: // 176
-  case FX_MODE_RESONANCE_FILL: // 177
-  case FX_MODE_TELEMETRY: // 178
-  case FX_MODE_STELLAR_DUST: // 179
-    mode_static(); // Ambient fill effects
-    break;
-  case FX_MODE_INTERFERENCE: // 180
-    mode_interference();
-    break;
-  case FX_MODE_ECLIPSE: // 181
-    mode_eclipse();
-    break;
-  case FX_MODE_GAS_DISCHARGE: // 182
-    mode_static();  // No running mode, just intro/outro
-    break;
-  case FX_MODE_HARMONIC_SETTLE: // 183
-    mode_static();  // No running mode, just intro/outro
-    break;
-  case FX_MODE_LITHOGRAPH: // 184
-    mode_lithograph();
-    break;
-  case FX_MODE_TIDAL_SURGE: // 186
-    mode_tidal_surge();
-    break;
-  default:
-    mode_static();
-    break;
-  }
+  RenderContext ctx{this,           &_segment, _segment.pixels,
+                    _segment.length(), now,      &randomStream()};
+#ifdef USE_CFX_PROFILER
+  const uint32_t render_start_us = cfx_micros();
+  getModeDescriptor(_mode).render(ctx);
+  CFXProfiler::get().record_render(_mode, cfx_micros() - render_start_us,
+                                   _segment.length());
+#else
+  getModeDescriptor(_mode).render(ctx);
+#endif
 
-  diagnostics.record_service_us(cfx_micros() - service_start_us);
+  commitFrame();
+  const uint32_t service_us = cfx_micros() - service_start_us;
+  noteServiceCost(service_us);
+  diagnostics.record_service_us(service_us);
+#ifdef USE_CFX_TRACE
+  CFXTrace::get().span(CFX_TRACE_RENDER, service_start_us, service_us, _mode);
+#endif
 }
 
 const char *CFXRunner::getModeName() const {
-  switch (_mode) {
-  case FX_MODE_STATIC:
-    return "Solid";
-  case FX_MODE_BLINK:
-    return "Blink";
-  case FX_MODE_BREATH:
-    return "Breathe";
-  case FX_MODE_COLOR_WIPE:
-    return "Wipe";
-  case FX_MODE_COLOR_WIPE_RANDOM:
-    return "Wipe Random";
-  case FX_MODE_COLOR_SWEEP:
-    return "Sweep";
-  case FX_MODE_RAINBOW:
-    return "Rainbow";
-  case FX_MODE_RAINBOW_CYCLE:
-    return "Rainbow Cycle";
-  case FX_MODE_RUNNING_LIGHTS:
-    return "Running Lights";
-  case FX_MODE_SAW:
-    return "Saw";
-  case FX_MODE_DISSOLVE:
-    return "Dissolve";
-  case FX_MODE_SPARKLE:
-    return "Sparkle";
-  case FX_MODE_FLASH_SPARKLE:
-    return "Flash Sparkle";
-  case FX_MODE_HYPER_SPARKLE:
-    return "Hyper Sparkle";
-  case FX_MODE_STROBE:
-    return "Strobe";
-  case FX_MODE_STROBE_RAINBOW:
-    return "Strobe Rainbow";
-  case FX_MODE_MULTI_STROBE:
-    return "Multi Strobe";
-  case FX_MODE_BLINK_RAINBOW:
-    return "Blink Rainbow";
-  case FX_MODE_CHASE_COLOR:
-    return "Chase";
-  case FX_MODE_AURORA:
-    return "Aurora";
-  case FX_MODE_SCANNER:
-    return "Scanner";
-  case FX_MODE_RAIN:
-    return "Rain";
-  case FX_MODE_RUNNING_DUAL:
-    return "Running Dual";
-  case FX_MODE_CHASE_MULTI:
-    return "Chase Multi";
-  case FX_MODE_SCANNER_DUAL:
-    return "Scanner Dual";
-  case FX_MODE_PRIDE_2015:
-    return "Pride 2015";
-  case FX_MODE_JUGGLE:
-    return "Juggle";
-  case FX_MODE_FIRE_2012:
-    return "Fire";
-  case FX_MODE_BPM:
-    return "BPM";
-  case FX_MODE_COLORTWINKLE:
-    return "Colortwinkle";
-  case FX_MODE_METEOR:
-    return "Meteor";
-  case FX_MODE_RIPPLE:
-    return "Ripple";
-  case FX_MODE_GLITTER:
-    return "Glitter";
-  case FX_MODE_EXPLODING_FIREWORKS:
-    return "Fireworks";
-  case FX_MODE_BOUNCINGBALLS:
-    return "Bouncing Balls";
-  case FX_MODE_POPCORN:
-    return "Popcorn";
-  case FX_MODE_DRIP:
-    return "Drip";
-  case FX_MODE_PLASMA:
-    return "Plasma";
-  case FX_MODE_PERCENT:
-    return "Percent";
-  case FX_MODE_HEARTBEAT:
-    return "Heartbeat";
-  case FX_MODE_OCEAN:
-    return "Ocean";
-  case FX_MODE_SUNRISE:
-    return "Sunrise";
-  case FX_MODE_PHASED:
-    return "Phased";
-  case FX_MODE_NOISEPAL:
-    return "Noise Pal";
-  case FX_MODE_FLOW:
-    return "Flow";
-  case FX_MODE_DROPPING_TIME:
-    return "Dropping Time";
-  case FX_MODE_PERCENT_CENTER:
-    return "Percent Center";
-  case FX_MODE_FIRE_DUAL:
-    return "Fire Dual";
-  case FX_MODE_HEARTBEAT_CENTER:
-    return "Heartbeat Center";
-  case FX_MODE_KALEIDOS:
-    return "Kaleidos";
-  case FX_MODE_FOLLOW_ME:
-    return "Follow Me";
-  case FX_MODE_FOLLOW_US:
-    return "Follow Us";
-  case FX_MODE_ENERGY:
-    return "Energy";
-  case FX_MODE_CHAOS_THEORY:
-    return "Chaos Theory";
-  case FX_MODE_FLUID_RAIN:
-    return "Fluid Rain";
-  case FX_MODE_HORIZON_SWEEP:
-    return "Horizon Sweep";
-  case FX_MODE_CENTER_SWEEP:
-    return "Center Sweep";
-  case FX_MODE_GLITTER_SWEEP:
-    return "Glitter Sweep";
-  case FX_MODE_COLLIDER:
-    return "Collider";
-  case FX_MODE_TWIN_PULSE_SWEEP:
-    return "Twin Pulse Sweep";
-  case FX_MODE_TRANSMISSION:
-    return "Transmission";
-  case FX_MODE_FOUR_TIMES_THE_CHARM:
-    return "Four Times The Charm";
-  case FX_MODE_HYDRO_PULSE:
-    return "Hydro Pulse";
-  case FX_MODE_DROPPING_FILL:
-    return "Dropping Fill";
-  case FX_MODE_ASSEMBLY:
-    return "Assembly";
-  case FX_MODE_INERTIA_SWEEP:
-    return "Inertia Sweep";
-  case FX_MODE_SONAR_REVEAL:
-    return "Sonar Reveal";
-  case FX_MODE_VENETIAN:
-    return "Venetian";
-  case FX_MODE_CRYSTALLIZE:
-    return "Crystallize";
-  case FX_MODE_DEEP_BREATHE:
-    return "Deep Breathe";
-  case FX_MODE_MOIRE_SHIFT:
-    return "Moire Shift";
-  case FX_MODE_RESONANCE_FILL:
-    return "Resonance Fill";
-  case FX_MODE_TELEMETRY:
-    return "Telemetry";
-  case FX_MODE_STELLAR_DUST:
-    return "Stellar Dust";
-  case FX_MODE_INTERFERENCE:
-    return "Interference";
-  case FX_MODE_ECLIPSE:
-    return "Eclipse";
-  case FX_MODE_GAS_DISCHARGE:
-    return "Gas Discharge";
-  case FX_MODE_HARMONIC_SETTLE:
-    return "Harmonic Settle";
-  case FX_MODE_LITHOGRAPH:
-    return "Lithograph";
-  case FX_MODE_SEPARATOR:
-    return "Separator";
-  case FX_MODE_TIDAL_SURGE:
-    return "Tidal Surge";
-  case FX_MODE_IMPACT_FLARE:
-    return "Impact Flare";
-  case 188:
-    return "Monolith";
-  default:
-    return "Unknown";
-  }
+  return getModeDescriptor(_mode).name;
 }
 
 // --- Physics Effects (ID 90, 95, 96) ---
 
-// Shared Particle Struct for Fireworks, Popcorn, Drip
+// Fireworks, Popcorn and Drip run on the fixed-point particle engine
+// (cfx_particles.h): positions in pixels, velocities in pixels per frame.
+// Bouncing Balls, Fluid Rain and Collider keep their state on it too.
+
+// Float particle used by Dropping Time, which keeps a fixed handful of drops
+// inside its own state block.
 struct Spark {
   float pos;
   float vel;
@@ -4976,38 +5056,42 @@ struct Spark {
  * Ported from WLED (Aircoookie/Blazoncek)
  * Optimized for 1D Strips (No 2D support)
  */
-/*
- * Exploding Fireworks (ID 90)
- * Ported from WLED (Aircoookie/Blazoncek)
- * Optimized for 1D Strips (No 2D support)
- */
-uint16_t mode_exploding_fireworks(void) {
-  uint16_t len = instance->_segment.length();
-  if (len <= 1)
-    return mode_static();
+static constexpr uint16_t FIREWORKS_DEFAULT_SPARKS = 64;
 
-  // Allocate Data
-  // WLED Logic: 5 + (rows*cols)/2, maxed at FAIR_DATA
-  const uint16_t MAX_SPARKS = 64;
-  uint16_t numSparks = std::min((uint16_t)(5 + (len >> 1)), MAX_SPARKS);
-
-  // Data layout: [Spark array...] [float dying_gravity]
-  size_t dataSize = sizeof(Spark) * numSparks;
+struct FireworksState {
+  cfx::q16_16 dying_gravity;
+};
 
-  if (!instance->_segment.allocateData(dataSize + sizeof(float))) {
+uint16_t mode_exploding_fireworks(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
+  uint16_t len = instance->_segment.length();
+  if (len <= 1)
+    return mode_static(ctx);
+
+  // WLED Logic: 5 + (rows*cols)/2, capped by the runner's particle cap.
+  // Particle 0 is the rocket flare, the debris starts at 1.
+  const uint16_t cap = instance->particleCap(FIREWORKS_DEFAULT_SPARKS);
+  uint16_t numSparks = std::min((uint16_t)(5 + (len >> 1)), cap);
+  if (numSparks < 2)
+    numSparks = 2;
+
+  // Data layout: [particle arrays...] [FireworksState]
+  const size_t dataSize = cfx::ParticleSet::bytes(numSparks);
+  if (!instance->_segment.allocateData(dataSize + sizeof(FireworksState))) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
-             (size_t)(dataSize + sizeof(float))); // CFX-007
-    return mode_static();
+             (size_t)(dataSize + sizeof(FireworksState))); // CFX-007
+    return mode_static(ctx);
   }
 
-  Spark *sparks = reinterpret_cast<Spark *>(instance->_segment.data);
-  float *dying_gravity =
-      reinterpret_cast<float *>(instance->_segment.data + dataSize);
-  Spark *flare = sparks; // First spark is the rocket flare
+  cfx::ParticleSet sparks =
+      cfx::ParticleSet::bind(instance->_segment.data, numSparks);
+  auto *state = reinterpret_cast<FireworksState *>(instance->_segment.data +
+                                                   dataSize);
 
   // Initialization / Resize handling
   if (dataSize != instance->_segment.aux1) {
-    *dying_gravity = 0.0f;
+    sparks.clear();
+    state->dying_gravity = 0;
     instance->_segment.aux0 = 0;        // State: 0=Init Flare
     instance->_segment.aux1 = dataSize; // Size tracker
   }
@@ -5021,33 +5105,32 @@ uint16_t mode_exploding_fireworks(void) {
   // Physics
   // Gravity: WLED 0.0004 + speed/800000.
   // Map speed 0-255 to reasonable gravity.
-  float gravity = -0.0004f - (instance->_segment.speed / 800000.0f);
-  gravity *= len; // Scale by strip length
+  float gravity_f = -0.0004f - (instance->_segment.speed / 800000.0f);
+  gravity_f *= len; // Scale by strip length
+  const cfx::q16_16 gravity = cfx::q16_from_float(gravity_f);
 
   if (instance->_segment.aux0 < 2) {    // STATE: FLARE LAUNCH
     if (instance->_segment.aux0 == 0) { // Init Flare
-      flare->pos = 0;
-      flare->vel = 0;
       // WLED Peak Height
       float peakHeight = (75 + cfx::hw_random8(180)) * (len - 1) / 255.0f;
-      flare->vel = sqrtf(-2.0f * gravity * peakHeight);
-      flare->col = 255; // Max brightness
+      sparks.spawn(0, 0, cfx::q16_from_float(sqrtf(-2.0f * gravity_f * peakHeight)),
+                   255, 0); // Max brightness
       instance->_segment.aux0 = 1;
     }
 
     // Process Flare Physics
-    if (flare->vel > 12 * gravity) { // Still rising (gravity is negative)
+    if (sparks.vel[0] > 12 * gravity) { // Still rising (gravity is negative)
       // Draw Flare
-      int pos = (int)flare->pos;
-      if (pos >= 0 && pos < len) {
-        instance->_segment.setPixelColor(
-            pos, RGBW32(flare->col, flare->col, flare->col, 0));
-      }
-
-      flare->pos += flare->vel;
-      flare->pos = cfx_constrain(flare->pos, 0.0f, (float)len - 1.0f);
-      flare->vel += gravity;
-      flare->col = qsub8(flare->col, 2); // Dim slightly
+      int pos = cfx::q16_floor(sparks.pos[0]);
+      uint8_t bri = (uint8_t)sparks.life[0];
+      if (pos >= 0 && pos < len)
+        instance->_segment.setPixelColor(pos, RGBW32(bri, bri, bri, 0));
+
+      sparks.integrate(gravity, 0, 1);
+      sparks.pos[0] = cfx_constrain(sparks.pos[0], (cfx::q16_16)0,
+                                    cfx::q16_from_int(len - 1));
+      // Dim slightly; a live flare never reaches 0.
+      sparks.life[0] = sparks.life[0] > 3 ? sparks.life[0] - 2 : 1;
     } else {
       instance->_segment.aux0 = 2; // Trigger Explosion
     }
@@ -5058,99 +5141,71 @@ uint16_t mode_exploding_fireworks(void) {
     if (instance->_segment.aux0 == 2) {
       // Explosion Logic
       // Use nSparks logic from WLED (approximate for 1D)
-      int nSparks = flare->pos + cfx::hw_random8(4);
+      int nSparks = cfx::q16_floor(sparks.pos[0]) + cfx::hw_random8(4);
       nSparks = std::max(nSparks, 4);
       nSparks = std::min(nSparks, (int)numSparks);
 
+      // WLED Velocity Logic:
+      // (random(20001)/10000 - 0.9) covers range -0.9 to 1.1
+      // Then multiplied by negative gravity * 50 to scale to strip
+      // size/physics
+      // INTENSITY CONTROL: Scale velocity by intensity/128 (128=Native,
+      // 255=2x, 64=0.5x)
+      float intensityScale = instance->_segment.intensity / 128.0f;
+      if (intensityScale < 0.1f)
+        intensityScale = 0.1f; // Prevent 0 velocity
+      const int64_t burst =
+          cfx::q16_from_float(-gravity_f * 50.0f * intensityScale);
+
       for (int i = 1; i < nSparks; i++) {
-        sparks[i].pos = flare->pos;
-        // WLED Velocity Logic:
-        // (random(20001)/10000 - 0.9) covers range -0.9 to 1.1
-        // Then multiplied by negative gravity * 50 to scale to strip
-        // size/physics
-        // INTENSITY CONTROL: Scale velocity by intensity/128 (128=Native,
-        // 255=2x, 64=0.5x)
-        float intensityScale = instance->_segment.intensity / 128.0f;
-        if (intensityScale < 0.1f)
-          intensityScale = 0.1f; // Prevent 0 velocity
-
-        sparks[i].vel = (float(cfx::hw_random16(0, 20001)) / 10000.0f) - 0.9f;
-        sparks[i].vel *= -gravity * 50.0f *
-                         intensityScale; // Velocity scaling + Intensity scaling
-
-        // Heat initialization (WLED uses extended range for heat)
-        sparks[i].col = 345;
-
-        // Random color index
-        sparks[i].colIndex = cfx::hw_random8();
+        const int32_t r = (int32_t)cfx::hw_random16(0, 20001) - 9000;
+        // Heat initialization (WLED uses extended range for heat) and a
+        // random color index
+        sparks.spawn(i, sparks.pos[0], (cfx::q16_16)(r * burst / 10000), 345,
+                     cfx::hw_random8());
       }
       // Known spark[1] keeps the explosion alive
-      sparks[1].col = 345;
+      sparks.life[1] = 345;
 
-      *dying_gravity = gravity / 2;
+      state->dying_gravity = gravity / 2;
       instance->_segment.aux0 = 3;
     }
 
     // Process Sparks
     // Check if "known spark" (index 1) is still burnt out
-    if (sparks[1].col > 4) {
-      // Iterate over all active sparks.
-      // Note: We don't track nSparks locally between frames, so we iterate
-      // numSparks but only process those with heat > 0.
-      for (int i = 1; i < numSparks; i++) {
-        if (sparks[i].col > 0) {
-          sparks[i].pos += sparks[i].vel;
-          sparks[i].vel += *dying_gravity;
-
-          if (sparks[i].col > 3)
-            sparks[i].col -= 4; // Cooling
-          else
-            sparks[i].col = 0;
-
-          if (sparks[i].pos >= 0 && sparks[i].pos < len) {
-            // WLED Heat->Color Logic
-            uint16_t prog = sparks[i].col;
-            uint32_t spColor;
-
-            // Resolve palette color
-            // If default palette (0), use Rainbow (ID 4) logic
-            uint8_t palId = instance->_segment.palette;
-            if (palId == 0)
-              palId = 4; // Default to Rainbow
-
-            const uint32_t *pal = getPaletteByIndex(palId);
-            CRGBW c = ColorFromPalette(pal, sparks[i].colIndex, 255);
-            spColor = RGBW32(c.r, c.g, c.b, c.w);
-
-            CRGBW finalColor = CRGBW(0, 0, 0, 0);
-
-            if (prog > 300) { // White hot (fade from white to spark color)
-              // Blend White -> Color
-              // prog 345 -> 300 map to 255 -> 0 blend amount?
-              // WLED: color_blend(spColor, WHITE, (prog-300)*5)
-              // (345-300)*5 = 225. So high heat = mostly white.
-              finalColor = CRGBW(color_blend(
-                  spColor, RGBW32(255, 255, 255, 255), (prog - 300) * 5));
-            } else if (prog > 45) { // Fade from color to black
-              // WLED: color_blend(BLACK, spColor, prog - 45)
-              // (300-45) = 255 (full color). (46-45) = 1 (mostly black).
-              int blendAmt = cfx_constrain((int)prog - 45, 0, 255);
-              finalColor = CRGBW(color_blend(0, spColor, blendAmt));
-
-              // WLED adds specific cooling to G/B channels for fire look?
-              // int cooling = (300 - prog) >> 5;
-              // We'll skip that subtle detail for 1D optimization unless
-              // needed.
-            }
-
-            instance->_segment.setPixelColor(
-                (int)sparks[i].pos,
-                RGBW32(finalColor.r, finalColor.g, finalColor.b, finalColor.w));
-          }
-        }
-      }
-      *dying_gravity *=
-          0.8f; // Air resistance (WLED uses 0.8f, we were using 0.9f)
+    if (sparks.life[1] > 4) {
+      sparks.integrate(state->dying_gravity, 1, numSparks);
+      sparks.cool(4, 1, numSparks);
+
+      // Resolve palette color
+      // If default palette (0), use Rainbow (ID 4) logic
+      uint8_t palId = instance->_segment.palette;
+      if (palId == 0)
+        palId = 4; // Default to Rainbow
+      const uint32_t *pal = getPaletteByIndex(instance, palId);
+
+      // WLED Heat->Color Logic, added onto the trails
+      int lo = len, hi = 0;
+      sparks.render_add(
+          instance->_segment.pixels, len, 1, numSparks,
+          [&](uint16_t i) -> uint32_t {
+            const uint16_t prog = sparks.life[i];
+            CRGBW c = ColorFromPalette(instance, pal, sparks.hue[i], 255);
+            const uint32_t spColor = RGBW32(c.r, c.g, c.b, c.w);
+            if (prog > 300) // White hot (fade from white to spark color)
+              return color_blend(spColor, RGBW32(255, 255, 255, 255),
+                                 (prog - 300) * 5);
+            if (prog > 45) // Fade from color to black
+              return color_blend(0, spColor,
+                                 cfx_constrain((int)prog - 45, 0, 255));
+            return 0;
+          },
+          lo, hi);
+      if (lo < hi)
+        instance->_segment.markDirty(lo, hi);
+
+      // Air resistance (WLED uses 0.8f, we were using 0.9f)
+      state->dying_gravity -= state->dying_gravity / 5;
     } else {
       // Burnt out
       instance->_segment.aux0 = 6 + cfx::hw_random8(10); // Wait frames
@@ -5170,26 +5225,32 @@ uint16_t mode_exploding_fireworks(void) {
  * Popcorn (ID 95)
  * Ported from WLED
  */
-uint16_t mode_popcorn(void) {
+static constexpr uint16_t POPCORN_DEFAULT_KERNELS = 24;
+
+uint16_t mode_popcorn(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   uint16_t len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
-  // WLED: max 21 kernels per segment (ESP8266)
-  const int MAX_POPCORN = 24;
-  if (!instance->_segment.allocateData(sizeof(Spark) * MAX_POPCORN)) {
+  // WLED: max 21 kernels per segment (ESP8266); ours follow the particle cap
+  const uint16_t cap = instance->particleCap(POPCORN_DEFAULT_KERNELS);
+  const size_t dataSize = cfx::ParticleSet::bytes(cap);
+  if (!instance->_segment.allocateData(dataSize)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
-             (size_t)(sizeof(Spark) * MAX_POPCORN)); // CFX-007
-    return mode_static();
+             dataSize); // CFX-007
+    return mode_static(ctx);
   }
 
-  Spark *popcorn = reinterpret_cast<Spark *>(instance->_segment.data);
+  cfx::ParticleSet popcorn =
+      cfx::ParticleSet::bind(instance->_segment.data, cap);
 
   // Background
   instance->_segment.fill(instance->_segment.colors[1]); // Secondary
 
-  float gravity = -0.0001f - (instance->_segment.speed / 200000.0f);
-  gravity *= len;
+  float gravity_f = -0.0001f - (instance->_segment.speed / 200000.0f);
+  gravity_f *= len;
+  const cfx::q16_16 gravity = cfx::q16_from_float(gravity_f);
 
   // WLED Density fix: ~1:1 with 83 intensity
   // WLED used `intensity` directly?
@@ -5201,48 +5262,52 @@ uint16_t mode_popcorn(void) {
 
   // Scaling density by 0.5 for further reduction
   uint8_t effective_intensity = scale8(instance->_segment.intensity, 128);
-  int numPopcorn = effective_intensity * MAX_POPCORN / 255;
+  uint16_t numPopcorn = effective_intensity * cap / 255;
   if (numPopcorn == 0)
     numPopcorn = 1;
 
-  for (int i = 0; i < numPopcorn; i++) {
-    if (popcorn[i].pos >= 0.0f) { // Active
-      popcorn[i].pos += popcorn[i].vel;
-      popcorn[i].vel += gravity;
-    } else {                       // Inactive - Pop?
-      if (cfx::hw_random8() < 5) { // Pop Chance
-        popcorn[i].pos = 0.01f;
-
-        // Initial Velocity calculation
-        unsigned peakHeight = 128 + cfx::hw_random8(128);
-        peakHeight = (peakHeight * (len - 1)) >> 8;
-        popcorn[i].vel = sqrtf(-2.0f * gravity * peakHeight);
-
-        if (instance->_segment.palette == 0) {
-          popcorn[i].colIndex = cfx::hw_random8(0, 3); // Pick simple colors?
-        } else {
-          popcorn[i].colIndex = cfx::hw_random8();
-        }
-      }
-    }
+  // A kernel is in flight while it is on or above the pan (pos >= 0), the
+  // same test WLED uses; all-zero data starts every kernel resting on it.
+  // life holds that test from the start of the frame, so a kernel that
+  // lands this frame only gets its pop chance on the next one.
+  for (uint16_t i = 0; i < numPopcorn; i++)
+    popcorn.life[i] = popcorn.pos[i] >= 0;
+  popcorn.integrate(gravity, 0, numPopcorn);
 
-    // Draw
-    if (popcorn[i].pos >= 0.0f) {
-      int idx = (int)popcorn[i].pos;
-      if (idx < len) {
-        uint32_t col;
-        if (instance->_segment.palette == 0 ||
-            instance->_segment.palette == 255) {
-          // Default (0) or Solid (255): Use Primary Color
-          col = instance->_segment.colors[0];
-        } else {
-          const uint32_t *pal = getPaletteByIndex(instance->_segment.palette);
-          CRGBW c = ColorFromPalette(pal, popcorn[i].colIndex, 255);
-          col = RGBW32(c.r, c.g, c.b, c.w);
-        }
-        instance->_segment.setPixelColor(idx, col);
-      }
+  for (uint16_t i = 0; i < numPopcorn; i++) {
+    if (popcorn.alive(i) || cfx::hw_random8() >= 5) // Pop Chance
+      continue;
+    // Initial Velocity calculation
+    unsigned peakHeight = 128 + cfx::hw_random8(128);
+    peakHeight = (peakHeight * (len - 1)) >> 8;
+    const uint8_t hue = instance->_segment.palette == 0
+                            ? cfx::hw_random8(0, 3) // Pick simple colors?
+                            : cfx::hw_random8();
+    popcorn.spawn(i, cfx::q16_from_float(0.01f),
+                  cfx::q16_from_float(sqrtf(-2.0f * gravity_f * peakHeight)),
+                  1, hue);
+  }
+
+  // Draw: kernels sit in front of the background rather than adding to it
+  const bool solid =
+      instance->_segment.palette == 0 || instance->_segment.palette == 255;
+  const uint32_t *pal =
+      solid ? nullptr : getPaletteByIndex(instance, instance->_segment.palette);
+  for (uint16_t i = 0; i < numPopcorn; i++) {
+    if (popcorn.pos[i] < 0)
+      continue;
+    int idx = cfx::q16_floor(popcorn.pos[i]);
+    if (idx >= len)
+      continue;
+    uint32_t col;
+    if (solid) {
+      // Default (0) or Solid (255): Use Primary Color
+      col = instance->_segment.colors[0];
+    } else {
+      CRGBW c = ColorFromPalette(instance, pal, popcorn.hue[i], 255);
+      col = RGBW32(c.r, c.g, c.b, c.w);
     }
+    instance->_segment.setPixelColor(idx, col);
   }
 
   return FRAMETIME;
@@ -5281,14 +5346,15 @@ struct DroppingTimeState {
   }
 };
 
-uint16_t mode_dropping_time(void) {
+uint16_t mode_dropping_time(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   uint16_t len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   if (!instance->_segment.allocateData(sizeof(DroppingTimeState))) {
     ESP_LOGE("CFX", "DroppingTime: Alloc failed!");
-    return mode_static();
+    return mode_static(ctx);
   }
 
   DroppingTimeState *state =
@@ -5352,7 +5418,7 @@ uint16_t mode_dropping_time(void) {
   // scope. The top-of-function (len <= 1) guard does not cover code
   // restructuring paths.
   if (len == 0)
-    return mode_static();
+    return mode_static(ctx);
 
   // A. Filling Drop Timing
   // We want the drop to 'release' (finish swelling and fall) at releaseTime
@@ -5452,7 +5518,7 @@ uint16_t mode_dropping_time(void) {
   uint8_t pal = instance->_segment.palette;
   if (pal == 0 || pal == 255)
     pal = 11; // Default to Ocean to prevent flat colors
-  const uint32_t *active_palette = getPaletteByIndex(pal);
+  const uint32_t *active_palette = getPaletteByIndex(instance, pal);
 
   uint8_t t1 = beat8(15);
   uint8_t t2 = beat8(18);
@@ -5464,7 +5530,7 @@ uint16_t mode_dropping_time(void) {
     uint8_t wave2 = sin8(x2 + t2);
     uint8_t index = (wave1 + wave2) / 2;
 
-    CRGBW c = ColorFromPalette(active_palette, index, 255);
+    CRGBW c = ColorFromPalette(instance, active_palette, index, 255);
     instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
   }
 
@@ -5473,7 +5539,7 @@ uint16_t mode_dropping_time(void) {
   // previous fallback mechanism to skip pulling from the palette. Here, we
   // force the drop to organically sample the active theme (e.g., Ocean) by
   // sampling the palette center directly.
-  CRGBW c_drop = ColorFromPalette(active_palette, 128, 255);
+  CRGBW c_drop = ColorFromPalette(instance, active_palette, 128, 255);
   uint32_t dropColor = RGBW32(c_drop.r, c_drop.g, c_drop.b, c_drop.w);
   // If the palette center happens to be black, fallback to a light water
   // blue
@@ -5590,18 +5656,24 @@ uint16_t mode_dropping_time(void) {
   return FRAMETIME;
 }
 
-uint16_t mode_drip(void) {
+uint16_t mode_drip(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   uint16_t len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
+  // One tap, so the drops do not scale with the particle cap.
   const int MAX_DROPS = 4;
-  if (!instance->_segment.allocateData(sizeof(Spark) * MAX_DROPS)) {
+  const size_t dataSize = cfx::ParticleSet::bytes(MAX_DROPS);
+  if (!instance->_segment.allocateData(dataSize)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
-             (size_t)(sizeof(Spark) * MAX_DROPS)); // CFX-007
-    return mode_static();
+             dataSize); // CFX-007
+    return mode_static(ctx);
   }
-  Spark *drops = reinterpret_cast<Spark *>(instance->_segment.data);
+  // life = drop brightness/size, hue = state (0 init, 1 forming, 2 falling,
+  // 5 bouncing)
+  cfx::ParticleSet drops =
+      cfx::ParticleSet::bind(instance->_segment.data, MAX_DROPS);
 
   instance->_segment.fill(instance->_segment.colors[1]);
 
@@ -5612,26 +5684,27 @@ uint16_t mode_drip(void) {
   // If we receive 128, map it down.
   uint8_t wled_speed = scale8(instance->_segment.speed, 166); // 128 -> ~83
 
-  float gravity = -0.0005f - (wled_speed / 50000.0f);
-  gravity *= (len - 1);
+  float gravity_f = -0.0005f - (wled_speed / 50000.0f);
+  gravity_f *= (len - 1);
+  const cfx::q16_16 gravity = cfx::q16_from_float(gravity_f);
 
   for (int j = 0; j < numDrops; j++) {
-    if (drops[j].colIndex == 0) { // Init
-      drops[j].pos = len - 1;
-      drops[j].vel = 0;
-      drops[j].col = 0;      // Brightness/Size measure
-      drops[j].colIndex = 1; // State: 1=Forming
+    if (drops.hue[j] == 0) { // Init
+      drops.pos[j] = cfx::q16_from_int(len - 1);
+      drops.vel[j] = 0;
+      drops.life[j] = 0;      // Brightness/Size measure
+      drops.hue[j] = 1; // State: 1=Forming
     }
 
     // Source (Tap)
     // Draw source pixel at top
     // WLED uses "sourcedrop" brightness logic.
 
-    if (drops[j].colIndex == 1) { // Forming
+    if (drops.hue[j] == 1) { // Forming
       // Swelling
-      drops[j].col += cfx::cfx_map(instance->_segment.speed, 0, 255, 1, 6);
-      if (drops[j].col > 255)
-        drops[j].col = 255;
+      drops.life[j] += cfx::cfx_map(instance->_segment.speed, 0, 255, 1, 6);
+      if (drops.life[j] > 255)
+        drops.life[j] = 255;
 
       // Draw swelling drop at the top (len-1)
       // WLED logic: Source brightness increases.
@@ -5641,43 +5714,44 @@ uint16_t mode_drip(void) {
           instance->_segment.palette == 255) {
         col = instance->_segment.colors[0];
       } else {
-        const uint32_t *pal = getPaletteByIndex(instance->_segment.palette);
-        CRGBW c = ColorFromPalette(pal, (uint8_t)(j * 64), 255);
+        const uint32_t *pal =
+            getPaletteByIndex(instance, instance->_segment.palette);
+        CRGBW c = ColorFromPalette(instance, pal, (uint8_t)(j * 64), 255);
         col = RGBW32(c.r, c.g, c.b, c.w);
       }
       // Blend black -> color based on 'col' (0-255)
       // Using color_blend(0, col, brightness)
       // Note: color_blend blend param: 0=color1, 255=color2.
-      // So color_blend(0, col, drops[j].col) blends from Black(0) to Color.
+      // So color_blend(0, col, drops.life[j]) blends from Black(0) to Color.
       instance->_segment.setPixelColor(
-          len - 1, color_blend(0, col, (uint8_t)drops[j].col));
+          len - 1, color_blend(0, col, (uint8_t)drops.life[j]));
 
       // Random Fall Trigger
       // Chance increased by swelling size
-      if (cfx::hw_random8() < drops[j].col / 20) {
-        drops[j].colIndex = 2; // Fall State
-        drops[j].col = 255;    // Full brightness for falling
+      if (cfx::hw_random8() < drops.life[j] / 20) {
+        drops.hue[j] = 2; // Fall State
+        drops.life[j] = 255;    // Full brightness for falling
       }
     }
 
-    if (drops[j].colIndex > 1) { // Falling
-      if (drops[j].pos > 0) {
-        drops[j].pos += drops[j].vel;
-        if (drops[j].pos < 0)
-          drops[j].pos = 0;
-        drops[j].vel += gravity;
+    if (drops.hue[j] > 1) { // Falling
+      if (drops.pos[j] > 0) {
+        drops.integrate(gravity, j, j + 1);
+        if (drops.pos[j] < 0)
+          drops.pos[j] = 0;
 
         // Draw falling drop with TAIL
         // Simple trail logic: pos, pos-direction, ...
-        int pos = (int)drops[j].pos;
+        int pos = cfx::q16_floor(drops.pos[j]);
         // Palette support (like Popcorn)
         uint32_t col;
         if (instance->_segment.palette == 0 ||
             instance->_segment.palette == 255) {
           col = instance->_segment.colors[0];
         } else {
-          const uint32_t *pal = getPaletteByIndex(instance->_segment.palette);
-          CRGBW c = ColorFromPalette(pal, (uint8_t)(j * 64), 255);
+          const uint32_t *pal =
+              getPaletteByIndex(instance, instance->_segment.palette);
+          CRGBW c = ColorFromPalette(instance, pal, (uint8_t)(j * 64), 255);
           col = RGBW32(c.r, c.g, c.b, c.w);
         }
 
@@ -5687,7 +5761,7 @@ uint16_t mode_drip(void) {
         // Tail Logic: Only when Falling (vel < 0) AND in initial Drop phase
         // (colIndex == 2) User: "another led bounce 6 led backward with a
         // lower brightness without tail" So ONLY draw tail if falling.
-        if (drops[j].colIndex == 2 && drops[j].vel < 0) {
+        if (drops.hue[j] == 2 && drops.vel[j] < 0) {
           // Falling: Moves towards 0. Tail is at pos+1, pos+2...
           // Increased tail length to 6 pixels
           for (int t = 1; t <= 6; t++) {
@@ -5711,7 +5785,7 @@ uint16_t mode_drip(void) {
         }
 
         // Bounce Logic
-        if (drops[j].colIndex > 2) { // Bouncing
+        if (drops.hue[j] > 2) { // Bouncing
           // Splash on floor (stay on the last led) applies when bouncing
           // Draw the static drop at the bottom with lower brightness
           uint32_t dimCol = color_blend(col, 0, 150); // Lower brightness
@@ -5727,17 +5801,17 @@ uint16_t mode_drip(void) {
         }
 
       } else {                       // Hit Bottom
-        if (drops[j].colIndex > 2) { // Already bouncing and hit bottom again
-          drops[j].colIndex = 0;     // Reset / Disappear
+        if (drops.hue[j] > 2) { // Already bouncing and hit bottom again
+          drops.hue[j] = 0;     // Reset / Disappear
         } else {
           // Init Bounce
           // Math for exactly 7 LEDs high: v = sqrt(2 * |g| * h)
           // gravity is negative, so |g| = -gravity.
           // h = 7.0f
-          drops[j].vel = sqrtf(-2.0f * gravity * 7.0f);
-          drops[j].pos =
-              0.1f; // Lift slightly so it doesn't immediately hit 0 again
-          drops[j].colIndex = 5; // Bouncing state
+          drops.vel[j] = cfx::q16_from_float(sqrtf(-2.0f * gravity_f * 7.0f));
+          // Lift slightly so it doesn't immediately hit 0 again
+          drops.pos[j] = cfx::q16_from_float(0.1f);
+          drops.hue[j] = 5; // Bouncing state
         }
       }
     }
@@ -5747,8 +5821,8 @@ uint16_t mode_drip(void) {
   {
     int32_t lowest = -1;
     for (int j = 0; j < MAX_DROPS; j++) {
-      if (drops[j].colIndex > 0) {
-        int32_t p = (int32_t)drops[j].pos;
+      if (drops.hue[j] > 0) {
+        int32_t p = cfx::q16_floor(drops.pos[j]);
         if (p >= 0 && (lowest < 0 || p < lowest)) lowest = p;
       }
     }
@@ -5764,33 +5838,39 @@ uint16_t mode_drip(void) {
 
 #define MAX_BALLS 8
 
-struct BouncingBall {
-  float impactVelocity;           // v0 (upward velocity after bounce)
-  float height;                   // Current height
-  uint32_t clockTimeAtLastBounce; // Timestamp
-  float dampening;                // Energy retention (0.0 - 1.0)
-};
+// Balls follow closed-form trajectories from their last bounce, evaluated in
+// fixed point on the particle engine: pos is the height in pixels, vel the
+// impact velocity (strip heights per second) and life the energy retention
+// per bounce (Q16, 0.90-0.99). Each ball's colour comes from its index. The
+// bounce clocks follow the set in Segment::data.
+static constexpr size_t BOUNCING_BALLS_DATA =
+    cfx::ParticleSet::bytes(MAX_BALLS) + MAX_BALLS * sizeof(uint32_t);
 
-uint16_t mode_bouncing_balls(void) {
+uint16_t mode_bouncing_balls(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
   // Allocate State
-  if (!instance->_segment.allocateData(sizeof(BouncingBall) * MAX_BALLS)) {
+  if (!instance->_segment.allocateData(BOUNCING_BALLS_DATA)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
-             (size_t)(sizeof(BouncingBall) * MAX_BALLS)); // CFX-007
-    return mode_static();
+             BOUNCING_BALLS_DATA); // CFX-007
+    return mode_static(ctx);
   }
-  BouncingBall *balls =
-      reinterpret_cast<BouncingBall *>(instance->_segment.data);
+  cfx::ParticleSet balls =
+      cfx::ParticleSet::bind(instance->_segment.data, MAX_BALLS);
+  uint32_t *lastBounce = reinterpret_cast<uint32_t *>(
+      instance->_segment.data + cfx::ParticleSet::bytes(MAX_BALLS));
+
+  const uint16_t len = instance->_segment.length();
+  const int32_t top = len > 0 ? len - 1 : 0;
 
   // Initialize/Reset
   if (instance->_segment.reset) {
     for (int i = 0; i < MAX_BALLS; i++) {
-      balls[i].clockTimeAtLastBounce = instance->now;
-      balls[i].height = 0;
-      balls[i].impactVelocity = 0; // Will be set by re-injection
-      balls[i].dampening = 0.90f;
+      // Impact velocity is set by re-injection on the first bounce
+      balls.spawn(i, 0, 0, cfx::q16_from_float(0.90f), 0);
+      lastBounce[i] = instance->now;
     }
     instance->_segment.fill(0);
     instance->_segment.reset = false;
@@ -5804,13 +5884,13 @@ uint16_t mode_bouncing_balls(void) {
 
   // Physics Constants
   // Gravity -18.0 for snappy "real" feel (less floaty)
-  const float GRAVITY = -18.0f;
-  const float MAX_HEIGHT = 1.0f; // Normalized top of strip
+  const cfx::q16_16 GRAVITY = cfx::q16_from_int(-18);
 
-  // Calculate Launch Velocity needed to reach MAX_HEIGHT
+  // Calculate Launch Velocity needed to reach the top of the strip (1.0)
   // v = sqrt(2 * |g| * h)
   // v = sqrt(2 * 18 * 1) = 6.0
   const float V_MAX = 6.0f; // sqrt(36)
+  const cfx::q16_16 V_REINJECT = cfx::q16_from_int(2);
 
   // Controls
   uint8_t numBalls = (instance->_segment.intensity * (MAX_BALLS - 1)) / 255 + 1;
@@ -5819,74 +5899,72 @@ uint16_t mode_bouncing_balls(void) {
   // User Feedback: "Speed 25-30 is good".
   // Target: We want 128 to equal ~0.36.
   // 128 / 350.0f ~= 0.365.
-  float speedFactor = instance->_segment.speed / 350.0f;
+  const int64_t speed = instance->_segment.speed;
 
   for (int i = 0; i < numBalls; i++) {
-    float time_sec = (instance->now - balls[i].clockTimeAtLastBounce) /
-                     1000.0f * speedFactor;
+    // Q16 seconds of simulated time since the last bounce
+    const int64_t t =
+        (int64_t)(instance->now - lastBounce[i]) * speed * cfx::Q16_ONE /
+        (1000 * 350);
 
-    float h = balls[i].impactVelocity * time_sec +
-              0.5f * GRAVITY * time_sec * time_sec;
+    // h = v*t + g*t^2/2, in strip heights
+    int64_t h = ((int64_t)balls.vel[i] * t >> 16) +
+                (((int64_t)GRAVITY * t >> 16) * t >> 17);
 
     if (h <= 0) {
       h = 0;
-      balls[i].impactVelocity *= balls[i].dampening;
+      balls.vel[i] = (cfx::q16_16)((int64_t)balls.vel[i] * balls.life[i] >> 16);
 
       // Energy Re-injection
       // Inject energy if velocity drops too low (dead ball)
-      if (balls[i].impactVelocity < 2.0f) {
+      if (balls.vel[i] < V_REINJECT) {
         // Randomize nicely between 80% and 105% of max height energy
         // Range: ~0.8 * 6.0 (4.8) to ~1.05 * 6.0 (6.3)
         // This ensures they reach the top but vary a bit
         float energyMult =
             0.8f + ((hw_random8(25) / 100.0f)); // CFX-002: was rand() % 25
-        balls[i].impactVelocity = V_MAX * energyMult;
+        balls.vel[i] = cfx::q16_from_float(V_MAX * energyMult);
 
-        balls[i].dampening =
-            0.90f + ((hw_random8(10) / 100.0f)); // CFX-002: was rand() % 10
+        balls.life[i] = cfx::q16_from_float(
+            0.90f + ((hw_random8(10) / 100.0f))); // CFX-002: was rand() % 10
       }
 
-      balls[i].clockTimeAtLastBounce = instance->now;
-    }
-    balls[i].height = h;
-
-    // Draw Ball
-    // Map Normalized Height 0.0-1.0 to Strip Length
-    int pixel = (int)(h * (instance->_segment.length() - 1));
-
-    // Bounds Check
-    if (pixel >= instance->_segment.length())
-      pixel = instance->_segment.length() - 1;
-    if (pixel < 0)
-      pixel = 0;
-
-    // Color Logic
-    const uint32_t *active_palette;
-    if (instance->_segment.palette == 255 || instance->_segment.palette == 0) {
-      // Default (0) or Explicit Solid (255) -> Use Primary Color
-      fillSolidPalette(instance->_segment.colors[0]);
-      active_palette = activeSolidPalette();
-    } else {
-      active_palette = getPaletteByIndex(instance->_segment.palette);
+      lastBounce[i] = instance->now;
     }
-
-    CRGBW c = ColorFromPalette(active_palette, i * (256 / MAX_BALLS), 255);
-    uint32_t colorInt = RGBW32(c.r, c.g, c.b, c.w);
-
-    uint32_t existing = instance->_segment.getPixelColor(pixel);
-    uint8_t r = qadd8((existing >> 16) & 0xFF, (colorInt >> 16) & 0xFF);
-    uint8_t g = qadd8((existing >> 8) & 0xFF, (colorInt >> 8) & 0xFF);
-    uint8_t b = qadd8(existing & 0xFF, colorInt & 0xFF);
-    uint8_t w = qadd8((existing >> 24) & 0xFF, (colorInt >> 24) & 0xFF);
-
-    instance->_segment.setPixelColor(pixel, RGBW32(r, g, b, w));
+    // Map the height onto the strip, clamped to the last pixel
+    const int64_t px = h * top;
+    balls.pos[i] = px > cfx::q16_from_int(top) ? cfx::q16_from_int(top)
+                                                 : (cfx::q16_16)px;
   }
 
+  // Color Logic
+  const uint32_t *active_palette;
+  if (instance->_segment.palette == 255 || instance->_segment.palette == 0) {
+    // Default (0) or Explicit Solid (255) -> Use Primary Color
+    fillSolidPalette(instance->_segment.colors[0]);
+    active_palette = activeSolidPalette();
+  } else {
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
+  }
+
+  // Draw Balls, added onto the fading trails
+  int lo = len, hi = 0;
+  balls.render_add(
+      instance->_segment.pixels, len, 0, numBalls,
+      [&](uint16_t i) -> uint32_t {
+        CRGBW c = ColorFromPalette(instance, active_palette,
+                                   i * (256 / MAX_BALLS), 255);
+        return RGBW32(c.r, c.g, c.b, c.w);
+      },
+      lo, hi);
+  if (lo < hi)
+    instance->_segment.markDirty(lo, hi);
+
   // Progress tracking: highest ball position gives "activity front"
   {
     int32_t highest = -1;
     for (int i = 0; i < numBalls; i++) {
-      int px = (int)(balls[i].height * (instance->_segment.length() - 1));
+      int px = cfx::q16_floor(balls.pos[i]);
       if (px > highest) highest = px;
     }
     if (highest >= 0)
@@ -5906,7 +5984,9 @@ uint16_t mode_bouncing_balls(void) {
  * Alternate between color1 and color2
  * if(strobe == true) then create a strobe effect
  */
-uint16_t blink(uint32_t color1, uint32_t color2, bool strobe, bool do_palette) {
+uint16_t blink(RenderContext &ctx, uint32_t color1, uint32_t color2,
+               bool strobe, bool do_palette) {
+  CFXRunner *const instance = ctx.runner;
   uint32_t cycleTime = (255 - instance->_segment.speed) * 20;
   uint32_t onTime = FRAMETIME;
   if (!strobe)
@@ -5933,10 +6013,11 @@ uint16_t blink(uint32_t color1, uint32_t color2, bool strobe, bool do_palette) {
       // SEGMENT.color_from_palette(i, true, PALETTE_SOLID_WRAP, 0) Since we
       // lack simple palette helper in this scope, we use manual:
       const uint32_t *active_palette =
-          getPaletteByIndex(instance->_segment.palette);
+          getPaletteByIndex(instance, instance->_segment.palette);
       // PALETTE_SOLID_WRAP means wrap, we use standard logic
       uint16_t len = instance->_segment.length();
-      CRGBW c = ColorFromPalette(active_palette, (i * 255) / len, 255);
+      CRGBW c =
+          ColorFromPalette(instance, active_palette, (i * 255) / len, 255);
       instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
     }
   } else {
@@ -5949,16 +6030,18 @@ uint16_t blink(uint32_t color1, uint32_t color2, bool strobe, bool do_palette) {
 /*
  * Normal blinking. Intensity sets duty cycle.
  */
-uint16_t mode_blink(void) {
-  return blink(instance->_segment.colors[0], instance->_segment.colors[1],
+uint16_t mode_blink(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
+  return blink(ctx, instance->_segment.colors[0], instance->_segment.colors[1],
                false, true);
 }
 
 /*
  * Classic Blink effect. Cycling through the rainbow.
  */
-uint16_t mode_blink_rainbow(void) {
-  return blink(cfx::color_wheel(instance->_segment.call & 0xFF),
+uint16_t mode_blink_rainbow(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
+  return blink(ctx, cfx::color_wheel(instance->_segment.call & 0xFF),
                instance->_segment.colors[1], false, false);
 }
 
@@ -5966,7 +6049,8 @@ uint16_t mode_blink_rainbow(void) {
  * Classic Strobe effect.
  * Refined to use stateful timing (aux0/aux1) for stability at high speeds.
  */
-uint16_t mode_strobe(void) {
+uint16_t mode_strobe(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   // 1. Initialization
   if (instance->_segment.reset) {
     instance->_segment.aux1 = 1; // Start ON
@@ -6001,14 +6085,14 @@ uint16_t mode_strobe(void) {
     uint32_t color = instance->_segment.colors[0];
 
     // Palette handling with "Primary Color" override for Solid/Default
-    // Identical to our blink() fix: if Solid/Default, use Primary Color.
+    // Identical to our blink(ctx) fix: if Solid/Default, use Primary Color.
     if (instance->_segment.palette != 0 && instance->_segment.palette != 255) {
       const uint32_t *active_palette =
-          getPaletteByIndex(instance->_segment.palette);
+          getPaletteByIndex(instance, instance->_segment.palette);
       uint16_t len = instance->_segment.length();
       for (unsigned i = 0; i < len; i++) {
         uint8_t colorIndex = (i * 255) / len;
-        CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
+        CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
         instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
       }
     } else {
@@ -6026,7 +6110,8 @@ uint16_t mode_strobe(void) {
  * Classic Strobe effect. Cycling through the rainbow.
  * Refined to use stateful timing (aux0/aux1) for stability at high speeds.
  */
-uint16_t mode_strobe_rainbow(void) {
+uint16_t mode_strobe_rainbow(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   // 1. Initialization
   if (instance->_segment.reset) {
     instance->_segment.aux1 = 1; // Start ON
@@ -6069,7 +6154,8 @@ uint16_t mode_strobe_rainbow(void) {
  * Multi Strobe logic
  * Refined to match stateful structure and include Primary Color fix.
  */
-uint16_t mode_multi_strobe(void) {
+uint16_t mode_multi_strobe(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   // 1. Initialization
   if (instance->_segment.reset) {
     instance->_segment.aux1 = 1000; // Trigger cycle reset
@@ -6119,11 +6205,11 @@ uint16_t mode_multi_strobe(void) {
     uint32_t color = instance->_segment.colors[0];
     if (instance->_segment.palette != 0 && instance->_segment.palette != 255) {
       const uint32_t *active_palette =
-          getPaletteByIndex(instance->_segment.palette);
+          getPaletteByIndex(instance, instance->_segment.palette);
       uint16_t len = instance->_segment.length();
       for (unsigned i = 0; i < len; i++) {
         uint8_t colorIndex = (i * 255) / len;
-        CRGBW c = ColorFromPalette(active_palette, colorIndex, 255);
+        CRGBW c = ColorFromPalette(instance, active_palette, colorIndex, 255);
         instance->_segment.setPixelColor(i, RGBW32(c.r, c.g, c.b, c.w));
       }
     } else {
@@ -6136,16 +6222,20 @@ uint16_t mode_multi_strobe(void) {
   return FRAMETIME;
 }
 
-static uint16_t running_base(bool saw, bool dual = false) {
+static uint16_t running_base(RenderContext &ctx, bool saw, bool dual = false) {
+  CFXRunner *const instance = ctx.runner;
   uint16_t len = instance->_segment.length();
   unsigned x_scale = instance->_segment.intensity >> 2;
-  uint32_t counter = (instance->now * instance->_segment.speed) >> 9;
+  uint32_t counter =
+      cfx::scale_time(instance->now, instance->_segment.speed, 9);
   const bool use_palette =
       instance->_segment.palette != 0 && instance->_segment.palette != 255;
   const uint32_t *active_palette =
-      use_palette ? getPaletteByIndex(instance->_segment.palette) : nullptr;
+      use_palette ? getPaletteByIndex(instance,
+                                      instance->_segment.palette) : nullptr;
   const uint32_t color1 = instance->_segment.colors[1];
   const uint32_t solid_color = instance->_segment.colors[0];
+  uint32_t span[SPAN_CHUNK];
 
   for (unsigned i = 0; i < len; i++) {
     unsigned a = i * x_scale - counter;
@@ -6170,7 +6260,7 @@ static uint16_t running_base(bool saw, bool dual = false) {
     } else {
       // Palette mode: use palette color for 'i'
       palette_index = (i * 255) / len;
-      CRGBW c = ColorFromPalette(active_palette, palette_index, 255);
+      CRGBW c = ColorFromPalette(instance, active_palette, palette_index, 255);
       color2 = RGBW32(c.r, c.g, c.b, c.w);
     }
 
@@ -6184,23 +6274,32 @@ static uint16_t running_base(bool saw, bool dual = false) {
       if (!use_palette) {
         color3 = solid_color; // Use Primary color (fix solid palette hole)
       } else {
-        CRGBW c = ColorFromPalette(active_palette, palette_index + 128, 255);
+        CRGBW c =
+            ColorFromPalette(instance, active_palette, palette_index + 128,
+                             255);
         color3 = RGBW32(c.r, c.g, c.b, c.w);
       }
       ca = color_blend(ca, color3, s2);
     }
 
-    instance->_segment.setPixelColor(i, ca);
+    span[i % SPAN_CHUNK] = ca;
+    if (i % SPAN_CHUNK == SPAN_CHUNK - 1 || i == len - 1u)
+      instance->_segment.writeSpan(i - i % SPAN_CHUNK, span,
+                                   i % SPAN_CHUNK + 1);
   }
 
   return FRAMETIME;
 }
 
-uint16_t mode_running_lights(void) { return running_base(false); }
+uint16_t mode_running_lights(RenderContext &ctx) {
+  return running_base(ctx, false);
+}
 
-uint16_t mode_running_dual(void) { return running_base(false, true); }
+uint16_t mode_running_dual(RenderContext &ctx) {
+  return running_base(ctx, false, true);
+}
 
-uint16_t mode_saw(void) { return running_base(true); }
+uint16_t mode_saw(RenderContext &ctx) { return running_base(ctx, true); }
 
 // --- Simple Effects Batch (ID 3, 4, 6, 23) ---
 
@@ -6214,7 +6313,8 @@ static inline uint8_t cfx_clean_edge_amount(uint8_t amount) {
   return amount;
 }
 
-uint16_t color_wipe(bool rev, bool useRandomColors) {
+uint16_t color_wipe(RenderContext &ctx, bool rev, bool useRandomColors) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
@@ -6301,77 +6401,113 @@ uint16_t color_wipe(bool rev, bool useRandomColors) {
   } else if (instance->_segment.palette == 255) {
     active_palette = activeSolidPalette();
   } else {
-    active_palette = getPaletteByIndex(instance->_segment.palette);
+    active_palette = getPaletteByIndex(instance, instance->_segment.palette);
   }
 
   // Background Color Logic
   uint32_t col1 = 0; // Default to Black/Off
   if (useRandomColors) {
-    CRGBW c1 = ColorFromPalette(active_palette, instance->_segment.aux1, 255);
+    CRGBW c1 =
+        ColorFromPalette(instance, active_palette, instance->_segment.aux1,
+                         255);
     col1 = RGBW32(c1.r, c1.g, c1.b, c1.w);
   }
 
+  // Foreground Color Construction: solid/random are uniform, any other
+  // palette is a smooth gradient across the strip (CFX-035).
+  const bool gradient = !useRandomColors && instance->_segment.palette != 255 &&
+                        instance->_segment.palette != 0;
+  uint32_t solid0 = instance->_segment.colors[0];
+  if (useRandomColors) {
+    CRGBW c0 =
+        ColorFromPalette(instance, active_palette, instance->_segment.aux0,
+                         255);
+    solid0 = RGBW32(c0.r, c0.g, c0.b, c0.w);
+  }
+
   // Optimize gradient mapping division out of the loop
   uint32_t palStep = len > 0 ? (255 << 8) / len : 0;
+  auto foreground = [&](int i) -> uint32_t {
+    if (!gradient)
+      return solid0;
+    uint8_t colorIndex = (i * palStep) >> 8;
+    CRGBW c0 = ColorFromPalette(instance, active_palette, colorIndex, 255);
+    return RGBW32(c0.r, c0.g, c0.b, c0.w);
+  };
 
-  for (int i = 0; i < len; i++) {
-    int index = (rev && back) ? len - 1 - i : i;
-
-    // Foreground Color Construction
-    uint32_t col0;
-    if (useRandomColors) {
-      CRGBW c0 = ColorFromPalette(active_palette, instance->_segment.aux0, 255);
-      col0 = RGBW32(c0.r, c0.g, c0.b, c0.w);
-    } else if (instance->_segment.palette == 255 ||
-               (!useRandomColors && instance->_segment.palette == 0)) {
-      col0 = instance->_segment.colors[0]; // Solid Color
-    } else {
-      // CFX-035: Smooth gradient across the strip (optimized div)
-      uint8_t colorIndex = (i * palStep) >> 8;
-      CRGBW c0 = ColorFromPalette(active_palette, colorIndex, 255);
-      col0 = RGBW32(c0.r, c0.g, c0.b, c0.w);
+  // Logic: Always wipe 'fillCol' over 'baseCol'.
+  // Standard/Random Wipe: Fill FG (col0) over BG (col1).
+  // Sweep Return (rev && back): Fill BG (col1) over FG (col0) -> "Erase"
+  // effect, rendered back to front.
+  const bool reversed = rev && back;
+  const int n_len = (int)len;
+  Segment &seg = instance->_segment;
+  uint32_t span[SPAN_CHUNK];
+  auto render = [&](int a, int b, auto &&color_at) {
+    for (int c0 = a; c0 < b; c0 += SPAN_CHUNK) {
+      int n = std::min(SPAN_CHUNK, b - c0);
+      for (int k = 0; k < n; k++)
+        span[k] = color_at(c0 + k);
+      seg.writeSpan(reversed ? n_len - c0 - n : c0, span, n, reversed);
     }
+  };
+  auto put_uniform = [&](int a, int b, uint32_t c) {
+    if (b > a)
+      seg.fillRange(reversed ? n_len - b : a, b - a, c);
+  };
+
+  // Split the strip at the wipe front: [0, behind_end) is fully behind it
+  // (blend 255), [ahead_start, len) fully ahead (blend 0), and only the
+  // feathered band in between needs a per-pixel blend.
+  int ahead_start = std::min<int>(n_len, (totalPos + 32767u) >> 15);
+  int behind_end = 0;
+  if (totalPos >= fadeWidth)
+    behind_end = std::min<int>(ahead_start, ((totalPos - fadeWidth) >> 15) + 1);
 
+  if (reversed || !gradient)
+    put_uniform(0, behind_end, reversed ? col1 : solid0);
+  else
+    render(0, behind_end, foreground);
+
+  render(behind_end, ahead_start, [&](int i) -> uint32_t {
     uint32_t pixelPos = (uint32_t)i << 15;
     int32_t dist = (int32_t)(totalPos - pixelPos);
 
     uint8_t blendVal;
     if (dist <= 0) {
       blendVal = 0; // Completely ahead (Background)
-    } else if (dist >= fadeWidth) {
+    } else if (dist >= (int32_t)fadeWidth) {
       blendVal = 255; // Completely behind (Foreground)
     } else {
       blendVal = (uint8_t)((dist * 255) / fadeWidth);
     }
     blendVal = cfx_clean_edge_amount(blendVal);
 
-    // Applying Blend
-    // Logic: Always wipe 'fillCol' over 'baseCol'.
-    // Standard/Random Wipe: Fill FG (col0) over BG (col1).
-    // Sweep Return (rev && back): Fill BG (col1) over FG (col0) -> "Erase"
-    // effect.
-
-    uint32_t fillCol = col0;
-    uint32_t baseCol = col1;
-
-    if (rev && back) {
-      fillCol = col1;
-      baseCol = col0;
-    }
+    uint32_t col0 = foreground(i);
+    uint32_t fillCol = reversed ? col1 : col0;
+    uint32_t baseCol = reversed ? col0 : col1;
+    return color_blend(baseCol, fillCol, blendVal);
+  });
 
-    // Always blend fillCol over baseCol
-    uint32_t finalColor = color_blend(baseCol, fillCol, blendVal);
+  if (!reversed || !gradient)
+    put_uniform(ahead_start, n_len, reversed ? solid0 : col1);
+  else
+    render(ahead_start, n_len, foreground);
 
-    instance->_segment.setPixelColor(index, finalColor);
-  }
   return FRAMETIME;
 }
 
-uint16_t mode_color_wipe(void) { return color_wipe(false, false); }
+uint16_t mode_color_wipe(RenderContext &ctx) {
+  return color_wipe(ctx, false, false);
+}
 
-uint16_t mode_color_wipe_random(void) { return color_wipe(false, true); }
+uint16_t mode_color_wipe_random(RenderContext &ctx) {
+  return color_wipe(ctx, false, true);
+}
 
-uint16_t mode_color_sweep(void) { return color_wipe(true, false); }
+uint16_t mode_color_sweep(RenderContext &ctx) {
+  return color_wipe(ctx, true, false);
+}
 
 // --- INTRO IMPLEMENTATION ---
 
@@ -6511,8 +6647,21 @@ bool CFXRunner::serviceIntro() {
 }
 
 void CFXRunner::reset() {
-  _virtual_now = 0.0f;
-  _accum_ms = 0;
+  const uint64_t now_us = cfx_micros_64();
+  _timebase.reset(now_us);
+#if CFX_HAS_SYNC_GROUP_CLOCK
+  if (group_clock_key != nullptr) {
+    // The leader's restart is the group's new epoch; a follower starts at
+    // the leader's current position instead of 0.
+    auto &clock = esphome::cfx_sync::CFXSyncGroupClock::get();
+    uint64_t group_elapsed_us;
+    if (!clock.restart(group_clock_key, now_us) &&
+        clock.timeline_us(group_clock_key, now_us, group_elapsed_us))
+      _timebase.seek(group_elapsed_us);
+  }
+#endif
+  _segment.phase.reset();
+  _governor.wake();
   _segment.call = 0;
   // Reset mutable runtime controls to neutral defaults so a reused runner
   // never carries sequence/cfx_set leftovers into the next effect start.
@@ -6525,7 +6674,6 @@ void CFXRunner::reset() {
   iteration_count_ = 0;
   effect_complete_ = false;
   _segment.reset = true;
-  _last_frame = cfx_millis();
   current_leading_pixel = -1;
   is_return_phase_ = false;
   // Ownership flags are cleared on reset so a bare light.turn_on after a
@@ -6540,7 +6688,8 @@ void CFXRunner::reset() {
 // Same logic as Heartbeat, but mapping pulse to width from center
 // --- Heartbeat Center Effect (ID 154) ---
 // Same logic as Heartbeat, but mapping pulse to width from center
-uint16_t mode_heartbeat_center(void) {
+uint16_t mode_heartbeat_center(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return 350;
 
@@ -6641,8 +6790,9 @@ uint16_t mode_heartbeat_center(void) {
       if (instance->_segment.palette != 0 &&
           instance->_segment.palette != 255) {
         const uint32_t *active_palette =
-            getPaletteByIndex(instance->_segment.palette);
-        CRGBW c = ColorFromPalette(active_palette, (i * 255) / len, 255);
+            getPaletteByIndex(instance, instance->_segment.palette);
+        CRGBW c =
+            ColorFromPalette(instance, active_palette, (i * 255) / len, 255);
         pixel_color = RGBW32(c.r, c.g, c.b, c.w);
       }
 
@@ -6673,13 +6823,14 @@ uint16_t mode_heartbeat_center(void) {
  * kaleidoscope illusion. Uses a pure sub-pixel triangle wave phase engine
  * to guarantee flawless scrolling mirrors.
  */
-uint16_t mode_kaleidos(void) {
+uint16_t mode_kaleidos(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
   uint16_t len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   uint32_t ms = cfx_millis();
   // Speed 0 = very slow, Speed 255 = fast
@@ -6703,12 +6854,19 @@ uint16_t mode_kaleidos(void) {
   // Map sine to 0.7 - 1.3 (+/- 30% width variation)
   float breath_factor = 0.7f + (cfx::sin8(breath_phase) * 0.6f / 255.0f);
 
-  // Phase step per pixel
+  // Phase step per pixel. On a matrix the fold runs outward from the centre
+  // in diamond rings: distance is counted in half pixels so even sides stay
+  // symmetric, and the segments fit across width + height of them.
+  const bool grid = instance->_segment.is2D();
+  const uint16_t width = instance->_segment.virtualWidth();
+  const uint16_t height = instance->_segment.virtualHeight();
   uint32_t total_dynamic_phase = (uint32_t)(total_base_phase * breath_factor);
-  uint32_t phase_step = total_dynamic_phase / len;
+  uint32_t phase_step = total_dynamic_phase / (grid ? width + height : len);
+  uint32_t pixel_step = grid ? phase_step * 2 : phase_step;
 
   // === Palette ===
-  const uint32_t *palette = getPaletteByIndex(instance->_segment.palette);
+  const uint32_t *palette =
+      getPaletteByIndex(instance, instance->_segment.palette);
   // Handle solid color palette
   if (instance->_segment.palette == 255 || instance->_segment.palette == 21) {
     fillSolidPalette(instance->_segment.colors[0]);
@@ -6716,10 +6874,18 @@ uint16_t mode_kaleidos(void) {
 
   // === Render Loop ===
   // Glint settings: glint is ~1.5 pixels wide
-  uint32_t glint_radius = phase_step + (phase_step >> 1);
+  uint32_t glint_radius = pixel_step + (pixel_step >> 1);
 
   for (int i = 0; i < len; i++) {
-    uint32_t spatial_phase = i * phase_step;
+    uint32_t spatial_phase;
+    if (grid) {
+      const int x = i % width;
+      const int y = i / width;
+      spatial_phase =
+          (abs(2 * x - (width - 1)) + abs(2 * y - (height - 1))) * phase_step;
+    } else {
+      spatial_phase = i * phase_step;
+    }
 
     // Triangle wave fold
     uint16_t cycle = (spatial_phase >> 16);
@@ -6738,7 +6904,7 @@ uint16_t mode_kaleidos(void) {
     uint8_t color_index = (uint8_t)((folded_phase >> 8) + cycle_time);
 
     // Get base kaleidoscope color
-    CRGBW c = ColorFromPalette(palette, color_index, 255);
+    CRGBW c = ColorFromPalette(instance, palette, color_index, 255);
 
     // === Prism Glints (Option B) ===
     // Distance to nearest symmetry bound (0 or 65536 equivalent in
@@ -6797,19 +6963,20 @@ struct FollowMeData {
   uint8_t restart_brightness; // For fade-out in RESTART state
 };
 
-uint16_t mode_follow_me(void) {
+uint16_t mode_follow_me(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
   uint16_t len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   // === Allocate State ===
   if (!instance->_segment.allocateData(sizeof(FollowMeData))) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(sizeof(FollowMeData))); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
 
   FollowMeData *fm = reinterpret_cast<FollowMeData *>(instance->_segment.data);
@@ -6831,7 +6998,8 @@ uint16_t mode_follow_me(void) {
 
   // === Palette (Ignored per request) ===
   fillSolidPalette(instance->_segment.colors[0]);
-  const uint32_t *palette = getPaletteByIndex(255); // Solid Palette via ID 255
+  const uint32_t *palette =
+      getPaletteByIndex(instance, 255); // Solid Palette via ID 255
 
   // === Trail Fade (Subtractive) ===
   // Fixes persistence issue: Ensure we always subtract enough to clear the
@@ -6852,40 +7020,38 @@ uint16_t mode_follow_me(void) {
                     : (instance->_segment.intensity < 90) ? 4
                                                           : 2;
 
-  int start = instance->_segment.start;
-  int stop = instance->_segment.stop;
-  esphome::light::AddressableLight &light = *instance->target_light;
-
-  for (int i = start; i < stop; i++) {
-    if (i < light.size()) {
-      esphome::Color c = light[i].get();
+  Segment &seg = instance->_segment;
 
-      // 1. Scale
-      c.r = cfx::scale8(c.r, scale);
-      c.g = cfx::scale8(c.g, scale);
-      c.b = cfx::scale8(c.b, scale);
-      c.w = cfx::scale8(c.w, scale);
-
-      // 2. Subtract (Floor Cleaning)
-      c.r = (c.r > sub_val) ? (c.r - sub_val) : 0;
-      c.g = (c.g > sub_val) ? (c.g - sub_val) : 0;
-      c.b = (c.b > sub_val) ? (c.b - sub_val) : 0;
-      c.w = (c.w > sub_val) ? (c.w - sub_val) : 0;
+  for (int i = 0; i < len; i++) {
+    uint32_t px = seg.getPixelColor(i);
+    if (px == 0)
+      continue;
 
-      // 3. Hard Cutoff (Final Cleanup)
-      // Increased threshold to 20 for absolute clearance of low-level
-      // noise.
-      if (c.r < 20)
-        c.r = 0;
-      if (c.g < 20)
-        c.g = 0;
-      if (c.b < 20)
-        c.b = 0;
-      if (c.w < 20)
-        c.w = 0;
+    // 1. Scale
+    uint8_t r = cfx::scale8(CFX_R(px), scale);
+    uint8_t g = cfx::scale8(CFX_G(px), scale);
+    uint8_t b = cfx::scale8(CFX_B(px), scale);
+    uint8_t w = cfx::scale8(CFX_W(px), scale);
+
+    // 2. Subtract (Floor Cleaning)
+    r = (r > sub_val) ? (r - sub_val) : 0;
+    g = (g > sub_val) ? (g - sub_val) : 0;
+    b = (b > sub_val) ? (b - sub_val) : 0;
+    w = (w > sub_val) ? (w - sub_val) : 0;
+
+    // 3. Hard Cutoff (Final Cleanup)
+    // Increased threshold to 20 for absolute clearance of low-level
+    // noise.
+    if (r < 20)
+      r = 0;
+    if (g < 20)
+      g = 0;
+    if (b < 20)
+      b = 0;
+    if (w < 20)
+      w = 0;
 
-      light[i] = c;
-    }
+    seg.setPixelColor(i, RGBW32(r, g, b, w));
   }
 
   // === Strobe Frequency ===
@@ -6906,7 +7072,7 @@ uint16_t mode_follow_me(void) {
     uint8_t bri = beatsin8(60, 50, 255);
     for (int j = 0; j < cursor_size && j < len; j++) {
       uint8_t ci = (j * 255) / cursor_size;
-      CRGBW c = ColorFromPalette(palette, ci, bri);
+      CRGBW c = ColorFromPalette(instance, palette, ci, bri);
       instance->_segment.setPixelColor(j, RGBW32(c.r, c.g, c.b, c.w));
     }
 
@@ -6942,7 +7108,7 @@ uint16_t mode_follow_me(void) {
         // color regardless of index (usually). Let's rely on standard
         // behavior.
         uint8_t ci = (j * 255) / cursor_size;
-        CRGBW c = ColorFromPalette(palette, ci, 255);
+        CRGBW c = ColorFromPalette(instance, palette, ci, 255);
         instance->_segment.setPixelColor(px, RGBW32(c.r, c.g, c.b, c.w));
       }
     }
@@ -6969,7 +7135,7 @@ uint16_t mode_follow_me(void) {
         if (px < len) {
           // Use Palette Color (Solid) exclusively
           uint8_t ci = (j * 255) / cursor_size;
-          CRGBW c = ColorFromPalette(palette, ci, 255);
+          CRGBW c = ColorFromPalette(instance, palette, ci, 255);
           instance->_segment.setPixelColor(px, RGBW32(c.r, c.g, c.b, c.w));
         }
       }
@@ -7059,19 +7225,20 @@ struct FollowUsData {
   CursorPart parts[3];
 };
 
-uint16_t mode_follow_us(void) {
+uint16_t mode_follow_us(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
   uint16_t len = instance->_segment.length();
   if (len <= 9)
-    return mode_static();
+    return mode_static(ctx);
 
   // === Allocate State ===
   if (!instance->_segment.allocateData(sizeof(FollowUsData))) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
              (size_t)(sizeof(FollowUsData))); // CFX-007
-    return mode_static();
+    return mode_static(ctx);
   }
 
   FollowUsData *fu = reinterpret_cast<FollowUsData *>(instance->_segment.data);
@@ -7284,13 +7451,14 @@ uint16_t mode_follow_us(void) {
 // Subtle moving water surface + physical drop sequences (fall -> impact ->
 // ripple) Zero allocated buffers — safe for multi-strip operation
 #define FLUID_RAIN_NUM_DROPS 5
-uint16_t mode_fluid_rain(void) {
+uint16_t mode_fluid_rain(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
   int len = instance->_segment.length();
   if (len <= 1)
-    return mode_static();
+    return mode_static(ctx);
 
   uint8_t speed = instance->_segment.speed;
   uint8_t intensity = instance->_segment.intensity;
@@ -7303,7 +7471,7 @@ uint16_t mode_fluid_rain(void) {
 
   // Time base (slowed way down for ultimate smoothness)
   uint32_t now = cfx_millis();
-  uint32_t t = (now * (eff_speed + 1) * 200) >> 17;
+  uint32_t t = cfx::scale_time(now, (eff_speed + 1) * 200, 17);
 
   // === SUBTLE BACKGROUND WATER SURFACE ===
   uint16_t wave1 = t;
@@ -7317,17 +7485,17 @@ uint16_t mode_fluid_rain(void) {
   uint16_t cycle_len = 300 - ((intensity * 60) >> 8); // 300 to 240 units total
 
   // Palette
-  const uint32_t *pal = getPaletteByIndex(instance->_segment.palette);
+  const uint32_t *pal = getPaletteByIndex(instance, instance->_segment.palette);
   bool is_solid = (instance->_segment.palette == 255);
   uint32_t solid_color = is_solid ? instance->_segment.colors[0] : 0;
 
-  // Pre-compute drop states
-  struct {
-    int center;    // Impact location in 16-bit sub-pixel space (pixel * 256)
-    uint8_t phase; // 1=impact, 2=ripple spreading, 3=fade
-    uint16_t ripple_rad; // Current radius in 16-bit sub-pixel space
-    uint8_t bright;      // Current brightness of the active element
-  } drops[FLUID_RAIN_NUM_DROPS];
+  // Pre-compute drop states. The drops derive from the clock every frame, so
+  // the particle set lives on the stack: pos is the impact center and vel
+  // the ripple radius (pixels, Q16.16), life the brightness of the active
+  // element and hue the phase (1=impact, 2=ripple spreading, 3=fade).
+  alignas(4) uint8_t drop_data[cfx::ParticleSet::bytes(FLUID_RAIN_NUM_DROPS)];
+  cfx::ParticleSet drops =
+      cfx::ParticleSet::bind(drop_data, FLUID_RAIN_NUM_DROPS);
 
   for (int d = 0; d < FLUID_RAIN_NUM_DROPS; d++) {
     uint32_t drop_t = t + d * (cycle_len / FLUID_RAIN_NUM_DROPS);
@@ -7338,8 +7506,8 @@ uint16_t mode_fluid_rain(void) {
     // * 256)
     uint16_t center_pixel =
         (sin8((uint8_t)(cycle_num * 37 + d * 73)) * (len - 14)) >> 8;
-    center_pixel += 7;                   // Generous margin
-    drops[d].center = center_pixel << 8; // Convert to sub-pixel space
+    center_pixel += 7; // Generous margin
+    drops.pos[d] = cfx::q16_from_int(center_pixel);
 
     // Phase timing thresholds
     uint16_t t_ripple = cycle_len / 5; // 20% time spent as impact flash
@@ -7347,12 +7515,13 @@ uint16_t mode_fluid_rain(void) {
 
     if (c_phase < t_ripple) {
       // 1. IMPACT: bright flash at center that quickly dims
-      drops[d].phase = 1;
-      drops[d].bright = 255 - (255 * c_phase / t_ripple);
+      drops.hue[d] = 1;
+      drops.vel[d] = 0;
+      drops.life[d] = 255 - (255 * c_phase / t_ripple);
 
     } else {
       // 2 & 3. RIPPLE: expanding ring
-      drops[d].phase = (c_phase < t_fade) ? 2 : 3;
+      drops.hue[d] = (c_phase < t_fade) ? 2 : 3;
 
       // Radius grows over time, smoothly due to sub-pixel math.
       // Every step of c_phase expands radius by a fractional amount
@@ -7361,16 +7530,17 @@ uint16_t mode_fluid_rain(void) {
       // Maximum desired radius before fade out (e.g. 15 pixels)
       // distance = (time / duration) * max_distance * 256
       uint16_t expansion_duration = cycle_len - t_ripple;
-      drops[d].ripple_rad = (time_in_ripple * 15 * 256) / expansion_duration;
+      // (kept on the 1/256 pixel grid the ring is drawn on)
+      drops.vel[d] = ((time_in_ripple * 15 * 256) / expansion_duration) << 8;
 
       // Brightness envelope
-      if (drops[d].phase == 2) {
-        drops[d].bright = 220; // Strong ripple
+      if (drops.hue[d] == 2) {
+        drops.life[d] = 220; // Strong ripple
       } else {
         // Fade out
         uint16_t time_in_fade = c_phase - t_fade;
         uint16_t fade_duration = cycle_len - t_fade;
-        drops[d].bright = 220 - (220 * time_in_fade / fade_duration);
+        drops.life[d] = 220 - (220 * time_in_fade / fade_duration);
       }
     }
   }
@@ -7393,29 +7563,31 @@ uint16_t mode_fluid_rain(void) {
     int i_sub = i << 8;
 
     for (int d = 0; d < FLUID_RAIN_NUM_DROPS; d++) {
-      int dist = abs(i_sub - drops[d].center) >> 8; // Integer pixel distance
-      if (drops[d].phase == 1) {
+      const int center = drops.pos[d] >> 8; // Sub-pixel space (pixel * 256)
+      const uint8_t bright = (uint8_t)drops.life[d];
+      int dist = abs(i_sub - center) >> 8; // Integer pixel distance
+      if (drops.hue[d] == 1) {
         // Impact flash (sharp point at center)
         if (dist == 0)
-          white_add = qadd8(white_add, drops[d].bright);
+          white_add = qadd8(white_add, bright);
         else if (dist == 1)
-          white_add = qadd8(white_add, drops[d].bright >> 1);
+          white_add = qadd8(white_add, bright >> 1);
       } else {
         // While the ripple expands, keep a persistent white dot at the
         // center so the user knows where the ripple originated.
         if (dist == 0) {
-          white_add = qadd8(white_add, drops[d].bright);
+          white_add = qadd8(white_add, bright);
         } else if (dist == 1) {
-          white_add = qadd8(white_add, drops[d].bright >> 2);
+          white_add = qadd8(white_add, bright >> 2);
         }
 
         // ANTI-ALIASED RIPPLE RING
         // Distance from center to current pixel (in sub-pixels)
-        int dist_sub = abs(i_sub - drops[d].center);
+        int dist_sub = abs(i_sub - center);
 
         // Distance from pixel to the exactly ideal ring radius (in
         // sub-pixels)
-        int ring_dist_sub = abs(dist_sub - drops[d].ripple_rad);
+        int ring_dist_sub = abs(dist_sub - (drops.vel[d] >> 8));
 
         // WIDENED RIPPLE: Render a ring 4.0 pixels wide (1024 subpixels)
         // for smooth blending If ring_dist_sub is 0, brightness is 100%. If
@@ -7423,7 +7595,7 @@ uint16_t mode_fluid_rain(void) {
         if (ring_dist_sub < 1024) {
           // Inverse linear falloff from center of the ring
           uint8_t intensity_scale = 255 - (ring_dist_sub >> 2);
-          uint8_t pixel_bri = (drops[d].bright * intensity_scale) >> 8;
+          uint8_t pixel_bri = (bright * intensity_scale) >> 8;
           color_add = qadd8(color_add, pixel_bri);
         }
       }
@@ -7440,7 +7612,7 @@ uint16_t mode_fluid_rain(void) {
       c = RGBW32((sc.r * pal_index) >> 8, (sc.g * pal_index) >> 8,
                  (sc.b * pal_index) >> 8, (sc.w * pal_index) >> 8);
     } else {
-      CRGBW cWLED = ColorFromPalette(pal, pal_index, 255);
+      CRGBW cWLED = ColorFromPalette(instance, pal, pal_index, 255);
 
       // Inject the pure white impacts ON TOP of the palette color
       if (white_add > 0) {
@@ -7467,7 +7639,8 @@ uint16_t mode_fluid_rain(void) {
 // Upgraded physics: colliding edges "glue" together (slow down
 // significantly). Visuals: Nodes act as portals/masks for a scrolling
 // palette gradient.
-uint16_t mode_collider(void) {
+uint16_t mode_collider(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
@@ -7485,69 +7658,72 @@ uint16_t mode_collider(void) {
     spacing = 6;
   uint16_t numNodes = (len + spacing - 1) / spacing;
 
-  // 2. Persistence
-  if (!instance->_segment.allocateData(numNodes * sizeof(ColliderNode))) {
+  // 2. Persistence: one particle per node on the fixed-point engine. pos is
+  // the node radius in pixels, vel its direction (+/-1.0, 0 = uninitialized)
+  // and life the glue timer. Nodes push on their right-hand neighbour, so
+  // they step in order rather than as a batch.
+  const size_t dataSize = cfx::ParticleSet::bytes(numNodes);
+  if (!instance->_segment.allocateData(dataSize)) {
     ESP_LOGW("CFX", "%s: allocateData(%zu) failed", __func__,
-             numNodes * sizeof(ColliderNode)); // CFX-016 / CFX-007
-    return mode_static();
+             dataSize); // CFX-016 / CFX-007
+    return mode_static(ctx);
   }
-  ColliderNode *nodes = (ColliderNode *)instance->_segment.data;
+  cfx::ParticleSet nodes =
+      cfx::ParticleSet::bind(instance->_segment.data, numNodes);
 
   // 3. Grid Drift (Shared global shift for origins)
-  // Slow movement of the "grid centers" over time.
-  float global_drift =
-      (float)(instance->now % 65535) * 0.012f; // Increased drift
+  // Slow movement of the "grid centers" over time: 0.012 px per ms.
+  const cfx::q16_16 global_drift = (cfx::q16_16)(
+      (int64_t)(instance->now % 65535) * 12 * cfx::Q16_ONE / 1000); // Increased drift
 
   // 4. Physics Update
-  float base_step = (float)speed / 128.0f;
+  const cfx::q16_16 base_step = (cfx::q16_16)speed * (cfx::Q16_ONE / 128);
+  const cfx::q16_16 top = cfx::q16_from_int(spacing) * 7 / 10;
+  // Bridge more: allow 1.5 LEDs of overlap (3 LEDs total) before
+  // glue/retraction
+  const cfx::q16_16 bridge_limit =
+      cfx::q16_from_int(spacing) + cfx::Q16_ONE * 5 / 2;
   for (uint16_t n = 0; n < numNodes; n++) {
     // Re-initialize if state is blank or reset
-    if (nodes[n].vel == 0.0f || instance->_segment.reset) {
-      nodes[n].radius = (float)(n % 3) * (spacing / 5.0f);
-      nodes[n].vel = (n % 2 == 0 ? 1.0f : -1.0f);
-      nodes[n].glue_timer = 0;
+    if (nodes.vel[n] == 0 || instance->_segment.reset) {
+      nodes.spawn(n, cfx::q16_from_int(n % 3) * spacing / 5,
+                  n % 2 == 0 ? cfx::Q16_ONE : -cfx::Q16_ONE, 0, 0);
       if (n == numNodes - 1)
         instance->_segment.reset = false;
     }
 
     // Per-node speed variation (±20%)
-    float node_step = base_step * (0.8f + (float)(n % 5) * 0.1f);
+    cfx::q16_16 node_step = base_step * (8 + n % 5) / 10;
 
     // Magnetic Glue Logic: If collision detected, slow speed to 10%
-    if (nodes[n].glue_timer > 0) {
-      node_step *= 0.1f;
-      nodes[n].glue_timer--;
-      if (nodes[n].glue_timer == 0) {
-        nodes[n].vel = -1.0f; // Done glued, start retracting
+    if (nodes.life[n] > 0) {
+      node_step /= 10;
+      nodes.life[n]--;
+      if (nodes.life[n] == 0) {
+        nodes.vel[n] = -cfx::Q16_ONE; // Done glued, start retracting
       }
     }
 
-    nodes[n].radius += nodes[n].vel * node_step;
+    nodes.pos[n] += nodes.vel[n] > 0 ? node_step : -node_step;
 
     // Bottom Bounce
-    if (nodes[n].radius <= 0.0f) {
-      nodes[n].radius = 0.01f;
-      nodes[n].vel = 1.0f;
+    if (nodes.pos[n] <= 0) {
+      nodes.pos[n] = cfx::q16_from_float(0.01f);
+      nodes.vel[n] = cfx::Q16_ONE;
     }
 
     // Top Limit / Safety
-    if (nodes[n].radius >= (float)spacing * 0.7f) {
-      nodes[n].radius = (float)spacing * 0.7f;
-      nodes[n].vel = -1.0f;
+    if (nodes.pos[n] >= top) {
+      nodes.pos[n] = top;
+      nodes.vel[n] = -cfx::Q16_ONE;
     }
 
     // Neighbor Collision (Trigger Glue)
-    if (n < numNodes - 1) {
-      // Bridge more: allow 1.5 LEDs of overlap (3 LEDs total) before
-      // glue/retraction
-      float bridge_limit = (float)spacing + 2.5f;
-      if (nodes[n].radius + nodes[n + 1].radius >= bridge_limit) {
-        // Only trigger glue if both are expanding
-        if (nodes[n].vel > 0 && nodes[n + 1].vel > 0 &&
-            nodes[n].glue_timer == 0) {
-          nodes[n].glue_timer = 40; // Wait longer (~0.6s)
-          nodes[n + 1].glue_timer = 40;
-        }
+    if (n < numNodes - 1 && nodes.pos[n] + nodes.pos[n + 1] >= bridge_limit) {
+      // Only trigger glue if both are expanding
+      if (nodes.vel[n] > 0 && nodes.vel[n + 1] > 0 && nodes.life[n] == 0) {
+        nodes.life[n] = 40; // Wait longer (~0.6s)
+        nodes.life[n + 1] = 40;
       }
     }
   }
@@ -7558,26 +7734,28 @@ uint16_t mode_collider(void) {
   
   // CFX-032 FIX: Moving palette retrieval OUTSIDE the inner pixel loop! 
   // Prevents massive instruction cache thrashing and rendering delays under heavy load
-  const uint32_t *palData = getPaletteByIndex(instance->_segment.palette);
+  const uint32_t *palData =
+      getPaletteByIndex(instance, instance->_segment.palette);
 
+  const cfx::q16_16 strip = cfx::q16_from_int(len);
   for (uint16_t n = 0; n < numNodes; n++) {
     // Calculate center with drift
-    float center_f = (float)(n * spacing + (spacing / 2)) + global_drift;
+    cfx::q16_16 center =
+        cfx::q16_from_int(n * spacing + (spacing / 2)) + global_drift;
     // Wrap drift around strip length
-    while (center_f >= (float)len)
-      center_f -= (float)len;
-    while (center_f < 0.0f)
-      center_f += (float)len;
+    while (center >= strip)
+      center -= strip;
+    while (center < 0)
+      center += strip;
 
-    float node_r = nodes[n].radius;
+    const cfx::q16_16 node_r = nodes.pos[n];
     // Render range: floor to ceil + safety padding for anti-alias bleed
-    int r_start = (int)floorf(center_f - node_r - 1.0f);
-    int r_stop = (int)ceilf(center_f + node_r + 1.0f);
+    int r_start = cfx::q16_floor(center - node_r - cfx::Q16_ONE);
+    int r_stop = -cfx::q16_floor(-(center + node_r + cfx::Q16_ONE));
 
-    // CFX-032 FIX: Precalculate Q8.8 fixed-point variables to avoid heavy FPU logic 
-    // inside the tight pixel loop, dodging interrupt-context float corruption in ESP32
-    int32_t center_fp = (int32_t)(center_f * 256.0f);
-    int32_t node_r_fp = (int32_t)(node_r * 256.0f);
+    // Q8.8 copies for the coverage math in the pixel loop
+    int32_t center_fp = center >> 8;
+    int32_t node_r_fp = node_r >> 8;
 
     for (int i = r_start; i <= r_stop; i++) {
       // Distance from center for anti-aliasing (fixed point)
@@ -7602,7 +7780,7 @@ uint16_t mode_collider(void) {
 
       // Palette Scrolling Logic (inside the mask)
       uint8_t color_idx = (uint8_t)idx + pal_offset;
-      CRGBW pulse_rgbw = ColorFromPalette(palData, color_idx, bri);
+      CRGBW pulse_rgbw = ColorFromPalette(instance, palData, color_idx, bri);
 
       // Additive pixel mixing
       uint32_t current = instance->_segment.getPixelColor(idx);
@@ -7617,23 +7795,27 @@ uint16_t mode_collider(void) {
   return FRAMETIME;
 }
 
-uint16_t mode_hydro_pulse(void) {
+uint16_t mode_hydro_pulse(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   instance->_segment.fill(instance->_segment.colors[0]);
   return FRAMETIME;
 }
 
-uint16_t mode_dropping_fill(void) {
+uint16_t mode_dropping_fill(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   instance->_segment.fill(instance->_segment.colors[0]);
   return FRAMETIME;
 }
 
 
-uint16_t mode_interference(void) {
+uint16_t mode_interference(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance) return FRAMETIME;
   uint16_t len = instance->_segment.length();
-  if (len <= 1) return mode_static();
+  if (len <= 1) return mode_static(ctx);
 
-  uint32_t t_scaled = (instance->now * instance->_segment.speed) >> 7;
+  uint32_t t_scaled =
+      cfx::scale_time(instance->now, instance->_segment.speed, 7);
   uint8_t t1 = (uint8_t)(t_scaled >> 4);
   uint8_t t2 = (uint8_t)((t_scaled * 3u) >> 5);
 
@@ -7657,10 +7839,11 @@ uint16_t mode_interference(void) {
 // Batch 3 Monochromatic Running Modes
 // -----------------------------------------------------------------------------
 
-uint16_t mode_eclipse(void) {
+uint16_t mode_eclipse(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance) return FRAMETIME;
   uint16_t len = instance->_segment.length();
-  if (len <= 1) return mode_static();
+  if (len <= 1) return mode_static(ctx);
 
   const uint8_t BASE_B = 180;
   
@@ -7708,7 +7891,8 @@ uint16_t mode_eclipse(void) {
   return FRAMETIME;
 }
 
-uint16_t mode_lithograph(void) {
+uint16_t mode_lithograph(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
 
@@ -7718,7 +7902,8 @@ uint16_t mode_lithograph(void) {
   return FRAMETIME;
 }
 
-uint16_t mode_tidal_surge(void) {
+uint16_t mode_tidal_surge(RenderContext &ctx) {
+  CFXRunner *const instance = ctx.runner;
   if (!instance)
     return FRAMETIME;
   
@@ -7732,28 +7917,26 @@ uint16_t mode_tidal_surge(void) {
 // Valid Palette Implementation (Moved from line 121)
 uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool wrap,
                                      uint8_t mcol, uint8_t pbri) {
-  // Ensure the Solid Palette cache is populated properly with the W-channel
-  // included
-  if (this->palette == 255 || this->palette == 0) {
-    fillSolidPalette(this->colors[0]);
-  }
-
-  // Get Palette Data
-  const uint32_t *palData = getPaletteByIndex(this->palette);
-  if (!palData)
-    return 0; // Black if invalid definition
-
   // Logic:
   // i [0..255] maps to palette [0..15] with interpolation.
   // FastLED/WLED logic: index = i >> 4, blend = i & 15.
-
-  uint8_t index = i >> 4;
-  uint8_t blendAmt = (i & 0x0F) << 4; // Scale 0-15 -> 0-240
-
-  uint32_t c1 = palData[index];
-  uint32_t c2 = palData[(index + 1) & 0x0F]; // Wrap 16->0
-
-  uint32_t color = color_blend(c1, c2, blendAmt);
+  uint32_t color;
+  if (this->palette == 255 || this->palette == 21) {
+    // Solid palette: all 16 stops are colors[0] (service() refills it every
+    // frame), so the blend collapses to colors[0] on a stop and to
+    // color_blend(c, c, b) between stops. Palette 0 is not solid here: a
+    // mode that does not resolve its default gets the rainbow fallback of
+    // getPaletteByIndex().
+    uint32_t c = this->colors[0];
+    color = (i & 0x0F) == 0 ? c : color_blend(c, c, (i & 0x0F) << 4);
+  } else {
+    const uint32_t *palData = getPaletteByIndex(runner, this->palette);
+    if (!palData)
+      return 0; // Black if invalid definition
+    color = runner != nullptr
+                ? runner->expandPaletteBlend(palData)[(uint8_t)i]
+                : palette_blend(palData, (uint8_t)i);
+  }
 
   // Apply brightness scaling (critical for BPM pulsing effect)
   if (pbri < 255) {
@@ -7766,5 +7949,288 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool wrap,
   return color;
 }
 
+
+// --- Mode Descriptor Table ---
+// Single source of truth for dispatch, names, default controls and
+// capability flags. Entries are sparse here and expanded to a dense
+// 256-slot table at compile time so lookups are one index into flash.
+
+namespace {
+struct ModeEntry {
+  uint8_t id;
+  ModeDescriptor desc;
+};
+
+constexpr ModeDescriptor MODE_FALLBACK = {mode_static, "Unknown", 128, 128,
+                                          1,           0,         0};
+
+constexpr ModeEntry MODE_ENTRIES[] = {
+    {FX_MODE_STATIC,
+     {mode_static, "Solid", 128, 128, 255, 0,
+      CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_BLINK, {mode_blink, "Blink", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_BREATH, {mode_breath, "Breathe", 128, 128, 255, 0, 0}},
+    {FX_MODE_COLOR_WIPE, {mode_color_wipe, "Wipe", 128, 128, 255, 0, 0}},
+    {FX_MODE_COLOR_WIPE_RANDOM,
+     {mode_color_wipe_random, "Wipe Random", 128, 128, 255, 0,
+      0}},
+    {FX_MODE_COLOR_SWEEP, {mode_color_sweep, "Sweep", 128, 128, 255, 0, 0}},
+    {7, {mode_static, "Unknown", 128, 128, 4, 0, CFX_MODE_STATELESS}},
+    {FX_MODE_RAINBOW, {mode_rainbow, "Rainbow", 128, 128, 4, 0, 0}},
+    {FX_MODE_RAINBOW_CYCLE,
+     {mode_rainbow_cycle, "Rainbow Cycle", 128, 128, 4, 0,
+      0}},
+    {FX_MODE_RUNNING_LIGHTS,
+     {mode_running_lights, "Running Lights", 128, 128, 255, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_SAW, {mode_saw, "Saw", 128, 128, 255, 0, CFX_MODE_STATELESS}},
+    {FX_MODE_DISSOLVE,
+     {mode_dissolve, "Dissolve", 128, 128, 255, 0,
+      CFX_MODE_DATA_SCALES | CFX_MODE_FULL_RATE}},
+    {FX_MODE_SPARKLE,
+     {mode_sparkle, "Sparkle", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_FLASH_SPARKLE,
+     {mode_flash_sparkle, "Flash Sparkle", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_HYPER_SPARKLE,
+     {mode_hyper_sparkle, "Hyper Sparkle", 128, 128, 255, 0,
+      0}},
+    {FX_MODE_STROBE, {mode_strobe, "Strobe", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_STROBE_RAINBOW,
+     {mode_strobe_rainbow, "Strobe Rainbow", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_MULTI_STROBE,
+     {mode_multi_strobe, "Multi Strobe", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_BLINK_RAINBOW,
+     {mode_blink_rainbow, "Blink Rainbow", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_CHASE_COLOR,
+     {mode_chase_color, "Chase", 110, 40, 255, 0,
+      0}},
+    {FX_MODE_AURORA,
+     {mode_aurora, "Aurora", 24, 128, 1, sizeof(AuroraWave) * W_MAX_COUNT,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_SCANNER,
+     {mode_scanner, "Scanner", 128, 128, 255, 4,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_RAIN, {mode_static, "Rain", 128, 128, 1, 0, CFX_MODE_STATELESS}},
+    {FX_MODE_RUNNING_DUAL,
+     {mode_running_dual, "Running Dual", 128, 128, 13, 0,
+      CFX_MODE_STATELESS}},
+    {53, {mode_static, "Unknown", 128, 128, 5, 0, CFX_MODE_STATELESS}},
+    {FX_MODE_CHASE_MULTI,
+     {mode_chase_multi, "Chase Multi", 60, 70, 255, 0,
+      0}},
+    {FX_MODE_SCANNER_DUAL,
+     {mode_scanner_dual, "Scanner Dual", 128, 128, 255, 4,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_PRIDE_2015, {mode_pride_2015, "Pride 2015", 128, 128, 8, 0, 0}},
+    {FX_MODE_JUGGLE,
+     {mode_juggle, "Juggle", 64, 128, 4, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_FIRE_2012, {mode_fire_2012, "Fire", 64, 160, 5, 60, 0}},
+    {FX_MODE_BPM, {mode_bpm, "BPM", 64, 128, 255, 0, CFX_MODE_FULL_RATE}},
+    {FX_MODE_COLORTWINKLE,
+     {mode_colortwinkle, "Colortwinkle", 128, 128, 4, 0,
+      0}},
+    {FX_MODE_METEOR, {mode_meteor, "Meteor", 128, 128, 255, 0, 0}},
+    {FX_MODE_RIPPLE,
+     {mode_ripple, "Ripple", 128, 128, 4, sizeof(RippleState) * 100,
+      CFX_MODE_NEEDS_BLUR | CFX_MODE_FULL_RATE}},
+    {FX_MODE_GLITTER,
+     {mode_glitter, "Glitter", 128, 128, 4, 0,
+      0}},
+    {FX_MODE_EXPLODING_FIREWORKS,
+     {mode_exploding_fireworks, "Fireworks", 128, 128, 4, cfx::ParticleSet::bytes(FIREWORKS_DEFAULT_SPARKS) + sizeof(FireworksState),
+      CFX_MODE_NEEDS_BLUR | CFX_MODE_FULL_RATE}},
+    {FX_MODE_BOUNCINGBALLS,
+     {mode_bouncing_balls, "Bouncing Balls", 128, 128, 255, BOUNCING_BALLS_DATA,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_POPCORN,
+     {mode_popcorn, "Popcorn", 128, 128, 255, cfx::ParticleSet::bytes(POPCORN_DEFAULT_KERNELS),
+      0}},
+    {FX_MODE_DRIP,
+     {mode_drip, "Drip", 128, 128, 255, cfx::ParticleSet::bytes(4),
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_PLASMA,
+     {mode_plasma, "Plasma", 128, 128, 8, 0,
+      CFX_MODE_DATA_SCALES | CFX_MODE_FULL_RATE}},
+    {FX_MODE_PERCENT,
+     {mode_percent, "Percent", 128, 128, 255, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_HEARTBEAT, {mode_heartbeat, "Heartbeat", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_OCEAN, {mode_ocean, "Ocean", 128, 128, 11, 0, CFX_MODE_STATELESS}},
+    {FX_MODE_SUNRISE, {mode_sunrise, "Sunrise", 60, 128, 12, 0, 0}},
+    {FX_MODE_PHASED,
+     {mode_phased, "Phased", 128, 128, 4, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_NOISEPAL,
+     {mode_noisepal, "Noise Pal", 128, 128, 4, sizeof(CRGBPalette16) * 2,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_FLOW, {mode_flow, "Flow", 128, 128, 4, 0, CFX_MODE_STATELESS}},
+    {FX_MODE_DROPPING_TIME,
+     {mode_dropping_time, "Dropping Time", 15, 128, 11, sizeof(DroppingTimeState),
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_PERCENT_CENTER,
+     {mode_percent_center, "Percent Center", 128, 128, 255, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_FIRE_DUAL, {mode_fire_dual, "Fire Dual", 64, 160, 1, 60, 0}},
+    {FX_MODE_HEARTBEAT_CENTER,
+     {mode_heartbeat_center, "Heartbeat Center", 128, 128, 255, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_KALEIDOS,
+     {mode_kaleidos, "Kaleidos", 60, 150, 4, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_FOLLOW_ME,
+     {mode_follow_me, "Follow Me", 140, 40, 255, sizeof(FollowMeData),
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_FOLLOW_US,
+     {mode_follow_us, "Follow Us", 128, 128, 255, sizeof(FollowUsData),
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_ENERGY,
+     {mode_energy, "Energy", 128, 128, 1, sizeof(EnergyData),
+      0}},
+    {FX_MODE_CHAOS_THEORY,
+     {mode_chaos_theory, "Chaos Theory", 128, 170, 1, sizeof(ChaosData),
+      0}},
+    {FX_MODE_FLUID_RAIN,
+     {mode_fluid_rain, "Fluid Rain", 128, 128, 11, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_HORIZON_SWEEP,
+     {mode_cfx_horizon_sweep, "Horizon Sweep", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_CENTER_SWEEP,
+     {mode_cfx_horizon_sweep, "Center Sweep", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_GLITTER_SWEEP,
+     {mode_cfx_horizon_sweep, "Glitter Sweep", 1, 1, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_COLLIDER,
+     {mode_collider, "Collider", 100, 170, 255, 0,
+      CFX_MODE_ARCHITECTURAL | CFX_MODE_DATA_SCALES}},
+    {FX_MODE_TWIN_PULSE_SWEEP,
+     {mode_cfx_horizon_sweep, "Twin Pulse Sweep", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_TRANSMISSION,
+     {mode_cfx_horizon_sweep, "Transmission", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_FOUR_TIMES_THE_CHARM,
+     {mode_cfx_horizon_sweep, "Four Times The Charm", 128, 128, 1, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_HYDRO_PULSE,
+     {mode_hydro_pulse, "Hydro Pulse", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_DROPPING_FILL,
+     {mode_dropping_fill, "Dropping Fill", 1, 1, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_ASSEMBLY,
+     {mode_static, "Assembly", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_INERTIA_SWEEP,
+     {mode_static, "Inertia Sweep", 128, 128, 1, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_SONAR_REVEAL,
+     {mode_static, "Sonar Reveal", 1, 1, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_VENETIAN,
+     {mode_static, "Venetian", 1, 1, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_CRYSTALLIZE,
+     {mode_static, "Crystallize", 1, 1, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_DEEP_BREATHE,
+     {mode_static, "Deep Breathe", 1, 1, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_MOIRE_SHIFT,
+     {mode_static, "Moire Shift", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_RESONANCE_FILL,
+     {mode_static, "Resonance Fill", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_TELEMETRY,
+     {mode_static, "Telemetry", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_STELLAR_DUST,
+     {mode_static, "Stellar Dust", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_INTERFERENCE,
+     {mode_interference, "Interference", 160, 180, 15, 0,
+      CFX_MODE_STATELESS}},
+    {FX_MODE_ECLIPSE,
+     {mode_eclipse, "Eclipse", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_ANIMATED_HOLD | CFX_MODE_NEEDS_BLUR}},
+    {FX_MODE_GAS_DISCHARGE,
+     {mode_static, "Gas Discharge", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_HARMONIC_SETTLE,
+     {mode_static, "Harmonic Settle", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_LITHOGRAPH,
+     {mode_lithograph, "Lithograph", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_SEPARATOR,
+     {mode_separator, "Separator", 128, 128, 1, 0,
+      CFX_MODE_FULL_RATE}},
+    {FX_MODE_TIDAL_SURGE,
+     {mode_tidal_surge, "Tidal Surge", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_IMPACT_FLARE,
+     {mode_static, "Impact Flare", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {FX_MODE_MONOLITH,
+     {mode_static, "Monolith", 128, 128, 255, 0,
+      CFX_MODE_MONOCHROMATIC | CFX_MODE_ARCHITECTURAL | CFX_MODE_CAN_IDLE | CFX_MODE_STATELESS}},
+    {255,
+     {mode_static, "Unknown", 128, 128, 1, 0,
+      CFX_MODE_ARCHITECTURAL | CFX_MODE_STATELESS}},
+};
+
+constexpr std::array<ModeDescriptor, 256> build_mode_table() {
+  std::array<ModeDescriptor, 256> table{};
+  for (auto &d : table)
+    d = MODE_FALLBACK;
+  for (const auto &e : MODE_ENTRIES)
+    table[e.id] = e.desc;
+  return table;
+}
+
+constexpr std::array<ModeDescriptor, 256> MODE_TABLE = build_mode_table();
+
+constexpr size_t max_fixed_data_bytes() {
+  size_t max_bytes = 0;
+  for (const auto &e : MODE_ENTRIES)
+    if (e.desc.data_bytes > max_bytes)
+      max_bytes = e.desc.data_bytes;
+  return max_bytes;
+}
+
+constexpr size_t MAX_FIXED_DATA_BYTES = max_fixed_data_bytes();
+} // namespace
+
+const ModeDescriptor &getModeDescriptor(uint8_t mode) {
+  return MODE_TABLE[mode];
+}
+
+// Keep in sync with the allocateData() calls of the CFX_MODE_DATA_SCALES
+// modes; anything larger still works, it just falls back to the heap.
+size_t getModeDataMaxBytes(uint16_t len) {
+  size_t max_bytes = MAX_FIXED_DATA_BYTES;
+  const size_t plasma = len;                                  // 1 B/pixel
+  const size_t dissolve = ((size_t)len + 7) / 8;              // 1 bit/pixel
+  const size_t collider = cfx::ParticleSet::bytes(((size_t)len + 14) / 15);
+  if (plasma > max_bytes)
+    max_bytes = plasma;
+  if (dissolve > max_bytes)
+    max_bytes = dissolve;
+  if (collider > max_bytes)
+    max_bytes = collider;
+  return max_bytes;
+}
+
 } // namespace chimera_fx
 } // namespace esphome
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "FastLED_Stub.h"
+#include "cfx_data_arena.h"
+#include "cfx_frame_governor.h"
+#include "cfx_layout.h"
+#include "cfx_timebase.h"
 #include "cfx_utils.h"
 #include "esphome/components/light/addressable_light.h"
 #include "esphome/core/log.h"
@@ -55,13 +59,6 @@ struct CRGBW {
 #define RESET_REQ (uint16_t)0x0020
 #define SELECTED (uint16_t)0x0001
 
-struct ColliderNode {
-  float radius;
-  float vel;
-  uint8_t glue_timer; // New: holds position for N frames
-  float offset;       // New: local drift/offset from grid center
-};
-
 // Effect Mode IDs
 #define FX_MODE_STATIC 0
 #define FX_MODE_BLINK 1
@@ -171,9 +168,62 @@ struct ColliderNode {
 // CFX-008: Cover full 0–255 ID range (Ambient Roulette = 255)
 #define MODE_COUNT					189
 
-enum RunnerState { STATE_RUNNING = 0, STATE_INTRO = 1 };
+// Mode capability flags (ModeDescriptor::flags)
+#define CFX_MODE_MONOCHROMATIC 0x01 // Monochromatic series, forced intro/outro
+#define CFX_MODE_ARCHITECTURAL 0x02 // No default transition, solid backdrop
+#define CFX_MODE_ANIMATED_HOLD 0x04 // Monochromatic but keeps animating
+#define CFX_MODE_CAN_IDLE 0x08      // Frame is static once the intro is done
+#define CFX_MODE_STATELESS 0x10     // Pure f(now, params, i): no data/phase/step/RNG
+#define CFX_MODE_NEEDS_BLUR 0x20    // Calls Segment::blur / fade_out_smooth
+#define CFX_MODE_DATA_SCALES 0x40   // Segment::data grows with length()
+#define CFX_MODE_FULL_RATE 0x80     // Steps per call or jumps after stills: never governed
 
 class CFXRunner;
+class Segment;
+
+// Everything an effect renders against, built once per frame by
+// CFXRunner::service() and passed by reference, so effects reach the runner
+// through a register instead of the per-core instance slot.
+struct RenderContext {
+  CFXRunner *runner;
+  Segment *seg;
+  uint32_t *pixels; // == seg->pixels, logical order
+  uint16_t len;     // == seg->length()
+  uint32_t now;     // == runner->now
+  cfx::RandomStream *rng;
+};
+
+typedef uint16_t (*ModeRenderFn)(RenderContext &ctx);
+
+// Per-pixel kernel run by renderSpans() over ctx.pixels[begin, end), with
+// the frame's uniforms precomputed in `frame`. A kernel may touch only the
+// indices of its span (reading back its own pixels or per-pixel
+// Segment::data is fine) and must leave the runner untouched: the two
+// halves of a long strip can run on both cores at once.
+typedef void (*SpanKernelFn)(const RenderContext &ctx, const void *frame,
+                             uint16_t begin, uint16_t end);
+// Renders [split, end) on Core 0 while the caller renders [0, split).
+// Returns false, having rendered nothing, when Core 0 is not free.
+typedef bool (*SpanSplitFn)(const RenderContext &ctx, SpanKernelFn kernel,
+                            const void *frame, uint16_t split, uint16_t end);
+
+// One entry per mode ID (0–255), stored as a constexpr table in flash.
+// IDs without an effect render Solid and report "Unknown".
+struct ModeDescriptor {
+  ModeRenderFn render;
+  const char *name;
+  uint8_t default_speed;
+  uint8_t default_intensity;
+  uint8_t default_palette;
+  uint16_t data_bytes; // Fixed Segment::data upper bound, 0 if none/scales
+  uint8_t flags;
+};
+
+const ModeDescriptor &getModeDescriptor(uint8_t mode);
+// Largest Segment::data any mode requests at this segment length.
+size_t getModeDataMaxBytes(uint16_t len);
+
+enum RunnerState { STATE_RUNNING = 0, STATE_INTRO = 1 };
 
 class Segment {
 public:
@@ -201,10 +251,35 @@ public:
   uint16_t aux1;
   uint8_t *data;
   size_t _dataLen; // CFX-003: widened from uint16_t to avoid silent truncation vs allocateData(size_t)
+  // Per-output scratch block claimed by CFXRunner; data points into it
+  // whenever the request fits, so effect switches stay off the heap.
+  CFXDataArena *arena;
+  // Owning runner (set by its constructor), for primitives that need runner
+  // state such as the gamma-aware fade or the palette cache.
+  CFXRunner *runner;
   // audit 4.2: per-segment timestamp for effects that track their own frame
   // cadence (e.g. fire modes). Replaces function-scope static variables that
   // were shared across all runners.
   uint32_t frame_timestamp_ms;
+  // Speed-scaled position for effects that integrate motion per frame;
+  // cleared on mode changes and by CFXRunner::reset().
+  cfx::Phase phase;
+
+  // Logical-order RGBW32 working buffer (index 0 = first logical pixel).
+  // Effects render here; CFXRunner::commitFrame() resolves offset, mirror,
+  // force-white and brightness once per pixel when copying to the light.
+  uint32_t *pixels;
+  uint16_t _pixelsLen;
+  // Logical pixels written since the last commit, [dirty_lo, dirty_hi);
+  // empty while dirty_lo >= dirty_hi. Kept by the write primitives below so
+  // the runner can tell the output which LEDs changed.
+  uint16_t dirty_lo;
+  uint16_t dirty_hi;
+  // Logical grid given by the runner's layout (CFXRunner::setLayout); all 0
+  // without one, which is a single row as long as the segment.
+  uint16_t width;
+  uint16_t height;
+  uint16_t _layoutLen;
 
   uint32_t colors[3];
 
@@ -213,7 +288,8 @@ public:
         intensity(DEFAULT_INTENSITY), palette(255), mode(DEFAULT_MODE),
         selected(true), on(true), mirror(false), freeze(false), reset(true),
         step(0), call(0), aux0(0), aux1(0), data(nullptr), _dataLen(0),
-        frame_timestamp_ms(0) {
+        arena(nullptr), runner(nullptr), frame_timestamp_ms(0), pixels(nullptr), _pixelsLen(0),
+        dirty_lo(UINT16_MAX), dirty_hi(0), width(0), height(0), _layoutLen(0) {
     colors[0] = DEFAULT_COLOR;
     colors[1] = 0x0;
     colors[2] = 0x0;
@@ -221,17 +297,31 @@ public:
 
   // CFX-001 mapping reverted: mirror now correctly reverses the axis as intended.
   uint16_t physicalLength() const { return stop - start; }
-  uint16_t virtualLength() const { return physicalLength(); }
-  uint16_t length() const { return physicalLength(); }
+  // Logical pixels the effect draws: the LEDs unless a layout folds, skips
+  // or remaps them.
+  uint16_t virtualLength() const { return length(); }
+  uint16_t length() const {
+    return _layoutLen != 0 ? _layoutLen : physicalLength();
+  }
   bool isActive() const { return on && physicalLength() > 0; }
 
+  // 2D view of the same buffer, row-major: pixel (x, y) is XY(x, y).
+  uint16_t virtualWidth() const { return width != 0 ? width : length(); }
+  uint16_t virtualHeight() const { return width != 0 ? height : 1; }
+  bool is2D() const { return height > 1; }
+  int XY(int x, int y) const { return y * virtualWidth() + x; }
+
   bool allocateData(size_t len) {
     if (data && _dataLen == len)
       return true;
     deallocateData();
-    data = (uint8_t *)malloc(len);
-    if (!data)
-      return false;
+    if (arena != nullptr && len > 0 && len <= arena->capacity()) {
+      data = arena->base();
+    } else {
+      data = (uint8_t *)malloc(len);
+      if (!data)
+        return false;
+    }
     _dataLen = len;
     memset(data, 0, len);
     return true;
@@ -239,19 +329,80 @@ public:
 
   void deallocateData() {
     if (data) {
-      free(data);
+      if (arena == nullptr || data != arena->base())
+        free(data);
       data = nullptr;
     }
     _dataLen = 0;
   }
 
-  void setPixelColor(int n, uint32_t c);
+  bool allocatePixels(uint16_t len) {
+    if (pixels && _pixelsLen == len)
+      return true;
+    deallocatePixels();
+    if (len == 0)
+      return false;
+    // One trailing slot past the logical pixels stays black: layout gaps
+    // gather from it.
+    const size_t bytes = ((size_t)len + 1) * sizeof(uint32_t);
+    pixels = (uint32_t *)malloc(bytes);
+    if (!pixels)
+      return false;
+    _pixelsLen = len;
+    memset(pixels, 0, bytes);
+    return true;
+  }
+
+  void deallocatePixels() {
+    if (pixels) {
+      free(pixels);
+      pixels = nullptr;
+    }
+    _pixelsLen = 0;
+  }
+
+  void markDirty(int lo, int hi) {
+    if (lo < dirty_lo)
+      dirty_lo = (uint16_t)lo;
+    if (hi > dirty_hi)
+      dirty_hi = (uint16_t)hi;
+  }
+  void clearDirty() {
+    dirty_lo = UINT16_MAX;
+    dirty_hi = 0;
+  }
+
+  // Inline: the per-pixel path of most effects.
+  void setPixelColor(int n, uint32_t c) {
+    if (n < 0 || n >= (int)_pixelsLen)
+      return;
+    pixels[n] = c;
+    markDirty(n, n + 1);
+  }
+  void setPixelColorXY(int x, int y, uint32_t c) {
+    if (x < 0 || y < 0 || x >= (int)virtualWidth() || y >= (int)virtualHeight())
+      return;
+    setPixelColor(XY(x, y), c);
+  }
   uint32_t getPixelColor(int n);
   void fill(uint32_t c);
   void fadeToBlackBy(uint8_t fadeBy);
   void subtractive_fade_val(uint8_t fade_amt);
   void fade_out_smooth(uint8_t fade_amt);
   void blur(uint8_t blur_amount);
+
+  // Range primitives. Each call clips [start, start + count) to the segment
+  // once and then runs a branch-free loop over the working buffer.
+  void fillRange(int start, int count, uint32_t c);
+  // Writes src[0..count) to [start, start + count); with reverse set the
+  // span is stored back to front. src must not overlap the destination.
+  void writeSpan(int start, const uint32_t *src, int count,
+                 bool reverse = false);
+  // Per-channel scale, (c * scale) >> 8.
+  void scaleRange(int start, int count, uint8_t scale);
+  // memmove semantics, so overlapping ranges can be used to shift pixels.
+  void copyRange(int dst, int src, int count);
+
   uint32_t color_from_palette(uint16_t i, bool mapping, bool wrap, uint8_t mcol,
                               uint8_t pbri = 255);
 };
@@ -269,8 +420,8 @@ public:
 
   // Gamma Correction Helper Support
   // Non-static to allow multiple strips with different gammas to coexist
+  // Baked flash table for _gamma (cfx_gamma.h), shared by every runner.
   const uint8_t *_lut{nullptr};
-  uint8_t *_dynamic_lut{nullptr};
   float _gamma;
 
   // Sequence Iteration Limits
@@ -286,7 +437,6 @@ public:
   bool sequence_owns_mirror_{false};
 
   void setGamma(float g);
-  static void prewarmGamma(float g);
   inline uint8_t applyGamma(uint8_t val) { return _lut ? _lut[val] : val; }
   uint8_t shiftFloor(uint8_t val);
   uint8_t getFadeFactor(uint8_t factor);
@@ -295,10 +445,12 @@ public:
   // Destructor: Release segment data to reclaim RAM
   ~CFXRunner() {
     _segment.deallocateData();
-    if (_dynamic_lut != nullptr) {
-      free(_dynamic_lut);
-      _dynamic_lut = nullptr;
-    }
+    CFXDataArenaPool::get().release(_segment.arena);
+    _segment.arena = nullptr;
+    _segment.deallocatePixels();
+    free(_governor_prev);
+    free(_layout_lut);
+    free(_layout_first);
   }
 
   void setDebug(bool state) { diagnostics.enabled = state; }
@@ -315,15 +467,36 @@ public:
     if (_segment.palette == 254)
       generateRandomPalette();
   }
+  // Per-runner PRNG behind cfx::hw_random*() and FastLED random8/16 while
+  // this runner is serviced. Seeded on first use from the hardware RNG mixed
+  // with the palette salt; seedRandom() makes a run replayable.
+  cfx::RandomStream &randomStream() {
+    if (!_rng.seeded())
+      _rng.seed(cfx::detail::hw_rand32() ^ palette_seed_salt_);
+    return _rng;
+  }
+  void seedRandom(uint32_t seed) { _rng.seed(seed); }
   const char *getModeName() const;
 
   void service();
   void reset();
+  // Warm start: does the frame buffer allocation of the first frame ahead
+  // of time (see cfx_warm_start.h). The buffer is still seeded from the
+  // light, and the data arena claimed, when the first frame runs.
+  bool prestage();
+  // Physical wiring of the segment (cfx_layout.h): matrices, folds, gaps or
+  // an explicit map. nullptr keeps the straight, mirror-aware copy. Set
+  // after start/stop; the gather table is rebuilt whenever the segment
+  // length or mirror changes.
+  void setLayout(const CFXLayout *layout);
+  const CFXLayout *getLayout() const { return _layout; }
   void setMode(uint8_t m) {
     if (_mode != m) {
       _mode = m;
       _segment.mode = m;
       _segment.reset = true;
+      _segment.phase.reset();
+      _service_ewma_us = 0; // new mode, new cost: reseed on next frame
     }
   }
 
@@ -342,11 +515,16 @@ public:
     return (pct > 100u) ? 100u : (uint8_t)pct;
   }
 
-  float _virtual_now = 0.0f; // CFX-009: was double — ESP32 Xtensa LX6 only has single-precision HW FPU
-  float _accum_ms = 0;
-
-  uint32_t pacifica_speed_accum = 0;
-  uint32_t pacifica_virtual_time = 1;
+  // Runner timeline: 64-bit µs, restarted by reset(); `now` is its ms view.
+  // Integer-only, so it keeps 1 ms resolution after weeks of uptime (the
+  // CFX-009 float accumulator lost it after ~4.6 hours).
+  cfx::Timebase _timebase;
+  // Light this runner draws when it is in a cfx_sync group (set by the
+  // owning effect). The timeline then follows CFXSyncGroupClock; see
+  // cfx_sync_group_clock.h. Errors above GROUP_CLOCK_STEP_US are seeked.
+  const void *group_clock_key = nullptr;
+  static constexpr uint32_t GROUP_CLOCK_STEP_US = 250000;
+  static constexpr uint32_t GROUP_CLOCK_MAX_SLEW_MS = 1;
 
   void setSpeed(uint8_t s) {
     if (_segment.speed != s) {
@@ -377,8 +555,50 @@ public:
   bool getMirror() const { return _segment.mirror; }
   void setColor(uint32_t c) { _segment.colors[0] = c; }
   void generateRandomPalette();
+  // 256-entry expansions of a 16-stop palette, one indexed load per lookup.
+  // Rebuilt only when the source palette changes (or, for the random
+  // palette, when generateRandomPalette() refills it). The two variants keep
+  // the exact rounding of ColorFromPalette() and Segment::color_from_palette.
+  const uint32_t *expandPalette(const uint32_t *src) {
+    return isCached(_palette_lut, src) ? _palette_lut.entries
+                                       : rebuildPalette(src);
+  }
+  const uint32_t *expandPaletteBlend(const uint32_t *src) {
+    return isCached(_palette_blend_lut, src) ? _palette_blend_lut.entries
+                                             : rebuildPaletteBlend(src);
+  }
   void setBakeBrightness(bool bake) { bake_brightness_ = bake; }
-
+  // Content-aware cadence (see cfx_frame_governor.h). frameHeld() is true
+  // when the last service() kept the previous frame, so there is nothing
+  // new to show.
+  void setAdaptiveFrameRate(bool on) { _adaptive_frame_rate = on; }
+  // Upper bound on the particles of the physics effects (cfx_particles.h);
+  // 0 leaves each effect at its own default.
+  void setParticleCap(uint16_t cap) { _particle_cap = cap; }
+  uint16_t particleCap(uint16_t fallback) const {
+    return _particle_cap != 0 ? _particle_cap : fallback;
+  }
+  bool frameHeld() const { return _frame_held; }
+  uint8_t frameDivisor() const { return _governor.divisor(); }
+  // Light indices committed since the previous call, as [lo, hi) with
+  // lo == hi when no pixel changed. Returns false when the whole segment
+  // must be treated as changed (new buffer, intro, or a change in the
+  // brightness bake, force-white or mapping).
+  bool takeCommittedRange(uint16_t &lo, uint16_t &hi);
+  // Smoothed render+commit cost of a rendered frame in µs (EWMA, 1/8
+  // weight), measured independently of diagnostics. 0 until first frame.
+  uint32_t serviceCostUs() const { return _service_ewma_us; }
+  // Frame budget from the effect's update_interval. A batch whose predicted
+  // cost overruns it gets its heaviest runners degraded by the scheduler
+  // (see the budget state below); budgetLevel() is how far.
+  void setFrameBudgetUs(uint32_t us) {
+    _frame_budget_us = us > 0 ? us : FRAMETIME * 1000u;
+  }
+  uint32_t frameBudgetUs() const { return _frame_budget_us; }
+  uint8_t budgetLevel() const { return budget_level_; }
+  // Batches this runner has spent degraded (budgetLevel() > 0) since it
+  // was created.
+  uint32_t budgetDegradedFrames() const { return budget_degraded_frames_; }
 
   void start() { _state = STATE_RUNNING; }
 
@@ -399,6 +619,7 @@ public:
   uint32_t _currentRandomPaletteBuffer[16];
   uint32_t random_palette_nonce_{0};
   uint32_t palette_seed_salt_{0};
+  cfx::RandomStream _rng;
 
   bool force_white_active_{false};
   float global_brightness_ = 1.0f;
@@ -407,6 +628,23 @@ public:
 
 
 private:
+  // Placement and budget state, owned by the scheduler.
+  friend class CFXScheduler;
+  // Core the scheduler last placed this runner on (0xFF = never placed),
+  // kept for placement hysteresis.
+  uint8_t sched_core_ = 0xFF;
+  // budget_level_ 1 renders every 2nd tick, 2 every 4th tick with blur
+  // passes skipped; budget_hold_ asks the next service() to keep the last
+  // frame. budget_tick_ counts the batches this runner was budgeted in and
+  // budget_calm_ those since its level last changed; both are per runner so
+  // that outputs sharing the scheduler do not advance each other's clocks.
+  // budget_degraded_frames_ keeps adding up the batches spent degraded.
+  uint8_t budget_level_ = 0;
+  bool budget_hold_ = false;
+  uint16_t budget_calm_ = 0;
+  uint32_t budget_tick_ = 0;
+  uint32_t budget_degraded_frames_ = 0;
+
   RunnerState _state = STATE_RUNNING;
   uint8_t _intro_mode = INTRO_NONE;
   uint32_t _intro_start_time = 0;
@@ -414,6 +652,81 @@ private:
   uint32_t _intro_color = 0;
 
   bool serviceIntro();
+  bool prepareFrame();
+  void commitFrame();
+
+  // Brightness bake table for commitFrame(), rebuilt when
+  // global_brightness_ changes.
+  uint8_t _bake_lut[256];
+  float _bake_lut_bri = -1.0f;
+  bool _arena_claimed = false; // one claim attempt per runner
+  bool _seed_pending = false;  // prestage() allocated, first frame seeds
+
+  // Frame governor state: fingerprints of the last committed frame and a
+  // hash of the inputs that must wake it (colors, controls, brightness).
+  cfx::FrameGovernor _governor;
+  bool _adaptive_frame_rate = false; // modes flagged FULL_RATE opt out
+  uint16_t _particle_cap = 0;
+  uint8_t *_governor_prev = nullptr;
+  uint16_t _governor_prev_len = 0;
+  uint32_t _governor_inputs = 0;
+  bool _frame_held = false;
+  uint32_t governorInputs() const;
+
+  // Committed-range hint for the output, see takeCommittedRange().
+  uint32_t _commit_sig = 0;
+  uint16_t _committed_lo = UINT16_MAX;
+  uint16_t _committed_hi = 0;
+  bool _committed_full = true;
+
+  // Layout gather table: the logical pixel each LED of the segment shows,
+  // built for _layout_lut_len LEDs and the mirror state it was built with.
+  // _layout_first is its inverse: the first LED showing each logical pixel,
+  // UINT16_MAX for a pixel no LED shows.
+  const CFXLayout *_layout = nullptr;
+  uint16_t *_layout_lut = nullptr;
+  uint16_t *_layout_first = nullptr;
+  uint16_t _layout_lut_len = 0;
+  bool _layout_lut_mirror = false;
+  void refreshLayout();
+  // Null when the segment is linear. Valid until the next prepareFrame().
+  const uint16_t *layoutLut() {
+    refreshLayout();
+    return _layout != nullptr ? _layout_lut : nullptr;
+  }
+  const uint16_t *layoutFirst() const {
+    return _layout != nullptr ? _layout_first : nullptr;
+  }
+  uint16_t layoutLeds() const { return _layout != nullptr ? _layout_lut_len : 0; }
+
+  uint32_t _frame_budget_us = FRAMETIME * 1000u;
+  // Service cost EWMA, see serviceCostUs().
+  uint32_t _service_ewma_us = 0;
+  void noteServiceCost(uint32_t us) {
+    if (_service_ewma_us == 0) {
+      _service_ewma_us = us > 0 ? us : 1;
+      return;
+    }
+    const int32_t delta = (int32_t)us - (int32_t)_service_ewma_us;
+    const int32_t next = (int32_t)_service_ewma_us + delta / 8;
+    _service_ewma_us = next > 0 ? (uint32_t)next : 1;
+  }
+
+  struct PaletteLUT {
+    const uint32_t *src = nullptr;
+    uint32_t gen = 0;
+    uint32_t entries[256];
+  };
+  PaletteLUT _palette_lut;
+  PaletteLUT _palette_blend_lut;
+  uint32_t paletteGeneration(const uint32_t *src) const {
+    return src == _currentRandomPaletteBuffer ? random_palette_nonce_ : 0;
+  }
+  bool isCached(const PaletteLUT &lut, const uint32_t *src) const {
+    return lut.src == src && lut.gen == paletteGeneration(src);
+  }
+  const uint32_t *rebuildPalette(const uint32_t *src);
+  const uint32_t *rebuildPaletteBlend(const uint32_t *src);
 
   uint8_t _mode;
 
@@ -424,7 +737,6 @@ private:
   // in service(). The guard ensures each service() call operates on correct runner
   // context even with multiple strips.
 
-  uint32_t _last_frame = 0;
 };
 
 // Per-core instance pointer array.
@@ -432,25 +744,39 @@ private:
 // index 1 → Core 1 (ESPHome main loop on dual-core ESP32/S3)
 extern CFXRunner *instance_per_core[2];
 
+// Installed by CFXScheduler::setup() once its Core 0 task is live; nullptr
+// on single-core builds, where renderSpans() always runs inline.
+extern SpanSplitFn span_split_hook;
+
 // RAII guard — sets the per-core slot on construction, restores the
 // previous value on destruction. Thread-safe: Core 0 and Core 1 each
 // write their own independent slot, so simultaneous service() calls
 // on different cores cannot corrupt each other's pointer.
+// Effects no longer read the slot: they get the runner via RenderContext.
+// It remains for the FastLED shims (get_millis(), random8/16 through the
+// active RandomStream) and the intro/outro code in
+// cfx_addressable_light_effect.cpp.
 // NOTE: the `instance` macro is NOT defined here. Putting it in a header
 // corrupts every TU that uses `instance` as a variable name (CFXEventManager,
 // CFXSequenceSelect, esphome logger, etc.). The macro is defined after the
-// #include block in CFXRunner.cpp and cfx_addressable_light_effect.cpp only.
+// #include block in cfx_addressable_light_effect.cpp only.
+// The runner's RandomStream is swapped in alongside it.
 class InstanceGuard {
   uint8_t core_id_;
   CFXRunner *prev_;
+  cfx::RandomStream *prev_stream_;
 public:
   explicit InstanceGuard(CFXRunner *runner) {
     core_id_ = (uint8_t)xPortGetCoreID();
     prev_ = instance_per_core[core_id_];
+    prev_stream_ = cfx::detail::active_stream[core_id_];
     instance_per_core[core_id_] = runner;
+    cfx::detail::active_stream[core_id_] =
+        runner != nullptr ? &runner->randomStream() : nullptr;
   }
   ~InstanceGuard() {
     instance_per_core[core_id_] = prev_;
+    cfx::detail::active_stream[core_id_] = prev_stream_;
   }
 
   // Non-copyable
@@ -223,7 +223,8 @@ FASTLED_INLINE uint8_t max(uint8_t a, uint8_t b) { return (a > b) ? a : b; }
 FASTLED_INLINE uint8_t min(uint8_t a, uint8_t b) { return (a < b) ? a : b; }
 
 // --- Random Helpers (ESP-IDF compatible) ---
-// CFX-023: All random helpers delegate to cfx::hw_random* (backed by esp_random())
+// CFX-023: All random helpers delegate to cfx::hw_random* (the runner's
+// RandomStream inside service(), esp_random() elsewhere)
 
 FASTLED_INLINE uint8_t random8() { return cfx::hw_random8(); }
 FASTLED_INLINE uint8_t random8(uint8_t lim) {
@@ -11,7 +11,14 @@ import esphome.config_validation as cv
 from esphome.components.light.types import AddressableLightEffect
 from esphome.components.light.effects import register_addressable_effect
 from esphome.components import number, select, switch, light
-from esphome.const import CONF_ID, CONF_NAME, CONF_UPDATE_INTERVAL, CONF_EFFECTS, CONF_TRIGGER_ID
+from esphome.const import (
+    CONF_EFFECTS,
+    CONF_GAMMA_CORRECT,
+    CONF_ID,
+    CONF_NAME,
+    CONF_TRIGGER_ID,
+    CONF_UPDATE_INTERVAL,
+)
 from esphome.core import CORE
 from esphome import automation
 
@@ -47,6 +54,7 @@ async def to_code(config):
     import esphome.core as core
 
     cg.add_define("USE_CFX_EVENTS")
+    gamma_tables()
 
     # Auto-generate controls from cfx_light entries
     for lconf in core.CORE.config.get("light", []):
@@ -105,6 +113,12 @@ SET_COLOR_SCHEMA = cv.All(
 )
 
 
+# Content-aware cadence (frame governor)
+CONF_ADAPTIVE_FRAME_RATE = "adaptive_frame_rate"
+
+# Particle pool size for Fireworks / Popcorn (0 = effect default)
+CONF_PARTICLE_CAP = "particle_cap"
+
 # Intro Configuration
 CONF_INTRO_EFFECT = "intro_effect"
 CONF_INOUT_DURATION = "inout_duration"
@@ -119,6 +133,9 @@ CONF_ON_STOP     = "on_stop"
 CONF_ON_COMPLETE = "on_complete"
 CONF_ON_REACH = "on_reach"
 CONF_CFX_STRIP_TAG = "_cfx_strip_tag"
+# Set on registry entries injected by cfx_light: they are listed as stubs of
+# the light's engine instead of building their own effect object.
+CONF_CFX_STUB = "_cfx_stub"
 
 CONF_POSITION = "position"
 
@@ -235,6 +252,8 @@ CFX_EFFECTS = [
         cv.Optional(CONF_PALETTE): cv.use_id(select.Select),
         cv.Optional(CONF_MIRROR): cv.use_id(switch.Switch),
         cv.Optional(CONF_UPDATE_INTERVAL, default="17ms"): cv.update_interval,
+        cv.Optional(CONF_ADAPTIVE_FRAME_RATE, default=False): cv.boolean,
+        cv.Optional(CONF_PARTICLE_CAP): cv.int_range(min=4, max=1024),
         cv.Optional(CONF_INTRO_EFFECT): cv.use_id(select.Select),
         cv.Optional(CONF_INOUT_DURATION): cv.use_id(number.Number),
         cv.Optional(CONF_OUTRO_EFFECT): cv.use_id(select.Select),
@@ -249,6 +268,7 @@ CFX_EFFECTS = [
         cv.Optional(CONF_SET_OUTRO): cv.int_range(min=0, max=27),  # CFX-024: IntroMode enum now has 28 entries (0-27)
         cv.Optional(CONF_SET_FORCE_WHITE): cv.boolean,
         cv.Optional(CONF_CFX_STRIP_TAG): cv.string_strict,
+        cv.Optional(CONF_CFX_STUB): cv.boolean,
         cv.Optional(CONF_ON_START): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(CfxOnStartTrigger),
@@ -279,15 +299,17 @@ CFX_EFFECTS = [
 )
 async def cfx_effect_to_code(config, effect_id, is_virtual_segment=False):
     """Generate code for addressable_cfx effect."""
-    name = config.get(CONF_NAME) 
+    name = effect_display_name(config)
     eid = config[CONF_EFFECT_ID]
-    if name == "CFX Effect":
-        if eid in CFX_EFFECT_NAMES:
-            name = CFX_EFFECT_NAMES[eid]
     
     effect = cg.new_Pvariable(effect_id, name)
     cg.add(effect.set_update_interval(config[CONF_UPDATE_INTERVAL]))
-    cg.add(effect.set_effect_id(config[CONF_EFFECT_ID]))
+    if config[CONF_ADAPTIVE_FRAME_RATE]:
+        cg.add(effect.set_adaptive_frame_rate(True))
+    if CONF_PARTICLE_CAP in config:
+        cg.add(effect.set_particle_cap(config[CONF_PARTICLE_CAP]))
+    # Effect id and YAML presets come from the shared descriptor.
+    cg.add(effect.set_descriptor(effect_descriptor(name, eid, config)))
     
     if is_virtual_segment:
         cg.add(effect.set_virtual_segment(True))
@@ -321,37 +343,6 @@ async def cfx_effect_to_code(config, effect_id, is_virtual_segment=False):
     if CONF_OUTRO_EFFECT in config:
         outro_effect = await cg.get_variable(config[CONF_OUTRO_EFFECT])
         cg.add(effect.set_outro_effect(outro_effect))
-        
-    
-    if CONF_SET_SPEED in config:
-        cg.add(effect.set_speed_preset(config[CONF_SET_SPEED]))
-    if CONF_SET_INTENSITY in config:
-        cg.add(effect.set_intensity_preset(config[CONF_SET_INTENSITY]))
-    if CONF_SET_PALETTE in config:
-        cg.add(effect.set_palette_preset(config[CONF_SET_PALETTE]))
-    if CONF_SET_BRIGHTNESS in config:
-        cg.add(effect.set_brightness_preset(config[CONF_SET_BRIGHTNESS]))
-    if CONF_SET_COLOR in config:
-        color = config[CONF_SET_COLOR]
-        scaled = [int(round(channel * 255 / 100)) for channel in color]
-        if len(color) == 3:
-            cg.add(effect.set_color_preset_rgb(scaled[0], scaled[1], scaled[2]))
-        else:
-            cg.add(
-                effect.set_color_preset_rgbw(
-                    scaled[0], scaled[1], scaled[2], scaled[3]
-                )
-            )
-    if CONF_SET_MIRROR in config:
-        cg.add(effect.set_mirror_preset(config[CONF_SET_MIRROR]))
-    if CONF_SET_INTRO in config:
-        cg.add(effect.set_intro_preset(config[CONF_SET_INTRO]))
-    if CONF_SET_INOUT_DURATION in config:
-        cg.add(effect.set_inout_duration_preset(config[CONF_SET_INOUT_DURATION]))
-    if CONF_SET_OUTRO in config:
-        cg.add(effect.set_outro_preset(config[CONF_SET_OUTRO]))
-    if CONF_SET_FORCE_WHITE in config:
-        cg.add(effect.set_force_white_preset(config[CONF_SET_FORCE_WHITE]))
 
     # Setup Triggers
     for conf in config.get(CONF_ON_START, []):
@@ -382,6 +373,203 @@ async def cfx_effect_to_code(config, effect_id, is_virtual_segment=False):
 
     return effect
 
+# ── Shared effect descriptors ─────────────────────────────────────────────────
+# Every light lists the same registry effects, so the name, effect id and YAML
+# presets of an entry go into one const CFXEffectDescriptor per distinct
+# entry, shared by all the effect stubs and effect objects that show it.
+# Field order matches the aggregate in cfx_effect_descriptor.h.
+_DESCRIPTORS_KEY = "cfx_effect_descriptors"
+
+_DESC_SPEED = 1 << 0
+_DESC_INTENSITY = 1 << 1
+_DESC_PALETTE = 1 << 2
+_DESC_BRIGHTNESS = 1 << 3
+_DESC_COLOR = 1 << 4
+_DESC_COLOR_WHITE = 1 << 5
+_DESC_MIRROR = 1 << 6
+_DESC_FORCE_WHITE = 1 << 7
+_DESC_INTRO = 1 << 8
+_DESC_INOUT_DURATION = 1 << 9
+_DESC_OUTRO = 1 << 10
+
+
+def effect_descriptor(name, effect_id, config=None):
+    """Return `&<descriptor>` for this entry, emitting it on first use."""
+    from esphome.helpers import cpp_string_escape
+
+    config = config or {}
+    presets = 0
+    color = [0, 0, 0, 0]
+    if CONF_SET_SPEED in config:
+        presets |= _DESC_SPEED
+    if CONF_SET_INTENSITY in config:
+        presets |= _DESC_INTENSITY
+    if CONF_SET_PALETTE in config:
+        presets |= _DESC_PALETTE
+    if CONF_SET_BRIGHTNESS in config:
+        presets |= _DESC_BRIGHTNESS
+    if CONF_SET_COLOR in config:
+        presets |= _DESC_COLOR
+        scaled = [int(round(channel * 255 / 100)) for channel in config[CONF_SET_COLOR]]
+        if len(scaled) == 4:
+            presets |= _DESC_COLOR_WHITE
+        color[: len(scaled)] = scaled
+    if CONF_SET_MIRROR in config:
+        presets |= _DESC_MIRROR
+    if CONF_SET_FORCE_WHITE in config:
+        presets |= _DESC_FORCE_WHITE
+    if CONF_SET_INTRO in config:
+        presets |= _DESC_INTRO
+    if CONF_SET_INOUT_DURATION in config:
+        presets |= _DESC_INOUT_DURATION
+    if CONF_SET_OUTRO in config:
+        presets |= _DESC_OUTRO
+
+    fields = (
+        cpp_string_escape(name),
+        str(int(effect_id)),
+        str(presets),
+        str(int(config.get(CONF_SET_SPEED, 0))),
+        str(int(config.get(CONF_SET_INTENSITY, 0))),
+        str(int(config.get(CONF_SET_PALETTE, 0))),
+        str(int(config.get(CONF_SET_INTRO, 0))),
+        str(int(config.get(CONF_SET_OUTRO, 0))),
+        "true" if config.get(CONF_SET_MIRROR, False) else "false",
+        "true" if config.get(CONF_SET_FORCE_WHITE, False) else "false",
+        "{" + ", ".join(str(c) for c in color) + "}",
+        f"{float(config.get(CONF_SET_BRIGHTNESS, 0.0))!r}f",
+        f"{float(config.get(CONF_SET_INOUT_DURATION, 0.0))!r}f",
+    )
+    descriptors = CORE.data.setdefault(_DESCRIPTORS_KEY, {})
+    var = descriptors.get(fields)
+    if var is None:
+        var = f"cfx_effect_desc_{len(descriptors)}"
+        descriptors[fields] = var
+        cg.add_global(
+            cg.RawStatement(
+                f"static const esphome::chimera_fx::CFXEffectDescriptor {var} = "
+                "{" + ", ".join(fields) + "};"
+            )
+        )
+    return cg.RawExpression(f"&{var}")
+
+
+def effect_display_name(config):
+    """Name an addressable_cfx entry shows in the effect dropdown."""
+    name = config.get(CONF_NAME, "CFX Effect")
+    eid = config.get(CONF_EFFECT_ID, 0)
+    if name == "CFX Effect" and eid in CFX_EFFECT_NAMES:
+        name = CFX_EFFECT_NAMES[eid]
+    return name
+
+
+# ── Effect stubs ──────────────────────────────────────────────────────────────
+# A light lists its registry entries through CFXEffectStub records holding
+# only a descriptor pointer, emitted as one static array per light and handed
+# to the light's engine: a single CFXAddressableLightEffect that renders
+# whichever entry is active (see cfx_effect_stub.h).
+_STUB_HEADER_KEY = "cfx_effect_stub_header"
+
+
+def effect_engine(engine_id, light_state, config=None):
+    """Create the engine for `light_state`, taking its cadence, particle cap
+    and strip tag from the validated entry `config` when given."""
+    engine = cg.new_Pvariable(engine_id, "CFX Light Engine")
+    if config is not None:
+        cg.add(engine.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+        if config.get(CONF_ADAPTIVE_FRAME_RATE, False):
+            cg.add(engine.set_adaptive_frame_rate(True))
+        if CONF_PARTICLE_CAP in config:
+            cg.add(engine.set_particle_cap(config[CONF_PARTICLE_CAP]))
+        if CONF_CFX_STRIP_TAG in config:
+            cg.add(engine.set_strip_tag(config[CONF_CFX_STRIP_TAG]))
+    cg.add(engine.init_internal(light_state))
+    return engine
+
+
+def effect_stubs(engine, block, descriptors):
+    """Emit the stub array `block` for `engine`; return `&block[i]` per entry."""
+    if not descriptors:
+        return []
+    if not CORE.data.get(_STUB_HEADER_KEY):
+        CORE.data[_STUB_HEADER_KEY] = True
+        cg.add_global(
+            cg.RawExpression(
+                '#include "esphome/components/cfx_effect/cfx_effect_stub.h"\n'
+            )
+        )
+    cg.add_global(
+        cg.RawStatement(
+            f"static esphome::chimera_fx::CFXEffectStub {block}[] = "
+            "{" + ", ".join(str(desc) for desc in descriptors) + "};"
+        )
+    )
+    cg.add(engine.set_stubs(cg.RawExpression(block), len(descriptors)))
+    return [cg.RawExpression(f"&{block}[{i}]") for i in range(len(descriptors))]
+
+
+# ── Baked gamma tables ────────────────────────────────────────────────────────
+# Runners shape their output through a 256-entry table per light gamma (see
+# cfx_gamma.h). Every gamma_correct in the YAML gets one const table, computed
+# here in float32 exactly as the firmware's powf() would, and the set is handed
+# to the runners once from setup(). Segment lights keep ESPHome's 2.8 default,
+# which the firmware always carries, so it is not emitted again.
+_GAMMA_DEFAULT = 2.8
+
+
+def _f32(value):
+    import struct
+
+    return struct.unpack("f", struct.pack("f", value))[0]
+
+
+def _gamma_lut(gamma):
+    import math
+
+    power = _f32(_f32(3.5) / _f32(gamma))
+    return [
+        int(_f32(_f32(math.pow(_f32(i / 255.0), power)) * 255.0))
+        for i in range(256)
+    ]
+
+
+def gamma_tables():
+    """Emit one const LUT per distinct configured gamma and install them."""
+    gammas = {}
+    for lconf in CORE.config.get("light", []):
+        gamma = lconf.get(CONF_GAMMA_CORRECT)
+        if gamma is None:
+            continue
+        # CFXRunner::setGamma() treats anything below 0.1 as 1.0.
+        gamma = float(gamma) if gamma >= 0.1 else 1.0
+        if abs(gamma - _GAMMA_DEFAULT) > 0.01:
+            gammas.setdefault(round(gamma, 2), gamma)
+    if not gammas:
+        return
+
+    entries = []
+    for idx, gamma in enumerate(sorted(gammas.values())):
+        var = f"cfx_gamma_lut_{idx}"
+        cg.add_global(
+            cg.RawStatement(
+                f"static const uint8_t {var}[256] = "
+                "{" + ", ".join(str(v) for v in _gamma_lut(gamma)) + "};"
+            )
+        )
+        entries.append(f"{{{gamma!r}f, {var}}}")
+    cg.add_global(
+        cg.RawStatement(
+            "static const esphome::chimera_fx::CFXGammaLut cfx_gamma_luts[] = "
+            "{" + ", ".join(entries) + "};"
+        )
+    )
+    cg.add(
+        cg.RawExpression(
+            f"esphome::chimera_fx::cfx_gamma_set_tables(cfx_gamma_luts, {len(entries)})"
+        )
+    )
+
+
 # Play Effect Action
 PlayEffectAction = chimera_fx_ns.class_("PlayEffectAction", automation.Action)
 
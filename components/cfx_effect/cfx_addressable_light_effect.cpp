@@ -10,20 +10,29 @@
 #include "cfx_compat.h"
 #include "cfx_control.h"
 #include "cfx_effect_stub.h"
+#include "cfx_layout_view.h"
 #include "cfx_utils.h"
+#include "cfx_warm_start.h"
 #include "esphome/core/application.h"
 #include "esphome/core/color.h"
 #include "esphome/core/hal.h" // For millis_64()
 #include "esphome/core/log.h"
 #include <algorithm>
 #include <cinttypes>
+#include <functional>
 #include <span>
 
 #include "cfx_event_manager.h"
 #include "cfx_scheduler.h"
+#ifdef USE_CFX_PROFILER
+#include "cfx_profiler.h"
+#endif
 #ifdef USE_CFX_SEQUENCE
 #include "../cfx_sequence/cfx_sequence.h"
 #endif
+#ifdef USE_CFX_DIMMER
+#include "../cfx_button/cfx_dimmer_timing.h"
+#endif
 
 // File-local macro: maps bare `instance` and `chimera_fx::instance` →
 // per-core slot. Fixes all intro/outro engine references without requiring
@@ -50,15 +59,13 @@ const std::vector<CfxOnStopTrigger *>
     CFXAddressableLightEffect::empty_stop_triggers_;
 const std::vector<CfxOnCompleteTrigger *>
     CFXAddressableLightEffect::empty_complete_triggers_;
-const std::vector<CfxOnReachTrigger *>
-    CFXAddressableLightEffect::empty_reach_triggers_;
 
 static const char *const TAG = "chimera_fx";
 
 namespace {
 static CFXAddressableLightEffect *
-resolve_parallel_segment_stub_singleton(light::LightState *state,
-                                        light::LightEffect *active) {
+resolve_parallel_segment_engine(light::LightState *state,
+                                light::LightEffect *active) {
   if (state == nullptr || active == nullptr) {
     return nullptr;
   }
@@ -72,9 +79,7 @@ resolve_parallel_segment_stub_singleton(light::LightState *state,
 #else
   return nullptr;
 #endif
-  auto *stub = static_cast<CFXEffectStub *>(active);
-  auto *singleton = stub->get_singleton();
-  return singleton;
+  return CFXAddressableLightEffect::engine_for(active);
 }
 
 static bool is_parallel_virtual_segment_state(light::LightState *state) {
@@ -100,9 +105,9 @@ resolve_active_segment_cfx_effect(light::LightState *state) {
   if (active == nullptr) {
     return nullptr;
   }
-  auto *stub_singleton = resolve_parallel_segment_stub_singleton(state, active);
-  if (stub_singleton != nullptr) {
-    return stub_singleton;
+  auto *engine = resolve_parallel_segment_engine(state, active);
+  if (engine != nullptr) {
+    return engine;
   }
   for (auto *effect : CFXAddressableLightEffect::all_segment_effects) {
     if (effect == active) {
@@ -134,6 +139,84 @@ static float resolve_led_fps(CFXAddressableLightEffect *effect) {
   return out != nullptr ? out->get_led_fps() : -1.0f;
 }
 
+// Brightness the frame renders at. A cfx_dimmer hold on an effect light
+// publishes its ramp position every loop and commits a LightCall only on a
+// slow cadence; the preview wins over current_values while it is fresh.
+// `preview` (optional) reports whether it did.
+static float resolve_frame_brightness(light::LightState *state,
+                                      bool *preview = nullptr) {
+  float bri = state->current_values.get_brightness();
+  bool previewed = false;
+#ifdef USE_CFX_DIMMER
+  previewed = cfx_dimmer::read_light_preview_brightness(state, millis(), bri);
+#endif
+  if (preview != nullptr)
+    *preview = previewed;
+  return bri;
+}
+
+// Intro/outro select option names. Resolved once when an intro or outro
+// starts, never per frame.
+constexpr CFXNameEntry CFX_INTRO_NAMES[] = {
+    {CFXAddressableLightEffect::INTRO_MODE_NONE, "None"},
+    {CFXAddressableLightEffect::INTRO_MODE_CENTER, "Center"},
+    {CFXAddressableLightEffect::INTRO_MODE_ASSEMBLY, "Construct"},
+    {CFXAddressableLightEffect::INTRO_MODE_CRYSTALLIZE, "Crystallize"},
+    {CFXAddressableLightEffect::INTRO_MODE_DEEP_BREATHE, "Deep Breathe"},
+    {CFXAddressableLightEffect::INTRO_MODE_DROPPING, "Dropping"},
+    {CFXAddressableLightEffect::INTRO_MODE_ECLIPSE, "Eclipse"},
+    {CFXAddressableLightEffect::INTRO_MODE_FADE, "Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_GAS_DISCHARGE, "Gas Discharge"},
+    {CFXAddressableLightEffect::INTRO_MODE_GLITTER, "Glitter"},
+    {CFXAddressableLightEffect::INTRO_MODE_HARMONIC_SETTLE, "Harmonic Settle"},
+    {CFXAddressableLightEffect::INTRO_MODE_IMPACT_FLARE, "Impact Flare"},
+    {CFXAddressableLightEffect::INTRO_MODE_INERTIA_SWEEP, "Inertia Sweep"},
+    {CFXAddressableLightEffect::INTRO_MODE_INTERFERENCE, "Interference"},
+    {CFXAddressableLightEffect::INTRO_MODE_LITHOGRAPH, "Lithograph"},
+    {CFXAddressableLightEffect::INTRO_MODE_MOIRE_SHIFT, "Moiré Shift"},
+    {CFXAddressableLightEffect::INTRO_MODE_MORSE, "Morse Code"},
+    {CFXAddressableLightEffect::INTRO_MODE_HYDRAULICS, "Pressurize"},
+    {CFXAddressableLightEffect::INTRO_MODE_QUADRANT, "Quadrant"},
+    {CFXAddressableLightEffect::INTRO_MODE_RESONANCE_FILL, "Resonance"},
+    {CFXAddressableLightEffect::INTRO_MODE_SONAR_REVEAL, "Sonar Reveal"},
+    {CFXAddressableLightEffect::INTRO_MODE_STELLAR_DUST, "Stellar Dust"},
+    {CFXAddressableLightEffect::INTRO_MODE_TELEMETRY, "Telemetry"},
+    {CFXAddressableLightEffect::INTRO_MODE_TIDAL_SURGE, "Tidal Surge"},
+    {CFXAddressableLightEffect::INTRO_MODE_TWIN_PULSE, "Twin Pulse"},
+    {CFXAddressableLightEffect::INTRO_MODE_VENETIAN, "Venetian"},
+    {CFXAddressableLightEffect::INTRO_MODE_WIPE, "Wipe"},
+};
+
+constexpr CFXNameEntry CFX_OUTRO_NAMES[] = {
+    {CFXAddressableLightEffect::INTRO_MODE_NONE, "None"},
+    {CFXAddressableLightEffect::INTRO_MODE_CENTER, "Center"},
+    {CFXAddressableLightEffect::OUTRO_MODE_CENTER_SQUEEZE, "Center Squeeze"},
+    {CFXAddressableLightEffect::INTRO_MODE_VENETIAN, "Close Blinds"},
+    {CFXAddressableLightEffect::INTRO_MODE_INERTIA_SWEEP, "Decelerate"},
+    {CFXAddressableLightEffect::INTRO_MODE_ASSEMBLY, "Dismantle"},
+    {CFXAddressableLightEffect::INTRO_MODE_HYDRAULICS, "Drain"},
+    {CFXAddressableLightEffect::INTRO_MODE_ECLIPSE, "Eclipse"},
+    {CFXAddressableLightEffect::INTRO_MODE_DROPPING, "Emptying"},
+    {CFXAddressableLightEffect::INTRO_MODE_CRYSTALLIZE, "Erode"},
+    {CFXAddressableLightEffect::INTRO_MODE_DEEP_BREATHE, "Exhale"},
+    {CFXAddressableLightEffect::INTRO_MODE_FADE, "Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_GAS_DISCHARGE, "Gas Discharge"},
+    {CFXAddressableLightEffect::INTRO_MODE_GLITTER, "Glitter"},
+    {CFXAddressableLightEffect::INTRO_MODE_HARMONIC_SETTLE, "Harmonic Settle"},
+    {CFXAddressableLightEffect::INTRO_MODE_INTERFERENCE, "Interference Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_LITHOGRAPH, "Lithograph"},
+    {CFXAddressableLightEffect::INTRO_MODE_MOIRE_SHIFT, "Moiré Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_MORSE, "Morse Code"},
+    {CFXAddressableLightEffect::INTRO_MODE_QUADRANT, "Quadrant"},
+    {CFXAddressableLightEffect::INTRO_MODE_RESONANCE_FILL, "Resonance Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_SONAR_REVEAL, "Sonar Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_STELLAR_DUST, "Stellar Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_TELEMETRY, "Telemetry Fade"},
+    {CFXAddressableLightEffect::INTRO_MODE_TIDAL_SURGE, "Tidal Recede"},
+    {CFXAddressableLightEffect::INTRO_MODE_TWIN_PULSE, "Twin Pulse"},
+    {CFXAddressableLightEffect::INTRO_MODE_WIPE, "Wipe"},
+};
+
 static light::ColorMode resolve_effect_call_color_mode(light::LightState *light,
                                                        bool prefer_white) {
   if (prefer_white &&
@@ -240,9 +323,13 @@ static SPIDiagCensus collect_spi_diag_census() {
   return census;
 }
 
-template <typename T> static void release_vector_storage(std::vector<T> &v) {
-  std::vector<T>().swap(v);
-}
+// Stopped activations are parked here and reset on reuse, so effect
+// switching does not churn the heap with CFXActivation-sized blocks.
+static constexpr size_t CFX_ACTIVATION_POOL_SIZE = 8;
+static CFXActivation *activation_pool[CFX_ACTIVATION_POOL_SIZE] = {};
+static size_t activation_pool_count = 0;
+// Activations alive on the heap, in use or parked.
+static size_t activation_live_count = 0;
 
 static uint32_t palette_salt_hash(const char *text,
                                   uint32_t seed = 2166136261u) {
@@ -306,6 +393,30 @@ static void assign_palette_seed_salts(
   salt = palette_salt_hash(act->runner->get_segment_id().c_str(), salt);
   act->runner->setPaletteSeedSalt(salt);
 }
+
+// In-place 1D blur over [start, start + len) of a light view. Used by intros
+// that draw straight into the output rather than into a runner's segment
+// buffer, so the edge softening acts on what they actually wrote.
+static void blur_light_range(light::AddressableLight &it, int start, int len,
+                             uint8_t blur_amount) {
+  int stop = std::min(start + len, (int)it.size());
+  if (start < 0 || start >= stop)
+    return;
+  uint8_t keep = 255 - blur_amount;
+  uint8_t seep = blur_amount >> 1;
+  Color left = it[start].get();
+  for (int i = start; i < stop; i++) {
+    Color c = it[i].get();
+    Color right = (i + 1 < stop) ? it[i + 1].get() : c;
+    Color out(
+        ((uint16_t)c.r * keep + (uint16_t)(left.r + right.r) * seep) >> 8,
+        ((uint16_t)c.g * keep + (uint16_t)(left.g + right.g) * seep) >> 8,
+        ((uint16_t)c.b * keep + (uint16_t)(left.b + right.b) * seep) >> 8,
+        ((uint16_t)c.w * keep + (uint16_t)(left.w + right.w) * seep) >> 8);
+    it[i] = out;
+    left = out;
+  }
+}
 } // namespace
 
 CFXAddressableLightEffect::CFXAddressableLightEffect(const char *name)
@@ -319,12 +430,152 @@ CFXAddressableLightEffect::~CFXAddressableLightEffect() {
   if (it != CFXAddressableLightEffect::all_effects.end()) {
     CFXAddressableLightEffect::all_effects.erase(it);
   }
-  delete this->act_;
+  release_activation_(this->act_);
   this->act_ = nullptr;
+  CFXWarmStart::get().discard(this);
   delete this->cfg_;
   this->cfg_ = nullptr;
 }
 
+bool CFXAddressableLightEffect::owns_stub(
+    const light::LightEffect *effect) const {
+  if (this->stub_count_ == 0 || effect == nullptr)
+    return false;
+  const light::LightEffect *first = this->stubs_;
+  const light::LightEffect *last = this->stubs_ + (this->stub_count_ - 1);
+  return !std::less<const light::LightEffect *>()(effect, first) &&
+         !std::less<const light::LightEffect *>()(last, effect);
+}
+
+CFXAddressableLightEffect *
+CFXAddressableLightEffect::engine_for(const light::LightEffect *effect) {
+  if (effect == nullptr)
+    return nullptr;
+  for (auto *group : {&all_effects, &all_segment_effects}) {
+    for (auto *inst : *group) {
+      if (inst == effect || inst->owns_stub(effect))
+        return inst;
+    }
+  }
+  return nullptr;
+}
+
+void CFXAddressableLightEffect::clear_runtime_presets_() {
+  CFXEffectConfig &cfg = *this->cfg_;
+  cfg.speed_preset.reset();
+  cfg.intensity_preset.reset();
+  cfg.palette_preset.reset();
+  cfg.brightness_preset.reset();
+  cfg.has_color_preset = false;
+  cfg.color_preset_has_white = false;
+  cfg.mirror_preset.reset();
+  cfg.force_white_preset.reset();
+  cfg.intro_preset.reset();
+  cfg.inout_duration_preset.reset();
+  cfg.outro_preset.reset();
+}
+
+CFXEffectStub *CFXAddressableLightEffect::find_stub(light::LightState *state,
+                                                    const std::string &name) {
+  if (state == nullptr)
+    return nullptr;
+  for (auto *group : {&all_effects, &all_segment_effects}) {
+    for (auto *inst : *group) {
+      for (uint16_t i = 0; i < inst->stub_count_; i++) {
+        CFXEffectStub *stub = &inst->stubs_[i];
+        if (stub->get_light_state() == state && stub->get_name() == name)
+          return stub;
+      }
+    }
+  }
+  return nullptr;
+}
+
+CFXActivation *CFXAddressableLightEffect::acquire_activation_() {
+  if (activation_pool_count > 0) {
+    CFXActivation *act = activation_pool[--activation_pool_count];
+    *act = CFXActivation{};
+    return act;
+  }
+  activation_live_count++;
+  return new CFXActivation();
+}
+
+size_t CFXAddressableLightEffect::activation_bytes() {
+  return activation_live_count * sizeof(CFXActivation);
+}
+
+void CFXAddressableLightEffect::release_activation_(CFXActivation *act) {
+  if (act == nullptr)
+    return;
+  if (activation_pool_count < CFX_ACTIVATION_POOL_SIZE) {
+    activation_pool[activation_pool_count++] = act;
+    return;
+  }
+  activation_live_count--;
+  delete act;
+}
+
+bool CFXAddressableLightEffect::claim_transition_plane_(
+    TransitionSnapshot &snap, uint8_t plane, light::AddressableLight &it) {
+  snap.clear();
+  auto *out = this->get_diag_output();
+  if (out == nullptr)
+    return false;
+  Color *base = out->get_transition_plane(
+      static_cast<cfx_light::CFXTransitionPlane>(plane));
+  if (base == nullptr)
+    return false;
+
+  // Virtual segments own the disjoint slice of the plane under their LEDs.
+  // A layout view takes the slice at its segment's first LED.
+  size_t offset = 0;
+  light::AddressableLight *light = &it;
+  if (this->layout_view_ != nullptr && light == this->layout_view_) {
+    offset = this->layout_view_->offset();
+    light = &this->layout_view_->target();
+  }
+#ifdef USE_ESP32
+  if (static_cast<light::AddressableLight *>(out) != light)
+    offset += static_cast<cfx_light::CFXVirtualSegmentLight *>(light)->get_start();
+#endif
+  const size_t len = static_cast<size_t>(it.size());
+  if (offset + len > static_cast<size_t>(out->size()))
+    return false;
+
+  snap.px = base + offset;
+  snap.len = len;
+  return true;
+}
+
+void CFXAddressableLightEffect::run_intro_on_(light::AddressableLight &it,
+                                              CFXRunner *runner,
+                                              const Color &target_color) {
+  if (runner == nullptr || runner->layoutLut() == nullptr ||
+      runner->layoutFirst() == nullptr) {
+    this->run_intro(it, target_color);
+    return;
+  }
+  CFXLayoutView view(it, *runner);
+  this->layout_view_ = &view;
+  this->run_intro(view, target_color);
+  this->layout_view_ = nullptr;
+  view.finish();
+}
+
+bool CFXAddressableLightEffect::run_outro_on_(light::AddressableLight &it,
+                                              CFXRunner *runner) {
+  if (runner == nullptr || runner->layoutLut() == nullptr ||
+      runner->layoutFirst() == nullptr)
+    return this->run_outro_frame(it, runner);
+  CFXLayoutView view(it, *runner);
+  this->layout_view_ = &view;
+  const bool done = this->run_outro_frame(view, runner);
+  this->layout_view_ = nullptr;
+  view.finish();
+  return done;
+}
+
 cfx_light::CFXLightOutput *CFXAddressableLightEffect::get_diag_output() const {
   if (this->is_virtual_segment_) {
 #ifdef USE_ESP32
@@ -363,9 +614,7 @@ void CFXAddressableLightEffect::apply_startup_light_presets_() {
     }
 
     auto *scheduled_active = LightStateProxy::get_active_effect(scheduled_state);
-    if (scheduled_active != this &&
-        resolve_parallel_segment_stub_singleton(scheduled_state,
-                                                scheduled_active) != this) {
+    if (CFXAddressableLightEffect::engine_for(scheduled_active) != this) {
       return;
     }
 
@@ -759,44 +1008,12 @@ CFXAddressableLightEffect::get_monochromatic_preset_(uint8_t effect_id) {
 }
 
 bool CFXAddressableLightEffect::is_monochromatic_(uint8_t effect_id) const {
-  switch (effect_id) {
-  case 161: // Horizon Sweep
-  case 162: // Curtain Sweep
-  case 163: // Stardust Sweep
-  case 165: // Twin Pulse Sweep
-  case 166: // Transmission
-  case 168: // Aqueous Flow
-  case 169: // Dropping Fill
-  case 170: // Assembly
-  case 172: // Sonar Reveal
-  case 173: // Venetian
-  case 174: // Crystallize
-  case 175: // Deep Breathe
-  case 176: // Moiré Shift
-  case 177: // Resonance Fill
-  case 178: // Telemetry
-  case 179: // Stellar Dust
-  case 181: // Eclipse
-  case 182: // Gas Discharge
-  case 183: // Harmonic Settle
-  case 184: // Lithograph
-  case 186: // Tidal Surge
-  case 187: // Impact Flare
-  case 188: // Monolith
-    return true;
-  default:
-    return false;
-  }
+  return (getModeDescriptor(effect_id).flags & CFX_MODE_MONOCHROMATIC) != 0;
 }
 
 bool CFXAddressableLightEffect::is_animated_monochromatic_hold_(
     uint8_t effect_id) const {
-  switch (effect_id) {
-  case 181: // Eclipse
-    return true;
-  default:
-    return false;
-  }
+  return (getModeDescriptor(effect_id).flags & CFX_MODE_ANIMATED_HOLD) != 0;
 }
 
 std::vector<uint8_t> CFXAddressableLightEffect::get_monochromatic_pool_() {
@@ -812,36 +1029,7 @@ std::vector<uint8_t> CFXAddressableLightEffect::get_monochromatic_pool_() {
 }
 
 bool CFXAddressableLightEffect::is_architectural_effect_id_(uint8_t effect_id) {
-  switch (effect_id) {
-  case 161:
-  case 162:
-  case 163:
-  case 164:
-  case 165:
-  case 166:
-  case 168:
-  case 169:
-  case 170:
-  case 172:
-  case 173:
-  case 174:
-  case 175:
-  case 176:
-  case 177:
-  case 178:
-  case 179:
-  case 181:
-  case 182:
-  case 183:
-  case 184:
-  case 186:
-  case 187:
-  case 188:
-  case 255:
-    return true;
-  default:
-    return false;
-  }
+  return (getModeDescriptor(effect_id).flags & CFX_MODE_ARCHITECTURAL) != 0;
 }
 
 bool CFXAddressableLightEffect::allow_default_transition_() const {
@@ -877,6 +1065,66 @@ bool CFXAddressableLightEffect::rate_gate_due_(uint64_t now) {
   return true;
 }
 
+bool CFXAddressableLightEffect::runners_held_frame_() const {
+  if (!this->adaptive_frame_rate_ || act_ == nullptr || act_->mono_idle ||
+      act_->intro_active || act_->outro_active ||
+      act_->state != TRANSITION_NONE) {
+    return false;
+  }
+  if (!act_->segment_runners.empty()) {
+    for (auto *r : act_->segment_runners) {
+      if (r != nullptr && !r->frameHeld()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return act_->runner != nullptr && act_->runner->frameHeld();
+}
+
+// Only a single steady runner on an unsegmented strip owns every pixel it
+// reports; intros, outros, blends, transformers and segment layouts write
+// the light from elsewhere, so those frames are re-encoded in full.
+void CFXAddressableLightEffect::report_dirty_range_(
+    cfx_light::CFXLightOutput *out) {
+  uint16_t lo = 0;
+  uint16_t hi = 0;
+  const bool partial =
+      act_ != nullptr && act_->runner != nullptr &&
+      act_->runner->takeCommittedRange(lo, hi);
+  const bool owned =
+      act_ != nullptr && act_->segment_runners.empty() && !act_->mono_idle &&
+      !act_->intro_active && !act_->outro_active &&
+      act_->state == TRANSITION_NONE && !out->has_segments() &&
+      !out->has_outro() &&
+      !chimera_fx::LightStateProxy::has_active_transformer(
+          this->get_light_state());
+  if (partial && owned) {
+    out->note_dirty_range(lo, hi);
+  } else {
+    out->mark_frame_dirty();
+  }
+}
+
+void CFXAddressableLightEffect::report_power_effect_(uint8_t mode) {
+#ifdef USE_ESP32
+  auto *out = this->get_diag_output();
+  if (out == nullptr || !out->power_zones_enabled())
+    return;
+  uint16_t lo = 0;
+  uint16_t hi = static_cast<uint16_t>(out->size());
+  if (this->is_virtual_segment_) {
+    auto *vseg = static_cast<cfx_light::CFXVirtualSegmentLight *>(
+        this->get_addressable_());
+    if (vseg == nullptr)
+      return;
+    lo = vseg->get_start();
+    hi = vseg->get_stop();
+  }
+  out->note_power_effect(lo, hi, mode);
+#endif
+}
+
 uint32_t CFXAddressableLightEffect::effective_update_interval_ms_() const {
   auto *out = this->get_diag_output();
   if (out == nullptr) {
@@ -915,8 +1163,122 @@ void CFXAddressableLightEffect::sync_diagnostic_target_interval_() {
   this->act_->idle_target_frame_us = static_cast<uint32_t>(idle_target_us);
 }
 
+void CFXAddressableLightEffect::set_strip_tag(const char *tag) {
+  this->configured_strip_tag_ = tag;
+  if (act_ && tag != nullptr) {
+    act_->strip_tag = tag;
+#ifdef USE_CFX_EVENTS
+    act_->strip_tag_id = chimera_fx::CFXEventManager::get().add_known_tag(tag);
+#endif
+  }
+}
+
+// Builds the runner set start() installs: one runner per YAML segment on a
+// segmented master strip (unless `allow_segments` is false), a single runner
+// otherwise. Only returns false when the single runner cannot be allocated.
+bool CFXAddressableLightEffect::create_runners_(
+    light::AddressableLight *it, std::vector<CFXRunner *> &runners,
+    bool &segmented, bool allow_segments) {
+  segmented = false;
+#ifdef USE_ESP32
+  // Virtual segment lights are single-runner by design.
+  // We check the flag injected by Python codegen to avoid illegal
+  // dynamic_cast (-fno-rtti)
+  auto *cfx_out = static_cast<cfx_light::CFXLightOutput *>(it);
+  const std::vector<cfx_light::CFXSegmentDef> *seg_defs = nullptr;
+  if (!this->is_virtual_segment_) {
+    seg_defs = &cfx_out->get_segment_defs();
+  }
+
+  if (seg_defs != nullptr && !seg_defs->empty() && allow_segments) {
+    segmented = true;
+    for (const auto &def : *seg_defs) {
+      auto *r = new CFXRunner(it);
+      if (r == nullptr) {
+        ESP_LOGE("chimera_fx",
+                 "CFX-043 FATAL: Segment runner allocation failed!");
+        break;
+      }
+      r->setBakeBrightness(true); // Multi-segment mode: bake in engine
+      r->_segment.start = def.start;
+      r->_segment.stop = def.stop;
+      r->_segment.mirror = def.mirror;
+      r->setLayout(def.layout);
+      r->set_segment_id(def.id);
+      r->setMode(this->effect_id_);
+      r->group_clock_key = this->get_light_state();
+      r->diagnostics.set_target_interval_ms(
+          this->effective_update_interval_ms_());
+      r->diagnostics.is_parallel = cfx_out != nullptr && cfx_out->is_parallel_transport();
+      runners.push_back(r);
+
+      // Feed WDT during potentially heavy allocation loop
+      esphome::App.feed_wdt();
+    }
+    return true;
+  }
+#endif
+  auto *r = new CFXRunner(it);
+  if (r == nullptr)
+    return false;
+  // If this is a virtual segment entity, it must bake brightness.
+  // If it's a standard non-segmented master strip, let the hardware gate
+  // handle it.
+  r->setBakeBrightness(this->is_virtual_segment_);
+#ifdef USE_ESP32
+  if (!this->is_virtual_segment_ && it != nullptr)
+    r->setLayout(cfx_out->get_layout());
+#endif
+  r->setMode(this->effect_id_);
+  r->group_clock_key = this->get_light_state();
+  r->diagnostics.set_target_interval_ms(this->effective_update_interval_ms_());
+  r->diagnostics.is_parallel =
+      is_parallel_virtual_segment_state(this->get_light_state()) ||
+      (it != nullptr && static_cast<cfx_light::CFXLightOutput *>(it)->is_parallel_transport());
+  runners.push_back(r);
+  return true;
+}
+
+// Warm start (see cfx_warm_start.h): builds the runners the next start()
+// would create and parks them in the pool. Virtual segment effects are
+// shared between segment lights and the roulette picks its mode in start(),
+// so both start cold.
+bool CFXAddressableLightEffect::prestage_runners(
+    const CFXEffectDescriptor *desc) {
+  const uint8_t effect_id =
+      desc != nullptr ? desc->effect_id : this->configured_effect_id_;
+  if (this->is_virtual_segment_ || effect_id == 255)
+    return false;
+  auto *state = this->get_light_state();
+  if (state == nullptr)
+    return false;
+  auto *it = (light::AddressableLight *)state->get_output();
+  if (it == nullptr)
+    return false;
+  std::vector<CFXRunner *> runners;
+  bool segmented = false;
+  // create_runners_() takes the mode from effect_id_, which an engine may
+  // still be rendering with; stage under the target id and put it back.
+  const uint8_t running_id = this->effect_id_;
+  this->effect_id_ = effect_id;
+  const bool created = this->create_runners_(it, runners, segmented, true);
+  this->effect_id_ = running_id;
+  if (!created || runners.empty())
+    return false;
+  const float gamma = state->get_gamma_correct();
+  for (auto *r : runners) {
+    r->setGamma(gamma);
+    r->prestage();
+  }
+  CFXWarmStart::get().stage(this, runners, segmented);
+  return true;
+}
+
 void CFXAddressableLightEffect::start() {
   light::AddressableLightEffect::start();
+#ifdef USE_CFX_DIMMER
+  cfx_dimmer::set_light_renders_preview(this->get_light_state(), true);
+#endif
 
   // Initialise Core 0 dispatch task on first effect start (idempotent).
   CFXScheduler::get().setup();
@@ -969,7 +1331,7 @@ void CFXAddressableLightEffect::start() {
   // Allocate per-activation state. If already allocated (rapid start/stop)
   // reuse the existing object after resetting it cleanly.
   if (this->act_ == nullptr) {
-    this->act_ = new CFXActivation();
+    this->act_ = acquire_activation_();
     if (this->act_ == nullptr) {
       ESP_LOGE("chimera_fx",
                "FATAL: Failed to allocate CFXActivation! System near OOM.");
@@ -1041,14 +1403,16 @@ void CFXAddressableLightEffect::start() {
   // events. Prefer the codegen-provided ChimeraFX event tag because ESPHome's
   // object id normalization can differ from the tag registered for events.
   {
-    if (!this->configured_strip_tag_.empty()) {
+    if (this->configured_strip_tag_ != nullptr &&
+        this->configured_strip_tag_[0] != '\0') {
       act_->strip_tag = this->configured_strip_tag_;
     } else if (auto *ls = this->get_light_state(); ls != nullptr) {
       char id_buf[128] = {};
       ls->get_object_id_to(std::span(id_buf));
       act_->strip_tag = std::string(id_buf, strnlen(id_buf, sizeof(id_buf)));
     }
-    chimera_fx::CFXEventManager::get().add_known_tag(act_->strip_tag);
+    act_->strip_tag_id =
+        chimera_fx::CFXEventManager::get().add_known_tag(act_->strip_tag);
     this->rebuild_milestone_strings_();
     this->reset_milestones_();
   }
@@ -1105,22 +1469,23 @@ void CFXAddressableLightEffect::start() {
   // Defensive reset: ensure outro_start_time_ is clean for the next outro.
   act_->outro_start_time = 0;
   act_->active_transition_duration_ms = 0;
-  release_vector_storage(act_->intro_snapshot);
-  release_vector_storage(act_->transition_target_snapshot);
+  act_->intro_snapshot.clear();
+  act_->transition_target_snapshot.clear();
   act_->is_sequence_outro = false;
   act_->suppress_reach_event = false;
   act_->suppress_positional_events = false;
   act_->suppress_stop_event = false;
   act_->suppress_complete_event = false;
   act_->force_lifecycle_shutdown = false;
-  release_vector_storage(act_->outro_color_cache);
+  act_->outro_color_cache.clear();
   act_->hydraulics_fluid_level = 0.0f;
   act_->hydraulics_fluid_velocity = 0.0f;
-  act_->hydraulics_particle_count = 0; // audit 3.3: fixed array, reset count
+  act_->hydraulics_particles().clear();
   act_->hydraulics_last_ms = 0;
 
   act_->last_triggered_pixel = -1;
   act_->last_triggered_percentage = -1.0f;
+  act_->reach_next = 0;
   act_->last_leading_pixel = -1;
   act_->lifecycle_start_fired = false;
 
@@ -1154,9 +1519,12 @@ void CFXAddressableLightEffect::start() {
   // frame
   act_->palette_synced = false;
 
-  // Find controller early
+  // Find controller early. A miss counts as this activation's lookup, so
+  // the first frame does not repeat it.
   if (act_->controller == nullptr) {
     act_->controller = CFXControl::find(this->get_light_state());
+    if (act_->controller == nullptr)
+      act_->last_controller_lookup_ms = millis_64();
   }
 
   // Effect-level color/brightness presets are light-state defaults.
@@ -1186,68 +1554,31 @@ void CFXAddressableLightEffect::start() {
     act_->runner = nullptr;
   }
 
-  // Allocate Runner(s) early so we can use them for metadata fallback
+  // Allocate Runner(s) early so we can use them for metadata fallback.
+  // A sequence may have staged them already (CFXWarmStart), then this is
+  // only a pointer handover.
   if (act_->runner == nullptr) {
     auto *it = (light::AddressableLight *)this->get_light_state()->get_output();
     if (it != nullptr) {
-#ifdef USE_ESP32
-      // Virtual segment lights are single-runner by design.
-      // We check the flag injected by Python codegen to avoid illegal
-      // dynamic_cast (-fno-rtti)
-      auto *cfx_out = static_cast<cfx_light::CFXLightOutput *>(it);
-      const std::vector<cfx_light::CFXSegmentDef> *seg_defs = nullptr;
-      if (!this->is_virtual_segment_) {
-        seg_defs = &cfx_out->get_segment_defs();
-      }
-
-      if (seg_defs != nullptr && !seg_defs->empty() &&
-          !act_->segments_initialized) {
-        for (const auto &def : *seg_defs) {
-          auto *r = new CFXRunner(it);
-          if (r == nullptr) {
-            ESP_LOGE("chimera_fx",
-                     "CFX-043 FATAL: Segment runner allocation failed!");
-            break;
-          }
-          r->setBakeBrightness(true); // Multi-segment mode: bake in engine
-          r->_segment.start = def.start;
-          r->_segment.stop = def.stop;
-          r->_segment.mirror = def.mirror;
-          r->set_segment_id(def.id);
-          r->setMode(this->effect_id_);
-          r->diagnostics.set_target_interval_ms(
-              this->effective_update_interval_ms_());
-          r->diagnostics.is_parallel = cfx_out != nullptr && cfx_out->is_parallel_transport();
-          act_->segment_runners.push_back(r);
-
-          // Feed WDT during potentially heavy allocation loop
-          esphome::App.feed_wdt();
-        }
-        if (!act_->segment_runners.empty()) {
-          act_->runner = act_->segment_runners[0];
+      auto &runners = act_->segment_runners;
+      bool segmented = false;
+      if (!CFXWarmStart::get().take(this, runners, segmented) &&
+          !this->create_runners_(it, runners, segmented,
+                                 !act_->segments_initialized)) {
+        ESP_LOGE("chimera_fx",
+                 "CFX-043 FATAL: Single runner allocation failed!");
+        return;
+      }
+      // An engine's staged set may have been built for another entry.
+      for (auto *r : runners)
+        r->setMode(this->effect_id_);
+      if (!runners.empty()) {
+        act_->runner = runners[0];
+        if (segmented)
           act_->segments_initialized = true;
-        }
-      } else {
-#endif
-        act_->runner = new CFXRunner(it);
-        if (act_->runner == nullptr) {
-          ESP_LOGE("chimera_fx",
-                   "CFX-043 FATAL: Single runner allocation failed!");
-          return;
-        }
-        // If this is a virtual segment entity, it must bake brightness.
-        // If it's a standard non-segmented master strip, let the hardware gate
-        // handle it.
-        act_->runner->setBakeBrightness(this->is_virtual_segment_);
-        act_->runner->setMode(this->effect_id_);
-        act_->runner->diagnostics.set_target_interval_ms(
-            this->effective_update_interval_ms_());
-        act_->runner->diagnostics.is_parallel =
-            is_parallel_virtual_segment_state(this->get_light_state()) ||
-            (it != nullptr && static_cast<cfx_light::CFXLightOutput *>(it)->is_parallel_transport());
-#ifdef USE_ESP32
+        else
+          runners.clear();
       }
-#endif
     }
   }
   this->sync_diagnostic_target_interval_();
@@ -1514,7 +1845,10 @@ void CFXAddressableLightEffect::start() {
       }
 
       out->send_visualizer_metadata(this->get_name(), pal_name);
-      act_->last_sent_palette = pal_name;
+      act_->last_sent_palette_select = palette_sel;
+      act_->last_sent_palette_index =
+          select_has_state(palette_sel) ? palette_sel->active_index().value()
+                                        : SIZE_MAX;
     }
   }
 
@@ -1573,61 +1907,10 @@ void CFXAddressableLightEffect::start() {
     } else {
       // 2. YAML/runtime presets override the live UI selectors.
       if (select_has_state(intro_sel)) {
-        // audit 2.2: c_str() directly on the reference — no std::string copy
-        const char *opt = intro_sel->current_option().c_str();
-        std::string s = opt ? opt : "";
-        if (s == "Wipe")
-          act_->active_intro_mode = INTRO_MODE_WIPE;
-        else if (s == "Fade")
-          act_->active_intro_mode = INTRO_MODE_FADE;
-        else if (s == "Center")
-          act_->active_intro_mode = INTRO_MODE_CENTER;
-        else if (s == "Glitter")
-          act_->active_intro_mode = INTRO_MODE_GLITTER;
-        else if (s == "Twin Pulse")
-          act_->active_intro_mode = INTRO_MODE_TWIN_PULSE;
-        else if (s == "Morse Code")
-          act_->active_intro_mode = INTRO_MODE_MORSE;
-        else if (s == "Quadrant")
-          act_->active_intro_mode = INTRO_MODE_QUADRANT;
-        else if (s == "Eclipse")
-          act_->active_intro_mode = INTRO_MODE_ECLIPSE;
-        else if (s == "Gas Discharge")
-          act_->active_intro_mode = INTRO_MODE_GAS_DISCHARGE;
-        else if (s == "Harmonic Settle")
-          act_->active_intro_mode = INTRO_MODE_HARMONIC_SETTLE;
-        else if (s == "Lithograph")
-          act_->active_intro_mode = INTRO_MODE_LITHOGRAPH;
-        else if (s == "Pressurize")
-          act_->active_intro_mode = INTRO_MODE_HYDRAULICS;
-        else if (s == "Dropping")
-          act_->active_intro_mode = INTRO_MODE_DROPPING;
-        else if (s == "Construct")
-          act_->active_intro_mode = INTRO_MODE_ASSEMBLY;
-        else if (s == "Inertia Sweep")
-          act_->active_intro_mode = INTRO_MODE_INERTIA_SWEEP;
-        else if (s == "Sonar Reveal")
-          act_->active_intro_mode = INTRO_MODE_SONAR_REVEAL;
-        else if (s == "Venetian")
-          act_->active_intro_mode = INTRO_MODE_VENETIAN;
-        else if (s == "Crystallize")
-          act_->active_intro_mode = INTRO_MODE_CRYSTALLIZE;
-        else if (s == "Deep Breathe")
-          act_->active_intro_mode = INTRO_MODE_DEEP_BREATHE;
-        else if (s == "Moiré Shift")
-          act_->active_intro_mode = INTRO_MODE_MOIRE_SHIFT;
-        else if (s == "Resonance")
-          act_->active_intro_mode = INTRO_MODE_RESONANCE_FILL;
-        else if (s == "Telemetry")
-          act_->active_intro_mode = INTRO_MODE_TELEMETRY;
-        else if (s == "Stellar Dust")
-          act_->active_intro_mode = INTRO_MODE_STELLAR_DUST;
-        else if (s == "Interference")
-          act_->active_intro_mode = INTRO_MODE_INTERFERENCE;
-        else if (s == "Tidal Surge")
-          act_->active_intro_mode = INTRO_MODE_TIDAL_SURGE;
-        else if (s == "Impact Flare")
-          act_->active_intro_mode = INTRO_MODE_IMPACT_FLARE;
+        const int mode = cfx_name_lookup(
+            CFX_INTRO_NAMES, intro_sel->current_option().c_str());
+        if (mode > 0)
+          act_->active_intro_mode = static_cast<uint8_t>(mode);
       } else if (this->has_intro_preset_()) {
         act_->active_intro_mode = this->intro_preset_val_();
       }
@@ -1771,6 +2054,9 @@ void CFXAddressableLightEffect::start() {
 
 void CFXAddressableLightEffect::stop() {
   light::AddressableLightEffect::stop();
+#ifdef USE_CFX_DIMMER
+  cfx_dimmer::set_light_renders_preview(this->get_light_state(), false);
+#endif
   this->last_run_ = 0; // Reset per-instance rate gate for clean restart
   this->next_run_ = 0;
 
@@ -1811,21 +2097,23 @@ void CFXAddressableLightEffect::stop() {
 #endif
   }
 
+  this->report_power_effect_(cfx_light::CFXLightOutput::POWER_NO_EFFECT);
+
   if (this->effect_id_ != 185 && lifecycle_shutdown &&
       !act_->suppress_stop_event) {
     this->trigger_on_stop();
 #ifdef USE_CFX_EVENTS
     if (!act_->strip_tag.empty()) {
-      std::string evt = std::string("cfx_stop:") + act_->strip_tag;
-      chimera_fx::CFXEventManager::get().fire_event(evt.c_str());
+      chimera_fx::CFXEventManager::get().fire(chimera_fx::CFX_EVENT_STOP,
+                                              act_->strip_tag_id);
     }
 #endif
   }
 
-  // Transition snapshots are no longer useful once stop() begins; release
-  // capacity instead of holding full-strip buffers until act_ is deleted.
-  release_vector_storage(act_->intro_snapshot);
-  release_vector_storage(act_->transition_target_snapshot);
+  // Transition snapshots are no longer useful once stop() begins; drop the
+  // plane slices so a parked activation holds no stale views.
+  act_->intro_snapshot.clear();
+  act_->transition_target_snapshot.clear();
 
   if (act_->saved_transition_length > 0) {
     auto *ls = this->get_light_state();
@@ -1868,63 +2156,10 @@ void CFXAddressableLightEffect::stop() {
       } else {
         // 2. YAML/runtime presets override the live UI selectors.
         if (select_has_state(out_eff)) {
-          std::string raw_opt_s(out_eff->current_option());
-          const char *raw_opt = raw_opt_s.c_str();
-          std::string s = raw_opt ? raw_opt : "";
-          if (s == "Wipe")
-            act_->active_outro_mode = INTRO_MODE_WIPE;
-          else if (s == "Fade")
-            act_->active_outro_mode = INTRO_MODE_FADE;
-          else if (s == "Center")
-            act_->active_outro_mode = INTRO_MODE_CENTER;
-          else if (s == "Glitter")
-            act_->active_outro_mode = INTRO_MODE_GLITTER;
-          else if (s == "Twin Pulse")
-            act_->active_outro_mode = INTRO_MODE_TWIN_PULSE;
-          else if (s == "Morse Code")
-            act_->active_outro_mode = INTRO_MODE_MORSE;
-          else if (s == "Quadrant")
-            act_->active_outro_mode = INTRO_MODE_QUADRANT;
-          else if (s == "Eclipse")
-            act_->active_outro_mode = INTRO_MODE_ECLIPSE;
-          else if (s == "Gas Discharge")
-            act_->active_outro_mode = INTRO_MODE_GAS_DISCHARGE;
-          else if (s == "Harmonic Settle")
-            act_->active_outro_mode = INTRO_MODE_HARMONIC_SETTLE;
-          else if (s == "Lithograph")
-            act_->active_outro_mode = INTRO_MODE_LITHOGRAPH;
-          else if (s == "Drain")
-            act_->active_outro_mode = INTRO_MODE_HYDRAULICS;
-          else if (s == "Emptying")
-            act_->active_outro_mode = INTRO_MODE_DROPPING;
-          else if (s == "Dismantle")
-            act_->active_outro_mode = INTRO_MODE_ASSEMBLY;
-          else if (s == "Decelerate")
-            act_->active_outro_mode = INTRO_MODE_INERTIA_SWEEP;
-          else if (s == "Sonar Fade")
-            act_->active_outro_mode = INTRO_MODE_SONAR_REVEAL;
-          else if (s == "Close Blinds")
-            act_->active_outro_mode = INTRO_MODE_VENETIAN;
-          else if (s == "Erode")
-            act_->active_outro_mode = INTRO_MODE_CRYSTALLIZE;
-          else if (s == "Exhale")
-            act_->active_outro_mode = INTRO_MODE_DEEP_BREATHE;
-          else if (s == "Moiré Fade")
-            act_->active_outro_mode = INTRO_MODE_MOIRE_SHIFT;
-          else if (s == "Resonance Fade")
-            act_->active_outro_mode = INTRO_MODE_RESONANCE_FILL;
-          else if (s == "Telemetry Fade")
-            act_->active_outro_mode = INTRO_MODE_TELEMETRY;
-          else if (s == "Stellar Fade")
-            act_->active_outro_mode = INTRO_MODE_STELLAR_DUST;
-          else if (s == "Interference Fade")
-            act_->active_outro_mode = INTRO_MODE_INTERFERENCE;
-          else if (s == "Tidal Recede")
-            act_->active_outro_mode = INTRO_MODE_TIDAL_SURGE;
-          else if (s == "Center Squeeze")
-            act_->active_outro_mode = OUTRO_MODE_CENTER_SQUEEZE;
-          else
-            act_->active_outro_mode = INTRO_MODE_NONE;
+          const int mode = cfx_name_lookup(
+              CFX_OUTRO_NAMES, out_eff->current_option().c_str());
+          act_->active_outro_mode =
+              mode > 0 ? static_cast<uint8_t>(mode) : INTRO_MODE_NONE;
         } else if (this->has_outro_preset_()) {
           act_->active_outro_mode = this->outro_preset_val_();
         } else {
@@ -2158,9 +2393,10 @@ void CFXAddressableLightEffect::stop() {
       auto *it_light = static_cast<light::AddressableLight *>(output);
       if ((act_->active_outro_mode == INTRO_MODE_NONE ||
            act_->active_outro_mode == INTRO_MODE_FADE) &&
-          act_->transition_target_snapshot.empty()) {
-        act_->transition_target_snapshot.reserve(it_light->size());
-        act_->transition_target_snapshot.resize(it_light->size());
+          act_->transition_target_snapshot.empty() &&
+          this->claim_transition_plane_(act_->transition_target_snapshot,
+                                        cfx_light::TRANSITION_PLANE_OUTRO,
+                                        *it_light)) {
         for (int i = 0; i < it_light->size(); i++) {
           act_->transition_target_snapshot[i] = (*it_light)[i].get();
           if ((i & 0x1F) == 0)
@@ -2187,7 +2423,7 @@ void CFXAddressableLightEffect::stop() {
                 delete r;
               captured_runners->clear();
               captured_act->outro_start_time = 0; // Reset for the NEXT outro
-              delete captured_act;
+              release_activation_(captured_act);
               return true;
             }
 
@@ -2197,7 +2433,7 @@ void CFXAddressableLightEffect::stop() {
               captured_act->hydraulics_last_ms = captured_act->outro_start_time;
               if (captured_act->active_outro_mode == INTRO_MODE_HYDRAULICS) {
                 captured_act->hydraulics_fluid_level = (float)it_light->size();
-                captured_act->hydraulics_particle_count = 0; // audit 3.3
+                captured_act->hydraulics_particles().clear();
               }
             }
 
@@ -2205,9 +2441,15 @@ void CFXAddressableLightEffect::stop() {
             bool done = false;
             CFXActivation *live_act = this->act_;
             this->act_ = captured_act;
-            for (auto *r : *captured_runners) {
-              chimera_fx::instance = r;
-              done = this->run_outro_frame(*it_light, r);
+            {
+#ifdef USE_CFX_PROFILER
+              chimera_fx::CFXProfileScope outro_prof(
+                  chimera_fx::CFX_STAGE_INOUT);
+#endif
+              for (auto *r : *captured_runners) {
+                chimera_fx::instance = r;
+                done = this->run_outro_on_(*it_light, r);
+              }
             }
             this->act_ = live_act;
             chimera_fx::instance = nullptr;
@@ -2249,9 +2491,9 @@ void CFXAddressableLightEffect::stop() {
                   // Standalone (no sequence bound): fire HA event directly.
                   // Use instance act_->strip_tag — no singleton dependency.
                   if (!captured_act->strip_tag.empty()) {
-                    std::string evt =
-                        std::string("cfx_complete:") + captured_act->strip_tag;
-                    chimera_fx::CFXEventManager::get().fire_event(evt.c_str());
+                    chimera_fx::CFXEventManager::get().fire(
+                        chimera_fx::CFX_EVENT_COMPLETE,
+                        captured_act->strip_tag_id);
                   }
                 }
               }
@@ -2260,7 +2502,7 @@ void CFXAddressableLightEffect::stop() {
                 delete r;
               captured_runners->clear();
               captured_act->outro_start_time = 0; // Reset for the NEXT outro
-              delete captured_act;
+              release_activation_(captured_act);
             }
             return done;
           });
@@ -2308,8 +2550,8 @@ void CFXAddressableLightEffect::stop() {
       !this->act_->suppress_complete_event) {
     this->trigger_on_complete();
     if (!this->act_->strip_tag.empty()) {
-      std::string evt = std::string("cfx_complete:") + this->act_->strip_tag;
-      chimera_fx::CFXEventManager::get().fire_event(evt.c_str());
+      chimera_fx::CFXEventManager::get().fire(chimera_fx::CFX_EVENT_COMPLETE,
+                                              this->act_->strip_tag_id);
     }
   }
 #else
@@ -2318,7 +2560,7 @@ void CFXAddressableLightEffect::stop() {
     this->trigger_on_complete();
   }
 #endif
-  delete this->act_;
+  release_activation_(this->act_);
   this->act_ = nullptr;
 
 } // CFXAddressableLightEffect::stop()
@@ -2508,8 +2750,8 @@ void CFXAddressableLightEffect::fire_start_lifecycle_if_needed_() {
   }
 #endif
   if (emit_ha_start && !this->act_->strip_tag.empty()) {
-    std::string evt = std::string("cfx_start:") + this->act_->strip_tag;
-    chimera_fx::CFXEventManager::get().fire_event(evt.c_str());
+    chimera_fx::CFXEventManager::get().fire(chimera_fx::CFX_EVENT_START,
+                                            this->act_->strip_tag_id);
   }
 #endif
 }
@@ -2593,8 +2835,11 @@ void CFXAddressableLightEffect::prepare_steady_virtual_segment_runner_(
   }
 
   act_->runner->target_light = &it;
+  act_->runner->setAdaptiveFrameRate(this->adaptive_frame_rate_);
+  act_->runner->setParticleCap(this->particle_cap_);
+  act_->runner->setFrameBudgetUs(this->update_interval_ * 1000u);
   if (this->is_virtual_segment_) {
-    // Segment singleton effects are reused by multiple virtual segment
+    // Segment engine effects are reused by multiple virtual segment
     // entities. Rebind each apply to the current virtual view so later
     // segments do not inherit the first segment's parent/range geometry.
     act_->runner->_segment.start = 0;
@@ -2623,7 +2868,8 @@ void CFXAddressableLightEffect::prepare_steady_virtual_segment_runner_(
   act_->active_force_white = this->resolve_force_white_active_(
       force_white_requested, act_->runner->getPalette());
 
-  float state_bri = state_ptr->current_values.get_brightness();
+  bool previewed = false;
+  float state_bri = resolve_frame_brightness(state_ptr, &previewed);
   if (state_bri == 0.0f && state_ptr->remote_values.is_on() &&
       (!this->allow_default_transition_() ||
        !chimera_fx::LightStateProxy::has_active_transformer(state_ptr))) {
@@ -2631,6 +2877,20 @@ void CFXAddressableLightEffect::prepare_steady_virtual_segment_runner_(
   }
   act_->runner->global_brightness_ =
       state_bri * state_ptr->current_values.get_state();
+
+  // Without the bake the output gate applies brightness, and update_state()
+  // only moves it when a LightCall commits: hand it the preview every frame
+  // and give the gate back to update_state() once the hold ends.
+  if (!act_->runner->bake_brightness_) {
+    auto *out = this->get_diag_output();
+    if (out != nullptr && previewed) {
+      out->set_preview_brightness(act_->runner->global_brightness_);
+      this->preview_gated_ = true;
+    } else if (out != nullptr && this->preview_gated_) {
+      this->preview_gated_ = false;
+      out->update_state(state_ptr);
+    }
+  }
 }
 
 bool CFXAddressableLightEffect::try_batch_steady_virtual_segments_(
@@ -2731,6 +2991,12 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
   if (this->act_ == nullptr)
     return;
 
+  // A live DDP/E1.31/Art-Net stream owns this span: keep the runner paused
+  // so it does not draw over the streamed pixels.
+  cfx_light::CFXLightOutput *stream_out = this->get_diag_output();
+  if (stream_out != nullptr && stream_out->realtime_owns(this->get_light_state()))
+    return;
+
   if (this->is_virtual_segment_) {
     auto *state_ptr = this->get_light_state();
     if (state_ptr != nullptr) {
@@ -2904,6 +3170,10 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
     CFXScheduler::get().service_runner(act_->runner);
     esphome::App.feed_wdt();
     act_->runner->diagnostics.flush_log(resolve_led_fps(this));
+    if (act_->runner->frameHeld()) {
+      chimera_fx::instance = nullptr;
+      return;
+    }
 
     auto *light_output = state_ptr->get_output();
     if (light_output != nullptr) {
@@ -3017,6 +3287,9 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
   if (!act_->segment_runners.empty()) {
     for (auto *r : act_->segment_runners) {
       r->target_light = &it; // INJECT: Ensure we write to current buffer
+      r->setAdaptiveFrameRate(this->adaptive_frame_rate_);
+      r->setParticleCap(this->particle_cap_);
+      r->setFrameBudgetUs(this->update_interval_ * 1000u);
       r->setDebug(runner_debug_active);
       if (!runner_name.empty())
         r->setName(runner_name.c_str());
@@ -3029,6 +3302,9 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
       act_->runner->_segment.start = 0;
       act_->runner->_segment.stop = it.size();
     }
+    act_->runner->setAdaptiveFrameRate(this->adaptive_frame_rate_);
+    act_->runner->setParticleCap(this->particle_cap_);
+    act_->runner->setFrameBudgetUs(this->update_interval_ * 1000u);
     act_->runner->setDebug(runner_debug_active);
     if (!runner_name.empty())
       act_->runner->setName(runner_name.c_str());
@@ -3086,7 +3362,7 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
         chimera_fx::LightStateProxy::stop_state_transformer(bri_state);
       }
 
-      float state_bri = bri_state->current_values.get_brightness();
+      float state_bri = resolve_frame_brightness(bri_state);
       // CFX-066: Virtual Segment Default Brightness Restoration
       // When sequence/cfx_set turns ON a light without specifying a brightness,
       // ESPHome uses the last saved state. If no state was ever saved (e.g.
@@ -3100,7 +3376,7 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
 
       bri = state_bri * bri_state->current_values.get_state();
     } else {
-      float state_bri = bri_state->current_values.get_brightness();
+      float state_bri = resolve_frame_brightness(bri_state);
       if (state_bri == 0.0f && bri_state->remote_values.is_on() &&
           (!this->allow_default_transition_() ||
            !chimera_fx::LightStateProxy::has_active_transformer(bri_state))) {
@@ -3250,7 +3526,7 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
             i < cfx_out->get_segment_light_states().size()) {
           auto *seg_state = cfx_out->get_segment_light_states()[i];
           if (seg_state != nullptr) {
-            float inner_state_bri = seg_state->current_values.get_brightness();
+            float inner_state_bri = resolve_frame_brightness(seg_state);
             // CFX-066 Fallback
             if (inner_state_bri == 0.0f && seg_state->remote_values.is_on()) {
               inner_state_bri = 1.0f;
@@ -3399,18 +3675,23 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
       true) {
 #endif
     const uint32_t intro_start_us = apply_perf_enabled ? cfx_micros() : 0;
-    // Run intro on ALL segments (swap-on-service pattern)
-    // This acts as a mask on top of the already-rendered main effect.
-    if (!act_->segment_runners.empty()) {
-      for (auto *r : act_->segment_runners) {
-        chimera_fx::InstanceGuard intro_seg_guard(
-            r); // CFX-004: scoped per-iteration
-        this->run_intro(it, current_color);
+    {
+#ifdef USE_CFX_PROFILER
+      chimera_fx::CFXProfileScope intro_prof(chimera_fx::CFX_STAGE_INOUT);
+#endif
+      // Run intro on ALL segments (swap-on-service pattern)
+      // This acts as a mask on top of the already-rendered main effect.
+      if (!act_->segment_runners.empty()) {
+        for (auto *r : act_->segment_runners) {
+          chimera_fx::InstanceGuard intro_seg_guard(
+              r); // CFX-004: scoped per-iteration
+          this->run_intro_on_(it, r, current_color);
+        }
+      } else {
+        chimera_fx::InstanceGuard intro_guard(
+            act_->runner); // CFX-004: scoped single-runner
+        this->run_intro_on_(it, act_->runner, current_color);
       }
-    } else {
-      chimera_fx::InstanceGuard intro_guard(
-          act_->runner); // CFX-004: scoped single-runner
-      this->run_intro(it, current_color);
     }
     if (apply_perf_enabled) {
       apply_intro_us += cfx_micros() - intro_start_us;
@@ -3559,14 +3840,13 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
 #endif
       }
 
-      if (trans_dur > 0.0f) {
-        // Snapshot Intro End State
-        // Pre-allocate to strip size before capture — no realloc during
-        // transition (audit 3.1).
-        act_->intro_snapshot.reserve(it.size());
-        act_->intro_snapshot.resize(it.size());
+      if (trans_dur > 0.0f &&
+          this->claim_transition_plane_(act_->intro_snapshot,
+                                        cfx_light::TRANSITION_PLANE_INTRO,
+                                        it)) {
+        // Snapshot Intro End State into the output's preallocated plane;
+        // no allocation during the transition (audit 3.1).
         act_->transition_target_snapshot.clear();
-        act_->transition_target_snapshot.reserve(it.size());
         for (int i = 0; i < it.size(); i++) {
           act_->intro_snapshot[i] = it[i].get();
           if ((i & 0x1F) == 0)
@@ -3596,12 +3876,14 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
   if (act_->state == TRANSITION_RUNNING) {
     if (is_mono_preset &&
         act_->transition_target_snapshot.size() != it.size() &&
-        !act_->mono_dirty) {
+        !act_->mono_dirty &&
+        this->claim_transition_plane_(act_->transition_target_snapshot,
+                                      cfx_light::TRANSITION_PLANE_TARGET,
+                                      it)) {
       // CFX-067: Monochromatic presets go idle immediately after intro, so the
       // transition cannot rely on the live DMA buffer staying equal to the
       // true hold frame. Cache the first post-intro runner output once, then
       // dissolve toward that stable target on every subsequent frame.
-      act_->transition_target_snapshot.resize(it.size());
       for (int i = 0; i < it.size(); i++) {
         act_->transition_target_snapshot[i] = it[i].get();
         if ((i & 0x1F) == 0)
@@ -3673,8 +3955,8 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
     // End transition when fully complete
     if (progress >= (1.0f + softness)) {
       act_->state = TRANSITION_NONE;
-      release_vector_storage(act_->intro_snapshot);
-      release_vector_storage(act_->transition_target_snapshot);
+      act_->intro_snapshot.clear();
+      act_->transition_target_snapshot.clear();
     }
   }
 
@@ -3929,7 +4211,9 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
       sr->diagnostics.flush_log(resolve_led_fps(this));
   }
 
-  if (this->is_clean_mono_idle_output()) {
+  this->report_power_effect_(this->effect_id_);
+
+  if (this->is_clean_mono_idle_output() || this->runners_held_frame_()) {
     chimera_fx::instance = nullptr;
     return;
   }
@@ -3944,6 +4228,7 @@ void CFXAddressableLightEffect::apply(light::AddressableLight &it,
       seg_out->note_show_request();
     } else {
       auto *cfx_out = static_cast<cfx_light::CFXLightOutput *>(light_output);
+      this->report_dirty_range_(cfx_out);
       cfx_out->note_show_request();
     }
   }
@@ -3955,59 +4240,8 @@ uint8_t CFXAddressableLightEffect::get_pal_idx(select::Select *s) {
   if (s == nullptr)
     return 0;
 
-  // audit 2.2: current_option() returns const std::string& — call c_str()
-  // directly instead of copying into a new std::string first.
-  const char *option = s->current_option().c_str();
-  if (option == nullptr)
-    return 0;
-  if (strcmp(option, "Aurora") == 0)
-    return 1;
-  if (strcmp(option, "Forest") == 0)
-    return 2;
-  if (strcmp(option, "Halloween") == 0)
-    return 3;
-  if (strcmp(option, "Rainbow") == 0)
-    return 4;
-  if (strcmp(option, "Fire") == 0)
-    return 5;
-  if (strcmp(option, "Sunset") == 0)
-    return 6;
-  if (strcmp(option, "Ice") == 0)
-    return 7;
-  if (strcmp(option, "Party") == 0)
-    return 8;
-  if (strcmp(option, "Pastel") == 0)
-    return 10;
-  if (strcmp(option, "Ocean") == 0)
-    return 11;
-  if (strcmp(option, "HeatColors") == 0)
-    return 12;
-  if (strcmp(option, "Sakura") == 0)
-    return 13;
-  if (strcmp(option, "Rivendell") == 0)
-    return 14;
-  if (strcmp(option, "Cyberpunk") == 0)
-    return 15;
-  if (strcmp(option, "OrangeTeal") == 0)
-    return 16;
-  if (strcmp(option, "Christmas") == 0)
-    return 17;
-  if (strcmp(option, "RedBlue") == 0)
-    return 18;
-  if (strcmp(option, "Matrix") == 0)
-    return 19;
-  if (strcmp(option, "SunnyGold") == 0)
-    return 20;
-  if (strcmp(option, "None") == 0 || strcmp(option, "Solid") == 0)
-    return 255;
-  if (strcmp(option, "Smart Random") == 0)
-    return 254;
-  if (strcmp(option, "Fairy") == 0)
-    return 22;
-  if (strcmp(option, "Twilight") == 0)
-    return 9;
-
-  if (strcmp(option, "Default") == 0) {
+  const uint8_t code = this->palette_code_of_(s);
+  if (code == CFX_PALETTE_CODE_DEFAULT) {
     // Resolve the natural default for this effect
     if (act_->runner) {
       uint8_t m = act_->runner->getMode();
@@ -4015,8 +4249,21 @@ uint8_t CFXAddressableLightEffect::get_pal_idx(select::Select *s) {
     }
     return 1; // Fallback to Aurora if no runner
   }
+  return code;
+}
 
-  return 0; // Unknown palette name
+// Selects bound at codegen (this effect's own, its controller's) answer from
+// the code their state callback cached. Anything else resolves by name.
+uint8_t
+CFXAddressableLightEffect::palette_code_of_(select::Select *sel) const {
+  if (!select_has_state(sel))
+    return CFX_PALETTE_CODE_UNKNOWN;
+  if (cfg_ != nullptr && sel == cfg_->palette_code.get_select())
+    return cfg_->palette_code.get();
+  if (act_ != nullptr && act_->controller != nullptr &&
+      sel == act_->controller->get_palette())
+    return act_->controller->get_palette_code();
+  return cfx_palette_code(sel->current_option().c_str());
 }
 
 uint8_t CFXAddressableLightEffect::get_palette_index_() {
@@ -4041,95 +4288,8 @@ uint8_t CFXAddressableLightEffect::get_palette_index_() {
 }
 
 uint8_t CFXAddressableLightEffect::get_default_palette_id_(uint8_t effect_id) {
-  if (this->is_monochromatic_(effect_id)) {
-    return 255; // Monochromatic series ALWAYS defaults to Solid
-  }
-
-  switch (effect_id) {
-  case 0:       // Static
-  case 1:       // Blink
-  case 2:       // Breath
-  case 3:       // Wipe
-  case 4:       // Wipe Random
-  case 6:       // Sweep
-  case 15:      // Running Lights
-  case 16:      // Saw
-  case 18:      // Dissolve
-  case 20:      // Sparkle
-  case 21:      // Sparkle Dark
-  case 22:      // Sparkle+
-  case 23:      // Strobe
-  case 24:      // Strobe Rainbow
-  case 25:      // Multi Strobe
-  case 26:      // Blink Rainbow
-  case 28:      // Chase
-  case 40:      // Scanner
-  case 54:      // Chase Tri
-  case 60:      // Scanner Dual
-  case 68:      // BPM
-  case 76:      // Meteor
-  case 91:      // Bouncing Balls
-  case 95:      // Popcorn
-  case 96:      // Drip
-  case 98:      // Percent
-  case 100:     // Heartbeat
-  case 152:     // Center Gauge
-  case 154:     // Reactor Beat
-  case 156:     // Follow Me
-  case 157:     // Follow Us
-  case 164:     // Collider
-    return 255; // Defaults to Solid
-
-  case 7:     // Dynamic
-  case 8:     // Rainbow
-  case 9:     // Colorloop (WLED Cycle)
-  case 64:    // Juggle
-  case 74:    // Color Twinkle
-  case 79:    // Ripple
-  case 87:    // Glitter
-  case 90:    // Fireworks
-  case 105:   // Phased
-  case 107:   // Noise Pal
-  case 110:   // Flow
-  case 155:   // Kaleidos
-    return 4; // Defaults to Rainbow
-
-  case 63:    // Colorloop (ChimeraFX internal mapping)
-  case 97:    // Plasma
-    return 8; // Defaults to Party
-
-  case 66:    // Fire
-  case 53:    // Twin Flames
-    return 5; // Defaults to Fire Palette
-
-  case 101:    // Ocean (Pacifica)
-  case 151:    // Dropping Time
-  case 160:    // Fluid Rain
-  case 169:    // Dropping Fill
-    return 11; // Defaults to Ocean
-
-  case 38:    // Aurora
-    return 1; // Defaults to Aurora Palette
-
-  case 104:    // Sunrise
-    return 12; // Defaults to HeatColors
-
-  case 52:     // Running Dual
-    return 13; // Defaults to Sakura
-
-  case 180:    // Interference
-    return 15; // Defaults to Cyberpunk
-
-  case 170:     // Assembly
-  case 172:     // Sonar Reveal
-  case 173:     // Venetian
-  case 174:     // Crystallize
-  case 175:     // Deep Breathe
-    return 255; // Defaults to Solid
-
-  default:
-    return 1; // General fallback to Aurora
-  }
+  // Monochromatic series ALWAYS defaults to Solid (baked into the table)
+  return getModeDescriptor(effect_id).default_palette;
 }
 
 Color CFXAddressableLightEffect::get_intro_palette_color_(
@@ -4201,182 +4361,19 @@ bool CFXAddressableLightEffect::resolve_force_white_active_(
   return cfx::palette_supports_force_white(palette_id);
 }
 
-std::string CFXAddressableLightEffect::get_palette_name_(uint8_t pal_id) {
-  switch (pal_id) {
-  case 1:
-    return "Aurora";
-  case 2:
-    return "Forest";
-  case 3:
-    return "Halloween";
-  case 4:
-    return "Rainbow";
-  case 5:
-    return "Fire";
-  case 6:
-    return "Sunset";
-  case 7:
-    return "Ice";
-  case 8:
-    return "Party";
-
-  case 10:
-    return "Pastel";
-  case 11:
-    return "Ocean";
-  case 12:
-    return "HeatColors";
-  case 13:
-    return "Sakura";
-  case 14:
-    return "Rivendell";
-  case 15:
-    return "Cyberpunk";
-  case 16:
-    return "OrangeTeal";
-  case 17:
-    return "Christmas";
-  case 18:
-    return "RedBlue";
-  case 19:
-    return "Matrix";
-  case 20:
-    return "SunnyGold";
-  case 22:
-    return "Fairy";
-  case 9:
-    return "Twilight";
-  case 23:
-    return "Default";
-  case 254:
-    return "Smart Random";
-  case 255:
-    return "Solid";
-  default:
-    return "Default";
-  }
+const char *
+CFXAddressableLightEffect::get_palette_name_(uint8_t pal_id) const {
+  return cfx_palette_name(pal_id);
 }
 
-std::string CFXAddressableLightEffect::get_intro_name_(uint8_t intro_id) {
-  switch (intro_id) {
-  case INTRO_MODE_NONE:
-    return "None";
-  case INTRO_MODE_CENTER:
-    return "Center";
-  case INTRO_MODE_ASSEMBLY:
-    return "Construct";
-  case INTRO_MODE_CRYSTALLIZE:
-    return "Crystallize";
-  case INTRO_MODE_DEEP_BREATHE:
-    return "Deep Breathe";
-  case INTRO_MODE_DROPPING:
-    return "Dropping";
-  case INTRO_MODE_ECLIPSE:
-    return "Eclipse";
-  case INTRO_MODE_FADE:
-    return "Fade";
-  case INTRO_MODE_GAS_DISCHARGE:
-    return "Gas Discharge";
-  case INTRO_MODE_GLITTER:
-    return "Glitter";
-  case INTRO_MODE_HARMONIC_SETTLE:
-    return "Harmonic Settle";
-  case INTRO_MODE_IMPACT_FLARE:
-    return "Impact Flare";
-  case INTRO_MODE_INERTIA_SWEEP:
-    return "Inertia Sweep";
-  case INTRO_MODE_INTERFERENCE:
-    return "Interference";
-  case INTRO_MODE_LITHOGRAPH:
-    return "Lithograph";
-  case INTRO_MODE_MOIRE_SHIFT:
-    return "Moiré Shift";
-  case INTRO_MODE_MORSE:
-    return "Morse Code";
-  case INTRO_MODE_HYDRAULICS:
-    return "Pressurize";
-  case INTRO_MODE_QUADRANT:
-    return "Quadrant";
-  case INTRO_MODE_RESONANCE_FILL:
-    return "Resonance";
-  case INTRO_MODE_SONAR_REVEAL:
-    return "Sonar Reveal";
-  case INTRO_MODE_STELLAR_DUST:
-    return "Stellar Dust";
-  case INTRO_MODE_TELEMETRY:
-    return "Telemetry";
-  case INTRO_MODE_TIDAL_SURGE:
-    return "Tidal Surge";
-  case INTRO_MODE_TWIN_PULSE:
-    return "Twin Pulse";
-  case INTRO_MODE_VENETIAN:
-    return "Venetian";
-  case INTRO_MODE_WIPE:
-    return "Wipe";
-  default:
-    return "None";
-  }
+const char *
+CFXAddressableLightEffect::get_intro_name_(uint8_t intro_id) const {
+  return cfx_name_of(CFX_INTRO_NAMES, intro_id, "None");
 }
 
-std::string CFXAddressableLightEffect::get_outro_name_(uint8_t outro_id) {
-  switch (outro_id) {
-  case INTRO_MODE_NONE:
-    return "None";
-  case INTRO_MODE_CENTER:
-    return "Center";
-  case OUTRO_MODE_CENTER_SQUEEZE:
-    return "Center Squeeze";
-  case INTRO_MODE_VENETIAN:
-    return "Close Blinds";
-  case INTRO_MODE_INERTIA_SWEEP:
-    return "Decelerate";
-  case INTRO_MODE_ASSEMBLY:
-    return "Dismantle";
-  case INTRO_MODE_HYDRAULICS:
-    return "Drain";
-  case INTRO_MODE_ECLIPSE:
-    return "Eclipse";
-  case INTRO_MODE_DROPPING:
-    return "Emptying";
-  case INTRO_MODE_CRYSTALLIZE:
-    return "Erode";
-  case INTRO_MODE_DEEP_BREATHE:
-    return "Exhale";
-  case INTRO_MODE_FADE:
-    return "Fade";
-  case INTRO_MODE_GAS_DISCHARGE:
-    return "Gas Discharge";
-  case INTRO_MODE_GLITTER:
-    return "Glitter";
-  case INTRO_MODE_HARMONIC_SETTLE:
-    return "Harmonic Settle";
-  case INTRO_MODE_INTERFERENCE:
-    return "Interference Fade";
-  case INTRO_MODE_LITHOGRAPH:
-    return "Lithograph";
-  case INTRO_MODE_MOIRE_SHIFT:
-    return "Moiré Fade";
-  case INTRO_MODE_MORSE:
-    return "Morse Code";
-  case INTRO_MODE_QUADRANT:
-    return "Quadrant";
-  case INTRO_MODE_RESONANCE_FILL:
-    return "Resonance Fade";
-  case INTRO_MODE_SONAR_REVEAL:
-    return "Sonar Fade";
-  case INTRO_MODE_STELLAR_DUST:
-    return "Stellar Fade";
-  case INTRO_MODE_TELEMETRY:
-    return "Telemetry Fade";
-  case INTRO_MODE_TIDAL_SURGE:
-    return "Tidal Recede";
-  case INTRO_MODE_TWIN_PULSE:
-    return "Twin Pulse";
-  case INTRO_MODE_WIPE:
-    return "Wipe";
-  default:
-    return "None";
-  }
+const char *
+CFXAddressableLightEffect::get_outro_name_(uint8_t outro_id) const {
+  return cfx_name_of(CFX_OUTRO_NAMES, outro_id, "None");
 }
 
 uint32_t CFXAddressableLightEffect::get_intro_mode_min_duration_ms_(
@@ -4495,49 +4492,8 @@ uint8_t CFXAddressableLightEffect::get_default_speed_(uint8_t effect_id) {
   }
 #endif
 
-  // Per-effect speed defaults from effects_preset.md
-  switch (effect_id) {
-  case 38:
-    return 24; // Aurora
-  case 28:
-    return 110; // Chase
-  case 54:
-    return 60; // Chase Multi
-  case 153:
-    return 64; // Twin Flames (same as Fire)
-  case 64:
-    return 64; // Juggle
-  case 66:
-    return 64; // Fire
-  case 68:
-    return 64; // BPM
-  case 104:
-    return 60; // Sunrise
-  case 151:
-    return 15; // Dropping Time
-  case 155:
-    return 60; // Kaleidos
-  case 156:
-    return 140; // Follow Me (Default Speed)
-  case 157:
-    return 128; // Follow Us (Default Speed 128)
-  case 163:
-    return 1; // Monochromatic series (fastest speed)
-  case 168:
-    return 128; // Aqueous Flow (Default Speed)
-  case 169:
-  case 172:
-  case 173:
-  case 174:
-  case 175:
-    return 1; // Monochromatic effects (Speed slider controls duration)
-  case 164:
-    return 100; // Collider (Default Speed)
-  case 180:
-    return 160; // Interference (Default Speed)
-  default:
-    return 128; // WLED default
-  }
+  // Per-effect defaults from effects_preset.md
+  return getModeDescriptor(effect_id).default_speed;
 }
 
 uint8_t CFXAddressableLightEffect::get_default_intensity_(uint8_t effect_id) {
@@ -4547,41 +4503,8 @@ uint8_t CFXAddressableLightEffect::get_default_intensity_(uint8_t effect_id) {
   }
 #endif
 
-  // Per-effect intensity defaults from effects_preset.md
-  switch (effect_id) {
-  case 28:
-    return 40; // Chase
-  case 54:
-    return 70; // Chase Multi
-  case 153:
-    return 160; // Twin Flames(same as Fire)
-  case 66:
-    return 160; // Fire
-  case 155:
-    return 150; // Kaleidos
-  case 156:
-    return 40; // Follow Me (Default Intensity)
-  case 157:
-    return 128; // Follow Us (Default Intensity 128)
-  case 163:
-    return 1; // Monochromatic series (No blur)
-  case 168:
-    return 128; // Aqueous Flow (Default Viscosity)
-  case 169:
-  case 172:
-  case 173:
-  case 174:
-  case 175:
-    return 1; // Monochromatic effects (No blur)
-  case 164:
-    return 170; // Collider (Default Intensity)
-  case 180:
-    return 180; // Interference (Default Intensity)
-  case 159:
-    return 170; // Chaos Theory (Default Peak Chaos)
-  default:
-    return 128; // WLED default
-  }
+  // Per-effect defaults from effects_preset.md
+  return getModeDescriptor(effect_id).default_intensity;
 }
 
 void CFXAddressableLightEffect::run_controls_() {
@@ -4673,7 +4596,8 @@ void CFXAddressableLightEffect::run_controls_() {
       manual_override = true;
 
     if (is_currently_target && select_has_state(palette_sel) &&
-        palette_sel->current_option() != act_->autotune_expected_palette)
+        this->palette_code_of_(palette_sel) !=
+            act_->autotune_expected_palette)
       manual_override = true;
 
     if (manual_override) {
@@ -4683,17 +4607,19 @@ void CFXAddressableLightEffect::run_controls_() {
   }
 
   // --- Visualizer: Dynamic Palette Sync ---
+  // Compared by option index; the name is only built when it changed.
   if (!this->is_virtual_segment_ && select_has_state(palette_sel)) {
-    // audit 2.2: c_str() directly on the reference — no std::string copy
-    const char *opt = palette_sel->current_option().c_str();
-    std::string current_pal = opt ? opt : "";
-    if (!current_pal.empty() && current_pal != act_->last_sent_palette) {
+    const size_t pal_index = palette_sel->active_index().value();
+    if (palette_sel != act_->last_sent_palette_select ||
+        pal_index != act_->last_sent_palette_index) {
+      const std::string current_pal(palette_sel->current_option().c_str());
       auto *out = static_cast<cfx_light::CFXLightOutput *>(
           this->get_light_state()->get_output());
-      if (out != nullptr) {
+      if (out != nullptr && !current_pal.empty()) {
         out->send_visualizer_metadata(this->get_name(), current_pal);
       }
-      act_->last_sent_palette = current_pal;
+      act_->last_sent_palette_select = palette_sel;
+      act_->last_sent_palette_index = pal_index;
     }
   }
 
@@ -4725,69 +4651,13 @@ void CFXAddressableLightEffect::run_controls_() {
   } // End of Visualizer block
 
   if (act_->runner) {
-    // Helper lambda for Palette Index Lookup
-    // New indices: 0=Default, 1=Aurora, 2=Forest, 3=Ocean, 4=Rainbow, etc.
-    auto get_pal_idx = [this](select::Select *sel) -> uint8_t {
-      if (!select_has_state(sel))
-        return 0;
-      // audit 2.2: avoid copying current_option() into a new std::string
-      const char *opt = sel->current_option().c_str();
-      if (!opt)
-        return 0;
-      if (strcmp(opt, "Aurora") == 0)
-        return 1;
-      if (strcmp(opt, "Forest") == 0)
-        return 2;
-      if (strcmp(opt, "Halloween") == 0)
-        return 3;
-      if (strcmp(opt, "Rainbow") == 0)
-        return 4;
-      if (strcmp(opt, "Fire") == 0)
-        return 5;
-      if (strcmp(opt, "Sunset") == 0)
-        return 6;
-      if (strcmp(opt, "Ice") == 0)
-        return 7;
-      if (strcmp(opt, "Party") == 0)
-        return 8;
-      if (strcmp(opt, "Twilight") == 0)
-        return 9;
-      if (strcmp(opt, "Pastel") == 0)
-        return 10;
-      if (strcmp(opt, "Ocean") == 0)
-        return 11;
-      if (strcmp(opt, "HeatColors") == 0)
-        return 12;
-      if (strcmp(opt, "Sakura") == 0)
-        return 13;
-      if (strcmp(opt, "Rivendell") == 0)
-        return 14;
-      if (strcmp(opt, "Cyberpunk") == 0)
-        return 15;
-      if (strcmp(opt, "OrangeTeal") == 0)
-        return 16;
-      if (strcmp(opt, "Christmas") == 0)
-        return 17;
-      if (strcmp(opt, "RedBlue") == 0)
-        return 18;
-      if (strcmp(opt, "Matrix") == 0)
-        return 19;
-      if (strcmp(opt, "SunnyGold") == 0)
-        return 20;
-      if (strcmp(opt, "None") == 0 || strcmp(opt, "Solid") == 0)
-        return 255;
-      if (strcmp(opt, "Smart Random") == 0)
-        return 254;
-      if (strcmp(opt, "Fairy") == 0)
-        return 22;
-      if (strcmp(opt, "Default") == 0) {
-        // Resolve the natural default for this effect
-        // FIX: Use this->effect_id_ (Requested Effect) instead of
-        // runner_->getMode() (Current/Old Effect) This ensures that when
-        // switching effects, we get the default palette of the NEW effect.
-        return this->get_default_palette_id_(this->effect_id_);
-      }
-      return 0; // Unknown palette name
+    // Palette codes come cached from the selects' state callbacks; only
+    // "Default" needs resolving, against the requested effect (not
+    // runner->getMode(), which is still the old effect during a switch).
+    auto resolve_pal = [this](uint8_t code) -> uint8_t {
+      return code == CFX_PALETTE_CODE_DEFAULT
+                 ? this->get_default_palette_id_(this->effect_id_)
+                 : code;
     };
     // Speed/Intensity/Palette/Mirror PULL — only when NO controller exists.
     // When a controller IS present, these are managed by PUSH callbacks
@@ -4840,7 +4710,8 @@ void CFXAddressableLightEffect::run_controls_() {
         else
 #endif
             if (!transient_autotune_context && this->local_palette_()) {
-          current_palette = get_pal_idx(this->local_palette_());
+          current_palette =
+              resolve_pal(this->palette_code_of_(this->local_palette_()));
         } else if (this->has_palette_preset_()) {
           current_palette = this->palette_preset_val_();
         }
@@ -4931,7 +4802,7 @@ void CFXAddressableLightEffect::run_controls_() {
         current_palette = act_->sequence_palette.value();
 #endif
       else if (!transient_autotune_context && c->get_palette())
-        current_palette = get_pal_idx(c->get_palette());
+        current_palette = resolve_pal(c->get_palette_code());
       else if (this->has_palette_preset_())
         current_palette = this->palette_preset_val_();
 
@@ -4988,13 +4859,7 @@ void CFXAddressableLightEffect::run_controls_() {
                   r_mirror = seg_c->get_mirror()->state;
 
                 if (select_has_state(seg_c->get_palette())) {
-                  // audit 2.2: check non-empty via c_str() directly —
-                  // no intermediate std::string copy needed.
-                  const char *opt_ptr =
-                      seg_c->get_palette()->current_option().c_str();
-                  if (opt_ptr && opt_ptr[0] != '\0') {
-                    r_palette = get_pal_idx(seg_c->get_palette());
-                  }
+                  r_palette = resolve_pal(seg_c->get_palette_code());
                 }
 
                 if (seg_c->get_light() != seg_state) {
@@ -5549,13 +5414,13 @@ void CFXAddressableLightEffect::run_intro(light::AddressableLight &it,
     break;
   }
   case INTRO_MODE_HYDRAULICS: {
+    cfx::ParticleSet drops = act_->hydraulics_particles();
     uint64_t now_ms = millis_64();
     if (act_->hydraulics_last_ms == 0) {
       act_->hydraulics_last_ms = now_ms;
       act_->hydraulics_fluid_level = 0.0f;
       act_->hydraulics_fluid_velocity = 0.0f;
-      act_->hydraulics_particle_count =
-          0; // audit 3.3: fixed array, reset count
+      drops.clear();
     }
     uint32_t dt_ms = (uint32_t)(now_ms - act_->hydraulics_last_ms);
     if (dt_ms == 0)
@@ -5589,13 +5454,13 @@ void CFXAddressableLightEffect::run_intro(light::AddressableLight &it,
       if (act_->hydraulics_fluid_velocity > 15.0f) {
         int splash_count = (cfx::hw_random8(4)) + 3; // 3 to 6 drops — CFX-023
         for (int d = 0; d < splash_count; d++) {
-          if (act_->hydraulics_particle_count <
-              MAX_HYDRAULICS_PARTICLES) { // audit 3.3
-            act_->hydraulics_particles[act_->hydraulics_particle_count++] = {
-                target_l,
-                -act_->hydraulics_fluid_velocity *
-                    (0.2f + (cfx::hw_random8(50)) / 100.0f), // CFX-023
-                true};
+          const uint16_t slot = drops.find_free(0, MAX_HYDRAULICS_PARTICLES);
+          if (slot < MAX_HYDRAULICS_PARTICLES) {
+            drops.spawn(slot, cfx::q16_from_float(target_l),
+                        cfx::q16_from_float(
+                            -act_->hydraulics_fluid_velocity *
+                            (0.2f + (cfx::hw_random8(50)) / 100.0f)), // CFX-023
+                        1, 0);
           }
         }
       }
@@ -5608,15 +5473,15 @@ void CFXAddressableLightEffect::run_intro(light::AddressableLight &it,
     }
 
     // --- Continuous Spray Spawning (While moving fast) ---
-    if (act_->hydraulics_fluid_velocity > 8.0f &&
-        act_->hydraulics_particle_count <
-            MAX_HYDRAULICS_PARTICLES) { // audit 3.3
-      if (cfx::hw_random8(100) < 40) {  // CFX-023
-        act_->hydraulics_particles[act_->hydraulics_particle_count++] = {
-            act_->hydraulics_fluid_level,
-            act_->hydraulics_fluid_velocity *
-                (1.1f + (cfx::hw_random8(40)) / 100.0f), // CFX-023
-            true};
+    if (act_->hydraulics_fluid_velocity > 8.0f) {
+      const uint16_t slot = drops.find_free(0, MAX_HYDRAULICS_PARTICLES);
+      if (slot < MAX_HYDRAULICS_PARTICLES &&
+          cfx::hw_random8(100) < 40) { // CFX-023
+        drops.spawn(slot, cfx::q16_from_float(act_->hydraulics_fluid_level),
+                    cfx::q16_from_float(
+                        act_->hydraulics_fluid_velocity *
+                        (1.1f + (cfx::hw_random8(40)) / 100.0f)), // CFX-023
+                    1, 0);
       }
     }
 
@@ -5673,23 +5538,24 @@ void CFXAddressableLightEffect::run_intro(light::AddressableLight &it,
     }
 
     // 4. Droplets / Particles Rendering
+    // Droplets fall back into the fluid (at or below its level) and bounce
+    // off the end of the pipe.
     float gravity = 25.0f + (intensity_val * 20.0f);
-    for (uint8_t _pi = 0; _pi < act_->hydraulics_particle_count;
-         _pi++) { // audit 3.3
-      auto &p = act_->hydraulics_particles[_pi];
-      if (!p.active)
+    const cfx::q16_16 top = cfx::q16_from_float(target_l);
+    drops.step(cfx::q16_from_float(-gravity), cfx::q16_from_float(dt), 0,
+               MAX_HYDRAULICS_PARTICLES);
+    drops.floor_bounds(
+        cfx::q16_from_float(act_->hydraulics_fluid_level) + 1, 0, 0,
+        MAX_HYDRAULICS_PARTICLES);
+    for (uint16_t _pi = 0; _pi < MAX_HYDRAULICS_PARTICLES; _pi++) {
+      if (!drops.alive(_pi))
         continue;
-      p.vel -= gravity * dt;
-      p.pos += p.vel * dt;
-      if (p.pos <= act_->hydraulics_fluid_level) {
-        p.active = false;
-        continue;
-      }
-      if (p.pos >= target_l) {
-        p.pos = target_l - 0.1f;
-        p.vel *= -0.3f;
+      if (drops.pos[_pi] >= top) {
+        drops.pos[_pi] = top - cfx::q16_from_float(0.1f);
+        drops.vel[_pi] = (cfx::q16_16)(((int64_t)drops.vel[_pi] *
+                                         cfx::q16_from_float(-0.3f)) >> 16);
       }
-      int p_idx = (int)p.pos;
+      int p_idx = cfx::q16_floor(drops.pos[_pi]);
       if (p_idx >= 0 && p_idx < seg_len) {
         uint8_t r = 255, g = 255, b_val = 255, w = 255;
         if (act_->active_force_white)
@@ -5697,15 +5563,6 @@ void CFXAddressableLightEffect::run_intro(light::AddressableLight &it,
         it[seg_start + p_idx] = Color(r, g, b_val, w);
       }
     }
-    // Compact inactive particles (audit 3.3: replaces erase/remove_if on
-    // vector)
-    {
-      uint8_t w = 0;
-      for (uint8_t _pi = 0; _pi < act_->hydraulics_particle_count; _pi++)
-        if (act_->hydraulics_particles[_pi].active)
-          act_->hydraulics_particles[w++] = act_->hydraulics_particles[_pi];
-      act_->hydraulics_particle_count = w;
-    }
     break;
   }
   case INTRO_MODE_MORSE: {
@@ -6543,9 +6400,7 @@ void CFXAddressableLightEffect::run_intro(light::AddressableLight &it,
     }
 
     // Smooth the physical edges
-    if (act_->runner) {
-      act_->runner->_segment.blur(32);
-    }
+    blur_light_range(it, seg_start, seg_len, 32);
     break;
   }
 
@@ -7371,6 +7226,7 @@ bool CFXAddressableLightEffect::run_outro_frame(light::AddressableLight &it,
     break;
   }
   case INTRO_MODE_HYDRAULICS: {
+    cfx::ParticleSet drops = act_->hydraulics_particles();
     uint64_t now_ms = millis_64();
     if (act_->hydraulics_last_ms == 0)
       act_->hydraulics_last_ms = now_ms;
@@ -7398,13 +7254,12 @@ bool CFXAddressableLightEffect::run_outro_frame(light::AddressableLight &it,
     }
 
     // Drops cling more based on intensity
-    if (act_->hydraulics_fluid_level < old_level &&
-        act_->hydraulics_particle_count <
-            MAX_HYDRAULICS_PARTICLES) { // audit 3.3
-      if ((cfx::hw_random8(100)) <
-          (10 + (int)(intensity_val * 25))) { // CFX-023
-        act_->hydraulics_particles[act_->hydraulics_particle_count++] = {
-            old_level, 0.0f, true};
+    if (act_->hydraulics_fluid_level < old_level) {
+      const uint16_t slot = drops.find_free(0, MAX_HYDRAULICS_PARTICLES);
+      if (slot < MAX_HYDRAULICS_PARTICLES &&
+          (cfx::hw_random8(100)) <
+              (10 + (int)(intensity_val * 25))) { // CFX-023
+        drops.spawn(slot, cfx::q16_from_float(old_level), 0, 1, 0);
       }
     }
 
@@ -7439,23 +7294,17 @@ bool CFXAddressableLightEffect::run_outro_frame(light::AddressableLight &it,
       it[seg_start + floor_level] = Color(r, g, b_val, w);
     }
 
+    // Clinging drops fall until they reach the draining fluid (the level is
+    // never below 0).
     float gravity = 25.0f + (intensity_val * 20.0f);
-    for (uint8_t _pi = 0; _pi < act_->hydraulics_particle_count;
-         _pi++) { // audit 3.3
-      auto &p = act_->hydraulics_particles[_pi];
-      if (!p.active)
-        continue;
-      p.vel -= gravity * dt;
-      p.pos += p.vel * dt;
-      if (p.pos < 0.0f) {
-        p.active = false;
+    drops.step(cfx::q16_from_float(-gravity), cfx::q16_from_float(dt), 0,
+               MAX_HYDRAULICS_PARTICLES);
+    drops.floor_bounds(cfx::q16_from_float(act_->hydraulics_fluid_level), 0,
+                       0, MAX_HYDRAULICS_PARTICLES);
+    for (uint16_t _pi = 0; _pi < MAX_HYDRAULICS_PARTICLES; _pi++) {
+      if (!drops.alive(_pi))
         continue;
-      }
-      if (p.pos < act_->hydraulics_fluid_level) {
-        p.active = false;
-        continue;
-      }
-      int p_idx = (int)p.pos;
+      int p_idx = cfx::q16_floor(drops.pos[_pi]);
       if (p_idx >= 0 && p_idx < seg_len) {
         uint8_t r = 255, g = 255, b_val = 255, w = 255;
         if (act_->active_outro_force_white)
@@ -7463,18 +7312,9 @@ bool CFXAddressableLightEffect::run_outro_frame(light::AddressableLight &it,
         it[seg_start + p_idx] = Color(r, g, b_val, w);
       }
     }
-    // Compact inactive particles (audit 3.3: replaces erase/remove_if on
-    // vector)
-    {
-      uint8_t w = 0;
-      for (uint8_t _pi = 0; _pi < act_->hydraulics_particle_count; _pi++)
-        if (act_->hydraulics_particles[_pi].active)
-          act_->hydraulics_particles[w++] = act_->hydraulics_particles[_pi];
-      act_->hydraulics_particle_count = w;
-    }
 
     if (act_->hydraulics_fluid_level <= 0.01f &&
-        act_->hydraulics_particle_count == 0) { // audit 3.3
+        !drops.any_alive(0, MAX_HYDRAULICS_PARTICLES)) {
       for (int i = 0; i < seg_len; i++)
         it[seg_start + i] = Color::BLACK;
       outro_done = true;
@@ -7540,12 +7380,17 @@ bool CFXAddressableLightEffect::run_outro_frame(light::AddressableLight &it,
 
     // ── 1.5 Cache population (First frame only)
     // ───────────────────────────────
-    if (act_->outro_color_cache.empty()) {
+    if (act_->outro_color_cache.empty() &&
+        this->claim_transition_plane_(act_->outro_color_cache,
+                                      cfx_light::TRANSITION_PLANE_OUTRO, it)) {
+      // Narrow the slice to this runner's pixels, indexed like the segment.
+      act_->outro_color_cache.px += seg_start;
+      act_->outro_color_cache.len = seg_len;
       for (int i = 0; i < seg_len; i++) {
         uint32_t c_raw = runner->_segment.getPixelColor(i);
-        act_->outro_color_cache.push_back(Color(
+        act_->outro_color_cache[i] = Color(
             (uint8_t)((c_raw >> 16) & 0xFF), (uint8_t)((c_raw >> 8) & 0xFF),
-            (uint8_t)(c_raw & 0xFF), (uint8_t)((c_raw >> 24) & 0xFF)));
+            (uint8_t)(c_raw & 0xFF), (uint8_t)((c_raw >> 24) & 0xFF));
       }
     }
 
@@ -8458,9 +8303,9 @@ void CFXAddressableLightEffect::apply_autotune_defaults_() {
       call.set_option(pal_name);
       call.perform();
     }
-    act_->autotune_expected_palette = pal_name;
+    act_->autotune_expected_palette = cfx_palette_code(pal_name.c_str());
   } else if (palette_sel != nullptr) {
-    act_->autotune_expected_palette = palette_sel->current_option();
+    act_->autotune_expected_palette = this->palette_code_of_(palette_sel);
   }
 }
 
@@ -8525,8 +8370,8 @@ void CFXAddressableLightEffect::check_milestones_(float current_pct) {
     act_->milestone_fired_this_frame = true;
 #ifdef USE_CFX_EVENTS
     if (!act_->suppress_reach_event && !suppress_ha_reach) {
-      chimera_fx::CFXEventManager::get().fire_reach_event(
-          act_->strip_tag, act_->last_fired_milestone);
+      chimera_fx::CFXEventManager::get().fire_reach(
+          act_->strip_tag_id, act_->last_fired_milestone);
     }
 #endif
     next = act_->last_fired_milestone + MILESTONE_STEP;
@@ -8624,52 +8469,17 @@ void CFXAddressableLightEffect::check_positional_triggers(
   }
 #endif
 
-  // Effect internal triggers (from YAML)
-  if (!(cfg_ ? cfg_->on_reach_triggers : empty_reach_triggers_).empty()) {
-    float current_percentage = (float)current_pixel / (float)total_pixels;
-
-    for (auto *t : (cfg_ ? cfg_->on_reach_triggers : empty_reach_triggers_)) {
-      float target = t->get_target_position();
-      bool crossed = false;
-
-      if (act_->last_triggered_percentage == -1.0f) {
-        if (current_percentage >= target)
-          crossed = true;
-      } else {
-        // Forward crossing
-        if (current_percentage >= target &&
-            act_->last_triggered_percentage < target) {
-          crossed = true;
-        }
-        // Backward crossing
-        else if (current_percentage <= target &&
-                 act_->last_triggered_percentage > target) {
-          crossed = true;
-        }
-        // Wrap-around forward
-        else if (act_->last_triggered_percentage > 0.8f &&
-                 current_percentage < 0.2f) {
-          if (target > act_->last_triggered_percentage ||
-              target <= current_percentage) {
-            crossed = true;
-          }
-        }
-        // Wrap-around backward
-        else if (act_->last_triggered_percentage < 0.2f &&
-                 current_percentage > 0.8f) {
-          if (target < act_->last_triggered_percentage ||
-              target >= current_percentage) {
-            crossed = true;
-          }
-        }
-      }
-
-      if (crossed) {
-        t->trigger(current_percentage);
-      }
-      // Feed WDT in long positional loops (16+ strips)
-      esphome::App.feed_wdt();
-    }
+  // Effect internal triggers (from YAML). The schedule is sorted by target,
+  // so only the targets actually crossed since the last frame are touched.
+  if (cfg_ != nullptr && !cfg_->on_reach_triggers.empty()) {
+    const float current_percentage = (float)current_pixel / (float)total_pixels;
+    cfg_->on_reach_triggers.advance(
+        act_->reach_next, act_->last_triggered_percentage, current_percentage,
+        [current_percentage](CfxOnReachTrigger *t) {
+          t->trigger(current_percentage);
+          // Feed WDT when a large step fires a long run of triggers.
+          esphome::App.feed_wdt();
+        });
   }
 
   act_->last_triggered_percentage = (float)current_pixel / (float)total_pixels;
@@ -8755,6 +8565,7 @@ void CFXAddressableLightEffect::set_active_sequence(
     }
     act_->state = TRANSITION_NONE;
     act_->last_triggered_percentage = -1.0f;
+    act_->reach_next = 0;
     act_->last_leading_pixel = -1;
     act_->last_triggered_pixel = -1;
 
@@ -8844,11 +8655,7 @@ void CFXAddressableLightEffect::execute_completion() {
 }
 
 bool CFXAddressableLightEffect::runner_mode_can_idle_(uint8_t mode) {
-  if (mode == FX_MODE_STATIC) {
-    return true;
-  }
-  return this->get_monochromatic_preset_(mode).is_active &&
-         !this->is_animated_monochromatic_hold_(mode);
+  return (getModeDescriptor(mode).flags & CFX_MODE_CAN_IDLE) != 0;
 }
 
 bool CFXAddressableLightEffect::evaluate_mono_idle_() {
@@ -9,6 +9,10 @@
 #pragma once
 
 #include "CFXRunner.h"
+#include "cfx_effect_descriptor.h"
+#include "cfx_names.h"
+#include "cfx_particles.h"
+#include "cfx_reach_schedule.h"
 #include "cfx_triggers.h"
 #include "esphome/components/light/addressable_light_effect.h"
 #include "esphome/components/number/number.h"
@@ -34,6 +38,8 @@ using cfx_sequence::CFXSequence;
 
 class CFXRunner;
 class CFXControl;
+class CFXLayoutView;
+class CFXEffectStub;
 
 class CFXAddressableLightEffect : public light::AddressableLightEffect {
 public:
@@ -52,21 +58,31 @@ public:
     uint8_t outro_mode;
   };
 
-  struct HydraulicsParticle {
-    float pos;
-    float vel;
-    bool active;
-  };
-
   // ── CFXActivation — heap-allocated per active light ───────────────────────
   // All members that are only meaningful while the effect is running live here.
-  // Allocated in start(), deleted in stop(). At rest the object is ~100 bytes
-  // instead of ~304 bytes, saving ~15 KB across 77 effect objects.
+  // Taken from the shared activation pool in start(), parked in stop(). At
+  // rest the object is ~100 bytes instead of ~304 bytes; with registry entries
+  // listed as stubs there is one such object per light (its engine).
   // Fixed capacity for hydraulics splash/drip particles.
   // Must be declared before CFXActivation so the constant is available as an
   // array bound inside the nested struct.
   static constexpr uint8_t MAX_HYDRAULICS_PARTICLES = 8;
 
+  // A slice of one of the output's preallocated transition planes
+  // (claim_transition_plane_()). Owns no storage; empty means no snapshot.
+  struct TransitionSnapshot {
+    Color *px{nullptr};
+    size_t len{0};
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    Color &operator[](size_t i) { return px[i]; }
+    const Color &operator[](size_t i) const { return px[i]; }
+    void clear() {
+      px = nullptr;
+      len = 0;
+    }
+  };
+
   struct CFXActivation {
     CFXRunner *runner{nullptr};
     std::vector<CFXRunner *> segment_runners{};
@@ -76,8 +92,8 @@ public:
     TransitionState state{TRANSITION_NONE};
     uint64_t transition_start_ms{0};
     uint32_t active_transition_duration_ms{0};
-    std::vector<Color> intro_snapshot{};
-    std::vector<Color> transition_target_snapshot{};
+    TransitionSnapshot intro_snapshot{};
+    TransitionSnapshot transition_target_snapshot{};
     bool is_sequence_outro{false};
 
     bool intro_active{false};
@@ -95,14 +111,19 @@ public:
     uint8_t active_outro_intensity{128};
     float active_outro_brightness{1.0f};
     uint64_t outro_start_time{0};
-    std::vector<Color> outro_color_cache{};
+    TransitionSnapshot outro_color_cache{};
 
     float hydraulics_fluid_level{0.0f};
     float hydraulics_fluid_velocity{0.0f};
-    // Fixed-size array (audit 3.3): avoids heap allocation during intro/outro.
-    // hydraulics_particle_count tracks how many slots [0..count) are active.
-    HydraulicsParticle hydraulics_particles[MAX_HYDRAULICS_PARTICLES]{};
-    uint8_t hydraulics_particle_count{0};
+    // Splash/drip droplets on the particle engine (cfx_particles.h), in
+    // pixels and pixels per second. Fixed block (audit 3.3): no heap
+    // allocation during intro/outro.
+    alignas(4) uint8_t hydraulics_particle_data[cfx::ParticleSet::bytes(
+        MAX_HYDRAULICS_PARTICLES)]{};
+    cfx::ParticleSet hydraulics_particles() {
+      return cfx::ParticleSet::bind(hydraulics_particle_data,
+                                    MAX_HYDRAULICS_PARTICLES);
+    }
     uint64_t hydraulics_last_ms{0};
 
     CFXControl *controller{nullptr};
@@ -116,12 +137,19 @@ public:
     bool autotune_active{false};
     float autotune_expected_speed{-1.0f};
     float autotune_expected_intensity{-1.0f};
-    std::string autotune_expected_palette{};
-    std::string last_sent_palette{};
+    // Palette code autotune last set; a different live code is a manual
+    // override.
+    uint8_t autotune_expected_palette{CFX_PALETTE_CODE_UNKNOWN};
+    // Option last sent to the visualizer, by select and index, so the frame
+    // only compares integers and builds the name when it changes.
+    const select::Select *last_sent_palette_select{nullptr};
+    size_t last_sent_palette_index{SIZE_MAX};
     uint64_t last_metadata_refresh{0};
 
     uint32_t saved_transition_length{0};
     std::string strip_tag{};
+    // Interned strip_tag (CFXEventManager::NO_TAG until start() resolves it).
+    uint16_t strip_tag_id{0xFFFF};
     uint8_t spi_diag_apply_logs{0};
     uint8_t spi_diag_bind_logs{0};
     uint8_t spi_diag_census_logs{0};
@@ -133,6 +161,8 @@ public:
     std::vector<std::string> cached_segment_names{};
     float last_triggered_percentage{-1.0f};
     int32_t last_triggered_pixel{-1};
+    // Cursor into cfg_->on_reach_triggers; reset with last_triggered_percentage.
+    uint16_t reach_next{0};
     bool last_return_phase{false};
     int32_t last_leading_pixel{-1};
     bool lifecycle_start_fired{false};
@@ -247,6 +277,8 @@ public:
     number::Number *inout_duration{nullptr};
     select::Select *outro_effect{nullptr};
     switch_::Switch *debug_switch{nullptr};
+    // Palette code of `palette`, refreshed by its state callback.
+    CFXPaletteCode palette_code;
 
     // Effect preset defaults. Empty/inactive for most virtual segments.
     std::optional<uint8_t> speed_preset{};
@@ -278,7 +310,7 @@ public:
     std::vector<CfxOnBeginTrigger *> on_begin_triggers;
     std::vector<CfxOnStopTrigger *> on_stop_triggers;
     std::vector<CfxOnCompleteTrigger *> on_complete_triggers;
-    std::vector<CfxOnReachTrigger *> on_reach_triggers;
+    CFXReachSchedule<CfxOnReachTrigger> on_reach_triggers;
   };
 
   CFXAddressableLightEffect(const char *name);
@@ -286,7 +318,8 @@ public:
 
   static std::vector<CFXAddressableLightEffect *> all_effects;
   static std::vector<CFXAddressableLightEffect *> all_segment_effects;
-
+  // Heap held by activation records across all effects, parked ones included.
+  static size_t activation_bytes();
 
   void start() override;
   void stop() override;
@@ -296,10 +329,41 @@ public:
     this->effect_id_ = effect_id;
     this->configured_effect_id_ = effect_id;
   }
+  // Shared codegen record with this entry's effect id and YAML presets.
+  void set_descriptor(const CFXEffectDescriptor *desc) {
+    this->desc_ = desc;
+    if (desc != nullptr)
+      this->set_effect_id(desc->effect_id);
+  }
+  const CFXEffectDescriptor *get_descriptor() const { return this->desc_; }
+  // Makes this effect the engine of a light: `stubs` (a static codegen
+  // array, see cfx_effect_stub.h) are the dropdown entries it renders.
+  void set_stubs(CFXEffectStub *stubs, uint16_t count) {
+    this->stubs_ = stubs;
+    this->stub_count_ = count;
+  }
+  bool owns_stub(const light::LightEffect *effect) const;
+  // An engine's runtime presets (cfx_set, play_effect) belong to one entry:
+  // claiming them for another entry drops the previous entry's presets.
+  // Stubs claim on start(); a caller seeding presets ahead of a switch
+  // claims for the target first.
+  void claim_presets_for(const CFXEffectDescriptor *desc) {
+    if (desc == this->presets_desc_)
+      return;
+    this->presets_desc_ = desc;
+    if (this->cfg_ != nullptr)
+      this->clear_runtime_presets_();
+  }
+  // The effect that renders `effect`: the effect itself when it is a CFX
+  // effect, the owning engine when it is a stub, null otherwise.
+  static CFXAddressableLightEffect *engine_for(const light::LightEffect *effect);
+  // The stub listed on `state` as `name`, or null.
+  static CFXEffectStub *find_stub(light::LightState *state,
+                                  const std::string &name);
   // ── Setters — lazily allocate cfg_ on first call ──────────────────────────
   void set_speed(number::Number *v) { ensure_cfg_(); cfg_->speed = v; }
   void set_intensity(number::Number *v) { ensure_cfg_(); cfg_->intensity = v; }
-  void set_palette(select::Select *v) { ensure_cfg_(); cfg_->palette = v; }
+  void set_palette(select::Select *v) { ensure_cfg_(); cfg_->palette = v; cfg_->palette_code.bind(v); }
   void set_mirror(switch_::Switch *v) { ensure_cfg_(); cfg_->mirror = v; }
   void set_autotune(switch_::Switch *v) { ensure_cfg_(); cfg_->autotune = v; }
   // CFX-044: Stack bypass evaluation
@@ -313,6 +377,10 @@ public:
     this->sync_diagnostic_target_interval_();
   }
   uint32_t get_update_interval() const { return this->update_interval_; }
+  void set_adaptive_frame_rate(bool enabled) {
+    this->adaptive_frame_rate_ = enabled;
+  }
+  void set_particle_cap(uint16_t cap) { this->particle_cap_ = cap; }
   uint32_t get_effective_update_interval() const;
   void set_transition_effect(select::Select *v) { ensure_cfg_(); cfg_->transition_effect = v; }
   void set_transition_duration(number::Number *v) { ensure_cfg_(); cfg_->transition_duration = v; }
@@ -420,7 +488,7 @@ public:
     ensure_cfg_(); cfg_->on_complete_triggers.push_back(t);
   }
   void add_on_reach_trigger(CfxOnReachTrigger *t) {
-    ensure_cfg_(); cfg_->on_reach_triggers.push_back(t);
+    ensure_cfg_(); cfg_->on_reach_triggers.add(t);
   }
 
   void trigger_on_start();
@@ -428,6 +496,9 @@ public:
   void trigger_on_stop();
   void trigger_on_complete();
   void check_positional_triggers(int32_t current_pixel, int32_t total_pixels);
+  // Stages the runners for this effect's next start() (CFXWarmStart). An
+  // engine stages for the entry `desc` it is about to be started with.
+  bool prestage_runners(const CFXEffectDescriptor *desc = nullptr);
 
 
   // Per-instance milestone tracking — replaces CFXEventManager singleton state.
@@ -461,8 +532,15 @@ protected:
   // Holds UI entity pointers, preset optionals, and trigger vectors.
   // Allocated on first setter call via ensure_cfg_().
   CFXEffectConfig *cfg_{nullptr};
+  // Shared, flash-resident name/id/YAML presets; null for hand-built effects.
+  // On an engine it is the descriptor of the stub that started it.
+  const CFXEffectDescriptor *desc_{nullptr};
+  CFXEffectStub *stubs_{nullptr};
+  uint16_t stub_count_{0};
+  const CFXEffectDescriptor *presets_desc_{nullptr};
 
   void ensure_cfg_() { if (!cfg_) cfg_ = new CFXEffectConfig(); }
+  void clear_runtime_presets_();
 
   // ── Inline accessors — return null/empty when cfg_ absent ─────────────────
   number::Number *local_speed_() const { return cfg_ ? cfg_->speed : nullptr; }
@@ -478,31 +556,35 @@ protected:
   switch_::Switch *local_debug_switch_() const { return cfg_ ? cfg_->debug_switch : nullptr; }
 
   // ── Preset accessors ──────────────────────────────────────────────────────
-  bool has_speed_preset_() const { return cfg_ && cfg_->speed_preset.has_value(); }
-  bool has_intensity_preset_() const { return cfg_ && cfg_->intensity_preset.has_value(); }
-  bool has_palette_preset_() const { return cfg_ && cfg_->palette_preset.has_value(); }
-  bool has_brightness_preset_() const { return cfg_ && cfg_->brightness_preset.has_value(); }
-  bool has_color_preset_() const { return cfg_ && cfg_->has_color_preset; }
-  bool has_mirror_preset_() const { return cfg_ && cfg_->mirror_preset.has_value(); }
-  bool has_force_white_preset_() const { return cfg_ && cfg_->force_white_preset.has_value(); }
-  bool has_intro_preset_() const { return cfg_ && cfg_->intro_preset.has_value(); }
-  bool has_inout_duration_preset_() const { return cfg_ && cfg_->inout_duration_preset.has_value(); }
-  bool has_outro_preset_() const { return cfg_ && cfg_->outro_preset.has_value(); }
-
-  uint8_t speed_preset_val_() const { return cfg_->speed_preset.value(); }
-  uint8_t intensity_preset_val_() const { return cfg_->intensity_preset.value(); }
-  uint8_t palette_preset_val_() const { return cfg_->palette_preset.value(); }
-  float brightness_preset_val_() const { return cfg_->brightness_preset.value(); }
-  bool color_preset_has_white_() const { return cfg_->color_preset_has_white; }
-  uint8_t color_preset_r_() const { return cfg_->color_preset_r; }
-  uint8_t color_preset_g_() const { return cfg_->color_preset_g; }
-  uint8_t color_preset_b_() const { return cfg_->color_preset_b; }
-  uint8_t color_preset_w_() const { return cfg_->color_preset_w; }
-  bool mirror_preset_val_() const { return cfg_->mirror_preset.value(); }
-  bool force_white_preset_val_() const { return cfg_->force_white_preset.value(); }
-  uint8_t intro_preset_val_() const { return cfg_->intro_preset.value(); }
-  float inout_duration_preset_val_() const { return cfg_->inout_duration_preset.value(); }
-  uint8_t outro_preset_val_() const { return cfg_->outro_preset.value(); }
+  // A runtime preset in cfg_ wins; otherwise the descriptor's YAML preset.
+  bool desc_has_(uint16_t bit) const { return desc_ != nullptr && desc_->has(bit); }
+  bool cfg_color_preset_() const { return cfg_ && cfg_->has_color_preset; }
+
+  bool has_speed_preset_() const { return (cfg_ && cfg_->speed_preset.has_value()) || desc_has_(CFX_DESC_SPEED); }
+  bool has_intensity_preset_() const { return (cfg_ && cfg_->intensity_preset.has_value()) || desc_has_(CFX_DESC_INTENSITY); }
+  bool has_palette_preset_() const { return (cfg_ && cfg_->palette_preset.has_value()) || desc_has_(CFX_DESC_PALETTE); }
+  bool has_brightness_preset_() const { return (cfg_ && cfg_->brightness_preset.has_value()) || desc_has_(CFX_DESC_BRIGHTNESS); }
+  bool has_color_preset_() const { return cfg_color_preset_() || desc_has_(CFX_DESC_COLOR); }
+  bool has_mirror_preset_() const { return (cfg_ && cfg_->mirror_preset.has_value()) || desc_has_(CFX_DESC_MIRROR); }
+  bool has_force_white_preset_() const { return (cfg_ && cfg_->force_white_preset.has_value()) || desc_has_(CFX_DESC_FORCE_WHITE); }
+  bool has_intro_preset_() const { return (cfg_ && cfg_->intro_preset.has_value()) || desc_has_(CFX_DESC_INTRO); }
+  bool has_inout_duration_preset_() const { return (cfg_ && cfg_->inout_duration_preset.has_value()) || desc_has_(CFX_DESC_INOUT_DURATION); }
+  bool has_outro_preset_() const { return (cfg_ && cfg_->outro_preset.has_value()) || desc_has_(CFX_DESC_OUTRO); }
+
+  uint8_t speed_preset_val_() const { return cfg_ && cfg_->speed_preset.has_value() ? cfg_->speed_preset.value() : desc_->speed; }
+  uint8_t intensity_preset_val_() const { return cfg_ && cfg_->intensity_preset.has_value() ? cfg_->intensity_preset.value() : desc_->intensity; }
+  uint8_t palette_preset_val_() const { return cfg_ && cfg_->palette_preset.has_value() ? cfg_->palette_preset.value() : desc_->palette; }
+  float brightness_preset_val_() const { return cfg_ && cfg_->brightness_preset.has_value() ? cfg_->brightness_preset.value() : desc_->brightness; }
+  bool color_preset_has_white_() const { return cfg_color_preset_() ? cfg_->color_preset_has_white : desc_->has(CFX_DESC_COLOR_WHITE); }
+  uint8_t color_preset_r_() const { return cfg_color_preset_() ? cfg_->color_preset_r : desc_->color[0]; }
+  uint8_t color_preset_g_() const { return cfg_color_preset_() ? cfg_->color_preset_g : desc_->color[1]; }
+  uint8_t color_preset_b_() const { return cfg_color_preset_() ? cfg_->color_preset_b : desc_->color[2]; }
+  uint8_t color_preset_w_() const { return cfg_color_preset_() ? cfg_->color_preset_w : desc_->color[3]; }
+  bool mirror_preset_val_() const { return cfg_ && cfg_->mirror_preset.has_value() ? cfg_->mirror_preset.value() : desc_->mirror; }
+  bool force_white_preset_val_() const { return cfg_ && cfg_->force_white_preset.has_value() ? cfg_->force_white_preset.value() : desc_->force_white; }
+  uint8_t intro_preset_val_() const { return cfg_ && cfg_->intro_preset.has_value() ? cfg_->intro_preset.value() : desc_->intro; }
+  float inout_duration_preset_val_() const { return cfg_ && cfg_->inout_duration_preset.has_value() ? cfg_->inout_duration_preset.value() : desc_->inout_duration_s; }
+  uint8_t outro_preset_val_() const { return cfg_ && cfg_->outro_preset.has_value() ? cfg_->outro_preset.value() : desc_->outro; }
   std::optional<uint32_t> resolve_inout_duration_override_ms_(
       number::Number *dur_num) const {
     if (dur_num != nullptr && dur_num->has_state()) {
@@ -721,14 +803,10 @@ public:
   static const std::vector<CfxOnBeginTrigger *> empty_begin_triggers_;
   static const std::vector<CfxOnStopTrigger *> empty_stop_triggers_;
   static const std::vector<CfxOnCompleteTrigger *> empty_complete_triggers_;
-  static const std::vector<CfxOnReachTrigger *> empty_reach_triggers_;
 
 
-  void set_strip_tag(const std::string &tag) {
-    this->configured_strip_tag_ = tag;
-    if (act_)
-      act_->strip_tag = tag;
-  }
+  // `tag` must outlive the effect (codegen passes a literal).
+  void set_strip_tag(const char *tag);
 
   void set_is_sequence_outro(bool v) { if (act_) act_->is_sequence_outro = v; }
   void set_suppress_positional_events(bool v) {
@@ -755,15 +833,45 @@ public:
   // is_virtual_segment_ is set at codegen time, not per-activation.
   bool is_virtual_segment_{false};
   uint32_t update_interval_{16};
+  bool adaptive_frame_rate_{false};
+  uint16_t particle_cap_{0};
+  // True when every runner held its previous frame (frame governor), so the
+  // light already shows the current output.
+  bool runners_held_frame_() const;
+  // Hands the output the LEDs the runner committed since the last show, so
+  // its encoder can reuse the rest of the previous frame.
+  void report_dirty_range_(cfx_light::CFXLightOutput *out);
+  // Tags the LEDs this effect draws with `mode` for power accounting.
+  void report_power_effect_(uint8_t mode);
+  // Points snap at the LEDs of `it` in an output transition plane; false
+  // when the output has no planes (the caller then skips the blend).
+  bool claim_transition_plane_(TransitionSnapshot &snap, uint8_t plane,
+                               light::AddressableLight &it);
+  // run_intro() / run_outro_frame() for one runner. A laid-out segment is
+  // drawn through a CFXLayoutView (layout_view_ while it runs) so its gaps,
+  // folds and LED order follow the layout.
+  void run_intro_on_(light::AddressableLight &it, CFXRunner *runner,
+                     const Color &target_color);
+  bool run_outro_on_(light::AddressableLight &it, CFXRunner *runner);
+  CFXLayoutView *layout_view_{nullptr};
+  // The output gate carries a cfx_dimmer preview (see apply()).
+  bool preview_gated_{false};
+  // Activations are parked in a small shared pool instead of freed, so
+  // restarting an effect does not hit the heap.
+  static CFXActivation *acquire_activation_();
+  static void release_activation_(CFXActivation *act);
 
   void sync_diagnostic_target_interval_();
+  bool create_runners_(light::AddressableLight *it,
+                       std::vector<CFXRunner *> &runners, bool &segmented,
+                       bool allow_segments);
   uint64_t next_run_{0};         // Absolute due-time gate; avoids snapping to caller ticks.
   uint64_t last_run_{0};         // Per-instance rate gate — must NOT be in CFXActivation (shared across virtual segments)
 
   // controller_ is set at codegen time via set_controller(), before start()
   // is ever called. Copied into act_->controller on each start().
   CFXControl *controller_{nullptr};
-  std::string configured_strip_tag_{};
+  const char *configured_strip_tag_{nullptr};
 
 
 
@@ -781,12 +889,13 @@ public:
 
   uint8_t get_palette_index_();
   uint8_t get_pal_idx(select::Select *s);
+  uint8_t palette_code_of_(select::Select *sel) const;
   uint8_t get_default_palette_id_(uint8_t effect_id);
   Color get_intro_palette_color_(uint8_t palette_id, const Color &fallback) const;
   bool resolve_force_white_active_(bool requested, uint8_t palette_id) const;
-  std::string get_palette_name_(uint8_t pal_id);
-  std::string get_intro_name_(uint8_t intro_id);
-  std::string get_outro_name_(uint8_t outro_id);
+  const char *get_palette_name_(uint8_t pal_id) const;
+  const char *get_intro_name_(uint8_t intro_id) const;
+  const char *get_outro_name_(uint8_t outro_id) const;
   uint32_t get_intro_mode_min_duration_ms_(uint8_t intro_mode) const;
   uint32_t get_outro_mode_min_duration_ms_(uint8_t outro_mode) const;
   std::optional<float> get_default_inout_duration_s_(uint8_t effect_id) const;
@@ -873,13 +982,9 @@ public:
     light::LightEffect *effect =
         LightStateProxy::get_active_effect(this->light_);
     if (effect != nullptr) {
-      CFXAddressableLightEffect *active_fx = nullptr;
-      for (auto *inst : CFXAddressableLightEffect::all_effects) {
-        if (inst == effect) {
-          active_fx = inst;
-          break;
-        }
-      }
+      // A stub resolves to its light's engine.
+      CFXAddressableLightEffect *active_fx =
+          CFXAddressableLightEffect::engine_for(effect);
       if (active_fx != nullptr) {
         if (this->speed_.has_value())
           active_fx->set_speed_preset(this->speed_.value(x...));
@@ -14,6 +14,7 @@
 
 #ifdef USE_ARDUINO
 #include <Arduino.h>
+#include "esp_timer.h"
 #define CFX_ARDUINO 1
 #else
 #include "esp_timer.h"
@@ -44,6 +45,10 @@ inline uint32_t cfx_millis() {
 #endif
 }
 
+// Monotonic 64-bit microseconds; never wraps in practice (ESP32 only, so
+// esp_timer is available under both frameworks).
+inline uint64_t cfx_micros_64() { return (uint64_t)esp_timer_get_time(); }
+
 inline uint32_t cfx_micros() {
 #ifdef CFX_ARDUINO
   return micros();
@@ -18,6 +18,7 @@
 #include "../cfx_light/cfx_light.h"
 #include "../cfx_light/cfx_virtual_segment_light.h"
 #include "cfx_addressable_light_effect.h"
+#include "cfx_names.h"
 #ifdef USE_CFX_EVENTS
 #include "cfx_event_manager.h"
 #endif
@@ -208,13 +209,9 @@ public:
     else
       runner->setDebug(global_debug_enabled_);
     if (select_has_state(palette_) && !runner->sequence_owns_palette_) {
-      std::string opt_str(palette_->current_option());
-      const char *opt_ptr = opt_str.c_str();
-      std::string opt = opt_ptr ? opt_ptr : "";
-      if (!opt.empty() && opt != "Default") {
-        uint8_t pal_idx = get_palette_index_(opt);
-        runner->setPalette(pal_idx);
-      }
+      const uint8_t code = this->palette_code_.get();
+      if (code != CFX_PALETTE_CODE_DEFAULT)
+        runner->setPalette(code);
     }
   }
 
@@ -227,6 +224,8 @@ public:
   number::Number *get_speed() { return speed_; }
   number::Number *get_intensity() { return intensity_; }
   select::Select *get_palette() { return palette_; }
+  // Palette id of the current option, or CFX_PALETTE_CODE_DEFAULT.
+  uint8_t get_palette_code() const { return this->palette_code_.get(); }
   esphome::light::LightState *get_light() { return light_; }
   esphome::switch_::Switch *get_mirror() { return mirror_; }
   esphome::switch_::Switch *get_autotune() { return autotune_; }
@@ -290,10 +289,12 @@ protected:
       return;
     }
     this->palette_cb_select_ = this->palette_;
+    // Bound first so its callback refreshes the code before the push below.
+    this->palette_code_.bind(this->palette_);
     this->palette_->add_on_state_callback(
         [this](size_t) {
-          const char *opt_ptr = this->palette_->current_option().c_str();
-          if (opt_ptr == nullptr || strcmp(opt_ptr, "Default") == 0) {
+          const uint8_t r_pal_idx = this->palette_code_.get();
+          if (r_pal_idx == CFX_PALETTE_CODE_DEFAULT) {
             // "Default" is effect-specific. Let the effect resolve and push
             // its own natural palette on the next control pass instead of
             // forcing a generic control-layer palette index here.
@@ -301,7 +302,6 @@ protected:
             return;
           }
 
-          uint8_t r_pal_idx = this->get_palette_index_(opt_ptr);
           this->apply_to_live_runners_([r_pal_idx](CFXRunner *r) {
             if (!r->sequence_owns_palette_) {
               r->setPalette(r_pal_idx);
@@ -530,6 +530,7 @@ protected:
   number::Number *speed_{nullptr};
   number::Number *intensity_{nullptr};
   select::Select *palette_{nullptr};
+  CFXPaletteCode palette_code_;
   esphome::switch_::Switch *mirror_{nullptr};
   esphome::switch_::Switch *autotune_{nullptr};
   esphome::switch_::Switch *force_white_{nullptr};
@@ -547,43 +548,6 @@ protected:
   esphome::light::LightState *light_{nullptr};
   std::vector<CFXRunner *> runners_;
   bool was_on_{false};
-
-
-  // audit 2.1: accept const char* directly to avoid std::string comparisons.
-  // Callers that hold a std::string pass .c_str(); callers with a const char*
-  // pass it straight through.
-  uint8_t get_palette_index_(const char *name) {
-    if (!name) return 0;
-    if (strcmp(name, "Aurora") == 0)      return 1;
-    if (strcmp(name, "Forest") == 0)      return 2;
-    if (strcmp(name, "Halloween") == 0)   return 3;
-    if (strcmp(name, "Rainbow") == 0)     return 4;
-    if (strcmp(name, "Fire") == 0)        return 5;
-    if (strcmp(name, "Sunset") == 0)      return 6;
-    if (strcmp(name, "Ice") == 0)         return 7;
-    if (strcmp(name, "Party") == 0)       return 8;
-    if (strcmp(name, "Pastel") == 0)      return 10;
-    if (strcmp(name, "Ocean") == 0)       return 11;
-    if (strcmp(name, "HeatColors") == 0)  return 12;
-    if (strcmp(name, "Sakura") == 0)      return 13;
-    if (strcmp(name, "Rivendell") == 0)   return 14;
-    if (strcmp(name, "Cyberpunk") == 0)   return 15;
-    if (strcmp(name, "OrangeTeal") == 0)  return 16;
-    if (strcmp(name, "Christmas") == 0)   return 17;
-    if (strcmp(name, "RedBlue") == 0)     return 18;
-    if (strcmp(name, "Matrix") == 0)      return 19;
-    if (strcmp(name, "SunnyGold") == 0)   return 20;
-    if (strcmp(name, "Solid") == 0)       return 255;
-    if (strcmp(name, "Fairy") == 0)       return 22;
-    if (strcmp(name, "Twilight") == 0)    return 9;
-    if (strcmp(name, "Smart Random") == 0) return 254;  // CFX-019
-    return 0;
-  }
-  // Overload for callers that already hold a std::string (avoids changing
-  // every call site while still eliminating the comparison overhead).
-  uint8_t get_palette_index_(const std::string &name) {
-    return get_palette_index_(name.c_str());
-  }
 };
 
 } // namespace chimera_fx
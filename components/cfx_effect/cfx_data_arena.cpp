@@ -0,0 +1,93 @@
+/*
+ * ChimeraFX — Segment data arenas implementation
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ */
+
+#include "cfx_data_arena.h"
+#include "esp_heap_caps.h"
+#include <cstdlib>
+
+namespace esphome {
+namespace chimera_fx {
+
+bool CFXDataArena::reserve(size_t bytes) {
+  if (bytes <= capacity_)
+    return true;
+  free(block_);
+  // Segment::data is read and written per pixel every frame, so keep it in
+  // internal RAM; large blocks would otherwise land in PSRAM on boards that
+  // route big mallocs there.
+  block_ = (uint8_t *)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (block_ == nullptr)
+    block_ = (uint8_t *)malloc(bytes);
+  capacity_ = block_ != nullptr ? bytes : 0;
+  return block_ != nullptr;
+}
+
+CFXDataArenaPool &CFXDataArenaPool::get() {
+  static CFXDataArenaPool inst;
+  return inst;
+}
+
+CFXDataArena *CFXDataArenaPool::claim(const void *owner, uint16_t start,
+                                      size_t bytes) {
+  CFXDataArena *slot = nullptr;
+  portENTER_CRITICAL(&lock_);
+  // Prefer this segment's own parked block, then a never-used slot, then
+  // any parked block (outputs are never destroyed, so stale keys only come
+  // from segment layouts that no longer exist).
+  CFXDataArena *fresh = nullptr;
+  CFXDataArena *stale = nullptr;
+  for (CFXDataArena &a : slots_) {
+    if (a.in_use_)
+      continue;
+    if (a.owner_ == owner && a.start_ == start) {
+      slot = &a;
+      break;
+    }
+    if (a.owner_ == nullptr) {
+      if (fresh == nullptr)
+        fresh = &a;
+    } else if (stale == nullptr) {
+      stale = &a;
+    }
+  }
+  if (slot == nullptr)
+    slot = fresh != nullptr ? fresh : stale;
+  if (slot != nullptr) {
+    slot->in_use_ = true;
+    slot->owner_ = owner;
+    slot->start_ = start;
+  }
+  portEXIT_CRITICAL(&lock_);
+
+  if (slot == nullptr)
+    return nullptr;
+  // The slot is ours now; allocate outside the critical section.
+  if (!slot->reserve(bytes)) {
+    release(slot);
+    return nullptr;
+  }
+  return slot;
+}
+
+void CFXDataArenaPool::release(CFXDataArena *arena) {
+  if (arena == nullptr)
+    return;
+  portENTER_CRITICAL(&lock_);
+  arena->in_use_ = false;
+  portEXIT_CRITICAL(&lock_);
+}
+
+size_t CFXDataArenaPool::reserved_bytes() const {
+  size_t total = 0;
+  portENTER_CRITICAL(&lock_);
+  for (const CFXDataArena &a : slots_)
+    total += a.capacity_;
+  portEXIT_CRITICAL(&lock_);
+  return total;
+}
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -0,0 +1,72 @@
+/*
+ * ChimeraFX — Segment data arenas
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Runners are recreated on every effect start, and each effect sizes
+ * Segment::data differently, so a sequencer cycling effects used to hit the
+ * heap with a free/malloc pair per switch and per segment. Each output now
+ * owns one grow-only block per segment, sized up front for the largest
+ * effect-data requirement at that length. Switching effects is a pointer
+ * reset plus memset.
+ *
+ * Slots are keyed by (output, segment start). A second slot for the same key
+ * only appears while an outro runner overlaps the next effect. Blocks persist
+ * for the firmware lifetime, like the CFXRunPool sequences.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cfx_limits.h"
+#include "freertos/FreeRTOS.h"
+
+namespace esphome {
+namespace chimera_fx {
+
+class CFXDataArena {
+public:
+  uint8_t *base() const { return block_; }
+  size_t capacity() const { return capacity_; }
+
+  // Grow-only: keeps the block when it already fits. Must not be called
+  // while Segment::data points into the block.
+  bool reserve(size_t bytes);
+
+private:
+  friend class CFXDataArenaPool;
+
+  uint8_t *block_{nullptr};
+  size_t capacity_{0};
+  const void *owner_{nullptr};
+  uint16_t start_{0};
+  bool in_use_{false};
+};
+
+class CFXDataArenaPool {
+public:
+  static constexpr uint8_t POOL_SIZE = CFX_DATA_ARENA_SLOTS;
+
+  static CFXDataArenaPool &get();
+
+  // Claims the arena for (owner, start) and reserves `bytes`. Returns
+  // nullptr when every slot is busy or the reservation fails; callers then
+  // fall back to per-effect heap allocation.
+  CFXDataArena *claim(const void *owner, uint16_t start, size_t bytes);
+  void release(CFXDataArena *arena);
+
+  // Total bytes held by arena blocks (in use or parked).
+  size_t reserved_bytes() const;
+
+private:
+  CFXDataArenaPool() = default;
+
+  CFXDataArena slots_[POOL_SIZE];
+  // claim() runs from CFXRunner::service(), which either core may call.
+  mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -0,0 +1,59 @@
+/*
+ * ChimeraFX — Shared effect descriptors
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Every light lists the same ~80 registry effects, and each entry used to
+ * carry its name, effect id and YAML presets in its own object (presets in a
+ * heap CFXEffectConfig). Codegen now emits one const descriptor per distinct
+ * entry; registry entries are listed through CFXEffectStub records that hold
+ * only a pointer to it, and hand-configured effect objects point at it too,
+ * so the lights share flash data instead of building copies at boot. Presets
+ * set at runtime (cfx_set, cfx.play_effect) still go to the rendering
+ * effect's own cfg_ and win over the descriptor.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace chimera_fx {
+
+// Which preset fields of a descriptor are set.
+enum CFXDescriptorPreset : uint16_t {
+  CFX_DESC_SPEED = 1 << 0,
+  CFX_DESC_INTENSITY = 1 << 1,
+  CFX_DESC_PALETTE = 1 << 2,
+  CFX_DESC_BRIGHTNESS = 1 << 3,
+  CFX_DESC_COLOR = 1 << 4,
+  CFX_DESC_COLOR_WHITE = 1 << 5,
+  CFX_DESC_MIRROR = 1 << 6,
+  CFX_DESC_FORCE_WHITE = 1 << 7,
+  CFX_DESC_INTRO = 1 << 8,
+  CFX_DESC_INOUT_DURATION = 1 << 9,
+  CFX_DESC_OUTRO = 1 << 10,
+};
+
+// Aggregate so codegen can emit it as a brace initializer; field order is
+// part of that contract (see effect_descriptor() in cfx_effect/__init__.py).
+struct CFXEffectDescriptor {
+  const char *name;
+  uint8_t effect_id;
+  uint16_t presets;  // CFXDescriptorPreset bits
+  uint8_t speed;
+  uint8_t intensity;
+  uint8_t palette;
+  uint8_t intro;
+  uint8_t outro;
+  bool mirror;
+  bool force_white;
+  uint8_t color[4];  // r, g, b, w
+  float brightness;
+  float inout_duration_s;
+
+  constexpr bool has(uint16_t bit) const { return (this->presets & bit) != 0; }
+};
+
+} // namespace chimera_fx
+} // namespace esphome
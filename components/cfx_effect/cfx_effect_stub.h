@@ -4,20 +4,26 @@
  *
  * Licensed under the EUPL-1.2
  *
- * Slim proxy that populates the HA effect dropdown for virtual segments
- * without carrying full CFXAddressableLightEffect runner/config overhead.
- * All rendering is delegated to a per-segment singleton effect instance.
+ * Slim proxy that lists one effect in a light's HA effect dropdown without
+ * carrying CFXAddressableLightEffect runner/config overhead. All rendering is
+ * delegated to the light's engine: one CFXAddressableLightEffect per light
+ * that runs whichever entry is selected.
  *
  * Architecture:
- *   Many stubs delegate to 1 singleton.
- *   HA sees all effect names. Only the singleton allocates CFXActivation/CFXRunner.
+ *   Codegen emits each light's stubs as one static array (effect_stubs() in
+ *   cfx_effect/__init__.py) and hands it to the engine with set_stubs(). A
+ *   stub finds its engine through CFXAddressableLightEffect::engine_for(),
+ *   and the engine takes its activation from the shared pool on start().
  *
- * Memory savings: keeps each selectable segment effect to a tiny proxy.
+ * Memory savings: the name, effect id and YAML presets live in a shared
+ * CFXEffectDescriptor, so a stub is just the light-effect base plus the
+ * descriptor pointer, with no heap allocation and no registration.
  */
 
 #pragma once
 
 #include "cfx_addressable_light_effect.h"
+#include "cfx_effect_descriptor.h"
 #include "esphome/components/light/addressable_light_effect.h"
 #include "esphome/components/light/light_effect.h"
 #include "esphome/core/log.h"
@@ -27,79 +33,88 @@ namespace chimera_fx {
 
 class CFXEffectStub : public light::AddressableLightEffect {
 public:
-  CFXEffectStub(const char *name, uint8_t effect_id,
-                CFXAddressableLightEffect *singleton)
-      : AddressableLightEffect(name),
-        effect_id_(effect_id),
-        singleton_(singleton) {}
+  // Not explicit, so codegen can brace-initialize a stub array from
+  // descriptor pointers.
+  CFXEffectStub(const CFXEffectDescriptor *desc)
+      : AddressableLightEffect(desc->name), desc_(desc) {}
 
   /// Called by ESPHome when this stub is selected from the HA effect dropdown.
   /// ESPHome guarantees: old_effect.stop() completes before new_effect.start().
   /// Flow: ESPHome calls stub->start_internal() which handles
   /// set_effect_active(true) + clear_effect_data(), then calls this start().
   void start() override {
-    // Inject the segment's LightState so the singleton can access the
-    // CFXVirtualSegmentLight output, find its CFXControl, and derive
-    // its strip_tag for events.
+    auto *engine = this->get_engine();
+    if (engine == nullptr)
+      return;
+    // Inject the light's LightState so the engine can access the output,
+    // find its CFXControl, and derive its strip_tag for events.
     static uint8_t start_diag_logs = 0;
     if (start_diag_logs < 32) {
       auto *state = this->get_light_state();
       ESP_LOGI("cfx_stub",
-               "Segment effect start[%u]: light='%s' "
-               "state=%p output=%p stub=%p singleton=%p effect_id=%u "
+               "Effect start[%u]: light='%s' "
+               "state=%p output=%p stub=%p engine=%p effect_id=%u "
                "effect='%s'",
                static_cast<unsigned>(start_diag_logs),
                state != nullptr ? state->get_name().c_str() : "<null>",
                state, state != nullptr ? state->get_output() : nullptr, this,
-               singleton_, static_cast<unsigned>(effect_id_),
+               engine, static_cast<unsigned>(desc_->effect_id),
                this->get_name().c_str());
       start_diag_logs++;
     }
-    singleton_->init_internal(this->get_light_state());
-    singleton_->set_effect_id(effect_id_);
-    singleton_->start();
+    engine->init_internal(this->get_light_state());
+    engine->claim_presets_for(desc_);
+    engine->set_descriptor(desc_);
+    engine->start();
   }
 
   /// Called by ESPHome when the effect is deactivated or a different effect
-  /// is selected. Tears down the singleton's CFXActivation + CFXRunner.
+  /// is selected. Tears down the engine's CFXActivation + CFXRunner.
   void stop() override {
+    auto *engine = this->get_engine();
+    if (engine == nullptr)
+      return;
     static uint8_t stop_diag_logs = 0;
     auto *state = this->get_light_state();
     if (stop_diag_logs < 32) {
       ESP_LOGI("cfx_stub",
-               "Segment effect stop[%u]: light='%s' "
-               "state=%p output=%p stub=%p singleton=%p effect_id=%u "
+               "Effect stop[%u]: light='%s' "
+               "state=%p output=%p stub=%p engine=%p effect_id=%u "
                "effect='%s' active='%s' remote_on=%d",
                static_cast<unsigned>(stop_diag_logs),
                state != nullptr ? state->get_name().c_str() : "<null>",
                state, state != nullptr ? state->get_output() : nullptr, this,
-               singleton_, static_cast<unsigned>(effect_id_),
+               engine, static_cast<unsigned>(desc_->effect_id),
                this->get_name().c_str(),
                state != nullptr ? state->get_effect_name().c_str() : "<null>",
                state != nullptr ? state->remote_values.is_on() : 0);
       stop_diag_logs++;
     }
-    singleton_->init_internal(state);
-    singleton_->set_effect_id(effect_id_);
-    singleton_->request_lifecycle_shutdown();
-    singleton_->stop();
+    engine->init_internal(state);
+    engine->set_descriptor(desc_);
+    engine->request_lifecycle_shutdown();
+    engine->stop();
   }
 
   /// Called every frame by AddressableLightEffect::apply() after its
-  /// rate-gate passes. Delegates rendering to the singleton.
+  /// rate-gate passes. Delegates rendering to the engine.
   void apply(light::AddressableLight &it, const Color &current_color) override {
-    singleton_->apply(it, current_color);
+    auto *engine = this->get_engine();
+    if (engine != nullptr)
+      engine->apply(it, current_color);
   }
 
   /// Expose the effect_id for diagnostics and cfx_set routing.
-  uint8_t get_effect_id() const { return effect_id_; }
+  uint8_t get_effect_id() const { return desc_->effect_id; }
+  const CFXEffectDescriptor *get_descriptor() const { return desc_; }
 
-  /// Expose the underlying singleton effect so the coordinator can resolve it.
-  CFXAddressableLightEffect *get_singleton() const { return singleton_; }
+  /// The engine that renders this stub's light.
+  CFXAddressableLightEffect *get_engine() const {
+    return CFXAddressableLightEffect::engine_for(this);
+  }
 
 private:
-  uint8_t effect_id_;
-  CFXAddressableLightEffect *singleton_;
+  const CFXEffectDescriptor *desc_;
 };
 
 }  // namespace chimera_fx
@@ -4,38 +4,61 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include <cstdio>
+#include <cstring>
 #include <map>
 #include <string>
 #include <vector>
-#include <algorithm>
 
 namespace esphome {
 namespace chimera_fx {
 
+// Lifecycle event types. Names are the HA event_type prefixes.
+enum CFXEventType : uint8_t {
+  CFX_EVENT_START = 0,
+  CFX_EVENT_STOP,
+  CFX_EVENT_COMPLETE,
+  CFX_EVENT_BEGIN,
+  CFX_EVENT_REACH,
+  CFX_EVENT_TYPE_COUNT,
+};
+
+static constexpr const char *CFX_EVENT_TYPE_NAMES[CFX_EVENT_TYPE_COUNT] = {
+    "cfx_start", "cfx_stop", "cfx_complete", "cfx_begin", "cfx_reach",
+};
+
 class CFXEventManager {
 public:
-  enum DeferredKind : uint8_t {
-    DEFERRED_KIND_TEXT = 0,
-    DEFERRED_KIND_REACH = 1,
-  };
+  // Tag id for untagged events; those go to the default event entity.
+  static constexpr uint16_t NO_TAG = 0xFFFF;
 
   static CFXEventManager &get() {
     static CFXEventManager instance;
     return instance;
   }
 
+  // Strip tags are interned once, at codegen or effect start; everything
+  // after that works on the id. Allocates only the first time a tag is seen.
+  uint16_t intern_tag(const std::string &tag) {
+    if (tag.empty())
+      return NO_TAG;
+    auto it = this->strip_tag_ids_.find(tag);
+    if (it != this->strip_tag_ids_.end())
+      return it->second;
+    if (this->strip_tags_.size() >= NO_TAG)
+      return NO_TAG;
+    const uint16_t tag_id = static_cast<uint16_t>(this->strip_tags_.size());
+    this->strip_tag_ids_[tag] = tag_id;
+    this->strip_tags_.push_back(tag);
+    this->strip_entities_by_id_.push_back(nullptr);
+    this->tag_disabled_.push_back(0);
+    return tag_id;
+  }
+
   // CFX-028: register a dedicated HA event entity for one strip tag.
   void register_strip_entity(const std::string &tag, esphome::event::Event *e) {
-    this->strip_entities_[tag] = e;
-    auto id_it = this->strip_tag_ids_.find(tag);
-    if (id_it == this->strip_tag_ids_.end()) {
-      uint16_t tag_id = static_cast<uint16_t>(this->strip_tags_.size());
-      this->strip_tag_ids_[tag] = tag_id;
-      this->strip_tags_.push_back(tag);
-      this->strip_entities_by_id_.push_back(e);
-    } else if (id_it->second < this->strip_entities_by_id_.size()) {
-      this->strip_entities_by_id_[id_it->second] = e;
-    }
+    const uint16_t tag_id = this->intern_tag(tag);
+    if (tag_id != NO_TAG)
+      this->strip_entities_by_id_[tag_id] = e;
     if (this->event_entity_ == nullptr)
       this->event_entity_ = e;
   }
@@ -45,109 +68,73 @@ public:
 
   // Per-tag event delivery opt-out (CFX-040)
   void set_ha_events_disabled_for_tag(const std::string &tag) {
-    if (std::find(this->disabled_tags_.begin(), this->disabled_tags_.end(), tag) == this->disabled_tags_.end()) {
-      this->disabled_tags_.push_back(tag);
-    }
+    const uint16_t tag_id = this->intern_tag(tag);
+    if (tag_id != NO_TAG)
+      this->tag_disabled_[tag_id] = 1;
   }
 
-  void add_known_tag(const std::string &tag) { (void) tag; }
+  uint16_t add_known_tag(const std::string &tag) { return this->intern_tag(tag); }
 
-  void fire_event(const char *type) {
-    if (!this->ha_events_enabled_ || type == nullptr)
+  // Frame-path entry points: no strings, no lookups, no allocation. The
+  // record goes into the ring and flush_pending() delivers it.
+  void fire(CFXEventType type, uint16_t tag_id) {
+    if (!this->ha_events_enabled_ || type >= CFX_EVENT_TYPE_COUNT)
       return;
-    std::string evt(type);
     esphome::event::Event *target_entity = this->event_entity_;
-    if (!this->resolve_target_entity_(evt, &target_entity))
+    if (!this->resolve_target_(tag_id, &target_entity))
       return;
-    this->push_deferred_text_(evt, target_entity);
+    this->push_deferred_(type, tag_id, 0, target_entity);
   }
 
-  void fire_reach_event(const std::string &tag, uint8_t milestone) {
-    if (!this->ha_events_enabled_ || tag.empty())
+  void fire_reach(uint16_t tag_id, uint8_t milestone) {
+    if (!this->ha_events_enabled_ || tag_id == NO_TAG)
       return;
-
     esphome::event::Event *target_entity = this->event_entity_;
-    uint16_t tag_id = 0;
-    if (!this->resolve_reach_target_(tag, &target_entity, &tag_id))
+    if (!this->resolve_target_(tag_id, &target_entity))
       return;
-    this->push_deferred_reach_(tag_id, milestone, target_entity);
+    this->push_deferred_(CFX_EVENT_REACH, tag_id, milestone, target_entity);
   }
 
-  // Push one event string onto the deferred ring-buffer queue.
-  // Full-string coalescing: exact duplicates are dropped. (CFX-034)
-  void push_deferred_text_(const std::string &evt,
-                           esphome::event::Event *target_entity) {
-    // 1. Coalescing: Drop if an identical event is already in the queue.
-    for (uint8_t i = this->deferred_read_; i != this->deferred_write_;
-         i = (i + 1) % DEFERRED_QUEUE_SIZE) {
-      if (this->deferred_kind_[i] == DEFERRED_KIND_TEXT &&
-          this->deferred_queue_[i] == evt) {
-        return;
-      }
-    }
-
-    uint8_t next = (this->deferred_write_ + 1) % DEFERRED_QUEUE_SIZE;
-
-    // 2. Priority-aware Dropping (CFX-051)
-    // If we're hitting the limit (~80% full), and the new event is a high-priority 
-    // lifecycle event, we can safely drop an old non-critical milestone to make room.
-    if (next == this->deferred_read_) {
-      // Queue is hard-full. Preserve exact cfx_reach semantics by reclaiming
-      // only from other deferred text entries.
-      bool reclaimed = false;
-      for (uint8_t j = 0; j < DEFERRED_QUEUE_SIZE; j++) {
-        uint8_t idx = (this->deferred_read_ + j) % DEFERRED_QUEUE_SIZE;
-        if (idx == this->deferred_write_)
-          break;
-        if (this->deferred_kind_[idx] == DEFERRED_KIND_TEXT) {
-          this->deferred_queue_[idx] = evt;
-          this->deferred_targets_[idx] = target_entity;
-          reclaimed = true;
-          break;
+  // "<type>" or "<type>:<tag>" text form, for callers without ids. Resolves
+  // through the intern table, so keep it off the frame path.
+  void fire_event(const char *type) {
+    if (!this->ha_events_enabled_ || type == nullptr)
+      return;
+    const char *colon = std::strchr(type, ':');
+    const size_t name_len = colon != nullptr ? static_cast<size_t>(colon - type)
+                                             : std::strlen(type);
+    for (uint8_t t = 0; t < CFX_EVENT_TYPE_COUNT; t++) {
+      const char *name = CFX_EVENT_TYPE_NAMES[t];
+      if (std::strlen(name) != name_len || std::strncmp(name, type, name_len) != 0)
+        continue;
+      uint16_t tag_id = NO_TAG;
+      if (colon != nullptr) {
+        const char *tag = colon + 1;
+        const char *end = std::strchr(tag, ':');
+        tag_id = this->find_tag_(end != nullptr
+                                     ? std::string(tag, static_cast<size_t>(end - tag))
+                                     : std::string(tag));
+        if (tag_id == NO_TAG) {
+          ESP_LOGW("cfx_seq", "dropping event with unknown tag in '%s'", type);
+          return;
         }
       }
-      if (!reclaimed) {
-        ESP_LOGW("cfx_seq", "deferred queue full, dropping '%s'", evt.c_str());
-        return;
-      }
+      this->fire(static_cast<CFXEventType>(t), tag_id);
       return;
     }
-
-    this->deferred_kind_[this->deferred_write_] = DEFERRED_KIND_TEXT;
-    this->deferred_queue_[this->deferred_write_] = evt;
-    this->deferred_targets_[this->deferred_write_] = target_entity;
-    this->deferred_write_ = next;
+    ESP_LOGW("cfx_seq", "dropping unknown event type '%s'", type);
   }
 
-  void push_deferred_reach_(uint16_t tag_id, uint8_t milestone,
-                            esphome::event::Event *target_entity) {
-    for (uint8_t i = this->deferred_read_; i != this->deferred_write_;
-         i = (i + 1) % DEFERRED_QUEUE_SIZE) {
-      if (this->deferred_kind_[i] == DEFERRED_KIND_REACH &&
-          this->deferred_reach_tag_ids_[i] == tag_id &&
-          this->deferred_reach_milestones_[i] == milestone) {
-        return;
-      }
-    }
-
-    uint8_t next = (this->deferred_write_ + 1) % DEFERRED_QUEUE_SIZE;
-    if (next == this->deferred_read_) {
-      if (tag_id < this->strip_tags_.size()) {
-        ESP_LOGW("cfx_seq", "reach queue full, dropping cfx_reach:%s:%u",
-                 this->strip_tags_[tag_id].c_str(), (unsigned) milestone);
-      } else {
-        ESP_LOGW("cfx_seq", "reach queue full, dropping milestone %u",
-                 (unsigned) milestone);
-      }
+  void fire_reach_event(const std::string &tag, uint8_t milestone) {
+    if (!this->ha_events_enabled_ || tag.empty())
+      return;
+    const uint16_t tag_id = this->find_tag_(tag);
+    if (tag_id == NO_TAG) {
+      ESP_LOGW("cfx_seq", "dropping reach event with unknown tag '%s'",
+               tag.c_str());
       return;
     }
-
-    this->deferred_kind_[this->deferred_write_] = DEFERRED_KIND_REACH;
-    this->deferred_queue_[this->deferred_write_].clear();
-    this->deferred_targets_[this->deferred_write_] = target_entity;
-    this->deferred_reach_tag_ids_[this->deferred_write_] = tag_id;
-    this->deferred_reach_milestones_[this->deferred_write_] = milestone;
-    this->deferred_write_ = next;
+    this->fire_reach(tag_id, milestone);
   }
 
   // Drain queued events conservatively. This can be called by both sequence and
@@ -167,106 +154,122 @@ public:
     uint8_t flushed_this_loop = 0;
     while (this->deferred_read_ != this->deferred_write_ &&
            flushed_this_loop < MAX_EVENTS_PER_FLUSH) {
-      const uint8_t idx = this->deferred_read_;
-      const DeferredKind kind = this->deferred_kind_[idx];
-      std::string evt;
-      if (kind == DEFERRED_KIND_TEXT) {
-        evt.swap(this->deferred_queue_[idx]);
-      }
-      esphome::event::Event *target_entity = this->deferred_targets_[idx];
-      this->deferred_targets_[idx] = nullptr;
-      this->deferred_read_ = (idx + 1) % DEFERRED_QUEUE_SIZE;
+      const DeferredEvent record = this->deferred_[this->deferred_read_];
+      this->deferred_read_ = (this->deferred_read_ + 1) % DEFERRED_QUEUE_SIZE;
       flushed_this_loop++;
-
-      if (target_entity != nullptr) {
-        if (kind == DEFERRED_KIND_REACH) {
-          const uint16_t tag_id = this->deferred_reach_tag_ids_[idx];
-          const uint8_t milestone = this->deferred_reach_milestones_[idx];
-          if (tag_id < this->strip_tags_.size()) {
-            char reach_evt[48];
-            std::snprintf(reach_evt, sizeof(reach_evt), "cfx_reach:%s:%u",
-                          this->strip_tags_[tag_id].c_str(),
-                          (unsigned) milestone);
-            target_entity->trigger(reach_evt);
-          }
+      if (record.target == nullptr)
+        continue;
+
+      char evt[96];
+      const char *name = CFX_EVENT_TYPE_NAMES[record.type];
+      if (record.tag_id == NO_TAG) {
+        std::snprintf(evt, sizeof(evt), "%s", name);
+      } else if (record.tag_id < this->strip_tags_.size()) {
+        const char *tag = this->strip_tags_[record.tag_id].c_str();
+        if (record.type == CFX_EVENT_REACH) {
+          std::snprintf(evt, sizeof(evt), "%s:%s:%u", name, tag,
+                        (unsigned) record.milestone);
         } else {
-          target_entity->trigger(evt);
+          std::snprintf(evt, sizeof(evt), "%s:%s", name, tag);
         }
+      } else {
+        continue;
       }
+      record.target->trigger(evt);
     }
   }
 
-protected:
-  bool resolve_reach_target_(const std::string &tag,
-                             esphome::event::Event **target_entity,
-                             uint16_t *tag_id) {
-    if (!this->resolve_target_for_tag_(tag, target_entity)) {
-      return false;
+  // Queue plus tag tables, estimated: a map node is its pair and three tree
+  // pointers, and each tag's characters are counted in both tables.
+  size_t memory_bytes() const {
+    size_t bytes = sizeof(*this);
+    for (const auto &tag : this->strip_tags_) {
+      bytes += 2 * tag.capacity();
+      bytes += sizeof(std::pair<const std::string, uint16_t>) + 3 * sizeof(void *);
     }
+    bytes += this->strip_tags_.capacity() * sizeof(std::string);
+    bytes += this->strip_entities_by_id_.capacity() * sizeof(esphome::event::Event *);
+    bytes += this->tag_disabled_.capacity();
+    return bytes;
+  }
 
-    auto id_it = this->strip_tag_ids_.find(tag);
-    if (id_it == this->strip_tag_ids_.end()) {
-      ESP_LOGW("cfx_seq", "dropping reach event with unknown tag '%s'",
-               tag.c_str());
-      return false;
-    }
+protected:
+  struct DeferredEvent {
+    esphome::event::Event *target{nullptr};
+    uint16_t tag_id{NO_TAG};
+    uint8_t type{CFX_EVENT_START};
+    uint8_t milestone{0};
+  };
 
-    if (tag_id != nullptr) {
-      *tag_id = id_it->second;
-    }
-    return true;
+  uint16_t find_tag_(const std::string &tag) const {
+    auto it = this->strip_tag_ids_.find(tag);
+    return it != this->strip_tag_ids_.end() ? it->second : NO_TAG;
   }
 
-  bool resolve_target_for_tag_(const std::string &tag,
-                               esphome::event::Event **target_entity) {
-    if (std::find(this->disabled_tags_.begin(), this->disabled_tags_.end(), tag) !=
-        this->disabled_tags_.end()) {
+  bool resolve_target_(uint16_t tag_id, esphome::event::Event **target_entity) {
+    if (tag_id == NO_TAG)
+      return true;
+    if (tag_id >= this->strip_tags_.size() || this->tag_disabled_[tag_id])
+      return false;
+    if (this->strip_entities_by_id_[tag_id] == nullptr) {
+      ESP_LOGW("cfx_seq", "dropping event with unknown tag '%s'",
+               this->strip_tags_[tag_id].c_str());
       return false;
     }
+    *target_entity = this->strip_entities_by_id_[tag_id];
+    return true;
+  }
 
-    auto it = this->strip_entities_.find(tag);
-    if (it != this->strip_entities_.end() && it->second != nullptr) {
-      *target_entity = it->second;
-      return true;
+  // Exact duplicates already queued are dropped (CFX-034). On a full queue
+  // a lifecycle event takes over the oldest queued lifecycle slot, while
+  // cfx_reach is dropped to keep its exact milestone semantics (CFX-051).
+  void push_deferred_(CFXEventType type, uint16_t tag_id, uint8_t milestone,
+                      esphome::event::Event *target_entity) {
+    for (uint8_t i = this->deferred_read_; i != this->deferred_write_;
+         i = (i + 1) % DEFERRED_QUEUE_SIZE) {
+      const DeferredEvent &queued = this->deferred_[i];
+      if (queued.type == type && queued.tag_id == tag_id &&
+          queued.milestone == milestone) {
+        return;
+      }
     }
 
-    ESP_LOGW("cfx_seq", "dropping event with unknown tag '%s'", tag.c_str());
-    return false;
-  }
-
-  bool resolve_target_entity_(const std::string &evt,
-                              esphome::event::Event **target_entity) {
-    size_t first_colon = evt.find(':');
-    if (first_colon == std::string::npos) {
-      return true;
+    const uint8_t next = (this->deferred_write_ + 1) % DEFERRED_QUEUE_SIZE;
+    if (next == this->deferred_read_) {
+      if (type != CFX_EVENT_REACH) {
+        for (uint8_t i = this->deferred_read_; i != this->deferred_write_;
+             i = (i + 1) % DEFERRED_QUEUE_SIZE) {
+          if (this->deferred_[i].type != CFX_EVENT_REACH) {
+            this->deferred_[i] = {target_entity, tag_id,
+                                  static_cast<uint8_t>(type), milestone};
+            return;
+          }
+        }
+      }
+      ESP_LOGW("cfx_seq", "deferred queue full, dropping %s milestone %u",
+               CFX_EVENT_TYPE_NAMES[type], (unsigned) milestone);
+      return;
     }
 
-    size_t second_colon = evt.find(':', first_colon + 1);
-    std::string tag = (second_colon != std::string::npos)
-                          ? evt.substr(first_colon + 1,
-                                       second_colon - first_colon - 1)
-                          : evt.substr(first_colon + 1);
-    return this->resolve_target_for_tag_(tag, target_entity);
+    this->deferred_[this->deferred_write_] = {
+        target_entity, tag_id, static_cast<uint8_t>(type), milestone};
+    this->deferred_write_ = next;
   }
 
   CFXEventManager() = default;
   esphome::event::Event *event_entity_{nullptr};
-  std::map<std::string, esphome::event::Event *> strip_entities_;
+  // Registration-time only; the fire path indexes the vectors below.
   std::map<std::string, uint16_t> strip_tag_ids_;
   std::vector<std::string> strip_tags_;
   std::vector<esphome::event::Event *> strip_entities_by_id_;
+  std::vector<uint8_t> tag_disabled_;
   bool ha_events_enabled_{true};
-  std::vector<std::string> disabled_tags_;
 
   static constexpr uint8_t DEFERRED_QUEUE_SIZE = 128;
   static constexpr uint8_t MAX_EVENTS_PER_FLUSH = 1;
   static constexpr uint32_t EVENT_FLUSH_MIN_INTERVAL_MS = 12;
   uint32_t last_flush_ms_{0};
-  DeferredKind deferred_kind_[DEFERRED_QUEUE_SIZE]{};
-  std::string deferred_queue_[DEFERRED_QUEUE_SIZE];
-  esphome::event::Event *deferred_targets_[DEFERRED_QUEUE_SIZE]{};
-  uint16_t deferred_reach_tag_ids_[DEFERRED_QUEUE_SIZE]{};
-  uint8_t deferred_reach_milestones_[DEFERRED_QUEUE_SIZE]{};
+  DeferredEvent deferred_[DEFERRED_QUEUE_SIZE]{};
   uint8_t deferred_write_{0};
   uint8_t deferred_read_{0};
 };
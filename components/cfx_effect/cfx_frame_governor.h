@@ -0,0 +1,105 @@
+/*
+ * ChimeraFX — Content-aware frame rate governor
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * A runner with the governor enabled renders every Nth tick of the effect's
+ * update_interval instead of every tick, where N (the divisor) follows how
+ * much the committed frames actually change. Static fills and slow breaths
+ * settle at a fraction of the configured rate; any frame that changes a
+ * pixel by more than WAKE_DELTA drops the divisor back to 1 at once. Held
+ * ticks leave the previous frame on the light and skip the show, so they
+ * cost neither render time nor RMT/SPI bandwidth.
+ *
+ * The delta metric is the largest per-pixel change of a one-byte colour
+ * fingerprint between consecutive committed frames. Time-based effects
+ * absorb the longer frame delta; the divisor only grows while doubling it
+ * would keep every per-frame step within STEP_DELTA, so the slowed output
+ * still moves in steps too small to see. Modes that jump after a still phase
+ * (Blink, Strobe, Heartbeat) carry CFX_MODE_FULL_RATE and are not governed,
+ * since a held tick would delay the jump. So do modes that advance a phase,
+ * position or spawn chance by a fixed amount per call (Phased, BPM, Scanner,
+ * Sparkle...): every held tick would be a step lost, and at MAX_DIVISOR
+ * they would run eight times slower. The host bench's --governed run finds
+ * them (tests/host_bench).
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace cfx {
+
+class FrameGovernor {
+public:
+  static constexpr uint8_t MAX_DIVISOR = 8;
+  // Consecutive quiet frames before the divisor doubles.
+  static constexpr uint8_t QUIET_FRAMES = 8;
+  // Largest per-frame step (in fingerprint levels) the slowed output may take.
+  static constexpr uint8_t STEP_DELTA = 2;
+  // A step above this is real motion: return to the full rate immediately.
+  static constexpr uint8_t WAKE_DELTA = 24;
+
+  // Weighted so a hue rotation at constant brightness still changes it.
+  static uint8_t fingerprint(uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    return (uint8_t)(((uint16_t)r + 2u * g + 3u * b + 2u * w) >> 3);
+  }
+
+  bool enabled() const { return enabled_; }
+  void setEnabled(bool enabled) {
+    if (enabled_ != enabled) {
+      enabled_ = enabled;
+      wake();
+    }
+  }
+
+  // Called once per tick. False means hold the previous frame.
+  bool due() {
+    if (!enabled_ || divisor_ <= 1)
+      return true;
+    if (++held_ < divisor_)
+      return false;
+    held_ = 0;
+    return true;
+  }
+
+  // Back to the full rate, e.g. after a control or parameter change.
+  void wake() {
+    divisor_ = 1;
+    held_ = 0;
+    quiet_ = 0;
+  }
+
+  // Feeds the largest fingerprint change of the frame just committed.
+  void observe(uint8_t max_delta) {
+    if (max_delta > WAKE_DELTA) {
+      wake();
+      return;
+    }
+    if (max_delta > STEP_DELTA) {
+      // Steps became visible at this divisor; back off one octave.
+      if (divisor_ > 1)
+        divisor_ >>= 1;
+      quiet_ = 0;
+      return;
+    }
+    if (divisor_ >= MAX_DIVISOR || 2u * max_delta > STEP_DELTA) {
+      quiet_ = 0;
+      return;
+    }
+    if (++quiet_ >= QUIET_FRAMES) {
+      divisor_ <<= 1;
+      quiet_ = 0;
+    }
+  }
+
+  uint8_t divisor() const { return divisor_; }
+
+private:
+  bool enabled_{false};
+  uint8_t divisor_{1};
+  uint8_t held_{0};
+  uint8_t quiet_{0};
+};
+
+} // namespace cfx
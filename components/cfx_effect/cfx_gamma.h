@@ -0,0 +1,40 @@
+/*
+ * ChimeraFX — Gamma tables
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Effects shape their output through one 256-entry table per light gamma,
+ * lut[i] = (i / 255)^(3.5 / gamma) * 255. The tables are baked at build time:
+ * codegen emits one const table per distinct gamma_correct in the YAML (see
+ * gamma_tables() in cfx_effect/__init__.py) and hands the set over once from
+ * setup(). A runner only looks its gamma up and keeps the pointer, so there
+ * is no powf() at boot, no per-runner allocation and no limit on how many
+ * gammas coexist. The 2.8 default table is always available.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace chimera_fx {
+
+// Aggregate so codegen can emit it as a brace initializer.
+struct CFXGammaLut {
+  float gamma;
+  const uint8_t *lut;
+};
+
+static constexpr float CFX_DEFAULT_GAMMA = 2.8f;
+
+// Installs the baked tables. `tables` must outlive every runner (codegen
+// passes a static const array).
+void cfx_gamma_set_tables(const CFXGammaLut *tables, uint8_t count);
+
+// Table for `gamma`. A gamma that was not baked (set from a lambda at
+// runtime) gets the closest baked table, whose gamma is stored in `baked`.
+// Never returns null.
+const uint8_t *cfx_gamma_lut(float gamma, float *baked = nullptr);
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -0,0 +1,127 @@
+/*
+ * ChimeraFX — Segment layouts implementation
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ */
+
+#include "cfx_layout.h"
+
+namespace esphome {
+namespace chimera_fx {
+
+static constexpr uint16_t GAP_MARK = UINT16_MAX;
+
+static uint16_t lit_leds(const CFXLayout &layout, uint16_t leds) {
+  uint32_t dark = 0;
+  for (uint16_t g = 0; g < layout.gap_count; g++) {
+    const CFXLayoutGap &gap = layout.gaps[g];
+    if (gap.start < leds) {
+      const uint32_t end = (uint32_t)gap.start + gap.count;
+      dark += (end > leds ? leds : end) - gap.start;
+    }
+  }
+  return dark >= leds ? 0 : (uint16_t)(leds - dark);
+}
+
+CFXLayoutShape cfx_layout_shape(const CFXLayout &layout, uint16_t leds) {
+  if (layout.type == CFX_LAYOUT_MAP) {
+    const uint32_t cells = (uint32_t)layout.width * layout.height;
+    if (cells != 0 && cells == layout.map_len)
+      return {layout.map_len, layout.width, layout.height};
+    return {layout.map_len, layout.map_len, 1};
+  }
+
+  const uint16_t lit = lit_leds(layout, leds);
+  if (layout.type == CFX_LAYOUT_MATRIX) {
+    // Either side may be left for the segment length to decide.
+    uint16_t w = layout.width;
+    uint16_t h = layout.height;
+    if (w == 0 && h != 0)
+      w = lit / h;
+    else if (h == 0 && w != 0)
+      h = lit / w;
+    if (w != 0 && h != 0)
+      return {(uint16_t)(w * h), w, h};
+  } else if (layout.type == CFX_LAYOUT_FOLDED && layout.folds > 1) {
+    const uint16_t leg = lit / layout.folds;
+    return {leg, leg, 1};
+  }
+  return {lit, lit, 1};
+}
+
+// Logical pixel shown by the k-th lit LED, or blank past the layout's end.
+static uint16_t logical_index(const CFXLayout &layout,
+                              const CFXLayoutShape &shape, uint32_t k,
+                              uint16_t blank) {
+  const bool serpentine = (layout.flags & CFX_LAYOUT_SERPENTINE) != 0;
+  if (layout.type == CFX_LAYOUT_MATRIX && shape.height > 1) {
+    uint32_t x, y;
+    if (layout.flags & CFX_LAYOUT_VERTICAL) {
+      x = k / shape.height;
+      y = k % shape.height;
+      if (serpentine && (x & 1))
+        y = shape.height - 1 - y;
+    } else {
+      y = k / shape.width;
+      x = k % shape.width;
+      if (serpentine && (y & 1))
+        x = shape.width - 1 - x;
+    }
+    if (x >= shape.width || y >= shape.height)
+      return blank;
+    return (uint16_t)(y * shape.width + x);
+  }
+  if (layout.type == CFX_LAYOUT_FOLDED && layout.folds > 1 &&
+      shape.length > 0) {
+    // Each leg is folded back over the previous one.
+    const uint32_t leg = k / shape.length;
+    if (leg >= layout.folds)
+      return blank;
+    const uint32_t j = k % shape.length;
+    return (uint16_t)((leg & 1) ? shape.length - 1 - j : j);
+  }
+  return k < shape.length ? (uint16_t)k : blank;
+}
+
+CFXLayoutShape cfx_layout_build(const CFXLayout &layout, uint16_t leds,
+                                bool mirror, uint16_t *lut) {
+  const CFXLayoutShape shape = cfx_layout_shape(layout, leds);
+  const uint16_t blank = shape.length;
+
+  if (layout.type == CFX_LAYOUT_MAP) {
+    for (uint16_t p = 0; p < leds; p++)
+      lut[p] = blank;
+    for (uint16_t i = 0; i < layout.map_len; i++) {
+      if (layout.map[i] < leds)
+        lut[layout.map[i]] = i;
+    }
+  } else {
+    for (uint16_t p = 0; p < leds; p++)
+      lut[p] = 0;
+    for (uint16_t g = 0; g < layout.gap_count; g++) {
+      const CFXLayoutGap &gap = layout.gaps[g];
+      const uint32_t end = (uint32_t)gap.start + gap.count;
+      for (uint32_t p = gap.start; p < end && p < leds; p++)
+        lut[p] = GAP_MARK;
+    }
+    uint32_t k = 0;
+    for (uint16_t p = 0; p < leds; p++) {
+      lut[p] = lut[p] == GAP_MARK ? blank
+                                  : logical_index(layout, shape, k++, blank);
+    }
+  }
+
+  if (mirror && shape.width > 0) {
+    for (uint16_t p = 0; p < leds; p++) {
+      const uint16_t v = lut[p];
+      if (v == blank)
+        continue;
+      const uint16_t x = v % shape.width;
+      lut[p] = (uint16_t)(v - x + (shape.width - 1 - x));
+    }
+  }
+  return shape;
+}
+
+} // namespace chimera_fx
+} // namespace esphome
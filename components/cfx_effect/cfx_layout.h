@@ -0,0 +1,76 @@
+/*
+ * ChimeraFX — Segment layouts
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Effects draw into a logical buffer; a layout says which logical pixel each
+ * physical LED of a segment shows. Serpentine and column-wired matrices,
+ * strips folded back on themselves, unlit gaps and arbitrary coordinate maps
+ * are all compiled once per segment length into a gather table of one
+ * uint16_t per LED, so the commit pass is a plain pixels[lut[p]] loop with
+ * no per-pixel branching however the strip is wired. Gap LEDs point at the
+ * blank slot just past the logical pixels, which is always black.
+ *
+ * Codegen emits one const CFXLayout per distinct YAML `layout:` block (see
+ * layout_descriptor() in cfx_light/light.py) and hands the segments a
+ * pointer to it; the records live in flash.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace chimera_fx {
+
+enum CFXLayoutType : uint8_t {
+  CFX_LAYOUT_LINEAR = 0, // one row; only the gaps change anything
+  CFX_LAYOUT_MATRIX,     // width x height grid
+  CFX_LAYOUT_FOLDED,     // `folds` legs, each showing the same pixels
+  CFX_LAYOUT_MAP,        // explicit table, map[i] = LED of logical pixel i
+};
+
+enum CFXLayoutFlag : uint8_t {
+  CFX_LAYOUT_SERPENTINE = 1 << 0, // every other row (column) runs backwards
+  CFX_LAYOUT_VERTICAL = 1 << 1,   // wired column by column
+};
+
+// LEDs [start, start + count) of the segment that are not lit (corners,
+// cut-outs). Every other LED is numbered in order for the layout.
+struct CFXLayoutGap {
+  uint16_t start;
+  uint16_t count;
+};
+
+// Aggregate so codegen can emit it as a brace initializer; field order is
+// part of that contract.
+struct CFXLayout {
+  uint8_t type;  // CFXLayoutType
+  uint8_t flags; // CFXLayoutFlag bits
+  uint16_t width;
+  uint16_t height;
+  uint16_t folds;
+  const CFXLayoutGap *gaps;
+  uint16_t gap_count;
+  const uint16_t *map; // CFX_LAYOUT_MAP only; LEDs are segment-relative
+  uint16_t map_len;
+};
+
+// Logical grid a layout gives a segment of `leds` LEDs. height is 1 for
+// anything that is not two-dimensional.
+struct CFXLayoutShape {
+  uint16_t length;
+  uint16_t width;
+  uint16_t height;
+};
+
+CFXLayoutShape cfx_layout_shape(const CFXLayout &layout, uint16_t leds);
+
+// Fills lut[0..leds) with the logical pixel each LED shows, or shape.length
+// (the blank slot) for LEDs that show nothing. With mirror set the x axis of
+// the logical grid is reversed, which on a single row is the usual mirror.
+CFXLayoutShape cfx_layout_build(const CFXLayout &layout, uint16_t leds,
+                                bool mirror, uint16_t *lut);
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -0,0 +1,77 @@
+/*
+ * ChimeraFX — Logical view of a laid-out segment
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Intros and outros paint the light directly instead of going through the
+ * runner's frame buffer, indexing it by logical pixel. On a segment with a
+ * layout (fold, gap, reverse, serpentine, map) that index is not an LED, so
+ * they draw through this view instead: pixel k lands on the first LED that
+ * shows logical pixel k, and finish() copies it to the other LEDs sharing
+ * it and blanks the gaps, the same scatter commitFrame() does with the
+ * gather table.
+ */
+
+#pragma once
+
+#include "CFXRunner.h"
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/core/color.h"
+#include <cstdint>
+
+namespace esphome {
+namespace chimera_fx {
+
+class CFXLayoutView : public light::AddressableLight {
+public:
+  // `runner` must have a layout (layoutLut() != nullptr) and outlive the
+  // view. `target` is the light the runner commits to.
+  CFXLayoutView(light::AddressableLight &target, CFXRunner &runner)
+      : target_(target), lut_(runner.layoutLut()),
+        first_(runner.layoutFirst()), leds_(runner.layoutLeds()),
+        len_(runner._segment.length()) {
+    this->offset_ = (target.size() == this->leds_) ? 0 : runner._segment.start;
+  }
+
+  light::AddressableLight &target() { return this->target_; }
+  // First LED of the segment on target().
+  uint16_t offset() const { return this->offset_; }
+
+  int32_t size() const override { return this->len_; }
+  light::LightTraits get_traits() override { return this->target_.get_traits(); }
+  void write_state(light::LightState *state) override {}
+  void clear_effect_data() override {}
+
+  // Scatters the drawn pixels onto the remaining LEDs of the segment.
+  void finish() {
+    for (uint16_t p = 0; p < this->leds_; p++) {
+      const uint16_t k = this->lut_[p];
+      if (k >= this->len_ || this->first_[k] == UINT16_MAX)
+        this->target_[this->offset_ + p] = Color::BLACK;
+      else if (this->first_[k] != p)
+        this->target_[this->offset_ + p] =
+            this->target_[this->offset_ + this->first_[k]].get();
+    }
+  }
+
+protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    if (index >= 0 && index < this->len_ && this->first_[index] != UINT16_MAX)
+      return this->target_[this->offset_ + this->first_[index]];
+    // A logical pixel no LED shows: draw into a sink.
+    return light::ESPColorView(&this->sink_[0], &this->sink_[1],
+                               &this->sink_[2], &this->sink_[3],
+                               &this->sink_[4], &this->correction_);
+  }
+
+  light::AddressableLight &target_;
+  const uint16_t *lut_;
+  const uint16_t *first_;
+  uint16_t leds_;
+  uint16_t len_;
+  uint16_t offset_{0};
+  mutable uint8_t sink_[5]{};
+};
+
+} // namespace chimera_fx
+} // namespace esphome
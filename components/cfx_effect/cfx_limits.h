@@ -0,0 +1,22 @@
+/*
+ * ChimeraFX — Node-wide limits
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Codegen emits MAX_CFX_SEGMENTS from MAX_CFX_SEGMENTS in cfx_light/light.py,
+ * which also rejects configs over it; the default below only serves builds
+ * without codegen (host bench). Everything sized by segment count derives
+ * from it.
+ */
+
+#pragma once
+
+// Segment runners per node, whole strips counting as one: per light the
+// limit is also the CFXSegmentMask width (cfx_light.h).
+#ifndef MAX_CFX_SEGMENTS
+#define MAX_CFX_SEGMENTS 32
+#endif
+
+// One data arena per runner, plus one for each runner's outro overlapping
+// the next effect.
+#define CFX_DATA_ARENA_SLOTS (2 * MAX_CFX_SEGMENTS)
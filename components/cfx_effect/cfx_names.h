@@ -0,0 +1,116 @@
+/*
+ * ChimeraFX — Palette name table
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * One constexpr table maps palette select options to palette ids and back.
+ * Selects resolve their option through it once per state change
+ * (CFXPaletteCode); the frame path only reads the cached code.
+ */
+
+#pragma once
+
+#include "esphome/components/select/select.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace chimera_fx {
+
+struct CFXNameEntry {
+  uint8_t id;
+  const char *name;
+};
+
+// A palette code is a palette id, or one of the two values below.
+// "Default" is effect-specific and resolved by the effect; an unknown or
+// empty option keeps the historical 0.
+static constexpr uint8_t CFX_PALETTE_CODE_UNKNOWN = 0;
+static constexpr uint8_t CFX_PALETTE_CODE_DEFAULT = 0xFD;
+
+// First entry for an id is its display name ("Solid" before "None").
+inline constexpr CFXNameEntry CFX_PALETTE_NAMES[] = {
+    {1, "Aurora"},      {2, "Forest"},     {3, "Halloween"},
+    {4, "Rainbow"},     {5, "Fire"},       {6, "Sunset"},
+    {7, "Ice"},         {8, "Party"},      {9, "Twilight"},
+    {10, "Pastel"},     {11, "Ocean"},     {12, "HeatColors"},
+    {13, "Sakura"},     {14, "Rivendell"}, {15, "Cyberpunk"},
+    {16, "OrangeTeal"}, {17, "Christmas"}, {18, "RedBlue"},
+    {19, "Matrix"},     {20, "SunnyGold"}, {22, "Fairy"},
+    {254, "Smart Random"}, {255, "Solid"}, {255, "None"},
+};
+
+constexpr bool cfx_name_equals(const char *a, const char *b) {
+  if (a == nullptr || b == nullptr)
+    return false;
+  while (*a != '\0' && *a == *b) {
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+template<size_t N>
+constexpr int cfx_name_lookup(const CFXNameEntry (&table)[N], const char *name) {
+  for (size_t i = 0; i < N; i++) {
+    if (cfx_name_equals(table[i].name, name))
+      return table[i].id;
+  }
+  return -1;
+}
+
+template<size_t N>
+constexpr const char *cfx_name_of(const CFXNameEntry (&table)[N], uint8_t id,
+                                  const char *fallback) {
+  for (size_t i = 0; i < N; i++) {
+    if (table[i].id == id)
+      return table[i].name;
+  }
+  return fallback;
+}
+
+constexpr uint8_t cfx_palette_code(const char *name) {
+  if (cfx_name_equals(name, "Default"))
+    return CFX_PALETTE_CODE_DEFAULT;
+  const int id = cfx_name_lookup(CFX_PALETTE_NAMES, name);
+  return id < 0 ? CFX_PALETTE_CODE_UNKNOWN : static_cast<uint8_t>(id);
+}
+
+constexpr const char *cfx_palette_name(uint8_t id) {
+  return cfx_name_of(CFX_PALETTE_NAMES, id, "Default");
+}
+
+static_assert(cfx_palette_code("Fairy") == 22, "palette table out of order");
+static_assert(cfx_palette_code("Default") == CFX_PALETTE_CODE_DEFAULT,
+              "Default must stay effect-specific");
+static_assert(cfx_name_equals(cfx_palette_name(255), "Solid"),
+              "255 must display as Solid");
+
+// Cached palette code of one select, refreshed by its state callback. The
+// address must stay stable once bound: the callback captures it.
+class CFXPaletteCode {
+public:
+  void bind(select::Select *sel) {
+    if (sel == nullptr || sel == this->select_)
+      return;
+    this->select_ = sel;
+    this->refresh_();
+    sel->add_on_state_callback([this](size_t) { this->refresh_(); });
+  }
+
+  select::Select *get_select() const { return this->select_; }
+  uint8_t get() const { return this->code_; }
+
+protected:
+  void refresh_() {
+    this->code_ = this->select_->active_index().has_value()
+                      ? cfx_palette_code(this->select_->current_option().c_str())
+                      : CFX_PALETTE_CODE_UNKNOWN;
+  }
+
+  select::Select *select_{nullptr};
+  uint8_t code_{CFX_PALETTE_CODE_UNKNOWN};
+};
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -0,0 +1,170 @@
+/*
+ * ChimeraFX — Particle engine
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Fixed-point particles for the 1D physics effects. A ParticleSet lays its
+ * state out as parallel arrays over Segment::data: Q16.16 position and
+ * velocity (pixels, pixels per frame), a 16-bit life that doubles as heat
+ * or brightness, and an 8-bit palette index. Integration and cooling are
+ * batch passes with one add per particle and the dead ones masked out
+ * rather than branched around; bounds and rendering test each particle.
+ * Hundreds of particles on a long strip cost integer adds instead of
+ * single-precision float math. Effects keep their own floats only where
+ * they spawn (launch velocities), never in the per-particle loop.
+ *
+ * Q16.16 covers strips up to 32767 LEDs.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace cfx {
+
+using q16_16 = int32_t;
+
+constexpr q16_16 Q16_ONE = 1 << 16;
+
+constexpr q16_16 q16_from_int(int32_t v) { return v * Q16_ONE; }
+// Rounds to nearest: truncating would bias every gravity toward zero.
+inline q16_16 q16_from_float(float v) { return (q16_16)lrintf(v * 65536.0f); }
+// Floor, also for negative positions.
+constexpr int32_t q16_floor(q16_16 v) { return v >> 16; }
+
+inline uint8_t qadd8_sat(uint8_t a, uint8_t b) {
+  const unsigned s = (unsigned)a + b;
+  return s > 255 ? 255 : (uint8_t)s;
+}
+
+// Saturating per-channel add of two RGBW32 colors.
+inline uint32_t add_rgbw32(uint32_t a, uint32_t b) {
+  return ((uint32_t)qadd8_sat(a >> 24, b >> 24) << 24) |
+         ((uint32_t)qadd8_sat(a >> 16, b >> 16) << 16) |
+         ((uint32_t)qadd8_sat(a >> 8, b >> 8) << 8) |
+         qadd8_sat(a & 0xFF, b & 0xFF);
+}
+
+class ParticleSet {
+public:
+  q16_16 *pos{nullptr};
+  q16_16 *vel{nullptr};
+  uint16_t *life{nullptr}; // 0 = dead
+  uint8_t *hue{nullptr};
+  uint16_t capacity{0};
+
+  // Bytes needed for `capacity` particles, rounded so effect state can
+  // follow it at an aligned offset.
+  static constexpr size_t bytes(uint16_t capacity) {
+    return ((size_t)capacity * (2 * sizeof(q16_16) + sizeof(uint16_t) + 1) +
+            3) &
+           ~(size_t)3;
+  }
+
+  // Views `data` (at least bytes(capacity), 4-byte aligned) as a set. The
+  // arrays persist with the data, so a set is re-bound every frame.
+  static ParticleSet bind(uint8_t *data, uint16_t capacity) {
+    ParticleSet p;
+    p.capacity = capacity;
+    p.pos = reinterpret_cast<q16_16 *>(data);
+    p.vel = p.pos + capacity;
+    p.life = reinterpret_cast<uint16_t *>(p.vel + capacity);
+    p.hue = reinterpret_cast<uint8_t *>(p.life + capacity);
+    return p;
+  }
+
+  void clear() {
+    memset(pos, 0, bytes(capacity));
+  }
+
+  bool alive(uint16_t i) const { return life[i] != 0; }
+
+  void spawn(uint16_t i, q16_16 p, q16_16 v, uint16_t l, uint8_t h) {
+    pos[i] = p;
+    vel[i] = v;
+    life[i] = l;
+    hue[i] = h;
+  }
+
+  // pos += vel, then vel += gravity, for the live particles in
+  // [begin, end). Dead ones are masked so their state stays put.
+  void integrate(q16_16 gravity, uint16_t begin, uint16_t end) {
+    for (uint16_t i = begin; i < end; i++) {
+      const int32_t live = -(int32_t)(life[i] != 0);
+      pos[i] += vel[i] & live;
+      vel[i] += gravity & live;
+    }
+  }
+
+  // Time-stepped variant for velocities per second: vel += accel * dt, then
+  // pos += vel * dt, with `dt` in Q16.16 seconds. Dead ones are masked.
+  void step(q16_16 accel, q16_16 dt, uint16_t begin, uint16_t end) {
+    const q16_16 dv = (q16_16)(((int64_t)accel * dt) >> 16);
+    for (uint16_t i = begin; i < end; i++) {
+      const int32_t live = -(int32_t)(life[i] != 0);
+      vel[i] += dv & live;
+      pos[i] += (q16_16)(((int64_t)vel[i] * dt) >> 16) & live;
+    }
+  }
+
+  // life -= amount, saturating at 0 (dead).
+  void cool(uint16_t amount, uint16_t begin, uint16_t end) {
+    for (uint16_t i = begin; i < end; i++)
+      life[i] = life[i] > amount ? life[i] - amount : 0;
+  }
+
+  // Particles below `floor` die; with `restitution` (Q8, 256 = elastic) they
+  // are reflected off it instead, losing that share of their speed.
+  void floor_bounds(q16_16 floor, uint16_t restitution, uint16_t begin,
+                    uint16_t end) {
+    for (uint16_t i = begin; i < end; i++) {
+      if (life[i] == 0 || pos[i] >= floor)
+        continue;
+      if (restitution == 0) {
+        life[i] = 0;
+        continue;
+      }
+      pos[i] = floor + (floor - pos[i]);
+      vel[i] = (q16_16)(((int64_t)-vel[i] * restitution) >> 8);
+    }
+  }
+
+  // First dead slot in [begin, end), or `end` when all are live.
+  uint16_t find_free(uint16_t begin, uint16_t end) const {
+    for (uint16_t i = begin; i < end; i++)
+      if (life[i] == 0)
+        return i;
+    return end;
+  }
+
+  bool any_alive(uint16_t begin, uint16_t end) const {
+    for (uint16_t i = begin; i < end; i++)
+      if (life[i] != 0)
+        return true;
+    return false;
+  }
+
+  // Adds color(i) into pixels at each live particle of [begin, end) that
+  // lies on the strip. Returns the touched range in lo/hi (lo >= hi: none).
+  template <typename ColorFn>
+  void render_add(uint32_t *pixels, uint16_t len, uint16_t begin,
+                  uint16_t end, ColorFn color, int &lo, int &hi) const {
+    for (uint16_t i = begin; i < end; i++) {
+      if (life[i] == 0)
+        continue;
+      const int32_t px = q16_floor(pos[i]);
+      if (px < 0 || px >= (int32_t)len)
+        continue;
+      pixels[px] = add_rgbw32(pixels[px], color(i));
+      if (px < lo)
+        lo = px;
+      if (px + 1 > hi)
+        hi = px + 1;
+    }
+  }
+};
+
+} // namespace cfx
@@ -0,0 +1,270 @@
+/*
+ * ChimeraFX — CFXProfiler implementation
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ */
+
+#include "cfx_profiler.h"
+#include "CFXRunner.h"
+#include "cfx_compat.h"
+#include "esphome/core/log.h"
+#include <cinttypes>
+#include <cstdio>
+
+static const char *const TAG = "cfx_profiler";
+
+namespace esphome {
+namespace chimera_fx {
+
+// ── Histogram ────────────────────────────────────────────────────────────────
+
+uint8_t CFXProfileHistogram::bucket_for(uint32_t value) {
+  if (value < 4)
+    return (uint8_t)value;
+  const uint32_t msb = 31u - (uint32_t)__builtin_clz(value);
+  const uint32_t sub = (value >> (msb - 2)) & 3u;
+  const uint32_t bucket = 4u * (msb - 1) + sub;
+  return bucket >= BUCKETS ? (uint8_t)(BUCKETS - 1) : (uint8_t)bucket;
+}
+
+uint32_t CFXProfileHistogram::bucket_upper(uint8_t bucket) {
+  if (bucket < 4)
+    return bucket;
+  const uint32_t msb = bucket / 4u + 1u;
+  const uint32_t sub = bucket & 3u;
+  return ((5u + sub) << (msb - 2)) - 1u;
+}
+
+void CFXProfileHistogram::record(uint32_t value) {
+  uint16_t &bin = bins_[bucket_for(value)];
+  if (bin == UINT16_MAX) {
+    // Halve everything so recent samples keep moving the percentiles.
+    count_ = 0;
+    for (uint16_t &b : bins_) {
+      b >>= 1;
+      count_ += b;
+    }
+  }
+  bin++;
+  count_++;
+  if (count_ == 1 || value < min_)
+    min_ = value;
+  if (value > max_)
+    max_ = value;
+}
+
+void CFXProfileHistogram::reset() {
+  for (uint16_t &b : bins_)
+    b = 0;
+  count_ = 0;
+  min_ = 0;
+  max_ = 0;
+}
+
+uint32_t CFXProfileHistogram::percentile(float q) const {
+  if (count_ == 0)
+    return 0;
+  if (q < 0.0f)
+    q = 0.0f;
+  if (q > 1.0f)
+    q = 1.0f;
+  uint32_t target = (uint32_t)(q * (float)count_ + 0.5f);
+  if (target == 0)
+    target = 1;
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < BUCKETS; b++) {
+    seen += bins_[b];
+    if (seen >= target) {
+      const uint32_t upper = bucket_upper(b);
+      return upper < max_ ? upper : max_;
+    }
+  }
+  return max_;
+}
+
+uint32_t CFXProfileScope::now_us_() { return cfx_micros(); }
+
+// ── Singleton ────────────────────────────────────────────────────────────────
+
+CFXProfiler &CFXProfiler::get() {
+  static CFXProfiler inst;
+  return inst;
+}
+
+// ── Recording ────────────────────────────────────────────────────────────────
+
+CFXModeProfile *CFXProfiler::slot_for_(uint8_t mode, uint32_t now_ms) {
+  CFXModeProfile *victim = &modes_[0];
+  for (uint8_t i = 0; i < MODE_SLOTS; i++) {
+    CFXModeProfile &p = modes_[i];
+    if (p.used && p.mode == mode) {
+      last_slot_ = (int8_t)i;
+      return &p;
+    }
+    // Prefer a free slot, else evict the least recently rendered mode.
+    if (!victim->used)
+      continue;
+    if (!p.used || (int32_t)(p.last_seen_ms - victim->last_seen_ms) < 0)
+      victim = &p;
+  }
+  victim->ns_per_led.reset();
+  victim->mode = mode;
+  victim->used = true;
+  last_slot_ = (int8_t)(victim - modes_);
+  return victim;
+}
+
+void CFXProfiler::record_render(uint8_t mode, uint32_t us, uint16_t leds) {
+  if (!enabled_)
+    return;
+  const uint32_t now_ms = cfx_millis();
+  const uint32_t ns_per_led =
+      leds ? (uint32_t)(((uint64_t)us * 1000u) / leds) : 0;
+  portENTER_CRITICAL(&lock_);
+  CFXModeProfile *p = slot_for_(mode, now_ms);
+  p->last_leds = leds;
+  p->last_seen_ms = now_ms;
+  p->ns_per_led.record(ns_per_led);
+  stages_[CFX_STAGE_RENDER].record(us);
+  portEXIT_CRITICAL(&lock_);
+}
+
+void CFXProfiler::record_stage(CFXProfileStage stage, uint32_t us) {
+  if (!enabled_ || stage >= CFX_STAGE_COUNT)
+    return;
+  portENTER_CRITICAL(&lock_);
+  stages_[stage].record(us);
+  portEXIT_CRITICAL(&lock_);
+}
+
+void CFXProfiler::reset() {
+  portENTER_CRITICAL(&lock_);
+  for (CFXModeProfile &p : modes_)
+    p = CFXModeProfile{};
+  for (CFXProfileHistogram &h : stages_)
+    h.reset();
+  last_slot_ = -1;
+  portEXIT_CRITICAL(&lock_);
+}
+
+// ── Queries ──────────────────────────────────────────────────────────────────
+
+const CFXModeProfile *CFXProfiler::worst_mode() const {
+  const CFXModeProfile *worst = nullptr;
+  uint32_t worst_p99 = 0;
+  for (const CFXModeProfile &p : modes_) {
+    if (!p.used || p.ns_per_led.count() == 0)
+      continue;
+    const uint32_t p99 = p.ns_per_led.percentile(0.99f);
+    if (worst == nullptr || p99 > worst_p99) {
+      worst = &p;
+      worst_p99 = p99;
+    }
+  }
+  return worst;
+}
+
+const CFXModeProfile *CFXProfiler::last_mode() const {
+  return last_slot_ >= 0 ? &modes_[last_slot_] : nullptr;
+}
+
+const char *CFXProfiler::stage_name(CFXProfileStage stage) {
+  switch (stage) {
+  case CFX_STAGE_RENDER:
+    return "render";
+  case CFX_STAGE_INOUT:
+    return "intro/outro";
+  case CFX_STAGE_COORDINATOR:
+    return "coordinator";
+  case CFX_STAGE_COPY:
+    return "copy";
+  case CFX_STAGE_DMA_WAIT:
+    return "dma_wait";
+  default:
+    return "?";
+  }
+}
+
+void CFXProfiler::dump() const {
+  // Log from a snapshot so the critical section never spans ESP_LOG I/O.
+  CFXModeProfile modes[MODE_SLOTS];
+  CFXProfileHistogram stages[CFX_STAGE_COUNT];
+  portENTER_CRITICAL(&lock_);
+  for (uint8_t i = 0; i < MODE_SLOTS; i++)
+    modes[i] = modes_[i];
+  for (uint8_t i = 0; i < CFX_STAGE_COUNT; i++)
+    stages[i] = stages_[i];
+  portEXIT_CRITICAL(&lock_);
+
+  ESP_LOGI(TAG, "Render cost per mode (ns/LED):");
+  for (const CFXModeProfile &p : modes) {
+    if (!p.used)
+      continue;
+    const CFXProfileHistogram &h = p.ns_per_led;
+    ESP_LOGI(TAG,
+             "  %3u %-20s n=%" PRIu32 " p50=%" PRIu32 " p90=%" PRIu32
+             " p99=%" PRIu32 " max=%" PRIu32 " (%u LEDs)",
+             p.mode, getModeDescriptor(p.mode).name, h.count(),
+             h.percentile(0.50f), h.percentile(0.90f), h.percentile(0.99f),
+             h.max(), p.last_leds);
+  }
+  ESP_LOGI(TAG, "Stage cost (us):");
+  for (uint8_t s = 0; s < CFX_STAGE_COUNT; s++) {
+    const CFXProfileHistogram &h = stages[s];
+    ESP_LOGI(TAG,
+             "  %-12s n=%" PRIu32 " p50=%" PRIu32 " p99=%" PRIu32
+             " max=%" PRIu32,
+             stage_name((CFXProfileStage)s), h.count(), h.percentile(0.50f),
+             h.percentile(0.99f), h.max());
+  }
+}
+
+size_t CFXProfiler::summary(char *out, size_t len) const {
+  if (out == nullptr || len == 0)
+    return 0;
+  out[0] = '\0';
+
+  struct Entry {
+    uint8_t mode;
+    uint32_t p50;
+    uint32_t p99;
+  };
+  Entry entries[MODE_SLOTS];
+  uint8_t n = 0;
+  portENTER_CRITICAL(&lock_);
+  for (const CFXModeProfile &p : modes_) {
+    if (!p.used || p.ns_per_led.count() == 0)
+      continue;
+    entries[n++] = {p.mode, p.ns_per_led.percentile(0.50f),
+                    p.ns_per_led.percentile(0.99f)};
+  }
+  portEXIT_CRITICAL(&lock_);
+
+  // Costliest first (insertion sort: at most MODE_SLOTS entries).
+  for (uint8_t i = 1; i < n; i++) {
+    Entry e = entries[i];
+    int8_t j = (int8_t)(i - 1);
+    while (j >= 0 && entries[j].p99 < e.p99) {
+      entries[j + 1] = entries[j];
+      j--;
+    }
+    entries[j + 1] = e;
+  }
+
+  size_t pos = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    int w = snprintf(out + pos, len - pos, "%s%u %" PRIu32 "/%" PRIu32,
+                     i ? ", " : "", entries[i].mode, entries[i].p50,
+                     entries[i].p99);
+    if (w < 0 || (size_t)w >= len - pos) {
+      // Drop the partial entry rather than publish a truncated number.
+      out[pos] = '\0';
+      break;
+    }
+    pos += (size_t)w;
+  }
+  return pos;
+}
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -0,0 +1,131 @@
+/*
+ * ChimeraFX — CFXProfiler
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Render cost histograms for production sizing.
+ *
+ * Per mode ID: render time normalised per LED (ns/LED), so one histogram
+ * covers every strip length an effect runs on. Per stage: absolute µs for
+ * render, intro/outro, segment coordinator, buffer copy/encode and DMA wait.
+ *
+ * Histograms are log-linear (4 sub-buckets per power of two, ~25% worst-case
+ * resolution) with saturating 16-bit counts that halve on overflow, so old
+ * samples decay instead of pinning the percentiles. Percentiles report the
+ * bucket's upper bound — pessimistic by design.
+ *
+ * Recording is compiled in only with USE_CFX_PROFILER (set by the
+ * cfx_profiler component) and costs one branch when disabled at runtime.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+
+namespace esphome {
+namespace chimera_fx {
+
+enum CFXProfileStage : uint8_t {
+  CFX_STAGE_RENDER = 0,
+  CFX_STAGE_INOUT,
+  CFX_STAGE_COORDINATOR,
+  CFX_STAGE_COPY,
+  CFX_STAGE_DMA_WAIT,
+  CFX_STAGE_COUNT,
+};
+
+class CFXProfileHistogram {
+public:
+  static constexpr uint8_t BUCKETS = 80; // top bucket ends at ~2.1M
+
+  void record(uint32_t value);
+  void reset();
+  uint32_t count() const { return count_; }
+  uint32_t min() const { return count_ ? min_ : 0; }
+  uint32_t max() const { return max_; }
+  // q in [0, 1]. Returns 0 when empty.
+  uint32_t percentile(float q) const;
+
+  static uint8_t bucket_for(uint32_t value);
+  static uint32_t bucket_upper(uint8_t bucket);
+
+private:
+  uint16_t bins_[BUCKETS]{};
+  uint32_t count_{0};
+  uint32_t min_{0};
+  uint32_t max_{0};
+};
+
+struct CFXModeProfile {
+  uint8_t mode{0};
+  bool used{false};
+  uint16_t last_leds{0};
+  uint32_t last_seen_ms{0};
+  CFXProfileHistogram ns_per_led;
+};
+
+class CFXProfiler {
+public:
+  static constexpr uint8_t MODE_SLOTS = 16;
+
+  static CFXProfiler &get();
+
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+  bool enabled() const { return enabled_; }
+
+  // Called by CFXRunner::service() after the effect's render call.
+  void record_render(uint8_t mode, uint32_t us, uint16_t leds);
+  void record_stage(CFXProfileStage stage, uint32_t us);
+
+  void reset();
+  // Logs every tracked mode and stage at INFO level.
+  void dump() const;
+  // Compact "mode p50/p99 ns/LED" list of the costliest modes, for a
+  // text_sensor. Writes at most len bytes including the terminator.
+  size_t summary(char *out, size_t len) const;
+
+  // Mode with the highest p99 ns/LED among tracked modes; nullptr if none.
+  const CFXModeProfile *worst_mode() const;
+  const CFXModeProfile *last_mode() const;
+  const CFXProfileHistogram &stage(CFXProfileStage stage) const {
+    return stages_[stage];
+  }
+  static const char *stage_name(CFXProfileStage stage);
+
+private:
+  CFXProfiler() = default;
+
+  CFXModeProfile *slot_for_(uint8_t mode, uint32_t now_ms);
+
+  bool enabled_{false};
+  int8_t last_slot_{-1};
+  CFXModeProfile modes_[MODE_SLOTS];
+  CFXProfileHistogram stages_[CFX_STAGE_COUNT];
+  // Runners are serviced on both cores; keep histogram updates atomic.
+  mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+// Records the enclosing block's duration into a stage histogram.
+class CFXProfileScope {
+public:
+  explicit CFXProfileScope(CFXProfileStage stage)
+      : stage_(stage), start_us_(CFXProfiler::get().enabled() ? now_us_() : 0) {}
+  ~CFXProfileScope() {
+    CFXProfiler &p = CFXProfiler::get();
+    if (p.enabled())
+      p.record_stage(stage_, now_us_() - start_us_);
+  }
+  CFXProfileScope(const CFXProfileScope &) = delete;
+  CFXProfileScope &operator=(const CFXProfileScope &) = delete;
+
+private:
+  static uint32_t now_us_();
+  CFXProfileStage stage_;
+  uint32_t start_us_;
+};
+
+} // namespace chimera_fx
+} // namespace esphome
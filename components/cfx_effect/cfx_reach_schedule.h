@@ -0,0 +1,113 @@
+/*
+ * ChimeraFX — Positional trigger schedule
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * on_cfx_reach triggers are kept sorted by target position as they are
+ * registered, so the per-frame check walks a cursor instead of the whole
+ * list. The cursor is the index of the first target above the last position
+ * seen: a frame with no crossing costs one compare against the next target
+ * in its direction, and a frame that crosses several (a large step, a wrap,
+ * a reversal) fires exactly the ones it passed and moves on.
+ *
+ * The schedule itself is configuration and can be shared; the cursor is run
+ * state and lives with whoever tracks the last position.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace chimera_fx {
+
+template<typename TriggerT> class CFXReachSchedule {
+public:
+  struct Entry {
+    float target;
+    TriggerT *trigger;
+  };
+
+  // Stable: equal targets keep their registration order.
+  void add(TriggerT *trigger) {
+    const float target = trigger->get_target_position();
+    auto it = std::upper_bound(
+        this->entries_.begin(), this->entries_.end(), target,
+        [](float value, const Entry &entry) { return value < entry.target; });
+    this->entries_.insert(it, Entry{target, trigger});
+  }
+
+  bool empty() const { return this->entries_.empty(); }
+  size_t size() const { return this->entries_.size(); }
+  void release() { std::vector<Entry>().swap(this->entries_); }
+
+  // Moves `next` from position `last` (negative before the first sample of
+  // a pass) to `current` and calls fire(trigger) for every target crossed,
+  // in the order it was crossed. The wrap rules match the previous linear
+  // scan: a jump from above 80% to below 20% is a forward wrap, the reverse
+  // is a backward wrap, and a target sitting exactly on `last` already fired.
+  template<typename FireFn>
+  void advance(uint16_t &next, float last, float current, FireFn &&fire) const {
+    const uint16_t count = static_cast<uint16_t>(this->entries_.size());
+    if (next > count)
+      next = count;
+    if (count == 0)
+      return;
+    const Entry *e = this->entries_.data();
+
+    if (last < 0.0f) {
+      next = 0;
+      this->forward_(next, count, current, fire);
+    } else if (last > 0.8f && current < 0.2f) {
+      while (next < count)
+        fire(e[next++].trigger);
+      next = 0;
+      this->forward_(next, count, current, fire);
+    } else if (last < 0.2f && current > 0.8f) {
+      while (next > 0) {
+        --next;
+        if (e[next].target < last)
+          fire(e[next].trigger);
+      }
+      next = count;
+      this->backward_(next, 2.0f, current, fire);
+    } else if (current >= last) {
+      this->forward_(next, count, current, fire);
+    } else {
+      this->backward_(next, last, current, fire);
+    }
+  }
+
+protected:
+  template<typename FireFn>
+  void forward_(uint16_t &next, uint16_t count, float current,
+                FireFn &fire) const {
+    const Entry *e = this->entries_.data();
+    while (next < count && e[next].target <= current)
+      fire(e[next++].trigger);
+  }
+
+  // Targets exactly on `current` fire but stay below the cursor, so the
+  // next forward step does not take them again.
+  template<typename FireFn>
+  void backward_(uint16_t &next, float last, float current,
+                 FireFn &fire) const {
+    const Entry *e = this->entries_.data();
+    while (next > 0 && e[next - 1].target > current) {
+      --next;
+      if (e[next].target < last)
+        fire(e[next].trigger);
+    }
+    for (uint16_t i = next; i > 0 && e[i - 1].target == current; i--) {
+      if (e[i - 1].target < last)
+        fire(e[i - 1].trigger);
+    }
+  }
+
+  std::vector<Entry> entries_;
+};
+
+}  // namespace chimera_fx
+}  // namespace esphome
@@ -9,6 +9,9 @@
 #include "esphome/core/log.h"
 #include <algorithm>  // std::sort
 #include <cinttypes>
+#ifdef USE_CFX_TRACE
+#include "cfx_trace.h"
+#endif
 
 static const char *const TAG = "CFXScheduler";
 
@@ -57,6 +60,7 @@ void CFXScheduler::setup() {
     core0_task_ = nullptr;
   } else {
     ESP_LOGD(TAG, "Core 0 task created — dual-core LED dispatch enabled");
+    span_split_hook = &CFXScheduler::split_span_;
   }
 
 #else
@@ -74,6 +78,16 @@ void CFXScheduler::core0_task_fn(void *arg) {
     // Block until Core 1 signals the start of a new frame slice.
     // portMAX_DELAY: task sleeps with zero CPU cost between frames.
     ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const uint32_t slice_start_us = micros();
+
+    if (self->span_job_.kernel != nullptr) {
+      const SpanJob &job = self->span_job_;
+      InstanceGuard guard(job.ctx->runner);
+      job.kernel(*job.ctx, job.frame, job.begin, job.end);
+      self->core0_busy_.store(false, std::memory_order_release);
+      xSemaphoreGive(self->core0_done_);
+      continue;
+    }
 
     // Service Core 0's runner slice.
     // InstanceGuard sets instance_per_core[0] for each runner so all
@@ -87,14 +101,298 @@ void CFXScheduler::core0_task_fn(void *arg) {
     }
 
     // Signal Core 1 that this frame's slice is complete.
+    self->core0_busy_us_ = micros() - slice_start_us;
+    self->core0_busy_.store(false, std::memory_order_release);
     xSemaphoreGive(self->core0_done_);
   }
 
   // Never reached — task loops until the device reboots.
   vTaskDelete(nullptr);
 }
+
+// ── Span split ───────────────────────────────────────────────────────────────
+
+bool CFXScheduler::split_span_(const RenderContext &ctx, SpanKernelFn kernel,
+                               const void *frame, uint16_t split,
+                               uint16_t end) {
+  CFXScheduler &self = CFXScheduler::get();
+  // Only the main loop may hand work to Core 0, and only while no batch
+  // owns it. A runner already on Core 0 renders its span inline.
+  if (self.core0_reserved_ || self.force_sequential_ || split == 0 ||
+      xPortGetCoreID() == 0)
+    return false;
+
+  self.span_job_ = SpanJob{&ctx, kernel, frame, split, end};
+  self.core0_busy_.store(true, std::memory_order_release);
+  xTaskNotifyGive(self.core0_task_);
+  kernel(ctx, frame, 0, split);
+
+  // Core 0 renders into the caller's ctx, frame state and segment pixels, so
+  // the span is never abandoned: a late half only costs frame time.
+  constexpr uint32_t timeout_ms = (FRAMETIME + 12 > 25) ? (FRAMETIME + 12) : 25;
+  if (!self.wait_core0_(timeout_ms)) {
+    self.stats_.timeouts++;
+    ESP_LOGW(TAG, "Core 0 span over %" PRIu32 " ms — pixels %u..%u late",
+             timeout_ms, (unsigned)split, (unsigned)end);
+  }
+  self.span_job_.kernel = nullptr;
+  self.stats_.span_splits++;
+  return true;
+}
+
+bool CFXScheduler::wait_core0_(uint32_t timeout_ms) {
+  if (xSemaphoreTake(core0_done_, pdMS_TO_TICKS(timeout_ms)) == pdTRUE)
+    return true;
+  // Past the deadline: keep waiting. Returning now would hand the caller
+  // runners and pixels Core 0 is still writing, and its late give would
+  // pair with the next dispatch's take.
+  xSemaphoreTake(core0_done_, portMAX_DELAY);
+  return false;
+}
+
+// ── Placement ────────────────────────────────────────────────────────────────
+
+// A placement is kept while the cost gap between the cores stays within this
+// share of the total, and a fresh LPT split must close the gap by at least
+// as much again before runners move. Without the band, two runners of
+// similar cost swap cores every time their EWMAs cross.
+static constexpr uint32_t CFX_SCHED_KEEP_PCT = 15;
+
+static inline uint32_t sched_cost(const CFXRunner *r) {
+  // Unmeasured runners count as 1 µs so a cold batch alternates cores.
+  const uint32_t c = r->serviceCostUs();
+  return c > 0 ? c : 1;
+}
+
+static inline uint32_t sched_gap(uint32_t a, uint32_t b) {
+  return a > b ? a - b : b - a;
+}
+
+bool CFXScheduler::place_runners_(const std::vector<CFXRunner *> &runners,
+                                  uint32_t &cost_core0, uint32_t &cost_core1) {
+  core0_slice_.clear();
+  core1_slice_.clear();
+  cost_core0 = 0;
+  cost_core1 = 0;
+
+  // Sticky pass: every runner stays where it ran last frame.
+  bool unplaced = false;
+  for (auto *r : runners) {
+    if (r == nullptr)
+      continue;
+    if (r->sched_core_ == 0) {
+      core0_slice_.push_back(r);
+      cost_core0 += sched_cost(r);
+    } else if (r->sched_core_ == 1) {
+      core1_slice_.push_back(r);
+      cost_core1 += sched_cost(r);
+    } else {
+      unplaced = true;
+    }
+  }
+  // Newcomers go to the lighter core in list order; Core 1 takes ties
+  // because inline work has no wake-up latency.
+  if (unplaced) {
+    for (auto *r : runners) {
+      if (r == nullptr || r->sched_core_ <= 1)
+        continue;
+      if (cost_core1 <= cost_core0) {
+        r->sched_core_ = 1;
+        core1_slice_.push_back(r);
+        cost_core1 += sched_cost(r);
+      } else {
+        r->sched_core_ = 0;
+        core0_slice_.push_back(r);
+        cost_core0 += sched_cost(r);
+      }
+    }
+  }
+
+  const uint32_t total = cost_core0 + cost_core1;
+  const uint32_t gap = sched_gap(cost_core0, cost_core1);
+  const uint64_t keep_band = (uint64_t)total * CFX_SCHED_KEEP_PCT;
+  if ((uint64_t)gap * 100 <= keep_band)
+    return false;
+
+  // Longest Processing Time: heaviest first, each to the lighter core.
+  // Reuse scheduler-owned scratch to avoid heap churn in the hot path.
+  sorted_slice_.clear();
+  sorted_slice_.insert(sorted_slice_.end(), core1_slice_.begin(),
+                       core1_slice_.end());
+  sorted_slice_.insert(sorted_slice_.end(), core0_slice_.begin(),
+                       core0_slice_.end());
+  std::sort(sorted_slice_.begin(), sorted_slice_.end(),
+            [](const CFXRunner *a, const CFXRunner *b) {
+              return a->serviceCostUs() > b->serviceCostUs();
+            });
+  uint32_t lpt0 = 0, lpt1 = 0;
+  for (auto *r : sorted_slice_) {
+    if (lpt1 <= lpt0)
+      lpt1 += sched_cost(r);
+    else
+      lpt0 += sched_cost(r);
+  }
+  const uint32_t lpt_gap = sched_gap(lpt0, lpt1);
+  if (lpt_gap >= gap || (uint64_t)(gap - lpt_gap) * 100 <= keep_band)
+    return false;
+
+  core0_slice_.clear();
+  core1_slice_.clear();
+  cost_core0 = lpt0;
+  cost_core1 = lpt1;
+  lpt0 = lpt1 = 0;
+  bool moved = false;
+  for (auto *r : sorted_slice_) {
+    const uint8_t core = lpt1 <= lpt0 ? 1 : 0;
+    (core == 1 ? lpt1 : lpt0) += sched_cost(r);
+    (core == 1 ? core1_slice_ : core0_slice_).push_back(r);
+    moved |= r->sched_core_ != core;
+    r->sched_core_ = core;
+  }
+  return moved;
+}
+
+void CFXScheduler::note_batch_(uint32_t cost_core0, uint32_t cost_core1,
+                               uint32_t busy_core0, uint32_t busy_core1,
+                               bool moved, bool core0_ok) {
+  CFXSchedulerStats &st = stats_;
+  const bool first = st.batches == 0;
+  st.batches++;
+  if (moved)
+    st.rebalances++;
+  if (!core0_ok)
+    st.timeouts++;
+
+  // 1/8 EWMA, seeded by the first batch.
+  auto smooth = [first](uint32_t &avg, uint32_t sample) {
+    avg = first ? sample
+                : (uint32_t)((int32_t)avg + ((int32_t)sample - (int32_t)avg) / 8);
+  };
+  smooth(st.cost_core0_us, cost_core0);
+  smooth(st.cost_core1_us, cost_core1);
+  smooth(st.busy_core0_us, busy_core0);
+  smooth(st.busy_core1_us, busy_core1);
+
+  constexpr uint32_t budget_us = FRAMETIME * 1000;
+  auto pct = [](uint32_t num, uint32_t den) -> uint8_t {
+    if (den == 0)
+      return 0;
+    const uint32_t p = (uint32_t)(((uint64_t)num * 100) / den);
+    return p > 255 ? 255 : (uint8_t)p;
+  };
+  st.util_core0_pct = pct(st.busy_core0_us, budget_us);
+  st.util_core1_pct = pct(st.busy_core1_us, budget_us);
+  st.imbalance_pct = pct(sched_gap(st.busy_core0_us, st.busy_core1_us),
+                         std::max(st.busy_core0_us, st.busy_core1_us));
+}
 #endif
 
+// ── Frame budgets ────────────────────────────────────────────────────────────
+
+static constexpr uint8_t CFX_BUDGET_MAX_LEVEL = 2;
+// Relax one step once the load has stayed under this share of the budget
+// for CFX_BUDGET_RELAX_BATCHES, and only if the restored load stays under
+// CFX_BUDGET_RESTORE_PCT; the gap keeps a runner from flapping.
+static constexpr uint32_t CFX_BUDGET_RELAX_PCT = 70;
+static constexpr uint32_t CFX_BUDGET_RESTORE_PCT = 85;
+static constexpr uint16_t CFX_BUDGET_RELAX_BATCHES = 64;
+
+// Average per-tick cost of a runner at its level: level n renders every
+// 2^n ticks.
+static inline uint32_t budget_load(const CFXRunner *r) {
+  const uint32_t c = r->serviceCostUs() > 0 ? r->serviceCostUs() : 1;
+  return c >> r->budgetLevel();
+}
+
+uint16_t CFXScheduler::apply_budget_(std::vector<CFXRunner *> &slice,
+                                     uint32_t budget_us, uint32_t floor_cost) {
+  uint64_t load = 0;
+  for (auto *r : slice) {
+    if (r == nullptr)
+      continue;
+    load += budget_load(r);
+    r->budget_tick_++;
+    if (r->budget_calm_ < CFX_BUDGET_RELAX_BATCHES)
+      r->budget_calm_++;
+  }
+
+  if (load > budget_us) {
+    // Heaviest first: each step halves the runner that saves the most.
+    while (load > budget_us) {
+      CFXRunner *pick = nullptr;
+      for (auto *r : slice) {
+        if (r == nullptr || r->budget_level_ >= CFX_BUDGET_MAX_LEVEL ||
+            r->serviceCostUs() < floor_cost)
+          continue;
+        if (pick == nullptr || budget_load(r) > budget_load(pick))
+          pick = r;
+      }
+      if (pick == nullptr)
+        break;
+      load -= budget_load(pick);
+      pick->budget_level_++;
+      load += budget_load(pick);
+      pick->budget_calm_ = 0;
+    }
+  } else if (load * 100 < (uint64_t)budget_us * CFX_BUDGET_RELAX_PCT) {
+    // Lightest settled degraded runner first: it costs the least to restore.
+    CFXRunner *pick = nullptr;
+    for (auto *r : slice) {
+      if (r == nullptr || r->budget_level_ == 0 ||
+          r->budget_calm_ < CFX_BUDGET_RELAX_BATCHES)
+        continue;
+      if (pick == nullptr || r->serviceCostUs() < pick->serviceCostUs())
+        pick = r;
+    }
+    if (pick != nullptr) {
+      const uint32_t now_load = budget_load(pick);
+      pick->budget_level_--;
+      const uint64_t restored = load - now_load + budget_load(pick);
+      if (restored * 100 > (uint64_t)budget_us * CFX_BUDGET_RESTORE_PCT)
+        pick->budget_level_++;
+      else
+        pick->budget_calm_ = 0;
+    }
+  }
+
+  // Stagger the held ticks so degraded runners take turns rendering.
+  uint16_t degraded = 0;
+  for (auto *r : slice) {
+    if (r == nullptr)
+      continue;
+    if (r->budget_level_ == 0) {
+      r->budget_hold_ = false;
+      continue;
+    }
+    const uint32_t period = 1u << r->budget_level_;
+    r->budget_hold_ = ((r->budget_tick_ + degraded) & (period - 1)) != 0;
+    r->budget_degraded_frames_++;
+    stats_.degraded_frames++;
+    if (r->budget_degraded_frames_ > stats_.degraded_frames_worst)
+      stats_.degraded_frames_worst = r->budget_degraded_frames_;
+    degraded++;
+  }
+  return degraded;
+}
+
+// Budget for a batch serviced on one core: the tightest runner budget.
+void CFXScheduler::budget_batch_(std::vector<CFXRunner *> &runners) {
+  uint32_t budget_us = UINT32_MAX;
+  uint64_t total = 0;
+  size_t count = 0;
+  for (auto *r : runners) {
+    if (r == nullptr)
+      continue;
+    budget_us = std::min(budget_us, r->frameBudgetUs());
+    total += r->serviceCostUs();
+    count++;
+  }
+  if (count < 2)
+    return;
+  stats_.degraded = this->apply_budget_(runners, budget_us,
+                                        (uint32_t)(total / count));
+}
+
 // ── Dispatch ─────────────────────────────────────────────────────────────────
 
 bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
@@ -102,6 +400,9 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
   const size_t total = runners.size();
   if (total == 0) return true;
   const uint32_t dispatch_start_us = total >= 4 ? micros() : 0;
+#ifdef USE_CFX_TRACE
+  CFXTraceScope dispatch_trace(CFX_TRACE_DISPATCH, (uint16_t)total);
+#endif
 
   // Global override (diagnostic) takes precedence. Per-call flag (e.g. SPI
   // coordinator batch) runs the same sequential path without the warning —
@@ -115,12 +416,19 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
       sequential_diag_logged_ = true;
     }
 
+#if CFX_DUAL_CORE
+    this->core0_reserved_ = true;
+#endif
+    this->budget_batch_(runners);
     for (auto *r : runners) {
       if (r != nullptr) {
         InstanceGuard guard(r);
         r->service();
       }
     }
+#if CFX_DUAL_CORE
+    this->core0_reserved_ = false;
+#endif
 
     if (total >= 4) {
       const uint32_t now_ms = millis();
@@ -145,20 +453,13 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
   // Parallel path: requires ≥2 runners and a live Core 0 task.
   if (total >= 2 && core0_task_ != nullptr && core0_done_ != nullptr) {
 
-    // ── Cost-weighted greedy bin-packing split ────────────────────────────
-    // Instead of a naive midpoint split, distribute runners by measured frame
-    // cost (frame_time, in ms, updated every frame by CFXRunner::service()).
-    // Runners are sorted heaviest-first so the largest jobs are placed first,
-    // minimising imbalance. Each runner goes to whichever core has less
-    // accumulated cost so far — classic "Longest Processing Time" heuristic.
-    //
-    // On the very first frame frame_time is 0 for all runners, so the sort
-    // is a no-op and runners alternate cores in list order — equivalent to
-    // the old midpoint split, with no warm-up penalty.
-    //
-    // Core 1 is the calling core (ESPHome main loop). It receives the extra
-    // runner when counts are odd because there is no scheduling latency for
-    // inline work.
+    // ── Cost-weighted placement ───────────────────────────────────────────
+    // Runners are placed by their measured service cost (serviceCostUs(), an
+    // EWMA of render+commit µs) rather than frame_time, which is only the
+    // wall-clock delta between frames and looks the same for every runner.
+    // Placement is sticky: a runner stays on its core until the cost gap
+    // leaves the hysteresis band, then an LPT split re-places the batch
+    // heaviest-first (see place_runners_()).
 
     // Reuse scheduler-owned scratch vectors to avoid heap churn in the
     // per-frame hot path. Pointer copies only; runner ownership stays external.
@@ -169,24 +470,25 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
     if (core0_slice_.capacity() < total)
       core0_slice_.reserve(total);
 
-    sorted_slice_.clear();
-    sorted_slice_.insert(sorted_slice_.end(), runners.begin(), runners.end());
-    std::sort(sorted_slice_.begin(), sorted_slice_.end(), [](CFXRunner *a, CFXRunner *b) {
-      return a->frame_time > b->frame_time;
-    });
-
     uint32_t cost_core0 = 0, cost_core1 = 0;
-    core0_slice_.clear();
-    core1_slice_.clear();
-
-    for (auto *r : sorted_slice_) {
-      if (cost_core1 <= cost_core0) {
-        core1_slice_.push_back(r);
-        cost_core1 += r->frame_time;
-      } else {
-        core0_slice_.push_back(r);
-        cost_core0 += r->frame_time;
+    const bool moved = this->place_runners_(runners, cost_core0, cost_core1);
+
+    // ── Frame budgets ────────────────────────────────────────────────────
+    // Each core must finish its slice inside the tightest runner budget.
+    // An overrun degrades that core's heaviest runners instead of letting
+    // Core 0 miss the barrier and drop the frame for the whole slice.
+    {
+      uint32_t budget_us = UINT32_MAX;
+      for (auto *r : runners) {
+        if (r != nullptr)
+          budget_us = std::min(budget_us, r->frameBudgetUs());
       }
+      const uint32_t floor_cost =
+          (cost_core0 + cost_core1) /
+          (uint32_t)(core0_slice_.size() + core1_slice_.size());
+      stats_.degraded =
+          this->apply_budget_(core0_slice_, budget_us, floor_cost) +
+          this->apply_budget_(core1_slice_, budget_us, floor_cost);
     }
 
     // ── Dynamic semaphore timeout ─────────────────────────────────────────
@@ -202,28 +504,41 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
     // (core0_slice_ is already set above.)
 
     // Wake Core 0 — it will start processing core0_slice_ immediately.
+    this->core0_reserved_ = true;
+    this->core0_busy_.store(true, std::memory_order_release);
     xTaskNotifyGive(core0_task_);
 
     // Core 1 services its slice inline while Core 0 runs in parallel.
     // InstanceGuard sets instance_per_core[1] for each runner.
+    const uint32_t core1_start_us = micros();
     for (auto *r : core1_slice_) {
-      if (r != nullptr) {
-        InstanceGuard guard(r);
-        r->service();
-      }
+      InstanceGuard guard(r);
+      r->service();
     }
+    const uint32_t core1_busy_us = micros() - core1_start_us;
 
-    // Wait for Core 0 to finish before returning to apply().
-    // On timeout the strip retains its last valid pixel values —
-    // graceful degradation, no crash.
-    const bool core0_ok =
-        xSemaphoreTake(core0_done_, pdMS_TO_TICKS(CFX_CORE0_TIMEOUT_MS)) == pdTRUE;
+    // Wait for Core 0 to finish before returning to apply(). A slice that
+    // misses the deadline is still waited for (see wait_core0_()); the batch
+    // then reports the frame as late.
+#ifdef USE_CFX_TRACE
+    const uint32_t core0_wait_start_us = CFXTrace::now_us();
+#endif
+    const bool core0_ok = this->wait_core0_(CFX_CORE0_TIMEOUT_MS);
+#ifdef USE_CFX_TRACE
+    CFXTrace::get().span(CFX_TRACE_CORE0_WAIT, core0_wait_start_us,
+                         CFXTrace::now_us() - core0_wait_start_us,
+                         (uint16_t)core0_slice_.size());
+#endif
+    this->core0_reserved_ = false;
     if (!core0_ok) {
       ESP_LOGW(TAG,
-               "Core 0 runner timeout (%" PRIu32
-               " ms) — frame skipped for %u runners",
+               "Core 0 slice over %" PRIu32
+               " ms — frame late for %u runners",
                CFX_CORE0_TIMEOUT_MS, (unsigned)core0_slice_.size());
     }
+    this->note_batch_(cost_core0, cost_core1,
+                      core0_ok ? core0_busy_us_ : CFX_CORE0_TIMEOUT_MS * 1000,
+                      core1_busy_us, moved, core0_ok);
 
     if (total >= 4) {
       const uint32_t now_ms = millis();
@@ -233,7 +548,9 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
         ESP_LOGV(TAG,
                  "CFX sched_batch total=%u mode=dual force=0 global=%u "
                  "core1=%u core0=%u cost1=%u cost0=%u dispatch_us=%" PRIu32
-                 " ok=%u timeout_ms=%" PRIu32,
+                 " ok=%u timeout_ms=%" PRIu32
+                 " util1=%u%% util0=%u%% imb=%u%% rebal=%" PRIu32
+                 " degraded=%u",
                  static_cast<unsigned>(total),
                  static_cast<unsigned>(force_sequential_),
                  static_cast<unsigned>(core1_slice_.size()),
@@ -241,7 +558,11 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
                  static_cast<unsigned>(cost_core1),
                  static_cast<unsigned>(cost_core0),
                  micros() - dispatch_start_us, static_cast<unsigned>(core0_ok),
-                 CFX_CORE0_TIMEOUT_MS);
+                 CFX_CORE0_TIMEOUT_MS,
+                 static_cast<unsigned>(stats_.util_core1_pct),
+                 static_cast<unsigned>(stats_.util_core0_pct),
+                 static_cast<unsigned>(stats_.imbalance_pct),
+                 stats_.rebalances, static_cast<unsigned>(stats_.degraded));
       }
     }
 
@@ -251,6 +572,7 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
 #endif
 
   // Sequential fallthrough: single-core, only 1 runner, or dual-core task not live.
+  this->budget_batch_(runners);
   for (auto *r : runners) {
     if (r != nullptr) {
       InstanceGuard guard(r);
@@ -279,6 +601,9 @@ bool CFXScheduler::service_runners(std::vector<CFXRunner *> &runners,
 
 void CFXScheduler::service_runner(CFXRunner *r) {
   if (r == nullptr) return;
+  // Alone, a runner has nothing to yield its budget to.
+  r->budget_level_ = 0;
+  r->budget_hold_ = false;
   InstanceGuard guard(r);
   r->service();
 
@@ -286,11 +611,11 @@ void CFXScheduler::service_runner(CFXRunner *r) {
 
 void CFXScheduler::drain_core0() {
 #if CFX_DUAL_CORE
-  if (core0_task_ != nullptr && core0_done_ != nullptr) {
-    if (xSemaphoreTake(core0_done_, pdMS_TO_TICKS(FRAMETIME + 12)) == pdTRUE) {
-      xSemaphoreGive(core0_done_);
-    }
-  }
+  // Dispatch waits for its Core 0 job before returning, so this only has to
+  // cover a caller on another task. It never touches core0_done_, which
+  // belongs to the dispatch handshake.
+  while (core0_busy_.load(std::memory_order_acquire))
+    vTaskDelay(1);
 #endif
 }
 
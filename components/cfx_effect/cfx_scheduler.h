@@ -6,9 +6,12 @@
  * Dispatches CFXRunner::service() calls across FreeRTOS cores.
  *
  * Dual-core ESP32 / ESP32-S3:
- *   Splits the runner list at the midpoint. Core 0 handles the second half
- *   via a pinned FreeRTOS task; Core 1 (ESPHome main loop) handles the first
- *   half inline. A binary semaphore synchronises completion before DMA write.
+ *   Splits the runner list by measured service cost, with hysteresis so
+ *   runners stay on their core. Core 0 handles its slice via a pinned
+ *   FreeRTOS task; Core 1 (ESPHome main loop) handles the rest inline. A
+ *   binary semaphore synchronises completion before DMA write.
+ *   A runner serviced alone can also hand the upper half of a long strip's
+ *   pixel kernel to Core 0 (see renderSpans() in CFXRunner.cpp).
  *
  * Single-core ESP32 variants (C3, S2, H2):
  *   CONFIG_FREERTOS_UNICORE is defined by sdkconfig.
@@ -19,6 +22,7 @@
 #pragma once
 
 #include "CFXRunner.h"
+#include <atomic>
 #include <vector>
 
 // ── Dual-core detection ───────────────────────────────────────────────────────
@@ -36,6 +40,27 @@
 namespace esphome {
 namespace chimera_fx {
 
+// Dual-core placement telemetry, smoothed over recent parallel batches.
+// Costs are the runners' serviceCostUs() EWMAs; busy times are the measured
+// wall time of each core's slice. Utilisation is busy time against the
+// FRAMETIME budget and may exceed 100 when a core overruns the frame.
+struct CFXSchedulerStats {
+  uint32_t batches{0};    // parallel batches dispatched
+  uint32_t rebalances{0}; // batches that moved runners between cores
+  uint32_t timeouts{0};   // Core 0 slices that missed the barrier
+  uint32_t span_splits{0}; // single-runner frames rendered on both cores
+  uint16_t degraded{0};    // runners currently held to a reduced rate
+  uint32_t degraded_frames{0};  // runner frames budgeted degraded, all runners
+  uint32_t degraded_frames_worst{0}; // most any one runner has been degraded
+  uint32_t cost_core0_us{0};
+  uint32_t cost_core1_us{0};
+  uint32_t busy_core0_us{0};
+  uint32_t busy_core1_us{0};
+  uint8_t util_core0_pct{0};
+  uint8_t util_core1_pct{0};
+  uint8_t imbalance_pct{0}; // |busy1 - busy0| / max(busy1, busy0)
+};
+
 class CFXScheduler {
 public:
   // Singleton accessor — safe to call from any context.
@@ -50,8 +75,9 @@ public:
 
   // ── Primary dispatch entry points ────────────────────────────────────────
 
-  // Service a vector of runners. Returns false only when a parallel slice times
-  // out and the caller should suppress presentation of the partial frame.
+  // Service a vector of runners. Returns false when Core 0's slice missed the
+  // frame deadline; the frame is still complete (the slice is always waited
+  // for), only late.
   // Dual-core: splits list, Core 0 handles second half in parallel.
   // Single-core / 1 runner: sequential loop, no FreeRTOS overhead.
   //
@@ -78,15 +104,27 @@ public:
   }
   bool is_force_sequential() const { return force_sequential_; }
 
-  // Wait for Core 0 to finish its current frame slice before returning.
-  // Must be called from Core 1 before mutating segment_runners or deleting
-  // any CFXRunner that may still be referenced in core0_slice_.
+  // Wait until Core 0 is idle. Call before mutating segment_runners or
+  // deleting any CFXRunner that may still be referenced in core0_slice_.
   // No-op on single-core builds or when Core 0 task is not live.
   void drain_core0();
 
+  const CFXSchedulerStats &get_stats() const { return stats_; }
+
 private:
   CFXScheduler() = default;
 
+  CFXSchedulerStats stats_{};
+
+  // Frame budgets: degrades the heaviest runners of `slice` until its
+  // predicted cost fits budget_us, and relaxes them again once the load has
+  // stayed well under budget. Runners cheaper than floor_cost are never
+  // degraded, and a runner is only relaxed once its own level has held for
+  // CFX_BUDGET_RELAX_BATCHES batches. Returns the number of degraded runners in the slice.
+  uint16_t apply_budget_(std::vector<CFXRunner *> &slice, uint32_t budget_us,
+                         uint32_t floor_cost);
+  void budget_batch_(std::vector<CFXRunner *> &runners);
+
   bool setup_done_{false};
   bool force_sequential_{false};
   bool sequential_diag_logged_{false};
@@ -96,6 +134,21 @@ private:
 
 #if CFX_DUAL_CORE
   static void core0_task_fn(void *arg);
+  // span_split_hook target, see SpanSplitFn in CFXRunner.h.
+  static bool split_span_(const RenderContext &ctx, SpanKernelFn kernel,
+                          const void *frame, uint16_t split, uint16_t end);
+
+  // Places runners on core0_slice_ / core1_slice_. Returns true when the
+  // placement differs from the one the runners carried in.
+  bool place_runners_(const std::vector<CFXRunner *> &runners,
+                      uint32_t &cost_core0, uint32_t &cost_core1);
+  void note_batch_(uint32_t cost_core0, uint32_t cost_core1,
+                   uint32_t busy_core0, uint32_t busy_core1, bool moved,
+                   bool core0_ok);
+
+  // Blocks until Core 0 gives core0_done_. Returns false when that took
+  // longer than timeout_ms; it still waited for the job to end.
+  bool wait_core0_(uint32_t timeout_ms);
 
   TaskHandle_t      core0_task_{nullptr};
   SemaphoreHandle_t core0_done_{nullptr};
@@ -104,6 +157,25 @@ private:
   // Written by Core 1 (before xTaskNotifyGive), read by Core 0 task.
   // Protected by the notification/semaphore handshake — no mutex needed.
   std::vector<CFXRunner *> core0_slice_;
+  // Wall time of Core 0's last slice, written before core0_done_ is given.
+  uint32_t core0_busy_us_{0};
+  // True from dispatch until Core 0 has finished the job, cleared by the
+  // worker just before it gives core0_done_.
+  std::atomic<bool> core0_busy_{false};
+
+  // Half-frame job for Core 0; when kernel is set the task runs it instead
+  // of core0_slice_. Same handshake as the slice.
+  struct SpanJob {
+    const RenderContext *ctx{nullptr};
+    SpanKernelFn kernel{nullptr};
+    const void *frame{nullptr};
+    uint16_t begin{0};
+    uint16_t end{0};
+  };
+  SpanJob span_job_{};
+  // Set while a batch owns Core 0, or asked for sequential servicing, so a
+  // runner inside the batch does not split its span.
+  bool core0_reserved_{false};
 #endif
 };
 
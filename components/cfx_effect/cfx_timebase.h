@@ -0,0 +1,111 @@
+/*
+ * ChimeraFX — Runner timebase
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Integer-only time for effects that run for weeks. The runner timeline is
+ * kept in 64-bit microseconds and frame deltas are whole milliseconds taken
+ * from the same clock, so the deltas always sum to the elapsed time (a float
+ * accumulator stops resolving 1 ms after ~4.6 hours). Effects that integrate
+ * a speed-scaled position use Phase instead of multiplying the clock.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "cfx_compat.h"
+
+namespace cfx {
+
+class Timebase {
+public:
+  // Restarts the timeline at 0, anchored to the given clock reading.
+  void reset(uint64_t now_us) {
+    last_us_ = now_us;
+    elapsed_us_ = 0;
+    elapsed_ms_ = 0;
+  }
+
+  // Moves the timeline to now_us and returns the whole milliseconds crossed
+  // since the previous call. Deltas are counted on the clock's own
+  // millisecond boundaries, so they match cfx_millis() differences exactly.
+  uint32_t advance(uint64_t now_us) {
+    if (now_us < last_us_)
+      now_us = last_us_; // esp_timer is monotonic; guard stub clocks
+    const uint32_t delta_ms = (uint32_t)(now_us / 1000 - last_us_ / 1000);
+    elapsed_us_ += now_us - last_us_;
+    elapsed_ms_ += delta_ms;
+    last_us_ = now_us;
+    return delta_ms;
+  }
+
+  // Jumps the timeline to an absolute position, e.g. one derived from the
+  // sync group clock when an effect starts.
+  void seek(uint64_t elapsed_us) {
+    elapsed_us_ = elapsed_us;
+    elapsed_ms_ = elapsed_us / 1000;
+  }
+
+  // Pulls the timeline toward target_us. Errors up to step_us are slewed by
+  // at most max_slew_ms per call, so a running animation never visibly
+  // jumps; larger ones are seeked. Returns the whole milliseconds added
+  // (negative: removed) by slewing, 0 after a seek.
+  int32_t follow(uint64_t target_us, uint32_t step_us, uint32_t max_slew_ms) {
+    const int64_t error_us = (int64_t)(target_us - elapsed_us_);
+    if (error_us > (int64_t)step_us || error_us < -(int64_t)step_us) {
+      seek(target_us);
+      return 0;
+    }
+    int64_t slew_ms = error_us / 1000;
+    if (slew_ms > (int64_t)max_slew_ms)
+      slew_ms = max_slew_ms;
+    else if (slew_ms < -(int64_t)max_slew_ms)
+      slew_ms = -(int64_t)max_slew_ms;
+    if (slew_ms < 0) {
+      const uint64_t floor_ms =
+          elapsed_ms_ < elapsed_us_ / 1000 ? elapsed_ms_ : elapsed_us_ / 1000;
+      if ((uint64_t)(-slew_ms) > floor_ms)
+        slew_ms = -(int64_t)floor_ms;
+    }
+    elapsed_us_ += slew_ms * 1000;
+    elapsed_ms_ += slew_ms;
+    return (int32_t)slew_ms;
+  }
+
+  uint64_t elapsed_us() const { return elapsed_us_; }
+  uint64_t elapsed_ms() const { return elapsed_ms_; }
+  // Effect-facing 32-bit view; wraps after ~49 days, and effects only use
+  // it modularly.
+  uint32_t now_ms() const { return (uint32_t)elapsed_ms_; }
+
+private:
+  uint64_t last_us_{0};
+  uint64_t elapsed_us_{0};
+  uint64_t elapsed_ms_{0};
+};
+
+// Speed-scaled phase accumulator in 48.16 fixed point. Advancing by the frame
+// delta at the current rate means a speed change never jumps the pattern and
+// the fraction keeps 16 bits of resolution for the firmware lifetime.
+struct Phase {
+  uint64_t value{0};
+
+  void reset() { value = 0; }
+  void advance(uint32_t dt_ms, uint32_t rate_q16) {
+    value += (uint64_t)dt_ms * rate_q16;
+  }
+  // Phase modulo a period (also 16.16), for cyclic patterns.
+  uint32_t wrap(uint32_t period_q16) const {
+    return period_q16 != 0 ? (uint32_t)(value % period_q16) : 0;
+  }
+};
+
+// (t * mul) >> shift without the 32-bit product overflowing. The result
+// wraps modulo 2^32 like a counter instead of jumping back when t * mul
+// passes 2^32 (4.6 hours at t in ms and mul 255).
+inline uint32_t scale_time(uint32_t t, uint32_t mul, uint8_t shift) {
+  return (uint32_t)(((uint64_t)t * mul) >> shift);
+}
+
+} // namespace cfx
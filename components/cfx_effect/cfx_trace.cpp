@@ -0,0 +1,197 @@
+/*
+ * ChimeraFX — CFXTrace implementation
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ */
+
+#include "cfx_trace.h"
+#include "cfx_compat.h"
+#include "freertos/FreeRTOS.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace chimera_fx {
+
+static const char *const STAGE_NAMES[CFX_TRACE_STAGE_COUNT] = {
+    "dispatch",     "render",    "core0_wait", "coordinator",
+    "tx_prep",      "barrier",   "dma_start",  "dma_done",
+    "sync_tx",      "sync_rx",
+};
+
+CFXTrace &CFXTrace::get() {
+  static CFXTrace inst;
+  return inst;
+}
+
+const char *CFXTrace::stage_name(CFXTraceStage stage) {
+  return stage < CFX_TRACE_STAGE_COUNT ? STAGE_NAMES[stage] : "?";
+}
+
+uint32_t CFXTrace::now_us() { return cfx_micros(); }
+
+void CFXTrace::span(CFXTraceStage stage, uint32_t start_us, uint32_t dur_us,
+                    uint16_t arg) {
+  if (!enabled())
+    return;
+  const uint32_t idx = head_.fetch_add(1, std::memory_order_relaxed);
+  CFXTraceEvent &e = ring_[idx & (RING_SIZE - 1)];
+  // Unpublish first so a concurrent export skips the slot while it changes;
+  // the fence keeps the field stores below from moving ahead of it.
+  e.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  e.ts_us = start_us;
+  e.dur_us = dur_us;
+  e.arg = arg;
+  e.stage = (uint8_t)stage;
+  e.core = (uint8_t)xPortGetCoreID();
+  e.seq.store(idx + 1, std::memory_order_release);
+}
+
+void CFXTrace::reset() {
+  for (auto &e : ring_)
+    e.seq.store(0, std::memory_order_relaxed);
+  head_.store(0, std::memory_order_relaxed);
+}
+
+namespace {
+
+struct EventCopy {
+  uint32_t ts_us;
+  uint32_t dur_us;
+  uint16_t arg;
+  uint8_t stage;
+  uint8_t core;
+};
+
+// Copies event `idx` out of its slot. False once the slot holds another
+// event (or none), or a writer keeps rewriting it.
+bool read_event(const CFXTraceEvent &e, uint32_t idx, EventCopy &out) {
+  for (int attempt = 0; attempt < 3; attempt++) {
+    const uint32_t seq = e.seq.load(std::memory_order_acquire);
+    if (seq != idx + 1 && seq != 0)
+      return false; // overwritten by a newer event
+    if (seq == 0)
+      continue; // mid-write
+    out.ts_us = e.ts_us;
+    out.dur_us = e.dur_us;
+    out.arg = e.arg;
+    out.stage = e.stage;
+    out.core = e.core;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (e.seq.load(std::memory_order_relaxed) == seq)
+      return true;
+  }
+  return false;
+}
+
+// Buffers appended text and hands it to the sink a chunk at a time. One
+// event line is always emitted whole.
+struct ChunkWriter {
+  static constexpr size_t MAX_LINE = 192;
+
+  CFXTrace::Sink sink;
+  void *ctx;
+  size_t chunk;
+  char buf[1024];
+  size_t len{0};
+  bool ok{true};
+
+  ChunkWriter(CFXTrace::Sink s, void *c, size_t size)
+      : sink(s), ctx(c),
+        chunk(size < MAX_LINE ? MAX_LINE
+                              : (size > sizeof(buf) ? sizeof(buf) : size)) {}
+
+  void flush() {
+    if (len > 0 && ok)
+      ok = sink(buf, len, ctx);
+    len = 0;
+  }
+  void append(const char *text) {
+    if (!ok)
+      return;
+    const size_t n = std::strlen(text);
+    if (len + n > chunk)
+      flush();
+    std::memcpy(buf + len, text, n);
+    len += n;
+  }
+};
+
+} // namespace
+
+size_t CFXTrace::export_json(Sink sink, void *ctx, size_t chunk) {
+  if (sink == nullptr)
+    return 0;
+  const bool was_enabled = enabled_.exchange(false, std::memory_order_relaxed);
+
+  ChunkWriter out{sink, ctx, chunk};
+  char line[ChunkWriter::MAX_LINE];
+  std::snprintf(line, sizeof(line),
+                "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+                "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+                "\"args\":{\"name\":\"ChimeraFX\"}}");
+  out.append(line);
+  for (int core = 0; core < 2; core++) {
+    std::snprintf(line, sizeof(line),
+                  ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                  "\"tid\":%d,\"args\":{\"name\":\"Core %d\"}}",
+                  core, core);
+    out.append(line);
+  }
+
+  // Events land in completion order, so a span can start before the event
+  // ahead of it. Timestamps are made relative to the earliest start, taken
+  // as signed offsets so a micros() wrap inside the window stays monotonic.
+  const uint32_t head = head_.load(std::memory_order_acquire);
+  const uint32_t first = head > RING_SIZE ? head - RING_SIZE : 0;
+  bool have_ref = false;
+  uint32_t ref_us = 0;
+  int32_t earliest = 0;
+  EventCopy e;
+  for (uint32_t idx = first; idx != head; idx++) {
+    if (!read_event(ring_[idx & (RING_SIZE - 1)], idx, e))
+      continue;
+    if (!have_ref) {
+      ref_us = e.ts_us;
+      have_ref = true;
+    }
+    const int32_t offset = (int32_t)(e.ts_us - ref_us);
+    if (offset < earliest)
+      earliest = offset;
+  }
+
+  size_t written = 0;
+  for (uint32_t idx = first; have_ref && out.ok && idx != head; idx++) {
+    if (!read_event(ring_[idx & (RING_SIZE - 1)], idx, e))
+      continue;
+    // An event still mid-write during the first pass may start earlier.
+    const int32_t offset = (int32_t)(e.ts_us - ref_us) - earliest;
+    const uint32_t ts = offset > 0 ? (uint32_t)offset : 0;
+    const char *name = stage_name((CFXTraceStage)e.stage);
+    if (e.dur_us == 0) {
+      std::snprintf(line, sizeof(line),
+                    ",{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,"
+                    "\"tid\":%u,\"ts\":%" PRIu32 ",\"args\":{\"arg\":%u}}",
+                    name, (unsigned)e.core, ts, (unsigned)e.arg);
+    } else {
+      std::snprintf(line, sizeof(line),
+                    ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                    "\"ts\":%" PRIu32 ",\"dur\":%" PRIu32
+                    ",\"args\":{\"arg\":%u}}",
+                    name, (unsigned)e.core, ts, e.dur_us, (unsigned)e.arg);
+    }
+    out.append(line);
+    if (out.ok)
+      written++;
+  }
+  out.append("]}");
+  out.flush();
+
+  enabled_.store(was_enabled, std::memory_order_relaxed);
+  return written;
+}
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -0,0 +1,119 @@
+/*
+ * ChimeraFX — CFXTrace
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Frame pipeline timeline. The cadence logs (RMT, SPI, coordinator,
+ * sched_batch, frame diagnostics) each summarise one stage on their own
+ * clock; the trace records every stage of every frame into one ring with a
+ * common µs timestamp and the core it ran on, so the critical path of a bad
+ * frame can be read off a timeline.
+ *
+ * Writers claim a slot with one atomic increment and publish it by storing
+ * its sequence number last; the ring overwrites the oldest events and needs
+ * no lock on either core. The export reads a slot seqlock style: it copies
+ * the event, then checks the sequence number again and retries (or skips a
+ * slot a newer event has taken) if a writer got in between. export_json()
+ * writes the ring as Chrome trace
+ * JSON (chrome://tracing, ui.perfetto.dev): spans as complete events,
+ * zero-length ones (DMA start/done, sync TX/RX) as instants, one thread per
+ * core.
+ *
+ * Recording is compiled in only with USE_CFX_TRACE (set by cfx_profiler's
+ * `trace:` option) and costs one branch when disabled at runtime.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace chimera_fx {
+
+enum CFXTraceStage : uint8_t {
+  CFX_TRACE_DISPATCH = 0, // scheduler batch, arg = runner count
+  CFX_TRACE_RENDER,       // one runner's service(), arg = effect id
+  CFX_TRACE_CORE0_WAIT,   // Core 1 waiting for Core 0's slice
+  CFX_TRACE_COORDINATOR,  // segment epoch collect to flush, arg = pin
+  CFX_TRACE_TX_PREP,      // copy/encode into the transport, arg = pin
+  CFX_TRACE_BARRIER_WAIT, // first arrival to barrier fire, arg = outputs
+  CFX_TRACE_DMA_START,    // transmit handed to hardware, arg = pin
+  CFX_TRACE_DMA_DONE,     // wait for the previous transmit, arg = pin
+  CFX_TRACE_SYNC_TX,      // sync packet sent, arg = bytes
+  CFX_TRACE_SYNC_RX,      // sync packet accepted, arg = packet type
+  CFX_TRACE_STAGE_COUNT,
+};
+
+struct CFXTraceEvent {
+  std::atomic<uint32_t> seq{0}; // claim index + 1 once written, 0 = empty
+  uint32_t ts_us{0};
+  uint32_t dur_us{0};
+  uint16_t arg{0};
+  uint8_t stage{0};
+  uint8_t core{0};
+};
+
+class CFXTrace {
+public:
+  // 8 KB; ~1 s of a four-segment build at 60 FPS.
+  static constexpr uint16_t RING_SIZE = 512;
+  static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "ring size must be 2^n");
+
+  static CFXTrace &get();
+
+  void set_enabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // start_us is micros() at the beginning of the span.
+  void span(CFXTraceStage stage, uint32_t start_us, uint32_t dur_us,
+            uint16_t arg = 0);
+  void instant(CFXTraceStage stage, uint16_t arg = 0) {
+    if (enabled())
+      span(stage, now_us(), 0, arg);
+  }
+
+  void reset();
+  // Streams the ring, oldest first, as one Chrome trace JSON document in
+  // chunks of at most `chunk` bytes. Recording pauses for the duration. A
+  // sink returning false stops the export there. Returns the number of
+  // events written.
+  using Sink = bool (*)(const char *data, size_t len, void *ctx);
+  size_t export_json(Sink sink, void *ctx, size_t chunk = 512);
+
+  static const char *stage_name(CFXTraceStage stage);
+  static uint32_t now_us();
+
+private:
+  CFXTrace() = default;
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint32_t> head_{0};
+  CFXTraceEvent ring_[RING_SIZE];
+};
+
+// Records the enclosing block as a span.
+class CFXTraceScope {
+public:
+  explicit CFXTraceScope(CFXTraceStage stage, uint16_t arg = 0)
+      : stage_(stage), arg_(arg),
+        start_us_(CFXTrace::get().enabled() ? CFXTrace::now_us() : 0) {}
+  ~CFXTraceScope() {
+    CFXTrace &t = CFXTrace::get();
+    if (t.enabled())
+      t.span(stage_, start_us_, CFXTrace::now_us() - start_us_, arg_);
+  }
+  CFXTraceScope(const CFXTraceScope &) = delete;
+  CFXTraceScope &operator=(const CFXTraceScope &) = delete;
+
+private:
+  CFXTraceStage stage_;
+  uint16_t arg_;
+  uint32_t start_us_;
+};
+
+} // namespace chimera_fx
+} // namespace esphome
@@ -28,6 +28,7 @@
 #endif
 
 #include "cfx_compat.h"
+#include "cfx_timebase.h"
 #include "esphome/core/color.h"
 #include "esphome/core/log.h"
 
@@ -44,8 +45,60 @@ namespace cfx {
 // random() on Arduino framework) instead of the unseeded libc rand() which
 // always starts from seed=1 at boot and produces identical sequences every
 // power cycle.
+// Inside CFXRunner::service() they draw from the runner's RandomStream
+// instead: esp_random() busy-waits to pace its reads, which per-pixel callers
+// (dissolve, sparkle, twinkle, meteor) pay on every draw. The stream is
+// seeded once from the hardware RNG, so boots still differ.
 // ============================================================================
 
+// xoshiro128** — 128-bit state, period 2^128 - 1, cheap on a 32-bit core.
+class RandomStream {
+public:
+  // splitmix32 expansion, so any seed (including 0) gives a valid state.
+  void seed(uint32_t seed) {
+    for (uint32_t &word : s_) {
+      uint32_t z = (seed += 0x9E3779B9u);
+      z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+      z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+      word = z ^ (z >> 16);
+    }
+    if ((s_[0] | s_[1] | s_[2] | s_[3]) == 0)
+      s_[0] = 1;
+  }
+  bool seeded() const { return (s_[0] | s_[1] | s_[2] | s_[3]) != 0; }
+
+  uint32_t next() {
+    const uint32_t result = rotl(s_[1] * 5, 7) * 9;
+    const uint32_t t = s_[1] << 9;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = rotl(s_[3], 11);
+    return result;
+  }
+
+  // n random bytes, four per draw.
+  void fill(uint8_t *dst, size_t n) {
+    while (n >= 4) {
+      const uint32_t r = next();
+      memcpy(dst, &r, 4);
+      dst += 4;
+      n -= 4;
+    }
+    if (n > 0) {
+      const uint32_t r = next();
+      memcpy(dst, &r, n);
+    }
+  }
+
+private:
+  static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+  uint32_t s_[4]{0, 0, 0, 0};
+};
+
 namespace detail {
 // Returns a 32-bit hardware-entropy random word.
 // esp_random() is available in both Arduino and bare ESP-IDF builds for ESP32.
@@ -57,8 +110,28 @@ inline uint32_t hw_rand32() {
   return esp_random();
 #endif
 }
+
+// Stream of the runner being serviced on each core, set by InstanceGuard.
+// nullptr outside service(), where draws fall back to the hardware RNG.
+inline RandomStream *active_stream[2] = {nullptr, nullptr};
+
+inline uint32_t rand32() {
+  RandomStream *stream = active_stream[xPortGetCoreID()];
+  return stream != nullptr ? stream->next() : hw_rand32();
+}
 } // namespace detail
 
+// Fill n bytes from the active stream (or the hardware RNG).
+inline void random_fill(uint8_t *dst, size_t n) {
+  RandomStream *stream = detail::active_stream[xPortGetCoreID()];
+  if (stream != nullptr) {
+    stream->fill(dst, n);
+    return;
+  }
+  for (size_t i = 0; i < n; i++)
+    dst[i] = (uint8_t)detail::hw_rand32();
+}
+
 // Scale one byte by a second one, which is treated as the numerator of a
 // fraction whose denominator is 256.
 inline uint8_t scale8(uint8_t i, uint8_t scale) {
@@ -67,31 +140,31 @@ inline uint8_t scale8(uint8_t i, uint8_t scale) {
 
 // Random 16-bit value (0-65535)
 inline uint16_t hw_random16() {
-  return (uint16_t)(detail::hw_rand32() & 0xFFFF);
+  return (uint16_t)(detail::rand32() & 0xFFFF);
 }
 
 // Random 16-bit value in range [min, max)
 inline uint16_t hw_random16(uint16_t min, uint16_t max) {
   if (min >= max)
     return min;
-  return min + (uint16_t)(detail::hw_rand32() % (uint32_t)(max - min));
+  return min + (uint16_t)(detail::rand32() % (uint32_t)(max - min));
 }
 
 // Random 8-bit value (0-255)
-inline uint8_t hw_random8() { return (uint8_t)(detail::hw_rand32() & 0xFF); }
+inline uint8_t hw_random8() { return (uint8_t)(detail::rand32() & 0xFF); }
 
 // Random 8-bit value in range [0, max)
 inline uint8_t hw_random8(uint8_t max) {
   if (max == 0)
     return 0; // Safety: prevent div/0
-  return (uint8_t)(detail::hw_rand32() % (uint32_t)max);
+  return (uint8_t)(detail::rand32() % (uint32_t)max);
 }
 
 // Random 8-bit value in range [min, max)
 inline uint8_t hw_random8(uint8_t min, uint8_t max) {
   if (min >= max)
     return min;
-  return min + (uint8_t)(detail::hw_rand32() % (uint32_t)(max - min));
+  return min + (uint8_t)(detail::rand32() % (uint32_t)(max - min));
 }
 // CFX-005 FIX: sin8() now uses a 256-byte lookup table (identical to FastLED
 // sin8_C). The old sinf() call cost ~40-80 cycles on ESP32; the LUT costs a
@@ -212,15 +285,22 @@ hashToGradient(uint32_t h) {
   return (h & 0x03) - 2; // PERLIN_SHIFT 1 → closest to FastLED
 }
 
+// Lattice corner hash; depends only on the cell, not the sample position
+static inline __attribute__((always_inline)) uint32_t perlin_hash(uint32_t x0,
+                                                                  uint32_t y0) {
+  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D);
+  h ^= h >> 15;
+  h *= 0x92C3412B;
+  h ^= h >> 13;
+  return h;
+}
+
 // 2D gradient: dot product of gradient vector with distance vector
 static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0,
                                                                 int32_t dx,
                                                                 uint32_t y0,
                                                                 int32_t dy) {
-  uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D);
-  h ^= h >> 15;
-  h *= 0x92C3412B;
-  h ^= h >> 13;
+  uint32_t h = perlin_hash(x0, y0);
   return (hashToGradient(h) * dx + hashToGradient(h >> PERLIN_SHIFT) * dy) >>
          (1 + PERLIN_SHIFT);
 }
@@ -270,6 +350,60 @@ inline uint8_t inoise8(uint16_t x, uint16_t y) {
          8;
 }
 
+// Batched inoise8 along a line: out[i] = inoise8(x + i*dx, y + i*dy), with
+// the same uint16_t wrap-around. Adjacent samples usually share a lattice
+// cell, so corner hashes and gradients are derived once per cell; inside a
+// cell each corner's (unshifted) dot product just advances by a constant.
+// Bit-identical to calling inoise8() in a loop.
+inline void inoise8_line(uint8_t *out, uint16_t count, uint16_t x, uint16_t y,
+                         uint16_t dx, uint16_t dy) {
+  // Staying in a cell means the fraction moved by (int16_t)step, < 256.
+  const int32_t step_x = (int32_t)(int16_t)dx << 8;
+  const int32_t step_y = (int32_t)(int16_t)dy << 8;
+  int32_t cell_x = -1, cell_y = -1;
+  int32_t dot[4] = {0, 0, 0, 0}; // corners 00, 10, 01, 11
+  int32_t inc[4] = {0, 0, 0, 0};
+  for (uint16_t i = 0; i < count; i++) {
+    // Same coordinates as perlin2D_raw((uint32_t)x << 8, (uint32_t)y << 8)
+    const int32_t x0 = x >> 8;
+    const int32_t y0 = y >> 8;
+    const int32_t dx0 = (x & 0xFF) << 8;
+    const int32_t dy0 = (y & 0xFF) << 8;
+    const int32_t dx1 = dx0 - 0x10000;
+    const int32_t dy1 = dy0 - 0x10000;
+    if (x0 != cell_x || y0 != cell_y) {
+      const int32_t x1 = (x0 + 1) & 0xFF;
+      const int32_t y1 = (y0 + 1) & 0xFF;
+      const uint32_t h[4] = {perlin_hash(x0, y0), perlin_hash(x1, y0),
+                             perlin_hash(x0, y1), perlin_hash(x1, y1)};
+      const int32_t ox[4] = {dx0, dx1, dx0, dx1};
+      const int32_t oy[4] = {dy0, dy0, dy1, dy1};
+      for (int c = 0; c < 4; c++) {
+        const int32_t gx = hashToGradient(h[c]);
+        const int32_t gy = hashToGradient(h[c] >> PERLIN_SHIFT);
+        dot[c] = gx * ox[c] + gy * oy[c];
+        inc[c] = gx * step_x + gy * step_y;
+      }
+      cell_x = x0;
+      cell_y = y0;
+    }
+
+    const uint32_t tx = perlin_smoothstep(dx0);
+    const uint32_t ty = perlin_smoothstep(dy0);
+    const int32_t nx0 = perlin_lerp(dot[0] >> (1 + PERLIN_SHIFT),
+                                    dot[1] >> (1 + PERLIN_SHIFT), tx);
+    const int32_t nx1 = perlin_lerp(dot[2] >> (1 + PERLIN_SHIFT),
+                                    dot[3] >> (1 + PERLIN_SHIFT), tx);
+    const int32_t raw = perlin_lerp(nx0, nx1, ty);
+    out[i] = (((raw * 1620) >> 10) + 32771) >> 8;
+
+    for (int c = 0; c < 4; c++)
+      dot[c] += inc[c];
+    x += dx;
+    y += dy;
+  }
+}
+
 // inoise16(x,y): 16-bit version of the Perlin noise, returns 0-65535
 inline uint16_t inoise16(uint16_t x, uint16_t y) {
   return (
@@ -282,29 +416,47 @@ inline uint16_t inoise16(uint16_t x, uint16_t y) {
 // COLOR MATH
 // ============================================================================
 
+// Packed RGBW32 kernels (SWAR): each 32-bit word is split into its even and
+// odd byte lanes (0x00FF00FF masks) so one multiply handles two channels.
+// Every lane product stays below 2^16, so the results are bit-identical to
+// the per-channel (c * k) >> 8 forms they replace. Xtensa has a single-cycle
+// 32-bit MUL on every ESP32 target, so this is the fast path on all of them.
+static constexpr uint32_t RGBW32_EVEN = 0x00FF00FFu;
+
+// (ch * scale) >> 8 on all four channels.
+inline uint32_t scale_rgbw32(uint32_t c, uint8_t scale) {
+  const uint32_t even = ((c & RGBW32_EVEN) * scale) >> 8;
+  const uint32_t odd = ((c >> 8) & RGBW32_EVEN) * scale;
+  return (even & RGBW32_EVEN) | (odd & ~RGBW32_EVEN);
+}
+
+// max(ch - sub, 0) on all four channels. A guard bit above each 8-bit lane
+// survives the subtraction only when the lane did not borrow.
+inline uint32_t qsub_rgbw32(uint32_t c, uint8_t sub) {
+  const uint32_t k = (uint32_t)sub * 0x00010001u;
+  const uint32_t even = ((c & RGBW32_EVEN) | 0x01000100u) - k;
+  const uint32_t odd = (((c >> 8) & RGBW32_EVEN) | 0x01000100u) - k;
+  const uint32_t even_keep = ((even >> 8) & 0x00010001u) * 0xFFu;
+  const uint32_t odd_keep = ((odd >> 8) & 0x00010001u) * 0xFFu;
+  return (even & even_keep) | ((odd & odd_keep) << 8);
+}
+
+// (a * wa + b * wb) >> 8 on all four channels; wa + wb must not exceed 256.
+inline uint32_t mix_rgbw32(uint32_t a, uint8_t wa, uint32_t b, uint8_t wb) {
+  const uint32_t even =
+      ((a & RGBW32_EVEN) * wa + (b & RGBW32_EVEN) * wb) >> 8;
+  const uint32_t odd =
+      ((a >> 8) & RGBW32_EVEN) * wa + ((b >> 8) & RGBW32_EVEN) * wb;
+  return (even & RGBW32_EVEN) | (odd & ~RGBW32_EVEN);
+}
+
 // Blend two 32-bit RGBW colors (0=color1, 255=color2)
 inline uint32_t color_blend(uint32_t color1, uint32_t color2, uint8_t blend) {
   if (blend == 0)
     return color1;
   if (blend == 255)
     return color2;
-
-  uint8_t r1 = (color1 >> 16) & 0xFF;
-  uint8_t g1 = (color1 >> 8) & 0xFF;
-  uint8_t b1 = color1 & 0xFF;
-  uint8_t w1 = (color1 >> 24) & 0xFF;
-
-  uint8_t r2 = (color2 >> 16) & 0xFF;
-  uint8_t g2 = (color2 >> 8) & 0xFF;
-  uint8_t b2 = color2 & 0xFF;
-  uint8_t w2 = (color2 >> 24) & 0xFF;
-
-  uint8_t r3 = ((uint16_t)r1 * (255 - blend) + (uint16_t)r2 * blend) >> 8;
-  uint8_t g3 = ((uint16_t)g1 * (255 - blend) + (uint16_t)g2 * blend) >> 8;
-  uint8_t b3 = ((uint16_t)b1 * (255 - blend) + (uint16_t)b2 * blend) >> 8;
-  uint8_t w3 = ((uint16_t)w1 * (255 - blend) + (uint16_t)w2 * blend) >> 8;
-
-  return ((uint32_t)w3 << 24) | ((uint32_t)r3 << 16) | ((uint32_t)g3 << 8) | b3;
+  return mix_rgbw32(color1, 255 - blend, color2, blend);
 }
 
 // Get random wheel index avoiding previous value (for smooth color
@@ -717,8 +869,9 @@ inline FrameTiming calculate_frame_timing(uint8_t speed,
 
   // WLED exact deltat formula - speed-scaled monotonic time for position/beat
   // functions. uint32_t wrapping is safe: callers use modular arithmetic
-  // (& 0xFFFF, triwave16, etc.) so only lower bits matter.
-  uint32_t scaled_now = (real_now >> 2) + ((real_now * (uint32_t)speed) >> 7);
+  // (& 0xFFFF, triwave16, etc.) so only lower bits matter. The product is
+  // widened so it wraps smoothly instead of jumping after ~4.6 hours.
+  uint32_t scaled_now = (real_now >> 2) + scale_time(real_now, speed, 7);
 
   // WLED speed scaling: 128 ESPHome -> 83 WLED internal
   // Bit-shift approximation: *83/128 ≈ *83>>7, *172/127 ≈ *173>>7
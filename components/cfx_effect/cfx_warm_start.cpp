@@ -0,0 +1,101 @@
+/*
+ * ChimeraFX — Warm-start runner staging implementation
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ */
+
+#include "cfx_warm_start.h"
+#include "CFXRunner.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace chimera_fx {
+
+CFXWarmStart &CFXWarmStart::get() {
+  static CFXWarmStart inst;
+  return inst;
+}
+
+void CFXWarmStart::free_(Slot &slot) {
+  for (auto *r : slot.runners)
+    delete r;
+  slot.runners.clear();
+  slot.owner = nullptr;
+  slot.segmented = false;
+}
+
+void CFXWarmStart::expire_(uint32_t now) {
+  for (Slot &slot : slots_) {
+    if (slot.owner != nullptr && now - slot.staged_ms > STALE_MS)
+      free_(slot);
+  }
+}
+
+void CFXWarmStart::stage(const void *owner, std::vector<CFXRunner *> &runners,
+                         bool segmented) {
+  const uint32_t now = millis();
+  expire_(now);
+  if (owner == nullptr || runners.empty())
+    return;
+
+  Slot *target = nullptr;
+  for (Slot &slot : slots_) {
+    if (slot.owner == owner) {
+      free_(slot);
+      target = &slot;
+      break;
+    }
+  }
+  if (target == nullptr) {
+    for (Slot &slot : slots_) {
+      if (slot.owner == nullptr) {
+        target = &slot;
+        break;
+      }
+      if (target == nullptr ||
+          now - slot.staged_ms > now - target->staged_ms)
+        target = &slot;
+    }
+    if (target->owner != nullptr)
+      free_(*target);
+  }
+
+  target->owner = owner;
+  target->runners.swap(runners);
+  target->segmented = segmented;
+  target->staged_ms = now;
+}
+
+bool CFXWarmStart::take(const void *owner, std::vector<CFXRunner *> &runners,
+                        bool &segmented) {
+  expire_(millis());
+  for (Slot &slot : slots_) {
+    if (slot.owner != owner || owner == nullptr)
+      continue;
+    runners.swap(slot.runners);
+    segmented = slot.segmented;
+    slot.runners.clear();
+    slot.owner = nullptr;
+    slot.segmented = false;
+    return !runners.empty();
+  }
+  return false;
+}
+
+void CFXWarmStart::discard(const void *owner) {
+  for (Slot &slot : slots_) {
+    if (slot.owner == owner && owner != nullptr)
+      free_(slot);
+  }
+}
+
+bool CFXWarmStart::has_staged(const void *owner) const {
+  for (const Slot &slot : slots_) {
+    if (slot.owner == owner && owner != nullptr)
+      return true;
+  }
+  return false;
+}
+
+} // namespace chimera_fx
+} // namespace esphome
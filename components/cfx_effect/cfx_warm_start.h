@@ -0,0 +1,66 @@
+/*
+ * ChimeraFX — Warm-start runner staging
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * An effect switch used to build its runners inside start() and leave the
+ * arena claim and frame buffer allocation to the first frame, all in the
+ * loop pass that also stops the previous effect. A sequence knows which
+ * effect each of its lights switches to before it issues the light calls,
+ * so each light's stagger slot stages that effect's runners first
+ * (constructed, gamma set, frame buffer allocated) and the effect's start()
+ * adopts them a loop pass later. The data arena is still claimed on the
+ * first frame, once the outgoing effect has released its slot.
+ *
+ * Staged runners belong to the pool until they are taken. A set that is
+ * not taken within STALE_MS, or that is replaced by a newer one for the
+ * same effect, is deleted. The pool only runs on the main loop.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace chimera_fx {
+
+class CFXRunner;
+
+class CFXWarmStart {
+public:
+  // One set per light a sequence switches at once.
+  static constexpr uint8_t POOL_SIZE = 8;
+  static constexpr uint32_t STALE_MS = 2000;
+
+  static CFXWarmStart &get();
+
+  // Takes ownership of `runners` (left empty). Evicts the oldest set when
+  // every slot is taken.
+  void stage(const void *owner, std::vector<CFXRunner *> &runners,
+             bool segmented);
+  // Moves the staged set for `owner` into `runners` (expected empty).
+  // False when nothing fresh is staged for it.
+  bool take(const void *owner, std::vector<CFXRunner *> &runners,
+            bool &segmented);
+  void discard(const void *owner);
+
+  bool has_staged(const void *owner) const;
+
+private:
+  struct Slot {
+    const void *owner{nullptr};
+    std::vector<CFXRunner *> runners;
+    bool segmented{false};
+    uint32_t staged_ms{0};
+  };
+
+  CFXWarmStart() = default;
+  void expire_(uint32_t now);
+  static void free_(Slot &slot);
+
+  Slot slots_[POOL_SIZE];
+};
+
+} // namespace chimera_fx
+} // namespace esphome
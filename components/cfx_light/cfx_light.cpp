@@ -12,11 +12,19 @@
 #include "cfx_power_manager.h"
 #include "cfx_virtual_segment_light.h"
 #include "cfx_transmit_barrier.h"
+#include "cfx_realtime_ingest.h"
+#include "cfx_visualizer_stream.h"
 #include "../cfx_effect/cfx_control.h"
 #include "../cfx_effect/CFXRunner.h"
 #include "../cfx_effect/cfx_scheduler.h"
 #include "../cfx_effect/cfx_utils.h"
 #include "../cfx_effect/cfx_effect_stub.h"
+#ifdef USE_CFX_PROFILER
+#include "../cfx_effect/cfx_profiler.h"
+#endif
+#ifdef USE_CFX_TRACE
+#include "../cfx_effect/cfx_trace.h"
+#endif
 
 #ifdef USE_WIFI
 #include <lwip/inet.h>
@@ -63,6 +71,7 @@ namespace cfx_light {
 static const char *const TAG = "cfx_light";
 
 static portMUX_TYPE g_parallel_mux = portMUX_INITIALIZER_UNLOCKED;
+static portMUX_TYPE g_rmt_queue_mux = portMUX_INITIALIZER_UNLOCKED;
 
 //#define CFX_PARALLEL_TEST_PATTERN
 
@@ -93,7 +102,7 @@ static const uint8_t PARALLEL_SYMBOL_SAMPLES = 3;
 static const uint32_t PARALLEL_PCLK_HZ = 2400000;
 static const size_t PARALLEL_RESET_SAMPLES = 240;  // 100 us at 2.4 MHz.
 #endif
-static const uint8_t PARALLEL_MAX_LANES = 4;
+static const uint8_t PARALLEL_MAX_LANES = 8;
 static const uint8_t PARALLEL_MAX_GROUPS = 2;
 static const uint8_t PARALLEL_I80_BUS_WIDTH = 8;
 static const uint16_t PARALLEL_CLASSIC_CHUNK_LEDS = 64;
@@ -660,6 +669,7 @@ void CFXLightOutput::repaint_force_white_solid_(bool state) {
     if (state)
       cfx::apply_force_white(c.r, c.g, c.b, c.w);
     this->all() = c;
+    this->mark_frame_dirty();
     this->schedule_show();
   }
 }
@@ -736,6 +746,8 @@ void CFXLightOutput::reset_perf_diag_() {
   this->perf_diag_total_gate_defers_ = 0;
   this->perf_diag_total_refresh_defers_ = 0;
   this->perf_diag_total_partial_flushes_ = 0;
+  this->perf_diag_total_dedup_skips_ = 0;
+  this->perf_diag_total_encoded_leds_ = 0;
   this->perf_diag_total_rmt_starve_count_ = 0;
   this->perf_diag_total_rmt_reset_starve_count_ = 0;
   this->perf_diag_total_rmt_callback_count_ = 0;
@@ -1012,7 +1024,8 @@ void CFXLightOutput::log_spi_cadence_diag_(bool force) {
            " guard(avg=%" PRIu32 " max=%" PRIu32
            " hits=%" PRIu64 " timeout=%" PRIu64 ")"
            " defers(refresh=%" PRIu64 " gate=%" PRIu64
-           " partial=%" PRIu64 ") spi(wait=%" PRIu32
+           " partial=%" PRIu64 " dedup=%" PRIu64 " enc_leds=%" PRIu64
+           ") spi(wait=%" PRIu32
            " timeout=%" PRIu32 " qerr=%" PRIu32 " in_flight=%d)",
            light_name, frames, led_fps_text, avg_flush_dt_us, avg_show_queue_us,
            avg_write_us, avg_flush_us, avg_wait_us, avg_pack_us,
@@ -1027,7 +1040,9 @@ void CFXLightOutput::log_spi_cadence_diag_(bool force) {
            this->perf_diag_total_dma_guard_timeouts_,
            this->perf_diag_total_refresh_defers_,
            this->perf_diag_total_gate_defers_,
-           this->perf_diag_total_partial_flushes_, this->spi_wait_count_,
+           this->perf_diag_total_partial_flushes_,
+           this->perf_diag_total_dedup_skips_,
+           this->perf_diag_total_encoded_leds_, this->spi_wait_count_,
            this->spi_wait_timeout_count_, this->spi_queue_error_count_,
            this->spi_tx_in_flight_);
   this->reset_perf_diag_();
@@ -1099,7 +1114,7 @@ void CFXLightOutput::log_rmt_cadence_diag_(bool force) {
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
   const char *encoder_label = "bytes+reset";
 #else
-  const char *encoder_label = "copy";
+  const char *encoder_label = "lut+reset";
 #endif
 
   ESP_LOGV(TAG,
@@ -1115,7 +1130,8 @@ void CFXLightOutput::log_rmt_cadence_diag_(bool force) {
            " leds=%" PRIu32 " stride=%u wire_floor=%" PRIu32
            " eff_ms=%" PRIu32
            " tx=%" PRIu64 " launch_us(avg=%" PRIu32 " max=%" PRIu32
-           ") coalesce=%" PRIu64 " wait=%" PRIu32
+           ") coalesce=%" PRIu64 " dedup=%" PRIu64 " enc_leds=%" PRIu64
+           " wait=%" PRIu32
            " timeout=%" PRIu32 " in_flight=%d)",
            light_name, frames, led_fps_text, avg_show_queue_us, avg_write_us,
            avg_flush_us, avg_wait_us, this->perf_diag_max_queue_us_,
@@ -1131,7 +1147,9 @@ void CFXLightOutput::log_rmt_cadence_diag_(bool force) {
            effective_interval_ms,
            this->perf_diag_total_rmt_tx_launches_,
            avg_rmt_tx_dt_us, this->perf_diag_max_rmt_tx_launch_interval_us_,
-           this->perf_diag_total_rmt_coalesced_flushes_, this->rmt_wait_count_,
+           this->perf_diag_total_rmt_coalesced_flushes_,
+           this->perf_diag_total_dedup_skips_,
+           this->perf_diag_total_encoded_leds_, this->rmt_wait_count_,
            this->rmt_wait_timeout_count_, this->rmt_tx_in_flight_);
   this->reset_perf_diag_();
 }
@@ -1198,12 +1216,11 @@ void CFXLightOutput::log_segment_coordinator_diag_() {
     return;
   }
 
-  uint8_t active_mask = 0;
-  for (size_t i = 0; i < this->segment_light_states_.size() &&
-                     i < MAX_CFX_SEGMENTS; i++) {
+  CFXSegmentMask active_mask = 0;
+  for (size_t i = 0; i < this->segment_light_states_.size(); i++) {
     auto *state = this->segment_light_states_[i];
     if (state != nullptr && state->remote_values.is_on()) {
-      active_mask |= static_cast<uint8_t>(1u << i);
+      active_mask |= cfx_segment_bit(i);
     }
   }
 
@@ -1241,8 +1258,9 @@ void CFXLightOutput::log_segment_coordinator_diag_() {
       this->seg_coord_total_refresh_dt_us_ / refresh_dt_count);
 
   ESP_LOGD(TAG,
-           "CFX seg_coord[%s] active=0x%02x owned=0x%02x dormant=0x%02x "
-           "idle=0x%02x last=0x%02x/%u epochs=%" PRIu32
+           "CFX seg_coord[%s] active=0x%" PRIx32 " owned=0x%" PRIx32
+           " dormant=0x%" PRIx32 " idle=0x%" PRIx32 " last=0x%" PRIx32
+           "/%u epochs=%" PRIu32
            " segs=%" PRIu32 " avg=%" PRIu32
            " partial=%" PRIu32 " missed=%" PRIu32
            " max_missing=%" PRIu32 " clean=%" PRIu32
@@ -1374,6 +1392,7 @@ void CFXLightOutput::paint_low_ram_warning_(light::LightState *state, bool on) {
   for (uint16_t i = start; i < stop && i < this->size(); i++) {
     (*this)[i] = warning;
   }
+  this->mark_frame_dirty();
   this->schedule_show();
 }
 
@@ -1424,13 +1443,11 @@ resolve_active_cfx_effect(light::LightState *state) {
   }
 
   auto *output = state->get_output();
-  bool virtual_segment_output = false;
   if (output != nullptr) {
     for (auto *seg_out : CFXVirtualSegmentLight::all_segments) {
       if (seg_out != output) {
         continue;
       }
-      virtual_segment_output = true;
       auto *slot_effect = seg_out->get_parent()->get_parent_owned_segment_effect(state);
       if (slot_effect != nullptr) {
         return slot_effect;
@@ -1439,31 +1456,9 @@ resolve_active_cfx_effect(light::LightState *state) {
     }
   }
 
-  light::LightEffect *effect = chimera_fx::LightStateProxy::get_active_effect(state);
-  if (effect == nullptr) {
-    return nullptr;
-  }
-
-  // If the active effect is a Stub (virtual segment), return its underlying singleton
-#if defined(USE_CFX_LIGHT) && defined(USE_ESP32)
-  if (virtual_segment_output) {
-    auto *cfx_stub = static_cast<chimera_fx::CFXEffectStub *>(effect);
-    return cfx_stub->get_singleton();
-  }
-#endif
-
-  for (auto *inst : chimera_fx::CFXAddressableLightEffect::all_effects) {
-    if (inst == effect) {
-      return inst;
-    }
-  }
-  for (auto *inst : chimera_fx::CFXAddressableLightEffect::all_segment_effects) {
-    if (inst == effect) {
-      return inst;
-    }
-  }
-
-  return nullptr;
+  // A stub resolves to its light's engine, a full effect to itself.
+  return chimera_fx::CFXAddressableLightEffect::engine_for(
+      chimera_fx::LightStateProxy::get_active_effect(state));
 }
 
 static bool perf_diag_enabled_for_effect(
@@ -1595,21 +1590,20 @@ static void mark_committed_mono_idle_outputs(CFXLightOutput *output) {
   }
 }
 
-uint8_t CFXLightOutput::collect_clean_mono_idle_segment_mask_() const {
+CFXSegmentMask CFXLightOutput::collect_clean_mono_idle_segment_mask_() const {
   if (!this->has_segments() || this->has_outro()) {
     return 0;
   }
 
-  uint8_t mask = 0;
-  for (size_t i = 0; i < this->segment_light_states_.size() &&
-                     i < MAX_CFX_SEGMENTS; i++) {
+  CFXSegmentMask mask = 0;
+  for (size_t i = 0; i < this->segment_light_states_.size(); i++) {
     auto *seg_state = this->segment_light_states_[i];
     if (seg_state == nullptr || !seg_state->remote_values.is_on()) {
       continue;
     }
     auto *effect = resolve_active_cfx_effect(seg_state);
     if (effect != nullptr && effect->is_clean_mono_idle_output()) {
-      mask |= static_cast<uint8_t>(1u << i);
+      mask |= cfx_segment_bit(i);
     }
   }
   return mask;
@@ -1637,20 +1631,17 @@ void CFXLightOutput::wake_mono_idle_light_state_(light::LightState *state) {
     return;
   }
 
-  for (size_t i = 0; i < this->segment_light_states_.size() &&
-                     i < MAX_CFX_SEGMENTS; i++) {
+  for (size_t i = 0; i < this->segment_light_states_.size(); i++) {
     if (this->segment_light_states_[i] != state) {
       continue;
     }
-    const uint8_t bit = static_cast<uint8_t>(1u << i);
+    const CFXSegmentMask bit = cfx_segment_bit(i);
     if ((this->segment_coord_dormant_mask_ & bit) != 0) {
       state->enable_loop();
-      this->segment_coord_dormant_mask_ &=
-          static_cast<uint8_t>(~bit);
+      this->segment_coord_dormant_mask_ &= ~bit;
       if ((this->segment_mono_idle_dormant_mask_ & bit) != 0) {
-        this->segment_mono_idle_dormant_mask_ &=
-            static_cast<uint8_t>(~bit);
-        this->segment_mono_idle_sleep_ms_[i] = 0;
+        this->segment_mono_idle_dormant_mask_ &= ~bit;
+        this->segment_runtime_slots_[i].mono_idle_sleep_ms = 0;
         this->mono_idle_wake_count_++;
       }
     }
@@ -1658,7 +1649,8 @@ void CFXLightOutput::wake_mono_idle_light_state_(light::LightState *state) {
   }
 }
 
-void CFXLightOutput::apply_mono_idle_loop_state_(uint8_t segment_idle_mask) {
+void CFXLightOutput::apply_mono_idle_loop_state_(
+    CFXSegmentMask segment_idle_mask) {
   const uint32_t now_ms = esphome::millis();
   const bool master_should_sleep =
       !this->has_outro() && this->master_light_state_ != nullptr &&
@@ -1685,25 +1677,24 @@ void CFXLightOutput::apply_mono_idle_loop_state_(uint8_t segment_idle_mask) {
     this->mono_idle_wake_count_++;
   }
 
-  const uint8_t previous_segment_idle_mask =
-      this->segment_mono_idle_dormant_mask_;
-  for (size_t i = 0; i < this->segment_light_states_.size() &&
-                     i < MAX_CFX_SEGMENTS; i++) {
+  // Only segments whose idle state flipped need bookkeeping.
+  for (CFXSegmentMask changed =
+           segment_idle_mask ^ this->segment_mono_idle_dormant_mask_;
+       changed != 0; changed &= changed - 1) {
+    const size_t i = cfx_segment_index(changed);
     auto *seg_state = this->segment_light_states_[i];
-    const uint8_t bit = static_cast<uint8_t>(1u << i);
-    const bool now_idle = (segment_idle_mask & bit) != 0;
-    const bool was_idle = (previous_segment_idle_mask & bit) != 0;
-    if (now_idle && !was_idle) {
+    const bool now_idle = (segment_idle_mask & cfx_segment_bit(i)) != 0;
+    if (now_idle) {
       auto *effect = seg_state != nullptr
                          ? resolve_active_cfx_effect(seg_state)
                          : nullptr;
       if (effect != nullptr) {
         effect->log_mono_idle_hold(true);
       }
-      this->segment_mono_idle_sleep_ms_[i] = now_ms;
+      this->segment_runtime_slots_[i].mono_idle_sleep_ms = now_ms;
       this->mono_idle_sleep_count_++;
-    } else if (!now_idle && was_idle) {
-      this->segment_mono_idle_sleep_ms_[i] = 0;
+    } else {
+      this->segment_runtime_slots_[i].mono_idle_sleep_ms = 0;
       this->mono_idle_wake_count_++;
     }
   }
@@ -1714,17 +1705,19 @@ void CFXLightOutput::apply_mono_idle_loop_state_(uint8_t segment_idle_mask) {
 }
 
 void CFXLightOutput::apply_segment_coordination_loop_state_(
-    uint8_t owned_mask) {
-  uint8_t next_dormant_mask = this->segment_coord_dormant_mask_;
+    CFXSegmentMask owned_mask) {
+  CFXSegmentMask next_dormant_mask = this->segment_coord_dormant_mask_;
 
-  for (size_t i = 0; i < this->segment_light_states_.size() &&
-                     i < MAX_CFX_SEGMENTS; i++) {
+  // Segments that are neither owned nor sleeping keep their own loop.
+  for (CFXSegmentMask pending = owned_mask | this->segment_coord_dormant_mask_;
+       pending != 0; pending &= pending - 1) {
+    const size_t i = cfx_segment_index(pending);
     auto *seg_state = this->segment_light_states_[i];
     if (seg_state == nullptr) {
       continue;
     }
 
-    const uint8_t bit = static_cast<uint8_t>(1u << i);
+    const CFXSegmentMask bit = cfx_segment_bit(i);
     const bool should_sleep = (owned_mask & bit) != 0;
     const bool is_sleeping = (this->segment_coord_dormant_mask_ & bit) != 0;
 
@@ -1734,7 +1727,7 @@ void CFXLightOutput::apply_segment_coordination_loop_state_(
       next_dormant_mask |= bit;
     } else if (!should_sleep && is_sleeping) {
       seg_state->enable_loop();
-      next_dormant_mask &= static_cast<uint8_t>(~bit);
+      next_dormant_mask &= ~bit;
     }
   }
 
@@ -1775,9 +1768,10 @@ int CFXLightOutput::find_segment_runtime_slot_(light::LightState *state) const {
   if (state == nullptr) {
     return -1;
   }
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    if (this->segment_runtime_slots_[i].active &&
-        this->segment_runtime_slots_[i].state == state) {
+  for (CFXSegmentMask m = this->segment_slot_active_mask_; m != 0;
+       m &= m - 1) {
+    const size_t i = cfx_segment_index(m);
+    if (this->segment_runtime_slots_[i].state == state) {
       return static_cast<int>(i);
     }
   }
@@ -1785,10 +1779,17 @@ int CFXLightOutput::find_segment_runtime_slot_(light::LightState *state) const {
 }
 
 void CFXLightOutput::clear_segment_runtime_slot_(size_t index) {
-  if (index >= MAX_CFX_SEGMENTS) {
+  if (index >= this->segment_runtime_slots_.size()) {
     return;
   }
   this->segment_runtime_slots_[index] = CFXSegmentRuntimeSlot{};
+  this->segment_slot_active_mask_ &= ~cfx_segment_bit(index);
+}
+
+void CFXLightOutput::mark_segment_generations_flushed_() {
+  for (auto &slot : this->segment_runtime_slots_) {
+    slot.flushed_generation = slot.request_generation;
+  }
 }
 
 void CFXLightOutput::clear_segment_idle_diag_() {
@@ -1801,8 +1802,9 @@ bool CFXLightOutput::has_active_parent_owned_segments_(bool include_outro) const
   if (this->has_outro() && !include_outro) {
     return false;
   }
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    const auto &slot = this->segment_runtime_slots_[i];
+  for (CFXSegmentMask m = this->segment_slot_active_mask_; m != 0;
+       m &= m - 1) {
+    const auto &slot = this->segment_runtime_slots_[cfx_segment_index(m)];
     if (slot.active && slot.state != nullptr && slot.effect != nullptr &&
         slot.runner != nullptr && slot.state->remote_values.is_on()) {
       return true;
@@ -1816,12 +1818,9 @@ CFXLightOutput::get_parent_owned_segment_effect(light::LightState *state) const
   if (state == nullptr) {
     return nullptr;
   }
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    const auto &slot = this->segment_runtime_slots_[i];
-    if (!slot.active || slot.state != state) {
-      continue;
-    }
-    return slot.effect;
+  const int slot_index = this->find_segment_runtime_slot_(state);
+  if (slot_index >= 0) {
+    return this->segment_runtime_slots_[slot_index].effect;
   }
   return nullptr;
 }
@@ -1861,11 +1860,9 @@ void CFXLightOutput::refresh_parent_owned_segment_slot_(
 }
 
 void CFXLightOutput::refresh_parent_owned_segment_slots_() {
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    auto &slot = this->segment_runtime_slots_[i];
-    if (!slot.active) {
-      continue;
-    }
+  for (CFXSegmentMask m = this->segment_slot_active_mask_; m != 0;
+       m &= m - 1) {
+    auto &slot = this->segment_runtime_slots_[cfx_segment_index(m)];
     this->refresh_parent_owned_segment_slot_(slot);
     slot.dirty = true;
   }
@@ -1885,8 +1882,7 @@ bool CFXLightOutput::register_parent_owned_segment(
   }
 
   int slot_index = -1;
-  for (size_t i = 0; i < this->segment_light_states_.size() &&
-                     i < MAX_CFX_SEGMENTS; i++) {
+  for (size_t i = 0; i < this->segment_light_states_.size(); i++) {
     if (this->segment_light_states_[i] == state) {
       slot_index = static_cast<int>(i);
       break;
@@ -1906,16 +1902,17 @@ bool CFXLightOutput::register_parent_owned_segment(
   slot.bound = false;
   slot.fallback = false;
   slot.due_at = 0;
+  slot.mono_idle_sleep_ms = 0;
+  this->segment_slot_active_mask_ |= cfx_segment_bit(slot_index);
   this->refresh_parent_owned_segment_slot_(slot);
   this->invalidate_segment_coord_schedule_();
 
   chimera_fx::LightStateProxy::clear_pending_write(state);
   state->enable_loop();
 
-  const uint8_t bit = static_cast<uint8_t>(1u << slot_index);
-  this->segment_coord_dormant_mask_ &= static_cast<uint8_t>(~bit);
-  this->segment_mono_idle_dormant_mask_ &= static_cast<uint8_t>(~bit);
-  this->segment_mono_idle_sleep_ms_[slot_index] = 0;
+  const CFXSegmentMask bit = cfx_segment_bit(slot_index);
+  this->segment_coord_dormant_mask_ &= ~bit;
+  this->segment_mono_idle_dormant_mask_ &= ~bit;
   this->refresh_segment_coordination_mask_();
   return true;
 }
@@ -1925,20 +1922,20 @@ void CFXLightOutput::unregister_parent_owned_segment(
   if (state == nullptr) {
     return;
   }
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
+  for (CFXSegmentMask m = this->segment_slot_active_mask_; m != 0;
+       m &= m - 1) {
+    const size_t i = cfx_segment_index(m);
     auto &slot = this->segment_runtime_slots_[i];
-    if (!slot.active || slot.state != state) {
+    if (slot.state != state) {
       continue;
     }
     if (effect != nullptr && slot.effect != effect) {
       continue;
     }
-    const uint8_t bit = static_cast<uint8_t>(1u << i);
-    this->segment_coord_dormant_mask_ &= static_cast<uint8_t>(~bit);
-    this->segment_mono_idle_dormant_mask_ &= static_cast<uint8_t>(~bit);
-    this->segment_mono_idle_sleep_ms_[i] = 0;
-    this->seg_request_generation_[i] = 0;
-    this->seg_flushed_generation_[i] = 0;
+    const CFXSegmentMask bit = cfx_segment_bit(i);
+    this->segment_coord_dormant_mask_ &= ~bit;
+    this->segment_mono_idle_dormant_mask_ &= ~bit;
+    // Clearing the slot also resets its flush generations and sleep stamp.
     state->enable_loop();
     this->clear_segment_runtime_slot_(i);
     this->invalidate_segment_coord_schedule_();
@@ -1947,20 +1944,23 @@ void CFXLightOutput::unregister_parent_owned_segment(
 }
 
 void CFXLightOutput::refresh_segment_coordination_mask_(bool include_outro) {
-  uint8_t mask = 0;
+  CFXSegmentMask mask = 0;
   if (this->has_segments() && (!this->has_outro() || include_outro)) {
-    for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
+    for (CFXSegmentMask m = this->segment_slot_active_mask_; m != 0;
+         m &= m - 1) {
+      const size_t i = cfx_segment_index(m);
       const auto &slot = this->segment_runtime_slots_[i];
       if (!slot.active || slot.state == nullptr || slot.effect == nullptr ||
           slot.runner == nullptr || slot.segment == nullptr) {
         continue;
       }
       if (!slot.state->remote_values.is_on() ||
+          this->realtime_owns(slot.state) ||
           !slot.effect->can_parent_coordinate_segment() ||
           slot.effect->is_clean_mono_idle_output()) {
         continue;
       }
-      mask |= static_cast<uint8_t>(1u << i);
+      mask |= cfx_segment_bit(i);
     }
   }
   this->segment_coord_owned_mask_ = mask;
@@ -1976,8 +1976,7 @@ bool CFXLightOutput::segment_coordinator_owns(light::LightState *state) {
   }
   const int slot_index = this->find_segment_runtime_slot_(state);
   return slot_index >= 0 &&
-         (this->segment_coord_owned_mask_ &
-          static_cast<uint8_t>(1u << slot_index)) != 0;
+         (this->segment_coord_owned_mask_ & cfx_segment_bit(slot_index)) != 0;
 }
 
 void CFXLightOutput::note_segment_coord_apply_skip() {
@@ -1992,18 +1991,14 @@ void CFXLightOutput::mark_parent_owned_segment_dirty(light::LightState *state) {
   if (state == nullptr) {
     return;
   }
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    auto &slot = this->segment_runtime_slots_[i];
-    if (!slot.active || slot.state != state) {
-      continue;
-    }
-    slot.dirty = true;
+  const int slot_index = this->find_segment_runtime_slot_(state);
+  if (slot_index >= 0) {
+    this->segment_runtime_slots_[slot_index].dirty = true;
     this->invalidate_segment_coord_schedule_();
-    return;
   }
 }
 
-bool CFXLightOutput::collect_segment_coordinator_epoch_(uint8_t &mask,
+bool CFXLightOutput::collect_segment_coordinator_epoch_(CFXSegmentMask &mask,
                                                         uint8_t &count,
                                                         uint64_t now,
                                                         bool force_due,
@@ -2032,7 +2027,7 @@ bool CFXLightOutput::collect_segment_coordinator_epoch_(uint8_t &mask,
   }
   uint64_t next_due = 0;
   this->refresh_segment_coordination_mask_(allow_outro);
-  const uint8_t segment_idle_mask =
+  const CFXSegmentMask segment_idle_mask =
       allow_outro ? 0 : this->collect_clean_mono_idle_segment_mask_();
   this->apply_mono_idle_loop_state_(segment_idle_mask);
   this->apply_master_segment_coordination_loop_state_();
@@ -2043,20 +2038,13 @@ bool CFXLightOutput::collect_segment_coordinator_epoch_(uint8_t &mask,
     return false;
   }
 
-  if (this->segment_coord_runners_.capacity() < MAX_CFX_SEGMENTS) {
-    this->segment_coord_runners_.reserve(MAX_CFX_SEGMENTS);
-  }
   this->segment_coord_runners_.clear();
 
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
+  // The owned mask only holds fully bound, rendering slots.
+  for (CFXSegmentMask owned = this->segment_coord_owned_mask_; owned != 0;
+       owned &= owned - 1) {
+    const size_t i = cfx_segment_index(owned);
     auto &slot = this->segment_runtime_slots_[i];
-    if (!slot.active || slot.state == nullptr || slot.effect == nullptr ||
-        slot.runner == nullptr || slot.segment == nullptr) {
-      continue;
-    }
-    if ((this->segment_coord_owned_mask_ & static_cast<uint8_t>(1u << i)) == 0) {
-      continue;
-    }
     uint32_t interval = slot.effect->get_effective_update_interval();
     if (this->rmt_c3_stability_cushion_) {
       const uint32_t c3_floor_us = this->get_segmented_rmt_refresh_floor_us_();
@@ -2096,7 +2084,7 @@ bool CFXLightOutput::collect_segment_coordinator_epoch_(uint8_t &mask,
       next_due = slot.due_at;
     }
     this->segment_coord_runners_.push_back(slot.runner);
-    mask |= static_cast<uint8_t>(1u << i);
+    mask |= cfx_segment_bit(i);
     count++;
   }
   this->segment_coord_schedule_dirty_ = false;
@@ -2129,7 +2117,7 @@ bool CFXLightOutput::collect_segment_coordinator_epoch_(uint8_t &mask,
   return true;
 }
 
-bool CFXLightOutput::render_segment_coordinator_epoch_(uint8_t &mask,
+bool CFXLightOutput::render_segment_coordinator_epoch_(CFXSegmentMask &mask,
                                                        uint8_t &count,
                                                        bool force_due,
                                                        bool allow_outro) {
@@ -2163,16 +2151,23 @@ bool CFXLightOutput::render_segment_coordinator_epoch_(uint8_t &mask,
     return true;
   }
 
+#ifdef USE_CFX_PROFILER
+  chimera_fx::CFXProfiler::get().record_stage(
+      chimera_fx::CFX_STAGE_COORDINATOR,
+      micros() - this->seg_coord_collect_start_us_);
+#endif
+#ifdef USE_CFX_TRACE
+  chimera_fx::CFXTrace::get().span(
+      chimera_fx::CFX_TRACE_COORDINATOR, this->seg_coord_collect_start_us_,
+      micros() - this->seg_coord_collect_start_us_, this->pin_);
+#endif
   for (auto *runner : this->segment_coord_runners_) {
     if (runner != nullptr) {
       runner->diagnostics.flush_log(this->get_led_fps());
     }
   }
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    if ((mask & static_cast<uint8_t>(1u << i)) == 0) {
-      continue;
-    }
-    auto &slot = this->segment_runtime_slots_[i];
+  for (CFXSegmentMask m = mask; m != 0; m &= m - 1) {
+    auto &slot = this->segment_runtime_slots_[cfx_segment_index(m)];
     if (slot.effect != nullptr) {
       slot.effect->process_parent_coordinated_runner_events();
     }
@@ -2182,19 +2177,17 @@ bool CFXLightOutput::render_segment_coordinator_epoch_(uint8_t &mask,
   return true;
 }
 
-void CFXLightOutput::mark_segment_coordinator_epoch_committed_(uint8_t mask) {
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    if ((mask & static_cast<uint8_t>(1u << i)) == 0) {
-      continue;
-    }
-    const auto &slot = this->segment_runtime_slots_[i];
+void CFXLightOutput::mark_segment_coordinator_epoch_committed_(
+    CFXSegmentMask mask) {
+  for (CFXSegmentMask m = mask; m != 0; m &= m - 1) {
+    const auto &slot = this->segment_runtime_slots_[cfx_segment_index(m)];
     if (slot.effect != nullptr && slot.effect->has_dirty_mono_idle_output()) {
       slot.effect->mark_mono_output_committed();
     }
   }
 }
 
-void CFXLightOutput::finalize_segment_coordinator_epoch_(uint8_t mask,
+void CFXLightOutput::finalize_segment_coordinator_epoch_(CFXSegmentMask mask,
                                                          uint8_t count,
                                                          bool transmit) {
   if (mask == 0 || count == 0) {
@@ -2204,13 +2197,10 @@ void CFXLightOutput::finalize_segment_coordinator_epoch_(uint8_t mask,
   if (this->seg_generation_counter_ == 0) {
     this->seg_generation_counter_ = 1;
   }
-  for (size_t i = 0; i < this->segment_light_states_.size() &&
-                     i < MAX_CFX_SEGMENTS; i++) {
-    if ((mask & static_cast<uint8_t>(1u << i)) == 0) {
-      continue;
-    }
-    this->seg_request_generation_[i] = this->seg_generation_counter_;
-    this->seg_flushed_generation_[i] = this->seg_generation_counter_;
+  for (CFXSegmentMask m = mask; m != 0; m &= m - 1) {
+    auto &slot = this->segment_runtime_slots_[cfx_segment_index(m)];
+    slot.request_generation = this->seg_generation_counter_;
+    slot.flushed_generation = this->seg_generation_counter_;
   }
   this->seg_flush_pending_mask_ = 0;
   this->seg_flush_dirty_mask_ = 0;
@@ -2230,7 +2220,7 @@ bool CFXLightOutput::service_parallel_segment_group_coordinator_() {
     return false;
   }
 
-  uint8_t lane_masks[PARALLEL_MAX_LANES] = {};
+  CFXSegmentMask lane_masks[PARALLEL_MAX_LANES] = {};
   uint8_t lane_counts[PARALLEL_MAX_LANES] = {};
   bool group_due = false;
   const uint64_t now = static_cast<uint64_t>(esphome::millis());
@@ -2260,25 +2250,20 @@ bool CFXLightOutput::service_parallel_segment_group_coordinator_() {
       if (output == nullptr || !output->has_segments() || output->has_outro()) {
         continue;
       }
-      const uint8_t segment_idle_mask =
+      const CFXSegmentMask segment_idle_mask =
           output->collect_clean_mono_idle_segment_mask_();
       output->apply_mono_idle_loop_state_(segment_idle_mask);
     }
     return false;
   }
 
-  if (this->parallel_segment_coord_runners_.capacity() <
-      PARALLEL_MAX_LANES * MAX_CFX_SEGMENTS) {
-    this->parallel_segment_coord_runners_.reserve(
-        PARALLEL_MAX_LANES * MAX_CFX_SEGMENTS);
-  }
   this->parallel_segment_coord_runners_.clear();
   for (uint8_t lane = 0; lane < g_parallel_group.lane_count; lane++) {
     auto *output = g_parallel_group.outputs[lane];
     if (output == nullptr || !output->has_segments() || output->has_outro()) {
       continue;
     }
-    uint8_t mask = 0;
+    CFXSegmentMask mask = 0;
     uint8_t count = 0;
     output->seg_coord_collect_start_us_ = micros();
     if (output->collect_segment_coordinator_epoch_(mask, count, now, false)) {
@@ -2330,11 +2315,8 @@ bool CFXLightOutput::service_parallel_segment_group_coordinator_() {
         runner->diagnostics.flush_log(output->get_led_fps());
       }
     }
-    for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-      if ((lane_masks[lane] & static_cast<uint8_t>(1u << i)) == 0) {
-        continue;
-      }
-      auto &slot = output->segment_runtime_slots_[i];
+    for (CFXSegmentMask m = lane_masks[lane]; m != 0; m &= m - 1) {
+      auto &slot = output->segment_runtime_slots_[cfx_segment_index(m)];
       if (slot.effect != nullptr) {
         slot.effect->process_parent_coordinated_runner_events();
       }
@@ -2410,7 +2392,7 @@ bool CFXLightOutput::service_segment_render_coordinator_() {
     return this->service_parallel_segment_group_coordinator_();
   }
 
-  uint8_t mask = 0;
+  CFXSegmentMask mask = 0;
   uint8_t count = 0;
   if (!this->render_segment_coordinator_epoch_(mask, count, false)) {
     return false;
@@ -2419,13 +2401,13 @@ bool CFXLightOutput::service_segment_render_coordinator_() {
   return true;
 }
 
-void CFXLightOutput::flush_segment_coordinator_epoch_(uint8_t mask,
+void CFXLightOutput::flush_segment_coordinator_epoch_(CFXSegmentMask mask,
                                                      uint8_t count) {
   this->finalize_segment_coordinator_epoch_(mask, count, true);
 }
 
 void CFXLightOutput::schedule_segment_deferred_flush_(
-    uint8_t mask, uint8_t count, uint32_t remaining_us) {
+    CFXSegmentMask mask, uint8_t count, uint32_t remaining_us) {
   if (!this->is_rmt_transport() || !this->has_segments() || mask == 0 ||
       count == 0) {
     this->schedule_show();
@@ -2451,7 +2433,7 @@ void CFXLightOutput::schedule_segment_deferred_flush_(
     if (!this->seg_deferred_flush_pending_) {
       return;
     }
-    const uint8_t mask = this->seg_deferred_flush_mask_;
+    const CFXSegmentMask mask = this->seg_deferred_flush_mask_;
     const uint8_t count = this->seg_deferred_flush_count_;
     this->seg_deferred_flush_pending_ = false;
     this->seg_deferred_flush_mask_ = 0;
@@ -2480,8 +2462,8 @@ uint32_t CFXLightOutput::get_segmented_rmt_refresh_floor_us_() const {
   return floor_us;
 }
 
-void CFXLightOutput::flush_parent_owned_segment_epoch_direct_(uint8_t mask,
-                                                              uint8_t count) {
+void CFXLightOutput::flush_parent_owned_segment_epoch_direct_(
+    CFXSegmentMask mask, uint8_t count) {
   if (mask == 0 || count == 0) {
     return;
   }
@@ -2569,11 +2551,8 @@ void CFXLightOutput::flush_parent_owned_segment_epoch_direct_(uint8_t mask,
     this->flush_rmt_();
   }
 
-  for (size_t i = 0; i < MAX_CFX_SEGMENTS; i++) {
-    if ((mask & static_cast<uint8_t>(1u << i)) == 0) {
-      continue;
-    }
-    const auto &slot = this->segment_runtime_slots_[i];
+  for (CFXSegmentMask m = mask; m != 0; m &= m - 1) {
+    const auto &slot = this->segment_runtime_slots_[cfx_segment_index(m)];
     if (slot.effect != nullptr && slot.effect->has_dirty_mono_idle_output()) {
       slot.effect->mark_mono_output_committed();
     }
@@ -2585,17 +2564,11 @@ void CFXLightOutput::flush_parent_owned_segment_epoch_direct_(uint8_t mask,
 
 // --- Core Control Loop & Initialization ---
 
-// CFX-025: Destructor closes the visualizer UDP socket if it was opened.
-// ESP32 has a small FD pool (~5 sockets under default ESP-IDF config). Without
-// this, each OTA cycle or component teardown leaks one FD, eventually causing
-// all subsequent socket() calls to fail. close() is available via
-// lwip/sockets.h.
+// CFX-025: the visualizer socket is owned by CFXVisualizerStream, a
+// singleton that opens exactly one for all outputs, so teardown cannot leak
+// FDs from the ESP32's small pool.
 CFXLightOutput::~CFXLightOutput() {
   this->high_freq_loop_requester_.stop();
-  if (this->socket_fd_ >= 0) {
-    ::close(this->socket_fd_);
-    this->socket_fd_ = -1;
-  }
   // RMT teardown: drain any in-flight DMA before releasing the channel.
   if (this->rmt_tx_in_flight_ && this->channel_ != nullptr) {
     this->wait_for_rmt_tx_(50, "destructor");
@@ -2611,9 +2584,11 @@ CFXLightOutput::~CFXLightOutput() {
   if (this->transport_ == TRANSPORT_SPI) {
     spi_bus_free(resolve_spi_host_(this->spi_host_));
   }
-  if (this->spi_frame_buf_ != nullptr) {
-    free(this->spi_frame_buf_);
-    this->spi_frame_buf_ = nullptr;
+  for (auto *&frame : this->spi_frame_bufs_) {
+    if (frame != nullptr) {
+      free(frame);
+      frame = nullptr;
+    }
   }
 }
 
@@ -2918,6 +2893,159 @@ static esp_err_t cfx_rmt_new_led_encoder(const LedParams &params,
   *ret_encoder = &led_encoder->base;
   return ESP_OK;
 }
+#else
+// Pre-5.3 streaming encoder. The TX interrupt refills the channel's symbol
+// memory from the staged byte frame, copying one pre-built row of 8 symbols
+// per byte, so only the byte buffer stays resident instead of a fully
+// expanded symbol frame (32 bytes per data byte).
+struct CFXRMTSymbolLut {
+  uint32_t bit0{0};
+  uint32_t bit1{0};
+  rmt_symbol_word_t *rows{nullptr}; // 256 rows of RMT_SYMBOLS_PER_BYTE
+};
+// Outputs with the same chipset timing share one table (8 KB each); there
+// is one per one-wire chipset at most.
+static CFXRMTSymbolLut g_rmt_symbol_luts[4];
+
+static const rmt_symbol_word_t *cfx_rmt_symbol_lut(const LedParams &params) {
+  for (const auto &lut : g_rmt_symbol_luts) {
+    if (lut.rows != nullptr && lut.bit0 == params.bit0.val &&
+        lut.bit1 == params.bit1.val) {
+      return lut.rows;
+    }
+  }
+  for (auto &lut : g_rmt_symbol_luts) {
+    if (lut.rows != nullptr) {
+      continue;
+    }
+    // Read from the TX ISR, so it must stay in internal RAM.
+    auto *rows = static_cast<rmt_symbol_word_t *>(heap_caps_malloc(
+        256 * RMT_SYMBOLS_PER_BYTE * sizeof(rmt_symbol_word_t),
+        MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    if (rows == nullptr) {
+      return nullptr;
+    }
+    for (size_t b = 0; b < 256; b++) {
+      for (size_t i = 0; i < RMT_SYMBOLS_PER_BYTE; i++) {
+        rows[b * RMT_SYMBOLS_PER_BYTE + i] =
+            (b & (0x80u >> i)) ? params.bit1 : params.bit0;
+      }
+    }
+    lut.bit0 = params.bit0.val;
+    lut.bit1 = params.bit1.val;
+    lut.rows = rows;
+    return rows;
+  }
+  return nullptr;
+}
+
+struct CFXRMTLutEncoder {
+  rmt_encoder_t base;
+  rmt_encoder_t *copy_encoder{nullptr};
+  const rmt_symbol_word_t *rows{nullptr};
+  rmt_symbol_word_t reset_symbol{};
+  size_t byte_index{0};
+  uint8_t state{0};
+};
+
+static size_t IRAM_ATTR cfx_rmt_lut_encode(rmt_encoder_t *encoder,
+                                           rmt_channel_handle_t channel,
+                                           const void *primary_data,
+                                           size_t data_size,
+                                           rmt_encode_state_t *ret_state) {
+  auto *lut_encoder = reinterpret_cast<CFXRMTLutEncoder *>(encoder);
+  rmt_encoder_t *copy = lut_encoder->copy_encoder;
+  const auto *bytes = static_cast<const uint8_t *>(primary_data);
+  rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+  size_t encoded_symbols = 0;
+
+  // The copy encoder keeps its own offset into a row cut short by
+  // MEM_FULL, so the same row is passed again on the next refill.
+  while (lut_encoder->state == 0) {
+    if (lut_encoder->byte_index >= data_size) {
+      lut_encoder->state = 1;
+      break;
+    }
+    const rmt_symbol_word_t *row =
+        lut_encoder->rows + bytes[lut_encoder->byte_index] * RMT_SYMBOLS_PER_BYTE;
+    encoded_symbols += copy->encode(
+        copy, channel, row, RMT_SYMBOLS_PER_BYTE * sizeof(rmt_symbol_word_t),
+        &session_state);
+    if (session_state & RMT_ENCODING_COMPLETE) {
+      lut_encoder->byte_index++;
+    }
+    if (session_state & RMT_ENCODING_MEM_FULL) {
+      *ret_state = RMT_ENCODING_MEM_FULL;
+      return encoded_symbols;
+    }
+  }
+
+  if (lut_encoder->reset_symbol.duration0 > 0 ||
+      lut_encoder->reset_symbol.duration1 > 0) {
+    encoded_symbols += copy->encode(copy, channel, &lut_encoder->reset_symbol,
+                                    sizeof(lut_encoder->reset_symbol),
+                                    &session_state);
+    if ((session_state & RMT_ENCODING_COMPLETE) == 0) {
+      *ret_state = RMT_ENCODING_MEM_FULL;
+      return encoded_symbols;
+    }
+  }
+  lut_encoder->state = 0;
+  lut_encoder->byte_index = 0;
+  *ret_state = RMT_ENCODING_COMPLETE;
+  return encoded_symbols;
+}
+
+static esp_err_t cfx_rmt_lut_encoder_reset(rmt_encoder_t *encoder) {
+  auto *lut_encoder = reinterpret_cast<CFXRMTLutEncoder *>(encoder);
+  rmt_encoder_reset(lut_encoder->copy_encoder);
+  lut_encoder->state = 0;
+  lut_encoder->byte_index = 0;
+  return ESP_OK;
+}
+
+static esp_err_t cfx_rmt_lut_encoder_del(rmt_encoder_t *encoder) {
+  auto *lut_encoder = reinterpret_cast<CFXRMTLutEncoder *>(encoder);
+  if (lut_encoder->copy_encoder != nullptr) {
+    rmt_del_encoder(lut_encoder->copy_encoder);
+  }
+  free(lut_encoder);
+  return ESP_OK;
+}
+
+static esp_err_t cfx_rmt_new_lut_encoder(const LedParams &params,
+                                         rmt_encoder_handle_t *ret_encoder) {
+  if (ret_encoder == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  const rmt_symbol_word_t *rows = cfx_rmt_symbol_lut(params);
+  if (rows == nullptr) {
+    return ESP_ERR_NO_MEM;
+  }
+
+  auto *lut_encoder = static_cast<CFXRMTLutEncoder *>(heap_caps_calloc(
+      1, sizeof(CFXRMTLutEncoder), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  if (lut_encoder == nullptr) {
+    return ESP_ERR_NO_MEM;
+  }
+  lut_encoder->base.encode = cfx_rmt_lut_encode;
+  lut_encoder->base.reset = cfx_rmt_lut_encoder_reset;
+  lut_encoder->base.del = cfx_rmt_lut_encoder_del;
+  lut_encoder->rows = rows;
+  lut_encoder->reset_symbol = params.reset;
+
+  rmt_copy_encoder_config_t copy_config;
+  memset(&copy_config, 0, sizeof(copy_config));
+  esp_err_t err =
+      rmt_new_copy_encoder(&copy_config, &lut_encoder->copy_encoder);
+  if (err != ESP_OK) {
+    cfx_rmt_lut_encoder_del(&lut_encoder->base);
+    return err;
+  }
+
+  *ret_encoder = &lut_encoder->base;
+  return ESP_OK;
+}
 #endif
 
 // --- P2: RMT async-done callback ---
@@ -2938,7 +3066,12 @@ static bool IRAM_ATTR rmt_tx_done_cb_(rmt_channel_handle_t,
   if (done == nullptr || done->in_flight == nullptr) {
     return false;
   }
-  *done->in_flight = false;
+  portENTER_CRITICAL_ISR(&g_rmt_queue_mux);
+  if (done->queued != nullptr && *done->queued > 0) {
+    (*done->queued)--;
+  }
+  *done->in_flight = done->queued != nullptr && *done->queued > 0;
+  portEXIT_CRITICAL_ISR(&g_rmt_queue_mux);
   if (done->dma_enabled && g_rmt_dma_active_count > 0) {
     g_rmt_dma_active_count--;
   }
@@ -2961,34 +3094,45 @@ void CFXLightOutput::setup() {
            this->num_leds_, static_cast<unsigned>(buffer_size),
            static_cast<unsigned>(this->get_pixel_stride_()));
 
-  // Allocate pixel buffer (internal RAM)
-  RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
-  this->buf_ = allocator.allocate(buffer_size);
-  if (this->buf_ == nullptr) {
-    ESP_LOGE(TAG, "Cannot allocate LED buffer (%u bytes)!", buffer_size);
-    this->mark_failed();
-    return;
+  // Pixel buffer (hot: internal unless memory_placement says otherwise).
+  // Zero-copy RMT outputs render straight into their transmit buffers;
+  // setup_rmt_() points buf_ there.
+  if (!this->zero_copy_ || this->transport_ != TRANSPORT_RMT) {
+    this->buf_ =
+        this->memory_budget_.allocate(CFX_MEM_HOT, buffer_size, "pixels");
+    if (this->buf_ == nullptr) {
+      ESP_LOGE(TAG, "Cannot allocate LED buffer (%u bytes)!", buffer_size);
+      this->mark_failed();
+      return;
+    }
+    memset(this->buf_, 0, buffer_size);
   }
-  memset(this->buf_, 0, buffer_size);
 
   // Allocate effect data buffer (1 byte per LED)
-  this->effect_data_ = allocator.allocate(this->num_leds_);
+  this->effect_data_ = this->memory_budget_.allocate(
+      CFX_MEM_HOT, this->num_leds_, "effect data");
   if (this->effect_data_ == nullptr) {
     ESP_LOGE(TAG, "Cannot allocate effect data!");
     this->mark_failed();
     return;
   }
 
-  if (this->state_parent_ != nullptr) {
-    chimera_fx::CFXRunner::prewarmGamma(
-        this->state_parent_->get_gamma_correct());
-  }
-  for (auto *seg_state : this->segment_light_states_) {
-    if (seg_state != nullptr) {
-      chimera_fx::CFXRunner::prewarmGamma(seg_state->get_gamma_correct());
-    }
+  // Transition planes (cold: PSRAM when present), since blends are not on
+  // the transmit path. Without them effects cut instead of dissolving.
+  this->transition_planes_ =
+      reinterpret_cast<Color *>(this->memory_budget_.allocate(
+          CFX_MEM_COLD,
+          static_cast<size_t>(this->num_leds_) * TRANSITION_PLANE_COUNT *
+              sizeof(Color),
+          "transition planes"));
+  if (this->transition_planes_ == nullptr) {
+    ESP_LOGW(TAG, "Cannot allocate transition buffers (%u bytes)",
+             static_cast<unsigned>(this->num_leds_ * TRANSITION_PLANE_COUNT *
+                                   sizeof(Color)));
   }
 
+  this->select_transmit_prep_();
+
   // Transport-specific hardware init
   if (this->transport_ == TRANSPORT_SPI) {
     this->setup_spi_();
@@ -3020,8 +3164,26 @@ void CFXLightOutput::setup() {
   // once all outputs have completed setup(). Single-output setups are no-ops
   // (barrier passes through immediately when count_ < 2).
   CFXTransmitBarrier::get().register_output(this);
+#ifdef CFX_REALTIME_ENABLED
+  if (this->realtime_enabled_ && this->buf_ != nullptr) {
+    CFXRealtimeIngest::get().register_sink(
+        this, static_cast<CFXRealtimeProtocol>(this->realtime_protocol_),
+        this->realtime_port_, this->realtime_address_, this->realtime_start_,
+        this->realtime_count_, this->realtime_timeout_ms_);
+  }
+#endif
+#if defined(CFX_VISUALIZER_ENABLED) && defined(USE_WIFI)
+  if (this->visualizer_enabled_ && !this->visualizer_ip_.empty() &&
+      this->buf_ != nullptr) {
+    this->visualizer_slot_ = CFXVisualizerStream::get().register_output(
+        this->visualizer_ip_, this->visualizer_port_,
+        this->visualizer_interval_ms_, this->get_buffer_size_(),
+        static_cast<uint8_t>(this->get_pixel_stride_()), this->pin_,
+        &this->memory_budget_);
+  }
+#endif
   if (!this->segment_light_states_.empty()) {
-    this->segment_coord_runners_.reserve(MAX_CFX_SEGMENTS);
+    this->segment_coord_runners_.reserve(this->segment_light_states_.size());
   }
 
   // --- Phase 2: Set up Event-Driven State Synchronization ---
@@ -3076,6 +3238,7 @@ void CFXLightOutput::setup() {
              this->rmt_symbols_, this->rmt_mem_block_symbols_,
              this->get_rmt_physical_led_count_());
   }
+  this->memory_budget_.log_summary(TAG, this->pin_);
   this->setup_completed_ = true;
 }
 
@@ -3098,27 +3261,54 @@ void CFXLightOutput::setup_rmt_() {
   this->rmt_mem_block_symbols_ = 0;
   this->rmt_alloc_index_ = 0;
 
-  // Allocate RMT transmission buffer
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
-  RAMAllocator<uint8_t> rmt_alloc(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
-  this->rmt_buf_ = rmt_alloc.allocate(buffer_size);
+  // Allocate RMT transmission buffer (read by the encoder ISR: internal)
+  this->rmt_buf_ =
+      this->memory_budget_.allocate(CFX_MEM_ISR, buffer_size, "rmt transmit");
   if (this->rmt_buf_ == nullptr) {
     ESP_LOGE(TAG, "Cannot allocate RMT transmit buffer (%u bytes)!",
              static_cast<unsigned>(buffer_size));
     this->mark_failed();
     return;
   }
-#else
-  RAMAllocator<rmt_symbol_word_t> rmt_allocator(
-      RAMAllocator<rmt_symbol_word_t>::ALLOC_INTERNAL);
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8 + 1);
-  if (this->rmt_buf_ == nullptr) {
-    ESP_LOGE(TAG, "Cannot allocate RMT transmit buffer (%u symbols)!",
-             static_cast<unsigned>(buffer_size * 8 + 1));
-    this->mark_failed();
-    return;
+  memset(this->rmt_buf_, 0, buffer_size);
+  const size_t pixel_offset =
+      this->sacrificial_pixel_ ? this->get_pixel_stride_() : 0;
+  if (this->buf_ == nullptr) {
+    // Zero-copy: the partner buffer stands in for both the pixel buffer and
+    // the back buffer; effects render into whichever is off the wire.
+    this->rmt_zc_other_ = this->memory_budget_.allocate(
+        CFX_MEM_ISR, buffer_size, "rmt zero-copy partner");
+    if (this->rmt_zc_other_ != nullptr) {
+      memset(this->rmt_zc_other_, 0, buffer_size);
+      this->buf_ = this->rmt_buf_ + pixel_offset;
+      ESP_LOGI(TAG, "RMT zero-copy: rendering into %u-byte transmit buffers",
+               static_cast<unsigned>(buffer_size));
+    } else {
+      ESP_LOGW(TAG, "RMT zero-copy partner (%u bytes) unavailable — using a "
+               "separate pixel buffer",
+               static_cast<unsigned>(buffer_size));
+      this->buf_ = this->memory_budget_.allocate(
+          CFX_MEM_HOT, this->get_buffer_size_(), "pixels");
+      if (this->buf_ == nullptr) {
+        ESP_LOGE(TAG, "Cannot allocate LED buffer (%u bytes)!",
+                 static_cast<unsigned>(this->get_buffer_size_()));
+        this->mark_failed();
+        return;
+      }
+      memset(this->buf_, 0, this->get_buffer_size_());
+    }
+  }
+  if (!this->rmt_zero_copy_()) {
+    // Byte buffers are cheap (the encoder expands them on the fly), so every
+    // strip gets a second one and encodes frame N+1 while N is on the wire.
+    this->rmt_buf_back_ = this->memory_budget_.allocate(
+        CFX_MEM_ISR, buffer_size, "rmt transmit back");
+    if (this->rmt_buf_back_ == nullptr) {
+      ESP_LOGW(TAG, "RMT back buffer (%u bytes) unavailable — render and "
+               "transmit will not overlap",
+               static_cast<unsigned>(buffer_size));
+    }
   }
-#endif
 
   // Auto-detect RMT symbol buffer size from chip variant
   if (this->rmt_symbols_ == 0) {
@@ -3142,7 +3332,8 @@ void CFXLightOutput::setup_rmt_() {
   channel.clk_src = RMT_CLK_SRC_DEFAULT;
   channel.resolution_hz = rmt_resolution_hz();
   channel.gpio_num = gpio_num_t(this->pin_);
-  channel.trans_queue_depth = 1;
+  // Room for the back buffer's transaction behind the one on the wire.
+  channel.trans_queue_depth = this->rmt_buf_back_ != nullptr ? 2 : 1;
   channel.flags.invert_out = 0;
 #if defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32S3) || \
     defined(CONFIG_IDF_TARGET_ESP32P4)
@@ -3257,10 +3448,9 @@ void CFXLightOutput::setup_rmt_() {
     return;
   }
 #else
-  rmt_copy_encoder_config_t encoder;
-  memset(&encoder, 0, sizeof(encoder));
-  if (rmt_new_copy_encoder(&encoder, &this->encoder_) != ESP_OK) {
-    ESP_LOGE(TAG, "Copy encoder creation failed");
+  ESP_LOGI(TAG, "RMT encoder: pin=%u lut+reset", this->pin_);
+  if (cfx_rmt_new_lut_encoder(this->params_, &this->encoder_) != ESP_OK) {
+    ESP_LOGE(TAG, "LED symbol-table encoder creation failed");
     this->mark_failed();
     return;
   }
@@ -3285,6 +3475,7 @@ void CFXLightOutput::setup_rmt_() {
     // Pass the address of this instance's flag as ctx.
     // Each RMT instance gets its own ctx pointer — no shared global state.
     this->rmt_done_ctx_.in_flight = &this->rmt_tx_in_flight_;
+    this->rmt_done_ctx_.queued = &this->rmt_tx_queued_;
     this->rmt_done_ctx_.dma_enabled = this->rmt_dma_enabled_;
     if (rmt_tx_register_event_callbacks(this->channel_, &rmt_cbs,
                                         (void *)&this->rmt_done_ctx_) != ESP_OK) {
@@ -3478,14 +3669,16 @@ void CFXLightOutput::setup_parallel_() {
              "Parallel backend %s group '%s' configured for deferred init: "
              "lanes=%u pclk=%" PRIu32
              "Hz frame=%u bytes chunk=%u leds/%u bytes alloc=%u "
-             "data=[%u,%u,%u,%u]",
+             "data=[%u,%u,%u,%u,%u,%u,%u,%u]",
              PARALLEL_BACKEND_REV, g_parallel_group.name.c_str(),
              g_parallel_group.lane_count, PARALLEL_PCLK_HZ,
              static_cast<unsigned>(frame_size), g_parallel_group.chunk_leds,
              static_cast<unsigned>(g_parallel_group.chunk_frame_size),
              static_cast<unsigned>(g_parallel_group.chunk_alloc_size),
              g_parallel_group.lane_pins[0], g_parallel_group.lane_pins[1],
-             g_parallel_group.lane_pins[2], g_parallel_group.lane_pins[3]);
+             g_parallel_group.lane_pins[2], g_parallel_group.lane_pins[3],
+             g_parallel_group.lane_pins[4], g_parallel_group.lane_pins[5],
+             g_parallel_group.lane_pins[6], g_parallel_group.lane_pins[7]);
 #else
     ESP_LOGI(TAG,
              "Parallel backend %s group '%s' configured for deferred init: "
@@ -3664,6 +3857,12 @@ bool CFXLightOutput::init_parallel_backend_() {
            PARALLEL_CANARY_VALUE, PARALLEL_CANARY_BYTES);
   }
   g_parallel_group.frame_buf = g_parallel_group.frame_bufs[0];
+  // Shared by the group; booked to the output that brought it up.
+  for (uint8_t i = 0; i < PARALLEL_TX_BUFFER_COUNT; i++) {
+    this->memory_budget_.note(CFX_MEM_DMA, g_parallel_group.frame_bufs[i],
+                              g_parallel_group.chunk_alloc_size,
+                              "parallel dma (group)");
+  }
 
   auto *descs = g_parallel_group.classic_descs;
   parallel_dma_desc_init_(&descs[PARALLEL_CLASSIC_SILENCE_DESC_A],
@@ -4064,6 +4263,12 @@ bool CFXLightOutput::init_parallel_backend_() {
 
       g_parallel_i80.frame_buf = g_parallel_i80.frame_bufs[0];
       g_parallel_i80.ready = true;
+      // Shared by every group; booked to the output that brought it up.
+      for (uint8_t i = 0; i < g_parallel_i80.buffer_count; i++) {
+        this->memory_budget_.note(CFX_MEM_DMA, g_parallel_i80.frame_bufs[i],
+                                  g_parallel_i80.chunk_alloc_size,
+                                  "parallel dma (shared)");
+      }
       for (uint8_t gi = 0; gi < PARALLEL_MAX_GROUPS; gi++) {
         auto &group = g_parallel_groups[gi];
         if (!group.configured) {
@@ -4252,6 +4457,80 @@ bool CFXLightOutput::force_parallel_shutdown_blackout_() {
   return queued && completed;
 }
 
+// --- Parallel frame kernel ---
+//
+// One byte slot (one byte from each of the 8 bus lanes) becomes 8 bits of
+// PARALLEL_SYMBOL_SAMPLES samples: enable mask, data mask, 0. With three
+// samples per bit that is 24 bytes, i.e. six whole DMA words per slot.
+static_assert(PARALLEL_SYMBOL_SAMPLES == 3,
+              "parallel kernel emits three samples per bit");
+
+// 8x8 bit transpose in two 32-bit halves (Hacker's Delight 7-3): masks[b]
+// holds bit (7 - b) of every lane, lane k in bit k.
+static inline void parallel_transpose8_(const uint8_t lanes[8],
+                                        uint8_t masks[8]) {
+  uint32_t x = (static_cast<uint32_t>(lanes[7]) << 24) |
+               (static_cast<uint32_t>(lanes[6]) << 16) |
+               (static_cast<uint32_t>(lanes[5]) << 8) | lanes[4];
+  uint32_t y = (static_cast<uint32_t>(lanes[3]) << 24) |
+               (static_cast<uint32_t>(lanes[2]) << 16) |
+               (static_cast<uint32_t>(lanes[1]) << 8) | lanes[0];
+  uint32_t t = (x ^ (x >> 7)) & 0x00AA00AAu;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAu;
+  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCCu;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCu;
+  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0u) | ((y >> 4) & 0x0F0F0F0Fu);
+  y = ((x << 4) & 0xF0F0F0F0u) | (y & 0x0F0F0F0Fu);
+  masks[0] = static_cast<uint8_t>(t >> 24);
+  masks[1] = static_cast<uint8_t>(t >> 16);
+  masks[2] = static_cast<uint8_t>(t >> 8);
+  masks[3] = static_cast<uint8_t>(t);
+  masks[4] = static_cast<uint8_t>(y >> 24);
+  masks[5] = static_cast<uint8_t>(y >> 16);
+  masks[6] = static_cast<uint8_t>(y >> 8);
+  masks[7] = static_cast<uint8_t>(y);
+}
+
+// Classic ESP32 I2S sends each 32-bit word's 16-bit halves swapped
+// (sample order 2, 3, 0, 1).
+static inline uint32_t parallel_dma_word_(uint32_t word) {
+#if defined(CONFIG_IDF_TARGET_ESP32)
+  return (word << 16) | (word >> 16);
+#else
+  return word;
+#endif
+}
+
+static inline void emit_parallel_byte_slot_(uint8_t *out, uint8_t enable_mask,
+                                            const uint8_t lanes[8]) {
+  uint8_t masks[8];
+  parallel_transpose8_(lanes, masks);
+  const uint32_t a = enable_mask;
+  uint32_t words[6];
+  for (uint8_t half = 0; half < 2; half++) {
+    const uint8_t *m = masks + half * 4;
+    // Samples: a m0 0 | a m1 0 | a m2 0 | a m3 0, little-endian words.
+    words[half * 3 + 0] = parallel_dma_word_(
+        a | (static_cast<uint32_t>(m[0]) << 8) | (a << 24));
+    words[half * 3 + 1] = parallel_dma_word_(
+        m[1] | (a << 16) | (static_cast<uint32_t>(m[2]) << 24));
+    words[half * 3 + 2] =
+        parallel_dma_word_((a << 8) | (static_cast<uint32_t>(m[3]) << 16));
+  }
+  if ((reinterpret_cast<uintptr_t>(out) & 3u) == 0) {
+    auto *dst = reinterpret_cast<uint32_t *>(out);
+    for (uint8_t i = 0; i < 6; i++) {
+      dst[i] = words[i];
+    }
+  } else {
+    memcpy(out, words, sizeof(words));
+  }
+}
+
 bool CFXLightOutput::build_parallel_frame_(uint8_t *dest, size_t len,
                                            uint16_t start_led,
                                            uint16_t led_count,
@@ -4275,111 +4554,76 @@ bool CFXLightOutput::build_parallel_frame_(uint8_t *dest, size_t len,
   if (len >= needed + PARALLEL_CANARY_BYTES) {
     memset(dest + needed, PARALLEL_CANARY_VALUE, PARALLEL_CANARY_BYTES);
   }
-  uint8_t *lane_bufs[PARALLEL_MAX_LANES] = {};
-  uint8_t lane_scales[PARALLEL_MAX_LANES] = {};
+  CFXLightOutput *lane_outputs[PARALLEL_MAX_LANES] = {};
+  const uint8_t *lane_bufs[PARALLEL_MAX_LANES] = {};
+  const uint8_t *lane_luts[PARALLEL_MAX_LANES] = {};
+  uint16_t lane_leds[PARALLEL_MAX_LANES] = {};
+  uint8_t lane_bus[PARALLEL_MAX_LANES] = {};
+  uint8_t lane_white_byte[PARALLEL_MAX_LANES] = {};
+  uint32_t lane_sums[PARALLEL_MAX_LANES] = {};
+  uint32_t lane_white[PARALLEL_MAX_LANES] = {};
+  uint8_t active_lane_count = 0;
   uint8_t active_lane_mask = 0;
   for (uint8_t lane = 0; lane < g_parallel_group.lane_count; lane++) {
     auto *lane_output = g_parallel_group.outputs[lane];
-    if (lane_output != nullptr && lane_output->buf_ != nullptr) {
-      lane_bufs[lane] = lane_output->buf_;
-      lane_scales[lane] = lane_output->get_power_transmit_scale_();
-      active_lane_mask |=
-          static_cast<uint8_t>(1u << (g_parallel_group.bit_offset + lane));
+    const uint8_t bus_lane =
+        static_cast<uint8_t>(g_parallel_group.bit_offset + lane);
+    if (lane_output != nullptr && lane_output->buf_ != nullptr &&
+        bus_lane < PARALLEL_I80_BUS_WIDTH) {
+      lane_outputs[active_lane_count] = lane_output;
+      lane_bufs[active_lane_count] = lane_output->buf_;
+      // The transfer table the RMT and SPI kernels scale with, so a lane
+      // sends the same bytes at a given scale as any other transport (and
+      // as the power estimate assumes), for one load per byte.
+      lane_luts[active_lane_count] = lane_output->get_power_transfer_lut_();
+      lane_white_byte[active_lane_count] =
+          lane_output->has_white_channel() ? (lane_output->is_wrgb_ ? 0 : 3)
+                                           : 0xFF;
+      lane_leds[active_lane_count] = lane_output->num_leds_;
+      lane_bus[active_lane_count] = bus_lane;
+      active_lane_count++;
+      active_lane_mask |= static_cast<uint8_t>(1u << bus_lane);
     }
   }
   uint8_t *out = dest;
   uint8_t *const data_end = dest + led_data_size;
-
-#if defined(CONFIG_IDF_TARGET_ESP32)
-  static const uint8_t SAMPLE_OFFSET_MAP[4] = {2, 3, 0, 1};
-#endif
+  const size_t led_symbol_bytes =
+      static_cast<size_t>(stride) * 8u * PARALLEL_SYMBOL_SAMPLES;
 
   for (uint16_t offset = 0; offset < led_count; offset++) {
     const uint16_t led = start_led + offset;
+    if (out + led_symbol_bytes > data_end) {
+      ESP_LOGE(TAG,
+               "Parallel frame writer overflow guard tripped "
+               "(start=%u leds=%u data=%u total=%u)",
+               start_led, led_count, static_cast<unsigned>(led_data_size),
+               static_cast<unsigned>(needed));
+      return false;
+    }
+    const size_t led_offset = static_cast<size_t>(led) * stride;
     for (uint8_t byte_index = 0; byte_index < stride; byte_index++) {
-      if (out + (8u * PARALLEL_SYMBOL_SAMPLES) > data_end) {
-        ESP_LOGE(TAG,
-                 "Parallel frame writer overflow guard tripped "
-                 "(start=%u leds=%u data=%u total=%u)",
-                 start_led, led_count, static_cast<unsigned>(led_data_size),
-                 static_cast<unsigned>(needed));
-        return false;
-      }
-      uint8_t *const symbol_out = out;
-      const size_t byte_offset = static_cast<size_t>(led) * stride + byte_index;
-      uint8_t lane_value0 = 0;
-      uint8_t lane_value1 = 0;
-      uint8_t lane_value2 = 0;
-      uint8_t lane_value3 = 0;
-      const uint8_t lane_bit0 =
-          static_cast<uint8_t>(1u << (g_parallel_group.bit_offset + 0u));
-      const uint8_t lane_bit1 =
-          static_cast<uint8_t>(1u << (g_parallel_group.bit_offset + 1u));
-      const uint8_t lane_bit2 =
-          static_cast<uint8_t>(1u << (g_parallel_group.bit_offset + 2u));
-      const uint8_t lane_bit3 =
-          static_cast<uint8_t>(1u << (g_parallel_group.bit_offset + 3u));
-      if (lane_bufs[0] != nullptr && led < g_parallel_group.outputs[0]->num_leds_) {
-        lane_value0 = lane_bufs[0][byte_offset];
-        if (lane_scales[0] < 255) {
-          lane_value0 = static_cast<uint8_t>(
-              (static_cast<uint16_t>(lane_value0) * lane_scales[0]) / 255u);
-        }
-      }
-      if (lane_bufs[1] != nullptr && led < g_parallel_group.outputs[1]->num_leds_) {
-        lane_value1 = lane_bufs[1][byte_offset];
-        if (lane_scales[1] < 255) {
-          lane_value1 = static_cast<uint8_t>(
-              (static_cast<uint16_t>(lane_value1) * lane_scales[1]) / 255u);
-        }
-      }
-      if (lane_bufs[2] != nullptr && led < g_parallel_group.outputs[2]->num_leds_) {
-        lane_value2 = lane_bufs[2][byte_offset];
-        if (lane_scales[2] < 255) {
-          lane_value2 = static_cast<uint8_t>(
-              (static_cast<uint16_t>(lane_value2) * lane_scales[2]) / 255u);
-        }
-      }
-      if (lane_bufs[3] != nullptr && led < g_parallel_group.outputs[3]->num_leds_) {
-        lane_value3 = lane_bufs[3][byte_offset];
-        if (lane_scales[3] < 255) {
-          lane_value3 = static_cast<uint8_t>(
-              (static_cast<uint16_t>(lane_value3) * lane_scales[3]) / 255u);
-        }
-      }
-      for (uint8_t bit = 0; bit < 8; bit++) {
-        uint8_t one_mask = 0;
-        const uint8_t bit_mask = static_cast<uint8_t>(0x80u >> bit);
-        if ((lane_value0 & bit_mask) != 0) {
-          one_mask |= lane_bit0;
-        }
-        if ((lane_value1 & bit_mask) != 0) {
-          one_mask |= lane_bit1;
-        }
-        if ((lane_value2 & bit_mask) != 0) {
-          one_mask |= lane_bit2;
+      uint8_t lane_values[PARALLEL_I80_BUS_WIDTH] = {};
+      for (uint8_t i = 0; i < active_lane_count; i++) {
+        if (led >= lane_leds[i]) {
+          continue;
         }
-        if ((lane_value3 & bit_mask) != 0) {
-          one_mask |= lane_bit3;
+        const uint8_t value = lane_bufs[i][led_offset + byte_index];
+        const uint8_t wire =
+            lane_luts[i] != nullptr ? lane_luts[i][value] : value;
+        lane_values[lane_bus[i]] = wire;
+        lane_sums[i] += wire;
+        if (byte_index == lane_white_byte[i]) {
+          lane_white[i] += wire;
         }
-        const uint8_t sample_base =
-            static_cast<uint8_t>(bit * PARALLEL_SYMBOL_SAMPLES);
-#if defined(CONFIG_IDF_TARGET_ESP32)
-        symbol_out[(sample_base & 0xFCu) | SAMPLE_OFFSET_MAP[sample_base & 0x03u]] =
-            active_lane_mask;
-        symbol_out[((sample_base + 1u) & 0xFCu) |
-                   SAMPLE_OFFSET_MAP[(sample_base + 1u) & 0x03u]] = one_mask;
-        symbol_out[((sample_base + 2u) & 0xFCu) |
-                   SAMPLE_OFFSET_MAP[(sample_base + 2u) & 0x03u]] = 0;
-#else
-        symbol_out[sample_base] = active_lane_mask;
-        symbol_out[sample_base + 1u] = one_mask;
-        symbol_out[sample_base + 2u] = 0;
-#endif
       }
+      emit_parallel_byte_slot_(out, active_lane_mask, lane_values);
       out += 8u * PARALLEL_SYMBOL_SAMPLES;
     }
   }
+  for (uint8_t i = 0; i < active_lane_count; i++) {
+    lane_outputs[i]->parallel_power_sums_.channels += lane_sums[i];
+    lane_outputs[i]->parallel_power_sums_.white += lane_white[i];
+  }
 
   if (out != data_end) {
     ESP_LOGE(TAG,
@@ -4425,10 +4669,6 @@ bool CFXLightOutput::build_parallel_shared_frame_(
   uint8_t *out = dest;
   uint8_t *const data_end = dest + led_data_size;
 
-#if defined(CONFIG_IDF_TARGET_ESP32)
-  static const uint8_t SAMPLE_OFFSET_MAP[4] = {2, 3, 0, 1};
-#endif
-
   struct SharedBuildGroup {
     bool active{false};
     uint8_t stride{0};
@@ -4438,7 +4678,10 @@ bool CFXLightOutput::build_parallel_shared_frame_(
     CFXLightOutput *outputs[PARALLEL_MAX_LANES]{};
     uint32_t byte_limits[PARALLEL_MAX_LANES]{};
     uint8_t bus_lanes[PARALLEL_MAX_LANES]{};
-    uint8_t scales[PARALLEL_MAX_LANES]{};
+    const uint8_t *luts[PARALLEL_MAX_LANES]{};
+    uint8_t white_bytes[PARALLEL_MAX_LANES]{};
+    uint32_t sums[PARALLEL_MAX_LANES]{};
+    uint32_t white[PARALLEL_MAX_LANES]{};
   };
 
   SharedBuildGroup build_groups[PARALLEL_MAX_GROUPS] = {};
@@ -4471,7 +4714,11 @@ bool CFXLightOutput::build_parallel_shared_frame_(
       build_group.byte_limits[lane] =
           static_cast<uint32_t>(lane_output->num_leds_) * build_group.stride;
       build_group.bus_lanes[lane] = bus_lane;
-      build_group.scales[lane] = lane_output->get_power_transmit_scale_();
+      // Same transfer table as build_parallel_frame_().
+      build_group.luts[lane] = lane_output->get_power_transfer_lut_();
+      build_group.white_bytes[lane] =
+          lane_output->has_white_channel() ? (lane_output->is_wrgb_ ? 0 : 3)
+                                           : 0xFF;
       build_group.lane_mask =
           static_cast<uint8_t>(build_group.lane_mask | (1u << bus_lane));
     }
@@ -4508,60 +4755,28 @@ bool CFXLightOutput::build_parallel_shared_frame_(
             byte_slot >= build_group.byte_limits[lane]) {
           continue;
         }
-        uint8_t lane_value = lane_output->buf_[byte_slot];
-        const uint8_t scale = build_group.scales[lane];
-        if (scale < 255) {
-          lane_value = static_cast<uint8_t>(
-              (static_cast<uint16_t>(lane_value) * scale) / 255u);
+        const uint8_t lane_value = lane_output->buf_[byte_slot];
+        const uint8_t *lut = build_group.luts[lane];
+        const uint8_t wire = lut != nullptr ? lut[lane_value] : lane_value;
+        lane_values[build_group.bus_lanes[lane]] = wire;
+        build_group.sums[lane] += wire;
+        if ((byte_slot & 3u) == build_group.white_bytes[lane]) {
+          build_group.white[lane] += wire;
         }
-        lane_values[build_group.bus_lanes[lane]] = lane_value;
       }
     }
 
-    uint8_t *const symbol_out = out;
-    for (uint8_t bit = 0; bit < 8; bit++) {
-      uint8_t one_mask = 0;
-      const uint8_t bit_mask = static_cast<uint8_t>(0x80u >> bit);
-      if ((lane_values[0] & bit_mask) != 0) {
-        one_mask |= 0x01u;
-      }
-      if ((lane_values[1] & bit_mask) != 0) {
-        one_mask |= 0x02u;
-      }
-      if ((lane_values[2] & bit_mask) != 0) {
-        one_mask |= 0x04u;
-      }
-      if ((lane_values[3] & bit_mask) != 0) {
-        one_mask |= 0x08u;
-      }
-      if ((lane_values[4] & bit_mask) != 0) {
-        one_mask |= 0x10u;
-      }
-      if ((lane_values[5] & bit_mask) != 0) {
-        one_mask |= 0x20u;
-      }
-      if ((lane_values[6] & bit_mask) != 0) {
-        one_mask |= 0x40u;
-      }
-      if ((lane_values[7] & bit_mask) != 0) {
-        one_mask |= 0x80u;
+    emit_parallel_byte_slot_(out, active_lane_mask, lane_values);
+    out += 8u * PARALLEL_SYMBOL_SAMPLES;
+  }
+  for (auto &build_group : build_groups) {
+    for (uint8_t lane = 0; lane < build_group.lane_count; lane++) {
+      if (build_group.outputs[lane] != nullptr) {
+        auto &sums = build_group.outputs[lane]->parallel_power_sums_;
+        sums.channels += build_group.sums[lane];
+        sums.white += build_group.white[lane];
       }
-      const uint8_t sample_base =
-          static_cast<uint8_t>(bit * PARALLEL_SYMBOL_SAMPLES);
-#if defined(CONFIG_IDF_TARGET_ESP32)
-      symbol_out[(sample_base & 0xFCu) | SAMPLE_OFFSET_MAP[sample_base & 0x03u]] =
-          active_lane_mask;
-      symbol_out[((sample_base + 1u) & 0xFCu) |
-                 SAMPLE_OFFSET_MAP[(sample_base + 1u) & 0x03u]] = one_mask;
-      symbol_out[((sample_base + 2u) & 0xFCu) |
-                 SAMPLE_OFFSET_MAP[(sample_base + 2u) & 0x03u]] = 0;
-#else
-      symbol_out[sample_base] = active_lane_mask;
-      symbol_out[sample_base + 1u] = one_mask;
-      symbol_out[sample_base + 2u] = 0;
-#endif
     }
-    out += 8u * PARALLEL_SYMBOL_SAMPLES;
   }
 
   if (out != data_end) {
@@ -4673,6 +4888,7 @@ bool CFXLightOutput::flush_parallel_shared_groups_(uint8_t group_mask) {
       if (lane_required == 0 && lane_output->buf_ != nullptr) {
         memset(lane_output->buf_, 0, lane_output->get_buffer_size_());
       }
+      lane_output->begin_parallel_power_frame_();
     }
     if (group_stride[gi] == 0) {
       continue;
@@ -4865,6 +5081,11 @@ bool CFXLightOutput::flush_parallel_shared_groups_(uint8_t group_mask) {
     group.chunk_tx_count += chunks_this_frame;
     group.last_tx_buffer_index = last_buffer_index;
     group.last_tx_leds = active_required_leds[gi];
+    for (uint8_t lane = 0; lane < group.lane_count; lane++) {
+      if (group.outputs[lane] != nullptr) {
+        group.outputs[lane]->report_parallel_power_frame_();
+      }
+    }
   }
 
   if (parallel_diag_log_due) {
@@ -5044,6 +5265,7 @@ void CFXLightOutput::flush_parallel_() {
     if (lane_required_leds[lane] == 0 && lane_output->buf_ != nullptr) {
       memset(lane_output->buf_, 0, lane_output->get_buffer_size_());
     }
+    lane_output->begin_parallel_power_frame_();
   }
   if (active_required_leds > g_parallel_group.max_leds) {
     active_required_leds = g_parallel_group.max_leds;
@@ -5123,7 +5345,8 @@ void CFXLightOutput::flush_parallel_() {
     }
   }
 
-  // Phase-1 diag: capture lane_scales for the TX log.
+  // Phase-1 diag: capture lane_scales for the TX log. The TX log lines only
+  // print the first four lanes; wider groups are captured but not logged.
   uint8_t diag_lane_scales[PARALLEL_MAX_LANES] = {};
   // Phase-1 diag: capture the buf_ value at the exact byte_offset the encoder
   // uses, AFTER scrub but BEFORE frame build - to verify data survives.
@@ -5566,6 +5789,11 @@ void CFXLightOutput::flush_parallel_() {
 
   g_parallel_group.tx_count++;
   g_parallel_group.last_tx_leds = active_required_leds;
+  for (uint8_t lane = 0; lane < g_parallel_group.lane_count; lane++) {
+    if (g_parallel_group.outputs[lane] != nullptr) {
+      g_parallel_group.outputs[lane]->report_parallel_power_frame_();
+    }
+  }
   if (parallel_diag_log_due) {
     probe_first_encoded_samples();
     ESP_LOGI(TAG,
@@ -5965,6 +6193,19 @@ uint8_t CFXLightOutput::get_spi_end_frame_byte_() const {
   return (this->chipset_ == CHIPSET_SK9822) ? 0x00 : 0xFF;
 }
 
+void CFXLightOutput::init_spi_frame_(uint8_t *frame) const {
+  const size_t frame_size = this->get_spi_frame_size_();
+  memset(frame, 0, frame_size);
+  // 1. Start frame: 32 bits of 0x00. 2. LED frames: 0xFF + black.
+  uint8_t *ptr = frame + 4;
+  for (uint16_t i = 0; i < this->num_leds_; i++, ptr += 4) {
+    *ptr = 0xFF;  // Global brightness: max (11111111)
+  }
+  // 3. End frame
+  const size_t end_size = this->get_spi_end_frame_size_();
+  memset(ptr, this->get_spi_end_frame_byte_(), end_size);
+}
+
 size_t CFXLightOutput::get_spi_frame_size_() const {
   // Start frame (4) + LED frames (num_leds * 4) + end frame
   size_t raw = 4 + (this->num_leds_ * 4) + this->get_spi_end_frame_size_();
@@ -6034,66 +6275,220 @@ bool CFXLightOutput::wait_for_rmt_tx_(uint32_t timeout_ms, const char *context)
   if (wait_us > this->perf_diag_max_wait_us_) {
     this->perf_diag_max_wait_us_ = wait_us;
   }
+#ifdef USE_CFX_PROFILER
+  chimera_fx::CFXProfiler::get().record_stage(chimera_fx::CFX_STAGE_DMA_WAIT,
+                                              wait_us);
+#endif
+#ifdef USE_CFX_TRACE
+  chimera_fx::CFXTrace::get().span(chimera_fx::CFX_TRACE_DMA_DONE,
+                                   wait_start_us, wait_us, this->pin_);
+#endif
   this->rmt_wait_count_++;
   return true;
 }
 
-bool CFXLightOutput::wait_for_spi_tx_(uint32_t timeout_ms, const char *context) {
-  if (!this->spi_tx_in_flight_ || this->spi_device_ == nullptr) {
-    return true;
+bool CFXLightOutput::rmt_tx_slot_free_() const {
+  return !this->rmt_tx_in_flight_ ||
+         (this->rmt_double_buffered_() && this->rmt_tx_queued_ < 2);
+}
+
+// Ping-pong buffers: the one about to be filled last held the frame before
+// the previous launch, so it is also missing that launch's changes. Bit 0 of
+// primed_mask is the buffer being filled, bit 1 its partner.
+static void widen_for_stale_buffer_(uint16_t &lo, uint16_t &hi,
+                                    uint16_t &prev_lo, uint16_t &prev_hi,
+                                    uint8_t &primed_mask, uint16_t num_leds) {
+  const uint16_t cur_lo = lo;
+  const uint16_t cur_hi = hi;
+  if ((primed_mask & 1u) == 0) {
+    lo = 0;
+    hi = num_leds;
+  } else if (prev_lo < prev_hi) {
+    lo = lo < hi ? std::min(lo, prev_lo) : prev_lo;
+    hi = std::max(hi, prev_hi);
   }
+  prev_lo = cur_lo;
+  prev_hi = cur_hi;
+  primed_mask |= 1u;
+}
 
-  const uint32_t wait_start_us = micros();
-  spi_transaction_t *ret_trans = nullptr;
-  esp_err_t err = spi_device_get_trans_result(
-      this->spi_device_, &ret_trans, pdMS_TO_TICKS(timeout_ms));
-  const uint32_t wait_us = micros() - wait_start_us;
+static inline uint8_t swap_primed_mask_(uint8_t primed_mask) {
+  return static_cast<uint8_t>(((primed_mask & 1u) << 1) | (primed_mask >> 1));
+}
 
-  if (err == ESP_OK) {
-    this->spi_tx_in_flight_ = false;
-    if (g_spi_dma_active_count > 0) {
-      g_spi_dma_active_count--;
-    }
-    this->spi_wait_count_++;
-    // Capture actual wire-time for perf diag (time spent waiting = DMA transfer time).
-    if (wait_us > this->perf_diag_max_wait_us_) {
-      this->perf_diag_max_wait_us_ = wait_us;
-    }
-    this->perf_diag_total_wait_us_ += wait_us;
-    if (ret_trans != &this->spi_trans_) {
-      ESP_LOGW(TAG,
-               "SPI TX completion mismatch during %s (expected=%p got=%p)",
-               context, &this->spi_trans_, ret_trans);
-    }
-    return true;
+void CFXLightOutput::widen_for_back_buffer_(uint16_t &lo, uint16_t &hi) {
+  if (!this->rmt_double_buffered_()) {
+    return;
   }
+  const uint16_t cur_lo = lo;
+  const uint16_t cur_hi = hi;
+  widen_for_stale_buffer_(lo, hi, this->rmt_prev_lo_, this->rmt_prev_hi_,
+                          this->rmt_primed_mask_, this->num_leds_);
+  this->perf_diag_total_encoded_leds_ += (hi - lo) - (cur_hi - cur_lo);
+}
 
-  if (err == ESP_ERR_TIMEOUT) {
-    this->spi_wait_timeout_count_++;
-    ESP_LOGW(TAG,
-             "SPI TX wait timeout during %s (%" PRIu32 " ms, waits=%" PRIu32
-             ", timeouts=%" PRIu32 ", queue_err=%" PRIu32 ")",
-             context, timeout_ms, this->spi_wait_count_,
-             this->spi_wait_timeout_count_, this->spi_queue_error_count_);
+// Zero-copy frames: rmt_buf_ holds what effects committed (buf_ points into
+// it), rmt_zc_other_ the frame before, off the wire by the time flush_rmt_()
+// gets here since only one transaction is ever queued.
+uint8_t *CFXLightOutput::stage_rmt_zero_copy_(uint16_t &lo, uint16_t &hi) {
+  const uint8_t stride = this->get_pixel_stride_();
+  const size_t prefix = this->sacrificial_pixel_ ? stride : 0;
+  uint8_t *other = this->rmt_zc_other_ + prefix;
+  if (this->get_power_transfer_lut_() != nullptr ||
+      !this->stage_rmt_unity_sums_(lo, hi)) {
+    // buf_ must keep the unscaled frame, so the scaled one goes out of the
+    // partner and the partner stops mirroring buf_.
+    this->rmt_zc_other_synced_ = false;
+    this->prep_transmit_(other, 0, this->num_leds_, this->rmt_buf_back_sums_);
+    this->limit_staged_frame_(other, this->rmt_buf_back_sums_);
+    return this->rmt_zc_other_;
+  }
+  return this->rmt_buf_;
+}
+
+// Unity: rmt_buf_ goes out as is. Its sums follow from the partner's by the
+// same delta prep_transmit_() applies, the partner still being last frame.
+// False when the limiter cuts the frame, which then needs a scaled copy.
+bool CFXLightOutput::stage_rmt_unity_sums_(uint16_t &lo, uint16_t &hi) {
+  const uint8_t stride = this->get_pixel_stride_();
+  const size_t prefix = this->sacrificial_pixel_ ? stride : 0;
+  const uint8_t *other = this->rmt_zc_other_ + prefix;
+  CFXPowerSums &sums = this->rmt_buf_sums_;
+  if (!this->rmt_zc_other_synced_ || !this->rmt_buf_back_sums_.valid) {
+    lo = 0;
+    hi = this->num_leds_;
+    sums = {};
   } else {
-    ESP_LOGW(TAG, "SPI TX wait failed during %s (err=%d)", context, err);
+    sums = this->rmt_buf_back_sums_;
+    sums.channels -= this->transmit_sum_(other, lo, hi, stride);
+    sums.white -= this->sum_wire_white_(other, lo, hi);
   }
-
-  this->status_set_warning();
-  return false;
+  if (this->zones_active_()) {
+    this->sum_zoned_(this->buf_, lo, hi, stride, sums);
+  } else {
+    sums.channels += this->transmit_sum_(this->buf_, lo, hi, stride);
+    sums.white += this->sum_wire_white_(this->buf_, lo, hi);
+  }
+  sums.scale = 255;
+  sums.valid = true;
+  this->power_sums_ = sums;
+  return this->report_power_frame_(sums) == 255;
 }
 
-void CFXLightOutput::setup_spi_() {
-  size_t frame_size = this->get_spi_frame_size_();
-
-  // Allocate DMA-capable frame buffer (must be 32-bit aligned internal RAM)
-  this->spi_frame_buf_ = (uint8_t *)heap_caps_malloc(frame_size, MALLOC_CAP_DMA);
-  if (this->spi_frame_buf_ == nullptr) {
-    ESP_LOGE(TAG, "Cannot allocate SPI frame buffer (%u bytes, DMA)!", frame_size);
+void CFXLightOutput::finish_rmt_zero_copy_(uint8_t *launched, uint16_t lo,
+                                           uint16_t hi) {
+  if (launched != this->rmt_buf_) {
+    return;  // Scaled frame from the partner; keep rendering into rmt_buf_.
+  }
+  // Bring the partner up to the frame just launched (only the dirty range
+  // differs), then let effects render the next frame into it.
+  const uint8_t stride = this->get_pixel_stride_();
+  const size_t prefix = this->sacrificial_pixel_ ? stride : 0;
+  const size_t start = static_cast<size_t>(lo) * stride;
+  memcpy(this->rmt_zc_other_ + prefix + start, this->buf_ + start,
+         static_cast<size_t>(hi - lo) * stride);
+  std::swap(this->rmt_buf_, this->rmt_zc_other_);
+  this->rmt_buf_back_sums_ = this->rmt_buf_sums_;
+  this->rmt_zc_other_synced_ = true;
+  this->buf_ = this->rmt_buf_ + prefix;
+}
+
+bool CFXLightOutput::drain_spi_tx_(uint8_t keep, uint32_t timeout_ms,
+                                   const char *context) {
+  if (this->spi_device_ == nullptr) {
+    return true;
+  }
+
+  const uint32_t wait_start_us = micros();
+  esp_err_t err = ESP_OK;
+  bool drained = false;
+  while (this->spi_trans_pending_ > keep) {
+    spi_transaction_t *ret_trans = nullptr;
+    err = spi_device_get_trans_result(this->spi_device_, &ret_trans,
+                                      pdMS_TO_TICKS(timeout_ms));
+    if (err != ESP_OK) {
+      break;
+    }
+    // g_spi_dma_active_count was already released by spi_tx_done_cb_.
+    this->spi_trans_pending_--;
+    drained = true;
+    const auto *first = &this->spi_trans_[0][0];
+    if (ret_trans < first || ret_trans >= first + 2 * SPI_MAX_CHUNKS) {
+      ESP_LOGW(TAG, "SPI TX completion mismatch during %s (got=%p)", context,
+               ret_trans);
+    }
+  }
+  this->spi_tx_in_flight_ = this->spi_trans_pending_ > 0;
+
+  if (err == ESP_OK) {
+    if (drained) {
+      const uint32_t wait_us = micros() - wait_start_us;
+      this->spi_wait_count_++;
+      // Capture actual wire-time for perf diag (time spent waiting = DMA transfer time).
+      if (wait_us > this->perf_diag_max_wait_us_) {
+        this->perf_diag_max_wait_us_ = wait_us;
+      }
+      this->perf_diag_total_wait_us_ += wait_us;
+#ifdef USE_CFX_PROFILER
+      chimera_fx::CFXProfiler::get().record_stage(
+          chimera_fx::CFX_STAGE_DMA_WAIT, wait_us);
+#endif
+#ifdef USE_CFX_TRACE
+      chimera_fx::CFXTrace::get().span(chimera_fx::CFX_TRACE_DMA_DONE,
+                                       wait_start_us, wait_us, this->pin_);
+#endif
+    }
+    return true;
+  }
+
+  if (err == ESP_ERR_TIMEOUT) {
+    this->spi_wait_timeout_count_++;
+    ESP_LOGW(TAG,
+             "SPI TX wait timeout during %s (%" PRIu32 " ms, waits=%" PRIu32
+             ", timeouts=%" PRIu32 ", queue_err=%" PRIu32 ")",
+             context, timeout_ms, this->spi_wait_count_,
+             this->spi_wait_timeout_count_, this->spi_queue_error_count_);
+  } else {
+    ESP_LOGW(TAG, "SPI TX wait failed during %s (err=%d)", context, err);
+  }
+
+  this->status_set_warning();
+  return false;
+}
+
+void CFXLightOutput::setup_spi_() {
+  size_t frame_size = this->get_spi_frame_size_();
+
+  // Allocate DMA-capable frame buffers (must be 32-bit aligned internal RAM)
+  this->spi_frame_bufs_[0] =
+      this->memory_budget_.allocate(CFX_MEM_DMA, frame_size, "spi frame");
+  if (this->spi_frame_bufs_[0] == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate SPI frame buffer (%u bytes, DMA)!", frame_size);
     this->mark_failed();
     return;
   }
-  memset(this->spi_frame_buf_, 0, frame_size);
+  this->spi_frame_bufs_[1] =
+      this->memory_budget_.allocate(CFX_MEM_DMA, frame_size, "spi frame back");
+  if (this->spi_frame_bufs_[1] == nullptr) {
+    ESP_LOGW(TAG, "SPI back buffer (%u bytes, DMA) unavailable — packing and "
+             "transmit will not overlap",
+             static_cast<unsigned>(frame_size));
+  }
+  for (uint8_t b = 0; b < 2; b++) {
+    if (this->spi_frame_bufs_[b] != nullptr) {
+      this->init_spi_frame_(this->spi_frame_bufs_[b]);
+    }
+    this->spi_frame_sums_[b] = {};
+  }
+  this->spi_buf_index_ = 0;
+  this->spi_primed_mask_ = 0;
+
+  // Split long strips into at most SPI_MAX_CHUNKS transactions per frame.
+  const uint16_t per_chunk =
+      (this->num_leds_ + SPI_MAX_CHUNKS - 1) / SPI_MAX_CHUNKS;
+  this->spi_chunk_leds_ = std::max(per_chunk, SPI_MIN_CHUNK_LEDS);
+  this->spi_chunk_count_ = static_cast<uint8_t>(std::max<uint16_t>(
+      1, (this->num_leds_ + this->spi_chunk_leds_ - 1) / this->spi_chunk_leds_));
 
   spi_host_device_t host = resolve_spi_host_(this->spi_host_);
 
@@ -6117,7 +6512,8 @@ void CFXLightOutput::setup_spi_() {
   dev_cfg.clock_speed_hz = this->spi_speed_hz_;
   dev_cfg.mode = 0;             // CPOL=0, CPHA=0
   dev_cfg.spics_io_num = -1;    // APA102/SK9822 have no CS line
-  dev_cfg.queue_size = 1;
+  // Room for every chunk of the frame on the wire and the one behind it.
+  dev_cfg.queue_size = this->spi_chunk_count_ * 2;
   dev_cfg.flags = SPI_DEVICE_NO_DUMMY;  // required for long strips
   dev_cfg.post_cb = spi_tx_done_cb_;
 
@@ -6133,10 +6529,11 @@ void CFXLightOutput::setup_spi_() {
   ESP_LOGI(TAG,
            "SPI transport ready: host=SPI%d data=GPIO%u clock=GPIO%u "
            "speed=%" PRIu32 " Hz frame=%u bytes est_tx_timeout=%" PRIu32
-           " ms mode=async_queue",
+           " ms mode=async_queue chunks=%u buffers=%u",
            spi_host_num, this->spi_data_pin_, this->spi_clock_pin_,
            this->spi_speed_hz_, static_cast<unsigned>(frame_size),
-           this->get_spi_frame_timeout_ms_());
+           this->get_spi_frame_timeout_ms_(), this->spi_chunk_count_,
+           this->spi_frame_bufs_[1] != nullptr ? 2u : 1u);
 }
 
 // --- Dynamic State Synchronization ---
@@ -6329,7 +6726,7 @@ void CFXLightOutput::loop() {
   }
 
   if (this->transport_ == TRANSPORT_RMT && this->rmt_flush_pending_ &&
-      !this->rmt_tx_in_flight_) {
+      this->rmt_tx_slot_free_()) {
     this->rmt_flush_pending_ = false;
     g_last_rmt_launch_us = micros();
     this->perf_diag_last_launch_slot_ =
@@ -6341,6 +6738,9 @@ void CFXLightOutput::loop() {
   // P3: drain any outputs whose barrier window expired before all outputs
   // arrived (e.g. an inactive output that skipped write_state this tick).
   CFXTransmitBarrier::get().service(this);
+#ifdef CFX_REALTIME_ENABLED
+  CFXRealtimeIngest::get().service(this);
+#endif
   this->service_parallel_group_flush_();
   this->service_parallel_shared_group_flush_();
   if (!this->outro_cbs_.empty()) {
@@ -6364,7 +6764,7 @@ void CFXLightOutput::loop() {
       }
     }
 
-    uint8_t outro_segment_mask = 0;
+    CFXSegmentMask outro_segment_mask = 0;
     uint8_t outro_segment_count = 0;
     if (this->render_segment_coordinator_epoch_(outro_segment_mask,
                                                 outro_segment_count, false,
@@ -6405,6 +6805,7 @@ void CFXLightOutput::loop() {
           (*this)[i] = Color::BLACK;
         }
       }
+      this->mark_frame_dirty();
       this->outro_parent_flush_allowed_ = true;
       this->write_state(nullptr);
       this->outro_parent_flush_allowed_ = false;
@@ -6426,19 +6827,18 @@ void CFXLightOutput::loop() {
     const size_t segment_count = this->segment_light_states_.size();
     uint8_t active_count = 0;
     uint8_t ready_count = 0;
-    for (size_t i = 0; i < segment_count && i < MAX_CFX_SEGMENTS; i++) {
+    for (size_t i = 0; i < segment_count; i++) {
       if (!this->segment_participates_in_barrier_(
               this->segment_light_states_[i])) {
         continue;
       }
-      const uint8_t bit = static_cast<uint8_t>(1u << i);
-      if ((this->segment_coord_owned_mask_ & bit) != 0 &&
-          this->seg_request_generation_[i] ==
-              this->seg_flushed_generation_[i]) {
+      const auto &slot = this->segment_runtime_slots_[i];
+      if ((this->segment_coord_owned_mask_ & cfx_segment_bit(i)) != 0 &&
+          slot.request_generation == slot.flushed_generation) {
         continue;
       }
       active_count++;
-      if (this->seg_request_generation_[i] != this->seg_flushed_generation_[i]) {
+      if (slot.request_generation != slot.flushed_generation) {
         ready_count++;
       }
     }
@@ -6470,9 +6870,7 @@ void CFXLightOutput::loop() {
         if (missing > this->perf_diag_max_partial_missing_) {
           this->perf_diag_max_partial_missing_ = missing;
         }
-        for (size_t i = 0; i < segment_count && i < MAX_CFX_SEGMENTS; i++) {
-          this->seg_flushed_generation_[i] = this->seg_request_generation_[i];
-        }
+        this->mark_segment_generations_flushed_();
         this->seg_flush_pending_mask_ = 0;
         this->seg_flush_dirty_mask_ = 0;
         this->seg_flush_pending_ = false;
@@ -6481,11 +6879,9 @@ void CFXLightOutput::loop() {
         this->log_segment_coordinator_diag_();
         goto segment_flush_done;
       }
-      for (size_t i = 0; i < segment_count && i < MAX_CFX_SEGMENTS; i++) {
-        this->seg_flushed_generation_[i] = this->seg_request_generation_[i];
-      }
+      this->mark_segment_generations_flushed_();
       this->seg_flush_pending_mask_ = 0;
-      const uint8_t dirty_mask = this->seg_flush_dirty_mask_;
+      const CFXSegmentMask dirty_mask = this->seg_flush_dirty_mask_;
       this->seg_flush_dirty_mask_ = 0;
       this->seg_flush_pending_ = false;
       this->seg_flush_first_ms_ = 0;
@@ -6517,25 +6913,15 @@ float CFXLightOutput::estimate_power_current_ma(
     return 0.0f;
   }
 
-  const bool has_white = this->has_white_channel();
-  const uint8_t stride = has_white ? 4 : 3;
-  const uint8_t *src = this->buf_;
+  // The sums carry the scale they were transmitted at; divide it back out so
+  // dynamic_scale can ask about any other reduction.
+  const CFXPowerSums sums = this->get_power_sums();
   float dynamic_ma = 0.0f;
-
-  for (uint16_t i = 0; i < this->num_leds_; i++) {
-    const uint8_t rgb_offset = this->is_wrgb_ ? 1 : 0;
-    dynamic_ma +=
-        model.rgb_channel_ma *
-        (static_cast<float>(src[rgb_offset]) +
-         static_cast<float>(src[rgb_offset + 1]) +
-         static_cast<float>(src[rgb_offset + 2])) /
-        255.0f;
-    if (has_white) {
-      const uint8_t white_offset = this->is_wrgb_ ? 0 : 3;
-      dynamic_ma += model.white_channel_ma *
-                    static_cast<float>(src[white_offset]) / 255.0f;
-    }
-    src += stride;
+  if (sums.scale > 0) {
+    dynamic_ma =
+        (model.rgb_channel_ma * static_cast<float>(sums.channels - sums.white) +
+         model.white_channel_ma * static_cast<float>(sums.white)) /
+        static_cast<float>(sums.scale);
   }
 
   if (dynamic_scale < 0.0f) {
@@ -6547,6 +6933,130 @@ float CFXLightOutput::estimate_power_current_ma(
          (dynamic_ma * dynamic_scale);
 }
 
+CFXPowerSums CFXLightOutput::sum_buffer_power_() const {
+  CFXPowerSums sums;
+  if (this->buf_ == nullptr) {
+    return sums;
+  }
+  const uint8_t stride = this->get_pixel_stride_();
+  const size_t len = this->get_buffer_size_();
+  for (size_t i = 0; i < len; i++) {
+    sums.channels += this->buf_[i];
+  }
+  if (stride == 4) {
+    for (size_t i = this->is_wrgb_ ? 0 : 3; i < len; i += stride) {
+      sums.white += this->buf_[i];
+    }
+  }
+  return sums;
+}
+
+uint8_t CFXLightOutput::report_power_frame_(const CFXPowerSums &sums) {
+  if (this->power_manager_ == nullptr || !sums.valid || sums.scale == 0 ||
+      !this->power_manager_->frame_limiter_active()) {
+    return this->get_power_transmit_scale_();
+  }
+  // The copy summed what it wrote; the limiter wants what buf_ asks for.
+  uint32_t channels = sums.channels;
+  uint32_t white = sums.white;
+  if (sums.scale < 255) {
+    channels = static_cast<uint32_t>(
+        (static_cast<uint64_t>(channels) * 255u + sums.scale / 2u) /
+        sums.scale);
+    white = static_cast<uint32_t>(
+        (static_cast<uint64_t>(white) * 255u + sums.scale / 2u) / sums.scale);
+  }
+  this->power_manager_->predict_output_frame(this, channels, white);
+  return this->get_power_transmit_scale_();
+}
+
+void CFXLightOutput::begin_parallel_power_frame_() {
+  this->parallel_power_sums_ = {};
+  this->parallel_power_sums_.scale = this->get_power_transmit_scale_();
+  this->parallel_power_sums_.valid = true;
+}
+
+void CFXLightOutput::report_parallel_power_frame_() {
+  // Lanes are transposed chunk by chunk while DMA streams them, so a frame
+  // the limiter rescales is corrected by the one right after it.
+  if (this->report_power_frame_(this->parallel_power_sums_) !=
+      this->parallel_power_sums_.scale) {
+    this->schedule_show();
+  }
+}
+
+bool CFXLightOutput::limit_staged_frame_(uint8_t *wire, CFXPowerSums &sums) {
+  const uint8_t scale = this->report_power_frame_(sums);
+  if (scale > sums.scale) {
+    // Brighter is never over budget: let the next frame pick it up.
+    this->schedule_show();
+    return false;
+  }
+  if (scale == sums.scale) {
+    return false;
+  }
+  this->prep_transmit_(wire, 0, this->num_leds_, sums);
+  this->encoded_power_scale_ = sums.scale;
+  this->perf_diag_total_encoded_leds_ += this->num_leds_;
+  return true;
+}
+
+CFXPowerSums CFXLightOutput::get_power_sums() const {
+  if (this->power_sums_.valid || this->buf_ == nullptr) {
+    return this->power_sums_;
+  }
+  // buf_ is a plain byte frame, so the byte sum kernel can split it by zone
+  // in the same pass; SPI wire framing never reaches here once it runs.
+  CFXPowerSums sums;
+  const bool zoned = this->zones_active_() && this->transmit_sum_ != nullptr &&
+                     this->transport_ != TRANSPORT_SPI;
+  if (zoned) {
+    this->sum_zoned_(this->buf_, 0, this->num_leds_, this->get_pixel_stride_(),
+                     sums);
+  } else {
+    sums = this->sum_buffer_power_();
+  }
+  // Apply the transmit scale the lane builders use, so callers see the same
+  // units as a prepared frame.
+  sums.scale = this->get_power_transmit_scale_();
+  if (sums.scale < 255) {
+    auto scaled = [&sums](uint32_t v) {
+      return static_cast<uint32_t>(
+          (static_cast<uint64_t>(v) * sums.scale + 127u) / 255u);
+    };
+    sums.channels = scaled(sums.channels);
+    sums.white = scaled(sums.white);
+    if (zoned) {
+      for (auto &zone : this->zone_power_sums_) {
+        zone.channels = scaled(zone.channels);
+        zone.white = scaled(zone.white);
+      }
+    }
+  }
+  sums.valid = true;
+  return sums;
+}
+
+void CFXLightOutput::note_power_effect(uint16_t lo, uint16_t hi, uint8_t mode) {
+  if (!this->power_zones_enabled_) {
+    return;
+  }
+  const size_t zones = std::max<size_t>(1, this->segment_defs_.size());
+  if (this->power_zone_effects_.size() != zones) {
+    this->power_zone_effects_.assign(zones, POWER_NO_EFFECT);
+  }
+  if (this->segment_defs_.empty()) {
+    this->power_zone_effects_[0] = mode;
+    return;
+  }
+  for (size_t i = 0; i < this->segment_defs_.size(); i++) {
+    const uint16_t start = this->segment_defs_[i].start;
+    if (start >= lo && start < hi) {
+      this->power_zone_effects_[i] = mode;
+    }
+  }
+}
+
 uint8_t CFXLightOutput::get_power_transmit_scale_() const {
   if (this->power_manager_ == nullptr) {
     return 255;
@@ -6562,27 +7072,360 @@ void CFXLightOutput::request_power_reduction_refresh() {
   this->schedule_show();
 }
 
-void CFXLightOutput::apply_power_scale_to_buffer_(uint8_t *data,
-                                                  size_t len) const {
+const uint8_t *CFXLightOutput::get_power_transfer_lut_() {
   const uint8_t scale = this->get_power_transmit_scale_();
-  if (data == nullptr || len == 0 || scale >= 255) {
+  if (scale >= 255) {
+    return nullptr;
+  }
+  if (scale != this->power_transfer_lut_scale_) {
+    for (uint16_t v = 0; v < 256; v++) {
+      this->power_transfer_lut_[v] =
+          static_cast<uint8_t>((v * scale + 127u) / 255u);
+    }
+    this->power_transfer_lut_scale_ = scale;
+  }
+  return this->power_transfer_lut_;
+}
+
+// --- Transmit prep kernels ---
+//
+// buf_ is already in wire byte order (ESPColorView writes through
+// rgb_order_), so a kernel only has to add the transport's framing and the
+// power scale. Each reads LEDs [lo, hi) of src once and writes them once,
+// summing the bytes it wrote on the way for the power estimate.
+
+static void prep_bytes_copy_(uint8_t *wire, const uint8_t *src, uint16_t lo,
+                             uint16_t hi, uint8_t stride, const uint8_t *,
+                             uint32_t *sum) {
+  const size_t start = static_cast<size_t>(lo) * stride;
+  const size_t end = static_cast<size_t>(hi) * stride;
+  uint32_t acc = 0;
+  size_t i = start;
+  for (; i + 4 <= end; i += 4) {
+    const uint8_t b0 = src[i];
+    const uint8_t b1 = src[i + 1];
+    const uint8_t b2 = src[i + 2];
+    const uint8_t b3 = src[i + 3];
+    wire[i] = b0;
+    wire[i + 1] = b1;
+    wire[i + 2] = b2;
+    wire[i + 3] = b3;
+    acc += static_cast<uint32_t>(b0) + b1 + b2 + b3;
+  }
+  for (; i < end; i++) {
+    wire[i] = src[i];
+    acc += src[i];
+  }
+  *sum += acc;
+}
+
+static void prep_bytes_scaled_(uint8_t *wire, const uint8_t *src, uint16_t lo,
+                               uint16_t hi, uint8_t stride,
+                               const uint8_t *lut, uint32_t *sum) {
+  const size_t start = static_cast<size_t>(lo) * stride;
+  const size_t end = static_cast<size_t>(hi) * stride;
+  uint32_t acc = 0;
+  size_t i = start;
+  for (; i + 4 <= end; i += 4) {
+    const uint8_t b0 = lut[src[i]];
+    const uint8_t b1 = lut[src[i + 1]];
+    const uint8_t b2 = lut[src[i + 2]];
+    const uint8_t b3 = lut[src[i + 3]];
+    wire[i] = b0;
+    wire[i + 1] = b1;
+    wire[i + 2] = b2;
+    wire[i + 3] = b3;
+    acc += static_cast<uint32_t>(b0) + b1 + b2 + b3;
+  }
+  for (; i < end; i++) {
+    wire[i] = lut[src[i]];
+    acc += wire[i];
+  }
+  *sum += acc;
+}
+
+static uint32_t sum_bytes_(const uint8_t *wire, uint16_t lo, uint16_t hi,
+                           uint8_t stride) {
+  const size_t end = static_cast<size_t>(hi) * stride;
+  uint32_t acc = 0;
+  for (size_t i = static_cast<size_t>(lo) * stride; i < end; i++) {
+    acc += wire[i];
+  }
+  return acc;
+}
+
+// APA102/SK9822 LED frame: 0xFF (full global brightness), then the three
+// colour bytes; assembled as one little-endian word per LED.
+static inline void store_apa102_frame_(uint8_t *wire, uint32_t frame) {
+  if ((reinterpret_cast<uintptr_t>(wire) & 3u) == 0) {
+    *reinterpret_cast<uint32_t *>(wire) = frame;
+  } else {
+    memcpy(wire, &frame, sizeof(frame));
+  }
+}
+
+static void prep_apa102_copy_(uint8_t *wire, const uint8_t *src, uint16_t lo,
+                              uint16_t hi, uint8_t, const uint8_t *,
+                              uint32_t *sum) {
+  uint8_t *out = wire + static_cast<size_t>(lo) * 4;
+  const uint8_t *in = src + static_cast<size_t>(lo) * 3;
+  uint32_t acc = 0;
+  for (uint16_t led = lo; led < hi; led++, out += 4, in += 3) {
+    store_apa102_frame_(out, 0xFFu | (static_cast<uint32_t>(in[0]) << 8) |
+                                 (static_cast<uint32_t>(in[1]) << 16) |
+                                 (static_cast<uint32_t>(in[2]) << 24));
+    acc += static_cast<uint32_t>(in[0]) + in[1] + in[2];
+  }
+  *sum += acc;
+}
+
+static void prep_apa102_scaled_(uint8_t *wire, const uint8_t *src, uint16_t lo,
+                                uint16_t hi, uint8_t, const uint8_t *lut,
+                                uint32_t *sum) {
+  uint8_t *out = wire + static_cast<size_t>(lo) * 4;
+  const uint8_t *in = src + static_cast<size_t>(lo) * 3;
+  uint32_t acc = 0;
+  for (uint16_t led = lo; led < hi; led++, out += 4, in += 3) {
+    const uint8_t c0 = lut[in[0]];
+    const uint8_t c1 = lut[in[1]];
+    const uint8_t c2 = lut[in[2]];
+    store_apa102_frame_(out, 0xFFu | (static_cast<uint32_t>(c0) << 8) |
+                                 (static_cast<uint32_t>(c1) << 16) |
+                                 (static_cast<uint32_t>(c2) << 24));
+    acc += static_cast<uint32_t>(c0) + c1 + c2;
+  }
+  *sum += acc;
+}
+
+// Colour bytes of LED frames [lo, hi); the 0xFF header byte is not counted.
+static uint32_t sum_apa102_(const uint8_t *wire, uint16_t lo, uint16_t hi,
+                            uint8_t) {
+  uint32_t acc = 0;
+  for (const uint8_t *in = wire + static_cast<size_t>(lo) * 4,
+                     *end = wire + static_cast<size_t>(hi) * 4;
+       in < end; in += 4) {
+    acc += static_cast<uint32_t>(in[1]) + in[2] + in[3];
+  }
+  return acc;
+}
+
+void CFXLightOutput::select_transmit_prep_() {
+  if (this->transport_ == TRANSPORT_SPI) {
+    this->transmit_prep_copy_ = prep_apa102_copy_;
+    this->transmit_prep_scaled_ = prep_apa102_scaled_;
+    this->transmit_sum_ = sum_apa102_;
+  } else {
+    // RMT stages plain bytes; the parallel builders transpose straight from
+    // buf_ and only borrow the transfer table.
+    this->transmit_prep_copy_ = prep_bytes_copy_;
+    this->transmit_prep_scaled_ = prep_bytes_scaled_;
+    this->transmit_sum_ = sum_bytes_;
+  }
+}
+
+// White bytes of LEDs [lo, hi) in a staged byte frame; zero unless the
+// output has a white channel (SPI strips never do).
+uint32_t CFXLightOutput::sum_wire_white_(const uint8_t *wire, uint16_t lo,
+                                         uint16_t hi) const {
+  if (!this->has_white_channel() || this->transport_ == TRANSPORT_SPI) {
+    return 0;
+  }
+  const size_t end = static_cast<size_t>(hi) * 4;
+  uint32_t acc = 0;
+  for (size_t i = static_cast<size_t>(lo) * 4 + (this->is_wrgb_ ? 0 : 3);
+       i < end; i += 4) {
+    acc += wire[i];
+  }
+  return acc;
+}
+
+void CFXLightOutput::ensure_power_zones_() const {
+  const size_t count = this->segment_defs_.size();
+  if (this->zone_power_sums_.size() == count &&
+      this->power_zone_order_.size() == count) {
     return;
   }
-  for (size_t i = 0; i < len; i++) {
-    data[i] =
-        static_cast<uint8_t>((static_cast<uint16_t>(data[i]) * scale + 127u) /
-                             255u);
+  this->zone_power_sums_.assign(count, CFXZonePowerSums{});
+  this->power_zone_order_.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    this->power_zone_order_[i] = static_cast<uint8_t>(i);
+  }
+  std::stable_sort(this->power_zone_order_.begin(),
+                   this->power_zone_order_.end(),
+                   [this](uint8_t a, uint8_t b) {
+                     return this->segment_defs_[a].start <
+                            this->segment_defs_[b].start;
+                   });
+}
+
+// Calls fn(a, b, zone) for consecutive pieces covering [lo, hi); zone is -1
+// for LEDs outside every segment. Overlapping segments: the earlier-starting
+// one owns the overlap.
+template<typename RangeFn>
+void CFXLightOutput::for_each_zone_piece_(uint16_t lo, uint16_t hi,
+                                          RangeFn &&fn) const {
+  uint16_t cursor = lo;
+  for (uint8_t z : this->power_zone_order_) {
+    const CFXSegmentDef &def = this->segment_defs_[z];
+    if (def.start >= hi) {
+      break;
+    }
+    const uint16_t a = std::max(def.start, cursor);
+    const uint16_t b = std::min(std::min(def.stop, this->num_leds_), hi);
+    if (b <= a) {
+      continue;
+    }
+    if (cursor < a) {
+      fn(cursor, a, -1);
+    }
+    fn(a, b, static_cast<int>(z));
+    cursor = b;
+  }
+  if (cursor < hi) {
+    fn(cursor, hi, -1);
   }
 }
 
-void CFXLightOutput::fill_buffer_solid_(const Color &color) {
-  if (this->buf_ == nullptr || this->effect_data_ == nullptr ||
-      this->num_leds_ == 0) {
+// Zones outside the prepared range keep last frame's sums: their bytes did
+// not change. A zone the range cuts re-reads the rest of its span from the
+// wire it now sits in.
+void CFXLightOutput::store_zone_sums_(const uint8_t *wire, int z, uint16_t a,
+                                      uint16_t b, uint8_t stride,
+                                      uint32_t channels,
+                                      uint32_t white) const {
+  const CFXSegmentDef &def = this->segment_defs_[z];
+  const uint16_t stop = std::min(def.stop, this->num_leds_);
+  CFXZonePowerSums &zone = this->zone_power_sums_[z];
+  zone.channels = channels;
+  zone.white = white;
+  if (def.start < a) {
+    zone.channels += this->transmit_sum_(wire, def.start, a, stride);
+    zone.white += this->sum_wire_white_(wire, def.start, a);
+  }
+  if (stop > b) {
+    zone.channels += this->transmit_sum_(wire, b, stop, stride);
+    zone.white += this->sum_wire_white_(wire, b, stop);
+  }
+}
+
+void CFXLightOutput::prep_zoned_(uint8_t *wire, uint16_t lo, uint16_t hi,
+                                 uint8_t stride, const uint8_t *lut,
+                                 TransmitPrepFn prep, CFXPowerSums &sums) {
+  this->ensure_power_zones_();
+  this->for_each_zone_piece_(lo, hi, [&](uint16_t a, uint16_t b, int z) {
+    uint32_t channels = 0;
+    prep(wire, this->buf_, a, b, stride, lut, &channels);
+    const uint32_t white = this->sum_wire_white_(wire, a, b);
+    sums.channels += channels;
+    sums.white += white;
+    if (z >= 0) {
+      this->store_zone_sums_(wire, z, a, b, stride, channels, white);
+    }
+  });
+}
+
+void CFXLightOutput::sum_zoned_(const uint8_t *wire, uint16_t lo, uint16_t hi,
+                                uint8_t stride, CFXPowerSums &sums) const {
+  this->ensure_power_zones_();
+  this->for_each_zone_piece_(lo, hi, [&](uint16_t a, uint16_t b, int z) {
+    const uint32_t channels = this->transmit_sum_(wire, a, b, stride);
+    const uint32_t white = this->sum_wire_white_(wire, a, b);
+    sums.channels += channels;
+    sums.white += white;
+    if (z >= 0) {
+      this->store_zone_sums_(wire, z, a, b, stride, channels, white);
+    }
+  });
+}
+
+void CFXLightOutput::prep_transmit_(uint8_t *wire, uint16_t lo, uint16_t hi,
+                                    CFXPowerSums &sums) {
+  hi = std::min(hi, this->num_leds_);
+  lo = std::min(lo, hi);
+  if (this->transmit_prep_copy_ == nullptr) {
     return;
   }
+  const uint8_t stride = this->get_pixel_stride_();
+  // sums describe what this wire buffer holds. A full frame starts them
+  // over; a partial one swaps the range's old bytes for the new ones.
+  if (lo == 0 && hi == this->num_leds_) {
+    sums.channels = 0;
+    sums.white = 0;
+  } else if (!sums.valid) {
+    sums.channels = this->transmit_sum_(wire, 0, lo, stride) +
+                    this->transmit_sum_(wire, hi, this->num_leds_, stride);
+    sums.white = this->sum_wire_white_(wire, 0, lo) +
+                 this->sum_wire_white_(wire, hi, this->num_leds_);
+  } else {
+    sums.channels -= this->transmit_sum_(wire, lo, hi, stride);
+    sums.white -= this->sum_wire_white_(wire, lo, hi);
+  }
+  if (lo < hi) {
+    const uint8_t *lut = this->get_power_transfer_lut_();
+    const TransmitPrepFn prep = lut != nullptr ? this->transmit_prep_scaled_
+                                               : this->transmit_prep_copy_;
+    if (this->zones_active_()) {
+      this->prep_zoned_(wire, lo, hi, stride, lut, prep, sums);
+    } else {
+      prep(wire, this->buf_, lo, hi, stride, lut, &sums.channels);
+      sums.white += this->sum_wire_white_(wire, lo, hi);
+    }
+  }
+  sums.scale = this->get_power_transmit_scale_();
+  sums.valid = true;
+  this->power_sums_ = sums;
+}
 
-  int32_t r = 0, g = 0, b = 0;
-  switch (this->rgb_order_) {
+void CFXLightOutput::note_dirty_range(uint16_t lo, uint16_t hi) {
+  // Brightness is applied per pixel as the runner commits, so a change
+  // rewrites every LED whatever the effect touched.
+  if (this->tracked_brightness_ != this->dirty_brightness_) {
+    this->dirty_brightness_ = this->tracked_brightness_;
+    this->dirty_state_ = DIRTY_FULL;
+  }
+  if (this->dirty_state_ == DIRTY_FULL || lo >= hi) {
+    if (this->dirty_state_ == DIRTY_UNKNOWN) {
+      this->dirty_state_ = DIRTY_RANGE;
+      this->dirty_lo_ = 0;
+      this->dirty_hi_ = 0;
+    }
+    return;
+  }
+  if (this->dirty_state_ == DIRTY_UNKNOWN ||
+      this->dirty_lo_ >= this->dirty_hi_) {
+    this->dirty_lo_ = lo;
+    this->dirty_hi_ = hi;
+  } else {
+    this->dirty_lo_ = std::min(this->dirty_lo_, lo);
+    this->dirty_hi_ = std::max(this->dirty_hi_, hi);
+  }
+  this->dirty_state_ = DIRTY_RANGE;
+}
+
+void CFXLightOutput::take_encode_range_(uint16_t &lo, uint16_t &hi) {
+  const uint8_t scale = this->get_power_transmit_scale_();
+  const bool partial = this->dirty_state_ == DIRTY_RANGE &&
+                       this->encoded_valid_ &&
+                       scale == this->encoded_power_scale_;
+  lo = partial ? std::min(this->dirty_lo_, this->num_leds_) : 0;
+  hi = partial ? std::min(this->dirty_hi_, this->num_leds_) : this->num_leds_;
+  if (lo > hi) {
+    lo = hi;
+  }
+  // A frame painted by another writer is not what the runner committed, so
+  // the next report cannot be diffed against it.
+  this->encoded_valid_ = this->dirty_state_ != DIRTY_FULL;
+  this->encoded_power_scale_ = scale;
+  this->dirty_state_ = DIRTY_UNKNOWN;
+  this->perf_diag_total_encoded_leds_ += hi - lo;
+}
+
+// Byte offsets of red, green and blue inside one wire-order pixel, before the
+// leading white byte of WRGB strips.
+static void wire_rgb_offsets(RGBOrder order, int32_t &r, int32_t &g,
+                             int32_t &b) {
+  r = g = b = 0;
+  switch (order) {
   case ORDER_RGB:
     r = 0;
     g = 1;
@@ -6614,6 +7457,16 @@ void CFXLightOutput::fill_buffer_solid_(const Color &color) {
     b = 0;
     break;
   }
+}
+
+void CFXLightOutput::fill_buffer_solid_(const Color &color) {
+  if (this->buf_ == nullptr || this->effect_data_ == nullptr ||
+      this->num_leds_ == 0) {
+    return;
+  }
+
+  int32_t r = 0, g = 0, b = 0;
+  wire_rgb_offsets(this->rgb_order_, r, g, b);
 
   const bool has_white = this->has_white_channel();
   const uint8_t multiplier = has_white ? 4 : 3;
@@ -6634,6 +7487,7 @@ void CFXLightOutput::fill_buffer_solid_(const Color &color) {
     }
     this->effect_data_[i] = 0;
   }
+  this->mark_frame_dirty();
 }
 
 void CFXLightOutput::scrub_inactive_segments_() {
@@ -6658,6 +7512,17 @@ void CFXLightOutput::scrub_inactive_segments_() {
 
 bool CFXLightOutput::should_scrub_segment_(
     light::LightState *state) const {
+#ifdef CFX_REALTIME_ENABLED
+  // A streamed segment keeps its pixels even while its own light is OFF.
+  if (this->realtime_live_) {
+    for (size_t i = 0; i < this->segment_light_states_.size(); i++) {
+      if (this->segment_light_states_[i] == state &&
+          this->realtime_owns_segment_(static_cast<int>(i))) {
+        return false;
+      }
+    }
+  }
+#endif
   return state != nullptr && !state->remote_values.is_on() &&
          !state->is_transformer_active();
 }
@@ -6710,6 +7575,11 @@ void CFXLightOutput::update_state(light::LightState *state) {
   this->tracked_brightness_ = max_brightness;
   this->correction_.set_local_brightness(max_brightness);
 
+  if (this->realtime_owns(state)) {
+    // Painting the state colour would overwrite the live stream until its
+    // next packet; set_realtime_live_(false) repaints once it ends.
+    return;
+  }
   if (this->is_effect_active()) {
     // Effect handles its own pixel math in apply().
     return;
@@ -6755,15 +7625,16 @@ void CFXLightOutput::request_segment_flush(light::LightState *state) {
   }
 
   if (state != nullptr) {
-    for (size_t i = 0; i < this->segment_light_states_.size() && i < 8; i++) {
+    for (size_t i = 0; i < this->segment_light_states_.size(); i++) {
       if (this->segment_light_states_[i] == state) {
-        this->seg_flush_pending_mask_ |= static_cast<uint8_t>(1u << i);
-        this->seg_flush_dirty_mask_ |= static_cast<uint8_t>(1u << i);
+        this->seg_flush_pending_mask_ |= cfx_segment_bit(i);
+        this->seg_flush_dirty_mask_ |= cfx_segment_bit(i);
         this->seg_generation_counter_++;
         if (this->seg_generation_counter_ == 0) {
           this->seg_generation_counter_ = 1;
         }
-        this->seg_request_generation_[i] = this->seg_generation_counter_;
+        this->segment_runtime_slots_[i].request_generation =
+            this->seg_generation_counter_;
         break;
       }
     }
@@ -6779,19 +7650,20 @@ void CFXLightOutput::request_segment_flush(light::LightState *state) {
   }
 
   const size_t segment_count = this->segment_light_states_.size();
-  if (segment_count == 0 || segment_count > 8) {
+  if (segment_count == 0) {
     return;
   }
 
   uint8_t active_count = 0;
   uint8_t ready_count = 0;
-  for (size_t i = 0; i < segment_count && i < MAX_CFX_SEGMENTS; i++) {
+  for (size_t i = 0; i < segment_count; i++) {
     if (!this->segment_participates_in_barrier_(
             this->segment_light_states_[i])) {
       continue;
     }
     active_count++;
-    if (this->seg_request_generation_[i] != this->seg_flushed_generation_[i]) {
+    const auto &slot = this->segment_runtime_slots_[i];
+    if (slot.request_generation != slot.flushed_generation) {
       ready_count++;
     }
   }
@@ -6803,11 +7675,9 @@ void CFXLightOutput::request_segment_flush(light::LightState *state) {
   // Flush immediately instead of idling in the fallback window.
   this->seg_last_flush_mask_ = this->seg_flush_pending_mask_;
   this->seg_last_flush_count_ = ready_count;
-  for (size_t i = 0; i < segment_count && i < MAX_CFX_SEGMENTS; i++) {
-    this->seg_flushed_generation_[i] = this->seg_request_generation_[i];
-  }
+  this->mark_segment_generations_flushed_();
   this->seg_flush_pending_mask_ = 0;
-  const uint8_t dirty_mask = this->seg_flush_dirty_mask_;
+  const CFXSegmentMask dirty_mask = this->seg_flush_dirty_mask_;
   this->seg_flush_dirty_mask_ = 0;
   this->seg_flush_pending_ = false;
   this->seg_flush_first_ms_ = 0;
@@ -6825,56 +7695,222 @@ void CFXLightOutput::request_segment_solid_repaint_flush(
     return;
   }
 
-  for (size_t i = 0;
-       i < this->segment_light_states_.size() && i < MAX_CFX_SEGMENTS; i++) {
+  for (size_t i = 0; i < this->segment_light_states_.size(); i++) {
     if (this->segment_light_states_[i] != state) {
       continue;
     }
 
-    const uint8_t mask = static_cast<uint8_t>(1u << i);
-    this->flush_parent_owned_segment_epoch_direct_(mask, 1);
+    this->flush_parent_owned_segment_epoch_direct_(cfx_segment_bit(i), 1);
+    return;
+  }
+}
+
+#ifdef CFX_REALTIME_ENABLED
+void CFXLightOutput::write_realtime_pixels_(uint16_t led, const uint8_t *src,
+                                            uint16_t count,
+                                            uint8_t src_stride) {
+  if (this->buf_ == nullptr || src == nullptr || led >= this->num_leds_) {
+    return;
+  }
+  count = std::min<uint16_t>(count, this->num_leds_ - led);
+  const uint8_t stride = this->get_pixel_stride_();
+  uint8_t *dst = this->buf_ + static_cast<size_t>(led) * stride;
+  if (this->rgb_order_ == ORDER_RGB && !this->is_wrgb_ &&
+      src_stride == stride) {
+    // Payload already matches the wire layout: one straight copy.
+    memcpy(dst, src, static_cast<size_t>(count) * stride);
+  } else {
+    int32_t r = 0, g = 0, b = 0;
+    wire_rgb_offsets(this->rgb_order_, r, g, b);
+    const uint8_t offset = this->is_wrgb_ ? 1 : 0;
+    const uint8_t white = this->is_wrgb_ ? 0 : 3;
+    for (uint16_t i = 0; i < count; i++, src += src_stride, dst += stride) {
+      dst[r + offset] = src[0];
+      dst[g + offset] = src[1];
+      dst[b + offset] = src[2];
+      if (stride == 4) {
+        dst[white] = src_stride == 4 ? src[3] : 0;
+      }
+    }
+  }
+  // The frame goes out once, from commit_realtime_frame_().
+  this->realtime_frame_open_ = true;
+}
+
+void CFXLightOutput::commit_realtime_frame_(uint32_t rx_us) {
+  this->realtime_frame_open_ = false;
+  if (this->buf_ == nullptr || this->is_failed()) {
+    return;
+  }
+  this->mark_frame_dirty();
+  this->realtime_rx_us_ = rx_us != 0 ? rx_us : 1;
+  this->last_refresh_ = micros();
+  this->mark_shown_();
+  // Same coordination as an effect frame: parallel lanes wait for their
+  // group and RMT outputs for the barrier, so a stream split over several
+  // outputs launches together.
+  if (this->is_parallel_transport()) {
+    if (this->request_parallel_group_flush_() &&
+        this->request_parallel_shared_group_flush_()) {
+      this->commit_transmit_();
+    }
+    return;
+  }
+  if (CFXTransmitBarrier::get().request_transmit(this)) {
+    this->commit_transmit_();
+  }
+}
+
+void CFXLightOutput::set_realtime_live_(bool live) {
+  this->realtime_live_ = live;
+  this->realtime_frame_open_ = false;
+  this->realtime_rx_us_ = 0;
+  this->mark_frame_dirty();
+  // Pause or resume the segment coordinator's runner for the streamed span.
+  this->invalidate_segment_coord_schedule_();
+  if (live) {
     return;
   }
+  // Hand the range back: repaint the light's own state over the last
+  // streamed frame. Running effects redraw it on their next apply().
+  const int index = this->realtime_segment_index_;
+  if (index >= 0 &&
+      static_cast<size_t>(index) < this->segment_light_states_.size()) {
+    auto *seg_state = this->segment_light_states_[index];
+    seg_state->get_output()->update_state(seg_state);
+    this->request_segment_solid_repaint_flush(seg_state);
+    return;
+  }
+  if (this->state_parent_ != nullptr) {
+    this->update_state(this->state_parent_);
+  }
+  this->schedule_show();
 }
+#endif  // CFX_REALTIME_ENABLED
 
 // --- Write State (Fire-and-Forget DMA) ---
 
+// Hashes buf_ and power scale so stage_transmit_() can skip repeat frames.
+uint32_t CFXLightOutput::hash_frame_() const {
+  const size_t len = this->get_buffer_size_();
+  uint32_t h = 0x811C9DC5u ^ this->get_power_transmit_scale_();
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    uint32_t word;
+    memcpy(&word, this->buf_ + i, sizeof(word));
+    h = (h ^ word) * 0x9E3779B1u;
+    h ^= h >> 15;
+  }
+  for (; i < len; i++) {
+    h = (h ^ this->buf_[i]) * 0x9E3779B1u;
+    h ^= h >> 15;
+  }
+  return h;
+}
+
 // P3: Called by CFXTransmitBarrier when all registered outputs are ready.
 // Encapsulates the transport-specific DMA fire sequence so the barrier can
 // trigger it on any output without knowing its transport type.
 void CFXLightOutput::commit_transmit_() {
+  if (this->stage_transmit_()) {
+    this->launch_staged_transmit_();
+  }
+}
+
+bool CFXLightOutput::stage_transmit_() {
+#ifdef CFX_REALTIME_ENABLED
+  if (this->realtime_frame_open_) {
+    // Other segments' pixels ride along with the stream's commit.
+    return false;
+  }
+#endif
 #ifdef USE_POWER_SUPPLY
   if (this->has_power_demand_()) {
+    if (!this->power_supply_requested_) {
+      // The rail was off, so the LEDs lost the last frame.
+      this->sent_frame_valid_ = false;
+    }
     this->request_power_supply_();
   }
 #endif
+  // Skip the copy, power scaling and DMA for a frame identical to the one
+  // already on the wire (static colours, frozen or completed effects), but
+  // resend at least once per keepalive interval. Parallel lanes share one
+  // group frame and always flush.
+  const bool dedup = this->keepalive_interval_ms_ != 0 &&
+                     this->transport_ != TRANSPORT_PARALLEL &&
+                     this->buf_ != nullptr;
+  uint32_t frame_hash = 0;
+  if (dedup) {
+    frame_hash = this->hash_frame_();
+    if (this->sent_frame_valid_ && frame_hash == this->sent_frame_hash_ &&
+        (esphome::millis() - this->sent_frame_ms_) <
+            this->keepalive_interval_ms_) {
+      this->perf_diag_total_dedup_skips_++;
+#ifdef USE_POWER_SUPPLY
+      this->schedule_power_supply_release_();
+#endif
+      return false;
+    }
+  }
+  this->staged_dedup_ = dedup;
+  this->staged_frame_hash_ = frame_hash;
+  this->perf_diag_last_flush_valid_ = false;
+
   if (this->transport_ == TRANSPORT_SPI) {
     esphome::App.feed_wdt();
     this->flush_spi_();
   } else if (this->transport_ == TRANSPORT_PARALLEL) {
     esphome::App.feed_wdt();
     this->flush_parallel_();
-  } else {
-    const uint32_t stagger_gap_us = rmt_launch_stagger_gap_us();
-    uint32_t launch_us = micros();
-    if (stagger_gap_us > 0 && g_last_rmt_launch_us != 0) {
-      const uint32_t since_last_launch = launch_us - g_last_rmt_launch_us;
-      if (since_last_launch < stagger_gap_us) {
-        const uint32_t gate_us = stagger_gap_us - since_last_launch;
-        this->perf_diag_total_gate_us_ += gate_us;
-        if (gate_us > this->perf_diag_max_gate_us_) {
-          this->perf_diag_max_gate_us_ = gate_us;
-        }
-        esp_rom_delay_us(gate_us);
-        launch_us = micros();
+  } else if (this->stage_rmt_frame_()) {
+    return true;
+  }
+  this->finish_transmit_();
+  return false;
+}
+
+bool CFXLightOutput::launch_staged_transmit_() {
+  const uint32_t stagger_gap_us = rmt_launch_stagger_gap_us();
+  uint32_t launch_us = micros();
+  if (stagger_gap_us > 0 && g_last_rmt_launch_us != 0) {
+    const uint32_t since_last_launch = launch_us - g_last_rmt_launch_us;
+    if (since_last_launch < stagger_gap_us) {
+      const uint32_t gate_us = stagger_gap_us - since_last_launch;
+      this->perf_diag_total_gate_us_ += gate_us;
+      if (gate_us > this->perf_diag_max_gate_us_) {
+        this->perf_diag_max_gate_us_ = gate_us;
       }
-    }
-    g_last_rmt_launch_us = launch_us;
-    this->perf_diag_last_launch_slot_ =
-        static_cast<uint8_t>(g_rmt_launch_seq & 0x3);
-    g_rmt_launch_seq++;
-    this->flush_rmt_();
+      esp_rom_delay_us(gate_us);
+      launch_us = micros();
+    }
+  }
+  g_last_rmt_launch_us = launch_us;
+  this->perf_diag_last_launch_slot_ =
+      static_cast<uint8_t>(g_rmt_launch_seq & 0x3);
+  g_rmt_launch_seq++;
+  this->launch_rmt_frame_();
+  const bool launched = this->perf_diag_last_flush_valid_;
+  this->finish_transmit_();
+  return launched;
+}
+
+void CFXLightOutput::finish_transmit_() {
+  if (this->staged_dedup_) {
+    // Only a launched frame counts as sent; a coalesced or deferred flush
+    // must still go out on the next request.
+    this->sent_frame_valid_ = this->perf_diag_last_flush_valid_;
+    this->sent_frame_hash_ = this->staged_frame_hash_;
+    this->sent_frame_ms_ = esphome::millis();
+    this->staged_dedup_ = false;
+  }
+#ifdef CFX_REALTIME_ENABLED
+  if (this->realtime_rx_us_ != 0 && this->perf_diag_last_flush_valid_) {
+    CFXRealtimeIngest::get().record_latency(this,
+                                            micros() - this->realtime_rx_us_);
+    this->realtime_rx_us_ = 0;
   }
+#endif
 #ifdef USE_POWER_SUPPLY
   this->schedule_power_supply_release_();
 #endif
@@ -6894,6 +7930,12 @@ void CFXLightOutput::write_state(light::LightState *state) {
   this->perf_diag_last_flush_total_us_ = 0;
   this->perf_diag_last_flush_tx_us_ = 0;
 
+#ifdef CFX_REALTIME_ENABLED
+  if (state != nullptr && this->realtime_owns_segment_(-1)) {
+    return;  // The live stream owns the strip and commits its own frames.
+  }
+#endif
+
   if (!this->has_outro() &&
       ((state != nullptr && active_cfx_effect_is_clean_mono_idle(state)) ||
        (state == nullptr && this->seg_last_flush_mask_ == 0 &&
@@ -6904,7 +7946,7 @@ void CFXLightOutput::write_state(light::LightState *state) {
     
     // Evaluate and log idle state even when the rendering pipeline is fully suppressed
     this->refresh_segment_coordination_mask_();
-    const uint8_t segment_idle_mask =
+    const CFXSegmentMask segment_idle_mask =
         this->collect_clean_mono_idle_segment_mask_();
     this->apply_mono_idle_loop_state_(segment_idle_mask);
     return;
@@ -7016,28 +8058,11 @@ void CFXLightOutput::write_state(light::LightState *state) {
   this->mark_shown_();
 
 #if defined(CFX_VISUALIZER_ENABLED) && defined(USE_WIFI)
-  // Visualizer UDP broadcast. Runs BEFORE rmt_tx_wait_all_done so the
-  // sendto() syscall cannot stall between the DMA wait and rmt_transmit.
+  // Visualizer preview: decimated snapshot handed to the sender task;
+  // encoding and sendto() never run on the render path.
   // Internal dev tool only -- not compiled unless CFX_VISUALIZER_ENABLED.
-  if (this->visualizer_enabled_ && !this->visualizer_ip_.empty()) {
-    if (this->socket_fd_ < 0)
-      this->socket_fd_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
-    if (this->socket_fd_ >= 0) {
-      struct sockaddr_in dest_addr;
-      dest_addr.sin_addr.s_addr = ::inet_addr(this->visualizer_ip_.c_str());
-      dest_addr.sin_family = AF_INET;
-      dest_addr.sin_port = ::htons(this->visualizer_port_);
-      size_t buf_len = this->get_buffer_size_();
-      this->visualizer_pkt_.clear();
-      this->visualizer_pkt_.reserve(buf_len + 1);
-      this->visualizer_pkt_.push_back(VISUALIZER_TYPE_PIXELS);
-      this->visualizer_pkt_.insert(this->visualizer_pkt_.end(), this->buf_,
-                                   this->buf_ + buf_len);
-      ::sendto(this->socket_fd_, this->visualizer_pkt_.data(),
-               this->visualizer_pkt_.size(), 0,
-               (struct sockaddr *)&dest_addr, sizeof(dest_addr));
-    }
-  }
+  CFXVisualizerStream::get().submit_frame(this->visualizer_slot_, this->buf_,
+                                          millis());
 #endif // CFX_VISUALIZER_ENABLED
 
   // Segment-owned parallel frames are coalesced per-lane by request_segment_flush().
@@ -7173,13 +8198,20 @@ record_write_perf:
 // --- RMT Transport Flush ---
 
 void CFXLightOutput::flush_rmt_() {
+  if (this->stage_rmt_frame_()) {
+    this->launch_rmt_frame_();
+  }
+}
+
+bool CFXLightOutput::stage_rmt_frame_() {
   const uint32_t flush_start_us = micros();
+  this->rmt_staged_buf_ = nullptr;
 
   if (this->is_failed() || this->buf_ == nullptr || this->rmt_buf_ == nullptr ||
       this->channel_ == nullptr || this->encoder_ == nullptr ||
       this->num_leds_ == 0) {
     this->perf_diag_last_flush_valid_ = false;
-    return;
+    return false;
   }
 
   // P2: use non-blocking flag poll (fast path: ISR already cleared the flag).
@@ -7188,13 +8220,15 @@ void CFXLightOutput::flush_rmt_() {
   uint32_t timeout_ms = (physical_leds * 30u / 1000u) + 20u;
   if (timeout_ms < 15u) timeout_ms = 15u;
 
-  if (this->rmt_tx_in_flight_) {
+  if (!this->rmt_tx_slot_free_()) {
     const bool segment_epoch_preflush =
         this->has_segments() && this->seg_last_flush_mask_ != 0 &&
         !this->has_outro();
     const bool whole_frame_preflush =
         this->seg_last_flush_mask_ == 0 && !this->has_outro();
-    if (!this->rmt_dma_enabled_ &&
+    // Double-buffered, both buffers are busy: coalesce and let loop()
+    // launch as soon as the front frame completes.
+    if (!this->rmt_dma_enabled_ && !this->rmt_double_buffered_() &&
         (CFXTransmitBarrier::get().rmt_output_count() < 2 ||
          segment_epoch_preflush || whole_frame_preflush) &&
         this->wait_for_rmt_tx_(timeout_ms,
@@ -7209,15 +8243,16 @@ void CFXLightOutput::flush_rmt_() {
       this->perf_diag_total_rmt_coalesced_flushes_++;
       this->perf_diag_last_flush_valid_ = false;
       this->update_high_frequency_loop_request_();
-      return;
+      return false;
     }
   }
 
-  if (!this->wait_for_rmt_tx_(timeout_ms, "flush")) {
+  if (!this->rmt_tx_slot_free_() &&
+      !this->wait_for_rmt_tx_(timeout_ms, "flush")) {
     ESP_LOGE(TAG, "RMT TX timeout (Wait: %" PRIu32 "ms, physical LEDs: %" PRIu32 ")",
              timeout_ms, physical_leds);
     this->status_set_warning();
-    return;
+    return false;
   }
   this->harvest_rmt_encoder_diag_();
   this->reset_rmt_encoder_diag_();
@@ -7228,6 +8263,10 @@ void CFXLightOutput::flush_rmt_() {
     if (dma_guard_us > 0) {
       this->perf_diag_total_dma_guard_wait_us_ += dma_guard_us;
       this->perf_diag_total_dma_guard_hits_++;
+#ifdef USE_CFX_PROFILER
+      chimera_fx::CFXProfiler::get().record_stage(
+          chimera_fx::CFX_STAGE_DMA_WAIT, dma_guard_us);
+#endif
       if (dma_guard_us > this->perf_diag_max_dma_guard_wait_us_) {
         this->perf_diag_max_dma_guard_wait_us_ = dma_guard_us;
       }
@@ -7237,79 +8276,80 @@ void CFXLightOutput::flush_rmt_() {
     }
   }
 
-  // Copy pixel buffer → RMT buffer and fire
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
-  const size_t logical_buffer_size = this->get_buffer_size_();
-  const size_t transmit_buffer_size = this->get_rmt_transmit_buffer_size_();
-  const uint8_t pixel_stride = this->get_pixel_stride_();
-  uint8_t *rmt_dest = this->rmt_buf_;
-  if (this->sacrificial_pixel_) {
-    memset(rmt_dest, 0, pixel_stride);
-    rmt_dest += pixel_stride;
-  }
-  memcpy(rmt_dest, this->buf_, logical_buffer_size);
-  this->apply_power_scale_to_buffer_(this->rmt_buf_, transmit_buffer_size);
-#else
-  // Pre-5.3: encode bytes → RMT symbols manually
-  const size_t transmit_buffer_size = this->get_rmt_transmit_buffer_size_();
+#ifdef USE_CFX_PROFILER
+  const uint32_t copy_start_us = micros();
+#endif
+  // Copy pixel buffer → RMT buffer; launch_rmt_frame_() fires it.
   const uint8_t pixel_stride = this->get_pixel_stride_();
-  size_t sz = 0;
-  uint8_t *psrc = this->buf_;
-  rmt_symbol_word_t *pdest = this->rmt_buf_;
-  const uint8_t power_scale = this->get_power_transmit_scale_();
-  while (this->sacrificial_pixel_ && sz < pixel_stride) {
-    for (int i = 0; i < 8; i++) {
-      pdest->val = this->params_.bit0.val;
-      pdest++;
-    }
-    sz++;
-  }
-  while (sz < transmit_buffer_size) {
-    uint8_t b = *psrc;
-    if (power_scale < 255) {
-      b = static_cast<uint8_t>((static_cast<uint16_t>(b) *
-                                    power_scale +
-                                127u) /
-                               255u);
-    }
-    for (int i = 0; i < 8; i++) {
-      pdest->val = (b & (1 << (7 - i))) ? this->params_.bit1.val
-                                        : this->params_.bit0.val;
-      pdest++;
-    }
-    sz++;
-    psrc++;
-  }
-  if (this->params_.reset.duration0 > 0 || this->params_.reset.duration1 > 0) {
-    pdest->val = this->params_.reset.val;
-    pdest++;
+  uint16_t dirty_lo = 0;
+  uint16_t dirty_hi = 0;
+  this->take_encode_range_(dirty_lo, dirty_hi);
+  uint8_t *launch_buf = this->rmt_buf_;
+  if (this->rmt_zero_copy_()) {
+    launch_buf = this->stage_rmt_zero_copy_(dirty_lo, dirty_hi);
+  } else {
+    this->widen_for_back_buffer_(dirty_lo, dirty_hi);
+    uint8_t *rmt_dest = this->rmt_buf_;
+    if (this->sacrificial_pixel_) {
+      memset(rmt_dest, 0, pixel_stride);
+      rmt_dest += pixel_stride;
+    }
+    this->prep_transmit_(rmt_dest, dirty_lo, dirty_hi, this->rmt_buf_sums_);
+    if (this->limit_staged_frame_(rmt_dest, this->rmt_buf_sums_)) {
+      dirty_lo = 0;
+      dirty_hi = this->num_leds_;
+    }
   }
+#ifdef USE_CFX_PROFILER
+  chimera_fx::CFXProfiler::get().record_stage(chimera_fx::CFX_STAGE_COPY,
+                                              micros() - copy_start_us);
+#endif
+#ifdef USE_CFX_TRACE
+  chimera_fx::CFXTrace::get().span(chimera_fx::CFX_TRACE_TX_PREP,
+                                   copy_start_us, micros() - copy_start_us,
+                                   this->pin_);
 #endif
 
+  this->rmt_staged_buf_ = launch_buf;
+  this->rmt_staged_lo_ = dirty_lo;
+  this->rmt_staged_hi_ = dirty_hi;
+  this->rmt_staged_start_us_ = flush_start_us;
+  return true;
+}
+
+void CFXLightOutput::launch_rmt_frame_() {
+  uint8_t *const launch_buf = this->rmt_staged_buf_;
+  if (launch_buf == nullptr) {
+    return;
+  }
+  this->rmt_staged_buf_ = nullptr;
+  const uint16_t dirty_lo = this->rmt_staged_lo_;
+  const uint16_t dirty_hi = this->rmt_staged_hi_;
+  const uint32_t flush_start_us = this->rmt_staged_start_us_;
+  const size_t transmit_buffer_size = this->get_rmt_transmit_buffer_size_();
+
   // Fire-and-forget: rmt_transmit returns immediately; RMT handles the rest.
   rmt_transmit_config_t config;
   memset(&config, 0, sizeof(config));
   esp_err_t error = ESP_OK;
+  portENTER_CRITICAL(&g_rmt_queue_mux);
+  this->rmt_tx_queued_++;
   this->rmt_tx_in_flight_ = true;
+  portEXIT_CRITICAL(&g_rmt_queue_mux);
   if (this->rmt_dma_enabled_) {
     g_rmt_dma_active_count++;
   }
 
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
-  error = rmt_transmit(this->channel_, this->encoder_, this->rmt_buf_,
+  error = rmt_transmit(this->channel_, this->encoder_, launch_buf,
                        transmit_buffer_size, &config);
-#else
-  size_t len =
-      transmit_buffer_size * 8 +
-      ((this->params_.reset.duration0 > 0 || this->params_.reset.duration1 > 0)
-           ? 1
-           : 0);
-  error = rmt_transmit(this->channel_, this->encoder_, this->rmt_buf_,
-                       len * sizeof(rmt_symbol_word_t), &config);
-#endif
 
   if (error != ESP_OK) {
-    this->rmt_tx_in_flight_ = false;
+    portENTER_CRITICAL(&g_rmt_queue_mux);
+    if (this->rmt_tx_queued_ > 0) {
+      this->rmt_tx_queued_--;
+    }
+    this->rmt_tx_in_flight_ = this->rmt_tx_queued_ > 0;
+    portEXIT_CRITICAL(&g_rmt_queue_mux);
     if (this->rmt_dma_enabled_ && g_rmt_dma_active_count > 0) {
       g_rmt_dma_active_count--;
     }
@@ -7319,7 +8359,20 @@ void CFXLightOutput::flush_rmt_() {
   }
   // P2: flag was armed before transmit so a short transaction cannot complete
   // before the ISR has valid in-flight state to clear.
+  // The launched buffer now belongs to the driver; the next frame encodes
+  // into the other one.
+  if (this->rmt_zero_copy_()) {
+    this->finish_rmt_zero_copy_(launch_buf, dirty_lo, dirty_hi);
+  } else if (this->rmt_double_buffered_()) {
+    std::swap(this->rmt_buf_, this->rmt_buf_back_);
+    std::swap(this->rmt_buf_sums_, this->rmt_buf_back_sums_);
+    this->rmt_primed_mask_ = swap_primed_mask_(this->rmt_primed_mask_);
+  }
   const uint32_t rmt_launch_us = micros();
+#ifdef USE_CFX_TRACE
+  chimera_fx::CFXTrace::get().instant(chimera_fx::CFX_TRACE_DMA_START,
+                                      this->pin_);
+#endif
   if (this->perf_diag_last_rmt_tx_launch_us_ != 0) {
     const uint32_t interval_us =
         rmt_launch_us - this->perf_diag_last_rmt_tx_launch_us_;
@@ -7402,7 +8455,12 @@ void CFXLightOutput::flush_spi_() {
              this->spi_tx_in_flight_, static_cast<unsigned>(this->tracked_brightness_));
     this->spi_diag_flush_logs_++;
   }
-  if (!this->wait_for_spi_tx_(timeout_ms, "flush")) {
+  // Only the buffer about to be packed has to be off the wire; with two, the
+  // previous frame keeps streaming from the other one.
+  const bool spi_double_buffered = this->spi_frame_bufs_[1] != nullptr;
+  if (!this->drain_spi_tx_(
+          spi_double_buffered ? this->spi_last_frame_chunks_ : 0, timeout_ms,
+          "flush")) {
     return;
   }
 
@@ -7416,6 +8474,10 @@ void CFXLightOutput::flush_spi_() {
   if (dma_guard_us > 0) {
     this->perf_diag_total_dma_guard_wait_us_ += dma_guard_us;
     this->perf_diag_total_dma_guard_hits_++;
+#ifdef USE_CFX_PROFILER
+    chimera_fx::CFXProfiler::get().record_stage(chimera_fx::CFX_STAGE_DMA_WAIT,
+                                                dma_guard_us);
+#endif
     if (dma_guard_us > this->perf_diag_max_dma_guard_wait_us_) {
       this->perf_diag_max_dma_guard_wait_us_ = dma_guard_us;
     }
@@ -7424,91 +8486,118 @@ void CFXLightOutput::flush_spi_() {
     }
   }
 
-  const uint32_t pack_start_us = micros();
-  uint8_t *ptr = this->spi_frame_buf_;
-  const uint8_t power_scale = this->get_power_transmit_scale_();
-
-  // 1. Start frame: 32 bits of 0x00
-  *ptr++ = 0x00;
-  *ptr++ = 0x00;
-  *ptr++ = 0x00;
-  *ptr++ = 0x00;
-
-  // 2. LED frames: 0xFF, Blue, Green, Red
-  uint8_t *src = this->buf_;
-  for (int i = 0; i < this->num_leds_; i++) {
-    *ptr++ = 0xFF; // Global brightness: max (11111111)
-
-    // Source buffer `buf_` is already ordered according to `rgb_order_`
-    // (handled by get_view_internal / ESPColorView).
-    // For APA102/SK9822 matching fastled behavior, we default to BGR order
-    // in light.py, so buf_[0] is B, buf_[1] is G, buf_[2] is R.
-    for (uint8_t c = 0; c < 3; c++) {
-      uint8_t value = *src++;
-      if (power_scale < 255) {
-        value = static_cast<uint8_t>((static_cast<uint16_t>(value) *
-                                          power_scale +
-                                      127u) /
-                                     255u);
+  const uint8_t target = this->spi_buf_index_;
+  uint8_t *frame = this->spi_frame_bufs_[target];
+  uint16_t dirty_lo = 0;
+  uint16_t dirty_hi = 0;
+  this->take_encode_range_(dirty_lo, dirty_hi);
+  if (spi_double_buffered) {
+    widen_for_stale_buffer_(dirty_lo, dirty_hi, this->spi_prev_lo_,
+                            this->spi_prev_hi_, this->spi_primed_mask_,
+                            this->num_leds_);
+  }
+
+  // Async fire-and-forget: each chunk is packed and queued in turn, so DMA
+  // drives the first one on the wire while the CPU packs the next. Start and
+  // end frames were written by init_spi_frame_(); LED frames outside the
+  // dirty range still hold the bytes last packed into this buffer. For
+  // APA102/SK9822 matching fastled behavior, light.py defaults to BGR order,
+  // so buf_ is already B, G, R.
+  const size_t frame_size = this->get_spi_frame_size_();
+  uint32_t pack_us = 0;
+  uint32_t queue_us = 0;
+  uint8_t queued = 0;
+  esp_err_t err = ESP_OK;
+  esphome::App.feed_wdt();
+  for (uint8_t chunk = 0; chunk < this->spi_chunk_count_; chunk++) {
+    const bool last = chunk + 1 == this->spi_chunk_count_;
+    const uint16_t chunk_lo = chunk * this->spi_chunk_leds_;
+    const uint16_t chunk_hi =
+        last ? this->num_leds_ : chunk_lo + this->spi_chunk_leds_;
+    const uint32_t pack_start_us = micros();
+    this->prep_transmit_(frame + 4, std::max(dirty_lo, chunk_lo),
+                         std::min(dirty_hi, chunk_hi),
+                         this->spi_frame_sums_[target]);
+    const uint32_t queue_start_us = micros();
+    pack_us += queue_start_us - pack_start_us;
+#ifdef USE_CFX_TRACE
+    chimera_fx::CFXTrace::get().span(chimera_fx::CFX_TRACE_TX_PREP,
+                                     pack_start_us,
+                                     queue_start_us - pack_start_us,
+                                     this->pin_);
+#endif
+
+    const size_t begin = chunk == 0 ? 0 : 4 + static_cast<size_t>(chunk_lo) * 4;
+    const size_t end =
+        last ? frame_size : 4 + static_cast<size_t>(chunk_hi) * 4;
+    spi_transaction_t &trans = this->spi_trans_[target][chunk];
+    memset(&trans, 0, sizeof(trans));
+    trans.length = (end - begin) * 8;
+    trans.tx_buffer = frame + begin;
+    g_spi_dma_active_count++;
+    err = spi_device_queue_trans(this->spi_device_, &trans, 0);
+    queue_us += micros() - queue_start_us;
+    if (err != ESP_OK) {
+      if (g_spi_dma_active_count > 0) {
+        g_spi_dma_active_count--;
       }
-      *ptr++ = value;
+      break;
     }
+    queued++;
+    this->spi_trans_pending_++;
+#ifdef USE_CFX_TRACE
+    chimera_fx::CFXTrace::get().instant(chimera_fx::CFX_TRACE_DMA_START,
+                                        this->pin_);
+#endif
   }
+  const uint32_t tx_queue_us = micros();
+  esphome::App.feed_wdt();
+  this->spi_tx_in_flight_ = this->spi_trans_pending_ > 0;
 
-  // 3. End frame
-  size_t end_size = this->get_spi_end_frame_size_();
-  uint8_t end_byte = this->get_spi_end_frame_byte_();
-  for (size_t i = 0; i < end_size; i++) {
-    *ptr++ = end_byte;
-  }
-  const uint32_t pack_us = micros() - pack_start_us;
   this->perf_diag_total_spi_pack_us_ += pack_us;
+#ifdef USE_CFX_PROFILER
+  chimera_fx::CFXProfiler::get().record_stage(chimera_fx::CFX_STAGE_COPY,
+                                              pack_us);
+#endif
   if (pack_us > this->perf_diag_max_spi_pack_us_) {
     this->perf_diag_max_spi_pack_us_ = pack_us;
   }
 
-
-  // Async fire-and-forget: queue_trans returns immediately (~5us).
-  // DMA drives the wire in hardware while the CPU is free for the next frame.
-  // The previous transaction was drained by wait_for_spi_tx_() at the top of
-  // this function, guaranteeing spi_frame_buf_ is safe to overwrite.
-  const uint32_t tx_start_us = micros();
-  esphome::App.feed_wdt();
-
-  memset(&this->spi_trans_, 0, sizeof(this->spi_trans_));
-  this->spi_trans_.length = this->get_spi_frame_size_() * 8;
-  this->spi_trans_.tx_buffer = this->spi_frame_buf_;
-  g_spi_dma_active_count++;
-  esp_err_t err = spi_device_queue_trans(this->spi_device_, &this->spi_trans_, 0);
-
-  const uint32_t tx_queue_us = micros();
-  esphome::App.feed_wdt();
-
-  if (err != ESP_OK) {
-    if (g_spi_dma_active_count > 0) {
-      g_spi_dma_active_count--;
+  if (queued > 0) {
+    // The other buffer is next; this one belongs to the driver until its
+    // chunks are collected by drain_spi_tx_().
+    this->spi_last_frame_chunks_ = queued;
+    if (spi_double_buffered) {
+      this->spi_buf_index_ = target ^ 1u;
+      this->spi_primed_mask_ = swap_primed_mask_(this->spi_primed_mask_);
     }
+  }
+  if (err != ESP_OK) {
     this->spi_queue_error_count_++;
     ESP_LOGW(TAG,
-             "SPI TX queue failed (err=%d, frame=%u bytes, waits=%" PRIu32
-             ", timeouts=%" PRIu32 ", queue_err=%" PRIu32 ")",
-             err, static_cast<unsigned>(this->get_spi_frame_size_()),
-             this->spi_wait_count_, this->spi_wait_timeout_count_,
-             this->spi_queue_error_count_);
+             "SPI TX queue failed (err=%d, frame=%u bytes, chunk=%u/%u, "
+             "waits=%" PRIu32 ", timeouts=%" PRIu32 ", queue_err=%" PRIu32 ")",
+             err, static_cast<unsigned>(frame_size), queued,
+             this->spi_chunk_count_, this->spi_wait_count_,
+             this->spi_wait_timeout_count_, this->spi_queue_error_count_);
     this->status_set_warning();
-    // spi_tx_in_flight_ stays false: next flush skips wait and retries.
+    // Unqueued chunks are retried whole with the next frame from this buffer.
   } else {
-    // Mark in-flight: wait_for_spi_tx_() at next flush start drains the result
-    // and records actual wire time via the DMA completion timestamp.
-    this->spi_tx_in_flight_ = true;
+    // Queued: drain_spi_tx_() at a later flush collects the results and
+    // records actual wire time via the DMA completion timestamp.
     this->spi_last_flush_ms_ = esphome::millis();
     this->record_led_frame_();
     if (this->power_manager_ != nullptr) {
       this->power_manager_->record_output_frame(this);
     }
+    // Chunks are on the wire as they are packed, so a frame the limiter
+    // rescales is corrected by the one right after it.
+    const CFXPowerSums &sums = this->spi_frame_sums_[target];
+    if (this->report_power_frame_(sums) != sums.scale) {
+      this->schedule_show();
+    }
     this->status_clear_warning();
-    // Record queue-submit latency (not wire time — that is in wait_for_spi_tx_).
-    const uint32_t queue_us = tx_queue_us - tx_start_us;
+    // Record queue-submit latency (not wire time — that is in drain_spi_tx_).
     this->perf_diag_total_spi_queue_us_ += queue_us;
     if (queue_us > this->perf_diag_max_spi_queue_us_) {
       this->perf_diag_max_spi_queue_us_ = queue_us;
@@ -7522,31 +8611,8 @@ void CFXLightOutput::flush_spi_() {
 void CFXLightOutput::send_visualizer_metadata(const std::string &name,
                                               const std::string &palette) {
 #if defined(CFX_VISUALIZER_ENABLED) && defined(USE_WIFI)
-  if (this->visualizer_enabled_ && !this->visualizer_ip_.empty()) {
-    if (this->socket_fd_ < 0) {
-      this->socket_fd_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
-    }
-    if (this->socket_fd_ >= 0) {
-      struct sockaddr_in dest_addr;
-      dest_addr.sin_addr.s_addr = ::inet_addr(this->visualizer_ip_.c_str());
-      dest_addr.sin_family = AF_INET;
-      dest_addr.sin_port = ::htons(this->visualizer_port_);
-
-      std::vector<uint8_t> pkt;
-      pkt.push_back(VISUALIZER_TYPE_METADATA);
-      pkt.push_back('C');
-      pkt.push_back('F');
-      pkt.push_back('X'); // Magic Header
-      pkt.insert(pkt.end(), name.begin(), name.end());
-      if (!palette.empty()) {
-        pkt.push_back(':');
-        pkt.insert(pkt.end(), palette.begin(), palette.end());
-      }
-
-      ::sendto(this->socket_fd_, pkt.data(), pkt.size(), 0,
-               (struct sockaddr *)&dest_addr, sizeof(dest_addr));
-    }
-  }
+  CFXVisualizerStream::get().submit_metadata(this->visualizer_slot_, name,
+                                             palette);
 #endif // CFX_VISUALIZER_ENABLED
 }
 
@@ -7575,38 +8641,7 @@ light::ESPColorView CFXLightOutput::get_view_internal(int32_t index) const {
   }
 
   int32_t r = 0, g = 0, b = 0;
-  switch (this->rgb_order_) {
-  case ORDER_RGB:
-    r = 0;
-    g = 1;
-    b = 2;
-    break;
-  case ORDER_RBG:
-    r = 0;
-    g = 2;
-    b = 1;
-    break;
-  case ORDER_GRB:
-    r = 1;
-    g = 0;
-    b = 2;
-    break;
-  case ORDER_GBR:
-    r = 2;
-    g = 0;
-    b = 1;
-    break;
-  case ORDER_BGR:
-    r = 2;
-    g = 1;
-    b = 0;
-    break;
-  case ORDER_BRG:
-    r = 1;
-    g = 2;
-    b = 0;
-    break;
-  }
+  wire_rgb_offsets(this->rgb_order_, r, g, b);
   uint8_t multiplier = (this->is_rgbw_ || this->is_wrgb_) ? 4 : 3;
   uint8_t white = this->is_wrgb_ ? 0 : 3;
 
@@ -7763,6 +8798,8 @@ void CFXLightOutput::dump_config() {
     }
   }
 
+  this->memory_budget_.log_config(TAG);
+
   constexpr uint32_t cfx_heap_floor = 15000   // Base System Margin
 #ifdef USE_WIFI
                                       + 30000 // Wi-Fi TX/RX buffers + LwIP
@@ -9,6 +9,8 @@
 
 #ifdef USE_ESP32
 
+#include "../cfx_effect/cfx_limits.h"
+#include "cfx_memory_budget.h"
 #include "esphome/components/light/addressable_light.h"
 #include "esphome/components/light/light_output.h"
 #include "esphome/components/light/light_state.h"
@@ -36,6 +38,7 @@ namespace esphome {
 namespace chimera_fx {
 class CFXAddressableLightEffect;
 class CFXRunner;
+struct CFXLayout;
 }
 
 namespace cfx_light {
@@ -44,6 +47,7 @@ using OutroCallback = std::function<bool()>;
 
 struct CFXRMTDoneContext {
   volatile bool *in_flight{nullptr};
+  volatile uint8_t *queued{nullptr}; // transactions not yet done
   bool dma_enabled{false};
 };
 class CFXVirtualSegmentLight;
@@ -51,7 +55,21 @@ class CFXPowerManager;
 
 // --- Segment Infrastructure (Phase 1) ---
 
-#define MAX_CFX_SEGMENTS 4
+// Coordination passes segments around as CFXSegmentMask bitsets indexed by
+// segment position, so MAX_CFX_SEGMENTS (cfx_limits.h) cannot exceed the
+// mask width.
+using CFXSegmentMask = uint32_t;
+static_assert(MAX_CFX_SEGMENTS <= sizeof(CFXSegmentMask) * 8,
+              "MAX_CFX_SEGMENTS exceeds the CFXSegmentMask width");
+
+inline CFXSegmentMask cfx_segment_bit(size_t index) {
+  return static_cast<CFXSegmentMask>(1u) << index;
+}
+// Lowest segment index in a non-empty mask. Coordination loops walk only the
+// set bits (`for (m = mask; m != 0; m &= m - 1)`), so idle segments are free.
+inline size_t cfx_segment_index(CFXSegmentMask mask) {
+  return static_cast<size_t>(__builtin_ctz(mask));
+}
 
 struct CFXSegmentDef {
   std::string id;
@@ -62,6 +80,9 @@ struct CFXSegmentDef {
   uint8_t outro_mode;     // 0 = inherit root default
   float intro_duration_s; // 0.0 = inherit root default
   float outro_duration_s; // 0.0 = inherit root default
+  // Wiring of the segment's LEDs (cfx_effect/cfx_layout.h); nullptr = a
+  // straight run.
+  const chimera_fx::CFXLayout *layout{nullptr};
 };
 
 struct CFXTurnOnDefaults {
@@ -139,6 +160,11 @@ struct CFXSegmentRuntimeSlot {
   bool bound{false};
   bool fallback{false};
   uint64_t due_at{0};
+  // Coalesced-flush barrier generations and mono-idle sleep start; tracked
+  // for every segment, coordinated or not.
+  uint16_t request_generation{0};
+  uint16_t flushed_generation{0};
+  uint32_t mono_idle_sleep_ms{0};
 };
 
 // Supported LED chipsets
@@ -169,6 +195,34 @@ struct CFXPowerModel {
   float white_channel_ma{20.0f};
 };
 
+// Channel byte sums of one frame as written to the wire (power scale
+// applied). The transmit-prep pass keeps one per transmit buffer and updates
+// it by delta over the dirty range; the power manager turns them into mA only
+// when it samples.
+struct CFXPowerSums {
+  uint32_t channels{0};  // Every colour byte, white included
+  uint32_t white{0};
+  uint8_t scale{255};    // Transmit scale the bytes were written at
+  bool valid{false};
+};
+
+// Wire byte sums of one segment of the frame in CFXPowerSums, same units.
+// Kept only while power accounting asks for per-segment attribution.
+struct CFXZonePowerSums {
+  uint32_t channels{0};
+  uint32_t white{0};
+};
+
+// Full-strip Color planes every effect on an output shares for transitions
+// (CFXLightOutput::get_transition_plane()). Indexed by LED, so segments on
+// the same strip use disjoint slices of each plane.
+enum CFXTransitionPlane : uint8_t {
+  TRANSITION_PLANE_INTRO,  // Last intro frame a dissolve starts from
+  TRANSITION_PLANE_TARGET, // Main frame a dissolve settles toward
+  TRANSITION_PLANE_OUTRO,  // Frozen last frame / Assembly colour cache
+  TRANSITION_PLANE_COUNT,
+};
+
 // RGB byte order in the protocol
 enum RGBOrder : uint8_t {
   ORDER_RGB,
@@ -194,12 +248,22 @@ struct LedParams {
 
 class CFXLightOutput : public light::AddressableLight {
 public:
-  ~CFXLightOutput(); // CFX-025: closes visualizer socket_fd_ to prevent FD leak
+  ~CFXLightOutput();
   void setup() override;
   void setup_state(light::LightState *state) override;
   void loop() override;
   void write_state(light::LightState *state) override;
   void update_state(light::LightState *state) override;
+  // Brightness gate for a frame of a cfx_dimmer hold (0..1, state included),
+  // ahead of the LightCall commits update_state() follows. Segmented outputs
+  // keep the gate open and bake brightness per segment instead.
+  void set_preview_brightness(float brightness) {
+    if (this->has_segments()) {
+      return;
+    }
+    this->tracked_brightness_ = light::to_uint8_scale(brightness);
+    this->correction_.set_local_brightness(this->tracked_brightness_);
+  }
   void on_shutdown() override;
   void on_master_update();
   void on_segment_update();
@@ -213,6 +277,12 @@ public:
   void drain_outro_callbacks();
   bool has_outro() const { return !this->outro_cbs_.empty(); }
   void note_show_request();
+  // Encode hint for the next transmit: only LEDs [lo, hi) changed since the
+  // previous one. Reported by effects that own the whole strip; any other
+  // writer marks the frame dirty, and a frame with no report (or a dirty
+  // mark) is re-encoded in full.
+  void note_dirty_range(uint16_t lo, uint16_t hi);
+  void mark_frame_dirty() { this->dirty_state_ = DIRTY_FULL; }
   void trigger_low_ram_warning(light::LightState *state);
   bool segment_coordinator_owns(light::LightState *state);
   bool register_parent_owned_segment(
@@ -268,9 +338,18 @@ public:
 
   // Public accessor for effect_data_ (used by virtual segment lights)
   uint8_t *get_effect_data() { return effect_data_; }
+  // num_leds_ Colors per plane, allocated once in setup() so effect
+  // transitions never allocate. nullptr if that allocation failed.
+  Color *get_transition_plane(CFXTransitionPlane plane) const {
+    return this->transition_planes_ != nullptr
+               ? this->transition_planes_ +
+                     static_cast<size_t>(plane) * this->num_leds_
+               : nullptr;
+  }
 
   // Config setters (called by light.py codegen)
   void set_pin(uint8_t pin) { this->pin_ = pin; }
+  uint8_t get_pin() const { return this->pin_; }
   void set_num_leds(uint16_t num_leds) { this->num_leds_ = num_leds; }
 #ifdef USE_POWER_SUPPLY
   void set_power_supply(power_supply::PowerSupply *supply) {
@@ -285,6 +364,14 @@ public:
   void set_sacrificial_pixel(bool enabled) {
     this->sacrificial_pixel_ = enabled;
   }
+  void set_zero_copy(bool enabled) { this->zero_copy_ = enabled; }
+  // `memory_placement:` for the HOT and COLD buffer classes.
+  void set_memory_placement(CFXMemClass cls, CFXMemPlacement placement) {
+    this->memory_budget_.set_placement(cls, placement);
+  }
+  const CFXMemoryBudget &get_memory_budget() const {
+    return this->memory_budget_;
+  }
   bool has_white_channel() const { return this->is_rgbw_ || this->is_wrgb_; }
   void set_turn_on_brightness(float brightness) {
     this->turn_on_defaults_.has_brightness = true;
@@ -316,6 +403,11 @@ public:
   void set_max_refresh_rate(uint32_t interval_us) {
     this->max_refresh_rate_ = interval_us;
   }
+  // Byte-identical frames are not re-sent until this much time has passed
+  // since the last transmit; 0 sends every frame.
+  void set_keepalive_interval(uint32_t interval_ms) {
+    this->keepalive_interval_ms_ = interval_ms;
+  }
   void set_runtime_debug_enabled(bool enabled) {
     this->runtime_debug_enabled_ = enabled;
   }
@@ -347,6 +439,44 @@ public:
   // P3: Called by CFXTransmitBarrier to fire the DMA transmit on this output.
   // Must be public — the barrier is an external caller with no class membership.
   void commit_transmit_();
+  // commit_transmit_() in two halves, so the barrier can stage every pending
+  // output before launching any. stage does the dedup check, the TX wait and
+  // the encode copy, and returns false when nothing is left to launch
+  // (deduplicated, coalesced, or a transport that launches while staging).
+  // launch only starts the RMT transaction and returns whether it went out.
+  bool stage_transmit_();
+  bool launch_staged_transmit_();
+  uint32_t get_last_rmt_launch_us() const {
+    return this->perf_diag_last_rmt_tx_launch_us_;
+  }
+#ifdef CFX_REALTIME_ENABLED
+  // Called by CFXRealtimeIngest. write stores `count` RGB or RGBW pixels
+  // (`src_stride` bytes each) into buf_ from LED `led` in wire channel order,
+  // with no gamma or brightness and holds this output's transmits until
+  // commit sends the frame through the transmit barrier; live hands the
+  // streamed range to the stream or gives it back.
+  void write_realtime_pixels_(uint16_t led, const uint8_t *src,
+                              uint16_t count, uint8_t src_stride);
+  void commit_realtime_frame_(uint32_t rx_us);
+  void set_realtime_live_(bool live);
+#endif
+  // Whether a live stream owns the LEDs `state` drives (the whole strip, or
+  // the streamed segment). Effects on such a light pause until it ends.
+  bool realtime_owns(light::LightState *state) const {
+#ifdef CFX_REALTIME_ENABLED
+    if (!this->realtime_live_ || state == nullptr) {
+      return false;
+    }
+    if (this->realtime_segment_index_ < 0) {
+      return true;
+    }
+    const size_t index = static_cast<size_t>(this->realtime_segment_index_);
+    return index < this->segment_light_states_.size() &&
+           this->segment_light_states_[index] == state;
+#else
+    return false;
+#endif
+  }
   void set_parallel_group(const std::string &group) {
     this->parallel_group_ = group;
   }
@@ -390,6 +520,29 @@ public:
   void request_power_reduction_refresh();
   float estimate_power_current_ma(const CFXPowerModel &model,
                                   float dynamic_scale = 1.0f) const;
+  // Sums of the frame last handed to the transport. Parallel lanes transpose
+  // straight from buf_, so theirs are taken from buf_ on demand.
+  CFXPowerSums get_power_sums() const;
+
+  // --- Power accounting ---
+  // Attribution is per segment (a "zone"); an unsegmented output is one zone
+  // for effect attribution and has no per-zone sums (they equal the totals).
+  static constexpr uint8_t POWER_NO_EFFECT = 0xFF;
+  void enable_power_zones() { this->power_zones_enabled_ = true; }
+  bool power_zones_enabled() const { return this->power_zones_enabled_; }
+  // Effects report the mode drawing LEDs [lo, hi) every frame they render:
+  // zones that start inside the span take it. POWER_NO_EFFECT on stop.
+  void note_power_effect(uint16_t lo, uint16_t hi, uint8_t mode);
+  uint8_t get_power_effect(size_t zone) const {
+    return zone < this->power_zone_effects_.size()
+               ? this->power_zone_effects_[zone]
+               : POWER_NO_EFFECT;
+  }
+  // Per-segment split of the frame get_power_sums() describes, in
+  // segment_defs_ order. Empty on unsegmented outputs.
+  const std::vector<CFXZonePowerSums> &get_zone_power_sums() const {
+    return this->zone_power_sums_;
+  }
 
   // --- Segment configuration (codegen setters) ---
   void add_segment_def(const std::string &id, uint16_t start, uint16_t stop,
@@ -400,6 +553,13 @@ public:
     segment_defs_.push_back(
         {id, start, stop, mirror, intro, outro, intro_dur, outro_dur});
   }
+  // Both layouts are codegen-emitted constants and are not copied.
+  void set_segment_layout(size_t index, const chimera_fx::CFXLayout *layout) {
+    if (index < segment_defs_.size())
+      segment_defs_[index].layout = layout;
+  }
+  void set_layout(const chimera_fx::CFXLayout *layout) { layout_ = layout; }
+  const chimera_fx::CFXLayout *get_layout() const { return layout_; }
   const std::vector<CFXSegmentDef> &get_segment_defs() const {
     return segment_defs_;
   }
@@ -414,7 +574,10 @@ public:
   }
 
   void add_segment_light_state(light::LightState *state) {
+    if (segment_light_states_.size() >= MAX_CFX_SEGMENTS)
+      return;
     segment_light_states_.push_back(state);
+    segment_runtime_slots_.emplace_back();
   }
   const std::vector<light::LightState *> &get_segment_light_states() const {
     return segment_light_states_;
@@ -458,13 +621,31 @@ public:
     this->visualizer_enabled_ = enabled;
 #endif
   }
+  void set_visualizer_interval(uint32_t interval_ms) {
+#ifdef CFX_VISUALIZER_ENABLED
+    this->visualizer_interval_ms_ = interval_ms;
+#endif
+  }
 
-protected:
-  enum VisualizerPacketType : uint8_t {
-    VISUALIZER_TYPE_PIXELS = 0x00,
-    VISUALIZER_TYPE_METADATA = 0x01,
-  };
+  // Realtime ingest setter. `protocol` is a CFXRealtimeProtocol; LEDs
+  // [start, start + count) take the stream, which is one segment when
+  // `segment_index` >= 0 and the whole strip otherwise.
+  void set_realtime(uint8_t protocol, uint16_t port, uint32_t address,
+                    uint16_t start, uint16_t count, uint32_t timeout_ms,
+                    int8_t segment_index) {
+#ifdef CFX_REALTIME_ENABLED
+    this->realtime_enabled_ = true;
+    this->realtime_protocol_ = protocol;
+    this->realtime_port_ = port;
+    this->realtime_address_ = address;
+    this->realtime_start_ = start;
+    this->realtime_count_ = count;
+    this->realtime_timeout_ms_ = timeout_ms;
+    this->realtime_segment_index_ = segment_index;
+#endif
+  }
 
+protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
 
   // Buffer size: 3 bytes/pixel (RGB) or 4 bytes/pixel (RGBW/WRGB)
@@ -492,6 +673,10 @@ protected:
   bool init_parallel_backend_();
   void deinit_parallel_backend_();
   void flush_rmt_();
+  // flush_rmt_() = stage (waits, encode copy) + launch (rmt_transmit).
+  bool stage_rmt_frame_();
+  void launch_rmt_frame_();
+  void finish_transmit_();
   void flush_spi_();
   void flush_parallel_();
   bool request_parallel_group_flush_();
@@ -527,32 +712,34 @@ protected:
   int find_segment_runtime_slot_(light::LightState *state) const;
   void clear_segment_runtime_slot_(size_t index);
   void clear_segment_idle_diag_();
+  void mark_segment_generations_flushed_();
   bool has_active_parent_owned_segments_(bool include_outro = false) const;
   void refresh_parent_owned_segment_slot_(CFXSegmentRuntimeSlot &slot);
   void refresh_parent_owned_segment_slots_();
   void refresh_segment_coordination_mask_(bool include_outro = false);
   void invalidate_segment_coord_schedule_();
-  void apply_segment_coordination_loop_state_(uint8_t owned_mask);
+  void apply_segment_coordination_loop_state_(CFXSegmentMask owned_mask);
   void apply_master_segment_coordination_loop_state_();
-  uint8_t collect_clean_mono_idle_segment_mask_() const;
-  void apply_mono_idle_loop_state_(uint8_t segment_idle_mask);
+  CFXSegmentMask collect_clean_mono_idle_segment_mask_() const;
+  void apply_mono_idle_loop_state_(CFXSegmentMask segment_idle_mask);
   void wake_mono_idle_light_state_(light::LightState *state);
   bool segment_participates_in_barrier_(light::LightState *state) const;
   bool service_segment_render_coordinator_();
   bool service_parallel_segment_group_coordinator_();
-  bool collect_segment_coordinator_epoch_(uint8_t &mask, uint8_t &count,
+  bool collect_segment_coordinator_epoch_(CFXSegmentMask &mask, uint8_t &count,
                                           uint64_t now,
                                           bool force_due = false,
                                           bool allow_outro = false);
-  bool render_segment_coordinator_epoch_(uint8_t &mask, uint8_t &count,
+  bool render_segment_coordinator_epoch_(CFXSegmentMask &mask, uint8_t &count,
                                          bool force_due = false,
                                          bool allow_outro = false);
-  void finalize_segment_coordinator_epoch_(uint8_t mask, uint8_t count,
+  void finalize_segment_coordinator_epoch_(CFXSegmentMask mask, uint8_t count,
                                            bool transmit);
-  void mark_segment_coordinator_epoch_committed_(uint8_t mask);
-  void flush_segment_coordinator_epoch_(uint8_t mask, uint8_t count);
-  void flush_parent_owned_segment_epoch_direct_(uint8_t mask, uint8_t count);
-  void schedule_segment_deferred_flush_(uint8_t mask, uint8_t count,
+  void mark_segment_coordinator_epoch_committed_(CFXSegmentMask mask);
+  void flush_segment_coordinator_epoch_(CFXSegmentMask mask, uint8_t count);
+  void flush_parent_owned_segment_epoch_direct_(CFXSegmentMask mask,
+                                                uint8_t count);
+  void schedule_segment_deferred_flush_(CFXSegmentMask mask, uint8_t count,
                                         uint32_t remaining_us);
   uint32_t get_segmented_rmt_refresh_floor_us_() const;
   // P2: non-blocking poll for previous RMT TX — mirrors wait_for_spi_tx_().
@@ -561,7 +748,24 @@ protected:
   // rmt_wait_timeout_count_ increments on each timeout; visible in the
   // ESP_LOGW that fires only when a timeout actually occurs.
   bool wait_for_rmt_tx_(uint32_t timeout_ms, const char *context);
-  bool wait_for_spi_tx_(uint32_t timeout_ms, const char *context);
+  // True when flush_rmt_() can encode without waiting: nothing on the wire,
+  // or the back transmit buffer is free while the front one streams.
+  bool rmt_tx_slot_free_() const;
+  bool rmt_double_buffered_() const { return this->rmt_buf_back_ != nullptr; }
+  void widen_for_back_buffer_(uint16_t &lo, uint16_t &hi);
+  // Zero-copy RMT: effects render into rmt_buf_ itself. stage returns the
+  // buffer to launch for LEDs [lo, hi); finish syncs the ping-pong partner
+  // and hands it to effects once the launch succeeded.
+  bool rmt_zero_copy_() const { return this->rmt_zc_other_ != nullptr; }
+  uint8_t *stage_rmt_zero_copy_(uint16_t &lo, uint16_t &hi);
+  bool stage_rmt_unity_sums_(uint16_t &lo, uint16_t &hi);
+  void finish_rmt_zero_copy_(uint8_t *launched, uint16_t lo, uint16_t hi);
+  bool wait_for_spi_tx_(uint32_t timeout_ms, const char *context) {
+    return this->drain_spi_tx_(0, timeout_ms, context);
+  }
+  // Collects completed SPI transactions, oldest first, until at most keep
+  // are still queued.
+  bool drain_spi_tx_(uint8_t keep, uint32_t timeout_ms, const char *context);
   uint32_t get_spi_frame_timeout_ms_() const;
   bool use_blocking_spi_diag_() const { return this->is_spi_transport(); }
   void reset_perf_diag_();
@@ -576,7 +780,68 @@ protected:
   void reset_rmt_encoder_diag_();
   void harvest_rmt_encoder_diag_();
   void log_segment_coordinator_diag_();
-  void apply_power_scale_to_buffer_(uint8_t *data, size_t len) const;
+  // Byte transfer table for the current power transmit scale, rebuilt only
+  // when the scale changes. nullptr means unity (plain copy).
+  const uint8_t *get_power_transfer_lut_();
+  // Transmit prep: writes LEDs [lo, hi) of buf_ into a wire buffer in final
+  // wire format, power scale applied through lut, adding every colour byte
+  // written to *sum. The kernel pair is picked once at setup from the
+  // transport; the scaled one runs while the power transmit scale is below
+  // unity. transmit_sum_ re-reads a range already on the wire so sums can
+  // be updated by delta.
+  using TransmitPrepFn = void (*)(uint8_t *wire, const uint8_t *src,
+                                  uint16_t lo, uint16_t hi, uint8_t stride,
+                                  const uint8_t *lut, uint32_t *sum);
+  using TransmitSumFn = uint32_t (*)(const uint8_t *wire, uint16_t lo,
+                                     uint16_t hi, uint8_t stride);
+  void select_transmit_prep_();
+  void prep_transmit_(uint8_t *wire, uint16_t lo, uint16_t hi,
+                      CFXPowerSums &sums);
+  uint32_t sum_wire_white_(const uint8_t *wire, uint16_t lo,
+                           uint16_t hi) const;
+  TransmitPrepFn transmit_prep_copy_{nullptr};
+  TransmitPrepFn transmit_prep_scaled_{nullptr};
+  TransmitSumFn transmit_sum_{nullptr};
+  // Sums of the last prepared frame, and of what each wire buffer holds.
+  CFXPowerSums power_sums_{};
+  CFXPowerSums rmt_buf_sums_{};
+  CFXPowerSums rmt_buf_back_sums_{};
+  CFXPowerSums spi_frame_sums_[2]{};
+  // LED span [lo, hi) the encoder must rewrite this transmit; the rest of
+  // the previous encode is reused. Consumes the dirty-range hint.
+  void take_encode_range_(uint16_t &lo, uint16_t &hi);
+  // Unscaled channel sums of buf_ as it stands (split per zone when zones
+  // are on).
+  CFXPowerSums sum_buffer_power_() const;
+  // Zone-aware forms of the transmit kernels: the same single pass over
+  // [lo, hi), cut at segment boundaries so each piece's bytes land in its
+  // zone as well as in the totals. A zone only partly inside the range has
+  // the rest of its span re-read from the wire buffer.
+  bool zones_active_() const {
+    return this->power_zones_enabled_ && !this->segment_defs_.empty();
+  }
+  void ensure_power_zones_() const;
+  template<typename RangeFn>
+  void for_each_zone_piece_(uint16_t lo, uint16_t hi, RangeFn &&fn) const;
+  void prep_zoned_(uint8_t *wire, uint16_t lo, uint16_t hi, uint8_t stride,
+                   const uint8_t *lut, TransmitPrepFn prep,
+                   CFXPowerSums &sums);
+  void sum_zoned_(const uint8_t *wire, uint16_t lo, uint16_t hi,
+                  uint8_t stride, CFXPowerSums &sums) const;
+  void store_zone_sums_(const uint8_t *wire, int z, uint16_t a, uint16_t b,
+                        uint8_t stride, uint32_t channels,
+                        uint32_t white) const;
+  // Frame limiter hook, fed the sums the transmit copy accumulated (wire
+  // bytes at sums.scale). Returns the transmit scale after the report.
+  uint8_t report_power_frame_(const CFXPowerSums &sums);
+  // Reports a frame staged into `wire` before it launches: a cut restages it
+  // whole at the new scale (true), a raise waits for the next frame.
+  bool limit_staged_frame_(uint8_t *wire, CFXPowerSums &sums);
+  // Parallel frames: the writers sum each lane's wire bytes as they
+  // transpose it, reset before the first chunk and reported once queued.
+  CFXPowerSums parallel_power_sums_{};
+  void begin_parallel_power_frame_();
+  void report_parallel_power_frame_();
   void fill_buffer_solid_(const Color &color);
   void scrub_inactive_segments_();
   uint8_t get_power_transmit_scale_() const;
@@ -585,6 +850,8 @@ protected:
   size_t get_spi_frame_size_() const;
   size_t get_spi_end_frame_size_() const;
   uint8_t get_spi_end_frame_byte_() const;
+  // Start frame, black LED frames and end frame; flushes only rewrite LEDs.
+  void init_spi_frame_(uint8_t *frame) const;
   static spi_host_device_t resolve_spi_host_(CFXSPIHost host);
 
   // Pixel data buffer (written by effects via ESPColorView)
@@ -600,13 +867,33 @@ protected:
 
   // Per-pixel effect data (used by AddressableLight)
   uint8_t *effect_data_{nullptr};
+  // TRANSITION_PLANE_COUNT planes of num_leds_ Colors, back to back.
+  Color *transition_planes_{nullptr};
 
-  // RMT transmission buffer
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+  // (v * scale + 127) / 255 for the scale in power_transfer_lut_scale_.
+  uint8_t power_transfer_lut_[256]{};
+  uint8_t power_transfer_lut_scale_{255};
+
+  // RMT transmission buffer: the staged byte frame. The encoder expands it
+  // to symbols from the TX interrupt (bytes encoder from ESP-IDF 5.3, the
+  // symbol-table encoder before that).
   uint8_t *rmt_buf_{nullptr};
-#else
-  rmt_symbol_word_t *rmt_buf_{nullptr};
-#endif
+  // Second transmit buffer, swapped with rmt_buf_ after each launch so the
+  // next frame encodes while this one is still on the wire. nullptr when it
+  // could not be allocated (single-buffered, waits as before).
+  uint8_t *rmt_buf_back_{nullptr};
+  // The range encoded by the previous flush and whether each buffer has had
+  // a full encode (bit 0 = rmt_buf_, bit 1 = rmt_buf_back_), for
+  // widen_for_back_buffer_().
+  uint16_t rmt_prev_lo_{0};
+  uint16_t rmt_prev_hi_{0};
+  uint8_t rmt_primed_mask_{0};
+  // zero_copy: buf_ points into rmt_buf_ past the sacrificial prefix, and
+  // rmt_zc_other_ is the ping-pong partner on the wire while effects render
+  // (no separate pixel buffer, no back buffer). The partner is synced while
+  // it holds the last committed frame; a scaled launch leaves it unsynced.
+  uint8_t *rmt_zc_other_{nullptr};
+  bool rmt_zc_other_synced_{false};
 
   // RMT hardware handles
   rmt_channel_handle_t channel_{nullptr};
@@ -618,6 +905,9 @@ protected:
   // volatile guarantees the compiler re-reads the flag on every poll iteration
   // rather than caching it in a register across the spin loop.
   volatile bool rmt_tx_in_flight_{false};
+  // Launched and not yet done; rmt_tx_in_flight_ == (rmt_tx_queued_ > 0).
+  // Updated under g_rmt_queue_mux by both the flush and the ISR.
+  volatile uint8_t rmt_tx_queued_{0};
   CFXRMTDoneContext rmt_done_ctx_{};
   bool rmt_flush_pending_{false};
 
@@ -630,6 +920,7 @@ protected:
   ChimeraChipset chipset_{CHIPSET_WS2812X};
   RGBOrder rgb_order_{ORDER_GRB};
   std::vector<CFXSegmentDef> segment_defs_;
+  const chimera_fx::CFXLayout *layout_{nullptr};
 
   light::LightState *master_light_state_{nullptr};
   std::vector<light::LightState *> segment_light_states_;
@@ -642,6 +933,9 @@ protected:
   bool is_rgbw_{false};
   bool is_wrgb_{false};
   bool sacrificial_pixel_{false};
+  bool zero_copy_{false};
+  // Placement policy and record of the large buffers this output owns.
+  CFXMemoryBudget memory_budget_;
   switch_::Switch *force_white_sw_{nullptr};
   switch_::Switch *force_white_cb_sw_{nullptr};
   uint32_t rmt_symbols_{0}; // 0 = auto-detect from chip variant
@@ -667,8 +961,24 @@ protected:
   uint32_t spi_speed_hz_{10000000};  // 10 MHz default
   CFXSPIHost spi_host_{SPI_HOST_2};
   spi_device_handle_t spi_device_{nullptr};
-  uint8_t *spi_frame_buf_{nullptr};
-  spi_transaction_t spi_trans_{};
+  // Two DMA frame buffers filled alternately (the second is optional), so
+  // a frame packs while the previous one is still on the wire. Each frame
+  // goes out as spi_chunk_count_ queued transactions: the first chunk is on
+  // the wire while the rest are packed (APA102 latches on clock edges, so
+  // the gaps between transactions are harmless).
+  static constexpr uint8_t SPI_MAX_CHUNKS = 8;
+  static constexpr uint16_t SPI_MIN_CHUNK_LEDS = 256;
+  uint8_t *spi_frame_bufs_[2]{};
+  spi_transaction_t spi_trans_[2][SPI_MAX_CHUNKS]{};
+  uint8_t spi_buf_index_{0};
+  uint8_t spi_chunk_count_{1};
+  uint16_t spi_chunk_leds_{0};
+  uint8_t spi_trans_pending_{0};
+  uint8_t spi_last_frame_chunks_{0};
+  // Same bookkeeping as rmt_prev_lo_/rmt_primed_mask_ for the SPI pair.
+  uint16_t spi_prev_lo_{0};
+  uint16_t spi_prev_hi_{0};
+  uint8_t spi_primed_mask_{0};
   bool spi_tx_in_flight_{false};
   uint32_t spi_wait_count_{0};
   uint32_t spi_wait_timeout_count_{0};
@@ -682,6 +992,12 @@ protected:
   uint32_t spi_last_flush_ms_{0};
 
   CFXPowerManager *power_manager_{nullptr};
+  bool power_zones_enabled_{false};
+  // Frame-pass outputs; get_power_sums() fills them for the parallel lanes.
+  mutable std::vector<CFXZonePowerSums> zone_power_sums_{};
+  // segment_defs_ indices by start LED, for the zone piece walk.
+  mutable std::vector<uint8_t> power_zone_order_{};
+  std::vector<uint8_t> power_zone_effects_{};
 #ifdef USE_POWER_SUPPLY
   power_supply::PowerSupplyRequester power_supply_requester_{};
   bool has_power_supply_{false};
@@ -693,15 +1009,66 @@ protected:
   uint32_t last_refresh_{0};
   optional<uint32_t> max_refresh_rate_{};
 
-  // Visualizer
-  int socket_fd_{-1};
+  // Frame dedup: hash of the last frame that actually went out (buf_ plus
+  // the power transmit scale), so unchanged frames skip copy and DMA.
+  uint32_t hash_frame_() const;
+  uint32_t keepalive_interval_ms_{1000};
+  uint32_t sent_frame_hash_{0};
+  uint32_t sent_frame_ms_{0};
+  bool sent_frame_valid_{false};
+  // Carried from stage_transmit_() to finish_transmit_().
+  uint32_t staged_frame_hash_{0};
+  bool staged_dedup_{false};
+  // Staged by stage_rmt_frame_() for launch_rmt_frame_().
+  uint8_t *rmt_staged_buf_{nullptr};
+  uint16_t rmt_staged_lo_{0};
+  uint16_t rmt_staged_hi_{0};
+  uint32_t rmt_staged_start_us_{0};
+
+  // Dirty-range hint since the last encode. UNKNOWN (no report yet) and
+  // FULL both re-encode everything; the encoded_* fields say whether the
+  // SPI/RMT buffers still hold a reusable previous frame.
+  enum DirtyState : uint8_t { DIRTY_UNKNOWN, DIRTY_RANGE, DIRTY_FULL };
+  DirtyState dirty_state_{DIRTY_UNKNOWN};
+  uint16_t dirty_lo_{0};
+  uint16_t dirty_hi_{0};
+  uint8_t dirty_brightness_{0};
+  bool encoded_valid_{false};
+  uint8_t encoded_power_scale_{255};
+
+  // Visualizer (streamed by CFXVisualizerStream)
 #ifdef CFX_VISUALIZER_ENABLED
   std::string visualizer_ip_{""};
   uint16_t visualizer_port_{7777};
+  uint32_t visualizer_interval_ms_{50};
   bool visualizer_enabled_{false};
-  std::vector<uint8_t> visualizer_pkt_;
+  int visualizer_slot_{-1};
 #endif  // CFX_VISUALIZER_ENABLED
 
+#ifdef CFX_REALTIME_ENABLED
+  // Realtime ingest
+  bool realtime_enabled_{false};
+  bool realtime_live_{false};
+  // Pixels of a frame are in buf_ but its push/sync/last universe has not
+  // arrived yet: hold every transmit so no half-written frame goes out.
+  bool realtime_frame_open_{false};
+  uint8_t realtime_protocol_{0};
+  int8_t realtime_segment_index_{-1};
+  uint16_t realtime_port_{0};
+  uint16_t realtime_start_{0};
+  uint16_t realtime_count_{0};
+  uint32_t realtime_address_{0};
+  uint32_t realtime_timeout_ms_{0};
+  // Read time of the newest committed frame's first packet, until the
+  // transmit carrying it launches; 0 when none is outstanding.
+  uint32_t realtime_rx_us_{0};
+  // Whether the live stream owns segment `index` (or the whole strip).
+  bool realtime_owns_segment_(int index) const {
+    return this->realtime_live_ && (this->realtime_segment_index_ < 0 ||
+                                    this->realtime_segment_index_ == index);
+  }
+#endif
+
   // State synchronization listeners
   class MasterListener : public light::LightRemoteValuesListener {
   public:
@@ -774,6 +1141,8 @@ protected:
   uint64_t perf_diag_total_gate_defers_{0};
   uint64_t perf_diag_total_refresh_defers_{0};
   uint64_t perf_diag_total_partial_flushes_{0};
+  uint64_t perf_diag_total_dedup_skips_{0};
+  uint64_t perf_diag_total_encoded_leds_{0};
   uint64_t perf_diag_total_rmt_starve_count_{0};
   uint64_t perf_diag_total_rmt_reset_starve_count_{0};
   uint64_t perf_diag_total_rmt_callback_count_{0};
@@ -796,9 +1165,9 @@ protected:
   uint32_t perf_diag_last_rmt_tx_launch_us_{0};
   uint32_t perf_diag_last_effective_rmt_update_ms_{0};
   uint32_t perf_diag_spi_loop_log_ms_{0};
-  uint8_t seg_flush_pending_mask_{0};
-  uint8_t seg_flush_dirty_mask_{0};
-  uint8_t seg_last_flush_mask_{0};
+  CFXSegmentMask seg_flush_pending_mask_{0};
+  CFXSegmentMask seg_flush_dirty_mask_{0};
+  CFXSegmentMask seg_last_flush_mask_{0};
   uint8_t seg_last_flush_count_{0};
   uint32_t seg_partial_frame_suppressed_{0};
   uint32_t seg_missed_epoch_count_{0};
@@ -823,23 +1192,22 @@ protected:
   uint32_t seg_coord_max_refresh_dt_us_{0};
   uint64_t seg_coord_total_refresh_dt_us_{0};
   bool seg_deferred_flush_pending_{false};
-  uint8_t seg_deferred_flush_mask_{0};
+  CFXSegmentMask seg_deferred_flush_mask_{0};
   uint8_t seg_deferred_flush_count_{0};
   uint32_t seg_deferred_flushes_{0};
   uint32_t seg_deferred_flush_skips_{0};
   uint16_t seg_generation_counter_{0};
-  uint16_t seg_request_generation_[MAX_CFX_SEGMENTS]{};
-  uint16_t seg_flushed_generation_[MAX_CFX_SEGMENTS]{};
-  CFXSegmentRuntimeSlot segment_runtime_slots_[MAX_CFX_SEGMENTS]{};
-  uint8_t segment_coord_owned_mask_{0};
-  uint8_t segment_coord_dormant_mask_{0};
-  uint8_t segment_mono_idle_dormant_mask_{0};
+  // One slot per segment light state, in segment order.
+  std::vector<CFXSegmentRuntimeSlot> segment_runtime_slots_{};
+  CFXSegmentMask segment_slot_active_mask_{0}; // slots registered by an effect
+  CFXSegmentMask segment_coord_owned_mask_{0};
+  CFXSegmentMask segment_coord_dormant_mask_{0};
+  CFXSegmentMask segment_mono_idle_dormant_mask_{0};
   uint64_t segment_coord_next_due_ms_{0};
   bool segment_coord_schedule_dirty_{true};
   bool master_mono_idle_dormant_{false};
   bool master_segment_coord_dormant_{false};
   uint32_t master_mono_idle_sleep_ms_{0};
-  uint32_t segment_mono_idle_sleep_ms_[MAX_CFX_SEGMENTS]{};
   uint32_t mono_idle_sleep_count_{0};
   uint32_t mono_idle_wake_count_{0};
   uint32_t segment_coord_owned_mask_ms_{0};
@@ -0,0 +1,162 @@
+#include "cfx_memory_budget.h"
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_ESP32
+
+#include "esphome/core/log.h"
+
+#include <esp_heap_caps.h>
+#include <esp_memory_utils.h>
+#include <stdlib.h>
+
+namespace esphome {
+namespace cfx_light {
+
+static const char *const CLASS_LABELS[CFX_MEM_CLASS_COUNT] = {
+    "dma", "isr", "hot", "cold",
+};
+
+static constexpr uint32_t CAPS_INTERNAL = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+static constexpr uint32_t CAPS_PSRAM = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+
+void CFXMemoryBudget::set_placement(CFXMemClass cls,
+                                    CFXMemPlacement placement) {
+  if (cls == CFX_MEM_HOT || cls == CFX_MEM_COLD) {
+    this->placement_[cls] = placement;
+  }
+}
+
+CFXMemPlacement CFXMemoryBudget::get_placement(CFXMemClass cls) const {
+  return cls < CFX_MEM_CLASS_COUNT ? this->placement_[cls] : CFX_MEM_AUTO;
+}
+
+uint8_t *CFXMemoryBudget::allocate(CFXMemClass cls, size_t bytes,
+                                   const char *what) {
+  if (bytes == 0) {
+    return nullptr;
+  }
+  void *ptr = nullptr;
+  switch (cls) {
+  case CFX_MEM_DMA:
+    ptr = heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    break;
+  case CFX_MEM_ISR:
+    ptr = heap_caps_malloc(bytes, CAPS_INTERNAL);
+    break;
+  case CFX_MEM_HOT:
+  case CFX_MEM_COLD: {
+    const CFXMemPlacement placement = this->placement_[cls];
+    const bool psram_first =
+        placement == CFX_MEM_PSRAM ||
+        (placement == CFX_MEM_AUTO && cls == CFX_MEM_COLD);
+    // Falling back from PSRAM is always allowed (the board may have none);
+    // falling back to it only under AUTO.
+    const bool may_fall_back = psram_first || placement == CFX_MEM_AUTO;
+    ptr = heap_caps_malloc(bytes, psram_first ? CAPS_PSRAM : CAPS_INTERNAL);
+    if (ptr == nullptr && may_fall_back) {
+      ptr = heap_caps_malloc(bytes, psram_first ? CAPS_INTERNAL : CAPS_PSRAM);
+    }
+    break;
+  }
+  default:
+    break;
+  }
+  if (ptr != nullptr) {
+    this->record_(cls, ptr, bytes, what);
+  }
+  return static_cast<uint8_t *>(ptr);
+}
+
+void CFXMemoryBudget::note(CFXMemClass cls, const void *ptr, size_t bytes,
+                           const char *what) {
+  if (ptr != nullptr && bytes > 0) {
+    this->record_(cls, ptr, bytes, what);
+  }
+}
+
+void CFXMemoryBudget::release(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  for (uint8_t i = 0; i < this->count_; i++) {
+    if (this->entries_[i].ptr == ptr) {
+      this->entries_[i] = this->entries_[--this->count_];
+      this->entries_[this->count_] = Entry{};
+      break;
+    }
+  }
+  heap_caps_free(ptr);
+}
+
+void CFXMemoryBudget::record_(CFXMemClass cls, const void *ptr, size_t bytes,
+                              const char *what) {
+  if (this->count_ >= MAX_ENTRIES) {
+    return;
+  }
+  Entry &entry = this->entries_[this->count_++];
+  entry.what = what;
+  entry.ptr = ptr;
+  entry.bytes = static_cast<uint32_t>(bytes);
+  entry.cls = cls;
+  entry.psram = esp_ptr_external_ram(ptr);
+}
+
+size_t CFXMemoryBudget::internal_bytes() const {
+  size_t total = 0;
+  for (uint8_t i = 0; i < this->count_; i++) {
+    if (!this->entries_[i].psram) {
+      total += this->entries_[i].bytes;
+    }
+  }
+  return total;
+}
+
+size_t CFXMemoryBudget::psram_bytes() const {
+  size_t total = 0;
+  for (uint8_t i = 0; i < this->count_; i++) {
+    if (this->entries_[i].psram) {
+      total += this->entries_[i].bytes;
+    }
+  }
+  return total;
+}
+
+size_t CFXMemoryBudget::class_bytes(CFXMemClass cls) const {
+  size_t total = 0;
+  for (uint8_t i = 0; i < this->count_; i++) {
+    if (this->entries_[i].cls == cls) {
+      total += this->entries_[i].bytes;
+    }
+  }
+  return total;
+}
+
+void CFXMemoryBudget::log_summary(const char *tag, uint8_t pin) const {
+  ESP_LOGI(tag,
+           "Memory budget pin=%u: internal=%u B psram=%u B in %u buffers "
+           "(internal free=%u B largest=%u B)",
+           pin, static_cast<unsigned>(this->internal_bytes()),
+           static_cast<unsigned>(this->psram_bytes()),
+           static_cast<unsigned>(this->count_),
+           static_cast<unsigned>(heap_caps_get_free_size(CAPS_INTERNAL)),
+           static_cast<unsigned>(heap_caps_get_largest_free_block(CAPS_INTERNAL)));
+}
+
+void CFXMemoryBudget::log_config(const char *tag) const {
+  ESP_LOGCONFIG(tag, "  Memory: internal=%u B psram=%u B",
+                static_cast<unsigned>(this->internal_bytes()),
+                static_cast<unsigned>(this->psram_bytes()));
+  for (uint8_t i = 0; i < this->count_; i++) {
+    const Entry &entry = this->entries_[i];
+    ESP_LOGCONFIG(tag, "    %s: %u B %s (%s)",
+                  entry.what != nullptr ? entry.what : "?",
+                  static_cast<unsigned>(entry.bytes),
+                  entry.psram ? "psram" : "internal", CLASS_LABELS[entry.cls]);
+  }
+}
+
+}  // namespace cfx_light
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,82 @@
+#pragma once
+// CFXMemoryBudget — placement policy and boot report for an output's buffers.
+//
+// Every large buffer an output owns belongs to one class:
+//
+//   DMA   read by a DMA engine (SPI frames, parallel rolling buffers): always
+//         internal, DMA-capable RAM.
+//   ISR   read by the RMT encoder from interrupt context (rmt_buf_ and the
+//         zero-copy partner): always internal RAM.
+//   HOT   touched per pixel every frame (buf_, effect data): internal by
+//         default, since PSRAM reads cost several times more per pixel.
+//   COLD  off the render path (transition planes, visualizer snapshots):
+//         PSRAM by default, keeping internal RAM for Wi-Fi and the above.
+//
+// HOT and COLD follow `memory_placement:` in YAML. AUTO prefers the class
+// default and falls back to the other memory; INTERNAL and PSRAM prefer
+// that memory and fall back only from PSRAM (boards without it keep working).
+// Each allocation is recorded with where it landed, so setup() can log what
+// the output costs in internal RAM and PSRAM.
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esphome {
+namespace cfx_light {
+
+enum CFXMemClass : uint8_t {
+  CFX_MEM_DMA = 0,
+  CFX_MEM_ISR,
+  CFX_MEM_HOT,
+  CFX_MEM_COLD,
+  CFX_MEM_CLASS_COUNT,
+};
+
+enum CFXMemPlacement : uint8_t {
+  CFX_MEM_AUTO = 0,
+  CFX_MEM_INTERNAL,
+  CFX_MEM_PSRAM,
+};
+
+class CFXMemoryBudget {
+ public:
+  static constexpr uint8_t MAX_ENTRIES = 12;
+
+  // Only HOT and COLD are configurable; DMA and ISR ignore this.
+  void set_placement(CFXMemClass cls, CFXMemPlacement placement);
+  CFXMemPlacement get_placement(CFXMemClass cls) const;
+
+  // Allocates `bytes` under the class policy and records it as `what`
+  // (a literal). nullptr when no permitted memory has room.
+  uint8_t *allocate(CFXMemClass cls, size_t bytes, const char *what);
+  // Records a buffer allocated elsewhere (e.g. shared parallel DMA buffers).
+  void note(CFXMemClass cls, const void *ptr, size_t bytes, const char *what);
+  // Frees a buffer from allocate() and drops its record.
+  void release(void *ptr);
+
+  size_t internal_bytes() const;
+  size_t psram_bytes() const;
+  size_t class_bytes(CFXMemClass cls) const;
+  // One summary line at INFO, one line per buffer at CONFIG.
+  void log_summary(const char *tag, uint8_t pin) const;
+  void log_config(const char *tag) const;
+
+ protected:
+  struct Entry {
+    const char *what{nullptr};
+    const void *ptr{nullptr};
+    uint32_t bytes{0};
+    uint8_t cls{CFX_MEM_DMA};
+    bool psram{false};
+  };
+
+  void record_(CFXMemClass cls, const void *ptr, size_t bytes,
+               const char *what);
+
+  CFXMemPlacement placement_[CFX_MEM_CLASS_COUNT]{};
+  Entry entries_[MAX_ENTRIES]{};
+  uint8_t count_{0};
+};
+
+}  // namespace cfx_light
+}  // namespace esphome
@@ -13,6 +13,10 @@ namespace cfx_light {
 
 static const char *const TAG_POWER = "cfx_power";
 static constexpr uint32_t ENERGY_SAVE_INTERVAL_MS = 3600000u;
+// The limit scale drops as far as a frame needs at once, but only climbs
+// back in steps of at least this much (or straight to unity), so a frame
+// hovering at the budget does not force a full re-encode every transmit.
+static constexpr uint8_t FRAME_LIMIT_RELEASE_STEP = 8;
 
 CFXPowerManager *CFXPowerManager::active_{nullptr};
 
@@ -38,16 +42,92 @@ void CFXPowerManager::setup() {
           static_cast<float>(this->target_reduction_percent_);
     }
   }
-  if (this->energy_sensor_ != nullptr && global_preferences != nullptr) {
-    this->energy_pref_ = global_preferences->make_preference<float>(
-        fnv1a_hash("cfx_estimated_energy_kwh"), true);
+  for (auto &entry : this->outputs_) {
+    entry.accounted = !this->effect_accounts_.empty();
+    for (const auto &account : this->zone_accounts_) {
+      entry.accounted |= account.output == entry.output;
+    }
+    if (entry.accounted && entry.output != nullptr) {
+      entry.output->enable_power_zones();
+    }
+  }
+  for (auto &account : this->effect_accounts_) {
+    account.shares.assign(this->outputs_.size(), EffectShare{});
+  }
+
+  bool energy_tracked = this->energy_sensor_ != nullptr;
+  for (const auto &account : this->zone_accounts_) {
+    energy_tracked |= account.energy_sensor != nullptr;
+  }
+  for (const auto &account : this->effect_accounts_) {
+    energy_tracked |= account.energy_sensor != nullptr;
+  }
+  if (energy_tracked && global_preferences != nullptr) {
+    this->energy_pref_ = global_preferences->make_preference<CFXEnergyRecord>(
+        fnv1a_hash("cfx_energy_ledger"), true);
     this->energy_pref_ready_ = true;
-    this->energy_pref_.load(&this->energy_kwh_);
-    this->energy_sensor_->publish_state(this->energy_kwh_);
+    this->restore_energy_();
   }
   this->publish_reduction_state_();
 }
 
+void CFXPowerManager::restore_energy_() {
+  CFXEnergyRecord record{};
+  if (this->energy_pref_.load(&record)) {
+    this->energy_record_ = record;
+  } else {
+    // Older firmware kept the node total alone, as a float.
+    float legacy_kwh = 0.0f;
+    auto legacy = global_preferences->make_preference<float>(
+        fnv1a_hash("cfx_estimated_energy_kwh"), true);
+    if (legacy.load(&legacy_kwh) && std::isfinite(legacy_kwh)) {
+      this->energy_record_.node_kwh = legacy_kwh;
+    }
+  }
+  if (this->energy_record_.history_head >= ENERGY_HISTORY_SLOTS ||
+      this->energy_record_.history_count > ENERGY_HISTORY_SLOTS) {
+    this->energy_record_.history_head = 0;
+    this->energy_record_.history_count = 0;
+  }
+  if (this->energy_sensor_ != nullptr) {
+    this->energy_sensor_->publish_state(this->energy_record_.node_kwh);
+  }
+  for (const auto &account : this->zone_accounts_) {
+    if (account.energy_sensor != nullptr && account.energy_slot >= 0) {
+      account.energy_sensor->publish_state(
+          this->energy_record_.zone_kwh[account.energy_slot]);
+    }
+  }
+  for (const auto &account : this->effect_accounts_) {
+    if (account.energy_sensor != nullptr && account.energy_slot >= 0) {
+      account.energy_sensor->publish_state(
+          this->energy_record_.effect_kwh[account.energy_slot]);
+    }
+  }
+}
+
+void CFXPowerManager::save_energy_() {
+  if (this->energy_pref_ready_) {
+    this->energy_pref_.save(&this->energy_record_);
+  }
+}
+
+// Saves happen once per ENERGY_SAVE_INTERVAL_MS, so each closed bucket is
+// one save interval of use.
+void CFXPowerManager::close_energy_bucket_() {
+  CFXEnergyRecord &record = this->energy_record_;
+  const uint8_t slot = static_cast<uint8_t>(
+      (record.history_head + record.history_count) % ENERGY_HISTORY_SLOTS);
+  record.history[slot] = record.open_bucket;
+  if (record.history_count < ENERGY_HISTORY_SLOTS) {
+    record.history_count++;
+  } else {
+    record.history_head =
+        static_cast<uint8_t>((record.history_head + 1) % ENERGY_HISTORY_SLOTS);
+  }
+  record.open_bucket = CFXEnergyBucket{};
+}
+
 void CFXPowerManager::loop() {
   const uint32_t now = millis();
 
@@ -140,6 +220,16 @@ void CFXPowerManager::configure_auto_reduction(uint32_t safe_hold_ms) {
   }
 }
 
+void CFXPowerManager::configure_frame_limiter(float max_load) {
+  this->frame_limiter_enabled_ = true;
+  this->frame_limit_max_load_ =
+      max_load > 0.0f ? std::min(max_load, 1.0f) : 1.0f;
+  if (this->psu_current_limit_ma_ <= 0.0f) {
+    ESP_LOGW(TAG_POWER,
+             "Frame limiter needs psu_current_limit; it stays inactive.");
+  }
+}
+
 void CFXPowerManager::set_node_sensors(sensor::Sensor *dc_current,
                                        sensor::Sensor *dc_power,
                                        sensor::Sensor *ac_power,
@@ -158,6 +248,60 @@ void CFXPowerManager::set_node_sensors(sensor::Sensor *dc_current,
   this->budget_status_sensor_ = budget_status;
 }
 
+void CFXPowerManager::add_zone_sensors(CFXLightOutput *output, uint8_t zone,
+                                       sensor::Sensor *current,
+                                       sensor::Sensor *energy) {
+  if (output == nullptr || (current == nullptr && energy == nullptr)) {
+    return;
+  }
+  ZoneAccount account;
+  account.output = output;
+  account.zone = zone;
+  account.current_sensor = current;
+  account.energy_sensor = energy;
+  if (energy != nullptr) {
+    int8_t used = 0;
+    for (const auto &other : this->zone_accounts_) {
+      used += other.energy_slot >= 0 ? 1 : 0;
+    }
+    if (used < ENERGY_ZONE_SLOTS) {
+      account.energy_slot = used;
+    } else {
+      ESP_LOGW(TAG_POWER,
+               "Only %u segment energy sensors are persisted; the rest "
+               "restart from 0 on reboot",
+               static_cast<unsigned>(ENERGY_ZONE_SLOTS));
+    }
+  }
+  this->zone_accounts_.push_back(account);
+}
+
+void CFXPowerManager::add_effect_sensors(uint8_t mode, sensor::Sensor *current,
+                                         sensor::Sensor *energy) {
+  if (current == nullptr && energy == nullptr) {
+    return;
+  }
+  EffectAccount account;
+  account.mode = mode;
+  account.current_sensor = current;
+  account.energy_sensor = energy;
+  if (energy != nullptr) {
+    int8_t used = 0;
+    for (const auto &other : this->effect_accounts_) {
+      used += other.energy_slot >= 0 ? 1 : 0;
+    }
+    if (used < ENERGY_EFFECT_SLOTS) {
+      account.energy_slot = used;
+    } else {
+      ESP_LOGW(TAG_POWER,
+               "Only %u effect energy sensors are persisted; the rest "
+               "restart from 0 on reboot",
+               static_cast<unsigned>(ENERGY_EFFECT_SLOTS));
+    }
+  }
+  this->effect_accounts_.push_back(account);
+}
+
 void CFXPowerManager::set_reduction_select(CFXPowerReductionSelect *select) {
   this->reduction_select_ = select;
   if (select != nullptr) {
@@ -183,25 +327,145 @@ void CFXPowerManager::record_output_frame(CFXLightOutput *output) {
     return;
   }
 
-  const float dynamic_scale =
-      static_cast<float>(this->get_transmit_scale()) / 255.0f;
-  for (auto &entry : this->outputs_) {
+  for (size_t i = 0; i < this->outputs_.size(); i++) {
+    OutputEntry &entry = this->outputs_[i];
     if (entry.output != output) {
       continue;
     }
-    const float current_ma =
-        output->estimate_power_current_ma(entry.model, dynamic_scale);
-    entry.estimated_dc_current_ma = current_ma;
-    entry.accumulated_dc_current_ma += current_ma;
+    // Sums already carry the transmit scale; mA is worked out in sample_().
+    const CFXPowerSums sums = output->get_power_sums();
+    entry.accumulated_channels += sums.channels;
+    entry.accumulated_white += sums.white;
     entry.accumulated_frames++;
+    if (entry.accounted) {
+      this->record_zones_(i, entry, sums);
+    }
+    return;
+  }
+}
+
+// Same integer sums as the totals, taken per segment by the pass that
+// produced them. An unsegmented output is one zone worth its totals.
+void CFXPowerManager::record_zones_(size_t index, OutputEntry &entry,
+                                    const CFXPowerSums &sums) {
+  CFXLightOutput *output = entry.output;
+  const auto &defs = output->get_segment_defs();
+  if (defs.empty()) {
+    if (!this->effect_accounts_.empty()) {
+      this->record_effect_(index, output->get_power_effect(0), sums.channels,
+                           sums.white, static_cast<uint16_t>(output->size()));
+    }
+    return;
+  }
+  const auto &zones = output->get_zone_power_sums();
+  if (zones.size() != defs.size()) {
+    return;
+  }
+  if (entry.zone_accumulated.size() != zones.size()) {
+    entry.zone_accumulated.assign(zones.size(), AccumulatedSums{});
+  }
+  for (size_t z = 0; z < zones.size(); z++) {
+    entry.zone_accumulated[z].channels += zones[z].channels;
+    entry.zone_accumulated[z].white += zones[z].white;
+    if (!this->effect_accounts_.empty()) {
+      const uint16_t stop = std::min<uint16_t>(
+          defs[z].stop, static_cast<uint16_t>(output->size()));
+      const uint16_t leds = stop > defs[z].start ? stop - defs[z].start : 0;
+      this->record_effect_(index, output->get_power_effect(z),
+                           zones[z].channels, zones[z].white, leds);
+    }
+  }
+}
+
+void CFXPowerManager::record_effect_(size_t index, uint8_t mode,
+                                     uint32_t channels, uint32_t white,
+                                     uint16_t leds) {
+  if (mode == CFXLightOutput::POWER_NO_EFFECT) {
+    return;
+  }
+  for (auto &account : this->effect_accounts_) {
+    if (account.mode != mode || index >= account.shares.size()) {
+      continue;
+    }
+    EffectShare &share = account.shares[index];
+    share.channels += channels;
+    share.white += white;
+    share.led_frames += leds;
+  }
+}
+
+void CFXPowerManager::predict_output_frame(CFXLightOutput *output,
+                                           uint32_t channels,
+                                           uint32_t white) {
+  if (!this->frame_limiter_active() || output == nullptr) {
+    return;
+  }
+
+  OutputEntry *reporting = nullptr;
+  float fixed_ma = this->controller_current_ma_;
+  float dynamic_ma = 0.0f;
+  for (auto &entry : this->outputs_) {
+    if (entry.output == nullptr) {
+      continue;
+    }
+    if (entry.output == output) {
+      reporting = &entry;
+      entry.predicted_dynamic_ma =
+          (entry.model.rgb_channel_ma * static_cast<float>(channels - white) +
+           entry.model.white_channel_ma * static_cast<float>(white)) /
+          255.0f;
+    }
+    fixed_ma += entry.model.idle_ma * static_cast<float>(entry.output->size());
+    dynamic_ma += entry.predicted_dynamic_ma;
+  }
+  if (reporting == nullptr) {
     return;
   }
+
+  // The reduction scale is applied first; the limiter only trims what is
+  // still over budget after it.
+  const float budget_ma =
+      this->psu_current_limit_ma_ * this->frame_limit_max_load_ - fixed_ma;
+  const float demand_ma = dynamic_ma * this->reduction_transmit_scale_();
+  uint8_t scale = 255;
+  if (demand_ma > budget_ma) {
+    scale = budget_ma > 0.0f
+                ? static_cast<uint8_t>(std::min(
+                      254.0f, std::floor(255.0f * budget_ma / demand_ma)))
+                : 0;
+  }
+  const bool held = scale > this->frame_limit_scale_ && scale < 255 &&
+                    scale - this->frame_limit_scale_ < FRAME_LIMIT_RELEASE_STEP;
+  if (!held) {
+    this->frame_limit_scale_ = scale;
+  }
+  reporting->predicted_limit_scale = this->frame_limit_scale_;
+
+  // Outputs that are not redrawing still show their last frame at the scale
+  // it went out at; a clearly higher one has to be sent again.
+  for (auto &entry : this->outputs_) {
+    if (entry.output != nullptr && &entry != reporting &&
+        entry.predicted_limit_scale >=
+            this->frame_limit_scale_ + FRAME_LIMIT_RELEASE_STEP) {
+      entry.predicted_limit_scale = this->frame_limit_scale_;
+      entry.output->request_power_reduction_refresh();
+    }
+  }
 }
 
 uint8_t CFXPowerManager::get_transmit_scale() const {
-  if (!this->reduction_enabled_ || this->current_reduction_percent_ <= 0.0f) {
+  const float scale = this->reduction_transmit_scale_() *
+                      static_cast<float>(this->frame_limit_scale_) / 255.0f;
+  if (scale >= 1.0f) {
     return 255;
   }
+  return static_cast<uint8_t>(std::round(scale * 255.0f));
+}
+
+float CFXPowerManager::reduction_transmit_scale_() const {
+  if (!this->reduction_enabled_ || this->current_reduction_percent_ <= 0.0f) {
+    return 1.0f;
+  }
   float scale = 1.0f - (this->current_reduction_percent_ / 100.0f);
   if (scale < 0.0f) {
     scale = 0.0f;
@@ -209,7 +473,7 @@ uint8_t CFXPowerManager::get_transmit_scale() const {
   if (scale > 1.0f) {
     scale = 1.0f;
   }
-  return static_cast<uint8_t>(std::round(scale * 255.0f));
+  return scale;
 }
 
 void CFXPowerManager::set_target_reduction_percent(float value, bool persist) {
@@ -248,6 +512,9 @@ void CFXPowerManager::set_target_reduction_percent(float value, bool persist) {
 }
 
 void CFXPowerManager::sample_() {
+  // Accounts read the frame counts the loop below resets.
+  this->measure_accounts_();
+
   const float dynamic_scale =
       static_cast<float>(this->get_transmit_scale()) / 255.0f;
   float total_demand_ma = this->controller_current_ma_;
@@ -257,14 +524,22 @@ void CFXPowerManager::sample_() {
       continue;
     }
     if (entry.accumulated_frames > 0) {
+      const float frames = static_cast<float>(entry.accumulated_frames);
+      const float white = static_cast<float>(entry.accumulated_white) / frames;
+      const float rgb =
+          static_cast<float>(entry.accumulated_channels - entry.accumulated_white) /
+          frames;
       entry.estimated_dc_current_ma =
-          entry.accumulated_dc_current_ma /
-          static_cast<float>(entry.accumulated_frames);
+          entry.model.idle_ma * static_cast<float>(entry.output->size()) +
+          (entry.model.rgb_channel_ma * rgb +
+           entry.model.white_channel_ma * white) /
+              255.0f;
     } else {
       entry.estimated_dc_current_ma =
           entry.output->estimate_power_current_ma(entry.model, dynamic_scale);
     }
-    entry.accumulated_dc_current_ma = 0.0f;
+    entry.accumulated_channels = 0;
+    entry.accumulated_white = 0;
     entry.accumulated_frames = 0;
     total_demand_ma += entry.estimated_dc_current_ma;
   }
@@ -301,20 +576,25 @@ void CFXPowerManager::sample_() {
   if (this->ac_current_sensor_ != nullptr) {
     this->ac_current_sensor_->publish_state(ac_current_a);
   }
-  if (this->energy_sensor_ != nullptr) {
+  if (this->energy_sensor_ != nullptr || this->energy_pref_ready_) {
     if (this->last_energy_sample_ms_ == 0) {
       this->last_energy_sample_ms_ = now_ms;
     } else {
       const uint32_t dt_ms = now_ms - this->last_energy_sample_ms_;
       this->last_energy_sample_ms_ = now_ms;
-      this->energy_kwh_ +=
-          ac_power_w * static_cast<float>(dt_ms) / 3600000000.0f;
+      const float kwh = ac_power_w * static_cast<float>(dt_ms) / 3600000000.0f;
+      this->energy_record_.node_kwh += kwh;
+      this->energy_record_.open_bucket.node_kwh += kwh;
+      this->integrate_accounts_(dt_ms);
+    }
+    if (this->energy_sensor_ != nullptr) {
+      this->energy_sensor_->publish_state(this->energy_record_.node_kwh);
     }
-    this->energy_sensor_->publish_state(this->energy_kwh_);
     if (this->energy_pref_ready_ &&
         (this->last_energy_save_ms_ != 0 &&
          (now_ms - this->last_energy_save_ms_) >= ENERGY_SAVE_INTERVAL_MS)) {
-      this->energy_pref_.save(&this->energy_kwh_);
+      this->close_energy_bucket_();
+      this->save_energy_();
       this->last_energy_save_ms_ = now_ms;
     } else if (this->last_energy_save_ms_ == 0) {
       this->last_energy_save_ms_ = now_ms;
@@ -346,6 +626,115 @@ void CFXPowerManager::sample_() {
   }
 }
 
+float CFXPowerManager::model_current_ma_(const CFXPowerModel &model,
+                                         uint64_t channels, uint64_t white,
+                                         uint64_t led_frames, float frames) {
+  if (frames <= 0.0f) {
+    return 0.0f;
+  }
+  return (model.idle_ma * static_cast<float>(led_frames) +
+          (model.rgb_channel_ma * static_cast<float>(channels - white) +
+           model.white_channel_ma * static_cast<float>(white)) /
+              255.0f) /
+         frames;
+}
+
+// Averages each account over the frames its outputs sent since the last
+// sample, like the node estimate. An output that sent none counts its
+// current frame once.
+void CFXPowerManager::measure_accounts_() {
+  if (this->zone_accounts_.empty() && this->effect_accounts_.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < this->outputs_.size(); i++) {
+    OutputEntry &entry = this->outputs_[i];
+    if (entry.accounted && entry.output != nullptr &&
+        entry.accumulated_frames == 0) {
+      this->record_zones_(i, entry, entry.output->get_power_sums());
+    }
+  }
+
+  for (auto &account : this->zone_accounts_) {
+    account.current_ma = 0.0f;
+    for (auto &entry : this->outputs_) {
+      if (entry.output != account.output ||
+          account.zone >= entry.zone_accumulated.size()) {
+        continue;
+      }
+      const auto &def = entry.output->get_segment_defs()[account.zone];
+      const uint16_t stop = std::min<uint16_t>(
+          def.stop, static_cast<uint16_t>(entry.output->size()));
+      const uint16_t leds = stop > def.start ? stop - def.start : 0;
+      const float frames =
+          static_cast<float>(std::max<uint32_t>(entry.accumulated_frames, 1));
+      const AccumulatedSums &sums = entry.zone_accumulated[account.zone];
+      account.current_ma = model_current_ma_(
+          entry.model, sums.channels, sums.white,
+          static_cast<uint64_t>(leds) * static_cast<uint64_t>(frames), frames);
+      break;
+    }
+    if (account.current_sensor != nullptr) {
+      account.current_sensor->publish_state(account.current_ma / 1000.0f);
+    }
+  }
+  for (auto &entry : this->outputs_) {
+    for (auto &sums : entry.zone_accumulated) {
+      sums = AccumulatedSums{};
+    }
+  }
+
+  for (auto &account : this->effect_accounts_) {
+    account.current_ma = 0.0f;
+    for (size_t i = 0; i < account.shares.size() && i < this->outputs_.size();
+         i++) {
+      EffectShare &share = account.shares[i];
+      const float frames = static_cast<float>(
+          std::max<uint32_t>(this->outputs_[i].accumulated_frames, 1));
+      account.current_ma += model_current_ma_(this->outputs_[i].model,
+                                              share.channels, share.white,
+                                              share.led_frames, frames);
+      share = EffectShare{};
+    }
+    if (account.current_sensor != nullptr) {
+      account.current_sensor->publish_state(account.current_ma / 1000.0f);
+    }
+  }
+}
+
+// Accounts are billed on the AC side like the node total; the controller's
+// own draw stays with the node.
+void CFXPowerManager::integrate_accounts_(uint32_t dt_ms) {
+  const float kwh_per_ma = this->supply_voltage_ / 1000.0f /
+                           this->psu_efficiency_ * static_cast<float>(dt_ms) /
+                           3600000000.0f;
+  CFXEnergyRecord &record = this->energy_record_;
+  for (auto &account : this->zone_accounts_) {
+    if (account.energy_sensor == nullptr) {
+      continue;
+    }
+    const float kwh = account.current_ma * kwh_per_ma;
+    float *total = &account.unsaved_kwh;
+    if (account.energy_slot >= 0) {
+      total = &record.zone_kwh[account.energy_slot];
+      record.open_bucket.zone_kwh[account.energy_slot] += kwh;
+    }
+    *total += kwh;
+    account.energy_sensor->publish_state(*total);
+  }
+  for (auto &account : this->effect_accounts_) {
+    if (account.energy_sensor == nullptr) {
+      continue;
+    }
+    const float kwh = account.current_ma * kwh_per_ma;
+    float *total = &account.unsaved_kwh;
+    if (account.energy_slot >= 0) {
+      total = &record.effect_kwh[account.energy_slot];
+    }
+    *total += kwh;
+    account.energy_sensor->publish_state(*total);
+  }
+}
+
 void CFXPowerManager::check_auto_reduction_(uint32_t now_ms) {
   const float dynamic_scale =
       static_cast<float>(this->get_transmit_scale()) / 255.0f;
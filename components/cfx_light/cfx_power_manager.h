@@ -15,6 +15,30 @@ namespace cfx_light {
 
 class CFXPowerManager;
 
+// Persisted energy ledger (energy_pref_). The node total and the first
+// ENERGY_ZONE_SLOTS segment / ENERGY_EFFECT_SLOTS effect accounts with an
+// energy sensor keep lifetime totals; the history ring holds what the node
+// and those segments used in each of the last ENERGY_HISTORY_SLOTS save
+// intervals (one hour each), oldest first from history_head.
+static constexpr uint8_t ENERGY_ZONE_SLOTS = 8;
+static constexpr uint8_t ENERGY_EFFECT_SLOTS = 8;
+static constexpr uint8_t ENERGY_HISTORY_SLOTS = 24;
+
+struct CFXEnergyBucket {
+  float node_kwh;
+  float zone_kwh[ENERGY_ZONE_SLOTS];
+};
+
+struct CFXEnergyRecord {
+  float node_kwh;
+  float zone_kwh[ENERGY_ZONE_SLOTS];
+  float effect_kwh[ENERGY_EFFECT_SLOTS];
+  CFXEnergyBucket history[ENERGY_HISTORY_SLOTS];
+  CFXEnergyBucket open_bucket;  // Interval in progress
+  uint8_t history_head;
+  uint8_t history_count;
+};
+
 class CFXPowerReductionSelect : public select::Select {
  public:
   void set_manager(CFXPowerManager *manager) { this->manager_ = manager; }
@@ -41,6 +65,7 @@ class CFXPowerManager : public Component {
                          sensor::Sensor *power_factor_sensor);
   void configure_reduction(bool restore, uint32_t ramp_time_ms);
   void configure_auto_reduction(uint32_t safe_hold_ms);
+  void configure_frame_limiter(float max_load);
   void set_node_sensors(sensor::Sensor *dc_current, sensor::Sensor *dc_power,
                         sensor::Sensor *ac_power,
                         sensor::Sensor *apparent_power,
@@ -48,24 +73,89 @@ class CFXPowerManager : public Component {
                         sensor::Sensor *psu_load,
                         text_sensor::TextSensor *budget_status);
   void set_reduction_select(CFXPowerReductionSelect *select);
+  // Per-segment accounting for segment `zone` (segment_defs_ index) of
+  // `output`. Either sensor may be null.
+  void add_zone_sensors(CFXLightOutput *output, uint8_t zone,
+                        sensor::Sensor *current, sensor::Sensor *energy);
+  // Per-effect accounting: every zone drawing effect `mode`, node-wide.
+  void add_effect_sensors(uint8_t mode, sensor::Sensor *current,
+                          sensor::Sensor *energy);
+  const CFXEnergyRecord &get_energy_record() const {
+    return this->energy_record_;
+  }
   void register_output(CFXLightOutput *output, const char *name, float idle_ma,
                        float rgb_channel_ma, float white_channel_ma);
   void record_output_frame(CFXLightOutput *output);
+  // Frame limiter: an output reports the unscaled sums of a frame as its
+  // transmit copy accumulated them, before DMA starts where the transport
+  // allows (streamed SPI and parallel frames report once queued and are
+  // corrected by the next frame). The prediction covers every registered
+  // output (the others at their last reported frame) and sets the limit
+  // scale.
+  bool frame_limiter_active() const {
+    return this->frame_limiter_enabled_ && this->psu_current_limit_ma_ > 0.0f;
+  }
+  void predict_output_frame(CFXLightOutput *output, uint32_t channels,
+                            uint32_t white);
 
+  // Reduction (thermal) scale times the frame limit scale.
   uint8_t get_transmit_scale() const;
+  uint8_t get_frame_limit_scale() const { return this->frame_limit_scale_; }
   float get_current_reduction_percent() const {
     return this->current_reduction_percent_;
   }
   void set_target_reduction_percent(float value, bool persist);
 
  protected:
+  struct AccumulatedSums {
+    uint64_t channels{0};
+    uint64_t white{0};
+  };
+
   struct OutputEntry {
     CFXLightOutput *output{nullptr};
     const char *name{nullptr};
     CFXPowerModel model{};
     float estimated_dc_current_ma{0.0f};
-    float accumulated_dc_current_ma{0.0f};
+    // Wire byte sums of every frame since the last sample.
+    uint64_t accumulated_channels{0};
+    uint64_t accumulated_white{0};
     uint32_t accumulated_frames{0};
+    // Unscaled dynamic mA of the last frame the output reported.
+    float predicted_dynamic_ma{0.0f};
+    // Frame limit scale that frame went out at.
+    uint8_t predicted_limit_scale{255};
+    // Per-segment sums since the last sample, segment_defs_ order; sized on
+    // the first accounted frame.
+    std::vector<AccumulatedSums> zone_accumulated;
+    bool accounted{false};
+  };
+
+  struct ZoneAccount {
+    CFXLightOutput *output{nullptr};
+    uint8_t zone{0};
+    sensor::Sensor *current_sensor{nullptr};
+    sensor::Sensor *energy_sensor{nullptr};
+    int8_t energy_slot{-1};  // CFXEnergyRecord zone slot, -1 when none
+    float current_ma{0.0f};
+    float unsaved_kwh{0.0f};  // Total when there is no slot
+  };
+
+  // What one output's zones running an effect drew since the last sample.
+  struct EffectShare {
+    uint64_t channels{0};
+    uint64_t white{0};
+    uint64_t led_frames{0};
+  };
+
+  struct EffectAccount {
+    uint8_t mode{0};
+    sensor::Sensor *current_sensor{nullptr};
+    sensor::Sensor *energy_sensor{nullptr};
+    int8_t energy_slot{-1};
+    float current_ma{0.0f};
+    float unsaved_kwh{0.0f};
+    std::vector<EffectShare> shares;  // Indexed like outputs_
   };
 
   void sample_();
@@ -75,6 +165,19 @@ class CFXPowerManager : public Component {
                              bool outputs_idle, uint32_t now_ms);
   void set_auto_reduction_percent_(uint8_t value);
   void update_effective_reduction_();
+  float reduction_transmit_scale_() const;
+  void record_zones_(size_t index, OutputEntry &entry,
+                     const CFXPowerSums &sums);
+  void record_effect_(size_t index, uint8_t mode, uint32_t channels,
+                      uint32_t white, uint16_t leds);
+  void measure_accounts_();
+  void integrate_accounts_(uint32_t dt_ms);
+  void close_energy_bucket_();
+  void save_energy_();
+  void restore_energy_();
+  static float model_current_ma_(const CFXPowerModel &model, uint64_t channels,
+                                 uint64_t white, uint64_t led_frames,
+                                 float frames);
   void refresh_outputs_();
   void publish_reduction_state_();
   static float live_sensor_or_(sensor::Sensor *sensor, float fallback,
@@ -87,6 +190,7 @@ class CFXPowerManager : public Component {
   bool monitor_enabled_{false};
   bool reduction_enabled_{false};
   bool auto_reduction_enabled_{false};
+  bool frame_limiter_enabled_{false};
   bool restore_reduction_{true};
   uint32_t update_interval_ms_{5000};
   uint32_t ramp_time_ms_{800};
@@ -102,6 +206,8 @@ class CFXPowerManager : public Component {
   float power_factor_{0.90f};
   float mains_voltage_{0.0f};
   float controller_current_ma_{120.0f};
+  float frame_limit_max_load_{1.0f};
+  uint8_t frame_limit_scale_{255};
   float current_reduction_percent_{0.0f};
   uint8_t manual_reduction_percent_{0};
   uint8_t auto_reduction_percent_{0};
@@ -112,7 +218,9 @@ class CFXPowerManager : public Component {
   ESPPreferenceObject pref_{};
   ESPPreferenceObject energy_pref_{};
   bool energy_pref_ready_{false};
-  float energy_kwh_{0.0f};
+  CFXEnergyRecord energy_record_{};
+  std::vector<ZoneAccount> zone_accounts_;
+  std::vector<EffectAccount> effect_accounts_;
   uint32_t last_energy_sample_ms_{0};
   uint32_t last_energy_save_ms_{0};
   sensor::Sensor *dc_current_sensor_{nullptr};
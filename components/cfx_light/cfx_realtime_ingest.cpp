@@ -0,0 +1,609 @@
+#include "cfx_realtime_ingest.h"
+#include "cfx_light.h"
+
+#if defined(USE_ESP32) && defined(CFX_REALTIME_ENABLED)
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <lwip/inet.h>
+#include <lwip/sockets.h>
+#include <unistd.h>
+
+namespace esphome {
+namespace cfx_light {
+
+static const char *const TAG_REALTIME = "cfx_realtime";
+
+// ── Wire formats ─────────────────────────────────────────────────────────────
+
+// DDP (Distributed Display Protocol): 10-byte header, 14 with a timecode.
+static constexpr size_t DDP_HEADER_SIZE = 10;
+static constexpr size_t DDP_TIMECODE_SIZE = 4;
+static constexpr uint8_t DDP_FLAG_PUSH = 0x01;
+static constexpr uint8_t DDP_FLAG_QUERY = 0x02;
+static constexpr uint8_t DDP_FLAG_TIMECODE = 0x10;
+static constexpr uint8_t DDP_VERSION_1 = 0x40;
+static constexpr uint8_t DDP_ID_DISPLAY = 1;
+static constexpr uint8_t DDP_ID_ALL = 255;
+
+// E1.31 (sACN): root, framing and DMP layers in front of the slots.
+static const uint8_t E131_ACN_ID[12] = {'A', 'S', 'C', '-', 'E', '1',
+                                        '.', '1', '7', 0,   0,   0};
+static constexpr size_t E131_DATA_HEADER_SIZE = 126;
+static constexpr size_t E131_SYNC_PACKET_SIZE = 49;
+static constexpr uint32_t E131_ROOT_VECTOR_DATA = 0x00000004;
+static constexpr uint32_t E131_ROOT_VECTOR_EXTENDED = 0x00000008;
+static constexpr uint32_t E131_FRAME_VECTOR_DATA = 0x00000002;
+static constexpr uint32_t E131_FRAME_VECTOR_SYNC = 0x00000001;
+static constexpr uint8_t E131_DMP_VECTOR_SET_PROPERTY = 0x02;
+static constexpr uint8_t E131_OPTION_PREVIEW = 0x80;
+static constexpr uint8_t E131_OPTION_TERMINATED = 0x40;
+
+// Art-Net 4: an 8-byte ID and a little-endian opcode.
+static const uint8_t ARTNET_ID[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+static constexpr size_t ARTNET_DMX_HEADER_SIZE = 18;
+static constexpr uint16_t ARTNET_OP_DMX = 0x5000;
+static constexpr uint16_t ARTNET_OP_SYNC = 0x5200;
+
+// One DMX universe; pixels are never split across universes, so an RGB
+// universe carries 170 LEDs (510 slots) and an RGBW one 128.
+static constexpr size_t DMX_UNIVERSE_SLOTS = 512;
+
+static uint16_t read_be16(const uint8_t *p) {
+  return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+static uint32_t read_be32(const uint8_t *p) {
+  return (static_cast<uint32_t>(p[0]) << 24) |
+         (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+static uint8_t sink_stride(const CFXLightOutput *output) {
+  return output->has_white_channel() ? 4 : 3;
+}
+
+static const char *protocol_label(CFXRealtimeProtocol protocol) {
+  switch (protocol) {
+  case REALTIME_E131:
+    return "E1.31";
+  case REALTIME_ARTNET:
+    return "Art-Net";
+  case REALTIME_DDP:
+  default:
+    return "DDP";
+  }
+}
+
+// Returns true when `sequence` does not follow `previous`. Sequences run
+// first..last and wrap; `valid` is false until the first one is seen.
+static bool sequence_gap(bool &valid, uint8_t &previous, uint8_t sequence,
+                         uint8_t first, uint8_t last) {
+  const uint8_t expected = previous == last ? first : previous + 1;
+  const bool gap = valid && sequence != expected;
+  valid = true;
+  previous = sequence;
+  return gap;
+}
+
+// ── Singleton ────────────────────────────────────────────────────────────────
+
+CFXRealtimeIngest &CFXRealtimeIngest::get() {
+  static CFXRealtimeIngest instance;
+  return instance;
+}
+
+// ── Registration ─────────────────────────────────────────────────────────────
+
+void CFXRealtimeIngest::register_sink(CFXLightOutput *output,
+                                      CFXRealtimeProtocol protocol,
+                                      uint16_t port, uint32_t address,
+                                      uint16_t start, uint16_t count,
+                                      uint32_t timeout_ms) {
+  if (sink_count_ >= MAX_SINKS) {
+    ESP_LOGW(TAG_REALTIME,
+             "MAX_SINKS (%zu) reached — realtime input disabled for pin %u",
+             MAX_SINKS, output->get_pin());
+    return;
+  }
+  size_t socket = socket_count_;
+  for (size_t i = 0; i < socket_count_; i++) {
+    if (sockets_[i].protocol == protocol && sockets_[i].port == port) {
+      socket = i;
+      break;
+    }
+  }
+  if (socket == socket_count_) {
+    if (socket_count_ >= MAX_SOCKETS) {
+      ESP_LOGW(TAG_REALTIME,
+               "MAX_SOCKETS (%zu) reached — realtime input disabled for pin %u",
+               MAX_SOCKETS, output->get_pin());
+      return;
+    }
+    sockets_[socket] = Socket{};
+    sockets_[socket].protocol = protocol;
+    sockets_[socket].port = port;
+    socket_count_++;
+  }
+
+  if (sink_count_ == 0) {
+    last_stats_log_ms_ = esphome::millis();
+  }
+  auto &sink = sinks_[sink_count_++];
+  sink = Sink{};
+  sink.output = output;
+  sink.socket = static_cast<uint8_t>(socket);
+  sink.address = address;
+  sink.start = start;
+  sink.count = count;
+  sink.timeout_ms = timeout_ms;
+  const size_t universe_leds = DMX_UNIVERSE_SLOTS / sink_stride(output);
+  sink.universe_count =
+      static_cast<uint16_t>((count + universe_leds - 1) / universe_leds);
+
+  auto &sock = sockets_[socket];
+  if (protocol == REALTIME_E131) {
+    // Memberships are (re)joined from service() once the socket is open.
+    sock.groups_joined = false;
+    sock.last_join_ms = 0;
+  }
+  if (sock.fd < 0) {
+    this->open_socket_(sock);
+  }
+  if (protocol == REALTIME_DDP) {
+    ESP_LOGI(TAG_REALTIME,
+             "Sink registered: pin=%u DDP port=%u offset=%" PRIu32
+             " leds=%u..%u",
+             output->get_pin(), port, address, start, start + count);
+  } else {
+    ESP_LOGI(TAG_REALTIME,
+             "Sink registered: pin=%u %s port=%u universes=%" PRIu32
+             "..%" PRIu32 " leds=%u..%u",
+             output->get_pin(), protocol_label(protocol), port, address,
+             address + sink.universe_count - 1, start, start + count);
+  }
+}
+
+bool CFXRealtimeIngest::open_socket_(Socket &socket) {
+  socket.last_open_ms = esphome::millis();
+  socket.fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+  if (socket.fd < 0) {
+    ESP_LOGW(TAG_REALTIME, "Failed to create %s socket: errno=%d",
+             protocol_label(socket.protocol), errno);
+    return false;
+  }
+  int enabled = 1;
+  if (::setsockopt(socket.fd, SOL_SOCKET, SO_REUSEADDR, &enabled,
+                   sizeof(enabled)) < 0) {
+    ESP_LOGD(TAG_REALTIME, "SO_REUSEADDR setup failed: errno=%d", errno);
+  }
+  const int flags = ::fcntl(socket.fd, F_GETFL, 0);
+  if (flags >= 0) {
+    ::fcntl(socket.fd, F_SETFL, flags | O_NONBLOCK);
+  }
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(socket.port);
+  address.sin_addr.s_addr = INADDR_ANY;
+  if (::bind(socket.fd, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) < 0) {
+    ESP_LOGW(TAG_REALTIME, "Failed to bind %s socket on port %u: errno=%d",
+             protocol_label(socket.protocol), socket.port, errno);
+    ::close(socket.fd);
+    socket.fd = -1;
+    return false;
+  }
+  return true;
+}
+
+void CFXRealtimeIngest::join_groups_(Socket &socket) {
+  // sACN senders multicast universe N to 239.255.N.N. Joining fails until
+  // the network interface is up, so keep retrying until every group holds.
+  socket.last_join_ms = esphome::millis();
+  bool joined = true;
+  for (size_t i = 0; i < sink_count_; i++) {
+    const auto &sink = sinks_[i];
+    if (&sockets_[sink.socket] != &socket) {
+      continue;
+    }
+    for (uint16_t u = 0; u < sink.universe_count; u++) {
+      const uint32_t universe = sink.address + u;
+      ip_mreq group{};
+      group.imr_multiaddr.s_addr = htonl(0xEFFF0000u | (universe & 0xFFFFu));
+      group.imr_interface.s_addr = htonl(INADDR_ANY);
+      if (::setsockopt(socket.fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &group,
+                       sizeof(group)) < 0) {
+        joined = false;
+      }
+    }
+  }
+  socket.groups_joined = joined;
+  if (joined) {
+    ESP_LOGD(TAG_REALTIME, "Joined E1.31 multicast groups on port %u",
+             socket.port);
+  }
+}
+
+// ── service ──────────────────────────────────────────────────────────────────
+
+void CFXRealtimeIngest::service(CFXLightOutput *caller) {
+  if (sink_count_ == 0 || sinks_[0].output != caller) {
+    return;
+  }
+  const uint32_t now_ms = esphome::millis();
+  for (size_t s = 0; s < socket_count_; s++) {
+    auto &socket = sockets_[s];
+    if (socket.fd < 0) {
+      if (now_ms - socket.last_open_ms < SOCKET_RETRY_MS) {
+        continue;
+      }
+      if (!this->open_socket_(socket)) {
+        continue;
+      }
+    }
+    if (!socket.groups_joined &&
+        (socket.last_join_ms == 0 ||
+         now_ms - socket.last_join_ms >= SOCKET_RETRY_MS)) {
+      this->join_groups_(socket);
+    }
+    for (size_t n = 0; n < RX_BURST; n++) {
+      const ssize_t received = ::recvfrom(socket.fd, rx_buffer_,
+                                          sizeof(rx_buffer_), MSG_DONTWAIT,
+                                          nullptr, nullptr);
+      if (received <= 0) {
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+          ESP_LOGV(TAG_REALTIME, "%s receive failed: errno=%d",
+                   protocol_label(socket.protocol), errno);
+        }
+        break;
+      }
+      const uint32_t rx_us = esphome::micros();
+      const uint8_t index = static_cast<uint8_t>(s);
+      const size_t size = static_cast<size_t>(received);
+      switch (socket.protocol) {
+      case REALTIME_E131:
+        this->handle_e131_(index, rx_buffer_, size, rx_us);
+        break;
+      case REALTIME_ARTNET:
+        this->handle_artnet_(index, rx_buffer_, size, rx_us);
+        break;
+      case REALTIME_DDP:
+      default:
+        this->handle_ddp_(index, rx_buffer_, size, rx_us);
+        break;
+      }
+    }
+  }
+
+  this->expire_sinks_(now_ms);
+  if ((now_ms - last_stats_log_ms_) >= STATS_LOG_INTERVAL_MS) {
+    this->log_stats_();
+  }
+}
+
+// ── Protocol handlers ────────────────────────────────────────────────────────
+
+void CFXRealtimeIngest::handle_ddp_(uint8_t socket, const uint8_t *data,
+                                    size_t size, uint32_t rx_us) {
+  if (size < DDP_HEADER_SIZE || (data[0] & 0xC0) != DDP_VERSION_1) {
+    return;
+  }
+  const uint8_t flags = data[0];
+  const uint8_t id = data[3];
+  if ((flags & DDP_FLAG_QUERY) != 0 ||
+      (id != DDP_ID_DISPLAY && id != DDP_ID_ALL)) {
+    return;  // Status/config queries and other devices are not ours.
+  }
+  const size_t header =
+      DDP_HEADER_SIZE + ((flags & DDP_FLAG_TIMECODE) != 0 ? DDP_TIMECODE_SIZE : 0);
+  if (size < header) {
+    return;
+  }
+  const uint8_t type = data[2];
+  const uint32_t offset = read_be32(data + 4);
+  const size_t length =
+      std::min<size_t>(read_be16(data + 8), size - header);
+  const uint8_t *payload = data + header;
+
+  auto &sock = sockets_[socket];
+  const uint8_t sequence = data[1] & 0x0F;
+  bool gap = false;
+  if (sequence != 0) {
+    // One DDP sequence per sender, so it is tracked on the socket.
+    gap = sequence_gap(sock.sequence_valid, sock.sequence, sequence, 1, 15);
+  }
+
+  for (size_t i = 0; i < sink_count_; i++) {
+    auto &sink = sinks_[i];
+    if (sink.socket != socket) {
+      continue;
+    }
+    if (gap) {
+      sink.stats.sequence_gaps++;
+    }
+    if (length == 0) {
+      continue;
+    }
+    // Type 0 means "undefined": take the sink's own pixel layout. Otherwise
+    // only 8-bit RGB (TTT=1) and RGBW (TTT=3) elements map onto a strip.
+    uint8_t src_stride = sink_stride(sink.output);
+    if (type != 0) {
+      const uint8_t kind = (type >> 3) & 0x07;
+      if ((type & 0x07) != 3 || (kind != 1 && kind != 3)) {
+        sink.stats.dropped++;
+        continue;
+      }
+      src_stride = kind == 3 ? 4 : 3;
+    }
+    // Skip a partial leading pixel so a misaligned packet cannot shift the
+    // channels of every pixel after it.
+    const uint32_t first_pixel = (offset + src_stride - 1) / src_stride;
+    const size_t skip = static_cast<size_t>(first_pixel) * src_stride - offset;
+    if (skip >= length) {
+      continue;
+    }
+    const uint32_t pixels =
+        static_cast<uint32_t>((length - skip) / src_stride);
+    const uint32_t lo = std::max<uint32_t>(first_pixel, sink.address);
+    const uint32_t hi =
+        std::min<uint32_t>(first_pixel + pixels, sink.address + sink.count);
+    if (lo >= hi) {
+      continue;
+    }
+    sink.output->write_realtime_pixels_(
+        static_cast<uint16_t>(sink.start + (lo - sink.address)),
+        payload + skip + static_cast<size_t>(lo - first_pixel) * src_stride,
+        static_cast<uint16_t>(hi - lo), src_stride);
+    this->note_packet_(sink, rx_us);
+  }
+
+  if ((flags & DDP_FLAG_PUSH) != 0) {
+    this->commit_socket_(socket);
+  }
+}
+
+void CFXRealtimeIngest::handle_e131_(uint8_t socket, const uint8_t *data,
+                                     size_t size, uint32_t rx_us) {
+  if (size < E131_SYNC_PACKET_SIZE ||
+      std::memcmp(data + 4, E131_ACN_ID, sizeof(E131_ACN_ID)) != 0) {
+    return;
+  }
+  const uint32_t root_vector = read_be32(data + 18);
+  const uint32_t frame_vector = read_be32(data + 40);
+  if (root_vector == E131_ROOT_VECTOR_EXTENDED) {
+    if (frame_vector == E131_FRAME_VECTOR_SYNC) {
+      sockets_[socket].last_sync_ms = esphome::millis();
+      this->commit_socket_(socket);
+    }
+    return;  // Universe discovery carries no pixels.
+  }
+  if (root_vector != E131_ROOT_VECTOR_DATA ||
+      frame_vector != E131_FRAME_VECTOR_DATA ||
+      size < E131_DATA_HEADER_SIZE ||
+      data[117] != E131_DMP_VECTOR_SET_PROPERTY || data[125] != 0) {
+    return;  // Not DMX level data (start codes other than 0 are ignored).
+  }
+  const uint8_t options = data[112];
+  if ((options & E131_OPTION_PREVIEW) != 0) {
+    return;
+  }
+  const uint16_t universe = read_be16(data + 113);
+  if ((options & E131_OPTION_TERMINATED) != 0) {
+    for (size_t i = 0; i < sink_count_; i++) {
+      auto &sink = sinks_[i];
+      if (sink.socket == socket && sink.live && universe >= sink.address &&
+          universe < sink.address + sink.universe_count) {
+        this->release_sink_(sink);
+      }
+    }
+    return;
+  }
+  const uint16_t property_count = read_be16(data + 123);
+  const size_t slot_count = std::min<size_t>(
+      property_count > 0 ? property_count - 1u : 0u,
+      size - E131_DATA_HEADER_SIZE);
+  const auto &sock = sockets_[socket];
+  const bool synchronized =
+      read_be16(data + 109) != 0 && sock.last_sync_ms != 0 &&
+      (esphome::millis() - sock.last_sync_ms) < SYNC_HOLD_MS;
+  this->write_universe_(socket, universe, data + E131_DATA_HEADER_SIZE,
+                        slot_count, data[111], true, synchronized, rx_us);
+}
+
+void CFXRealtimeIngest::handle_artnet_(uint8_t socket, const uint8_t *data,
+                                       size_t size, uint32_t rx_us) {
+  if (size < 10 || std::memcmp(data, ARTNET_ID, sizeof(ARTNET_ID)) != 0) {
+    return;
+  }
+  const uint16_t opcode = static_cast<uint16_t>(data[8] | (data[9] << 8));
+  if (opcode == ARTNET_OP_SYNC) {
+    sockets_[socket].last_sync_ms = esphome::millis();
+    this->commit_socket_(socket);
+    return;
+  }
+  if (opcode != ARTNET_OP_DMX || size < ARTNET_DMX_HEADER_SIZE) {
+    return;
+  }
+  // 15-bit Port-Address: Net (7 bits) : Sub-Net (4) : Universe (4).
+  const uint16_t universe =
+      static_cast<uint16_t>(data[14] | ((data[15] & 0x7F) << 8));
+  const size_t slot_count = std::min<size_t>(read_be16(data + 16),
+                                             size - ARTNET_DMX_HEADER_SIZE);
+  const auto &sock = sockets_[socket];
+  const bool synchronized =
+      sock.last_sync_ms != 0 &&
+      (esphome::millis() - sock.last_sync_ms) < SYNC_HOLD_MS;
+  // Sequence 0 means the sender does not number its packets.
+  this->write_universe_(socket, universe, data + ARTNET_DMX_HEADER_SIZE,
+                        slot_count, data[12], data[12] != 0, synchronized,
+                        rx_us);
+}
+
+void CFXRealtimeIngest::write_universe_(uint8_t socket, uint16_t universe,
+                                        const uint8_t *slots,
+                                        size_t slot_count, uint8_t sequence,
+                                        bool sequenced, bool synchronized,
+                                        uint32_t rx_us) {
+  // E1.31 numbers packets 0..255; Art-Net reserves 0 for "unsequenced".
+  const uint8_t first_sequence =
+      sockets_[socket].protocol == REALTIME_ARTNET ? 1 : 0;
+  for (size_t i = 0; i < sink_count_; i++) {
+    auto &sink = sinks_[i];
+    if (sink.socket != socket || universe < sink.address ||
+        universe >= sink.address + sink.universe_count) {
+      continue;
+    }
+    const uint8_t stride = sink_stride(sink.output);
+    const uint16_t universe_index =
+        static_cast<uint16_t>(universe - sink.address);
+    const size_t universe_leds = DMX_UNIVERSE_SLOTS / stride;
+    const size_t first = universe_index * universe_leds;
+    const size_t leds = std::min<size_t>(
+        std::min<size_t>(slot_count / stride, universe_leds),
+        sink.count - first);
+    if (universe_index == 0 && sequenced &&
+        sequence_gap(sink.sequence_valid, sink.sequence, sequence,
+                     first_sequence, 255)) {
+      sink.stats.sequence_gaps++;
+    }
+    if (leds == 0) {
+      sink.stats.dropped++;
+      continue;
+    }
+    sink.output->write_realtime_pixels_(
+        static_cast<uint16_t>(sink.start + first), slots,
+        static_cast<uint16_t>(leds), stride);
+    this->note_packet_(sink, rx_us);
+    // Without synchronization the sink's last universe completes its frame.
+    if (!synchronized && universe_index + 1u == sink.universe_count) {
+      this->commit_sink_(sink);
+    }
+  }
+}
+
+// ── Frame state ──────────────────────────────────────────────────────────────
+
+void CFXRealtimeIngest::note_packet_(Sink &sink, uint32_t rx_us) {
+  sink.stats.packets++;
+  sink.last_packet_ms = esphome::millis();
+  if (!sink.frame_pending) {
+    sink.frame_pending = true;
+    sink.frame_rx_us = rx_us;
+  }
+  if (!sink.live) {
+    sink.live = true;
+    if (live_count_++ == 0) {
+      // Keep loop() spinning so packets are drained as they arrive rather
+      // than on the next 16 ms tick.
+      high_freq_.start();
+    }
+    sink.output->set_realtime_live_(true);
+    ESP_LOGI(TAG_REALTIME, "Realtime stream started on pin %u",
+             sink.output->get_pin());
+  }
+}
+
+void CFXRealtimeIngest::commit_socket_(uint8_t socket) {
+  for (size_t i = 0; i < sink_count_; i++) {
+    if (sinks_[i].socket == socket) {
+      this->commit_sink_(sinks_[i]);
+    }
+  }
+}
+
+void CFXRealtimeIngest::commit_sink_(Sink &sink) {
+  if (!sink.frame_pending) {
+    return;
+  }
+  sink.frame_pending = false;
+  sink.stats.frames++;
+  sink.output->commit_realtime_frame_(sink.frame_rx_us);
+}
+
+void CFXRealtimeIngest::release_sink_(Sink &sink) {
+  sink.live = false;
+  sink.frame_pending = false;
+  sink.sequence_valid = false;
+  if (live_count_ > 0 && --live_count_ == 0) {
+    high_freq_.stop();
+  }
+  sink.output->set_realtime_live_(false);
+  ESP_LOGI(TAG_REALTIME, "Realtime stream ended on pin %u",
+           sink.output->get_pin());
+}
+
+void CFXRealtimeIngest::expire_sinks_(uint32_t now_ms) {
+  if (live_count_ == 0) {
+    return;
+  }
+  for (size_t i = 0; i < sink_count_; i++) {
+    auto &sink = sinks_[i];
+    if (sink.live && (now_ms - sink.last_packet_ms) > sink.timeout_ms) {
+      this->release_sink_(sink);
+    }
+  }
+}
+
+// ── Statistics ───────────────────────────────────────────────────────────────
+
+void CFXRealtimeIngest::record_latency(const CFXLightOutput *output,
+                                       uint32_t latency_us) {
+  for (size_t i = 0; i < sink_count_; i++) {
+    if (sinks_[i].output != output) {
+      continue;
+    }
+    auto &stats = sinks_[i].stats;
+    stats.latency_samples++;
+    stats.total_latency_us += latency_us;
+    if (latency_us > stats.max_latency_us) {
+      stats.max_latency_us = latency_us;
+    }
+    return;
+  }
+}
+
+const CFXRealtimeIngest::SinkStats *CFXRealtimeIngest::get_sink_stats(
+    const CFXLightOutput *output) const {
+  for (size_t i = 0; i < sink_count_; i++) {
+    if (sinks_[i].output == output) {
+      return &sinks_[i].stats;
+    }
+  }
+  return nullptr;
+}
+
+void CFXRealtimeIngest::log_stats_() {
+  last_stats_log_ms_ = esphome::millis();
+  for (size_t i = 0; i < sink_count_; i++) {
+    auto &sink = sinks_[i];
+    auto &stats = sink.stats;
+    if (stats.packets == 0 && stats.dropped == 0) {
+      continue;
+    }
+    ESP_LOGD(TAG_REALTIME,
+             "pin=%u %s packets=%" PRIu32 " frames=%" PRIu32
+             " dropped=%" PRIu32 " seq_gaps=%" PRIu32
+             " packet-to-photon avg=%" PRIu32 "us max=%" PRIu32 "us",
+             sink.output->get_pin(),
+             protocol_label(sockets_[sink.socket].protocol), stats.packets,
+             stats.frames, stats.dropped, stats.sequence_gaps,
+             stats.latency_samples > 0
+                 ? static_cast<uint32_t>(stats.total_latency_us /
+                                         stats.latency_samples)
+                 : 0u,
+             stats.max_latency_us);
+    stats = SinkStats{};
+  }
+}
+
+}  // namespace cfx_light
+}  // namespace esphome
+
+#endif  // USE_ESP32 && CFX_REALTIME_ENABLED
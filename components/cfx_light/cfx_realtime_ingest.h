@@ -0,0 +1,152 @@
+#pragma once
+// CFXRealtimeIngest — realtime pixel input from a show-control server.
+//
+// Outputs configured with `realtime:` register a sink here: a protocol, a UDP
+// port, an address in the sender's pixel space (DDP pixel offset or first
+// E1.31/Art-Net universe) and the LED range it feeds (the whole strip or one
+// segment). Sockets are shared per protocol+port, so several outputs can
+// split one DDP stream or a run of universes between them.
+//
+// Payloads are written from the receive buffer straight into the output's
+// buf_ at their offsets, reordered to the wire channel order in the same
+// pass. On zero-copy RMT outputs buf_ is the DMA buffer itself, so nothing
+// sits between the socket and the encoder. A frame commits on the DDP push
+// flag, an E1.31 synchronization packet or an ArtSync (or on the last
+// universe of the sink when the sender does not synchronize), and goes out
+// through the same transmit barrier as effect frames.
+//
+// While a sink is live (a packet within its timeout), the output stops
+// letting the master light paint or scrub the streamed range; other segments
+// keep running their effects and their flushes carry the streamed pixels.
+//
+// Packet-to-photon latency is measured from the read of a frame's first
+// packet to the launch of the transmit that carries it, and logged every
+// STATS_LOG_INTERVAL_MS at DEBUG level with packet, frame and loss counts.
+//
+// Thread safety: all paths run on the ESPHome main-loop task.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace cfx_light {
+
+class CFXLightOutput;  // forward declaration
+
+enum CFXRealtimeProtocol : uint8_t {
+  REALTIME_DDP = 0,
+  REALTIME_E131 = 1,
+  REALTIME_ARTNET = 2,
+};
+
+class CFXRealtimeIngest {
+ public:
+  static CFXRealtimeIngest &get();
+
+  // Called once per output at the end of setup(). `address` is the sink's
+  // first pixel in the DDP data space, or its first universe. LEDs
+  // [start, start + count) of the output receive the stream.
+  void register_sink(CFXLightOutput *output, CFXRealtimeProtocol protocol,
+                     uint16_t port, uint32_t address, uint16_t start,
+                     uint16_t count, uint32_t timeout_ms);
+
+  // Called from every registered output's loop() each tick. Only the first
+  // sink's output drains the sockets, so each loop pass reads them once.
+  void service(CFXLightOutput *caller);
+
+  // Called when a transmit carrying a streamed frame has launched;
+  // `latency_us` runs from the frame's first packet to the launch.
+  void record_latency(const CFXLightOutput *output, uint32_t latency_us);
+
+  // Per-sink statistics since the last stats log.
+  struct SinkStats {
+    uint32_t packets{0};
+    uint32_t frames{0};
+    uint32_t dropped{0};        // Malformed or out-of-range packets
+    uint32_t sequence_gaps{0};  // Missing or reordered sequence numbers
+    uint32_t latency_samples{0};
+    uint32_t max_latency_us{0};
+    uint64_t total_latency_us{0};
+  };
+  const SinkStats *get_sink_stats(const CFXLightOutput *output) const;
+
+ private:
+  CFXRealtimeIngest() = default;
+
+  struct Socket {
+    CFXRealtimeProtocol protocol{REALTIME_DDP};
+    uint16_t port{0};
+    int fd{-1};
+    bool groups_joined{true};  // E1.31 multicast memberships are in place
+    bool sequence_valid{false};  // DDP numbers packets per sender
+    uint8_t sequence{0};
+    uint32_t last_open_ms{0};
+    uint32_t last_join_ms{0};
+    uint32_t last_sync_ms{0};  // Last synchronization packet seen
+  };
+
+  struct Sink {
+    CFXLightOutput *output{nullptr};
+    uint8_t socket{0};
+    uint32_t address{0};
+    uint16_t start{0};
+    uint16_t count{0};
+    uint16_t universe_count{0};
+    uint32_t timeout_ms{0};
+    uint32_t last_packet_ms{0};
+    uint32_t frame_rx_us{0};  // First packet of the uncommitted frame
+    bool frame_pending{false};
+    bool live{false};
+    bool sequence_valid{false};
+    uint8_t sequence{0};
+    SinkStats stats{};
+  };
+
+  bool open_socket_(Socket &socket);
+  void join_groups_(Socket &socket);
+  void handle_ddp_(uint8_t socket, const uint8_t *data, size_t size,
+                   uint32_t rx_us);
+  void handle_e131_(uint8_t socket, const uint8_t *data, size_t size,
+                    uint32_t rx_us);
+  void handle_artnet_(uint8_t socket, const uint8_t *data, size_t size,
+                      uint32_t rx_us);
+  // Writes one universe of DMX slots to every sink of `socket` that maps it.
+  void write_universe_(uint8_t socket, uint16_t universe,
+                       const uint8_t *slots, size_t slot_count,
+                       uint8_t sequence, bool sequenced, bool synchronized,
+                       uint32_t rx_us);
+  void note_packet_(Sink &sink, uint32_t rx_us);
+  void commit_socket_(uint8_t socket);
+  void commit_sink_(Sink &sink);
+  void release_sink_(Sink &sink);
+  void expire_sinks_(uint32_t now_ms);
+  void log_stats_();
+
+  // Matches CFXTransmitBarrier::MAX_OUTPUTS; one socket per protocol.
+  static constexpr size_t MAX_SINKS = 8;
+  static constexpr size_t MAX_SOCKETS = 3;
+  // Datagrams drained per loop pass, so a flood cannot starve the loop.
+  static constexpr size_t RX_BURST = 16;
+  // Largest datagram on a 1500-byte MTU without fragmentation.
+  static constexpr size_t RX_BUFFER_SIZE = 1472;
+  // Binding and multicast joins fail until the network is up; retry period.
+  static constexpr uint32_t SOCKET_RETRY_MS = 5000;
+  // A synchronizing sender is expected to keep sending sync packets; after
+  // this long without one, universes commit on their own again.
+  static constexpr uint32_t SYNC_HOLD_MS = 4000;
+  static constexpr uint32_t STATS_LOG_INTERVAL_MS = 30000;
+
+  Socket sockets_[MAX_SOCKETS]{};
+  Sink sinks_[MAX_SINKS]{};
+  size_t socket_count_{0};
+  size_t sink_count_{0};
+  size_t live_count_{0};
+  uint8_t rx_buffer_[RX_BUFFER_SIZE]{};
+  HighFrequencyLoopRequester high_freq_{};
+  uint32_t last_stats_log_ms_{0};
+};
+
+}  // namespace cfx_light
+}  // namespace esphome
@@ -5,6 +5,11 @@
 
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#ifdef USE_CFX_TRACE
+#include "../cfx_effect/cfx_trace.h"
+#endif
+
+#include <cinttypes>
 
 namespace esphome {
 namespace cfx_light {
@@ -64,15 +69,21 @@ bool CFXTransmitBarrier::request_transmit(CFXLightOutput *output) {
   if (!pending_[slot]) {
     pending_[slot] = true;
     pending_count_++;
+    if (missed_[slot]) {
+      missed_[slot] = false;
+      stats_[slot].late_arrivals++;
+    }
     if (pending_count_ == 1) {
-      // First arrival — arm the timeout window.
-      first_req_ms_ = esphome::millis();
+      // First arrival — arm the timeout window and keep loop() spinning so
+      // service() sees the deadline on time.
+      first_req_us_ = esphome::micros();
+      high_freq_.start();
     }
   }
 
   // All registered RMT outputs are ready — fire all now.
   if (pending_count_ >= rmt_count_) {
-    fire_all_pending_();
+    fire_all_pending_(false);
     // Return false: the flush for this output already happened inside
     // fire_all_pending_(). Caller must NOT flush again.
     return false;
@@ -85,31 +96,121 @@ bool CFXTransmitBarrier::request_transmit(CFXLightOutput *output) {
 // ── service ──────────────────────────────────────────────────────────────────
 
 void CFXTransmitBarrier::service(CFXLightOutput * /* caller */) {
+  if (batches_ > 0 &&
+      (esphome::millis() - last_stats_log_ms_) >= STATS_LOG_INTERVAL_MS) {
+    log_stats_();
+  }
   if (pending_count_ == 0 || rmt_count_ < 2)
     return;
 
   // Timeout: fire whoever arrived — don't starve active outputs waiting for
   // an inactive one that suppressed write_state() this tick.
-  if ((esphome::millis() - first_req_ms_) >= BARRIER_TIMEOUT_MS) {
+  if ((esphome::micros() - first_req_us_) >= BARRIER_TIMEOUT_US) {
     ESP_LOGV(TAG_BARRIER,
              "Barrier timeout — firing %zu/%zu pending RMT output(s)",
              pending_count_, rmt_count_);
-    fire_all_pending_();
+    fire_all_pending_(true);
   }
 }
 
 // ── fire_all_pending_ ────────────────────────────────────────────────────────
 
-void CFXTransmitBarrier::fire_all_pending_() {
+void CFXTransmitBarrier::fire_all_pending_(bool timed_out) {
+  const uint32_t arrival_spread_us = esphome::micros() - first_req_us_;
+#ifdef USE_CFX_TRACE
+  chimera_fx::CFXTrace::get().span(chimera_fx::CFX_TRACE_BARRIER_WAIT,
+                                   first_req_us_, arrival_spread_us,
+                                   static_cast<uint16_t>(count_));
+#endif
   // Only RMT outputs enter the pending set. SPI/non-RMT queues independently.
+  // Phase 1: waits and encode copies, so nothing slow sits between launches.
   for (size_t i = 0; i < count_; i++) {
-    if (!pending_[i])
+    staged_[i] = pending_[i] && outputs_[i]->stage_transmit_();
+  }
+  // Phase 2: back-to-back launches.
+  bool have_first = false;
+  uint32_t first_launch_us = 0;
+  uint32_t skew_us = 0;
+  for (size_t i = 0; i < count_; i++) {
+    if (!staged_[i] || !outputs_[i]->launch_staged_transmit_())
       continue;
-    outputs_[i]->commit_transmit_();
+    const uint32_t launch_us = outputs_[i]->get_last_rmt_launch_us();
+    if (!have_first) {
+      have_first = true;
+      first_launch_us = launch_us;
+    }
+    const uint32_t offset_us = launch_us - first_launch_us;
+    auto &stats = stats_[i];
+    stats.launches++;
+    stats.total_offset_us += offset_us;
+    if (offset_us > stats.max_offset_us) {
+      stats.max_offset_us = offset_us;
+    }
+    skew_us = offset_us;
+  }
+  for (size_t i = 0; i < count_; i++) {
+    if (timed_out && !pending_[i] && outputs_[i]->is_rmt_transport()) {
+      missed_[i] = true;
+    }
     pending_[i] = false;
+    staged_[i] = false;
+  }
+
+  batches_++;
+  if (timed_out) {
+    timeout_batches_++;
+  }
+  total_skew_us_ += skew_us;
+  if (skew_us > max_skew_us_) {
+    max_skew_us_ = skew_us;
+  }
+  if (arrival_spread_us > max_arrival_spread_us_) {
+    max_arrival_spread_us_ = arrival_spread_us;
   }
   pending_count_ = 0;
-  first_req_ms_ = 0;
+  first_req_us_ = 0;
+  high_freq_.stop();
+}
+
+// ── Statistics ───────────────────────────────────────────────────────────────
+
+const CFXTransmitBarrier::OutputStats *CFXTransmitBarrier::get_output_stats(
+    const CFXLightOutput *output) const {
+  for (size_t i = 0; i < count_; i++) {
+    if (outputs_[i] == output) {
+      return &stats_[i];
+    }
+  }
+  return nullptr;
+}
+
+void CFXTransmitBarrier::log_stats_() {
+  ESP_LOGD(TAG_BARRIER,
+           "Batches=%" PRIu32 " timeouts=%" PRIu32 " skew avg=%" PRIu32
+           "us max=%" PRIu32 "us arrival_spread max=%" PRIu32 "us",
+           batches_, timeout_batches_,
+           static_cast<uint32_t>(total_skew_us_ / batches_), max_skew_us_,
+           max_arrival_spread_us_);
+  for (size_t i = 0; i < count_; i++) {
+    auto &stats = stats_[i];
+    if (!outputs_[i]->is_rmt_transport())
+      continue;
+    ESP_LOGD(TAG_BARRIER,
+             "  output[%zu] pin=%u launches=%" PRIu32 " late=%" PRIu32
+             " offset avg=%" PRIu32 "us max=%" PRIu32 "us",
+             i, outputs_[i]->get_pin(), stats.launches, stats.late_arrivals,
+             stats.launches > 0
+                 ? static_cast<uint32_t>(stats.total_offset_us / stats.launches)
+                 : 0u,
+             stats.max_offset_us);
+    stats = OutputStats{};
+  }
+  batches_ = 0;
+  timeout_batches_ = 0;
+  max_skew_us_ = 0;
+  total_skew_us_ = 0;
+  max_arrival_spread_us_ = 0;
+  last_stats_log_ms_ = esphome::millis();
 }
 
 }  // namespace cfx_light
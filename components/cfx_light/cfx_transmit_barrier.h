@@ -8,19 +8,30 @@
 // stagger gate, accumulated skew reduces the parallel overlap window.
 //
 // Solution: each output calls request_transmit() instead of flushing directly.
-// The barrier fires commit_transmit_() on all outputs simultaneously once all
-// registered outputs have requested in the same tick window. A safety timeout
-// (BARRIER_TIMEOUT_MS) fires whoever is pending if a late output misses the
-// window (e.g. it was suppressed as clean-idle this tick).
+// The barrier fires all pending outputs the moment the last registered one
+// arrives. Firing stages every output first (TX wait, encode copy) and only
+// then launches them back to back, so the launch skew is the cost of the
+// rmt_transmit() calls rather than of every copy in between. A safety
+// timeout (BARRIER_TIMEOUT_US) fires whoever is pending if a late output
+// misses the window (e.g. it was suppressed as clean-idle this tick); while a
+// window is open the barrier holds the main loop at high frequency so the
+// deadline is checked every pass, not on the next 16 ms tick.
+//
+// Launch skew, arrival spread and late arrivals are recorded per output and
+// logged every STATS_LOG_INTERVAL_MS at DEBUG level.
 //
 // Single-output setups: request_transmit() returns true immediately — zero
 // overhead, barrier is fully transparent.
 //
-// Thread safety: all paths run on the ESPHome main-loop task.
+// Thread safety: all paths run on the ESPHome main-loop task. A hardware
+// timer callback would fire outside it, where neither the effects' frame nor
+// the RMT bookkeeping may be touched, which is why the deadline is polled.
 
 #include <stddef.h>
 #include <stdint.h>
 
+#include "esphome/core/helpers.h"
+
 namespace esphome {
 namespace cfx_light {
 
@@ -49,9 +60,19 @@ class CFXTransmitBarrier {
 
   size_t rmt_output_count() const { return rmt_count_; }
 
+  // Per-output statistics since the last stats log.
+  struct OutputStats {
+    uint32_t launches{0};        // Launched as part of a barrier batch
+    uint32_t late_arrivals{0};   // Arrived after its batch fired on timeout
+    uint32_t max_offset_us{0};   // Launch after the batch's first launch
+    uint64_t total_offset_us{0};
+  };
+  const OutputStats *get_output_stats(const CFXLightOutput *output) const;
+
  private:
   CFXTransmitBarrier() = default;
-  void fire_all_pending_();
+  void fire_all_pending_(bool timed_out);
+  void log_stats_();
 
   // Maximum number of simultaneously registered outputs. 8 covers all
   // practical ESP32 configurations (limited by RMT channels + SPI buses).
@@ -60,14 +81,28 @@ class CFXTransmitBarrier {
   // Maximum time to wait for all outputs to arrive before firing whoever is
   // pending. 2 ms sits well inside one 20 ms frame budget at 50 FPS and is
   // longer than the Classic ESP32 300 µs RMT stagger gap.
-  static constexpr uint32_t BARRIER_TIMEOUT_MS = 2;
+  static constexpr uint32_t BARRIER_TIMEOUT_US = 2000;
+  static constexpr uint32_t STATS_LOG_INTERVAL_MS = 30000;
 
   CFXLightOutput *outputs_[MAX_OUTPUTS]{};
   bool pending_[MAX_OUTPUTS]{};
+  bool staged_[MAX_OUTPUTS]{};
+  // Missed the last timed-out batch; counted late when it next arrives.
+  bool missed_[MAX_OUTPUTS]{};
+  OutputStats stats_[MAX_OUTPUTS]{};
   size_t count_{0};          // total registered outputs
   size_t rmt_count_{0};      // registered outputs that participate in barrier
   size_t pending_count_{0};  // RMT outputs that have requested this tick
-  uint32_t first_req_ms_{0}; // timestamp of the first request this tick
+  uint32_t first_req_us_{0}; // timestamp of the first request this tick
+  HighFrequencyLoopRequester high_freq_{};
+
+  // Batch statistics since the last stats log.
+  uint32_t batches_{0};
+  uint32_t timeout_batches_{0};
+  uint32_t max_skew_us_{0};
+  uint64_t total_skew_us_{0};
+  uint32_t max_arrival_spread_us_{0};
+  uint32_t last_stats_log_ms_{0};
 };
 
 }  // namespace cfx_light
@@ -92,7 +92,7 @@ public:
   // it takes full ownership of brightness and pixels. Creating a Transformer
   // here would corrupt the pixels (flashes/spikes).
   void update_state(light::LightState *state) override {
-    if (parent_->has_outro())
+    if (parent_->has_outro() || parent_->realtime_owns(state))
       return;
 
     if (parent_->get_master_light_state() != nullptr &&
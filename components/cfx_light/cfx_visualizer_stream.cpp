@@ -0,0 +1,303 @@
+#include "cfx_visualizer_stream.h"
+
+#ifdef CFX_VISUALIZER_ENABLED
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef USE_ESP32
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <cerrno>
+#include <cinttypes>
+#include <lwip/inet.h>
+#endif
+
+namespace esphome {
+namespace cfx_light {
+
+CFXVisualizerStream &CFXVisualizerStream::get() {
+  static CFXVisualizerStream instance;
+  return instance;
+}
+
+// ── Frame encoder ────────────────────────────────────────────────────────────
+
+static void write_le16(uint8_t *p, uint16_t value) {
+  p[0] = static_cast<uint8_t>(value & 0xFF);
+  p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void CFXVisualizerStream::encode_frame(const uint8_t *pixels,
+                                       const uint8_t *previous,
+                                       uint16_t led_count, uint8_t stride,
+                                       uint16_t sequence, bool keyframe,
+                                       uint8_t *scratch, EmitFn emit,
+                                       void *ctx) {
+  const uint8_t base_flags = keyframe ? FLAG_KEYFRAME : 0;
+  auto pixel = [&](uint16_t led) { return pixels + led * stride; };
+  auto unchanged = [&](uint16_t led) {
+    return !keyframe &&
+           std::memcmp(pixel(led), previous + led * stride, stride) == 0;
+  };
+  auto same = [&](uint16_t a, uint16_t b) {
+    return std::memcmp(pixel(a), pixel(b), stride) == 0;
+  };
+
+  size_t pos = 0;
+  auto begin = [&](uint16_t first_led) {
+    scratch[0] = TYPE_FRAME;
+    write_le16(scratch + 1, sequence);
+    scratch[3] = base_flags;
+    scratch[4] = stride;
+    write_le16(scratch + 5, led_count);
+    write_le16(scratch + 7, first_led);
+    pos = FRAME_HEADER_SIZE;
+  };
+
+  begin(0);
+  uint16_t led = 0;
+  while (led < led_count) {
+    uint16_t count = 1;
+    uint8_t op;
+    size_t payload;
+    if (unchanged(led)) {
+      while (led + count < led_count && count < OP_MAX_COUNT &&
+             unchanged(led + count))
+        count++;
+      op = OP_SKIP;
+      payload = 0;
+    } else if (led + 1 < led_count && same(led, led + 1)) {
+      while (led + count < led_count && count < OP_MAX_COUNT &&
+             same(led, led + count))
+        count++;
+      op = OP_REPEAT;
+      payload = stride;
+    } else {
+      // Literal run up to the next pixel that a skip or repeat would carry
+      // more cheaply.
+      while (led + count < led_count && count < OP_MAX_COUNT) {
+        const uint16_t next = led + count;
+        if (unchanged(next) || (next + 1 < led_count && same(next, next + 1)))
+          break;
+        count++;
+      }
+      op = OP_LITERAL;
+      payload = count * stride;
+    }
+
+    // A trailing skip carries nothing the receiver does not already have.
+    if (op == OP_SKIP && led + count == led_count)
+      break;
+
+    if (pos + 1 + payload > MAX_DATAGRAM) {
+      emit(ctx, scratch, pos);
+      begin(led);
+    }
+    scratch[pos++] = static_cast<uint8_t>(op | (count - 1));
+    std::memcpy(scratch + pos, pixel(led), payload);
+    pos += payload;
+    led += count;
+  }
+  scratch[3] = base_flags | FLAG_LAST;
+  emit(ctx, scratch, pos);
+}
+
+#ifdef USE_ESP32
+
+static const char *const TAG_VISUALIZER = "cfx_visualizer";
+
+// ── Registration ─────────────────────────────────────────────────────────────
+
+int CFXVisualizerStream::register_output(const std::string &ip, uint16_t port,
+                                         uint32_t interval_ms,
+                                         size_t pixel_bytes, uint8_t stride,
+                                         uint8_t pin, CFXMemoryBudget *budget) {
+  if (stream_count_ >= MAX_STREAMS) {
+    ESP_LOGW(TAG_VISUALIZER, "pin=%u: stream table full (%u), not streaming",
+             pin, static_cast<unsigned>(MAX_STREAMS));
+    return -1;
+  }
+  struct in_addr addr {};
+  if (::inet_aton(ip.c_str(), &addr) == 0) {
+    ESP_LOGW(TAG_VISUALIZER, "pin=%u: '%s' is not an IPv4 address", pin,
+             ip.c_str());
+    return -1;
+  }
+  if (fd_ < 0) {
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    if (fd_ < 0) {
+      ESP_LOGW(TAG_VISUALIZER, "socket() failed: errno=%d", errno);
+      return -1;
+    }
+  }
+
+  // Snapshots are only touched by memcpy and the encoder: cold buffers.
+  uint8_t *snapshot =
+      budget->allocate(CFX_MEM_COLD, pixel_bytes, "visualizer snapshot");
+  uint8_t *sent =
+      budget->allocate(CFX_MEM_COLD, pixel_bytes, "visualizer sent");
+  if (snapshot == nullptr || sent == nullptr) {
+    budget->release(snapshot);
+    budget->release(sent);
+    ESP_LOGW(TAG_VISUALIZER, "pin=%u: cannot allocate %u-byte snapshots", pin,
+             static_cast<unsigned>(pixel_bytes));
+    return -1;
+  }
+
+  if (task_ == nullptr) {
+    // Priority 1, unpinned: below the ESPHome loop, so encoding and sendto()
+    // only ever use time the render path leaves over.
+    BaseType_t ret = xTaskCreatePinnedToCore(task_fn_, "cfx_visualizer", 3072,
+                                             this, 1, &task_, tskNO_AFFINITY);
+    if (ret != pdPASS) {
+      task_ = nullptr;
+      budget->release(snapshot);
+      budget->release(sent);
+      ESP_LOGW(TAG_VISUALIZER, "Task create failed (err=%d)", (int) ret);
+      return -1;
+    }
+    last_stats_log_ms_ = esphome::millis();
+  }
+
+  Stream &stream = streams_[stream_count_];
+  stream.dest.sin_family = AF_INET;
+  stream.dest.sin_port = htons(port);
+  stream.dest.sin_addr = addr;
+  stream.interval_ms = interval_ms;
+  stream.snapshot = snapshot;
+  stream.sent = sent;
+  stream.led_count = static_cast<uint16_t>(pixel_bytes / stride);
+  stream.stride = stride;
+  stream.pin = pin;
+  ESP_LOGCONFIG(TAG_VISUALIZER, "pin=%u: streaming to %s:%u every %" PRIu32
+                "ms", pin, ip.c_str(), port, interval_ms);
+  return static_cast<int>(stream_count_++);
+}
+
+// ── Main-loop side ───────────────────────────────────────────────────────────
+
+void CFXVisualizerStream::submit_frame(int slot, const uint8_t *pixels,
+                                       uint32_t now_ms) {
+  if (slot < 0 || static_cast<size_t>(slot) >= stream_count_ ||
+      pixels == nullptr)
+    return;
+  Stream &stream = streams_[slot];
+  if ((now_ms - stream.last_submit_ms) >= stream.interval_ms) {
+    if (stream.frame_ready.load(std::memory_order_acquire)) {
+      stream.busy_skips++;
+    } else {
+      std::memcpy(stream.snapshot, pixels,
+                  static_cast<size_t>(stream.led_count) * stream.stride);
+      stream.last_submit_ms = now_ms;
+      stream.frames++;
+      stream.frame_ready.store(true, std::memory_order_release);
+      xTaskNotifyGive(task_);
+    }
+  }
+  if ((now_ms - last_stats_log_ms_) >= STATS_LOG_INTERVAL_MS)
+    this->log_stats_();
+}
+
+void CFXVisualizerStream::submit_metadata(int slot, const std::string &name,
+                                          const std::string &palette) {
+  if (slot < 0 || static_cast<size_t>(slot) >= stream_count_)
+    return;
+  uint8_t pkt[96];
+  size_t pos = 0;
+  pkt[pos++] = TYPE_METADATA;
+  pkt[pos++] = 'C';
+  pkt[pos++] = 'F';
+  pkt[pos++] = 'X';
+  auto append = [&](const std::string &text) {
+    const size_t n = std::min(text.size(), sizeof(pkt) - pos);
+    std::memcpy(pkt + pos, text.data(), n);
+    pos += n;
+  };
+  append(name);
+  if (!palette.empty() && pos < sizeof(pkt)) {
+    pkt[pos++] = ':';
+    append(palette);
+  }
+  const Stream &stream = streams_[slot];
+  ::sendto(fd_, pkt, pos, MSG_DONTWAIT,
+           reinterpret_cast<const struct sockaddr *>(&stream.dest),
+           sizeof(stream.dest));
+}
+
+void CFXVisualizerStream::log_stats_() {
+  last_stats_log_ms_ = esphome::millis();
+  for (size_t i = 0; i < stream_count_; i++) {
+    Stream &stream = streams_[i];
+    const uint32_t datagrams =
+        stream.datagrams.exchange(0, std::memory_order_relaxed);
+    const uint32_t bytes = stream.bytes.exchange(0, std::memory_order_relaxed);
+    if (stream.frames == 0 && stream.busy_skips == 0)
+      continue;
+    ESP_LOGD(TAG_VISUALIZER,
+             "pin=%u frames=%" PRIu32 " busy_skips=%" PRIu32
+             " datagrams=%" PRIu32 " bytes=%" PRIu32 " (raw %" PRIu32 ")",
+             stream.pin, stream.frames, stream.busy_skips, datagrams, bytes,
+             stream.frames * stream.led_count * stream.stride);
+    stream.frames = 0;
+    stream.busy_skips = 0;
+  }
+}
+
+// ── Sender task ──────────────────────────────────────────────────────────────
+
+void CFXVisualizerStream::task_fn_(void *arg) {
+  auto *self = static_cast<CFXVisualizerStream *>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const uint32_t now_ms = esphome::millis();
+    for (size_t i = 0; i < self->stream_count_; i++) {
+      Stream &stream = self->streams_[i];
+      if (stream.frame_ready.load(std::memory_order_acquire))
+        self->send_frame_(stream, now_ms);
+    }
+  }
+}
+
+void CFXVisualizerStream::send_frame_(Stream &stream, uint32_t now_ms) {
+  const bool keyframe =
+      !stream.sent_valid ||
+      (now_ms - stream.last_keyframe_ms) >= KEYFRAME_INTERVAL_MS;
+  struct EmitCtx {
+    int fd;
+    Stream *stream;
+  } ctx{fd_, &stream};
+  encode_frame(
+      stream.snapshot, stream.sent, stream.led_count, stream.stride,
+      stream.sequence, keyframe, datagram_,
+      [](void *p, const uint8_t *data, size_t size) {
+        auto *c = static_cast<EmitCtx *>(p);
+        if (::sendto(c->fd, data, size, 0,
+                     reinterpret_cast<const struct sockaddr *>(&c->stream->dest),
+                     sizeof(c->stream->dest)) >= 0) {
+          c->stream->datagrams.fetch_add(1, std::memory_order_relaxed);
+          c->stream->bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+      },
+      &ctx);
+
+  if (keyframe)
+    stream.last_keyframe_ms = now_ms;
+  stream.sequence++;
+  stream.sent_valid = true;
+  // The encoded snapshot becomes the delta reference; the old reference is
+  // handed back to the main loop as the next snapshot buffer.
+  uint8_t *previous = stream.sent;
+  stream.sent = stream.snapshot;
+  stream.snapshot = previous;
+  stream.frame_ready.store(false, std::memory_order_release);
+}
+
+#endif  // USE_ESP32
+
+}  // namespace cfx_light
+}  // namespace esphome
+
+#endif  // CFX_VISUALIZER_ENABLED
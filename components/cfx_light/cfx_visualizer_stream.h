@@ -0,0 +1,147 @@
+#pragma once
+// CFXVisualizerStream — compact preview stream for the desktop visualizer.
+//
+// Outputs with `visualizer_ip:` register a stream here at the end of setup().
+// The destination is parsed once at registration. write_state() then offers
+// each shown frame through submit_frame(), which stays cheap:
+//
+//   - frames closer than the stream's interval to the last accepted one are
+//     ignored (rate decimation, `visualizer_interval`);
+//   - a frame is also ignored while the sender task still owns the previous
+//     snapshot, so a slow network never backs up into the render path;
+//   - an accepted frame costs one memcpy of buf_ and a task notification.
+//
+// A low-priority FreeRTOS task encodes the snapshot against the last frame it
+// sent and ships it as one or more datagrams that fit the MTU. Metadata
+// (effect and palette names) is rare and small, so it is sent straight from
+// the caller with MSG_DONTWAIT.
+//
+// Wire format, all multi-byte fields little-endian:
+//
+//   Metadata (type 0x01): 0x01 'C' 'F' 'X' name [':' palette]
+//
+//   Frame (type 0x02), FRAME_HEADER_SIZE-byte header:
+//     [0]    0x02
+//     [1-2]  frame sequence, shared by every datagram of one frame
+//     [3]    flags: bit0 keyframe, bit1 last datagram of the frame
+//     [4]    bytes per pixel (3 = RGB, 4 = RGBW), in the strip's wire order
+//     [5-6]  LED count of the strip
+//     [7-8]  first LED this datagram covers
+//   followed by ops, each an op byte (top two bits op, low six bits
+//   count - 1, so 1..64 pixels) and its payload:
+//     00  skip:    count pixels unchanged since the previous frame
+//     01  literal: count pixels follow
+//     10  repeat:  one pixel follows, applied to count pixels
+//   Every datagram is self-contained: its ops start at its first LED, so a
+//   receiver can apply datagrams in any order. Keyframes carry no skip ops
+//   and are sent every KEYFRAME_INTERVAL_MS, bounding how long a lost
+//   datagram leaves the preview stale.
+//
+// Thread safety: register_output() and submit_*() run on the ESPHome
+// main-loop task; frame encoding and its sendto() run on the sender task.
+// Each stream hands its snapshot over with an atomic flag.
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "cfx_memory_budget.h"
+#include "esphome/core/defines.h"
+
+#if defined(USE_ESP32) && defined(CFX_VISUALIZER_ENABLED)
+#include <lwip/sockets.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+namespace esphome {
+namespace cfx_light {
+
+class CFXVisualizerStream {
+ public:
+  static CFXVisualizerStream &get();
+
+  // Returns the stream slot, or -1 when the destination does not parse, the
+  // table is full or the buffers cannot be allocated. `pixel_bytes` is the
+  // size of the output's buf_, `stride` its bytes per pixel. The snapshots
+  // are cold buffers booked to `budget`, the output's memory policy.
+  int register_output(const std::string &ip, uint16_t port,
+                      uint32_t interval_ms, size_t pixel_bytes,
+                      uint8_t stride, uint8_t pin, CFXMemoryBudget *budget);
+
+  // Called from write_state() for every shown frame; see the header comment
+  // for when the frame is actually taken.
+  void submit_frame(int slot, const uint8_t *pixels, uint32_t now_ms);
+
+  // Sends the effect/palette name shown in the visualizer's title.
+  void submit_metadata(int slot, const std::string &name,
+                       const std::string &palette);
+
+  enum PacketType : uint8_t {
+    TYPE_METADATA = 0x01,
+    TYPE_FRAME = 0x02,
+  };
+  static constexpr uint8_t FLAG_KEYFRAME = 0x01;
+  static constexpr uint8_t FLAG_LAST = 0x02;
+  static constexpr size_t FRAME_HEADER_SIZE = 9;
+  // Payload that stays clear of IP fragmentation on common links.
+  static constexpr size_t MAX_DATAGRAM = 1400;
+  static constexpr uint8_t OP_SKIP = 0x00;
+  static constexpr uint8_t OP_LITERAL = 0x40;
+  static constexpr uint8_t OP_REPEAT = 0x80;
+  static constexpr uint16_t OP_MAX_COUNT = 64;
+
+  // Encodes one frame into datagrams of at most MAX_DATAGRAM bytes and hands
+  // each to `emit`. `previous` is ignored for keyframes. Pure function of
+  // its inputs so it can be exercised off-target.
+  using EmitFn = void (*)(void *ctx, const uint8_t *data, size_t size);
+  static void encode_frame(const uint8_t *pixels, const uint8_t *previous,
+                           uint16_t led_count, uint8_t stride,
+                           uint16_t sequence, bool keyframe, uint8_t *scratch,
+                           EmitFn emit, void *ctx);
+
+ private:
+  CFXVisualizerStream() = default;
+
+#if defined(USE_ESP32) && defined(CFX_VISUALIZER_ENABLED)
+  struct Stream {
+    struct sockaddr_in dest {};
+    uint32_t interval_ms{0};
+    uint32_t last_submit_ms{0};
+    uint8_t *snapshot{nullptr};  // Owned by the task while frame_ready
+    uint8_t *sent{nullptr};      // Task only: the last frame it encoded
+    uint16_t led_count{0};
+    uint8_t stride{3};
+    bool sent_valid{false};
+    uint16_t sequence{0};
+    uint32_t last_keyframe_ms{0};
+    uint8_t pin{0};  // For logs only
+    std::atomic<bool> frame_ready{false};
+    // Counters since the last stats log; the byte counts are the task's.
+    uint32_t frames{0};
+    uint32_t busy_skips{0};
+    std::atomic<uint32_t> datagrams{0};
+    std::atomic<uint32_t> bytes{0};
+  };
+
+  static void task_fn_(void *arg);
+  void send_frame_(Stream &stream, uint32_t now_ms);
+  void log_stats_();
+
+  static constexpr size_t MAX_STREAMS = 8;
+  static constexpr uint32_t KEYFRAME_INTERVAL_MS = 1000;
+  static constexpr uint32_t STATS_LOG_INTERVAL_MS = 30000;
+
+  Stream streams_[MAX_STREAMS]{};
+  size_t stream_count_{0};
+  int fd_{-1};
+  TaskHandle_t task_{nullptr};
+  uint8_t datagram_[MAX_DATAGRAM]{};
+  uint32_t last_stats_log_ms_{0};
+#endif
+};
+
+}  // namespace cfx_light
+}  // namespace esphome
@@ -59,11 +59,26 @@ from esphome.const import (
 CONF_RGB_ORDER = "rgb_order"
 CONF_RMT_SYMBOLS = "rmt_symbols"
 CONF_SACRIFICIAL_PIXEL = "sacrificial_pixel"
+CONF_ZERO_COPY = "zero_copy"
+CONF_MEMORY_PLACEMENT = "memory_placement"
+CONF_HOT = "hot"
+CONF_COLD = "cold"
 CONF_IS_WRGB = "is_wrgb"
 CONF_DEFAULT_TRANSITION_LENGTH = "default_transition_length"
 CONF_ALL_EFFECTS = "all_effects"
+CONF_ADAPTIVE_FRAME_RATE = "adaptive_frame_rate"
+CONF_PARTICLE_CAP = "particle_cap"
+CONF_KEEPALIVE_INTERVAL = "keepalive_interval"
 CONF_VISUALIZER_IP = "visualizer_ip"
 CONF_VISUALIZER_PORT = "visualizer_port"
+CONF_VISUALIZER_INTERVAL = "visualizer_interval"
+CONF_REALTIME = "realtime"
+CONF_REALTIME_PROTOCOL = "protocol"
+CONF_REALTIME_PORT = "port"
+CONF_REALTIME_OFFSET = "offset"
+CONF_REALTIME_UNIVERSE = "universe"
+CONF_REALTIME_SEGMENT = "segment"
+CONF_REALTIME_TIMEOUT = "timeout"
 CONF_POWER_MONITOR = "power_monitor"
 CONF_POWER_LIMIT = "power_limit"
 CONF_CFX_POWER = "cfx_power"
@@ -93,6 +108,11 @@ CONF_RESTORE = "restore"
 CONF_REDUCTION = "reduction"
 CONF_AUTO = "auto"
 CONF_SAFE_HOLD_TIME = "safe_hold_time"
+CONF_FRAME_LIMITER = "frame_limiter"
+CONF_POWER_SENSORS = "power_sensors"
+CONF_CURRENT = "current"
+CONF_EFFECT = "effect"
+CONF_MAX_LOAD = "max_load"
 
 CFX_POWER_SUPPLY_DEFAULT_ENABLE_TIME = "100ms"
 CFX_POWER_SUPPLY_DEFAULT_KEEP_ON_TIME = "5s"
@@ -115,6 +135,19 @@ CONF_SEGMENT_SET_COLOR = "set_color"
 CONF_SEGMENT_OUTPUT_ID = "output_id"
 CONF_SEGMENT_LIGHT_ID = "light_id"
 
+# Layout keys (segment or whole-light `layout:`)
+CONF_LAYOUT = "layout"
+CONF_LAYOUT_TYPE = "type"
+CONF_LAYOUT_WIDTH = "width"
+CONF_LAYOUT_HEIGHT = "height"
+CONF_LAYOUT_SERPENTINE = "serpentine"
+CONF_LAYOUT_VERTICAL = "vertical"
+CONF_LAYOUT_FOLDS = "folds"
+CONF_LAYOUT_GAPS = "gaps"
+CONF_LAYOUT_GAP_START = "start"
+CONF_LAYOUT_GAP_COUNT = "count"
+CONF_LAYOUT_MAP = "map"
+
 CODEOWNERS = ["@effelle"]
 DEPENDENCIES = ["esp32"]
 AUTO_LOAD = ["event", "cfx_effect", "sensor", "select", "text_sensor"]
@@ -196,6 +229,8 @@ CFXPowerReductionSelect = cfx_light_ns.class_(
 
 ChimeraChipset = cfx_light_ns.enum("ChimeraChipset")
 RGBOrder = cfx_light_ns.enum("RGBOrder")
+CFXMemClass = cfx_light_ns.enum("CFXMemClass")
+CFXMemPlacement = cfx_light_ns.enum("CFXMemPlacement")
 
 # Chipset enum mapping
 CHIPSETS = {
@@ -236,6 +271,25 @@ _SPI_SINGLE_HOST_VARIANTS = {
 _SPI_HOST_REGISTRY_KEY = "cfx_spi_host_registry"
 
 # RGB byte order mapping
+# Buffer placement for the HOT (pixel buffer, effect data) and COLD
+# (transition planes, visualizer snapshots) classes; see cfx_memory_budget.h.
+MEMORY_PLACEMENTS = {
+    "auto": CFXMemPlacement.CFX_MEM_AUTO,
+    "internal": CFXMemPlacement.CFX_MEM_INTERNAL,
+    "psram": CFXMemPlacement.CFX_MEM_PSRAM,
+}
+
+MEMORY_PLACEMENT_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_HOT, default="auto"): cv.enum(
+            MEMORY_PLACEMENTS, lower=True
+        ),
+        cv.Optional(CONF_COLD, default="auto"): cv.enum(
+            MEMORY_PLACEMENTS, lower=True
+        ),
+    }
+)
+
 RGB_ORDERS = {
     "RGB": RGBOrder.ORDER_RGB,
     "RBG": RGBOrder.ORDER_RBG,
@@ -278,6 +332,7 @@ PARALLEL_DC_PIN_DEFAULT = 21
 PARALLEL_PIN_SOURCE_AUTO = "auto"
 PARALLEL_PIN_SOURCE_USER = "user"
 _PARALLEL_PIN_RESOLUTION_KEY = "cfx_parallel_internal_pins"
+PARALLEL_BUS_WIDTH = 8
 
 _ESP32S3_PARALLEL_INTERNAL_PIN_CANDIDATES = (
     38, 39, 40, 41, 42, 47, 48,
@@ -387,6 +442,60 @@ def _power_sensors_schema(config):
             config[key] = merged
     return POWER_SENSORS_SCHEMA(config)
 
+_ACCOUNT_SENSORS_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_CURRENT): _ESTIMATED_CURRENT_SENSOR_SCHEMA,
+        cv.Optional(CONF_ENERGY): _ESTIMATED_ENERGY_SENSOR_SCHEMA,
+    }
+)
+
+
+def _account_sensors(label, config):
+    """Accounting sensor pair; names default to '<label> Current/Energy'."""
+    config = {} if config is None else dict(config)
+    for key, suffix in ((CONF_CURRENT, "Current"), (CONF_ENERGY, "Energy")):
+        if key in config:
+            sensor_conf = {} if config[key] is None else dict(config[key])
+            sensor_conf.setdefault(CONF_NAME, f"{label} {suffix}")
+            config[key] = sensor_conf
+    return _ACCOUNT_SENSORS_SCHEMA(config)
+
+
+def _effect_mode_id(value):
+    if isinstance(value, int):
+        return cv.int_range(min=0, max=254)(value)
+    name = cv.string_strict(value)
+    try:
+        from esphome.components.cfx_effect import CFX_EFFECTS
+    except ImportError:
+        CFX_EFFECTS = []
+    for group, effect_id, effect_name in CFX_EFFECTS:
+        if group != "sep" and effect_name.lower() == name.lower():
+            return effect_id
+    raise cv.Invalid(f"Unknown ChimeraFX effect '{name}'")
+
+
+def _mapping_or_none(value):
+    if value is None:
+        return {}
+    if isinstance(value, dict):
+        return value
+    raise cv.Invalid("expected a mapping")
+
+
+def _power_effect_account(config):
+    config = dict(_mapping_or_none(config))
+    if CONF_EFFECT not in config:
+        raise cv.Invalid("effect is required")
+    label = config.pop(CONF_EFFECT)
+    mode = _effect_mode_id(label)
+    sensors = _account_sensors(
+        label if isinstance(label, str) else f"Effect {mode}", config
+    )
+    sensors[CONF_EFFECT] = mode
+    return sensors
+
+
 POWER_MONITOR_SCHEMA = cv.Schema(
     {
         cv.Optional(CONF_UPDATE_INTERVAL, default="5s"): cv.positive_time_period_milliseconds,
@@ -402,6 +511,7 @@ POWER_MONITOR_SCHEMA = cv.Schema(
         cv.Optional(CONF_WHITE_CHANNEL_CURRENT_MA, default=20.0): _current_ma,
         cv.Optional(CONF_CONTROLLER_CURRENT_MA, default=120.0): _current_ma,
         cv.Optional(CONF_SENSORS, default={}): _power_sensors_schema,
+        cv.Optional(CONF_EFFECTS): cv.ensure_list(_power_effect_account),
     }
 )
 
@@ -418,12 +528,28 @@ def POWER_LIMIT_AUTO_SCHEMA(config):
     return _POWER_LIMIT_AUTO_SCHEMA(config)
 
 
+_POWER_FRAME_LIMITER_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_MAX_LOAD, default="95%"): cv.All(
+            cv.percentage, cv.Range(min=0.1, max=1.0)
+        ),
+    }
+)
+
+
+def POWER_FRAME_LIMITER_SCHEMA(config):
+    if config is None:
+        config = {}
+    return _POWER_FRAME_LIMITER_SCHEMA(config)
+
+
 _POWER_LIMIT_SCHEMA = cv.Schema(
     {
         cv.Optional(CONF_RESTORE, default=True): cv.boolean,
         cv.Optional(CONF_NAME, default="Power Reduction"): cv.string,
         cv.Optional(CONF_ICON, default="mdi:brightness-percent"): cv.icon,
         cv.Optional(CONF_AUTO): POWER_LIMIT_AUTO_SCHEMA,
+        cv.Optional(CONF_FRAME_LIMITER): POWER_FRAME_LIMITER_SCHEMA,
     }
 )
 
@@ -441,6 +567,209 @@ def POWER_LIMIT_SCHEMA(config):
     return _POWER_LIMIT_SCHEMA(config)
 
 
+# --- Layouts ---
+# C++ CFXLayoutType values (cfx_effect/cfx_layout.h).
+LAYOUT_TYPES = {"linear": 0, "matrix": 1, "folded": 2, "map": 3}
+_LAYOUT_SERPENTINE_FLAG = 1 << 0
+_LAYOUT_VERTICAL_FLAG = 1 << 1
+_LAYOUT_DESCRIPTORS_KEY = "cfx_light_layouts"
+
+LAYOUT_GAP_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_LAYOUT_GAP_START): cv.uint16_t,
+        cv.Optional(CONF_LAYOUT_GAP_COUNT, default=1): cv.int_range(
+            min=1, max=65535
+        ),
+    }
+)
+
+
+def _layout_type_default(config):
+    config = dict(config)
+    if CONF_LAYOUT_TYPE not in config:
+        if CONF_LAYOUT_MAP in config:
+            config[CONF_LAYOUT_TYPE] = "map"
+        elif CONF_LAYOUT_FOLDS in config:
+            config[CONF_LAYOUT_TYPE] = "folded"
+        elif CONF_LAYOUT_WIDTH in config or CONF_LAYOUT_HEIGHT in config:
+            config[CONF_LAYOUT_TYPE] = "matrix"
+        else:
+            config[CONF_LAYOUT_TYPE] = "linear"
+    return config
+
+
+LAYOUT_SCHEMA = cv.All(
+    _layout_type_default,
+    cv.Schema(
+        {
+            cv.Required(CONF_LAYOUT_TYPE): cv.one_of(*LAYOUT_TYPES, lower=True),
+            cv.Optional(CONF_LAYOUT_WIDTH): cv.int_range(min=1, max=65535),
+            cv.Optional(CONF_LAYOUT_HEIGHT): cv.int_range(min=1, max=65535),
+            cv.Optional(CONF_LAYOUT_SERPENTINE, default=False): cv.boolean,
+            cv.Optional(CONF_LAYOUT_VERTICAL, default=False): cv.boolean,
+            cv.Optional(CONF_LAYOUT_FOLDS): cv.int_range(min=2, max=255),
+            cv.Optional(CONF_LAYOUT_GAPS): cv.ensure_list(LAYOUT_GAP_SCHEMA),
+            cv.Optional(CONF_LAYOUT_MAP): cv.ensure_list(cv.uint16_t),
+        }
+    ),
+)
+
+
+def _validate_layout(layout, leds, label):
+    """Check a layout against the LED count of the run it describes."""
+    kind = layout[CONF_LAYOUT_TYPE]
+    width = layout.get(CONF_LAYOUT_WIDTH)
+    height = layout.get(CONF_LAYOUT_HEIGHT)
+    gaps = layout.get(CONF_LAYOUT_GAPS, [])
+
+    if kind != "matrix" and (
+        layout[CONF_LAYOUT_SERPENTINE] or layout[CONF_LAYOUT_VERTICAL]
+    ):
+        raise cv.Invalid(
+            f"{label}: 'serpentine' and 'vertical' only apply to a matrix layout"
+        )
+    if kind != "folded" and CONF_LAYOUT_FOLDS in layout:
+        raise cv.Invalid(f"{label}: 'folds' only applies to a folded layout")
+    if kind != "map" and CONF_LAYOUT_MAP in layout:
+        raise cv.Invalid(f"{label}: 'map' only applies to a map layout")
+    if kind in ("linear", "folded") and (width is not None or height is not None):
+        raise cv.Invalid(f"{label}: a {kind} layout has no width or height")
+
+    if kind == "map":
+        mapping = layout.get(CONF_LAYOUT_MAP)
+        if not mapping:
+            raise cv.Invalid(f"{label}: a map layout needs a 'map' list")
+        if gaps:
+            raise cv.Invalid(
+                f"{label}: a map layout lists its LEDs directly; drop 'gaps'"
+            )
+        for led in mapping:
+            if led >= leds:
+                raise cv.Invalid(
+                    f"{label}: map entry {led} is outside the {leds} LEDs"
+                )
+        if len(set(mapping)) != len(mapping):
+            raise cv.Invalid(f"{label}: map entries must be unique")
+        if (width is None) != (height is None):
+            raise cv.Invalid(f"{label}: a map layout needs both width and height")
+        if width is not None and width * height != len(mapping):
+            raise cv.Invalid(
+                f"{label}: map has {len(mapping)} entries, "
+                f"width x height is {width * height}"
+            )
+        return layout
+
+    dark = 0
+    covered_to = 0
+    for gap in sorted(gaps, key=lambda g: g[CONF_LAYOUT_GAP_START]):
+        start = gap[CONF_LAYOUT_GAP_START]
+        end = start + gap[CONF_LAYOUT_GAP_COUNT]
+        if end > leds:
+            raise cv.Invalid(
+                f"{label}: gap {start}+{gap[CONF_LAYOUT_GAP_COUNT]} runs past "
+                f"the {leds} LEDs"
+            )
+        if start < covered_to:
+            raise cv.Invalid(f"{label}: gaps overlap at LED {start}")
+        covered_to = end
+        dark += end - start
+    lit = leds - dark
+    if lit <= 0:
+        raise cv.Invalid(f"{label}: gaps leave no LEDs lit")
+
+    if kind == "matrix":
+        if width is None and height is None:
+            raise cv.Invalid(f"{label}: a matrix layout needs width or height")
+        side = width if width is not None else height
+        cells = width * height if width is not None and height is not None else None
+        if cells is not None and cells != lit:
+            raise cv.Invalid(
+                f"{label}: {width} x {height} matrix needs {cells} lit LEDs, "
+                f"the run has {lit} ({leds} minus {dark} in gaps)"
+            )
+        if cells is None and lit % side != 0:
+            raise cv.Invalid(
+                f"{label}: {lit} lit LEDs are not a whole number of "
+                f"{side}-LED lines"
+            )
+    elif kind == "folded":
+        folds = layout.get(CONF_LAYOUT_FOLDS)
+        if folds is None:
+            raise cv.Invalid(f"{label}: a folded layout needs 'folds'")
+        if lit % folds != 0:
+            raise cv.Invalid(
+                f"{label}: {lit} lit LEDs do not split into {folds} equal legs"
+            )
+    return layout
+
+
+def layout_descriptor(layout):
+    """Return `&<layout>` for this layout, emitting it on first use."""
+    gaps = sorted(
+        (g[CONF_LAYOUT_GAP_START], g[CONF_LAYOUT_GAP_COUNT])
+        for g in layout.get(CONF_LAYOUT_GAPS, [])
+    )
+    mapping = tuple(layout.get(CONF_LAYOUT_MAP, []))
+    flags = 0
+    if layout[CONF_LAYOUT_SERPENTINE]:
+        flags |= _LAYOUT_SERPENTINE_FLAG
+    if layout[CONF_LAYOUT_VERTICAL]:
+        flags |= _LAYOUT_VERTICAL_FLAG
+    key = (
+        LAYOUT_TYPES[layout[CONF_LAYOUT_TYPE]],
+        flags,
+        layout.get(CONF_LAYOUT_WIDTH, 0),
+        layout.get(CONF_LAYOUT_HEIGHT, 0),
+        layout.get(CONF_LAYOUT_FOLDS, 0),
+        tuple(gaps),
+        mapping,
+    )
+    layouts = CORE.data.setdefault(_LAYOUT_DESCRIPTORS_KEY, {})
+    var = layouts.get(key)
+    if var is not None:
+        return cg.RawExpression(f"&{var}")
+
+    var = f"cfx_layout_{len(layouts)}"
+    layouts[key] = var
+    gaps_ref = "nullptr"
+    if gaps:
+        gaps_ref = f"{var}_gaps"
+        cg.add_global(
+            cg.RawStatement(
+                f"static const esphome::chimera_fx::CFXLayoutGap {gaps_ref}[] = "
+                "{" + ", ".join(f"{{{start}, {count}}}" for start, count in gaps)
+                + "};"
+            )
+        )
+    map_ref = "nullptr"
+    if mapping:
+        map_ref = f"{var}_map"
+        cg.add_global(
+            cg.RawStatement(
+                f"static const uint16_t {map_ref}[] = "
+                "{" + ", ".join(str(led) for led in mapping) + "};"
+            )
+        )
+    fields = (
+        str(key[0]),
+        str(flags),
+        str(key[2]),
+        str(key[3]),
+        str(key[4]),
+        gaps_ref,
+        str(len(gaps)),
+        map_ref,
+        str(len(mapping)),
+    )
+    cg.add_global(
+        cg.RawStatement(
+            f"static const esphome::chimera_fx::CFXLayout {var} = "
+            "{" + ", ".join(fields) + "};"
+        )
+    )
+    return cg.RawExpression(f"&{var}")
+
+
 # --- Segment Schema & Validation (Phase 1) ---
 
 SEGMENT_SCHEMA = cv.Schema(
@@ -451,6 +780,7 @@ SEGMENT_SCHEMA = cv.Schema(
         cv.Required(CONF_SEGMENT_START): cv.uint16_t,
         cv.Required(CONF_SEGMENT_STOP): cv.uint16_t,
         cv.Optional(CONF_SEGMENT_MIRROR, default=False): cv.boolean,
+        cv.Optional(CONF_LAYOUT): LAYOUT_SCHEMA,
         cv.Optional(CONF_SEGMENT_USE_INTRO): cv.uint8_t,
         cv.Optional(CONF_SEGMENT_SET_INTRO): cv.uint8_t,
         cv.Optional(CONF_SEGMENT_USE_OUTRO): cv.uint8_t,
@@ -459,10 +789,49 @@ SEGMENT_SCHEMA = cv.Schema(
         cv.Optional(CONF_SEGMENT_SET_INOUT_DUR): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_SEGMENT_SET_BRIGHTNESS): cv.percentage,
         cv.Optional(CONF_SEGMENT_SET_COLOR): SET_COLOR_SCHEMA,
+        cv.Optional(CONF_POWER_SENSORS): _mapping_or_none,
     }
 )
 
-MAX_CFX_SEGMENTS = 4
+
+
+def _segment_power_sensors(config):
+    if CONF_POWER_SENSORS in config:
+        label = config.get(CONF_SEGMENT_NAME, str(config[CONF_SEGMENT_ID]))
+        config[CONF_POWER_SENSORS] = _account_sensors(
+            label, config[CONF_POWER_SENSORS]
+        )
+    return config
+
+
+# Segment runners per node (a light without segments runs one). Emitted as
+# the MAX_CFX_SEGMENTS define, which also sizes the C++ segment masks and the
+# data arena pool (cfx_effect/cfx_limits.h), so raise it only together with
+# CFXSegmentMask.
+MAX_CFX_SEGMENTS = 32
+
+# Realtime ingest protocols: C++ CFXRealtimeProtocol value, default UDP port
+# and default first universe (None for DDP, which addresses by pixel offset).
+REALTIME_PROTOCOLS = {
+    "ddp": (0, 4048, None),
+    "e131": (1, 5568, 1),
+    "artnet": (2, 6454, 0),
+}
+
+REALTIME_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_REALTIME_PROTOCOL, default="ddp"): cv.one_of(
+            *REALTIME_PROTOCOLS, lower=True
+        ),
+        cv.Optional(CONF_REALTIME_PORT): cv.port,
+        cv.Optional(CONF_REALTIME_OFFSET): cv.uint32_t,
+        cv.Optional(CONF_REALTIME_UNIVERSE): cv.int_range(min=0, max=63999),
+        cv.Optional(CONF_REALTIME_SEGMENT): cv.string,
+        cv.Optional(CONF_REALTIME_TIMEOUT, default="2500ms"): (
+            cv.positive_time_period_milliseconds
+        ),
+    }
+)
 
 
 _CFX_LIGHT_LIMITS_DEFAULT = {"total": 4, "spi": 2, "rmt": 4}
@@ -754,6 +1123,17 @@ def _ordered_parallel_groups(parallel_lights):
     return groups
 
 
+def _parallel_group_bit_offsets(groups):
+    # Groups pack onto the shared 8-bit bus back to back, so a single group can
+    # use every data line and two groups split whatever lanes they declare.
+    offsets = {}
+    bit_offset = 0
+    for group_name, group_lights in groups.items():
+        offsets[group_name] = bit_offset
+        bit_offset += len(group_lights)
+    return offsets
+
+
 def _resolve_parallel_s3_bus_pins(parallel_lights, root_config):
     store = CORE.data.setdefault(_PARALLEL_PIN_RESOLUTION_KEY, {})
     key = "__shared_s3_i80_bus__"
@@ -761,12 +1141,13 @@ def _resolve_parallel_s3_bus_pins(parallel_lights, root_config):
         return store[key]
 
     groups = _ordered_parallel_groups(parallel_lights)
-    bus_pins = [None] * 8
+    bus_pins = [None] * PARALLEL_BUS_WIDTH
     used_pins = _collect_declared_gpio_numbers(
         root_config, {CONF_PARALLEL_STROBE_PIN, CONF_PARALLEL_DC_PIN}
     )
-    for group_index, (group_name, group_lights) in enumerate(groups.items()):
-        bit_offset = group_index * 4
+    bit_offsets = _parallel_group_bit_offsets(groups)
+    for group_name, group_lights in groups.items():
+        bit_offset = bit_offsets[group_name]
         for lane_index, lconf in enumerate(group_lights):
             bus_pins[bit_offset + lane_index] = int(lconf[CONF_PIN][CONF_NUMBER])
 
@@ -1016,6 +1397,10 @@ def _validate_segments(config):
             raise cv.Invalid(
                 f"Segment '{seg_id}': stop ({stop}) exceeds num_leds ({num_leds})"
             )
+        if CONF_LAYOUT in seg:
+            _validate_layout(
+                seg[CONF_LAYOUT], stop - start, f"Segment '{seg_id}' layout"
+            )
         if seg_id in seen_ids:
             raise cv.Invalid(f"Duplicate segment id: '{seg_id}'")
         seen_ids.add(seg_id)
@@ -1035,6 +1420,29 @@ def _validate_segments(config):
     return config
 
 
+def _validate_light_layout(config):
+    """A light-level layout describes the whole strip of a plain light."""
+    if CONF_LAYOUT not in config:
+        return config
+    if config.get(CONF_SEGMENTS):
+        raise cv.Invalid(
+            f"'{CONF_LAYOUT}' on a light with segments is ambiguous; "
+            "set it on the segments instead"
+        )
+    _validate_layout(config[CONF_LAYOUT], config[CONF_NUM_LEDS], "Light layout")
+    return config
+
+
+def _validate_segment_runners(cfx_lights):
+    runners = sum(max(1, len(lconf.get(CONF_SEGMENTS, []))) for lconf in cfx_lights)
+    if runners > MAX_CFX_SEGMENTS:
+        raise cv.Invalid(
+            f"cfx_light entries on this node run {runners} segments in total "
+            f"(a light without segments counts as one); the limit is "
+            f"{MAX_CFX_SEGMENTS}"
+        )
+
+
 def _final_validate(config):
     fconf = full_config.get()
     all_lights = fconf.get_config_for_path(["light"])
@@ -1050,6 +1458,7 @@ def _final_validate(config):
         power_supplies,
         getattr(CORE, "raw_config", {}),
     )
+    _validate_segment_runners(cfx_lights)
     variant = _get_esp32_variant()
     limits = _get_cfx_light_limits(variant)
     spi_count = sum(1 for lconf in cfx_lights if _is_spi_cfx_light(lconf))
@@ -1101,7 +1510,14 @@ def _final_validate(config):
                 f"got {names}."
             )
 
-        max_parallel_lanes = 4
+        max_parallel_lanes = PARALLEL_BUS_WIDTH
+        total_lanes = sum(len(group_lights) for group_lights in groups.values())
+        if total_lanes > PARALLEL_BUS_WIDTH:
+            raise cv.Invalid(
+                f"cfx_light parallel groups declare {total_lanes} lanes in total; "
+                f"the shared {PARALLEL_BUS_WIDTH}-bit parallel bus carries at most "
+                f"{PARALLEL_BUS_WIDTH} lanes."
+            )
         for group_name, group_lights in groups.items():
             if len(group_lights) > max_parallel_lanes:
                 raise cv.Invalid(
@@ -1187,6 +1603,45 @@ def _config_has_white_channel(config):
     return config.get(CONF_CHIPSET) in RGBW_CHIPSETS
 
 
+def _realtime_segment_index(config):
+    realtime = config.get(CONF_REALTIME, {})
+    segment = realtime.get(CONF_REALTIME_SEGMENT)
+    if segment is None:
+        return -1
+    for index, seg in enumerate(config.get(CONF_SEGMENTS, [])):
+        if str(seg[CONF_SEGMENT_ID]) == segment:
+            return index
+    return None
+
+
+def _validate_realtime(config):
+    realtime = config.get(CONF_REALTIME)
+    if realtime is None:
+        return config
+    protocol = realtime[CONF_REALTIME_PROTOCOL]
+    if protocol == "ddp" and CONF_REALTIME_UNIVERSE in realtime:
+        raise cv.Invalid(
+            f"realtime '{CONF_REALTIME_UNIVERSE}' only applies to e131 and "
+            f"artnet; DDP addresses pixels with '{CONF_REALTIME_OFFSET}'."
+        )
+    if protocol != "ddp" and CONF_REALTIME_OFFSET in realtime:
+        raise cv.Invalid(
+            f"realtime '{CONF_REALTIME_OFFSET}' only applies to ddp; "
+            f"{protocol} addresses pixels with '{CONF_REALTIME_UNIVERSE}'."
+        )
+    universe = realtime.get(CONF_REALTIME_UNIVERSE)
+    if protocol == "e131" and universe == 0:
+        raise cv.Invalid("E1.31 universes start at 1.")
+    if protocol == "artnet" and universe is not None and universe > 32767:
+        raise cv.Invalid("Art-Net universes (Port-Address) end at 32767.")
+    if _realtime_segment_index(config) is None:
+        raise cv.Invalid(
+            f"realtime '{CONF_REALTIME_SEGMENT}' "
+            f"'{realtime[CONF_REALTIME_SEGMENT]}' is not a segment of this light."
+        )
+    return config
+
+
 def _validate_set_color(config):
     has_white_channel = _config_has_white_channel(config)
 
@@ -1299,6 +1754,8 @@ def _inject_all_effects(config):
         elif config.get(CONF_PARALLEL_GROUP):
             light_update_interval = "14ms"
 
+    adaptive_frame_rate = config.get(CONF_ADAPTIVE_FRAME_RATE, False)
+    particle_cap = config.get(CONF_PARTICLE_CAP)
     user_effects = list(config.get(CONF_EFFECTS, []))
     strip_tag = _cfx_event_tag(config.get(CONF_ID), config.get(CONF_NAME, ""))
 
@@ -1308,6 +1765,10 @@ def _inject_all_effects(config):
         eff_cfx = eff.get("addressable_cfx")
         if isinstance(eff_cfx, dict) and light_update_interval is not None:
             eff_cfx.setdefault(CONF_UPDATE_INTERVAL, light_update_interval)
+        if isinstance(eff_cfx, dict) and adaptive_frame_rate:
+            eff_cfx.setdefault(CONF_ADAPTIVE_FRAME_RATE, True)
+        if isinstance(eff_cfx, dict) and particle_cap is not None:
+            eff_cfx.setdefault(CONF_PARTICLE_CAP, particle_cap)
         if isinstance(eff_cfx, dict) and strip_tag:
             eff_cfx.setdefault("_cfx_strip_tag", strip_tag)
 
@@ -1360,11 +1821,16 @@ def _inject_all_effects(config):
     for (cat, eid, name) in CFX_EFFECTS:
         if name in user_names:
             continue
-        effect_data = {"effect_id": eid, CONF_NAME: name}
+        # Listed as a stub of the light's engine (see _register_effects()).
+        effect_data = {"effect_id": eid, CONF_NAME: name, "_cfx_stub": True}
         if strip_tag:
             effect_data["_cfx_strip_tag"] = strip_tag
         if light_update_interval is not None:
             effect_data[CONF_UPDATE_INTERVAL] = light_update_interval
+        if adaptive_frame_rate:
+            effect_data[CONF_ADAPTIVE_FRAME_RATE] = True
+        if particle_cap is not None:
+            effect_data[CONF_PARTICLE_CAP] = particle_cap
         if cat != "sep" and eid not in [158, 159, 161]:
             if use_intro is not None:
                 effect_data["set_intro"] = use_intro
@@ -1377,6 +1843,57 @@ def _inject_all_effects(config):
     config[CONF_EFFECTS] = user_effects
     return config
 
+async def _register_effects(light_state, config):
+    """List a whole-strip light's effects in YAML order. Registry entries
+    injected by _inject_all_effects() become stubs of one engine effect;
+    hand-configured entries keep their own effect objects."""
+    from esphome.components.light.effects import EFFECTS_REGISTRY
+    from esphome.core import ID as CoreID
+    from esphome.components.cfx_effect import (
+        CFXAddressableLightEffect, effect_descriptor, effect_display_name,
+        effect_engine, effect_stubs,
+    )
+
+    entries = config.get(CONF_EFFECTS, [])
+    stub_confs = [
+        eff["addressable_cfx"]
+        for eff in entries
+        if isinstance(eff.get("addressable_cfx"), dict)
+        and eff["addressable_cfx"].get("_cfx_stub", False)
+    ]
+    stubs = []
+    if stub_confs:
+        light_id = config[CONF_ID].id
+        engine_id = CoreID(
+            f"{light_id}_cfx_engine",
+            is_declaration=True,
+            type=CFXAddressableLightEffect,
+        )
+        # Injected entries share the light's cadence, cap and strip tag.
+        engine = effect_engine(engine_id, light_state, stub_confs[0])
+        stubs = effect_stubs(
+            engine,
+            f"{light_id}_cfx_stubs",
+            [
+                effect_descriptor(
+                    effect_display_name(conf), conf["effect_id"], conf
+                )
+                for conf in stub_confs
+            ],
+        )
+
+    stub_iter = iter(stubs)
+    effects = []
+    for eff in entries:
+        eff_cfx = eff.get("addressable_cfx")
+        if isinstance(eff_cfx, dict) and eff_cfx.get("_cfx_stub", False):
+            effects.append(next(stub_iter))
+        else:
+            effects.append(await cg.build_registry_entry(EFFECTS_REGISTRY, eff))
+    if effects:
+        cg.add(light_state.add_effects(effects))
+
+
 # Patch base schema to drop inherited default_transition_length so our 0ms default wins
 _base_schema = light.ADDRESSABLE_LIGHT_SCHEMA.schema.copy()
 _keys_to_drop = [k for k in _base_schema.keys() if str(k) == CONF_DEFAULT_TRANSITION_LENGTH or getattr(k, "key", None) == CONF_DEFAULT_TRANSITION_LENGTH]
@@ -1412,6 +1929,8 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_IS_RGBW): cv.boolean,
             cv.Optional(CONF_IS_WRGB, default=False): cv.boolean,
             cv.Optional(CONF_ALL_EFFECTS, default=True): cv.boolean,
+            cv.Optional(CONF_ADAPTIVE_FRAME_RATE, default=False): cv.boolean,
+            cv.Optional(CONF_PARTICLE_CAP): cv.int_range(min=4, max=1024),
             cv.Optional("use_intro"): cv.uint8_t,
             cv.Optional(CONF_SET_INTRO): cv.uint8_t,
             cv.Optional("use_outro"): cv.uint8_t,
@@ -1424,20 +1943,34 @@ CONFIG_SCHEMA = cv.All(
                 cv.positive_time_period_milliseconds
             ),
             cv.Optional(CONF_MAX_REFRESH_RATE): cv.positive_time_period_microseconds,
+            cv.Optional(CONF_KEEPALIVE_INTERVAL, default="1s"): (
+                cv.positive_time_period_milliseconds
+            ),
             cv.Optional(CONF_RMT_SYMBOLS, default=0): cv.uint32_t,
             cv.Optional(CONF_SACRIFICIAL_PIXEL, default=False): cv.boolean,
+            cv.Optional(CONF_ZERO_COPY, default=False): cv.boolean,
+            cv.Optional(CONF_MEMORY_PLACEMENT): MEMORY_PLACEMENT_SCHEMA,
             cv.Optional(CONF_VISUALIZER_IP): cv.string,
             cv.Optional(CONF_VISUALIZER_PORT, default=7777): cv.port,
+            cv.Optional(CONF_VISUALIZER_INTERVAL, default="50ms"): (
+                cv.positive_time_period_milliseconds
+            ),
+            cv.Optional(CONF_REALTIME): REALTIME_SCHEMA,
             cv.Optional(CONF_POWER_SUPPLY): cv.use_id(power_supply.PowerSupply),
             # Auto-controls (cfx_control entities generated from cfx_light)
             cv.Optional("controls", default=True): cv.boolean,
             cv.Optional("ctrl_exclude", default=[]): cv.ensure_list(cv.int_range(min=1, max=9)),
             # Segment definitions (Phase 1)
-            cv.Optional(CONF_SEGMENTS): cv.ensure_list(SEGMENT_SCHEMA),
+            cv.Optional(CONF_SEGMENTS): cv.ensure_list(
+                cv.All(SEGMENT_SCHEMA, _segment_power_sensors)
+            ),
+            cv.Optional(CONF_LAYOUT): LAYOUT_SCHEMA,
         }
     ).extend(cv.COMPONENT_SCHEMA),
     _validate_segments,  # Must run AFTER schema accepts the 'segments' key
+    _validate_light_layout,
     _validate_set_color,
+    _validate_realtime,
 )
 
 def _validate_transport(config):
@@ -1498,6 +2031,11 @@ def _validate_transport(config):
                 f"'{CONF_SACRIFICIAL_PIXEL}' is only supported by RMT chipsets "
                 f"(WS2812X, SK6812, WS2811)."
             )
+        if config.get(CONF_ZERO_COPY, False):
+            raise cv.Invalid(
+                f"'{CONF_ZERO_COPY}' is only supported by RMT chipsets "
+                f"(WS2812X, SK6812, WS2811)."
+            )
         return config
 
     else:
@@ -1529,6 +2067,12 @@ def _validate_transport(config):
                     f"in V1. Remove it from cfx_light entries using "
                     f"'{CONF_PARALLEL_GROUP}'."
                 )
+            if config.get(CONF_ZERO_COPY, False):
+                raise cv.Invalid(
+                    f"'{CONF_ZERO_COPY}' is only supported by legacy RMT. "
+                    f"Remove it from cfx_light entries using "
+                    f"'{CONF_PARALLEL_GROUP}'."
+                )
         else:
             if CONF_PARALLEL_STROBE_PIN in config:
                 raise cv.Invalid(
@@ -1848,6 +2392,16 @@ async def _ensure_power_manager():
             )
         )
 
+    if monitor_conf is not None and _power_sensor_configured():
+        for account in monitor_conf.get(CONF_EFFECTS, []):
+            current = cg.nullptr
+            if CONF_CURRENT in account:
+                current = await sensor.new_sensor(account[CONF_CURRENT])
+            energy = cg.nullptr
+            if CONF_ENERGY in account:
+                energy = await sensor.new_sensor(account[CONF_ENERGY])
+            cg.add(manager.add_effect_sensors(account[CONF_EFFECT], current, energy))
+
     limit_conf = _first_power_limit_config()
     if limit_conf is not None:
         cg.add(
@@ -1862,6 +2416,12 @@ async def _ensure_power_manager():
                     limit_conf[CONF_AUTO][CONF_SAFE_HOLD_TIME].total_milliseconds,
                 )
             )
+        if CONF_FRAME_LIMITER in limit_conf:
+            cg.add(
+                manager.configure_frame_limiter(
+                    limit_conf[CONF_FRAME_LIMITER][CONF_MAX_LOAD],
+                )
+            )
         reduction_id = core.ID(
             "cfx_power_reduction", is_declaration=True, type=CFXPowerReductionSelect
         )
@@ -1902,8 +2462,23 @@ async def _register_power_output(var, config):
         )
     )
 
+    if not _power_sensor_configured():
+        return
+    for seg_idx, seg in enumerate(config.get(CONF_SEGMENTS, [])):
+        sensors = seg.get(CONF_POWER_SENSORS)
+        if not sensors:
+            continue
+        current = cg.nullptr
+        if CONF_CURRENT in sensors:
+            current = await sensor.new_sensor(sensors[CONF_CURRENT])
+        energy = cg.nullptr
+        if CONF_ENERGY in sensors:
+            energy = await sensor.new_sensor(sensors[CONF_ENERGY])
+        cg.add(manager.add_zone_sensors(var, seg_idx, current, energy))
+
 
 async def to_code(config):
+    cg.add_define("MAX_CFX_SEGMENTS", MAX_CFX_SEGMENTS)
     var = cg.new_Pvariable(config[CONF_OUTPUT_ID])
     _LOGGER.debug(
         "CFXLight codegen: light_id=%s output_id=%s name=%s chipset=%s pin=%s",
@@ -1931,11 +2506,15 @@ async def to_code(config):
         cg.add(var.set_master_light_state(light_state))
         await cg.register_component(var, component_config)
     else:
-        # No segments: original single-light behavior
-        await light.register_light(var, light_config)
+        # No segments: original single-light behavior. Effects are listed by
+        # _register_effects() so registry entries can share one engine.
+        strip_config = dict(light_config)
+        strip_config[CONF_EFFECTS] = []
+        await light.register_light(var, strip_config)
         light_state = await cg.get_variable(config[CONF_ID])
         cg.add(var.set_master_light_state(light_state))
         await cg.register_component(var, component_config)
+        await _register_effects(light_state, config)
 
     # --- Hardware configuration (always) ---
     cg.add(var.set_num_leds(config[CONF_NUM_LEDS]))
@@ -1943,6 +2522,17 @@ async def to_code(config):
         supply = await cg.get_variable(config[CONF_POWER_SUPPLY])
         cg.add(var.set_power_supply(supply))
     cg.add(var.set_sacrificial_pixel(config[CONF_SACRIFICIAL_PIXEL]))
+    cg.add(var.set_zero_copy(config[CONF_ZERO_COPY]))
+    if CONF_MEMORY_PLACEMENT in config:
+        placement = config[CONF_MEMORY_PLACEMENT]
+        cg.add(
+            var.set_memory_placement(CFXMemClass.CFX_MEM_HOT, placement[CONF_HOT])
+        )
+        cg.add(
+            var.set_memory_placement(
+                CFXMemClass.CFX_MEM_COLD, placement[CONF_COLD]
+            )
+        )
     chipset_name = config[CONF_CHIPSET]
     cg.add(var.set_chipset(CHIPSETS[chipset_name]))
     
@@ -1996,7 +2586,11 @@ async def to_code(config):
         cg.add(var.set_parallel_lane_index(lane_index))
         cg.add(var.set_parallel_lane_count(len(lane_pins)))
         cg.add(var.set_parallel_group_index(group_index))
-        cg.add(var.set_parallel_bit_offset(group_index * 4))
+        cg.add(
+            var.set_parallel_bit_offset(
+                _parallel_group_bit_offsets(groups)[group_name]
+            )
+        )
         if _get_esp32_variant() == "ESP32S3":
             pin_resolution = _resolve_parallel_s3_bus_pins(
                 parallel_lights,
@@ -2123,6 +2717,7 @@ async def to_code(config):
 
     if CONF_MAX_REFRESH_RATE in config:
         cg.add(var.set_max_refresh_rate(config[CONF_MAX_REFRESH_RATE]))
+    cg.add(var.set_keepalive_interval(config[CONF_KEEPALIVE_INTERVAL]))
 
     await _register_power_output(var, config)
 
@@ -2132,12 +2727,49 @@ async def to_code(config):
     if CONF_VISUALIZER_IP in config:
         # Visualizer is an internal dev tool. Gated behind a build flag so
         # it compiles to zero code in production builds. The flag activates
-        # the sendto() path inside write_state() and the private fields.
+        # the snapshot handoff inside write_state() and the private fields.
         cg.add_build_flag("-DCFX_VISUALIZER_ENABLED")
         cg.add(var.set_visualizer_ip(config[CONF_VISUALIZER_IP]))
         cg.add(var.set_visualizer_port(config[CONF_VISUALIZER_PORT]))
+        cg.add(
+            var.set_visualizer_interval(
+                config[CONF_VISUALIZER_INTERVAL].total_milliseconds
+            )
+        )
         cg.add(var.set_visualizer_enabled(True))
 
+    if CONF_REALTIME in config:
+        # Realtime pixel ingest (DDP / E1.31 / Art-Net). Gated like the
+        # visualizer so lights without it carry no socket code.
+        realtime = config[CONF_REALTIME]
+        protocol_value, default_port, default_universe = REALTIME_PROTOCOLS[
+            realtime[CONF_REALTIME_PROTOCOL]
+        ]
+        if default_universe is None:
+            address = realtime.get(CONF_REALTIME_OFFSET, 0)
+        else:
+            address = realtime.get(CONF_REALTIME_UNIVERSE, default_universe)
+        segment_index = _realtime_segment_index(config)
+        if segment_index >= 0:
+            seg = segments[segment_index]
+            start = seg[CONF_SEGMENT_START]
+            count = seg[CONF_SEGMENT_STOP] - seg[CONF_SEGMENT_START]
+        else:
+            start = 0
+            count = config[CONF_NUM_LEDS]
+        cg.add_build_flag("-DCFX_REALTIME_ENABLED")
+        cg.add(
+            var.set_realtime(
+                protocol_value,
+                realtime.get(CONF_REALTIME_PORT, default_port),
+                address,
+                start,
+                count,
+                realtime[CONF_REALTIME_TIMEOUT].total_milliseconds,
+                segment_index,
+            )
+        )
+
     # --- Root-level intro/outro defaults ---
     if "use_intro" in config:
         cg.add(var.set_default_intro_mode(config["use_intro"]))
@@ -2149,6 +2781,9 @@ async def to_code(config):
         cg.add(var.set_default_intro_dur(intro_dur_s))
         cg.add(var.set_default_outro_dur(intro_dur_s))
 
+    if CONF_LAYOUT in config:
+        cg.add(var.set_layout(layout_descriptor(config[CONF_LAYOUT])))
+
     # --- Segment codegen ---
     for seg_idx, seg in enumerate(segments):
         seg_id_obj = seg[CONF_SEGMENT_ID]
@@ -2172,6 +2807,10 @@ async def to_code(config):
                 seg_intro, seg_outro, seg_intro_dur, seg_intro_dur
             )
         )
+        if CONF_LAYOUT in seg:
+            cg.add(
+                var.set_segment_layout(seg_idx, layout_descriptor(seg[CONF_LAYOUT]))
+            )
 
         # Phase 2: Create virtual segment light + independent LightState.
         # The LightState remains the HA/control shell, but active CFX segment
@@ -2221,65 +2860,50 @@ async def to_code(config):
                     )
                 )
 
-        # ── Stub + Singleton pattern (CFX-058) ──────────────────────────────
+        # ── Stub + engine pattern (CFX-058) ─────────────────────────────────
         # Instead of creating 81 full CFXAddressableLightEffect objects per
-        # segment (~60 B each = 4.9 KB), we create ONE real singleton effect
-        # and 81 lightweight CFXEffectStub proxies (~36 B each).
-        # Saves ~2.2 KB per segment (37% heap reduction).
+        # segment (~60 B each = 4.9 KB), we create ONE engine effect and a
+        # static array of CFXEffectStub entries that point at shared
+        # CFXEffectDescriptor records.
         from esphome.core import ID as CoreID
         from esphome.components.cfx_effect import (
-            cfx_effect_to_code, CFXAddressableLightEffect, CFXEffectStub,
-            CFX_EFFECT_NAMES,
+            CFXAddressableLightEffect, effect_descriptor, effect_display_name,
+            effect_engine, effect_stubs,
         )
 
         parent_id = config[CONF_ID].id
 
-        # Phase 1: Create the singleton — one real effect per segment.
-        # This is the only object that allocates CFXActivation + CFXRunner.
-        singleton_str = f"{parent_id}_cfx_singleton_s{seg_idx}"
-        singleton_id = CoreID(
-            singleton_str, is_declaration=True, type=CFXAddressableLightEffect
+        # The engine is the only object that allocates CFXActivation +
+        # CFXRunner for the segment.
+        engine_id = CoreID(
+            f"{parent_id}_cfx_engine_s{seg_idx}",
+            is_declaration=True,
+            type=CFXAddressableLightEffect,
         )
-        singleton_var = cg.new_Pvariable(singleton_id, "CFX Segment Singleton")
-        cg.add(singleton_var.set_virtual_segment(True))
+        engine = effect_engine(engine_id, light_state)
+        cg.add(engine.set_virtual_segment(True))
         seg_tag = _cfx_event_tag(
             seg[CONF_SEGMENT_ID],
             seg.get(CONF_SEGMENT_NAME, ""),
         )
         if seg_tag:
-            cg.add(singleton_var.set_strip_tag(seg_tag))
+            cg.add(engine.set_strip_tag(seg_tag))
 
-        # Ensure the stub header is included in the generated C++ output
-        cg.add_global(
-            cg.RawExpression(
-                '#include "esphome/components/cfx_effect/cfx_effect_stub.h"\n'
-            )
-        )
-
-        # Phase 2: Create lightweight stubs for the HA effect dropdown.
-        effect_vars = []
-        for eff_idx, eff in enumerate(config.get(CONF_EFFECTS, [])):
-            if not isinstance(eff, dict):
-                continue
-            if "addressable_cfx" not in eff:
+        # Stubs carry no presets; the descriptor is shared with every other
+        # light listing the same bare entry.
+        descriptors = []
+        for eff in config.get(CONF_EFFECTS, []):
+            if not isinstance(eff, dict) or "addressable_cfx" not in eff:
                 continue
-
             eff_conf = eff["addressable_cfx"]
-            eff_num = eff_conf.get("effect_id", 0)
-
-            # Resolve the display name (same logic as cfx_effect_to_code)
-            name = eff_conf.get(CONF_NAME, "CFX Effect")
-            if name == "CFX Effect" and eff_num in CFX_EFFECT_NAMES:
-                name = CFX_EFFECT_NAMES[eff_num]
-
-            stub_str = f"{parent_id}_cfx_stub_s{seg_idx}_e{eff_num}_{eff_idx}"
-            stub_id = CoreID(
-                stub_str, is_declaration=True, type=CFXEffectStub
-            )
-            stub_var = cg.new_Pvariable(
-                stub_id, name, eff_num, singleton_var
+            descriptors.append(
+                effect_descriptor(
+                    effect_display_name(eff_conf), eff_conf.get("effect_id", 0)
+                )
             )
-            effect_vars.append(stub_var)
+        effect_vars = effect_stubs(
+            engine, f"{parent_id}_cfx_stubs_s{seg_idx}", descriptors
+        )
 
         if effect_vars:
             cg.add(light_state.add_effects(effect_vars))
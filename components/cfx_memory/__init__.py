@@ -0,0 +1,92 @@
+"""ChimeraFX memory accounting.
+
+Publishes the heap held by each ChimeraFX subsystem (output buffers, effect
+data arenas, activations and snapshots, sync groups, sequences, the event
+queue) next to the internal and PSRAM free/largest-block figures. Owners are
+asked on every update; nothing is counted on the allocation path.
+"""
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID
+from esphome.core import CORE
+
+CODEOWNERS = ["@effelle"]
+DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["cfx_effect", "sensor"]
+
+cfx_memory_ns = cg.esphome_ns.namespace("cfx_memory")
+CFXMemoryComponent = cfx_memory_ns.class_(
+    "CFXMemoryComponent", cg.PollingComponent
+)
+
+CONF_OUTPUT_BUFFERS = "output_buffers"
+CONF_EFFECT_ARENAS = "effect_arenas"
+CONF_ACTIVATIONS = "activations"
+CONF_SYNC = "sync"
+CONF_SEQUENCES = "sequences"
+CONF_EVENTS = "events"
+CONF_TOTAL = "total"
+CONF_INTERNAL_FREE = "internal_free"
+CONF_INTERNAL_LARGEST_BLOCK = "internal_largest_block"
+CONF_PSRAM_FREE = "psram_free"
+CONF_PSRAM_LARGEST_BLOCK = "psram_largest_block"
+
+_BYTES_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement="B",
+    icon="mdi:memory",
+    accuracy_decimals=0,
+    device_class="data_size",
+    state_class="measurement",
+    entity_category="diagnostic",
+)
+
+# (yaml key, C++ setter)
+_SENSORS = (
+    (CONF_OUTPUT_BUFFERS, "set_output_buffers_sensor"),
+    (CONF_EFFECT_ARENAS, "set_effect_arenas_sensor"),
+    (CONF_ACTIVATIONS, "set_activations_sensor"),
+    (CONF_SYNC, "set_sync_sensor"),
+    (CONF_SEQUENCES, "set_sequences_sensor"),
+    (CONF_EVENTS, "set_events_sensor"),
+    (CONF_TOTAL, "set_total_sensor"),
+    (CONF_INTERNAL_FREE, "set_internal_free_sensor"),
+    (CONF_INTERNAL_LARGEST_BLOCK, "set_internal_largest_block_sensor"),
+    (CONF_PSRAM_FREE, "set_psram_free_sensor"),
+    (CONF_PSRAM_LARGEST_BLOCK, "set_psram_largest_block_sensor"),
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(CFXMemoryComponent),
+        **{cv.Optional(key): _BYTES_SCHEMA for key, _ in _SENSORS},
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    for key, setter in _SENSORS:
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
+
+    # Every cfx_light output and cfx_sync group reports its own share.
+    for lconf in CORE.config.get("light", []):
+        if lconf.get("platform", "") != "cfx_light":
+            continue
+        output_id = lconf.get("output_id")
+        if output_id is None:
+            continue
+        output = await cg.get_variable(output_id)
+        cg.add(var.add_output(output))
+
+    for sconf in CORE.config.get("cfx_sync", []):
+        sync_id = sconf.get(CONF_ID)
+        if sync_id is None:
+            continue
+        sync = await cg.get_variable(sync_id)
+        cg.add(var.add_sync(sync))
@@ -0,0 +1,102 @@
+/*
+ * ChimeraFX — Memory accounting component implementation
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ */
+
+#include "cfx_memory_component.h"
+#include "../cfx_effect/cfx_addressable_light_effect.h"
+#include "../cfx_effect/cfx_data_arena.h"
+#include "../cfx_effect/cfx_event_manager.h"
+#ifdef USE_CFX_SEQUENCE
+#include "../cfx_sequence/cfx_sequence.h"
+#endif
+#include "esphome/core/log.h"
+
+#include <esp_heap_caps.h>
+
+namespace esphome {
+namespace cfx_memory {
+
+static const char *const TAG = "cfx_memory";
+
+static constexpr uint32_t CAPS_INTERNAL = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+static constexpr uint32_t CAPS_PSRAM = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+
+static void publish_bytes(sensor::Sensor *s, size_t bytes) {
+  if (s != nullptr)
+    s->publish_state((float)bytes);
+}
+
+CFXMemoryComponent::Usage CFXMemoryComponent::collect_() const {
+  Usage usage;
+#if CFX_MEMORY_HAS_CFX_LIGHT
+  for (auto *output : this->outputs_) {
+    const auto &budget = output->get_memory_budget();
+    usage.output_buffers += budget.class_bytes(cfx_light::CFX_MEM_DMA) +
+                            budget.class_bytes(cfx_light::CFX_MEM_ISR) +
+                            budget.class_bytes(cfx_light::CFX_MEM_HOT);
+    // Transition planes and visualizer snapshots are the COLD class.
+    usage.activations += budget.class_bytes(cfx_light::CFX_MEM_COLD);
+  }
+#endif
+  usage.effect_arenas = chimera_fx::CFXDataArenaPool::get().reserved_bytes();
+  usage.activations +=
+      chimera_fx::CFXAddressableLightEffect::activation_bytes();
+#if CFX_MEMORY_HAS_CFX_SYNC
+  for (auto *sync : this->syncs_)
+    usage.sync += sync->memory_bytes();
+  // Every group shares the one bus; count its ring once.
+  if (!this->syncs_.empty())
+    usage.sync += cfx_sync::global_cfx_sync_bus().rx_ring_bytes();
+#endif
+#ifdef USE_CFX_SEQUENCE
+  usage.sequences = cfx_sequence::CFXRunPool::get().memory_bytes();
+#endif
+  usage.events = chimera_fx::CFXEventManager::get().memory_bytes();
+  return usage;
+}
+
+void CFXMemoryComponent::update() {
+  const Usage usage = this->collect_();
+  publish_bytes(this->output_buffers_, usage.output_buffers);
+  publish_bytes(this->effect_arenas_, usage.effect_arenas);
+  publish_bytes(this->activations_, usage.activations);
+  publish_bytes(this->sync_, usage.sync);
+  publish_bytes(this->sequences_, usage.sequences);
+  publish_bytes(this->events_, usage.events);
+  publish_bytes(this->total_, usage.total());
+
+  publish_bytes(this->internal_free_, heap_caps_get_free_size(CAPS_INTERNAL));
+  publish_bytes(this->internal_largest_block_,
+                heap_caps_get_largest_free_block(CAPS_INTERNAL));
+  publish_bytes(this->psram_free_, heap_caps_get_free_size(CAPS_PSRAM));
+  publish_bytes(this->psram_largest_block_,
+                heap_caps_get_largest_free_block(CAPS_PSRAM));
+}
+
+void CFXMemoryComponent::dump_config() {
+  const Usage usage = this->collect_();
+  ESP_LOGCONFIG(TAG, "ChimeraFX Memory:");
+  LOG_UPDATE_INTERVAL(this);
+  ESP_LOGCONFIG(TAG,
+                "  Now: outputs=%u B arenas=%u B activations=%u B sync=%u B "
+                "sequences=%u B events=%u B",
+                (unsigned)usage.output_buffers, (unsigned)usage.effect_arenas,
+                (unsigned)usage.activations, (unsigned)usage.sync,
+                (unsigned)usage.sequences, (unsigned)usage.events);
+  LOG_SENSOR("  ", "Output buffers", this->output_buffers_);
+  LOG_SENSOR("  ", "Effect arenas", this->effect_arenas_);
+  LOG_SENSOR("  ", "Activations", this->activations_);
+  LOG_SENSOR("  ", "Sync", this->sync_);
+  LOG_SENSOR("  ", "Sequences", this->sequences_);
+  LOG_SENSOR("  ", "Events", this->events_);
+  LOG_SENSOR("  ", "Total", this->total_);
+  LOG_SENSOR("  ", "Internal free", this->internal_free_);
+  LOG_SENSOR("  ", "Internal largest block", this->internal_largest_block_);
+  LOG_SENSOR("  ", "PSRAM free", this->psram_free_);
+  LOG_SENSOR("  ", "PSRAM largest block", this->psram_largest_block_);
+}
+
+} // namespace cfx_memory
+} // namespace esphome
@@ -0,0 +1,106 @@
+/*
+ * ChimeraFX — Memory accounting component
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Publishes the heap each ChimeraFX subsystem holds, in bytes, next to the
+ * internal and PSRAM free/largest-block figures. Nothing is counted on the
+ * allocation path: every update() asks the owners what they hold (output
+ * budgets, the arena pool, the activation pool, sync groups, the run pool
+ * and the event manager), so the sensors cost only their own polling.
+ * Figures for std containers count capacity; map nodes are estimated.
+ */
+
+#pragma once
+
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+
+#if __has_include("../cfx_light/cfx_light.h")
+#include "../cfx_light/cfx_light.h"
+#define CFX_MEMORY_HAS_CFX_LIGHT 1
+#else
+#define CFX_MEMORY_HAS_CFX_LIGHT 0
+#endif
+#if __has_include("../cfx_sync/cfx_sync.h")
+#include "../cfx_sync/cfx_sync.h"
+#define CFX_MEMORY_HAS_CFX_SYNC 1
+#else
+#define CFX_MEMORY_HAS_CFX_SYNC 0
+#endif
+
+#include <vector>
+
+namespace esphome {
+namespace cfx_memory {
+
+class CFXMemoryComponent : public PollingComponent {
+public:
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::LATE; }
+
+#if CFX_MEMORY_HAS_CFX_LIGHT
+  void add_output(cfx_light::CFXLightOutput *output) {
+    outputs_.push_back(output);
+  }
+#endif
+#if CFX_MEMORY_HAS_CFX_SYNC
+  void add_sync(cfx_sync::CFXSyncComponent *sync) { syncs_.push_back(sync); }
+#endif
+
+  void set_output_buffers_sensor(sensor::Sensor *s) { output_buffers_ = s; }
+  void set_effect_arenas_sensor(sensor::Sensor *s) { effect_arenas_ = s; }
+  void set_activations_sensor(sensor::Sensor *s) { activations_ = s; }
+  void set_sync_sensor(sensor::Sensor *s) { sync_ = s; }
+  void set_sequences_sensor(sensor::Sensor *s) { sequences_ = s; }
+  void set_events_sensor(sensor::Sensor *s) { events_ = s; }
+  void set_total_sensor(sensor::Sensor *s) { total_ = s; }
+  void set_internal_free_sensor(sensor::Sensor *s) { internal_free_ = s; }
+  void set_internal_largest_block_sensor(sensor::Sensor *s) {
+    internal_largest_block_ = s;
+  }
+  void set_psram_free_sensor(sensor::Sensor *s) { psram_free_ = s; }
+  void set_psram_largest_block_sensor(sensor::Sensor *s) {
+    psram_largest_block_ = s;
+  }
+
+protected:
+  // Bytes per subsystem, gathered in one pass so total matches the parts.
+  struct Usage {
+    size_t output_buffers{0};
+    size_t effect_arenas{0};
+    size_t activations{0};
+    size_t sync{0};
+    size_t sequences{0};
+    size_t events{0};
+    size_t total() const {
+      return output_buffers + effect_arenas + activations + sync + sequences +
+             events;
+    }
+  };
+  Usage collect_() const;
+
+#if CFX_MEMORY_HAS_CFX_LIGHT
+  std::vector<cfx_light::CFXLightOutput *> outputs_;
+#endif
+#if CFX_MEMORY_HAS_CFX_SYNC
+  std::vector<cfx_sync::CFXSyncComponent *> syncs_;
+#endif
+
+  sensor::Sensor *output_buffers_{nullptr};
+  sensor::Sensor *effect_arenas_{nullptr};
+  sensor::Sensor *activations_{nullptr};
+  sensor::Sensor *sync_{nullptr};
+  sensor::Sensor *sequences_{nullptr};
+  sensor::Sensor *events_{nullptr};
+  sensor::Sensor *total_{nullptr};
+  sensor::Sensor *internal_free_{nullptr};
+  sensor::Sensor *internal_largest_block_{nullptr};
+  sensor::Sensor *psram_free_{nullptr};
+  sensor::Sensor *psram_largest_block_{nullptr};
+};
+
+} // namespace cfx_memory
+} // namespace esphome
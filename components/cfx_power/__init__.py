@@ -4,6 +4,7 @@ import esphome.config_validation as cv
 
 from esphome.components.cfx_light.light import (
     CONF_AUTO,
+    CONF_FRAME_LIMITER,
     CONF_LIMIT,
     CONF_MONITOR,
     CONF_PSU_CURRENT_LIMIT,
@@ -18,12 +19,14 @@ AUTO_LOAD = ["sensor", "select", "text_sensor"]
 
 def _validate_power_config(config):
     limit = config.get(CONF_LIMIT) or {}
-    if CONF_AUTO in limit:
+    for key in (CONF_AUTO, CONF_FRAME_LIMITER):
+        if key not in limit:
+            continue
         if CONF_MONITOR not in config:
-            raise cv.Invalid("cfx_power.limit.auto requires cfx_power.monitor")
+            raise cv.Invalid(f"cfx_power.limit.{key} requires cfx_power.monitor")
         if config[CONF_MONITOR].get(CONF_PSU_CURRENT_LIMIT, 0.0) <= 0.0:
             raise cv.Invalid(
-                "cfx_power.limit.auto requires monitor.psu_current_limit"
+                f"cfx_power.limit.{key} requires monitor.psu_current_limit"
             )
     return config
 
@@ -0,0 +1,151 @@
+"""ChimeraFX render cost profiler.
+
+Enables per-mode ns/LED and per-stage µs histograms in the runner and
+publishes their percentiles as sensors. With `trace:` it also records a
+per-frame pipeline timeline that can be dumped as Chrome trace JSON. Leave it
+out of production builds: without this component the recording hooks are not
+compiled at all.
+"""
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, text_sensor
+from esphome.const import CONF_ID, CONF_PORT
+from esphome.core import CORE, ID
+
+CODEOWNERS = ["@effelle"]
+DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["cfx_effect", "sensor", "text_sensor"]
+
+cfx_profiler_ns = cg.esphome_ns.namespace("cfx_profiler")
+CFXProfilerComponent = cfx_profiler_ns.class_(
+    "CFXProfilerComponent", cg.PollingComponent
+)
+CFXProfilerServiceHandler = cfx_profiler_ns.class_(
+    "CFXProfilerServiceHandler", cg.Component
+)
+
+CONF_WORST_MODE_P99 = "worst_mode_p99"
+CONF_LAST_MODE_P50 = "last_mode_p50"
+CONF_LAST_MODE_P99 = "last_mode_p99"
+CONF_RENDER_P99 = "render_p99"
+CONF_INOUT_P99 = "inout_p99"
+CONF_COORDINATOR_P99 = "coordinator_p99"
+CONF_COPY_P99 = "copy_p99"
+CONF_DMA_WAIT_P99 = "dma_wait_p99"
+CONF_CORE0_LOAD = "core0_load"
+CONF_CORE1_LOAD = "core1_load"
+CONF_CORE_IMBALANCE = "core_imbalance"
+CONF_DEGRADED_FRAMES = "degraded_frames"
+CONF_RUNNER_DEGRADED_FRAMES = "runner_degraded_frames"
+CONF_SUMMARY = "summary"
+CONF_LOG_ON_UPDATE = "log_on_update"
+CONF_TRACE = "trace"
+CONF_UDP_HOST = "udp_host"
+
+_NS_PER_LED_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement="ns/LED",
+    icon="mdi:timer-outline",
+    accuracy_decimals=0,
+    state_class="measurement",
+)
+
+_STAGE_US_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement="µs",
+    icon="mdi:timer-sand",
+    accuracy_decimals=0,
+    state_class="measurement",
+)
+
+_PERCENT_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement="%",
+    icon="mdi:chip",
+    accuracy_decimals=0,
+    state_class="measurement",
+)
+
+_FRAMES_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement="frames",
+    icon="mdi:speedometer-slow",
+    accuracy_decimals=0,
+    state_class="total_increasing",
+)
+
+# (yaml key, C++ setter, schema)
+_SENSORS = (
+    (CONF_WORST_MODE_P99, "set_worst_mode_p99_sensor", _NS_PER_LED_SCHEMA),
+    (CONF_LAST_MODE_P50, "set_last_mode_p50_sensor", _NS_PER_LED_SCHEMA),
+    (CONF_LAST_MODE_P99, "set_last_mode_p99_sensor", _NS_PER_LED_SCHEMA),
+    (CONF_RENDER_P99, "set_render_p99_sensor", _STAGE_US_SCHEMA),
+    (CONF_INOUT_P99, "set_inout_p99_sensor", _STAGE_US_SCHEMA),
+    (CONF_COORDINATOR_P99, "set_coordinator_p99_sensor", _STAGE_US_SCHEMA),
+    (CONF_COPY_P99, "set_copy_p99_sensor", _STAGE_US_SCHEMA),
+    (CONF_DMA_WAIT_P99, "set_dma_wait_p99_sensor", _STAGE_US_SCHEMA),
+    (CONF_CORE0_LOAD, "set_core0_load_sensor", _PERCENT_SCHEMA),
+    (CONF_CORE1_LOAD, "set_core1_load_sensor", _PERCENT_SCHEMA),
+    (CONF_CORE_IMBALANCE, "set_core_imbalance_sensor", _PERCENT_SCHEMA),
+    (CONF_DEGRADED_FRAMES, "set_degraded_frames_sensor", _FRAMES_SCHEMA),
+    (
+        CONF_RUNNER_DEGRADED_FRAMES,
+        "set_runner_degraded_frames_sensor",
+        _FRAMES_SCHEMA,
+    ),
+)
+
+# Without udp_host, cfx_trace_dump writes the JSON to the log.
+TRACE_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_UDP_HOST): cv.string,
+        cv.Optional(CONF_PORT, default=7778): cv.port,
+    }
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(CFXProfilerComponent),
+        cv.Optional(CONF_LOG_ON_UPDATE, default=False): cv.boolean,
+        cv.Optional(CONF_TRACE): TRACE_SCHEMA,
+        cv.Optional(CONF_SUMMARY): text_sensor.text_sensor_schema(
+            icon="mdi:chart-histogram",
+        ),
+        **{cv.Optional(key): schema for key, _, schema in _SENSORS},
+    }
+).extend(cv.polling_component_schema("10s"))
+
+
+async def to_code(config):
+    cg.add_define("USE_CFX_PROFILER")
+
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_log_on_update(config[CONF_LOG_ON_UPDATE]))
+
+    if CONF_TRACE in config:
+        cg.add_define("USE_CFX_TRACE")
+        trace = config[CONF_TRACE]
+        if CONF_UDP_HOST in trace:
+            cg.add(var.set_trace_udp(trace[CONF_UDP_HOST], trace[CONF_PORT]))
+
+    for key, setter, _ in _SENSORS:
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
+
+    if CONF_SUMMARY in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_SUMMARY])
+        cg.add(var.set_summary_text_sensor(sens))
+
+    # HA services: cfx_profiler_dump / cfx_profiler_reset, plus
+    # cfx_trace_dump / cfx_trace_reset with trace:
+    if "api" in CORE.config:
+        cg.add_define("USE_API_USER_DEFINED_ACTIONS")
+        cg.add_define("USE_API_CUSTOM_SERVICES")
+        svc_id = ID(
+            "cfx_profiler_service_handler",
+            is_declaration=True,
+            type=CFXProfilerServiceHandler,
+        )
+        svc_var = cg.new_Pvariable(svc_id)
+        CORE.component_ids.add("cfx_profiler_service_handler")
+        await cg.register_component(svc_var, {})
+        cg.add(svc_var.set_parent(var))
@@ -0,0 +1,266 @@
+/*
+ * ChimeraFX — Render cost profiler component implementation
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ */
+
+#include "cfx_profiler_component.h"
+#include "../cfx_effect/cfx_profiler.h"
+#include "../cfx_effect/cfx_scheduler.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_CFX_TRACE
+#include "../cfx_effect/cfx_trace.h"
+#include <lwip/inet.h>
+#include <lwip/sockets.h>
+#include <cerrno>
+#include <unistd.h>
+// cfx_sync does not depend on cfx_effect; it reports packets through a hook.
+#if __has_include("../cfx_sync/cfx_sync_bus.h")
+#include "../cfx_sync/cfx_sync_bus.h"
+#define CFX_PROFILER_HAS_CFX_SYNC 1
+#else
+#define CFX_PROFILER_HAS_CFX_SYNC 0
+#endif
+#endif
+
+namespace esphome {
+namespace cfx_profiler {
+
+static const char *const TAG = "cfx_profiler";
+
+#ifdef USE_CFX_TRACE
+static constexpr uint32_t TRACE_SEND_ATTEMPTS = 5;
+static constexpr uint32_t TRACE_SEND_BACKOFF_MS = 4;
+#endif
+
+using chimera_fx::CFXProfiler;
+using chimera_fx::CFXProfileStage;
+
+static void publish_stage_p99(sensor::Sensor *s, CFXProfileStage stage) {
+  if (s == nullptr)
+    return;
+  const auto &h = CFXProfiler::get().stage(stage);
+  if (h.count() == 0)
+    return;
+  s->publish_state((float)h.percentile(0.99f));
+}
+
+void CFXProfilerComponent::setup() {
+  CFXProfiler::get().set_enabled(true);
+#ifdef USE_CFX_TRACE
+  chimera_fx::CFXTrace::get().set_enabled(true);
+#if CFX_PROFILER_HAS_CFX_SYNC
+  cfx_sync::global_cfx_sync_bus().set_packet_observer([](bool tx, uint16_t arg) {
+    chimera_fx::CFXTrace::get().instant(
+        tx ? chimera_fx::CFX_TRACE_SYNC_TX : chimera_fx::CFX_TRACE_SYNC_RX, arg);
+  });
+#endif
+#endif
+}
+
+#ifdef USE_CFX_TRACE
+void CFXProfilerComponent::dump_trace() {
+  using chimera_fx::CFXTrace;
+  if (this->trace_host_.empty()) {
+    // One chunk per line; strip the log prefixes and join them to load it.
+    ESP_LOGI(TAG, "Trace begin (Chrome trace JSON):");
+    const size_t n = CFXTrace::get().export_json(
+        [](const char *data, size_t len, void *) {
+          ESP_LOGI(TAG, "%.*s", (int)len, data);
+          return true;
+        },
+        nullptr, 256);
+    ESP_LOGI(TAG, "Trace end: %u events", (unsigned)n);
+    return;
+  }
+
+  struct sockaddr_in dest {};
+  dest.sin_family = AF_INET;
+  dest.sin_port = htons(this->trace_port_);
+  if (::inet_aton(this->trace_host_.c_str(), &dest.sin_addr) == 0) {
+    ESP_LOGW(TAG, "Trace: '%s' is not an IPv4 address",
+             this->trace_host_.c_str());
+    return;
+  }
+  const int fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+  if (fd < 0) {
+    ESP_LOGW(TAG, "Trace: socket() failed");
+    return;
+  }
+  struct UdpSink {
+    int fd;
+    const struct sockaddr_in *dest;
+    uint32_t sent;
+    uint32_t retries;
+    int error;
+  } sink{fd, &dest, 0, 0, 0};
+  // Blocking sends: a dump is a one-off service call, and a dropped chunk
+  // would leave the receiver with broken JSON. lwIP fails a send when it is
+  // out of buffers, so back off and retry before giving up on the dump.
+  const size_t n = CFXTrace::get().export_json(
+      [](const char *data, size_t len, void *ctx) {
+        auto *s = static_cast<UdpSink *>(ctx);
+        for (uint32_t attempt = 0; attempt < TRACE_SEND_ATTEMPTS; attempt++) {
+          if (attempt > 0) {
+            s->retries++;
+            delay(attempt * TRACE_SEND_BACKOFF_MS);
+          }
+          if (::sendto(s->fd, data, len, 0,
+                       reinterpret_cast<const struct sockaddr *>(s->dest),
+                       sizeof(*s->dest)) >= 0) {
+            s->sent++;
+            s->error = 0;
+            return true;
+          }
+          s->error = errno != 0 ? errno : EIO;
+        }
+        return false;
+      },
+      &sink, 1024);
+  ::close(fd);
+  if (sink.error != 0) {
+    // The sink stops the export at the first chunk it cannot send.
+    ESP_LOGE(TAG,
+             "Trace: sendto() to %s:%u failed after %u tries (errno %d); "
+             "dump stopped after %u datagrams, the JSON is incomplete",
+             this->trace_host_.c_str(), (unsigned)this->trace_port_,
+             (unsigned)TRACE_SEND_ATTEMPTS, sink.error, (unsigned)sink.sent);
+    return;
+  }
+  ESP_LOGI(TAG, "Trace: %u events in %u datagrams to %s:%u (%u retries)",
+           (unsigned)n, (unsigned)sink.sent, this->trace_host_.c_str(),
+           (unsigned)this->trace_port_, (unsigned)sink.retries);
+}
+#endif
+
+void CFXProfilerComponent::update() {
+  CFXProfiler &prof = CFXProfiler::get();
+
+  if (this->worst_mode_p99_ != nullptr) {
+    const auto *worst = prof.worst_mode();
+    if (worst != nullptr)
+      this->worst_mode_p99_->publish_state(
+          (float)worst->ns_per_led.percentile(0.99f));
+  }
+
+  const auto *last = prof.last_mode();
+  if (last != nullptr && last->ns_per_led.count() > 0) {
+    if (this->last_mode_p50_ != nullptr)
+      this->last_mode_p50_->publish_state(
+          (float)last->ns_per_led.percentile(0.50f));
+    if (this->last_mode_p99_ != nullptr)
+      this->last_mode_p99_->publish_state(
+          (float)last->ns_per_led.percentile(0.99f));
+  }
+
+  publish_stage_p99(this->render_p99_, chimera_fx::CFX_STAGE_RENDER);
+  publish_stage_p99(this->inout_p99_, chimera_fx::CFX_STAGE_INOUT);
+  publish_stage_p99(this->coordinator_p99_, chimera_fx::CFX_STAGE_COORDINATOR);
+  publish_stage_p99(this->copy_p99_, chimera_fx::CFX_STAGE_COPY);
+  publish_stage_p99(this->dma_wait_p99_, chimera_fx::CFX_STAGE_DMA_WAIT);
+
+  const auto &sched = chimera_fx::CFXScheduler::get().get_stats();
+  if (sched.batches > 0) {
+    if (this->core0_load_ != nullptr)
+      this->core0_load_->publish_state((float)sched.util_core0_pct);
+    if (this->core1_load_ != nullptr)
+      this->core1_load_->publish_state((float)sched.util_core1_pct);
+    if (this->core_imbalance_ != nullptr)
+      this->core_imbalance_->publish_state((float)sched.imbalance_pct);
+  }
+  if (this->degraded_frames_ != nullptr)
+    this->degraded_frames_->publish_state((float)sched.degraded_frames);
+  if (this->runner_degraded_frames_ != nullptr)
+    this->runner_degraded_frames_->publish_state(
+        (float)sched.degraded_frames_worst);
+
+  if (this->summary_ != nullptr) {
+    // HA caps text_sensor state at 255 chars.
+    char buf[256];
+    prof.summary(buf, sizeof(buf));
+    if (this->last_summary_ != buf) {
+      this->last_summary_ = buf;
+      this->summary_->publish_state(this->last_summary_);
+    }
+  }
+
+  if (this->log_on_update_)
+    prof.dump();
+}
+
+void CFXProfilerComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "ChimeraFX Profiler:");
+  ESP_LOGCONFIG(TAG, "  Log on update: %s", YESNO(this->log_on_update_));
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Worst mode p99", this->worst_mode_p99_);
+  LOG_SENSOR("  ", "Last mode p50", this->last_mode_p50_);
+  LOG_SENSOR("  ", "Last mode p99", this->last_mode_p99_);
+  LOG_SENSOR("  ", "Render p99", this->render_p99_);
+  LOG_SENSOR("  ", "Intro/outro p99", this->inout_p99_);
+  LOG_SENSOR("  ", "Coordinator p99", this->coordinator_p99_);
+  LOG_SENSOR("  ", "Copy p99", this->copy_p99_);
+  LOG_SENSOR("  ", "DMA wait p99", this->dma_wait_p99_);
+  LOG_SENSOR("  ", "Core 0 load", this->core0_load_);
+  LOG_SENSOR("  ", "Core 1 load", this->core1_load_);
+  LOG_SENSOR("  ", "Core imbalance", this->core_imbalance_);
+  LOG_SENSOR("  ", "Degraded frames", this->degraded_frames_);
+  LOG_SENSOR("  ", "Runner degraded frames", this->runner_degraded_frames_);
+  const auto &sched = chimera_fx::CFXScheduler::get().get_stats();
+  ESP_LOGCONFIG(TAG, "  Frame budget: %u degraded frames, worst runner %u",
+                (unsigned)sched.degraded_frames,
+                (unsigned)sched.degraded_frames_worst);
+  LOG_TEXT_SENSOR("  ", "Summary", this->summary_);
+#ifdef USE_CFX_TRACE
+  if (this->trace_host_.empty()) {
+    ESP_LOGCONFIG(TAG, "  Trace: %u events, dump to log",
+                  (unsigned)chimera_fx::CFXTrace::RING_SIZE);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Trace: %u events, dump to %s:%u",
+                  (unsigned)chimera_fx::CFXTrace::RING_SIZE,
+                  this->trace_host_.c_str(), (unsigned)this->trace_port_);
+  }
+#endif
+}
+
+#ifdef USE_API
+void CFXProfilerServiceHandler::setup() {
+  this->register_service(&CFXProfilerServiceHandler::on_dump,
+                         "cfx_profiler_dump");
+  this->register_service(&CFXProfilerServiceHandler::on_reset,
+                         "cfx_profiler_reset");
+#ifdef USE_CFX_TRACE
+  this->register_service(&CFXProfilerServiceHandler::on_trace_dump,
+                         "cfx_trace_dump");
+  this->register_service(&CFXProfilerServiceHandler::on_trace_reset,
+                         "cfx_trace_reset");
+#endif
+}
+
+void CFXProfilerServiceHandler::on_dump() {
+  ESP_LOGD(TAG, "Service: cfx_profiler_dump");
+  CFXProfiler::get().dump();
+}
+
+void CFXProfilerServiceHandler::on_reset() {
+  ESP_LOGD(TAG, "Service: cfx_profiler_reset");
+  CFXProfiler::get().reset();
+}
+
+#ifdef USE_CFX_TRACE
+void CFXProfilerServiceHandler::on_trace_dump() {
+  ESP_LOGD(TAG, "Service: cfx_trace_dump");
+  if (this->parent_ != nullptr)
+    this->parent_->dump_trace();
+}
+
+void CFXProfilerServiceHandler::on_trace_reset() {
+  ESP_LOGD(TAG, "Service: cfx_trace_reset");
+  chimera_fx::CFXTrace::get().reset();
+}
+#endif
+#endif
+
+} // namespace cfx_profiler
+} // namespace esphome
@@ -0,0 +1,111 @@
+/*
+ * ChimeraFX — Render cost profiler component
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Publishes CFXProfiler percentiles (see cfx_effect/cfx_profiler.h) as
+ * sensors. Mode sensors are ns/LED, stage sensors are µs, all p99 unless
+ * named otherwise. Core load sensors come from CFXScheduler's dual-core
+ * placement stats and stay silent until a parallel batch has run. The
+ * degraded frame counters come from its frame budget: the total over all
+ * runners, and the most any single runner has been degraded.
+ *
+ * With USE_CFX_TRACE the component also enables the frame pipeline trace
+ * (cfx_effect/cfx_trace.h) and dumps it on request, as Chrome trace JSON
+ * over UDP to the configured host or, without one, to the log.
+ */
+
+#pragma once
+
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/text_sensor/text_sensor.h"
+#include "esphome/core/component.h"
+
+#ifdef USE_API
+#include "esphome/components/api/custom_api_device.h"
+#endif
+
+#include <string>
+
+namespace esphome {
+namespace cfx_profiler {
+
+class CFXProfilerComponent : public PollingComponent {
+public:
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void set_log_on_update(bool log) { log_on_update_ = log; }
+
+  void set_worst_mode_p99_sensor(sensor::Sensor *s) { worst_mode_p99_ = s; }
+  void set_last_mode_p50_sensor(sensor::Sensor *s) { last_mode_p50_ = s; }
+  void set_last_mode_p99_sensor(sensor::Sensor *s) { last_mode_p99_ = s; }
+  void set_render_p99_sensor(sensor::Sensor *s) { render_p99_ = s; }
+  void set_inout_p99_sensor(sensor::Sensor *s) { inout_p99_ = s; }
+  void set_coordinator_p99_sensor(sensor::Sensor *s) { coordinator_p99_ = s; }
+  void set_copy_p99_sensor(sensor::Sensor *s) { copy_p99_ = s; }
+  void set_dma_wait_p99_sensor(sensor::Sensor *s) { dma_wait_p99_ = s; }
+  void set_core0_load_sensor(sensor::Sensor *s) { core0_load_ = s; }
+  void set_core1_load_sensor(sensor::Sensor *s) { core1_load_ = s; }
+  void set_core_imbalance_sensor(sensor::Sensor *s) { core_imbalance_ = s; }
+  void set_degraded_frames_sensor(sensor::Sensor *s) { degraded_frames_ = s; }
+  void set_runner_degraded_frames_sensor(sensor::Sensor *s) {
+    runner_degraded_frames_ = s;
+  }
+  void set_summary_text_sensor(text_sensor::TextSensor *s) { summary_ = s; }
+
+#ifdef USE_CFX_TRACE
+  void set_trace_udp(const std::string &host, uint16_t port) {
+    trace_host_ = host;
+    trace_port_ = port;
+  }
+  void dump_trace();
+#endif
+
+protected:
+  bool log_on_update_{false};
+
+  sensor::Sensor *worst_mode_p99_{nullptr};
+  sensor::Sensor *last_mode_p50_{nullptr};
+  sensor::Sensor *last_mode_p99_{nullptr};
+  sensor::Sensor *render_p99_{nullptr};
+  sensor::Sensor *inout_p99_{nullptr};
+  sensor::Sensor *coordinator_p99_{nullptr};
+  sensor::Sensor *copy_p99_{nullptr};
+  sensor::Sensor *dma_wait_p99_{nullptr};
+  sensor::Sensor *core0_load_{nullptr};
+  sensor::Sensor *core1_load_{nullptr};
+  sensor::Sensor *core_imbalance_{nullptr};
+  sensor::Sensor *degraded_frames_{nullptr};
+  sensor::Sensor *runner_degraded_frames_{nullptr};
+  text_sensor::TextSensor *summary_{nullptr};
+  std::string last_summary_;
+#ifdef USE_CFX_TRACE
+  std::string trace_host_;
+  uint16_t trace_port_{0};
+#endif
+};
+
+#ifdef USE_API
+class CFXProfilerServiceHandler : public ::esphome::api::CustomAPIDevice,
+                                  public ::esphome::Component {
+public:
+  void setup() override;
+  void set_parent(CFXProfilerComponent *parent) { parent_ = parent; }
+
+private:
+  void on_dump();
+  void on_reset();
+#ifdef USE_CFX_TRACE
+  void on_trace_dump();
+  void on_trace_reset();
+#endif
+
+  CFXProfilerComponent *parent_{nullptr};
+};
+#endif
+
+} // namespace cfx_profiler
+} // namespace esphome
@@ -2,6 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import light, select, event, sensor, button
 from esphome import automation
+from esphome.helpers import cpp_string_escape
 from esphome.const import (
     CONF_ID,
     CONF_NAME,
@@ -583,6 +584,70 @@ def _cfx_run_schema():
     )
 
 
+def _cfx_run_spec_initializer(config, strip_tag):
+    """Aggregate initializer for the CfxRunSpec record of one cfx_run."""
+    flags = []
+
+    def opt(key, flag, default=0):
+        if key in config:
+            flags.append(flag)
+            return config[key]
+        return default
+
+    speed = opt(CONF_SET_SPEED, "HAS_SPEED")
+    intensity = opt(CONF_SET_INTENSITY, "HAS_INTENSITY")
+    palette = opt(CONF_SET_PALETTE, "HAS_PALETTE")
+    brightness = opt(CONF_SET_BRIGHTNESS, "HAS_BRIGHTNESS", 0.0)
+    mirror = opt(CONF_SET_MIRROR, "HAS_MIRROR", False)
+    intro = opt(CONF_SET_INTRO, "HAS_INTRO")
+    outro = opt(CONF_SET_OUTRO, "HAS_OUTRO")
+    inout_duration = opt(CONF_SET_INOUT_DURATION, "HAS_INOUT_DURATION", 0.0)
+    force_white = opt(CONF_SET_FORCE_WHITE, "HAS_FORCE_WHITE", False)
+    autotune = opt(CONF_SET_AUTOTUNE, "HAS_AUTOTUNE", False)
+
+    color = [0, 0, 0, 0]
+    if CONF_SET_COLOR in config:
+        flags.append("HAS_COLOR")
+        scaled = [int(round(channel * 255 / 100)) for channel in config[CONF_SET_COLOR]]
+        if len(scaled) == 4:
+            flags.append("HAS_WHITE")
+        color[: len(scaled)] = scaled
+
+    if _resolve_ha_events(config[CONF_HA_EVENTS], default_enabled=False):
+        flags.append("HA_EVENTS")
+
+    def c_bool(value):
+        return "true" if value else "false"
+
+    def c_float(value):
+        return f"{float(value)!r}f"
+
+    flag_expr = " | ".join(
+        f"esphome::cfx_sequence::CfxRunSpec::{flag}" for flag in flags
+    ) or "0"
+    fields = [
+        f".effect = {cpp_string_escape(config['effect'])}",
+        f".strip_tag = {cpp_string_escape(strip_tag)}",
+        f".iterations = {int(config.get(CONF_ITERATIONS, 1))}u",
+        f".brightness = {c_float(brightness)}",
+        f".inout_duration = {c_float(inout_duration)}",
+        f".flags = static_cast<uint16_t>({flag_expr})",
+        f".speed = {int(speed)}",
+        f".intensity = {int(intensity)}",
+        f".palette = {int(palette)}",
+        f".color_r = {color[0]}",
+        f".color_g = {color[1]}",
+        f".color_b = {color[2]}",
+        f".color_w = {color[3]}",
+        f".intro = {int(intro)}",
+        f".outro = {int(outro)}",
+        f".mirror = {c_bool(mirror)}",
+        f".force_white = {c_bool(force_white)}",
+        f".autotune = {c_bool(autotune)}",
+    ]
+    return "{" + ", ".join(fields) + "}"
+
+
 @automation.register_action(
     "cfx_run",
     CfxRunAction,
@@ -594,37 +659,22 @@ async def cfx_run_to_code(config, action_id, template_arg, args):
 
     light_var = await cg.get_variable(config[CONF_ID])
     cg.add(var.set_light(light_var))
-    cg.add(var.set_effect(config["effect"]))
 
     # Reuse the same canonical light/segment tag resolution as cfx_sequence.
     light_name_map, _ = _build_light_tag_map()
     strip_tag = _resolve_light_tag(config[CONF_ID], light_name_map)
-    cg.add(var.set_strip_tag(strip_tag))
 
-    if CONF_SET_SPEED in config:
-        cg.add(var.set_speed(config[CONF_SET_SPEED]))
-    if CONF_SET_INTENSITY in config:
-        cg.add(var.set_intensity(config[CONF_SET_INTENSITY]))
-    if CONF_SET_PALETTE in config:
-        cg.add(var.set_palette(config[CONF_SET_PALETTE]))
-    if CONF_SET_BRIGHTNESS in config:
-        cg.add(var.set_brightness(config[CONF_SET_BRIGHTNESS]))
-    _emit_set_color(var, config)
-    if CONF_SET_MIRROR in config:
-        cg.add(var.set_mirror(config[CONF_SET_MIRROR]))
-    if CONF_SET_INTRO in config:
-        cg.add(var.set_intro(config[CONF_SET_INTRO]))
-    if CONF_SET_OUTRO in config:
-        cg.add(var.set_outro(config[CONF_SET_OUTRO]))
-    if CONF_SET_INOUT_DURATION in config:
-        cg.add(var.set_inout_duration(config[CONF_SET_INOUT_DURATION]))
-    if CONF_SET_FORCE_WHITE in config:
-        cg.add(var.set_force_white(config[CONF_SET_FORCE_WHITE]))
-    if CONF_SET_AUTOTUNE in config:
-        cg.add(var.set_autotune(config[CONF_SET_AUTOTUNE]))
-    _emit_ha_events(var, config, default_enabled=False)
-    if CONF_ITERATIONS in config:
-        cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    # The step itself is a static const record in flash; the action only
+    # keeps a pointer to it.
+    cg.add_define("USE_CFX_RUN")
+    spec_name = f"{action_id}_spec"
+    cg.add_global(
+        cg.RawStatement(
+            f"static const esphome::cfx_sequence::CfxRunSpec {spec_name} = "
+            f"{_cfx_run_spec_initializer(config, strip_tag)};"
+        )
+    )
+    cg.add(var.set_spec(cg.RawExpression(f"&{spec_name}")))
 
     # Nesting depth: count how many cfx_run levels deep this action is.
     # ESPHome passes the parent action chain in args — we walk up counting
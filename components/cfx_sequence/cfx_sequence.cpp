@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <cstdlib>
+#include <new>
 #include <set>
 
 #include "cfx_sequence.h"
@@ -77,29 +78,37 @@ static std::string resolve_light_tag_(light::LightState *state) {
   return std::string(id_buf, strnlen(id_buf, sizeof(id_buf)));
 }
 
-static chimera_fx::CFXAddressableLightEffect *resolve_segment_stub_singleton_(
+// The engine behind a stub entry on `state`: the entry named `effect_name`,
+// or the active one when `require_active` is set. Naming an entry claims the
+// engine's runtime presets for it, so the overrides seeded next carry over
+// to its start() instead of being dropped as another entry's.
+static chimera_fx::CFXAddressableLightEffect *resolve_stub_engine_(
     light::LightState *state, const std::string &effect_name,
     bool require_active) {
   if (state == nullptr) {
     return nullptr;
   }
 
-  light::LightEffect *active =
-      require_active ? chimera_fx::LightStateProxy::get_active_effect(state)
-                     : nullptr;
-  for (auto *stub : chimera_fx::CFXEffectStub::all_stubs()) {
-    if (stub == nullptr || stub->get_light_state() != state) {
-      continue;
-    }
-    if (!effect_name.empty() && stub->get_name() != effect_name) {
-      continue;
+  if (require_active) {
+    light::LightEffect *active =
+        chimera_fx::LightStateProxy::get_active_effect(state);
+    if (active == nullptr ||
+        (!effect_name.empty() && active->get_name() != effect_name)) {
+      return nullptr;
     }
-    if (require_active && active != stub) {
-      continue;
-    }
-    return stub->get_singleton();
+    auto *engine = chimera_fx::CFXAddressableLightEffect::engine_for(active);
+    return engine != nullptr && engine->owns_stub(active) ? engine : nullptr;
   }
-  return nullptr;
+
+  auto *stub = chimera_fx::CFXAddressableLightEffect::find_stub(state, effect_name);
+  if (stub == nullptr) {
+    return nullptr;
+  }
+  auto *engine = stub->get_engine();
+  if (engine != nullptr) {
+    engine->claim_presets_for(stub->get_descriptor());
+  }
+  return engine;
 }
 }  // namespace
 
@@ -168,8 +177,8 @@ void CFXRunPool::ensure_initialized_() {
   if (this->initialized_) return;
   this->initialized_ = true;
   ensure_sequence_registry_capacity_(POOL_SIZE + 8, "pool-init");
-  // Lazy: all slots start null. Sequences are heap-allocated on first claim().
-  // This avoids paying ~512 B per slot for pool entries that may never be used.
+  // All slots start unconstructed; claim() builds each slot's sequence in
+  // its static storage the first time the slot is used.
   for (uint8_t i = 0; i < POOL_SIZE; i++) {
     this->sequences_[i] = nullptr;
     this->slots_[i].sequence = nullptr;
@@ -189,11 +198,12 @@ CFXSequence *CFXRunPool::claim(uint8_t depth) {
 
   for (uint8_t i = 0; i < POOL_SIZE; i++) {
     if (!this->slots_[i].in_use) {
-      // Lazy allocation: create the sequence object on first use of this slot.
-      // Subsequent claims on the same slot reuse the existing object.
+      // Construct the slot's sequence in place on first use. Subsequent
+      // claims on the same slot reuse the existing object.
       if (this->sequences_[i] == nullptr) {
         std::string slot_id = "cfx_run_pool_" + std::to_string(i);
-        this->sequences_[i] = new CFXSequence(slot_id, slot_id, "", false);
+        this->sequences_[i] = new (this->storage_[i])
+            CFXSequence(slot_id, slot_id, "", false);
         // Remove from instances — pool sequences self-manage registration.
         auto &v = CFXSequence::instances;
         v.erase(std::remove(v.begin(), v.end(), this->sequences_[i]), v.end());
@@ -240,7 +250,7 @@ void CFXRunPool::release(CFXSequence *seq) {
       // Reset sequence state for next claim.
       seq->configured_light_count_ = 0;
       release_vector_storage_(seq->lights_);
-      release_vector_storage_(seq->on_reach_triggers_);
+      seq->on_reach_triggers_.release();
       release_vector_storage_(seq->on_complete_triggers_);
       release_vector_storage_(seq->on_stop_triggers_);
       release_vector_storage_(seq->on_start_triggers_);
@@ -289,10 +299,23 @@ bool CFXRunPool::is_pool_owned(CFXSequence *seq) const {
   return false;
 }
 
+size_t CFXRunPool::memory_bytes() const {
+  size_t bytes = sizeof(*this) +
+                 CFXSequence::instances.capacity() * sizeof(CFXSequence *);
+  // Pool sequences are registered only while they run and live in storage_.
+  for (auto *seq : CFXSequence::instances) {
+    if (!this->is_pool_owned(seq))
+      bytes += sizeof(CFXSequence);
+  }
+  return bytes;
+}
+
 // ── CfxRunActionBase::do_play_() ─────────────────────────────────────────────
 
 void CfxRunActionBase::do_play_() {
-  if (this->light_ == nullptr || this->effect_.empty()) {
+  const CfxRunSpec *spec = this->spec_;
+  if (this->light_ == nullptr || spec == nullptr || spec->effect == nullptr ||
+      spec->effect[0] == '\0') {
     ESP_LOGW("cfx_run", "cfx_run: light or effect not set — skipped");
     return;
   }
@@ -305,7 +328,7 @@ void CfxRunActionBase::do_play_() {
   for (auto *seq : CFXSequence::instances) {
     if (pool.is_pool_owned(seq) && seq->is_running() &&
         seq->owns_light(this->light_) &&
-        seq->effect_ == this->effect_) {
+        seq->effect_ == spec->effect) {
       return;
     }
   }
@@ -323,28 +346,28 @@ void CfxRunActionBase::do_play_() {
     parent_seq->attach_child_sequence_(seq);
   }
 
-  // Configure the claimed sequence.
-  seq->effect_    = this->effect_;
-  seq->strip_tag_ = this->strip_tag_;
-  seq->iterations_= this->iterations_;
-  if (this->speed_.has_value())        seq->set_speed(this->speed_.value());
-  if (this->intensity_.has_value())    seq->set_intensity(this->intensity_.value());
-  if (this->palette_.has_value())      seq->set_palette(this->palette_.value());
-  if (this->brightness_.has_value())   seq->set_brightness(this->brightness_.value());
-  if (this->has_color_) {
-    if (this->color_has_white_)
-      seq->set_color_rgbw(this->color_r_, this->color_g_, this->color_b_,
-                          this->color_w_);
+  // Configure the claimed sequence from the compiled record.
+  seq->effect_    = spec->effect;
+  seq->set_strip_tag(spec->strip_tag != nullptr ? spec->strip_tag : "");
+  seq->iterations_= spec->iterations;
+  if (spec->has(CfxRunSpec::HAS_SPEED))        seq->set_speed(spec->speed);
+  if (spec->has(CfxRunSpec::HAS_INTENSITY))    seq->set_intensity(spec->intensity);
+  if (spec->has(CfxRunSpec::HAS_PALETTE))      seq->set_palette(spec->palette);
+  if (spec->has(CfxRunSpec::HAS_BRIGHTNESS))   seq->set_brightness(spec->brightness);
+  if (spec->has(CfxRunSpec::HAS_COLOR)) {
+    if (spec->has(CfxRunSpec::HAS_WHITE))
+      seq->set_color_rgbw(spec->color_r, spec->color_g, spec->color_b,
+                          spec->color_w);
     else
-      seq->set_color_rgb(this->color_r_, this->color_g_, this->color_b_);
+      seq->set_color_rgb(spec->color_r, spec->color_g, spec->color_b);
   }
-  if (this->mirror_.has_value())       seq->set_mirror(this->mirror_.value());
-  if (this->intro_.has_value())        seq->set_intro(this->intro_.value());
-  if (this->outro_.has_value())        seq->set_outro(this->outro_.value());
-  if (this->inout_duration_.has_value()) seq->set_inout_duration(this->inout_duration_.value());
-  if (this->force_white_.has_value())  seq->set_force_white(this->force_white_.value());
-  if (this->autotune_.has_value())     seq->set_autotune(this->autotune_.value());
-  seq->set_ha_events(this->ha_events_);
+  if (spec->has(CfxRunSpec::HAS_MIRROR))       seq->set_mirror(spec->mirror);
+  if (spec->has(CfxRunSpec::HAS_INTRO))        seq->set_intro(spec->intro);
+  if (spec->has(CfxRunSpec::HAS_OUTRO))        seq->set_outro(spec->outro);
+  if (spec->has(CfxRunSpec::HAS_INOUT_DURATION)) seq->set_inout_duration(spec->inout_duration);
+  if (spec->has(CfxRunSpec::HAS_FORCE_WHITE))  seq->set_force_white(spec->force_white);
+  if (spec->has(CfxRunSpec::HAS_AUTOTUNE))     seq->set_autotune(spec->autotune);
+  seq->set_ha_events(spec->has(CfxRunSpec::HA_EVENTS));
 
   // Transfer triggers. These are YAML-codegen objects — they live for the
   // firmware lifetime and are safe to reference from the pooled sequence.
@@ -425,7 +448,7 @@ void CfxSetActionBase::do_play_() {
             return inst;
           if (auto *inst = find_inst(chimera_fx::CFXAddressableLightEffect::all_segment_effects, false))
             return inst;
-          if (auto *inst = resolve_segment_stub_singleton_(this->light_, this->effect_, false))
+          if (auto *inst = resolve_stub_engine_(this->light_, this->effect_, false))
             return inst;
         }
 
@@ -434,7 +457,7 @@ void CfxSetActionBase::do_play_() {
           return inst;
         if (auto *inst = find_inst(chimera_fx::CFXAddressableLightEffect::all_segment_effects, true))
           return inst;
-        if (auto *inst = resolve_segment_stub_singleton_(this->light_, this->effect_, true))
+        if (auto *inst = resolve_stub_engine_(this->light_, this->effect_, true))
           return inst;
 
         return nullptr;
@@ -798,10 +821,35 @@ void CFXSequence::start() {
     auto task_name = this->id_ + "_start_" + std::to_string(i);
     uint32_t task_hash = esphome::fnv1_hash(task_name);
     this->stagger_tasks_pending_++;
-             
+
+    // Warm start: each light stages its target effect's runners at the
+    // start of its own stagger slot, a loop pass ahead of its perform(), so
+    // the switch adopts them instead of building them inside perform().
+    uint32_t perform_delay = stagger_delay;
+    if (!this->effect_.empty()) {
+      esphome::App.scheduler.set_timeout(
+          CFXSequenceSelect::instance,
+          esphome::fnv1_hash(this->id_ + "_prestage_" + std::to_string(i)),
+          stagger_delay, [this, l]() {
+            if (!this->is_running_)
+              return;
+            for (auto *inst : chimera_fx::CFXAddressableLightEffect::all_effects) {
+              if (inst->get_light_state() == l && inst->get_name() == this->effect_) {
+                inst->prestage_runners();
+                return;
+              }
+            }
+            if (auto *stub = chimera_fx::CFXAddressableLightEffect::find_stub(l, this->effect_)) {
+              if (auto *engine = stub->get_engine())
+                engine->prestage_runners(stub->get_descriptor());
+            }
+          });
+      perform_delay += 10;
+    }
+
     esphome::App.scheduler.set_timeout(CFXSequenceSelect::instance,
                                       task_hash,
-                                      stagger_delay, [this, l]() {
+                                      perform_delay, [this, l]() {
       // CFX-055: Do NOT decrement stagger_tasks_pending_ until AFTER
       // call.perform() completes. Decrementing early opens the listener
       // gate (is_stagger_complete() == true) during the effect stop→start
@@ -834,7 +882,7 @@ void CFXSequence::start() {
       }
 
       if (target_inst == nullptr && !this->effect_.empty()) {
-        target_inst = resolve_segment_stub_singleton_(l, this->effect_, false);
+        target_inst = resolve_stub_engine_(l, this->effect_, false);
       }
 
       if (target_inst == nullptr) {
@@ -844,14 +892,8 @@ void CFXSequence::start() {
             auto *parent = s->get_parent();
             auto *master_ls = parent->get_master_light_state();
             if (master_ls != nullptr) {
-              light::LightEffect *master_active =
-                  chimera_fx::LightStateProxy::get_active_effect(master_ls);
-              for (auto *inst : chimera_fx::CFXAddressableLightEffect::all_effects) {
-                if (inst == master_active) {
-                  target_inst = inst;
-                  break;
-                }
-              }
+              target_inst = chimera_fx::CFXAddressableLightEffect::engine_for(
+                  chimera_fx::LightStateProxy::get_active_effect(master_ls));
             }
             break;
           }
@@ -924,6 +966,7 @@ void CFXSequence::start() {
 
   this->last_triggered_percentage_ = -1.0f;
   this->last_triggered_pixel_ = -1;
+  this->reach_next_ = 0;
   this->fired_reach_triggers_.clear();
   this->start_reported_ = false;
   this->completion_reported_ = false;
@@ -980,25 +1023,12 @@ bool CFXSequence::try_bind_effects_() {
       continue;
     }
 
-    // Search all_effects
-    for (auto *inst : chimera_fx::CFXAddressableLightEffect::all_effects) {
-      if (inst == active) {
-        this->apply_binding_to_effect_(inst);
-        any_bound = true;
-        break;
-      }
-    }
-    if (any_bound) continue;
-
-    // Search all_segment_effects
-    for (auto *inst : chimera_fx::CFXAddressableLightEffect::all_segment_effects) {
-      if (inst == active) {
-        this->apply_binding_to_effect_(inst);
-        any_bound = true;
-        break;
-      }
+    // The active effect, or the engine behind an active stub
+    if (auto *inst = chimera_fx::CFXAddressableLightEffect::engine_for(active)) {
+      this->apply_binding_to_effect_(inst);
+      any_bound = true;
+      continue;
     }
-    if (any_bound) continue;
 
     // Segment-to-parent resolution
     auto *output = l->get_output();
@@ -1007,14 +1037,10 @@ bool CFXSequence::try_bind_effects_() {
         auto *parent = s->get_parent();
         auto *master_ls = parent->get_master_light_state();
         if (master_ls != nullptr) {
-          light::LightEffect *master_active =
-              chimera_fx::LightStateProxy::get_active_effect(master_ls);
-          for (auto *inst : chimera_fx::CFXAddressableLightEffect::all_effects) {
-            if (inst == master_active) {
-              this->apply_binding_to_effect_(inst);
-              any_bound = true;
-              break;
-            }
+          if (auto *inst = chimera_fx::CFXAddressableLightEffect::engine_for(
+                  chimera_fx::LightStateProxy::get_active_effect(master_ls))) {
+            this->apply_binding_to_effect_(inst);
+            any_bound = true;
           }
         }
         break;
@@ -1640,8 +1666,7 @@ void CFXSequence::report_event_begin() {
   }
   if (!this->strip_tag_.empty()
       && this->ha_events_) {
-    std::string evt = std::string("cfx_begin:") + this->strip_tag_;
-    CFXEventManager::get().fire_event(evt.c_str());
+    CFXEventManager::get().fire(chimera_fx::CFX_EVENT_BEGIN, this->strip_tag_id_);
   }
 }
 
@@ -1657,24 +1682,24 @@ void CFXSequence::report_event_stop() {
   // This keeps stop semantics aligned with cfx_reach, which is already per
   // light, and covers adopted cfx_set lights as well.
   if (this->ha_events_) {
-    std::vector<std::string> stop_tags;
-    auto add_unique_tag = [&stop_tags](const std::string &tag) {
-      if (tag.empty()) {
+    auto &events = CFXEventManager::get();
+    std::vector<uint16_t> stop_tags;
+    auto add_unique_tag = [&stop_tags](uint16_t tag_id) {
+      if (tag_id == CFXEventManager::NO_TAG) {
         return;
       }
-      if (std::find(stop_tags.begin(), stop_tags.end(), tag) == stop_tags.end()) {
-        stop_tags.push_back(tag);
+      if (std::find(stop_tags.begin(), stop_tags.end(), tag_id) == stop_tags.end()) {
+        stop_tags.push_back(tag_id);
       }
     };
 
-    add_unique_tag(this->strip_tag_);
+    add_unique_tag(this->strip_tag_id_);
     for (auto *light : this->lights_) {
-      add_unique_tag(resolve_light_tag_(light));
+      add_unique_tag(events.intern_tag(resolve_light_tag_(light)));
     }
 
-    for (const auto &tag : stop_tags) {
-      std::string evt = std::string("cfx_stop:") + tag;
-      CFXEventManager::get().fire_event(evt.c_str());
+    for (uint16_t tag_id : stop_tags) {
+      events.fire(chimera_fx::CFX_EVENT_STOP, tag_id);
     }
   }
 }
@@ -1693,8 +1718,7 @@ void CFXSequence::report_event_complete() {
   // Fire tagged cfx_complete using this sequence's own strip_tag_.
   // No global singleton state — each sequence instance fires for its own strip.
   if (this->ha_events_ && !this->strip_tag_.empty()) {
-    std::string evt = std::string("cfx_complete:") + this->strip_tag_;
-    CFXEventManager::get().fire_event(evt.c_str());
+    CFXEventManager::get().fire(chimera_fx::CFX_EVENT_COMPLETE, this->strip_tag_id_);
   }
 }
 
@@ -1726,53 +1750,19 @@ void CFXSequence::check_positional_triggers(int32_t current_pixel,
       this->fired_reach_triggers_.clear();
     }
 
-    // Evaluate on_reach (Percentage based)
-    for (auto *t : this->on_reach_triggers_) {
-      float target = t->get_target_position();
-      bool crossed = false;
-
-      if (this->last_triggered_percentage_ == -1.0f) {
-        if (current_percentage >= target)
-          crossed = true;
-      } else {
-        // Forward crossing
-        if (current_percentage >= target &&
-            this->last_triggered_percentage_ < target) {
-          crossed = true;
-        }
-        // Backward crossing
-        else if (current_percentage <= target &&
-                 this->last_triggered_percentage_ > target) {
-          crossed = true;
-        }
-        // Wrap-around forward (e.g. 0.95 -> 0.05)
-        else if (this->last_triggered_percentage_ > 0.8f &&
-                 current_percentage < 0.2f) {
-          if (target > this->last_triggered_percentage_ ||
-              target <= current_percentage) {
-            crossed = true;
-          }
-        }
-        // Wrap-around backward (e.g. 0.05 -> 0.95)
-        else if (this->last_triggered_percentage_ < 0.2f &&
-                 current_percentage > 0.8f) {
-          if (target < this->last_triggered_percentage_ ||
-              target >= current_percentage) {
-            crossed = true;
+    // Evaluate on_reach (percentage based) against the sorted schedule:
+    // one compare per frame unless a target was actually crossed.
+    this->on_reach_triggers_.advance(
+        this->reach_next_, this->last_triggered_percentage_, current_percentage,
+        [this, current_percentage](CfxSeqOnReachTrigger *t) {
+          if (std::find(this->fired_reach_triggers_.begin(),
+                        this->fired_reach_triggers_.end(),
+                        t) != this->fired_reach_triggers_.end()) {
+            return;
           }
-        }
-      }
-
-      if (crossed) {
-        if (std::find(this->fired_reach_triggers_.begin(),
-                      this->fired_reach_triggers_.end(),
-                      t) != this->fired_reach_triggers_.end()) {
-          continue;
-        }
-        this->pending_reach_triggers_.push_back({t, current_percentage});
-        this->fired_reach_triggers_.push_back(t);
-      }
-    }
+          this->pending_reach_triggers_.push_back({t, current_percentage});
+          this->fired_reach_triggers_.push_back(t);
+        });
 
     this->last_triggered_percentage_ = current_percentage;
   }
@@ -27,6 +27,7 @@
 #include <string>
 
 #include "../cfx_effect/cfx_event_manager.h"
+#include "../cfx_effect/cfx_reach_schedule.h"
 
 namespace esphome {
 namespace chimera_fx {
@@ -136,7 +137,10 @@ public:
 
   // Strip identity tag — YAML id of the first target light, injected by
   // codegen. Pre-loaded into CFXEventManager before perform() fires. (CFX-024)
-  void set_strip_tag(const std::string &tag) { this->strip_tag_ = tag; }
+  void set_strip_tag(const std::string &tag) {
+    this->strip_tag_ = tag;
+    this->strip_tag_id_ = CFXEventManager::get().intern_tag(tag);
+  }
   const std::string &get_strip_tag() const { return this->strip_tag_; }
 
   std::string get_id() const { return this->id_; }
@@ -155,7 +159,7 @@ public:
     this->on_complete_triggers_.push_back(t);
   }
   void add_on_reach_trigger(CfxSeqOnReachTrigger *t) {
-    this->on_reach_triggers_.push_back(t);
+    this->on_reach_triggers_.add(t);
   }
 
   // Called by bound effects to report tracking
@@ -238,6 +242,7 @@ protected:
   bool ha_events_{true};
   uint32_t duration_ms_{0};
   std::string strip_tag_{};      // CFX-024: YAML id of first target light
+  uint16_t strip_tag_id_{CFXEventManager::NO_TAG};
   uint32_t duration_start_ms_{0};
   bool duration_complete_fired_{false};
 
@@ -252,7 +257,8 @@ protected:
   std::vector<CfxSeqOnBeginTrigger *>   on_begin_triggers_;
   std::vector<CfxSeqOnStopTrigger *>    on_stop_triggers_;
   std::vector<CfxSeqOnCompleteTrigger *> on_complete_triggers_;
-  std::vector<CfxSeqOnReachTrigger *> on_reach_triggers_;
+  // Sorted by target at registration; reach_next_ is the run's cursor.
+  chimera_fx::CFXReachSchedule<CfxSeqOnReachTrigger> on_reach_triggers_;
 
   // CFX-042: Deferred trigger queue. Triggers crossed during apply() are
   // collected here instead of fired synchronously. flush_pending_triggers()
@@ -271,6 +277,7 @@ protected:
 
   float last_triggered_percentage_{-1.0f};
   int32_t last_triggered_pixel_{-1};
+  uint16_t reach_next_{0};
 
   // Per-instance milestone tracking — decoupled from CFXEventManager singleton
   // so concurrent strips each maintain their own counter. (multi-strip fix)
@@ -302,8 +309,8 @@ protected:
     while (current_pct >= next && next <= 100) {
       this->last_fired_milestone_ = next;
       this->milestone_fired_this_frame_ = true;
-      CFXEventManager::get().fire_reach_event(this->strip_tag_,
-                                              this->last_fired_milestone_);
+      CFXEventManager::get().fire_reach(this->strip_tag_id_,
+                                        this->last_fired_milestone_);
       next = this->last_fired_milestone_ + MILESTONE_STEP;
     }
     // Auto-reset when a new forward pass begins (pct wraps back to ~0)
@@ -540,40 +547,53 @@ static constexpr uint8_t CFX_RUN_MAX_DEPTH  = 8;
 // Forward declaration — pool lives in cfx_sequence.cpp
 class CFXRunPool;
 
+// One cfx_run step as codegen compiles it: a static const record, so the
+// effect name, tag and overrides sit in flash instead of in every action.
+// An override applies only when its HAS_ flag is set.
+struct CfxRunSpec {
+  enum : uint16_t {
+    HAS_SPEED          = 1 << 0,
+    HAS_INTENSITY      = 1 << 1,
+    HAS_PALETTE        = 1 << 2,
+    HAS_BRIGHTNESS     = 1 << 3,
+    HAS_COLOR          = 1 << 4,
+    HAS_WHITE          = 1 << 5,
+    HAS_MIRROR         = 1 << 6,
+    HAS_INTRO          = 1 << 7,
+    HAS_OUTRO          = 1 << 8,
+    HAS_INOUT_DURATION = 1 << 9,
+    HAS_FORCE_WHITE    = 1 << 10,
+    HAS_AUTOTUNE       = 1 << 11,
+    HA_EVENTS          = 1 << 12,
+  };
+
+  const char *effect;
+  const char *strip_tag;
+  uint32_t iterations;
+  float brightness;
+  float inout_duration;
+  uint16_t flags;
+  uint8_t speed;
+  uint8_t intensity;
+  uint8_t palette;
+  uint8_t color_r;
+  uint8_t color_g;
+  uint8_t color_b;
+  uint8_t color_w;
+  uint8_t intro;
+  uint8_t outro;
+  bool mirror;
+  bool force_white;
+  bool autotune;
+
+  bool has(uint16_t flag) const { return (this->flags & flag) != 0; }
+};
+
 class CfxRunActionBase {
 public:
   void set_light(light::LightState *light)     { this->light_     = light; }
-  void set_effect(const std::string &effect)   { this->effect_    = effect; }
-  void set_speed(uint8_t v)                    { this->speed_     = v; }
-  void set_intensity(uint8_t v)                { this->intensity_ = v; }
-  void set_palette(uint8_t v)                  { this->palette_   = v; }
-  void set_brightness(float v)                 { this->brightness_= v; }
-  void set_color_rgb(uint8_t r, uint8_t g, uint8_t b) {
-    this->has_color_ = true;
-    this->color_r_ = r;
-    this->color_g_ = g;
-    this->color_b_ = b;
-    this->color_w_ = 0;
-    this->color_has_white_ = false;
-  }
-  void set_color_rgbw(uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
-    this->has_color_ = true;
-    this->color_r_ = r;
-    this->color_g_ = g;
-    this->color_b_ = b;
-    this->color_w_ = w;
-    this->color_has_white_ = true;
-  }
-  void set_mirror(bool v)                      { this->mirror_    = v; }
-  void set_intro(uint8_t v)                    { this->intro_     = v; }
-  void set_outro(uint8_t v)                    { this->outro_     = v; }
-  void set_inout_duration(float v)             { this->inout_duration_ = v; }
-  void set_force_white(bool v)                 { this->force_white_ = v; }
-  void set_autotune(bool v)                    { this->autotune_ = v; }
-  void set_iterations(uint32_t v)              { this->iterations_ = v; }
-  void set_strip_tag(const std::string &tag)   { this->strip_tag_  = tag; }
+  void set_spec(const CfxRunSpec *spec)        { this->spec_      = spec; }
   void set_nesting_depth(uint8_t depth)        { this->nesting_depth_ = depth; }
-  void set_ha_events(bool v)                   { this->ha_events_ = v; }
 
   // Trigger registration — called by codegen for on_cfx_reach blocks
   // inside cfx_run. Stored and transferred to the spawned sequence at play time.
@@ -594,26 +614,7 @@ protected:
   void do_play_();
 
   light::LightState *light_{nullptr};
-  std::string effect_{};
-  std::string strip_tag_{};
-  esphome::optional<uint8_t>  speed_{};
-  esphome::optional<uint8_t>  intensity_{};
-  esphome::optional<uint8_t>  palette_{};
-  esphome::optional<float>    brightness_{};
-  bool has_color_{false};
-  uint8_t color_r_{0};
-  uint8_t color_g_{0};
-  uint8_t color_b_{0};
-  uint8_t color_w_{0};
-  bool color_has_white_{false};
-  esphome::optional<bool>     mirror_{};
-  esphome::optional<uint8_t>  intro_{};
-  esphome::optional<uint8_t>  outro_{};
-  esphome::optional<float>    inout_duration_{};
-  esphome::optional<bool>     force_white_{};
-  esphome::optional<bool>     autotune_{};
-  bool ha_events_{false};
-  uint32_t iterations_{1};
+  const CfxRunSpec *spec_{nullptr};
   uint8_t  nesting_depth_{0};
 
   std::vector<CfxSeqOnReachTrigger *>    on_reach_triggers_;
@@ -650,15 +651,22 @@ public:
 
   bool is_pool_owned(CFXSequence *seq) const;
 
+  // Pool storage plus the YAML-declared sequences and their registry.
+  size_t memory_bytes() const;
+
 private:
   CFXRunPool() = default;
 
-  // Fixed storage — 16 slots. Lazily heap-allocated on first claim() per slot.
-  // Once allocated, a slot persists for firmware lifetime (never freed).
+  // Fixed storage: each slot's sequence is constructed in place on its
+  // first claim() and lives for the firmware lifetime. Only builds with a
+  // cfx_run action (USE_CFX_RUN) reserve the full pool.
+#ifdef USE_CFX_RUN
   static constexpr uint8_t POOL_SIZE = CFX_RUN_POOL_SIZE;
+#else
+  static constexpr uint8_t POOL_SIZE = 1;
+#endif
 
-  // Lazy allocation: nullptr until first claim() of each slot.
-  // Once allocated, each pointer is valid for the firmware lifetime.
+  alignas(CFXSequence) uint8_t storage_[POOL_SIZE][sizeof(CFXSequence)];
   CFXSequence *sequences_[POOL_SIZE]{};
   CFXRunSlot   slots_[POOL_SIZE]{};
   bool         initialized_{false};
@@ -10,7 +10,9 @@ from esphome.components import (
     light,
     number,
     select,
+    sensor,
     switch,
+    text_sensor,
 )
 from esphome.const import (
     CONF_DISABLED_BY_DEFAULT,
@@ -19,6 +21,7 @@ from esphome.const import (
     CONF_INTERNAL,
     CONF_NAME,
     CONF_RESTORE_MODE,
+    CONF_UPDATE_INTERVAL,
 )
 from esphome.core import CORE, HexInt, TimePeriod, ID as CoreID
 from esphome.final_validate import full_config
@@ -67,6 +70,8 @@ CONF_PEER = "peer"
 CONF_GROUP = "group"
 CONF_KEY = "key"
 CONF_HEARTBEAT = "heartbeat"
+CONF_STATE_INTERVAL = "state_interval"
+CONF_MAX_PEERS = "max_peers"
 CONF_FALLBACK_CHANNEL = "fallback_channel"
 CONF_INPUT_MODE = "input_mode"
 CONF_TRANSPORT = "transport"
@@ -95,6 +100,15 @@ CONF_SPEED = "speed"
 CONF_INTENSITY = "intensity"
 CONF_MIRROR = "mirror"
 CONF_PALETTE = "palette"
+CONF_PIXEL_STREAM = "pixel_stream"
+CONF_PIXEL_STREAM_INTERVAL = "pixel_stream_interval"
+CONF_PIXEL_LIGHTS = "_pixel_lights"
+CONF_RX_TASK = "rx_task"
+CONF_TELEMETRY = "telemetry"
+CONF_STATE_RTT = "state_rtt"
+CONF_INPUT_LATENCY = "input_latency"
+CONF_ACK_LOSS = "ack_loss"
+CONF_SLOWEST_PEER = "slowest_peer"
 
 ROLE_LEADER = "leader"
 ROLE_FOLLOWER = "follower"
@@ -115,6 +129,12 @@ EXCLUDE_FORCE_WHITE = 8
 
 MIN_HEARTBEAT = TimePeriod(seconds=10)
 MAX_HEARTBEAT = TimePeriod(minutes=5)
+DEFAULT_MAX_PEERS = 8
+MAX_PEERS_LIMIT = 64
+MIN_STATE_INTERVAL = TimePeriod(milliseconds=0)
+MAX_STATE_INTERVAL = TimePeriod(milliseconds=500)
+MIN_PIXEL_STREAM_INTERVAL = TimePeriod(milliseconds=10)
+MAX_PIXEL_STREAM_INTERVAL = TimePeriod(seconds=1)
 MAX_EFFECT_NAME_BYTES = 64
 DEFAULT_FALLBACK_CHANNEL = 6
 KEY_DERIVATION_PREFIX = b"CFX_SYNC_V1\x00"
@@ -124,6 +144,10 @@ CFXSyncComponent = cfx_sync_ns.class_("CFXSyncComponent", cg.Component)
 CFXSyncEnableSwitch = cfx_sync_ns.class_(
     "CFXSyncEnableSwitch", switch.Switch
 )
+CFXSyncServiceHandler = cfx_sync_ns.class_(
+    "CFXSyncServiceHandler", cg.Component
+)
+SERVICE_HANDLER_ID = "cfx_sync_service_handler"
 CFXSyncRole = cfx_sync_ns.enum("CFXSyncRole")
 CFXSyncInputMode = cfx_sync_ns.enum("CFXSyncInputMode", is_class=True)
 CFXSyncTransport = cfx_sync_ns.enum("CFXSyncTransport", is_class=True)
@@ -180,9 +204,14 @@ def AUTO_LOAD(config):
         if any(item.get(CONF_ROLE) == ROLE_SATELLITE for item in configs):
             return ESP8266_SATELLITE_AUTO_LOAD
         return ESP8266_CONTROLLER_AUTO_LOAD
+    telemetry = (
+        ["sensor", "text_sensor"]
+        if any(CONF_TELEMETRY in item for item in configs)
+        else []
+    )
     if all(transport == TRANSPORT_UDP for transport in transports):
-        return BASE_AUTO_LOAD
-    return BASE_AUTO_LOAD + ["espnow"]
+        return BASE_AUTO_LOAD + telemetry
+    return BASE_AUTO_LOAD + ["espnow"] + telemetry
 
 
 def _normalize_lights(value):
@@ -222,6 +251,29 @@ def _find_cfx_light_target(light_id, all_lights):
     return None
 
 
+# Light platforms whose output is a light::AddressableLight. Pixel-stream
+# frames are written straight into such an output.
+ADDRESSABLE_LIGHT_PLATFORMS = {
+    "cfx_light",
+    "beken_spi_led_strip",
+    "esp32_rmt_led_strip",
+    "fastled_clockless",
+    "fastled_spi",
+    "neopixelbus",
+    "partition",
+    "rp2040_pio_led_strip",
+    "spi_led_strip",
+}
+
+
+def _is_pixel_light(light_id, all_lights):
+    source_config = _find_effect_source_config(light_id, all_lights)
+    return (
+        source_config is not None
+        and source_config.get(CONF_PLATFORM) in ADDRESSABLE_LIGHT_PLATFORMS
+    )
+
+
 def _has_white_channel(light_config):
     return (
         light_config.get(CONF_IS_RGBW, False)
@@ -363,6 +415,20 @@ def _validate_role_lights(config):
         raise cv.Invalid("cfx_sync satellite requires at least one light")
     if role in (ROLE_FOLLOWER, ROLE_SATELLITE) and CONF_REMOTE_INPUT in config:
         raise cv.Invalid("remote_input can only be used with role: leader")
+    if config.get(CONF_PIXEL_STREAM, False) and (
+        role == ROLE_CONTROLLER or _is_esp8266_target()
+    ):
+        raise cv.Invalid(
+            "pixel_stream can only be used by an ESP32 leader, follower or "
+            "satellite"
+        )
+    if CONF_TELEMETRY in config and _is_esp8266_target():
+        raise cv.Invalid("telemetry is only supported on ESP32")
+    if config.get(CONF_RX_TASK, False):
+        if _is_esp8266_target():
+            raise cv.Invalid("rx_task is only supported on ESP32")
+        if config.get(CONF_TRANSPORT) == TRANSPORT_ESPNOW:
+            raise cv.Invalid("rx_task applies to the UDP transport only")
 
     seen = set()
     for light_id in lights:
@@ -552,6 +618,21 @@ def _final_validate(config):
         control_ids.append(_extract_control_ids(light_id, all_lights))
     config[CONF_EFFECT_CATALOGS] = effect_catalogs
     config[CONF_CONTROL_IDS] = control_ids
+
+    if config.get(CONF_PIXEL_STREAM, False):
+        pixel_lights = [
+            _is_pixel_light(light_id, all_lights)
+            for light_id in config[CONF_LIGHTS]
+        ]
+        if config[CONF_ROLE] == ROLE_LEADER and not pixel_lights[0]:
+            raise cv.Invalid(
+                "pixel_stream on a leader requires an addressable light"
+            )
+        if not any(pixel_lights):
+            raise cv.Invalid(
+                "pixel_stream requires at least one addressable light"
+            )
+        config[CONF_PIXEL_LIGHTS] = pixel_lights
     return config
 
 
@@ -590,6 +671,41 @@ def _validate_transport_dependencies(config):
     return config
 
 
+_LATENCY_MS_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement="ms",
+    icon="mdi:timer-outline",
+    accuracy_decimals=1,
+    state_class="measurement",
+)
+
+# (yaml key, C++ setter, schema); each reports the worst peer.
+_TELEMETRY_SENSORS = (
+    (CONF_STATE_RTT, "set_state_rtt_sensor", _LATENCY_MS_SCHEMA),
+    (CONF_INPUT_LATENCY, "set_input_latency_sensor", _LATENCY_MS_SCHEMA),
+    (
+        CONF_ACK_LOSS,
+        "set_ack_loss_sensor",
+        sensor.sensor_schema(
+            unit_of_measurement="%",
+            icon="mdi:lan-disconnect",
+            accuracy_decimals=0,
+            state_class="measurement",
+        ),
+    ),
+)
+
+TELEMETRY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(
+            CONF_UPDATE_INTERVAL, default="30s"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SLOWEST_PEER): text_sensor.text_sensor_schema(
+            icon="mdi:lan-pending",
+        ),
+        **{cv.Optional(key): schema for key, _, schema in _TELEMETRY_SENSORS},
+    }
+)
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -624,6 +740,15 @@ CONFIG_SCHEMA = cv.All(
                 cv.positive_time_period_milliseconds,
                 cv.Range(min=MIN_HEARTBEAT, max=MAX_HEARTBEAT),
             ),
+            cv.Optional(
+                CONF_STATE_INTERVAL, default="20ms"
+            ): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=MIN_STATE_INTERVAL, max=MAX_STATE_INTERVAL),
+            ),
+            cv.Optional(CONF_MAX_PEERS, default=DEFAULT_MAX_PEERS): cv.All(
+                cv.int_, cv.Range(min=1, max=MAX_PEERS_LIMIT)
+            ),
             cv.Optional(CONF_FALLBACK_CHANNEL, default=DEFAULT_FALLBACK_CHANNEL): cv.All(
                 cv.int_, cv.Range(min=1, max=14)
             ),
@@ -639,6 +764,18 @@ CONFIG_SCHEMA = cv.All(
                 TRANSPORT_UDP,
                 lower=True,
             ),
+            cv.Optional(CONF_PIXEL_STREAM, default=False): cv.boolean,
+            cv.Optional(CONF_RX_TASK, default=False): cv.boolean,
+            cv.Optional(CONF_TELEMETRY): TELEMETRY_SCHEMA,
+            cv.Optional(
+                CONF_PIXEL_STREAM_INTERVAL, default="40ms"
+            ): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(
+                    min=MIN_PIXEL_STREAM_INTERVAL,
+                    max=MAX_PIXEL_STREAM_INTERVAL,
+                ),
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     cv.only_on(["esp32", "esp8266"]),
@@ -650,6 +787,36 @@ CONFIG_SCHEMA = cv.All(
 FINAL_VALIDATE_SCHEMA = _final_validate
 
 
+async def _telemetry_to_code(var, config):
+    cg.add_define("USE_CFX_SYNC_TELEMETRY")
+    cg.add(
+        var.set_telemetry_interval_ms(
+            config[CONF_UPDATE_INTERVAL].total_milliseconds
+        )
+    )
+    for key, setter, _ in _TELEMETRY_SENSORS:
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
+    if CONF_SLOWEST_PEER in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_SLOWEST_PEER])
+        cg.add(var.set_slowest_peer_text_sensor(sens))
+
+    # HA services: cfx_sync_peer_stats / cfx_sync_peer_stats_reset, shared
+    # by every group.
+    if "api" in CORE.config and SERVICE_HANDLER_ID not in CORE.component_ids:
+        cg.add_define("USE_API_USER_DEFINED_ACTIONS")
+        cg.add_define("USE_API_CUSTOM_SERVICES")
+        svc_id = CoreID(
+            SERVICE_HANDLER_ID,
+            is_declaration=True,
+            type=CFXSyncServiceHandler,
+        )
+        svc_var = cg.new_Pvariable(svc_id)
+        CORE.component_ids.add(SERVICE_HANDLER_ID)
+        await cg.register_component(svc_var, {})
+
+
 async def to_code(config):
     config.setdefault(CONF_INPUT_MODE, INPUT_MODE_MOMENTARY)
     config.setdefault(CONF_FALLBACK_CHANNEL, DEFAULT_FALLBACK_CHANNEL)
@@ -767,6 +934,8 @@ async def to_code(config):
         cg.add(sync_switch.set_parent(var))
         cg.add(var.set_sync_switch(sync_switch))
     cg.add(var.set_role(ROLE_MAP[config[CONF_ROLE]]))
+    if config[CONF_MAX_PEERS] != DEFAULT_MAX_PEERS:
+        cg.add(var.set_max_peers(config[CONF_MAX_PEERS]))
     cg.add(var.set_transport(TRANSPORT_MAP[config[CONF_TRANSPORT]]))
     cg.add(var.set_input_mode(INPUT_MODE_MAP[config[CONF_INPUT_MODE]]))
     cg.add(var.set_fallback_channel(config[CONF_FALLBACK_CHANNEL]))
@@ -775,3 +944,25 @@ async def to_code(config):
     cg.add(
         var.set_heartbeat_ms(config[CONF_HEARTBEAT].total_milliseconds)
     )
+    if config[CONF_ROLE] == ROLE_LEADER:
+        cg.add(
+            var.set_state_interval_ms(
+                config[CONF_STATE_INTERVAL].total_milliseconds
+            )
+        )
+    if config.get(CONF_RX_TASK, False):
+        cg.add(var.set_rx_task(True))
+    if CONF_TELEMETRY in config:
+        await _telemetry_to_code(var, config[CONF_TELEMETRY])
+    if config.get(CONF_PIXEL_STREAM, False):
+        cg.add(var.set_pixel_stream(True))
+        cg.add(
+            var.set_pixel_stream_interval_ms(
+                config[CONF_PIXEL_STREAM_INTERVAL].total_milliseconds
+            )
+        )
+        for light_index, is_pixel in enumerate(
+            config.get(CONF_PIXEL_LIGHTS, [])
+        ):
+            if is_pixel:
+                cg.add(var.set_pixel_light(light_index))
@@ -10,10 +10,14 @@
 #if defined(USE_ESP32) && defined(USE_WIFI)
 #include "esphome/components/wifi/wifi_component.h"
 #endif
+#if defined(USE_ESP32)
+#include "esphome/components/light/addressable_light.h"
+#endif
 
 #if defined(USE_ESP32)
 #include <esp_err.h>
 #include <esp_random.h>
+#include <esp_timer.h>
 #include <esp_wifi.h>
 #elif defined(USE_ESP8266)
 #include <Arduino.h>
@@ -21,6 +25,7 @@ static uint32_t esp_random() { return static_cast<uint32_t>(::random()); }
 #endif
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <inttypes.h>
 #include <limits>
@@ -153,11 +158,24 @@ uint16_t CFXSyncComponent::local_capabilities_() const {
   if (this->role_ == CFXSyncRole::CFX_SYNC_ROLE_CONTROLLER) {
     return CFXSyncPacketCodec::CAP_BINARY_REMOTE;
   }
+  uint16_t capabilities = CFXSyncPacketCodec::CAP_LIGHT_FOLLOWER;
   if (this->role_ == CFXSyncRole::SATELLITE) {
-    return CFXSyncPacketCodec::CAP_LIGHT_FOLLOWER |
-           CFXSyncPacketCodec::CAP_BINARY_REMOTE;
+    capabilities |= CFXSyncPacketCodec::CAP_BINARY_REMOTE;
+  }
+#if defined(USE_ESP32)
+  if (this->pixel_stream_) {
+    capabilities |= CFXSyncPacketCodec::CAP_PIXEL_FOLLOWER;
+  }
+#endif
+  if (this->use_udp_transport_() &&
+      this->bus_->is_udp_group_joined(this->udp_group_address_())) {
+    capabilities |= CFXSyncPacketCodec::CAP_UDP_GROUP;
   }
-  return CFXSyncPacketCodec::CAP_LIGHT_FOLLOWER;
+  return capabilities;
+}
+
+uint32_t CFXSyncComponent::udp_group_address_() const {
+  return CFXSyncUDPTransport::group_address(this->group_hash_);
 }
 
 bool CFXSyncComponent::is_state_receiver_role_() const {
@@ -280,6 +298,9 @@ void CFXSyncComponent::setup() {
       this->mark_failed();
       return;
     }
+    if (this->is_state_receiver_role_()) {
+      this->bus_->join_udp_group(this->udp_group_address_());
+    }
     transport_started = true;
   }
   if (this->use_espnow_transport_()) {
@@ -310,6 +331,16 @@ void CFXSyncComponent::setup() {
     return;
   }
   this->bus_->register_group(this);
+#if defined(USE_ESP32)
+  if (this->rx_task_ && this->use_udp_transport_() &&
+      !this->bus_->start_rx_task()) {
+    ESP_LOGW(TAG, "UDP receive stays on the main loop");
+  }
+#endif
+#ifdef USE_CFX_SYNC_TELEMETRY
+  this->set_interval("telemetry", this->telemetry_interval_ms_,
+                     [this]() { this->publish_telemetry_(); });
+#endif
   this->boot_discovery_started_ms_ = millis();
   this->schedule_boot_discovery_();
   if (this->role_ != CFXSyncRole::LEADER) {
@@ -353,9 +384,24 @@ void CFXSyncComponent::setup() {
     this->register_control_callbacks_(0);
     this->set_interval("heartbeat", this->heartbeat_ms_,
                        [this]() { this->send_heartbeat_state_(); });
+    auto &clock = CFXSyncGroupClock::get();
+    clock.set_source();
+    clock.add_channel(leader);
+    this->set_interval("timebase", TIMEBASE_CHECK_INTERVAL_MS,
+                       [this]() { this->check_timebase_epoch_(); });
   } else if (this->is_state_receiver_role_()) {
+    for (auto *light : this->lights_) {
+      if (!CFXSyncGroupClock::get().add_channel(light)) {
+        ESP_LOGW(TAG, "Group clock full; %s keeps its own effect timeline",
+                 light->get_name().c_str());
+      }
+    }
     this->schedule_follower_recovery_();
   }
+  if (this->pixel_stream_) {
+    this->set_interval("pixel-stream", this->pixel_stream_interval_ms_,
+                       [this]() { this->service_pixel_stream_(millis()); });
+  }
 #endif
   if (this->role_ == CFXSyncRole::SATELLITE && this->local_light_input_) {
     if (this->lights_.size() != 1 || this->lights_[0] == nullptr) {
@@ -458,6 +504,23 @@ void CFXSyncComponent::loop() {
 #endif
 }
 
+#if defined(USE_ESP32)
+size_t CFXSyncComponent::memory_bytes() const {
+  size_t bytes = this->peers_.capacity() * sizeof(PeerState);
+  bytes += this->pixel_tx_frame_.capacity() + this->pixel_tx_sent_.capacity() +
+           this->pixel_tx_dirty_.capacity() + this->pixel_tx_packet_.capacity();
+  bytes += this->last_state_retry_packet_.capacity() +
+           this->state_tx_packet_.capacity();
+  for (const auto &sink : this->pixel_sinks_) {
+    bytes += sizeof(PixelSink) + sink.pixels.capacity();
+  }
+  for (const auto &catalog : this->effect_catalogs_) {
+    bytes += catalog.capacity() * sizeof(CFXSyncEffectEntry);
+  }
+  return bytes;
+}
+#endif
+
 void CFXSyncComponent::dump_config() {
   const uint32_t packet_age =
       this->last_valid_packet_ms_ == 0
@@ -498,6 +561,27 @@ void CFXSyncComponent::dump_config() {
   }
 #endif
 #if defined(USE_ESP32)
+  if (this->role_ == CFXSyncRole::LEADER) {
+    ESP_LOGCONFIG(TAG,
+                  "  State interval: %" PRIu32 " ms\n"
+                  "  State sends: full=%" PRIu32 " delta=%" PRIu32
+                  " coalesced=%" PRIu32,
+                  this->state_tx_.interval_ms(), this->state_tx_.full_sent(),
+                  this->state_tx_.delta_sent(), this->state_tx_.coalesced());
+  }
+  if (this->rx_task_) {
+    ESP_LOGCONFIG(TAG, "  Receive task: %s (ring full=%" PRIu32 ")",
+                  YESNO(this->bus_->is_rx_task_running()),
+                  this->bus_->rx_deferred());
+  }
+#ifdef USE_CFX_SYNC_TELEMETRY
+  ESP_LOGCONFIG(TAG, "  Telemetry interval: %" PRIu32 " ms",
+                this->telemetry_interval_ms_);
+  LOG_SENSOR("  ", "State round trip", this->state_rtt_sensor_);
+  LOG_SENSOR("  ", "Input latency", this->input_latency_sensor_);
+  LOG_SENSOR("  ", "ACK loss", this->ack_loss_sensor_);
+  LOG_TEXT_SENSOR("  ", "Slowest peer", this->slowest_peer_sensor_);
+#endif
   ESP_LOGCONFIG(TAG, "  Lights: %u",
                 static_cast<unsigned>(this->lights_.size()));
   ESP_LOGCONFIG(TAG, "  Wi-Fi channel: %u",
@@ -526,6 +610,15 @@ void CFXSyncComponent::dump_config() {
   ESP_LOGCONFIG(TAG,
                 "  State fanout: espnow=%" PRIu32 " udp=%" PRIu32,
                 this->espnow_state_sent_, this->udp_state_sent_);
+#if defined(USE_ESP32)
+  if (this->pixel_stream_) {
+    ESP_LOGCONFIG(TAG,
+                  "  Pixel stream: interval=%" PRIu32 " ms frames=%" PRIu32
+                  " chunks sent=%" PRIu32 " received=%" PRIu32,
+                  this->pixel_stream_interval_ms_, this->pixel_frames_sent_,
+                  this->pixel_chunks_sent_, this->pixel_chunks_received_);
+  }
+#endif
 }
 
 bool CFXSyncComponent::handle_unknown_packet_(const CFXSyncSource &source,
@@ -579,6 +672,31 @@ bool CFXSyncComponent::handle_packet_(const CFXSyncSource &source,
   return this->handle_decoded_packet_(source, packet);
 }
 
+#if defined(USE_ESP32)
+bool CFXSyncComponent::handle_rx_packet_(const CFXSyncSource &source,
+                                         CFXSyncDecodeResult result,
+                                         const CFXSyncPacket &packet,
+                                         uint64_t received_us) {
+  // Decoded by the bus receive task; otherwise as handle_packet_().
+  if (result == CFXSyncDecodeResult::NOT_CFX) {
+    return false;
+  }
+  if (result == CFXSyncDecodeResult::WRONG_GROUP) {
+    this->handle_decode_failure_(result);
+    return false;
+  }
+  if (result != CFXSyncDecodeResult::OK) {
+    this->handle_decode_failure_(result);
+    return true;
+  }
+
+  this->rx_task_received_us_ = received_us;
+  const bool handled = this->handle_decoded_packet_(source, packet);
+  this->rx_task_received_us_ = 0;
+  return handled;
+}
+#endif
+
 bool CFXSyncComponent::handle_decoded_packet_(
     const CFXSyncSource &source, const CFXSyncPacket &packet) {
   if (!source.identity_valid) {
@@ -587,6 +705,9 @@ bool CFXSyncComponent::handle_decoded_packet_(
   }
 
   auto *peer = this->find_peer_(source);
+#ifdef USE_CFX_TRACE
+  this->bus_->observe_packet(false, static_cast<uint16_t>(packet.type));
+#endif
   if (packet.type == CFXSyncPacketType::HELLO) {
     if (this->is_state_receiver_role_() &&
         (packet.node_role == CFXSyncNodeRole::FOLLOWER ||
@@ -618,6 +739,7 @@ bool CFXSyncComponent::handle_decoded_packet_(
     if (this->role_ == CFXSyncRole::LEADER &&
         this->should_send_state_for_hello_(*peer, new_peer,
                                            peer_rebooted)) {
+      this->state_tx_.request_full();
       this->send_state_();
     }
 #endif
@@ -647,6 +769,7 @@ bool CFXSyncComponent::handle_decoded_packet_(
     this->last_valid_packet_ms_ = millis();
     if (this->role_ == CFXSyncRole::LEADER &&
         this->peer_accepts_leader_state_(*peer)) {
+      this->state_tx_.request_full();
       this->send_state_();
     }
 #endif
@@ -718,9 +841,13 @@ bool CFXSyncComponent::handle_decoded_packet_(
     }
     this->received_packets_++;
     this->last_valid_packet_ms_ = millis();
+    const uint64_t input_rx_us = this->rx_task_received_us_ != 0
+                                     ? this->rx_task_received_us_
+                                     : esp_timer_get_time();
     const bool applied = this->handle_remote_input_(
         *peer, packet.input_pressed, packet.input_maintained,
         packet.input_toggle, packet.input_action);
+    this->record_input_apply_(*peer, applied, input_rx_us);
     if (source.transport == CFXSyncTransportKind::UDP) {
       this->udp_input_received_++;
     }
@@ -761,7 +888,11 @@ bool CFXSyncComponent::handle_decoded_packet_(
     }
     this->received_packets_++;
     this->last_valid_packet_ms_ = millis();
+    const uint64_t input_rx_us = this->rx_task_received_us_ != 0
+                                     ? this->rx_task_received_us_
+                                     : esp_timer_get_time();
     const bool applied = this->handle_remote_light_command_(*peer, packet);
+    this->record_input_apply_(*peer, applied, input_rx_us);
     if (source.transport == CFXSyncTransportKind::UDP) {
       this->udp_input_received_++;
     }
@@ -775,12 +906,40 @@ bool CFXSyncComponent::handle_decoded_packet_(
     return true;
   }
 
+  if (packet.type == CFXSyncPacketType::PIXEL_FRAME) {
+#if defined(USE_ESP32)
+    if (!this->pixel_stream_ || !this->is_state_receiver_role_() ||
+        !this->sync_enabled_ || peer == nullptr ||
+        peer->node_role != CFXSyncNodeRole::LEADER) {
+      this->log_rejection_("Ignoring PIXEL_FRAME for incompatible role");
+      return true;
+    }
+    peer->last_seen_ms = millis();
+    if (!this->accept_pixel_sequence_(*peer, packet.boot_id,
+                                      packet.sequence)) {
+      this->stale_packets_++;
+      this->log_rejection_("Ignoring duplicate or stale pixel chunk");
+      return true;
+    }
+    this->received_packets_++;
+    this->last_valid_packet_ms_ = peer->last_seen_ms;
+    this->handle_pixel_frame_(*peer, packet);
+#endif
+    return true;
+  }
+
   if (peer == nullptr) {
     this->log_rejection_("Ignoring authenticated packet from unknown peer");
     return true;
   }
 
   peer->last_seen_ms = millis();
+#if defined(USE_ESP32)
+  // Before any apply work, so ACK hold times and clock samples see it.
+  this->packet_rx_us_ = this->rx_task_received_us_ != 0
+                            ? this->rx_task_received_us_
+                            : esp_timer_get_time();
+#endif
   if (!this->accept_sequence_(*peer, packet.boot_id, packet.sequence)) {
     if (packet.type == CFXSyncPacketType::STATE &&
         this->is_state_receiver_role_() &&
@@ -829,8 +988,16 @@ bool CFXSyncComponent::handle_decoded_packet_(
        packet.has_color_brightness || packet.has_effect ||
        packet.has_controls || packet.has_color_temperature ||
        packet.has_cold_warm_white)) {
-    this->has_valid_state_ = true;
-    this->clear_warning_if_set_();
+    // A delta only moves what changed; it is applied and acked, but the
+    // follower is not in sync until a full snapshot lands.
+    if ((packet.flags & CFXSyncPacketCodec::FLAG_STATE_DELTA) == 0) {
+      this->has_valid_state_ = true;
+      this->clear_warning_if_set_();
+    }
+#if defined(USE_ESP32)
+    // Epochs go in before the apply so restarted effects start in phase.
+    this->handle_timebase_(packet);
+#endif
     const bool applied = this->apply_remote_state_(packet);
     if (this->role_ == CFXSyncRole::SATELLITE && applied) {
       if (this->local_light_input_ && this->lights_.size() == 1 &&
@@ -869,6 +1036,11 @@ void CFXSyncComponent::on_local_light_update() {
       controls == this->observed_controls_) {
     return;
   }
+  if (effect != this->observed_effect_) {
+    // The effect restart that follows moves it again by a frame or two;
+    // check_timebase_epoch_() only resends when that matters.
+    CFXSyncGroupClock::get().set_epoch(leader, esp_timer_get_time());
+  }
   this->has_observed_state_ = true;
   this->observed_state_ = snapshot;
   this->observed_effect_ = effect;
@@ -883,6 +1055,9 @@ void CFXSyncComponent::on_sync_enabled_switch(bool enabled) {
   if (!this->is_state_receiver_role_()) {
     return;
   }
+  if (!enabled) {
+    CFXSyncGroupClock::get().unlock();
+  }
   this->has_valid_state_ = false;
   this->clear_warning_if_set_();
   if (enabled) {
@@ -920,6 +1095,7 @@ bool CFXSyncComponent::send_state_(
 }
 
 bool CFXSyncComponent::send_heartbeat_state_() {
+  this->state_tx_.request_full();
   return this->send_state_();
 }
 
@@ -958,16 +1134,37 @@ bool CFXSyncComponent::send_state_to_followers_(
     return false;
   }
 
-  std::vector<uint8_t> packet;
+  const uint32_t now = millis();
+  const uint32_t wait_ms = this->state_tx_.wait_ms(now);
+  if (wait_ms != 0) {
+    // Paced: the latest update waits for the slot; anything it replaces is
+    // never sent.
+    this->state_tx_.hold(snapshot, effect, controls, timing);
+    this->set_timeout("state-tx", wait_ms,
+                      [this]() { this->flush_state_tx_(); });
+    return true;
+  }
+
+  auto &packet = this->state_tx_packet_;
   const uint32_t sequence = this->next_sequence_();
-  if (!CFXSyncPacketCodec::encode_state_snapshot(
+  const auto timed = this->with_timebase_(timing);
+  const uint32_t fields =
+      this->state_tx_.fields_for(snapshot, effect, controls);
+  const bool full = fields == CFXSyncStateTx::FULL;
+  if (full && !CFXSyncPacketCodec::encode_state_snapshot(
           this->group_hash_, this->boot_id_, sequence, snapshot, true, effect,
-          controls.has_any(), controls, timing, this->key_, packet)) {
+          controls.has_any(), controls, timed, this->key_, packet)) {
+    return false;
+  }
+  if (!full && !CFXSyncPacketCodec::encode_state_delta(
+          this->group_hash_, this->boot_id_, sequence, snapshot, fields,
+          effect, controls, timed, this->key_, packet)) {
     return false;
   }
   if (!this->send_state_packet_to_followers_(packet)) {
     return false;
   }
+  this->state_tx_.sent(now, sequence, fields, snapshot, effect, controls);
   this->last_state_retry_packet_ = packet;
   this->last_state_retry_packet_valid_ = true;
   if (!this->state_retry_active_) {
@@ -978,8 +1175,32 @@ bool CFXSyncComponent::send_state_to_followers_(
   return true;
 }
 
+void CFXSyncComponent::flush_state_tx_() {
+  if (this->role_ != CFXSyncRole::LEADER || !this->state_tx_.has_held()) {
+    return;
+  }
+  const auto update = this->state_tx_.held();
+  this->state_tx_.drop_held();
+  this->send_state_to_followers_(update.snapshot, update.effect,
+                                 update.controls, update.timing);
+}
+
+void CFXSyncComponent::confirm_state_baseline_() {
+  // Only a broadcast every follower acked is a baseline; a peer whose last
+  // STATE was addressed to it alone may hold something else.
+  for (const auto &peer : this->peers_) {
+    if (this->peer_accepts_leader_state_(peer) &&
+        (peer.last_ack_boot_id != this->last_broadcast_state_boot_id_ ||
+         peer.last_ack_sequence != this->last_broadcast_state_sequence_)) {
+      return;
+    }
+  }
+  this->state_tx_.confirm(this->last_broadcast_state_sequence_);
+}
+
 void CFXSyncComponent::mark_state_sent_to_followers_(uint32_t sequence) {
   const uint32_t now = millis();
+  const uint64_t now_us = esp_timer_get_time();
   this->last_broadcast_state_boot_id_ = this->boot_id_;
   this->last_broadcast_state_sequence_ = sequence;
   this->last_broadcast_state_ms_ = now;
@@ -990,6 +1211,8 @@ void CFXSyncComponent::mark_state_sent_to_followers_(uint32_t sequence) {
     peer.last_state_sent_boot_id = this->boot_id_;
     peer.last_state_sent_sequence = sequence;
     peer.last_state_sent_ms = now;
+    peer.last_state_sent_us = now_us;
+    peer.stats.states_sent++;
   }
 }
 
@@ -1022,13 +1245,14 @@ bool CFXSyncComponent::send_state_to_peer_(
     return false;
   }
 
-  std::vector<uint8_t> packet;
+  auto &packet = this->state_tx_packet_;
   auto *leader = this->leader_light_();
   const auto timing = capture_sync_timing_state(leader, snapshot, effect, false);
+  const auto timed = this->with_timebase_(timing);
   const uint32_t sequence = this->next_sequence_();
   if (!CFXSyncPacketCodec::encode_state_snapshot(
           this->group_hash_, this->boot_id_, sequence, snapshot, true, effect,
-          controls.has_any(), controls, timing, this->key_, packet)) {
+          controls.has_any(), controls, timed, this->key_, packet)) {
     return false;
   }
   if (!this->send_packet_to_peer_(peer, packet)) {
@@ -1037,6 +1261,9 @@ bool CFXSyncComponent::send_state_to_peer_(
   peer.last_state_sent_boot_id = this->boot_id_;
   peer.last_state_sent_sequence = sequence;
   peer.last_state_sent_ms = millis();
+  peer.last_state_sent_us = esp_timer_get_time();
+  peer.stats.states_sent++;
+  this->state_tx_.invalidate();
   return true;
 }
 
@@ -1118,6 +1345,21 @@ bool CFXSyncComponent::send_state_ack_(const uint8_t *destination,
           packet.boot_id, packet.sequence, result, this->key_, ack)) {
     return false;
   }
+  return this->send_state_ack_packet_(ack);
+}
+
+bool CFXSyncComponent::send_state_ack_packet_(std::vector<uint8_t> &ack) {
+  // Only the leader reads ACKs. Over UDP it gets them directly, so a large
+  // group does not hear every follower's reply.
+  if (this->use_udp_transport_() && !this->use_espnow_transport_()) {
+    for (size_t i = 0; i < this->peer_count_; i++) {
+      auto &peer = this->peers_[i];
+      if (peer.node_role == CFXSyncNodeRole::LEADER &&
+          peer.transport == CFXSyncTransportKind::UDP) {
+        return this->send_packet_to_peer_(peer, ack);
+      }
+    }
+  }
   return this->send_packet_to_(BROADCAST_MAC, ack);
 }
 
@@ -1127,18 +1369,34 @@ void CFXSyncComponent::schedule_state_ack_(const uint8_t *destination,
   (void) destination;
   const uint32_t acked_boot_id = packet.boot_id;
   const uint32_t acked_sequence = packet.sequence;
+  // A leader that sent a timebase takes the hold time off the round trip;
+  // older leaders never get the longer ACK.
+#if defined(USE_ESP32)
+  const bool timed = packet.has_timebase;
+  const uint64_t received_us = this->packet_rx_us_;
+#else
+  const bool timed = false;
+  const uint64_t received_us = 0;
+#endif
   const uint32_t delay_ms =
       ACK_JITTER_MIN_MS + (esp_random() % (ACK_JITTER_SPREAD_MS + 1));
   this->set_timeout(
       "state-ack", delay_ms,
-      [this, acked_boot_id, acked_sequence, result]() {
+      [this, acked_boot_id, acked_sequence, result, timed, received_us]() {
+        uint32_t hold_us = 0;
+#if defined(USE_ESP32)
+        hold_us = static_cast<uint32_t>(esp_timer_get_time() - received_us);
+#else
+        (void) received_us;
+#endif
         std::vector<uint8_t> ack;
         if (!CFXSyncPacketCodec::encode_state_ack(
                 this->group_hash_, this->boot_id_, this->next_sequence_(),
-                acked_boot_id, acked_sequence, result, this->key_, ack)) {
+                acked_boot_id, acked_sequence, result, timed, hold_us,
+                this->key_, ack)) {
           return;
         }
-        this->send_packet_to_(BROADCAST_MAC, ack);
+        this->send_state_ack_packet_(ack);
       });
 }
 
@@ -2030,6 +2288,9 @@ bool CFXSyncComponent::send_udp_packet_(std::vector<uint8_t> &packet) {
   this->handle_send_result_(ESP_OK);
 #endif
   this->sent_packets_++;
+#ifdef USE_CFX_TRACE
+  this->bus_->observe_packet(true, static_cast<uint16_t>(packet.size()));
+#endif
 #if defined(USE_ESP32)
   this->flush_deferred_state_();
 #endif
@@ -2050,6 +2311,9 @@ bool CFXSyncComponent::send_udp_packet_to_(uint32_t ipv4, uint16_t port,
   this->handle_send_result_(ESP_OK);
 #endif
   this->sent_packets_++;
+#ifdef USE_CFX_TRACE
+  this->bus_->observe_packet(true, static_cast<uint16_t>(packet.size()));
+#endif
 #if defined(USE_ESP32)
   this->flush_deferred_state_();
 #endif
@@ -2076,6 +2340,9 @@ bool CFXSyncComponent::send_espnow_packet_to_(
         if (send_result == ESP_OK) {
           this->flush_deferred_state_();
         }
+#if defined(USE_ESP32)
+        this->pump_pixel_stream_();
+#endif
       });
   if (result != ESP_OK) {
     this->send_pending_ = false;
@@ -2083,6 +2350,9 @@ bool CFXSyncComponent::send_espnow_packet_to_(
     return false;
   }
   this->sent_packets_++;
+#ifdef USE_CFX_TRACE
+  this->bus_->observe_packet(true, static_cast<uint16_t>(packet.size()));
+#endif
   return true;
 #else
   (void) mac;
@@ -2100,11 +2370,62 @@ bool CFXSyncComponent::send_packet_to_(const std::array<uint8_t, 6> &mac,
   return this->send_espnow_packet_to_(mac, packet);
 }
 
+bool CFXSyncComponent::followers_join_udp_group_() const {
+#if defined(USE_ESP32)
+  if (this->udp_group_disabled_) {
+    return false;
+  }
+  bool any = false;
+  for (size_t i = 0; i < this->peer_count_; i++) {
+    const auto &peer = this->peers_[i];
+    if (peer.transport != CFXSyncTransportKind::UDP ||
+        !this->peer_accepts_leader_state_(peer)) {
+      continue;
+    }
+    if ((peer.capabilities & CFXSyncPacketCodec::CAP_UDP_GROUP) == 0) {
+      return false;
+    }
+    any = true;
+  }
+  return any;
+#else
+  return false;
+#endif
+}
+
+bool CFXSyncComponent::send_udp_follower_packet_(
+    std::vector<uint8_t> &packet) {
+  if (!this->followers_join_udp_group_()) {
+    return this->send_udp_packet_(packet);
+  }
+  // Every UDP follower listens on the group: one datagram instead of a
+  // subnet plus a limited broadcast that wakes every node on the LAN.
+  if (!this->bus_->send_udp_group(this->udp_group_address_(), packet)) {
+#if defined(USE_ESP32)
+    this->handle_send_result_(ESP_FAIL);
+#else
+    this->send_failures_++;
+#endif
+    return false;
+  }
+#if defined(USE_ESP32)
+  this->handle_send_result_(ESP_OK);
+#endif
+  this->sent_packets_++;
+#ifdef USE_CFX_TRACE
+  this->bus_->observe_packet(true, static_cast<uint16_t>(packet.size()));
+#endif
+#if defined(USE_ESP32)
+  this->flush_deferred_state_();
+#endif
+  return true;
+}
+
 bool CFXSyncComponent::send_state_packet_to_followers_(
     std::vector<uint8_t> &packet) {
   bool sent = false;
   if (this->use_udp_transport_()) {
-    if (this->send_udp_packet_(packet)) {
+    if (this->send_udp_follower_packet_(packet)) {
       this->udp_state_sent_++;
       sent = true;
     }
@@ -2142,6 +2463,9 @@ bool CFXSyncComponent::send_packet_to_peer_(PeerState &peer,
         this->handle_peer_send_result_(peer, send_result);
         this->flush_deferred_input_();
         this->flush_deferred_state_();
+#if defined(USE_ESP32)
+        this->pump_pixel_stream_();
+#endif
       });
   if (result != ESP_OK) {
     this->send_pending_ = false;
@@ -2150,6 +2474,9 @@ bool CFXSyncComponent::send_packet_to_peer_(PeerState &peer,
     return false;
   }
   this->sent_packets_++;
+#ifdef USE_CFX_TRACE
+  this->bus_->observe_packet(true, static_cast<uint16_t>(packet.size()));
+#endif
   return true;
 #else
   (void) peer;
@@ -2170,20 +2497,62 @@ uint32_t CFXSyncComponent::next_sequence_() {
   return this->tx_sequence_;
 }
 
-CFXSyncComponent::PeerState *CFXSyncComponent::find_peer_(
-    const uint8_t *mac) {
-  if (mac == nullptr) {
+uint32_t CFXSyncComponent::peer_hash_(CFXSyncTransportKind transport,
+                                      const uint8_t *mac, uint32_t ipv4) {
+  // FNV-1a; ESP-NOW peers key on the MAC, UDP peers on the address.
+  uint32_t hash = 2166136261UL;
+  const auto mix = [&hash](uint8_t value) {
+    hash ^= value;
+    hash *= 16777619UL;
+  };
+  mix(static_cast<uint8_t>(transport));
+  if (transport == CFXSyncTransportKind::ESPNOW) {
+    for (size_t i = 0; i < 6; i++) {
+      mix(mac[i]);
+    }
+  } else {
+    mix(static_cast<uint8_t>(ipv4));
+    mix(static_cast<uint8_t>(ipv4 >> 8));
+    mix(static_cast<uint8_t>(ipv4 >> 16));
+    mix(static_cast<uint8_t>(ipv4 >> 24));
+  }
+  return hash;
+}
+
+void CFXSyncComponent::set_max_peers(uint8_t max_peers) {
+  if (max_peers == 0 || max_peers > MAX_PEERS_LIMIT) {
+    max_peers = DEFAULT_MAX_PEERS;
+  }
+  this->peers_.assign(max_peers, PeerState{});
+  this->peer_count_ = 0;
+  this->peer_index_.fill(0);
+}
+
+CFXSyncComponent::PeerState *CFXSyncComponent::add_peer_(uint32_t hash) {
+  if (this->peer_count_ >= this->peers_.size()) {
     return nullptr;
   }
-  for (auto &peer : this->peers_) {
-    if (peer.active &&
-        memcmp(peer.mac.data(), mac, peer.mac.size()) == 0) {
+  for (size_t probe = 0; probe < PEER_INDEX_SIZE; probe++) {
+    auto &slot = this->peer_index_[(hash + probe) & (PEER_INDEX_SIZE - 1)];
+    if (slot == 0) {
+      slot = static_cast<uint8_t>(this->peer_count_ + 1);
+      auto &peer = this->peers_[this->peer_count_++];
+      peer = PeerState{};
+      peer.active = true;
       return &peer;
     }
   }
   return nullptr;
 }
 
+CFXSyncComponent::PeerState *CFXSyncComponent::find_peer_(
+    const uint8_t *mac) {
+  if (mac == nullptr) {
+    return nullptr;
+  }
+  return this->find_peer_(CFXSyncSource::from_espnow(mac));
+}
+
 bool CFXSyncComponent::peer_matches_source_(
     const PeerState &peer, const CFXSyncSource &source) const {
   if (!peer.active || !source.identity_valid ||
@@ -2201,7 +2570,16 @@ CFXSyncComponent::PeerState *CFXSyncComponent::find_peer_(
   if (!source.identity_valid) {
     return nullptr;
   }
-  for (auto &peer : this->peers_) {
+  // Every receive lands here, so the cost must not grow with the group.
+  const uint32_t hash =
+      peer_hash_(source.transport, source.mac.data(), source.ipv4);
+  for (size_t probe = 0; probe < PEER_INDEX_SIZE; probe++) {
+    const uint8_t slot =
+        this->peer_index_[(hash + probe) & (PEER_INDEX_SIZE - 1)];
+    if (slot == 0) {
+      return nullptr;
+    }
+    auto &peer = this->peers_[slot - 1];
     if (this->peer_matches_source_(peer, source)) {
       return &peer;
     }
@@ -2224,12 +2602,10 @@ CFXSyncComponent::PeerState *CFXSyncComponent::find_or_add_peer_(
     return peer;
   }
 
-  for (auto &peer : this->peers_) {
-    if (peer.active) {
-      continue;
-    }
-    peer = PeerState{};
-    peer.active = true;
+  if (auto *added = this->add_peer_(
+          peer_hash_(CFXSyncTransportKind::ESPNOW, mac, 0));
+      added != nullptr) {
+    auto &peer = *added;
     peer.transport = CFXSyncTransportKind::ESPNOW;
     memcpy(peer.mac.data(), mac, peer.mac.size());
     peer.node_role = role;
@@ -2268,12 +2644,10 @@ CFXSyncComponent::PeerState *CFXSyncComponent::find_or_add_peer_(
     return peer;
   }
 
-  for (auto &peer : this->peers_) {
-    if (peer.active) {
-      continue;
-    }
-    peer = PeerState{};
-    peer.active = true;
+  if (auto *added = this->add_peer_(
+          peer_hash_(CFXSyncTransportKind::UDP, nullptr, source.ipv4));
+      added != nullptr) {
+    auto &peer = *added;
     peer.transport = CFXSyncTransportKind::UDP;
     peer.ipv4 = source.ipv4;
     peer.udp_port = source.port;
@@ -2328,6 +2702,7 @@ bool CFXSyncComponent::accept_sequence_(PeerState &peer, uint32_t boot_id,
     return true;
   }
   if (sequence <= peer.rx_sequence) {
+    peer.stats.stale++;
     return false;
   }
   peer.rx_sequence = sequence;
@@ -2365,6 +2740,7 @@ void CFXSyncComponent::seed_peer_sent_state_from_ack_(
   peer.last_state_sent_ms =
       this->last_broadcast_state_ms_ != 0 ? this->last_broadcast_state_ms_
                                           : millis();
+  peer.last_state_sent_us = 0;
 }
 #endif
 
@@ -2440,6 +2816,12 @@ void CFXSyncComponent::handle_state_ack_(PeerState &peer,
   peer.last_ack_sequence = packet.acked_sequence;
   peer.last_ack_ms = millis();
   peer.missed_acks = 0;
+  peer.stats.states_acked++;
+  this->record_state_rtt_(peer, packet);
+  if (packet.ack_result != CFXSyncAckResult::APPLIED) {
+    // That follower may sit anywhere now, so the next send is complete.
+    this->state_tx_.request_full();
+  }
 
   bool has_pending = false;
   for (const auto &candidate : this->peers_) {
@@ -2449,6 +2831,9 @@ void CFXSyncComponent::handle_state_ack_(PeerState &peer,
       break;
     }
   }
+  if (!has_pending) {
+    this->confirm_state_baseline_();
+  }
   if (!this->has_peer_send_warning_() && !has_pending &&
       this->consecutive_send_failures_ < MAX_CONSECUTIVE_SEND_FAILURES) {
     this->state_retry_attempts_ = 0;
@@ -2476,6 +2861,17 @@ void CFXSyncComponent::check_ack_health_() {
       if (peer.missed_acks < UINT32_MAX) {
         peer.missed_acks++;
       }
+      // Joined is only what the follower's stack reported; a network that
+      // drops multicast shows up here.
+      if (!this->udp_group_disabled_ &&
+          peer.transport == CFXSyncTransportKind::UDP &&
+          (peer.capabilities & CFXSyncPacketCodec::CAP_UDP_GROUP) != 0 &&
+          peer.missed_acks >= UDP_GROUP_MAX_MISSED_ACKS) {
+        this->udp_group_disabled_ = true;
+        ESP_LOGW(TAG,
+                 "CFX Sync UDP multicast is not reaching followers; using "
+                 "broadcast");
+      }
     }
   }
 
@@ -2614,6 +3010,12 @@ void CFXSyncComponent::schedule_state_retry_() {
       return;
     }
     this->state_retry_attempts_++;
+    for (auto &peer : this->peers_) {
+      if (this->peer_accepts_leader_state_(peer) &&
+          this->has_pending_ack_(peer)) {
+        peer.stats.state_retries++;
+      }
+    }
     this->state_retry_active_ = true;
     if (this->last_state_retry_packet_valid_) {
       this->send_state_packet_to_followers_(this->last_state_retry_packet_);
@@ -2658,6 +3060,134 @@ void CFXSyncComponent::log_rejection_(const char *message) {
   }
 }
 
+void CFXSyncComponent::format_peer_address_(const PeerState &peer,
+                                            char *buffer,
+                                            size_t size) const {
+  if (peer.transport == CFXSyncTransportKind::UDP) {
+    const uint8_t *addr = reinterpret_cast<const uint8_t *>(&peer.ipv4);
+    snprintf(buffer, size, "%u.%u.%u.%u:%u", addr[0], addr[1], addr[2],
+             addr[3], static_cast<unsigned>(peer.udp_port));
+    return;
+  }
+  const uint8_t *mac = peer.mac.data();
+  snprintf(buffer, size, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1],
+           mac[2], mac[3], mac[4], mac[5]);
+}
+
+void CFXSyncComponent::dump_peer_stats() {
+  const uint32_t now = millis();
+  ESP_LOGI(TAG, "CFX Sync group %08" PRIX32 " peers:", this->group_hash_);
+  for (const auto &peer : this->peers_) {
+    if (!peer.active) {
+      continue;
+    }
+    char address[24];
+    this->format_peer_address_(peer, address, sizeof(address));
+    const auto &stats = peer.stats;
+    ESP_LOGI(TAG,
+             "  %s %s: seen %" PRIu32 " ms ago, stale=%" PRIu32
+             " send_failed=%" PRIu32,
+             node_role_name(peer.node_role), address, now - peer.last_seen_ms,
+             stats.stale, peer.send_failures);
+    if (stats.states_sent != 0) {
+      ESP_LOGI(TAG,
+               "    state: sent=%" PRIu32 " acked=%" PRIu32 " retries=%" PRIu32
+               " ack_loss=%u%% rtt p50=%" PRIu32 " p95=%" PRIu32
+               " max=%" PRIu32 " us (n=%" PRIu32 ")",
+               stats.states_sent, stats.states_acked, stats.state_retries,
+               static_cast<unsigned>(stats.ack_loss_percent()),
+               stats.state_rtt.percentile_us(50),
+               stats.state_rtt.percentile_us(95), stats.state_rtt.max_us(),
+               stats.state_rtt.count());
+    }
+    if (stats.inputs_received != 0) {
+      ESP_LOGI(TAG,
+               "    input: received=%" PRIu32 " applied=%" PRIu32
+               " apply p50=%" PRIu32 " p95=%" PRIu32 " max=%" PRIu32 " us",
+               stats.inputs_received, stats.inputs_applied,
+               stats.input_apply.percentile_us(50),
+               stats.input_apply.percentile_us(95),
+               stats.input_apply.max_us());
+    }
+  }
+}
+
+void CFXSyncComponent::reset_peer_stats() {
+  for (auto &peer : this->peers_) {
+    peer.stats.reset();
+  }
+}
+
+#if defined(USE_CFX_SYNC_TELEMETRY) && defined(USE_API)
+void CFXSyncServiceHandler::setup() {
+  this->register_service(&CFXSyncServiceHandler::on_dump_,
+                         "cfx_sync_peer_stats");
+  this->register_service(&CFXSyncServiceHandler::on_reset_,
+                         "cfx_sync_peer_stats_reset");
+}
+
+void CFXSyncServiceHandler::on_dump_() {
+  global_cfx_sync_bus().dump_peer_stats();
+}
+
+void CFXSyncServiceHandler::on_reset_() {
+  global_cfx_sync_bus().reset_peer_stats();
+}
+#endif
+
+#ifdef USE_CFX_SYNC_TELEMETRY
+void CFXSyncComponent::publish_telemetry_() {
+  const PeerState *slowest = nullptr;
+  uint32_t worst_rtt_us = 0;
+  uint32_t worst_input_us = 0;
+  uint8_t worst_loss = 0;
+  bool has_rtt = false;
+  bool has_input = false;
+  bool has_loss = false;
+  for (const auto &peer : this->peers_) {
+    if (!peer.active) {
+      continue;
+    }
+    const auto &stats = peer.stats;
+    if (stats.state_rtt.count() != 0) {
+      const uint32_t rtt_us = stats.state_rtt.percentile_us(95);
+      if (!has_rtt || rtt_us > worst_rtt_us) {
+        worst_rtt_us = rtt_us;
+        slowest = &peer;
+      }
+      has_rtt = true;
+    }
+    if (stats.input_apply.count() != 0) {
+      worst_input_us =
+          std::max(worst_input_us, stats.input_apply.percentile_us(95));
+      has_input = true;
+    }
+    if (stats.states_sent != 0) {
+      worst_loss = std::max(worst_loss, stats.ack_loss_percent());
+      has_loss = true;
+    }
+  }
+
+  if (this->state_rtt_sensor_ != nullptr && has_rtt) {
+    this->state_rtt_sensor_->publish_state(worst_rtt_us / 1000.0f);
+  }
+  if (this->input_latency_sensor_ != nullptr && has_input) {
+    this->input_latency_sensor_->publish_state(worst_input_us / 1000.0f);
+  }
+  if (this->ack_loss_sensor_ != nullptr && has_loss) {
+    this->ack_loss_sensor_->publish_state(worst_loss);
+  }
+  if (this->slowest_peer_sensor_ != nullptr && slowest != nullptr) {
+    char address[24];
+    this->format_peer_address_(*slowest, address, sizeof(address));
+    if (this->last_slowest_peer_ != address) {
+      this->last_slowest_peer_ = address;
+      this->slowest_peer_sensor_->publish_state(this->last_slowest_peer_);
+    }
+  }
+}
+#endif
+
 void CFXSyncComponent::schedule_boot_discovery_() {
   const uint32_t delay_ms =
       BOOT_DISCOVERY_DELAY_MS +
@@ -2728,6 +3258,7 @@ void CFXSyncComponent::enter_offline_fallback_() {
   this->schedule_espnow_rearm_("offline-fallback");
   this->send_hello_();
   if (this->role_ == CFXSyncRole::LEADER) {
+    this->state_tx_.request_full();
     this->send_state_();
   } else if (this->is_state_receiver_role_() &&
              !this->has_valid_state_) {
@@ -2746,6 +3277,7 @@ void CFXSyncComponent::exit_offline_fallback_(uint8_t channel) {
   this->schedule_espnow_rearm_("wifi-restored");
   this->send_hello_();
   if (this->role_ == CFXSyncRole::LEADER) {
+    this->state_tx_.request_full();
     this->send_state_();
   }
 }
@@ -3107,6 +3639,9 @@ bool CFXSyncComponent::apply_remote_state_to_light_(
       use_remote_effect_off_transition
           ? light->get_default_transition_length()
           : 0;
+  const bool pixel_live = !turning_off &&
+                          light_index < this->pixel_sinks_.size() &&
+                          this->pixel_sinks_[light_index].live;
   auto call = light->make_call();
 
   if (packet.has_power) {
@@ -3216,6 +3751,12 @@ bool CFXSyncComponent::apply_remote_state_to_light_(
     log_state.effect_id = packet.effect.effect_id;
     log_state.name = packet.effect.name;
 
+    if (pixel_live) {
+      // The stream is showing the leader's frames; keep the effect for
+      // when it stops.
+      this->pixel_sinks_[light_index].resume_effect = desired_effect;
+      desired_effect = "None";
+    }
     if (light->get_effect_name() != desired_effect) {
       call.set_effect(desired_effect);
     }
@@ -3231,11 +3772,19 @@ bool CFXSyncComponent::apply_remote_state_to_light_(
              light->get_default_transition_length() == 0) {
     call.set_transition_length(packet.transition_ms);
   }
+  if (pixel_live) {
+    // A transition would repaint the strip with the solid colour on every
+    // step; land the new values at once and put the frame back on top.
+    call.set_transition_length(0);
+  }
 
   call.perform();
   if (use_remote_effect_off_transition) {
     light->set_default_transition_length(saved_default_transition);
   }
+  if (pixel_live) {
+    this->repaint_pixel_sink_(light_index);
+  }
   return true;
 #endif
 }
@@ -3503,6 +4052,429 @@ void CFXSyncComponent::log_control_skip_(
            static_cast<unsigned>(light_index), reason);
 }
 
+// ── Pixel stream ────────────────────────────────────────────────────────────
+
+void CFXSyncComponent::service_pixel_stream_(uint32_t now) {
+  if (this->role_ == CFXSyncRole::LEADER) {
+    // A frame still going out when the next tick comes is finished before
+    // a new one is captured.
+    if (this->pixel_tx_active_) {
+      this->pump_pixel_stream_();
+      return;
+    }
+    if (this->capture_pixel_frame_(now)) {
+      this->pump_pixel_stream_();
+    }
+    return;
+  }
+  if (this->is_state_receiver_role_()) {
+    this->expire_pixel_sinks_(now);
+  }
+}
+
+bool CFXSyncComponent::capture_pixel_frame_(uint32_t now) {
+  auto *light = this->leader_light_();
+  if (light == nullptr || this->pixel_sinks_.empty() ||
+      !this->pixel_sinks_[0].addressable || !light->remote_values.is_on() ||
+      !this->has_pixel_followers_()) {
+    // Whoever joins or turns on next starts from a keyframe.
+    this->pixel_tx_sent_.clear();
+    return false;
+  }
+  auto *output = static_cast<light::AddressableLight *>(light->get_output());
+  const int32_t size =
+      std::min<int32_t>(output->size(), std::numeric_limits<uint16_t>::max());
+  if (size <= 0) {
+    return false;
+  }
+  const uint16_t led_count = static_cast<uint16_t>(size);
+  const uint8_t stride = light_supports_rgb_white(*light) ? 4 : 3;
+  const size_t bytes = static_cast<size_t>(led_count) * stride;
+
+  this->pixel_tx_frame_.resize(bytes);
+  uint8_t *dst = this->pixel_tx_frame_.data();
+  for (uint16_t i = 0; i < led_count; i++) {
+    const Color color = (*output)[i].get();
+    *dst++ = color.r;
+    *dst++ = color.g;
+    *dst++ = color.b;
+    if (stride == 4) {
+      *dst++ = color.w;
+    }
+  }
+
+  const bool keyframe =
+      this->pixel_tx_sent_.size() != bytes ||
+      this->pixel_tx_stride_ != stride ||
+      now - this->pixel_tx_last_keyframe_ms_ >= PIXEL_KEYFRAME_INTERVAL_MS;
+  if (keyframe) {
+    this->pixel_tx_sent_.assign(bytes, 0);
+    this->pixel_tx_last_keyframe_ms_ = now;
+  }
+
+  // MAX_PIXEL_DATA_SIZE is a whole number of RGB and RGBW pixels, so chunks
+  // always start on a pixel boundary.
+  const size_t chunk_bytes = CFXSyncPacketCodec::MAX_PIXEL_DATA_SIZE;
+  const size_t chunks = (bytes + chunk_bytes - 1) / chunk_bytes;
+  this->pixel_tx_dirty_.assign(chunks, 0);
+  bool any_dirty = false;
+  for (size_t chunk = 0; chunk < chunks; chunk++) {
+    const size_t offset = chunk * chunk_bytes;
+    const size_t length = std::min(chunk_bytes, bytes - offset);
+    if (keyframe ||
+        memcmp(this->pixel_tx_frame_.data() + offset,
+               this->pixel_tx_sent_.data() + offset, length) != 0) {
+      this->pixel_tx_dirty_[chunk] = 1;
+      this->pixel_tx_last_chunk_ = static_cast<uint16_t>(chunk);
+      any_dirty = true;
+    }
+  }
+  if (!any_dirty) {
+    return false;
+  }
+
+  this->pixel_tx_stride_ = stride;
+  this->pixel_tx_led_count_ = led_count;
+  this->pixel_tx_keyframe_ = keyframe;
+  this->pixel_tx_frame_id_++;
+  this->pixel_tx_cursor_ = 0;
+  this->pixel_tx_active_ = true;
+  this->pixel_frames_sent_++;
+  return true;
+}
+
+void CFXSyncComponent::pump_pixel_stream_() {
+  const size_t chunk_bytes = CFXSyncPacketCodec::MAX_PIXEL_DATA_SIZE;
+  while (this->pixel_tx_active_) {
+    // STATE and input traffic waiting for the transport go first.
+    if (this->state_send_deferred_ || this->pending_input_count_ != 0) {
+      return;
+    }
+    size_t chunk = this->pixel_tx_cursor_;
+    while (chunk < this->pixel_tx_dirty_.size() &&
+           this->pixel_tx_dirty_[chunk] == 0) {
+      chunk++;
+    }
+    if (chunk >= this->pixel_tx_dirty_.size()) {
+      this->pixel_tx_active_ = false;
+      return;
+    }
+
+    const size_t offset = chunk * chunk_bytes;
+    const size_t length =
+        std::min(chunk_bytes, this->pixel_tx_frame_.size() - offset);
+    uint8_t flags = 0;
+    if (chunk == this->pixel_tx_last_chunk_) {
+      flags |= CFXSyncPacketCodec::PIXEL_FLAG_LAST;
+    }
+    if (this->pixel_tx_keyframe_) {
+      flags |= CFXSyncPacketCodec::PIXEL_FLAG_KEYFRAME;
+    }
+    if (this->pixel_tx_stride_ == 4) {
+      flags |= CFXSyncPacketCodec::PIXEL_FLAG_WHITE;
+    }
+
+    uint32_t sequence = this->pixel_tx_sequence_ + 1;
+    if (sequence == 0) {
+      // Same rollover rule as next_sequence_(): a fresh boot id lets
+      // followers restart both sequence spaces.
+      this->boot_id_ = esp_random();
+      if (this->boot_id_ == 0) {
+        this->boot_id_ = 1;
+      }
+      sequence = 1;
+    }
+    if (!CFXSyncPacketCodec::encode_pixel_frame(
+            this->group_hash_, this->boot_id_, sequence,
+            this->pixel_tx_frame_id_, flags, this->pixel_tx_led_count_,
+            static_cast<uint16_t>(offset / this->pixel_tx_stride_),
+            this->pixel_tx_frame_.data() + offset, length, this->key_,
+            this->pixel_tx_packet_)) {
+      this->pixel_tx_active_ = false;
+      return;
+    }
+    if (!this->send_pixel_packet_(this->pixel_tx_packet_)) {
+      // ESP-NOW is busy; the send callback resumes from this chunk.
+      return;
+    }
+    this->pixel_tx_sequence_ = sequence;
+    memcpy(this->pixel_tx_sent_.data() + offset,
+           this->pixel_tx_frame_.data() + offset, length);
+    this->pixel_tx_cursor_ = static_cast<uint16_t>(chunk + 1);
+  }
+}
+
+bool CFXSyncComponent::send_pixel_packet_(std::vector<uint8_t> &packet) {
+  if (this->use_espnow_transport_() && this->send_pending_) {
+    return false;
+  }
+  if (this->use_udp_transport_()) {
+    this->send_udp_follower_packet_(packet);
+  }
+  if (this->use_espnow_transport_()) {
+    this->send_espnow_packet_to_(BROADCAST_MAC, packet);
+  }
+  // A failed chunk is not retried: the next delta or keyframe covers it.
+  this->pixel_chunks_sent_++;
+  return true;
+}
+
+bool CFXSyncComponent::has_pixel_followers_() const {
+  for (const auto &peer : this->peers_) {
+    if (peer.active &&
+        (peer.capabilities & CFXSyncPacketCodec::CAP_PIXEL_FOLLOWER) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CFXSyncComponent::accept_pixel_sequence_(PeerState &peer,
+                                              uint32_t boot_id,
+                                              uint32_t sequence) {
+  if (!peer.has_pixel_rx_sequence || boot_id != peer.pixel_rx_boot_id) {
+    peer.has_pixel_rx_sequence = true;
+    peer.pixel_rx_boot_id = boot_id;
+    peer.pixel_rx_sequence = sequence;
+    return true;
+  }
+  if (sequence <= peer.pixel_rx_sequence) {
+    return false;
+  }
+  peer.pixel_rx_sequence = sequence;
+  return true;
+}
+
+void CFXSyncComponent::handle_pixel_frame_(PeerState &peer,
+                                           const CFXSyncPacket &packet) {
+  (void) peer;
+  const uint32_t now = millis();
+  const uint8_t stride =
+      (packet.pixel_flags & CFXSyncPacketCodec::PIXEL_FLAG_WHITE) != 0 ? 4
+                                                                       : 3;
+  const size_t frame_bytes =
+      static_cast<size_t>(packet.pixel_led_count) * stride;
+  const size_t offset = static_cast<size_t>(packet.pixel_first_led) * stride;
+  const bool last =
+      (packet.pixel_flags & CFXSyncPacketCodec::PIXEL_FLAG_LAST) != 0;
+  this->pixel_chunks_received_++;
+
+  for (size_t i = 0; i < this->lights_.size() && i < this->pixel_sinks_.size();
+       i++) {
+    auto *light = this->lights_[i];
+    auto &sink = this->pixel_sinks_[i];
+    if (light == nullptr || !sink.addressable ||
+        !light->remote_values.is_on()) {
+      continue;
+    }
+    auto *output =
+        static_cast<light::AddressableLight *>(light->get_output());
+    if (!sink.live) {
+      sink.live = true;
+      sink.resume_effect = light->get_effect_name();
+      ESP_LOGI(TAG, "Pixel stream started on '%s'; local effect paused",
+               light->get_name().c_str());
+      if (sink.resume_effect != "None") {
+        RemoteApplyGuard guard(this->applying_remote_state_);
+        auto call = light->make_call();
+        call.set_effect("None");
+        call.set_transition_length(0);
+        call.perform();
+      }
+    }
+    if (sink.uncommitted && sink.frame != packet.pixel_frame) {
+      // The previous frame's last chunk was lost; show what arrived.
+      output->schedule_show();
+    }
+    sink.frame = packet.pixel_frame;
+    sink.last_rx_ms = now;
+    if (sink.stride != stride || sink.pixels.size() != frame_bytes) {
+      sink.stride = stride;
+      sink.pixels.assign(frame_bytes, 0);
+    }
+    memcpy(sink.pixels.data() + offset, packet.pixel_data,
+           packet.pixel_data_size);
+
+    const int32_t size = output->size();
+    const uint8_t *src = packet.pixel_data;
+    const size_t count = packet.pixel_data_size / stride;
+    for (size_t p = 0; p < count; p++, src += stride) {
+      const int32_t led = static_cast<int32_t>(packet.pixel_first_led + p);
+      if (led >= size) {
+        break;
+      }
+      (*output)[led].set(Color(src[0], src[1], src[2],
+                               stride == 4 ? src[3] : 0));
+    }
+    sink.uncommitted = !last;
+    if (last) {
+      output->schedule_show();
+    }
+  }
+}
+
+void CFXSyncComponent::repaint_pixel_sink_(size_t light_index) {
+  if (light_index >= this->lights_.size() ||
+      light_index >= this->pixel_sinks_.size()) {
+    return;
+  }
+  auto *light = this->lights_[light_index];
+  const auto &sink = this->pixel_sinks_[light_index];
+  if (light == nullptr || !sink.live || sink.pixels.empty()) {
+    return;
+  }
+  auto *output = static_cast<light::AddressableLight *>(light->get_output());
+  const int32_t count = std::min<int32_t>(
+      output->size(), static_cast<int32_t>(sink.pixels.size() / sink.stride));
+  const uint8_t *src = sink.pixels.data();
+  for (int32_t led = 0; led < count; led++, src += sink.stride) {
+    (*output)[led].set(Color(src[0], src[1], src[2],
+                             sink.stride == 4 ? src[3] : 0));
+  }
+  output->schedule_show();
+}
+
+void CFXSyncComponent::expire_pixel_sinks_(uint32_t now) {
+  for (size_t i = 0; i < this->lights_.size() && i < this->pixel_sinks_.size();
+       i++) {
+    auto &sink = this->pixel_sinks_[i];
+    if (!sink.live || now - sink.last_rx_ms < PIXEL_STREAM_TIMEOUT_MS) {
+      continue;
+    }
+    auto *light = this->lights_[i];
+    sink.live = false;
+    sink.uncommitted = false;
+    sink.pixels.clear();
+    sink.pixels.shrink_to_fit();
+    if (light == nullptr) {
+      continue;
+    }
+    ESP_LOGI(TAG, "Pixel stream stopped on '%s'; resuming '%s'",
+             light->get_name().c_str(), sink.resume_effect.c_str());
+    if (!light->remote_values.is_on()) {
+      continue;
+    }
+    RemoteApplyGuard guard(this->applying_remote_state_);
+    auto call = light->make_call();
+    if (sink.resume_effect != "None") {
+      call.set_effect(sink.resume_effect);
+    }
+    // With no effect to resume this just repaints the solid colour.
+    call.set_transition_length(0);
+    call.perform();
+  }
+}
+
+// ── Group clock ─────────────────────────────────────────────────────────────
+
+CFXSyncTimingState CFXSyncComponent::with_timebase_(
+    const CFXSyncTimingState &timing) {
+  // Half the fastest filtered round trip: the closest follower sets the
+  // delay, slower ones land a little behind rather than ahead.
+  uint32_t rtt_us = 0;
+  for (const auto &peer : this->peers_) {
+    if (this->peer_accepts_leader_state_(peer) && peer.rtt_us != 0 &&
+        (rtt_us == 0 || peer.rtt_us < rtt_us)) {
+      rtt_us = peer.rtt_us;
+    }
+  }
+  uint64_t epoch_us = 0;
+  uint32_t revision = 0;
+  if (CFXSyncGroupClock::get().epoch(this->leader_light_(), epoch_us,
+                                     revision)) {
+    this->timebase_sent_revision_ = revision;
+    this->timebase_sent_epoch_us_ = epoch_us;
+  }
+  CFXSyncTimingState timed = timing;
+  timed.has_timebase = true;
+  timed.leader_us = esp_timer_get_time();
+  timed.delay_us = rtt_us / 2;
+  timed.epoch_us = epoch_us;
+  return timed;
+}
+
+void CFXSyncComponent::record_state_rtt_(PeerState &peer,
+                                         const CFXSyncPacket &packet) {
+  if (!packet.has_ack_hold || peer.last_state_sent_us == 0) {
+    return;
+  }
+  const uint64_t elapsed_us = esp_timer_get_time() - peer.last_state_sent_us;
+  // Only the first ACK of a send times it; retries and duplicates would
+  // measure the retry delay instead.
+  peer.last_state_sent_us = 0;
+  if (elapsed_us < packet.ack_hold_us) {
+    return;
+  }
+  // Telemetry keeps the slow trips the clock filter throws away.
+  const uint64_t trip_us = elapsed_us - packet.ack_hold_us;
+  peer.stats.state_rtt.record(
+      trip_us > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(trip_us));
+  if (trip_us > TIMEBASE_MAX_RTT_US) {
+    return;
+  }
+  const uint32_t rtt_us = static_cast<uint32_t>(trip_us);
+  // Drops right away to a faster trip, climbs slowly on slower ones.
+  if (peer.rtt_us == 0 || rtt_us < peer.rtt_us) {
+    peer.rtt_us = rtt_us;
+  } else {
+    peer.rtt_us += (rtt_us - peer.rtt_us) / 8;
+  }
+}
+
+void CFXSyncComponent::record_input_apply_(PeerState &peer, bool applied,
+                                           uint64_t received_us) {
+  peer.stats.inputs_received++;
+  if (!applied) {
+    return;
+  }
+  peer.stats.inputs_applied++;
+  const uint64_t elapsed_us = esp_timer_get_time() - received_us;
+  peer.stats.input_apply.record(elapsed_us > UINT32_MAX
+                                    ? UINT32_MAX
+                                    : static_cast<uint32_t>(elapsed_us));
+}
+
+void CFXSyncComponent::handle_timebase_(const CFXSyncPacket &packet) {
+  if (!packet.has_timebase) {
+    return;
+  }
+  const uint64_t now_us = this->packet_rx_us_;
+  if (packet.boot_id != this->clock_leader_boot_id_) {
+    // A rebooted leader restarts its clock from zero.
+    this->clock_estimator_.reset();
+    this->clock_leader_boot_id_ = packet.boot_id;
+  }
+  auto &clock = CFXSyncGroupClock::get();
+  if (this->clock_estimator_.add_sample(packet.leader_us, packet.delay_us,
+                                        now_us)) {
+    clock.set_estimate(this->clock_estimator_.offset_us(),
+                       this->clock_estimator_.skew_ppb(),
+                       this->clock_estimator_.anchor_us());
+  }
+  if (packet.epoch_us == 0) {
+    return;
+  }
+  for (auto *light : this->lights_) {
+    clock.set_epoch(light, packet.epoch_us);
+  }
+}
+
+void CFXSyncComponent::check_timebase_epoch_() {
+  uint64_t epoch_us = 0;
+  uint32_t revision = 0;
+  if (!CFXSyncGroupClock::get().epoch(this->leader_light_(), epoch_us,
+                                      revision) ||
+      revision == this->timebase_sent_revision_) {
+    return;
+  }
+  const uint64_t moved_us = epoch_us > this->timebase_sent_epoch_us_
+                                ? epoch_us - this->timebase_sent_epoch_us_
+                                : this->timebase_sent_epoch_us_ - epoch_us;
+  if (moved_us >= TIMEBASE_EPOCH_RESEND_US) {
+    this->send_state_();
+  }
+}
+
 #endif  // defined(USE_ESP32)
 
 bool CFXSyncComponent::is_broadcast_(const uint8_t *address) const {
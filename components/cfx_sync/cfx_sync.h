@@ -18,8 +18,14 @@
 #if defined(USE_ESP32)
 #include "cfx_sync_effect.h"
 #endif
+#include "cfx_sync_clock.h"
+#if defined(USE_ESP32)
+#include "cfx_sync_group_clock.h"
+#include "cfx_sync_state_tx.h"
+#endif
 #include "cfx_sync_bus.h"
 #include "cfx_sync_packet.h"
+#include "cfx_sync_telemetry.h"
 #include "cfx_sync_transport.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #ifdef USE_ESPNOW
@@ -31,11 +37,19 @@
 #include "esphome/components/select/select.h"
 #include "esphome/components/switch/switch.h"
 #endif
+#ifdef USE_CFX_SYNC_TELEMETRY
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/text_sensor/text_sensor.h"
+#ifdef USE_API
+#include "esphome/components/api/custom_api_device.h"
+#endif
+#endif
 #include "esphome/core/component.h"
 #include "esphome/core/version.h"
 
 #include <array>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace esphome {
@@ -102,6 +116,7 @@ class CFXSyncComponent : public Component {
     this->effect_catalogs_.emplace_back();
     this->effect_log_states_.emplace_back();
     this->control_bindings_.emplace_back();
+    this->pixel_sinks_.emplace_back();
 #endif
   }
 #if defined(USE_ESP32)
@@ -113,6 +128,9 @@ class CFXSyncComponent : public Component {
     this->effect_catalogs_[light_index].push_back(
         CFXSyncEffectEntry{effect_id, name});
   }
+  // Heap held by this group: peer table, packet scratch, pixel stream
+  // frames and effect catalogs. The shared bus is not included.
+  size_t memory_bytes() const;
 #endif
   void set_role(CFXSyncRole role) { this->role_ = role; }
   void set_local_input(binary_sensor::BinarySensor *input) {
@@ -154,7 +172,42 @@ class CFXSyncComponent : public Component {
   void set_heartbeat_ms(uint32_t heartbeat_ms) {
     this->heartbeat_ms_ = heartbeat_ms;
   }
+  // Peer slots are allocated once, before setup(); pointers into the table
+  // stay valid for the life of the component.
+  void set_max_peers(uint8_t max_peers);
 #if defined(USE_ESP32)
+  // Minimum spacing between STATE broadcasts; updates in between coalesce.
+  void set_state_interval_ms(uint32_t interval_ms) {
+    this->state_tx_.set_interval_ms(interval_ms);
+  }
+  // Pixel stream: the leader sends its rendered frames; followers write
+  // them to addressable lights instead of running the effect locally.
+  void set_pixel_stream(bool enabled) { this->pixel_stream_ = enabled; }
+  // UDP packets are received and decoded on a task of their own.
+  void set_rx_task(bool enabled) { this->rx_task_ = enabled; }
+#ifdef USE_CFX_SYNC_TELEMETRY
+  // Sensors report the worst peer, so one slow node stands out.
+  void set_telemetry_interval_ms(uint32_t interval_ms) {
+    this->telemetry_interval_ms_ = interval_ms;
+  }
+  void set_state_rtt_sensor(sensor::Sensor *s) { this->state_rtt_sensor_ = s; }
+  void set_input_latency_sensor(sensor::Sensor *s) {
+    this->input_latency_sensor_ = s;
+  }
+  void set_ack_loss_sensor(sensor::Sensor *s) { this->ack_loss_sensor_ = s; }
+  void set_slowest_peer_text_sensor(text_sensor::TextSensor *s) {
+    this->slowest_peer_sensor_ = s;
+  }
+#endif
+  void set_pixel_stream_interval_ms(uint32_t interval_ms) {
+    this->pixel_stream_interval_ms_ = interval_ms;
+  }
+  // Marks a light whose output is a light::AddressableLight.
+  void set_pixel_light(size_t light_index) {
+    if (light_index < this->pixel_sinks_.size()) {
+      this->pixel_sinks_[light_index].addressable = true;
+    }
+  }
   void set_force_white_control(size_t light_index,
                                switch_::Switch *control) {
     if (light_index < this->control_bindings_.size()) {
@@ -201,6 +254,9 @@ class CFXSyncComponent : public Component {
 
   void on_local_light_update();
   void on_sync_enabled_switch(bool enabled);
+  // One log line per known peer; reset clears the counters, not the peers.
+  void dump_peer_stats();
+  void reset_peer_stats();
 
  protected:
   friend class CFXSyncBus;
@@ -208,7 +264,12 @@ class CFXSyncComponent : public Component {
   static constexpr uint8_t MAX_CONSECUTIVE_SEND_FAILURES = 3;
   static constexpr uint32_t EFFECT_FALLBACK_LOG_INTERVAL_MS = 30000;
   static constexpr uint32_t CONTROL_SKIP_LOG_INTERVAL_MS = 30000;
-  static constexpr uint8_t CFX_SYNC_MAX_PEERS = 8;
+  static constexpr uint8_t DEFAULT_MAX_PEERS = 8;
+  static constexpr uint8_t MAX_PEERS_LIMIT = 64;
+  // Open-addressed slots over peers_; twice the largest table keeps probe
+  // runs short when it is full.
+  static constexpr size_t PEER_INDEX_SIZE = 128;
+  static constexpr uint32_t UDP_GROUP_MAX_MISSED_ACKS = 2;
   static constexpr uint32_t PEER_TIMEOUT_MS = 120000;
   static constexpr uint32_t HELLO_INTERVAL_MS = 10000;
   static constexpr uint32_t HELLO_JITTER_SPREAD_MS = 3000;
@@ -243,6 +304,16 @@ class CFXSyncComponent : public Component {
   static constexpr uint32_t REMOTE_INPUT_TIMEOUT_MS = 2500;
   static constexpr uint8_t PENDING_INPUT_QUEUE_SIZE = 8;
   static constexpr uint16_t DEFAULT_UDP_PORT = 39580;
+  // Leader keyframe period; also what keeps an unchanging frame live.
+  static constexpr uint32_t PIXEL_KEYFRAME_INTERVAL_MS = 1000;
+  // Follower falls back to local rendering after this long without chunks.
+  static constexpr uint32_t PIXEL_STREAM_TIMEOUT_MS = 2500;
+  // Round trips above this are queueing, not path delay.
+  static constexpr uint32_t TIMEBASE_MAX_RTT_US = 100000;
+  static constexpr uint32_t TIMEBASE_CHECK_INTERVAL_MS = 100;
+  // Leader resends STATE when an effect restart moves the epoch this far
+  // from what followers last heard.
+  static constexpr uint64_t TIMEBASE_EPOCH_RESEND_US = 20000;
   static constexpr std::array<uint8_t, 6> BROADCAST_MAC{
       0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
 
@@ -258,10 +329,19 @@ class CFXSyncComponent : public Component {
     bool has_rx_sequence{false};
     uint32_t rx_boot_id{0};
     uint32_t rx_sequence{0};
+    // Pixel frames are numbered apart from the control packets so a
+    // stream cannot make a retried STATE look stale.
+    bool has_pixel_rx_sequence{false};
+    uint32_t pixel_rx_boot_id{0};
+    uint32_t pixel_rx_sequence{0};
     uint32_t last_seen_ms{0};
     uint32_t last_state_sent_boot_id{0};
     uint32_t last_state_sent_sequence{0};
     uint32_t last_state_sent_ms{0};
+    // esp_timer at that send (0 = unknown) and the filtered STATE_ACK
+    // round trip it yields (0 = none yet).
+    uint64_t last_state_sent_us{0};
+    uint32_t rtt_us{0};
     uint32_t last_ack_boot_id{0};
     uint32_t last_ack_sequence{0};
     uint32_t last_ack_ms{0};
@@ -270,6 +350,7 @@ class CFXSyncComponent : public Component {
     uint32_t send_failures{0};
     uint32_t last_send_failure_log_ms{0};
     uint32_t tx_suspended_until_ms{0};
+    CFXSyncPeerStats stats;
   };
 
 #if defined(USE_ESP32)
@@ -293,6 +374,20 @@ class CFXSyncComponent : public Component {
     bool callbacks_registered{false};
     uint32_t last_skip_log_ms{0};
   };
+
+  // Follower side of the pixel stream, one per light.
+  struct PixelSink {
+    bool addressable{false};
+    bool live{false};
+    bool uncommitted{false};
+    uint16_t frame{0};
+    uint32_t last_rx_ms{0};
+    // Last frame received, in wire order, for repainting after a STATE.
+    std::vector<uint8_t> pixels;
+    uint8_t stride{3};
+    // Effect from the last STATE, restored when the stream stops.
+    std::string resume_effect{"None"};
+  };
 #endif
 
   struct PendingInputEvent {
@@ -318,6 +413,8 @@ class CFXSyncComponent : public Component {
                                 const CFXSyncEffectState &effect,
                                 const CFXSyncControlState &controls,
                                 const CFXSyncTimingState &timing);
+  void flush_state_tx_();
+  void confirm_state_baseline_();
   void mark_state_sent_to_followers_(uint32_t sequence);
   bool peer_accepts_leader_state_(const PeerState &peer) const;
   bool send_state_to_peer_(PeerState &peer);
@@ -329,6 +426,7 @@ class CFXSyncComponent : public Component {
   bool send_state_ack_(const uint8_t *destination,
                        const CFXSyncPacket &packet,
                        CFXSyncAckResult result);
+  bool send_state_ack_packet_(std::vector<uint8_t> &ack);
   void schedule_state_ack_(const uint8_t *destination,
                            const CFXSyncPacket &packet,
                            CFXSyncAckResult result);
@@ -381,12 +479,15 @@ class CFXSyncComponent : public Component {
   bool send_packet_to_(const std::array<uint8_t, 6> &mac,
                        std::vector<uint8_t> &packet);
   bool send_state_packet_to_followers_(std::vector<uint8_t> &packet);
+  bool followers_join_udp_group_() const;
+  bool send_udp_follower_packet_(std::vector<uint8_t> &packet);
   bool send_packet_to_peer_(PeerState &peer,
                             std::vector<uint8_t> &packet);
   bool use_udp_transport_() const;
   bool use_espnow_transport_() const;
   CFXSyncNodeRole local_node_role_() const;
   uint16_t local_capabilities_() const;
+  uint32_t udp_group_address_() const;
   bool is_state_receiver_role_() const;
   bool is_input_sender_role_() const;
   bool accepts_peer_role_(CFXSyncNodeRole role) const;
@@ -401,6 +502,9 @@ class CFXSyncComponent : public Component {
   PeerState *find_or_add_peer_(const CFXSyncSource &source,
                                CFXSyncNodeRole role,
                                uint16_t capabilities);
+  static uint32_t peer_hash_(CFXSyncTransportKind transport,
+                             const uint8_t *mac, uint32_t ipv4);
+  PeerState *add_peer_(uint32_t hash);
   bool peer_matches_source_(const PeerState &peer,
                             const CFXSyncSource &source) const;
   bool register_peer_(PeerState &peer);
@@ -412,6 +516,11 @@ class CFXSyncComponent : public Component {
                       size_t size);
   bool handle_decoded_packet_(const CFXSyncSource &source,
                               const CFXSyncPacket &packet);
+#if defined(USE_ESP32)
+  bool handle_rx_packet_(const CFXSyncSource &source,
+                         CFXSyncDecodeResult result,
+                         const CFXSyncPacket &packet, uint64_t received_us);
+#endif
   bool has_peer_send_warning_() const;
   bool has_pending_ack_(const PeerState &peer) const;
 #if defined(USE_ESP32)
@@ -440,6 +549,11 @@ class CFXSyncComponent : public Component {
 #endif
   void handle_decode_failure_(CFXSyncDecodeResult result);
   void log_rejection_(const char *message);
+  void format_peer_address_(const PeerState &peer, char *buffer,
+                            size_t size) const;
+#ifdef USE_CFX_SYNC_TELEMETRY
+  void publish_telemetry_();
+#endif
   void schedule_boot_discovery_();
   void run_boot_discovery_();
   bool boot_radio_ready_() const;
@@ -471,6 +585,23 @@ class CFXSyncComponent : public Component {
                          size_t light_index, const char *control_name,
                          const char *reason);
   light::LightState *leader_light_() const;
+  void service_pixel_stream_(uint32_t now);
+  bool capture_pixel_frame_(uint32_t now);
+  void pump_pixel_stream_();
+  bool send_pixel_packet_(std::vector<uint8_t> &packet);
+  bool has_pixel_followers_() const;
+  bool accept_pixel_sequence_(PeerState &peer, uint32_t boot_id,
+                              uint32_t sequence);
+  void handle_pixel_frame_(PeerState &peer, const CFXSyncPacket &packet);
+  void repaint_pixel_sink_(size_t light_index);
+  void expire_pixel_sinks_(uint32_t now);
+  // Copy of `timing` carrying the leader timebase for this send.
+  CFXSyncTimingState with_timebase_(const CFXSyncTimingState &timing);
+  void record_state_rtt_(PeerState &peer, const CFXSyncPacket &packet);
+  void record_input_apply_(PeerState &peer, bool applied,
+                           uint64_t received_us);
+  void handle_timebase_(const CFXSyncPacket &packet);
+  void check_timebase_epoch_();
 #endif
   bool is_broadcast_(const uint8_t *address) const;
   const char *role_name_() const;
@@ -482,6 +613,45 @@ class CFXSyncComponent : public Component {
   std::vector<std::vector<CFXSyncEffectEntry>> effect_catalogs_;
   std::vector<EffectLogState> effect_log_states_;
   std::vector<ControlBinding> control_bindings_;
+  std::vector<PixelSink> pixel_sinks_;
+  bool pixel_stream_{false};
+  bool rx_task_{false};
+#ifdef USE_CFX_SYNC_TELEMETRY
+  uint32_t telemetry_interval_ms_{30000};
+  sensor::Sensor *state_rtt_sensor_{nullptr};
+  sensor::Sensor *input_latency_sensor_{nullptr};
+  sensor::Sensor *ack_loss_sensor_{nullptr};
+  text_sensor::TextSensor *slowest_peer_sensor_{nullptr};
+  std::string last_slowest_peer_;
+#endif
+  uint32_t pixel_stream_interval_ms_{40};
+  // Leader: the frame being sent, the frame followers last received, and a
+  // per-chunk dirty map. A frame is sent chunk by chunk as the transport
+  // frees up; the next capture waits until it is out.
+  std::vector<uint8_t> pixel_tx_frame_;
+  std::vector<uint8_t> pixel_tx_sent_;
+  std::vector<uint8_t> pixel_tx_dirty_;
+  std::vector<uint8_t> pixel_tx_packet_;
+  bool pixel_tx_active_{false};
+  bool pixel_tx_keyframe_{false};
+  uint8_t pixel_tx_stride_{3};
+  uint16_t pixel_tx_led_count_{0};
+  uint16_t pixel_tx_frame_id_{0};
+  uint16_t pixel_tx_cursor_{0};
+  uint16_t pixel_tx_last_chunk_{0};
+  uint32_t pixel_tx_sequence_{0};
+  uint32_t pixel_tx_last_keyframe_ms_{0};
+  uint32_t pixel_frames_sent_{0};
+  uint32_t pixel_chunks_sent_{0};
+  uint32_t pixel_chunks_received_{0};
+  uint64_t packet_rx_us_{0};
+  // Arrival time stamped by the receive task for the packet being handled.
+  uint64_t rx_task_received_us_{0};
+  CFXSyncClockEstimator clock_estimator_;
+  uint32_t clock_leader_boot_id_{0};
+  // Leader: the epoch followers last heard, to notice effect restarts.
+  uint32_t timebase_sent_revision_{0};
+  uint64_t timebase_sent_epoch_us_{0};
 #endif
   CFXSyncRole role_{CFXSyncRole::FOLLOWER};
   binary_sensor::BinarySensor *local_input_{nullptr};
@@ -496,7 +666,11 @@ class CFXSyncComponent : public Component {
 #endif
   std::array<uint8_t, 6> peer_{};
   bool has_static_peer_{false};
-  std::array<PeerState, CFX_SYNC_MAX_PEERS> peers_{};
+  std::vector<PeerState> peers_ = std::vector<PeerState>(DEFAULT_MAX_PEERS);
+  size_t peer_count_{0};
+  // peers_ index + 1 per slot, 0 = empty. Peers are never removed, so
+  // there are no tombstones.
+  std::array<uint8_t, PEER_INDEX_SIZE> peer_index_{};
   std::array<uint8_t, 32> key_{};
   uint32_t group_hash_{0};
   uint32_t heartbeat_ms_{30000};
@@ -512,6 +686,9 @@ class CFXSyncComponent : public Component {
   bool state_retry_scheduled_{false};
   std::vector<uint8_t> last_state_retry_packet_;
   bool last_state_retry_packet_valid_{false};
+  // Encode scratch for outgoing STATE; keeps its storage between packets.
+  std::vector<uint8_t> state_tx_packet_;
+  CFXSyncStateTx state_tx_;
   uint32_t last_broadcast_state_boot_id_{0};
   uint32_t last_broadcast_state_sequence_{0};
   uint32_t last_broadcast_state_ms_{0};
@@ -528,6 +705,7 @@ class CFXSyncComponent : public Component {
   CFXSyncInputMode input_mode_{CFXSyncInputMode::CFX_SYNC_INPUT_MOMENTARY};
   CFXSyncTransport transport_{CFXSyncTransport::CFX_SYNC_TRANSPORT_AUTO};
   uint16_t udp_port_{DEFAULT_UDP_PORT};
+  bool udp_group_disabled_{false};
   bool local_input_has_state_{false};
   bool local_input_pressed_{false};
   bool local_input_sent_has_state_{false};
@@ -577,6 +755,19 @@ class CFXSyncComponent : public Component {
   uint32_t espnow_state_sent_{0};
 };
 
+#if defined(USE_CFX_SYNC_TELEMETRY) && defined(USE_API)
+// Home Assistant services cfx_sync_peer_stats and cfx_sync_peer_stats_reset,
+// registered once and applied to every group.
+class CFXSyncServiceHandler : public api::CustomAPIDevice, public Component {
+ public:
+  void setup() override;
+
+ protected:
+  void on_dump_();
+  void on_reset_();
+};
+#endif
+
 }  // namespace cfx_sync
 }  // namespace esphome
 
@@ -9,6 +9,10 @@
 #ifdef USE_ESPNOW
 #include <esp_err.h>
 #endif
+#if defined(USE_ESP32)
+#include <esp_timer.h>
+#endif
+#include <algorithm>
 #include <cstring>
 
 namespace esphome {
@@ -34,6 +38,12 @@ void CFXSyncBus::register_group(CFXSyncComponent *group) {
     ESP_LOGW(TAG, "Maximum CFX Sync group count reached");
     return;
   }
+#if defined(USE_ESP32)
+  const size_t index = this->group_count_;
+  this->rx_keys_[index].prepare(group->key_);
+  this->rx_group_hashes_[index] = group->group_hash();
+  this->rx_group_count_.store(index + 1, std::memory_order_release);
+#endif
   this->groups_[this->group_count_++] = group;
 }
 
@@ -102,7 +112,126 @@ bool CFXSyncBus::begin_udp(uint16_t port) {
   return true;
 }
 
-void CFXSyncBus::poll() { this->udp_.poll(this); }
+void CFXSyncBus::poll() {
+#if defined(USE_ESP32)
+  if (this->rx_task_ != nullptr) {
+    this->udp_.maintain();
+    this->drain_rx_ring_();
+    return;
+  }
+#endif
+  this->udp_.poll(this);
+}
+
+#if defined(USE_ESP32)
+bool CFXSyncBus::start_rx_task() {
+  if (this->rx_task_ != nullptr) {
+    return true;
+  }
+  if (!this->udp_.is_ready()) {
+    return false;
+  }
+  this->rx_ring_.reset(new CFXSyncRxRing<RxSlot, RX_RING_SIZE>());
+  // Priority 5 on the loop's core, away from the core 0 render task: the
+  // task sleeps in select() between bursts, and running above the loop
+  // lets a datagram be stamped and authenticated while the loop is still
+  // busy rendering or applying the previous one.
+  BaseType_t ret = xTaskCreatePinnedToCore(rx_task_fn_, "cfx_sync_rx", 3072,
+                                           this, 5, &this->rx_task_,
+                                           xPortGetCoreID());
+  if (ret != pdPASS) {
+    this->rx_task_ = nullptr;
+    this->rx_ring_.reset();
+    ESP_LOGW(TAG, "Receive task create failed (err=%d); using the loop",
+             static_cast<int>(ret));
+    return false;
+  }
+  ESP_LOGD(TAG, "UDP receive task started");
+  return true;
+}
+
+void CFXSyncBus::rx_task_fn_(void *arg) {
+  static_cast<CFXSyncBus *>(arg)->rx_task_loop_();
+}
+
+void CFXSyncBus::rx_task_loop_() {
+  using WaitResult = CFXSyncUDPTransport::WaitResult;
+  uint32_t backoff_ms = 0;
+  while (true) {
+    const WaitResult wait = this->udp_.wait_readable(RX_WAIT_MS);
+    if (wait == WaitResult::TIMEOUT ||
+        (wait == WaitResult::READABLE && this->receive_batch_())) {
+      backoff_ms = 0;
+      continue;
+    }
+    // A closed socket, a select() error or a readable socket that yields
+    // nothing all return at once; without a pause the task would spin
+    // above the loop and starve it.
+    backoff_ms = backoff_ms == 0
+                     ? RX_BACKOFF_MIN_MS
+                     : std::min<uint32_t>(backoff_ms * 2, RX_BACKOFF_MAX_MS);
+    vTaskDelay(pdMS_TO_TICKS(backoff_ms));
+  }
+}
+
+// False when the socket was readable but gave nothing back.
+bool CFXSyncBus::receive_batch_() {
+  for (size_t taken = 0; taken < RX_BATCH; taken++) {
+    RxSlot *slot = this->rx_ring_->claim();
+    if (slot == nullptr) {
+      // The loop is behind; the rest waits in the socket buffer while it
+      // catches up.
+      this->rx_deferred_.fetch_add(1, std::memory_order_relaxed);
+      vTaskDelay(1);
+      return true;
+    }
+    if (!this->udp_.receive(slot->data, sizeof(slot->data), slot->size,
+                            slot->source)) {
+      return taken > 0;
+    }
+    slot->received_us = esp_timer_get_time();
+    slot->group = -1;
+
+    uint32_t packet_group_hash = 0;
+    if (CFXSyncPacketCodec::peek_group_hash(slot->data, slot->size,
+                                            packet_group_hash) ==
+        CFXSyncDecodeResult::OK) {
+      const size_t count =
+          this->rx_group_count_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < count; i++) {
+        if (this->rx_group_hashes_[i] != packet_group_hash) {
+          continue;
+        }
+        slot->result = CFXSyncPacketCodec::decode(
+            slot->data, slot->size, packet_group_hash, this->rx_keys_[i],
+            slot->packet);
+        slot->group = static_cast<int8_t>(i);
+        break;
+      }
+    }
+    this->rx_ring_->publish();
+  }
+  return true;
+}
+
+void CFXSyncBus::drain_rx_ring_() {
+  for (size_t handled = 0; handled < RX_DRAIN_BATCH; handled++) {
+    RxSlot *slot = this->rx_ring_->front();
+    if (slot == nullptr) {
+      return;
+    }
+    if (slot->group < 0) {
+      // Foreign traffic, or a header no group claims: the normal path
+      // sorts it out.
+      this->dispatch_packet(slot->source, slot->data, slot->size);
+    } else {
+      this->groups_[slot->group]->handle_rx_packet_(
+          slot->source, slot->result, slot->packet, slot->received_us);
+    }
+    this->rx_ring_->pop();
+  }
+}
+#endif
 
 bool CFXSyncBus::send_udp(const uint8_t *data, size_t size) {
   if (data == nullptr || size == 0 ||
@@ -130,6 +259,26 @@ bool CFXSyncBus::send_udp_to(uint32_t address, uint16_t port,
   return this->send_udp_to(address, port, packet.data(), packet.size());
 }
 
+bool CFXSyncBus::send_udp_group(uint32_t address,
+                                const std::vector<uint8_t> &packet) {
+  if (packet.empty() || packet.size() > CFX_SYNC_SHARED_TRANSPORT_MTU) {
+    return false;
+  }
+  return this->udp_.send_group(address, packet.data(), packet.size());
+}
+
+void CFXSyncBus::dump_peer_stats() {
+  for (size_t i = 0; i < this->group_count_; i++) {
+    this->groups_[i]->dump_peer_stats();
+  }
+}
+
+void CFXSyncBus::reset_peer_stats() {
+  for (size_t i = 0; i < this->group_count_; i++) {
+    this->groups_[i]->reset_peer_stats();
+  }
+}
+
 bool CFXSyncBus::dispatch_shared_transport_packet_(
     CFXSyncReceivePath path, const CFXSyncSource &source, const uint8_t *data,
     size_t size) {
@@ -16,9 +16,17 @@
 #include <esp_err.h>
 #endif
 #include "esphome/core/version.h"
+#if defined(USE_ESP32)
+#include "cfx_sync_packet.h"
+#include "cfx_sync_rx_ring.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -99,6 +107,20 @@ class CFXSyncBus
 #endif
 
   bool begin_udp(uint16_t port);
+#if defined(USE_ESP32)
+  // Moves UDP receive and decode off the main loop; poll() then only
+  // hands over what the task queued. Safe to call once per group.
+  bool start_rx_task();
+  bool is_rx_task_running() const { return this->rx_task_ != nullptr; }
+  // Times the ring was full and datagrams were left in the socket.
+  uint32_t rx_deferred() const {
+    return this->rx_deferred_.load(std::memory_order_relaxed);
+  }
+  // The receive ring is allocated on start_rx_task(); 0 before that.
+  size_t rx_ring_bytes() const {
+    return this->rx_ring_ != nullptr ? sizeof(*this->rx_ring_) : 0;
+  }
+#endif
   void poll();
   bool send_udp(const uint8_t *data, size_t size);
   bool send_udp(const std::vector<uint8_t> &packet);
@@ -106,6 +128,30 @@ class CFXSyncBus
                    size_t size);
   bool send_udp_to(uint32_t address, uint16_t port,
                    const std::vector<uint8_t> &packet);
+  bool join_udp_group(uint32_t address) {
+    return this->udp_.join_group(address);
+  }
+  bool is_udp_group_joined(uint32_t address) const {
+    return this->udp_.is_group_joined(address);
+  }
+  bool send_udp_group(uint32_t address, const std::vector<uint8_t> &packet);
+
+  void dump_peer_stats();
+  void reset_peer_stats();
+
+#ifdef USE_CFX_TRACE
+  // Diagnostics hook for cfx_profiler's trace: every packet a group sends
+  // (tx, wire bytes) or accepts (rx, packet type).
+  using PacketObserver = void (*)(bool tx, uint16_t arg);
+  void set_packet_observer(PacketObserver observer) {
+    this->packet_observer_ = observer;
+  }
+  void observe_packet(bool tx, uint16_t arg) const {
+    if (this->packet_observer_ != nullptr) {
+      this->packet_observer_(tx, arg);
+    }
+  }
+#endif
 
   bool dispatch_packet(const CFXSyncSource &source, const uint8_t *data,
                        size_t size);
@@ -128,6 +174,47 @@ class CFXSyncBus
 
   CFXSyncUDPTransport udp_;
   uint16_t udp_port_{0};
+#ifdef USE_CFX_TRACE
+  PacketObserver packet_observer_{nullptr};
+#endif
+
+#if defined(USE_ESP32)
+  static constexpr size_t RX_RING_SIZE = 8;
+  // Datagrams taken per wakeup and handed to groups per poll(); both keep
+  // a flood from holding either side for long.
+  static constexpr size_t RX_BATCH = 4;
+  static constexpr size_t RX_DRAIN_BATCH = 8;
+  static constexpr uint32_t RX_WAIT_MS = 100;
+  // Backoff after a wait or receive that failed at once, doubling up to
+  // the cap while the socket stays unusable.
+  static constexpr uint32_t RX_BACKOFF_MIN_MS = 10;
+  static constexpr uint32_t RX_BACKOFF_MAX_MS = 1000;
+
+  struct RxSlot {
+    CFXSyncSource source;
+    uint8_t data[CFX_SYNC_SHARED_TRANSPORT_MTU + 1];
+    size_t size{0};
+    // Index of the group it decoded for, or -1 to dispatch the raw bytes.
+    int8_t group{-1};
+    CFXSyncDecodeResult result{CFXSyncDecodeResult::OK};
+    CFXSyncPacket packet;
+    uint64_t received_us{0};
+  };
+
+  static void rx_task_fn_(void *arg);
+  void rx_task_loop_();
+  bool receive_batch_();
+  void drain_rx_ring_();
+
+  // Copies the task decodes with; groups only ever append, and the count
+  // is published after the slot is written.
+  CFXSyncHmacKey rx_keys_[MAX_GROUPS];
+  uint32_t rx_group_hashes_[MAX_GROUPS]{};
+  std::atomic<size_t> rx_group_count_{0};
+  std::unique_ptr<CFXSyncRxRing<RxSlot, RX_RING_SIZE>> rx_ring_;
+  TaskHandle_t rx_task_{nullptr};
+  std::atomic<uint32_t> rx_deferred_{0};
+#endif
 
 #ifdef USE_ESPNOW
   espnow::ESPNowComponent *espnow_{nullptr};
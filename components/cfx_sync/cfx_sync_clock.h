@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * Follower-side estimate of the leader clock from STATE timebases.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace cfx_sync {
+
+// Each STATE carrying FIELD_TIMEBASE is one sample: the leader's clock at
+// send plus the one-way delay it measured, against our clock at receive.
+// Offset and skew follow the samples with a simple phase/frequency loop:
+//
+//   - a packet can arrive late but never early, so a sample well ahead of
+//     the prediction means the estimate was built on a late one and is
+//     taken at once;
+//   - a sample well behind it (a retry, a stalled loop) is dropped, unless
+//     OUTLIER_STRIKES arrive in a row, which means the leader clock moved;
+//   - anything else nudges the offset halfway and the skew a quarter of the
+//     way towards the sample.
+//
+// Pure arithmetic with no platform dependencies so it can run off-target.
+class CFXSyncClockEstimator {
+ public:
+  static constexpr int64_t OUTLIER_US = 20000;
+  static constexpr uint8_t OUTLIER_STRIKES = 3;
+  // Crystal tolerance is tens of ppm; anything past this is noise.
+  static constexpr int32_t MAX_SKEW_PPB = 200000;
+  // Shorter spans say more about jitter than about frequency.
+  static constexpr int64_t MIN_SKEW_SPAN_US = 1000000;
+
+  void reset() {
+    this->locked_ = false;
+    this->offset_us_ = 0;
+    this->skew_ppb_ = 0;
+    this->anchor_us_ = 0;
+    this->strikes_ = 0;
+  }
+
+  // Returns true when the sample was taken into the estimate.
+  bool add_sample(uint64_t leader_us, uint32_t delay_us, uint64_t local_us) {
+    const int64_t sample =
+        static_cast<int64_t>(leader_us + delay_us - local_us);
+    if (!this->locked_) {
+      this->step_(sample, local_us);
+      return true;
+    }
+
+    const int64_t span = static_cast<int64_t>(local_us - this->anchor_us_);
+    const int64_t predicted = this->predict_(local_us);
+    const int64_t residual = sample - predicted;
+    if (residual > OUTLIER_US) {
+      this->step_(sample, local_us);
+      return true;
+    }
+    if (residual < -OUTLIER_US) {
+      if (++this->strikes_ < OUTLIER_STRIKES) {
+        return false;
+      }
+      this->step_(sample, local_us);
+      return true;
+    }
+
+    this->strikes_ = 0;
+    if (span >= MIN_SKEW_SPAN_US) {
+      int64_t skew = this->skew_ppb_ + residual * 1000000000LL / span / 4;
+      if (skew > MAX_SKEW_PPB) {
+        skew = MAX_SKEW_PPB;
+      } else if (skew < -MAX_SKEW_PPB) {
+        skew = -MAX_SKEW_PPB;
+      }
+      this->skew_ppb_ = static_cast<int32_t>(skew);
+    }
+    this->offset_us_ = predicted + residual / 2;
+    this->anchor_us_ = local_us;
+    return true;
+  }
+
+  bool locked() const { return this->locked_; }
+  // leader = local + offset + skew * (local - anchor).
+  int64_t offset_us() const { return this->offset_us_; }
+  int32_t skew_ppb() const { return this->skew_ppb_; }
+  uint64_t anchor_us() const { return this->anchor_us_; }
+
+ protected:
+  int64_t predict_(uint64_t local_us) const {
+    const int64_t span = static_cast<int64_t>(local_us - this->anchor_us_);
+    return this->offset_us_ + span * this->skew_ppb_ / 1000000000LL;
+  }
+
+  void step_(int64_t sample, uint64_t local_us) {
+    this->locked_ = true;
+    this->offset_us_ = sample;
+    this->anchor_us_ = local_us;
+    this->strikes_ = 0;
+  }
+
+  bool locked_{false};
+  int64_t offset_us_{0};
+  int32_t skew_ppb_{0};
+  uint64_t anchor_us_{0};
+  uint8_t strikes_{0};
+};
+
+}  // namespace cfx_sync
+}  // namespace esphome
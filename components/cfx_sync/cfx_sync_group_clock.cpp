@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * Shared group clock for synchronized effect timelines.
+ */
+
+#include "cfx_sync_group_clock.h"
+
+#if !defined(USE_ESP8266)
+
+namespace esphome {
+namespace cfx_sync {
+
+CFXSyncGroupClock &CFXSyncGroupClock::get() {
+  static CFXSyncGroupClock instance;
+  return instance;
+}
+
+void CFXSyncGroupClock::set_source() {
+  portENTER_CRITICAL(&this->lock_);
+  this->source_ = true;
+  this->locked_ = true;
+  this->offset_us_ = 0;
+  this->skew_ppb_ = 0;
+  this->anchor_us_ = 0;
+  portEXIT_CRITICAL(&this->lock_);
+}
+
+void CFXSyncGroupClock::set_estimate(int64_t offset_us, int32_t skew_ppb,
+                                     uint64_t anchor_us) {
+  portENTER_CRITICAL(&this->lock_);
+  this->source_ = false;
+  this->locked_ = true;
+  this->offset_us_ = offset_us;
+  this->skew_ppb_ = skew_ppb;
+  this->anchor_us_ = anchor_us;
+  portEXIT_CRITICAL(&this->lock_);
+}
+
+void CFXSyncGroupClock::unlock() {
+  portENTER_CRITICAL(&this->lock_);
+  if (!this->source_) {
+    this->locked_ = false;
+  }
+  portEXIT_CRITICAL(&this->lock_);
+}
+
+bool CFXSyncGroupClock::add_channel(const void *key) {
+  bool added = false;
+  portENTER_CRITICAL(&this->lock_);
+  if (this->find_(key) != nullptr) {
+    added = true;
+  } else if (this->channel_count_ < MAX_CHANNELS) {
+    this->channels_[this->channel_count_++].key = key;
+    added = true;
+  }
+  portEXIT_CRITICAL(&this->lock_);
+  return added;
+}
+
+void CFXSyncGroupClock::set_epoch(const void *key, uint64_t epoch_us) {
+  portENTER_CRITICAL(&this->lock_);
+  Channel *channel = this->find_(key);
+  if (channel != nullptr &&
+      (!channel->has_epoch || channel->epoch_us != epoch_us)) {
+    channel->has_epoch = true;
+    channel->epoch_us = epoch_us;
+    channel->revision++;
+  }
+  portEXIT_CRITICAL(&this->lock_);
+}
+
+bool CFXSyncGroupClock::epoch(const void *key, uint64_t &epoch_us,
+                              uint32_t &revision) const {
+  bool found = false;
+  portENTER_CRITICAL(&this->lock_);
+  const Channel *channel = this->find_(key);
+  if (channel != nullptr && channel->has_epoch) {
+    epoch_us = channel->epoch_us;
+    revision = channel->revision;
+    found = true;
+  }
+  portEXIT_CRITICAL(&this->lock_);
+  return found;
+}
+
+bool CFXSyncGroupClock::locked() const {
+  portENTER_CRITICAL(&this->lock_);
+  const bool value = this->locked_;
+  portEXIT_CRITICAL(&this->lock_);
+  return value;
+}
+
+bool CFXSyncGroupClock::is_source() const {
+  portENTER_CRITICAL(&this->lock_);
+  const bool value = this->source_;
+  portEXIT_CRITICAL(&this->lock_);
+  return value;
+}
+
+uint64_t CFXSyncGroupClock::group_us(uint64_t local_us) const {
+  portENTER_CRITICAL(&this->lock_);
+  const uint64_t value = this->group_us_locked_(local_us);
+  portEXIT_CRITICAL(&this->lock_);
+  return value;
+}
+
+bool CFXSyncGroupClock::timeline_us(const void *key, uint64_t local_us,
+                                    uint64_t &elapsed_us) const {
+  // Channels are only added during setup, so an unsynced node skips the
+  // lock on every frame.
+  if (this->channel_count_ == 0) {
+    return false;
+  }
+  bool valid = false;
+  portENTER_CRITICAL(&this->lock_);
+  const Channel *channel = this->locked_ ? this->find_(key) : nullptr;
+  if (channel != nullptr && channel->has_epoch) {
+    const uint64_t now = this->group_us_locked_(local_us);
+    // An epoch slightly ahead of us (estimate noise) reads as 0.
+    elapsed_us = now > channel->epoch_us ? now - channel->epoch_us : 0;
+    valid = true;
+  }
+  portEXIT_CRITICAL(&this->lock_);
+  return valid;
+}
+
+bool CFXSyncGroupClock::restart(const void *key, uint64_t local_us) {
+  if (this->channel_count_ == 0) {
+    return false;
+  }
+  bool handled = false;
+  portENTER_CRITICAL(&this->lock_);
+  Channel *channel = this->source_ ? this->find_(key) : nullptr;
+  if (channel != nullptr) {
+    channel->has_epoch = true;
+    channel->epoch_us = local_us;
+    channel->revision++;
+    handled = true;
+  }
+  portEXIT_CRITICAL(&this->lock_);
+  return handled;
+}
+
+const CFXSyncGroupClock::Channel *CFXSyncGroupClock::find_(
+    const void *key) const {
+  for (uint8_t i = 0; i < this->channel_count_; i++) {
+    if (this->channels_[i].key == key) {
+      return &this->channels_[i];
+    }
+  }
+  return nullptr;
+}
+
+CFXSyncGroupClock::Channel *CFXSyncGroupClock::find_(const void *key) {
+  for (uint8_t i = 0; i < this->channel_count_; i++) {
+    if (this->channels_[i].key == key) {
+      return &this->channels_[i];
+    }
+  }
+  return nullptr;
+}
+
+uint64_t CFXSyncGroupClock::group_us_locked_(uint64_t local_us) const {
+  if (this->source_ || !this->locked_) {
+    return local_us;
+  }
+  const int64_t since_anchor = static_cast<int64_t>(local_us - this->anchor_us_);
+  const int64_t drift = since_anchor * this->skew_ppb_ / 1000000000LL;
+  return static_cast<uint64_t>(static_cast<int64_t>(local_us) +
+                               this->offset_us_ + drift);
+}
+
+}  // namespace cfx_sync
+}  // namespace esphome
+
+#endif  // !defined(USE_ESP8266)
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * Shared group clock for synchronized effect timelines.
+ *
+ * The leader's esp_timer is the group clock; followers map their own clock
+ * onto it with the offset and skew estimated from STATE timebases. Each
+ * synced light has a channel holding its effect epoch: the group time at
+ * which the leader's effect timeline was 0.
+ *
+ * An effect bound to a channel derives its timeline from the group clock
+ * (group now - epoch) instead of its own start time, so every node in the
+ * group shows the same animation phase without per-frame traffic. On the
+ * leader an effect restart moves the epoch instead, and the next STATE
+ * carries it.
+ *
+ * Writers are cfx_sync and effect restarts, both on the main loop. Readers
+ * are effects drawing on either core, so every access takes the lock.
+ * Effects only animate on ESP32; host builds without a platform define
+ * compile it against the FreeRTOS stubs.
+ */
+
+#pragma once
+
+#if !defined(USE_ESP8266)
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+
+namespace esphome {
+namespace cfx_sync {
+
+class CFXSyncGroupClock {
+ public:
+  // A leader, a follower group and segments fit comfortably.
+  static constexpr uint8_t MAX_CHANNELS = 8;
+
+  static CFXSyncGroupClock &get();
+
+  // ── cfx_sync side ─────────────────────────────────────────────────────
+
+  // Leader: group time is the local clock.
+  void set_source();
+  // Follower: group = local + offset_us + skew_ppb * (local - anchor_us).
+  void set_estimate(int64_t offset_us, int32_t skew_ppb, uint64_t anchor_us);
+  // Forgets the estimate; bound effects fall back to their own timeline.
+  void unlock();
+  // `key` is the synced light (its LightState). Returns false when full.
+  bool add_channel(const void *key);
+  void set_epoch(const void *key, uint64_t epoch_us);
+  // Epoch and a counter bumped on every change, for the leader to notice
+  // effect restarts.
+  bool epoch(const void *key, uint64_t &epoch_us, uint32_t &revision) const;
+
+  bool locked() const;
+  bool is_source() const;
+  uint64_t group_us(uint64_t local_us) const;
+
+  // ── Effect side ───────────────────────────────────────────────────────
+
+  // Timeline position for the effect drawing `key`, in µs. False while the
+  // clock is unlocked or the channel has no epoch yet.
+  bool timeline_us(const void *key, uint64_t local_us,
+                   uint64_t &elapsed_us) const;
+  // Called when an effect restarts. On the leader the restart becomes the
+  // new epoch and true is returned; elsewhere nothing changes.
+  bool restart(const void *key, uint64_t local_us);
+
+ private:
+  CFXSyncGroupClock() = default;
+
+  struct Channel {
+    const void *key{nullptr};
+    bool has_epoch{false};
+    uint64_t epoch_us{0};
+    uint32_t revision{0};
+  };
+
+  const Channel *find_(const void *key) const;
+  Channel *find_(const void *key);
+  uint64_t group_us_locked_(uint64_t local_us) const;
+
+  Channel channels_[MAX_CHANNELS];
+  uint8_t channel_count_{0};
+  bool locked_{false};
+  bool source_{false};
+  int64_t offset_us_{0};
+  int32_t skew_ppb_{0};
+  uint64_t anchor_us_{0};
+  mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
+
+}  // namespace cfx_sync
+}  // namespace esphome
+
+#endif  // !defined(USE_ESP8266)
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * HMAC-SHA256 with the group key schedule computed once.
+ */
+
+#include "cfx_sync_hmac.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace cfx_sync {
+
+static constexpr uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr(uint32_t value, uint8_t bits) {
+  return (value >> bits) | (value << (32 - bits));
+}
+
+void CFXSyncSha256::init() {
+  this->state_[0] = 0x6a09e667;
+  this->state_[1] = 0xbb67ae85;
+  this->state_[2] = 0x3c6ef372;
+  this->state_[3] = 0xa54ff53a;
+  this->state_[4] = 0x510e527f;
+  this->state_[5] = 0x9b05688c;
+  this->state_[6] = 0x1f83d9ab;
+  this->state_[7] = 0x5be0cd19;
+  this->length_ = 0;
+  this->buffered_ = 0;
+}
+
+void CFXSyncSha256::compress_(const uint8_t *block) {
+  uint32_t w[64];
+  for (uint8_t i = 0; i < 16; i++) {
+    w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) |
+           (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+           (static_cast<uint32_t>(block[i * 4 + 2]) << 8) |
+           static_cast<uint32_t>(block[i * 4 + 3]);
+  }
+  for (uint8_t i = 16; i < 64; i++) {
+    const uint32_t s0 =
+        rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const uint32_t s1 =
+        rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = this->state_[0];
+  uint32_t b = this->state_[1];
+  uint32_t c = this->state_[2];
+  uint32_t d = this->state_[3];
+  uint32_t e = this->state_[4];
+  uint32_t f = this->state_[5];
+  uint32_t g = this->state_[6];
+  uint32_t h = this->state_[7];
+  for (uint8_t i = 0; i < 64; i++) {
+    const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+    const uint32_t ch = (e & f) ^ (~e & g);
+    const uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+    const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+    const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    const uint32_t t2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  this->state_[0] += a;
+  this->state_[1] += b;
+  this->state_[2] += c;
+  this->state_[3] += d;
+  this->state_[4] += e;
+  this->state_[5] += f;
+  this->state_[6] += g;
+  this->state_[7] += h;
+}
+
+void CFXSyncSha256::update(const uint8_t *data, size_t size) {
+  this->length_ += size;
+  if (this->buffered_ != 0) {
+    const size_t take = std::min(size, BLOCK_SIZE - this->buffered_);
+    memcpy(this->buffer_ + this->buffered_, data, take);
+    this->buffered_ += take;
+    data += take;
+    size -= take;
+    if (this->buffered_ < BLOCK_SIZE) {
+      return;
+    }
+    this->compress_(this->buffer_);
+    this->buffered_ = 0;
+  }
+  while (size >= BLOCK_SIZE) {
+    this->compress_(data);
+    data += BLOCK_SIZE;
+    size -= BLOCK_SIZE;
+  }
+  if (size != 0) {
+    memcpy(this->buffer_, data, size);
+    this->buffered_ = size;
+  }
+}
+
+void CFXSyncSha256::finish(uint8_t *digest) {
+  const uint64_t bits = this->length_ * 8;
+  this->buffer_[this->buffered_++] = 0x80;
+  if (this->buffered_ > BLOCK_SIZE - 8) {
+    memset(this->buffer_ + this->buffered_, 0, BLOCK_SIZE - this->buffered_);
+    this->compress_(this->buffer_);
+    this->buffered_ = 0;
+  }
+  memset(this->buffer_ + this->buffered_, 0,
+         BLOCK_SIZE - 8 - this->buffered_);
+  for (uint8_t i = 0; i < 8; i++) {
+    this->buffer_[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+  }
+  this->compress_(this->buffer_);
+  this->buffered_ = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    digest[i * 4] = static_cast<uint8_t>(this->state_[i] >> 24);
+    digest[i * 4 + 1] = static_cast<uint8_t>(this->state_[i] >> 16);
+    digest[i * 4 + 2] = static_cast<uint8_t>(this->state_[i] >> 8);
+    digest[i * 4 + 3] = static_cast<uint8_t>(this->state_[i]);
+  }
+}
+
+void CFXSyncHmacKey::prepare(const std::array<uint8_t, 32> &key) {
+  // A 32-byte key is shorter than the block, so it is used as-is.
+  uint8_t pad[CFXSyncSha256::BLOCK_SIZE];
+  memset(pad, 0x36, sizeof(pad));
+  for (size_t i = 0; i < key.size(); i++) {
+    pad[i] ^= key[i];
+  }
+  this->inner_.init();
+  this->inner_.update(pad, sizeof(pad));
+
+  memset(pad, 0x5c, sizeof(pad));
+  for (size_t i = 0; i < key.size(); i++) {
+    pad[i] ^= key[i];
+  }
+  this->outer_.init();
+  this->outer_.update(pad, sizeof(pad));
+  memset(pad, 0, sizeof(pad));
+}
+
+void CFXSyncHmacKey::sign(const uint8_t *data, size_t size,
+                          uint8_t *digest) const {
+  uint8_t inner_digest[CFXSyncSha256::DIGEST_SIZE];
+  CFXSyncSha256 inner = this->inner_;
+  inner.update(data, size);
+  inner.finish(inner_digest);
+
+  CFXSyncSha256 outer = this->outer_;
+  outer.update(inner_digest, sizeof(inner_digest));
+  outer.finish(digest);
+}
+
+}  // namespace cfx_sync
+}  // namespace esphome
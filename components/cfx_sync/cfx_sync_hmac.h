@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * HMAC-SHA256 with the group key schedule computed once.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace cfx_sync {
+
+// Plain software SHA-256. Unlike the ESPHome wrapper (which may hold a
+// hardware context on ESP32) its state is a value, so a midstate can be
+// copied and resumed.
+class CFXSyncSha256 {
+ public:
+  static constexpr size_t BLOCK_SIZE = 64;
+  static constexpr size_t DIGEST_SIZE = 32;
+
+  void init();
+  void update(const uint8_t *data, size_t size);
+  void finish(uint8_t *digest);
+
+ protected:
+  void compress_(const uint8_t *block);
+
+  uint32_t state_[8]{};
+  uint64_t length_{0};
+  uint8_t buffer_[BLOCK_SIZE]{};
+  size_t buffered_{0};
+};
+
+// The ipad and opad blocks only depend on the key, so both hashes are
+// primed once and every tag starts from a copy of those midstates: two
+// compressions per packet saved and no key handling on the send path.
+class CFXSyncHmacKey {
+ public:
+  void prepare(const std::array<uint8_t, 32> &key);
+  void sign(const uint8_t *data, size_t size, uint8_t *digest) const;
+
+ protected:
+  CFXSyncSha256 inner_;
+  CFXSyncSha256 outer_;
+};
+
+}  // namespace cfx_sync
+}  // namespace esphome
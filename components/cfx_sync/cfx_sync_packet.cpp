@@ -9,13 +9,13 @@ namespace cfx_sync {
 
 static constexpr uint8_t CFX_SYNC_MAGIC[4] = {'C', 'F', 'X', 'S'};
 
-void CFXSyncPacketCodec::append_u16_(std::vector<uint8_t> &output,
+void CFXSyncPacketCodec::append_u16_(CFXSyncPacketWriter &output,
                                      uint16_t value) {
   output.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
   output.push_back(static_cast<uint8_t>(value & 0xFF));
 }
 
-void CFXSyncPacketCodec::append_u32_(std::vector<uint8_t> &output,
+void CFXSyncPacketCodec::append_u32_(CFXSyncPacketWriter &output,
                                      uint32_t value) {
   output.push_back(static_cast<uint8_t>((value >> 24) & 0xFF));
   output.push_back(static_cast<uint8_t>((value >> 16) & 0xFF));
@@ -23,6 +23,12 @@ void CFXSyncPacketCodec::append_u32_(std::vector<uint8_t> &output,
   output.push_back(static_cast<uint8_t>(value & 0xFF));
 }
 
+void CFXSyncPacketCodec::append_u64_(CFXSyncPacketWriter &output,
+                                     uint64_t value) {
+  append_u32_(output, static_cast<uint32_t>(value >> 32));
+  append_u32_(output, static_cast<uint32_t>(value & 0xFFFFFFFFULL));
+}
+
 uint16_t CFXSyncPacketCodec::read_u16_(const uint8_t *data) {
   return (static_cast<uint16_t>(data[0]) << 8) |
          static_cast<uint16_t>(data[1]);
@@ -35,16 +41,41 @@ uint32_t CFXSyncPacketCodec::read_u32_(const uint8_t *data) {
          static_cast<uint32_t>(data[3]);
 }
 
+uint64_t CFXSyncPacketCodec::read_u64_(const uint8_t *data) {
+  return (static_cast<uint64_t>(read_u32_(data)) << 32) |
+         static_cast<uint64_t>(read_u32_(data + 4));
+}
+
+const CFXSyncHmacKey &CFXSyncPacketCodec::hmac_key_(
+    const std::array<uint8_t, 32> &key) {
+  // Main loop only. A node carries one key per sync component, so a few
+  // slots cover every group and the schedule runs once per key.
+  struct Slot {
+    bool valid{false};
+    std::array<uint8_t, 32> key{};
+    CFXSyncHmacKey hmac;
+  };
+  static Slot slots[HMAC_KEY_SLOTS];
+  static uint8_t next_slot = 0;
+
+  for (auto &slot : slots) {
+    if (slot.valid && slot.key == key) {
+      return slot.hmac;
+    }
+  }
+  Slot &slot = slots[next_slot];
+  next_slot = static_cast<uint8_t>((next_slot + 1) % HMAC_KEY_SLOTS);
+  slot.valid = true;
+  slot.key = key;
+  slot.hmac.prepare(key);
+  return slot.hmac;
+}
+
 void CFXSyncPacketCodec::calculate_tag_(
     const uint8_t *data, size_t size, const std::array<uint8_t, 32> &key,
     uint8_t *tag) {
-  hmac_sha256::HmacSHA256 hmac;
-  hmac.init(key.data(), key.size());
-  hmac.add(data, size);
-  hmac.calculate();
-
-  uint8_t digest[32];
-  hmac.get_bytes(digest);
+  uint8_t digest[CFXSyncSha256::DIGEST_SIZE];
+  hmac_key_(key).sign(data, size, digest);
   memcpy(tag, digest, AUTH_TAG_SIZE);
 }
 
@@ -112,37 +143,62 @@ bool CFXSyncPacketCodec::is_valid_utf8_(const uint8_t *data, size_t size) {
   return true;
 }
 
-bool CFXSyncPacketCodec::encode_(
-    CFXSyncPacketType type, uint32_t group_hash, uint32_t boot_id,
-    uint32_t sequence, const uint8_t *payload, size_t payload_size,
-    const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
-  if (payload_size > UINT16_MAX) {
-    return false;
-  }
-
+void CFXSyncPacketCodec::begin_(CFXSyncPacketType type, uint8_t flags,
+                                uint32_t group_hash, uint32_t boot_id,
+                                uint32_t sequence, CFXSyncPacketWriter &output,
+                                CFXSyncPacketWriter &payload) {
   output.clear();
-  output.reserve(HEADER_SIZE + payload_size + AUTH_TAG_SIZE);
-  output.insert(output.end(), CFX_SYNC_MAGIC,
-                CFX_SYNC_MAGIC + sizeof(CFX_SYNC_MAGIC));
+  output.append(CFX_SYNC_MAGIC, sizeof(CFX_SYNC_MAGIC));
   output.push_back(VERSION);
   output.push_back(static_cast<uint8_t>(type));
-  output.push_back(0);  // Flags reserved for future protocol revisions.
+  output.push_back(flags);
   output.push_back(static_cast<uint8_t>(HEADER_SIZE));
-  append_u16_(output, static_cast<uint16_t>(payload_size));
+  append_u16_(output, 0);  // Payload length, filled in by finish_().
   append_u32_(output, group_hash);
   append_u32_(output, boot_id);
   append_u32_(output, sequence);
 
-  if (payload != nullptr && payload_size != 0) {
-    output.insert(output.end(), payload, payload + payload_size);
+  // The payload is written in place; its capacity leaves room for the tag.
+  const size_t spare = output.overflowed()
+                           ? 0
+                           : output.capacity() - output.size();
+  payload = CFXSyncPacketWriter(
+      output.data() + output.size(),
+      spare > AUTH_TAG_SIZE ? spare - AUTH_TAG_SIZE : 0);
+}
+
+bool CFXSyncPacketCodec::finish_(const CFXSyncPacketWriter &payload,
+                                 const std::array<uint8_t, 32> &key,
+                                 CFXSyncPacketWriter &output) {
+  if (output.overflowed() || payload.overflowed() ||
+      output.capacity() < HEADER_SIZE + AUTH_TAG_SIZE ||
+      payload.size() > UINT16_MAX) {
+    output.clear();
+    return false;
   }
 
+  output.set_size(HEADER_SIZE + payload.size());
+  uint8_t *header = output.data();
+  header[8] = static_cast<uint8_t>((payload.size() >> 8) & 0xFF);
+  header[9] = static_cast<uint8_t>(payload.size() & 0xFF);
+
   uint8_t tag[AUTH_TAG_SIZE];
   calculate_tag_(output.data(), output.size(), key, tag);
-  output.insert(output.end(), tag, tag + AUTH_TAG_SIZE);
+  output.append(tag, AUTH_TAG_SIZE);
   return true;
 }
 
+template<typename Encode>
+static bool encode_vector(size_t capacity, std::vector<uint8_t> &output,
+                          Encode encode) {
+  // A caller that keeps its vector reuses the storage from the last packet.
+  output.resize(capacity);
+  CFXSyncPacketWriter writer(output.data(), output.size());
+  const bool encoded = encode(writer);
+  output.resize(encoded ? writer.size() : 0);
+  return encoded;
+}
+
 bool CFXSyncPacketCodec::encode_state(
     uint32_t group_hash, uint32_t boot_id, uint32_t sequence, bool power,
     uint8_t brightness, uint8_t color_brightness, uint8_t red, uint8_t green,
@@ -188,24 +244,28 @@ bool CFXSyncPacketCodec::encode_state(
     const CFXSyncEffectState &effect, bool has_controls,
     const CFXSyncControlState &controls, const CFXSyncTimingState &timing,
     const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
-  return encode_state_with_fields_(
-      group_hash, boot_id, sequence, power, brightness, true, true,
-      color_brightness, red, green, blue, white, has_white,
-      has_color_temperature, color_temperature_mireds, has_cold_warm_white,
-      cold_white, warm_white, has_effect, effect, has_controls, controls,
-      timing, key, output);
+  return encode_vector(
+      MAX_STATE_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_state_with_fields_(
+            group_hash, boot_id, sequence, 0, true, power, true, brightness,
+            true, true, color_brightness, red, green, blue, white, has_white,
+            has_color_temperature, color_temperature_mireds,
+            has_cold_warm_white, cold_white, warm_white, has_effect, effect,
+            has_controls, controls, timing, key, writer);
+      });
 }
 
 bool CFXSyncPacketCodec::encode_state_with_fields_(
-    uint32_t group_hash, uint32_t boot_id, uint32_t sequence, bool power,
-    uint8_t brightness, bool has_color, bool has_color_brightness,
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence, uint8_t flags,
+    bool has_power, bool power, bool has_brightness, uint8_t brightness,
+    bool has_color, bool has_color_brightness,
     uint8_t color_brightness, uint8_t red, uint8_t green, uint8_t blue,
     uint8_t white, bool has_white, bool has_color_temperature,
     uint16_t color_temperature_mireds, bool has_cold_warm_white,
     uint8_t cold_white, uint8_t warm_white, bool has_effect,
     const CFXSyncEffectState &effect, bool has_controls,
     const CFXSyncControlState &controls, const CFXSyncTimingState &timing,
-    const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
+    const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output) {
   if (has_effect) {
     const size_t name_size = effect.name.size();
     switch (effect.kind) {
@@ -225,9 +285,16 @@ bool CFXSyncPacketCodec::encode_state_with_fields_(
     }
   }
 
-  std::vector<uint8_t> payload;
-  payload.reserve(MAX_STATE_PAYLOAD_SIZE);
-  uint32_t field_mask = FIELD_POWER | FIELD_BRIGHTNESS;
+  CFXSyncPacketWriter payload;
+  begin_(CFXSyncPacketType::STATE, flags, group_hash, boot_id, sequence,
+         output, payload);
+  uint32_t field_mask = 0;
+  if (has_power) {
+    field_mask |= FIELD_POWER;
+  }
+  if (has_brightness) {
+    field_mask |= FIELD_BRIGHTNESS;
+  }
   if (has_color) {
     field_mask |= FIELD_COLOR;
   }
@@ -252,9 +319,16 @@ bool CFXSyncPacketCodec::encode_state_with_fields_(
   if (timing.has_ramp) {
     field_mask |= FIELD_RAMP;
   }
+  if (timing.has_timebase) {
+    field_mask |= FIELD_TIMEBASE;
+  }
   append_u32_(payload, field_mask);
-  payload.push_back(power ? 1 : 0);
-  payload.push_back(brightness);
+  if (has_power) {
+    payload.push_back(power ? 1 : 0);
+  }
+  if (has_brightness) {
+    payload.push_back(brightness);
+  }
   if (has_color) {
     payload.push_back(has_white ? COLOR_CAP_WHITE : 0);
     payload.push_back(red);
@@ -282,11 +356,13 @@ bool CFXSyncPacketCodec::encode_state_with_fields_(
       case CFXSyncEffectKind::CHIMERAFX:
         payload.push_back(effect.effect_id);
         payload.push_back(static_cast<uint8_t>(effect.name.size()));
-        payload.insert(payload.end(), effect.name.begin(), effect.name.end());
+        payload.append(reinterpret_cast<const uint8_t *>(effect.name.data()),
+                       effect.name.size());
         break;
       case CFXSyncEffectKind::UNSUPPORTED:
         payload.push_back(static_cast<uint8_t>(effect.name.size()));
-        payload.insert(payload.end(), effect.name.begin(), effect.name.end());
+        payload.append(reinterpret_cast<const uint8_t *>(effect.name.data()),
+                       effect.name.size());
         break;
       default:
         return false;
@@ -351,9 +427,13 @@ bool CFXSyncPacketCodec::encode_state_with_fields_(
   if (timing.has_ramp) {
     append_u16_(payload, timing.ramp_ms);
   }
+  if (timing.has_timebase) {
+    append_u64_(payload, timing.leader_us);
+    append_u32_(payload, timing.delay_us);
+    append_u64_(payload, timing.epoch_us);
+  }
 
-  return encode_(CFXSyncPacketType::STATE, group_hash, boot_id, sequence,
-                 payload.data(), payload.size(), key, output);
+  return finish_(payload, key, output);
 }
 
 bool CFXSyncPacketCodec::encode_state_snapshot(
@@ -362,9 +442,23 @@ bool CFXSyncPacketCodec::encode_state_snapshot(
     const CFXSyncEffectState &effect, bool has_controls,
     const CFXSyncControlState &controls, const CFXSyncTimingState &timing,
     const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
+  return encode_vector(
+      MAX_STATE_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_state_snapshot(group_hash, boot_id, sequence, snapshot,
+                                     has_effect, effect, has_controls,
+                                     controls, timing, key, writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_state_snapshot(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    const CFXSyncLightSnapshot &snapshot, bool has_effect,
+    const CFXSyncEffectState &effect, bool has_controls,
+    const CFXSyncControlState &controls, const CFXSyncTimingState &timing,
+    const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output) {
   return encode_state_with_fields_(
-      group_hash, boot_id, sequence, snapshot.power, snapshot.brightness,
-      snapshot.has_color, snapshot.has_color_brightness,
+      group_hash, boot_id, sequence, 0, true, snapshot.power, true,
+      snapshot.brightness, snapshot.has_color, snapshot.has_color_brightness,
       snapshot.color_brightness, snapshot.red, snapshot.green,
       snapshot.blue, snapshot.white, snapshot.has_white,
       snapshot.has_color_temperature, snapshot.color_temperature_mireds,
@@ -373,17 +467,79 @@ bool CFXSyncPacketCodec::encode_state_snapshot(
       timing, key, output);
 }
 
+bool CFXSyncPacketCodec::encode_state_delta(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    const CFXSyncLightSnapshot &snapshot, uint32_t fields,
+    const CFXSyncEffectState &effect, const CFXSyncControlState &controls,
+    const CFXSyncTimingState &timing, const std::array<uint8_t, 32> &key,
+    std::vector<uint8_t> &output) {
+  return encode_vector(
+      MAX_STATE_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_state_delta(group_hash, boot_id, sequence, snapshot,
+                                  fields, effect, controls, timing, key,
+                                  writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_state_delta(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    const CFXSyncLightSnapshot &snapshot, uint32_t fields,
+    const CFXSyncEffectState &effect, const CFXSyncControlState &controls,
+    const CFXSyncTimingState &timing, const std::array<uint8_t, 32> &key,
+    CFXSyncPacketWriter &output) {
+  return encode_state_with_fields_(
+      group_hash, boot_id, sequence, FLAG_STATE_DELTA,
+      (fields & FIELD_POWER) != 0, snapshot.power,
+      (fields & FIELD_BRIGHTNESS) != 0, snapshot.brightness,
+      snapshot.has_color && (fields & FIELD_COLOR) != 0,
+      snapshot.has_color_brightness &&
+          (fields & FIELD_COLOR_BRIGHTNESS) != 0,
+      snapshot.color_brightness, snapshot.red, snapshot.green,
+      snapshot.blue, snapshot.white, snapshot.has_white,
+      snapshot.has_color_temperature &&
+          (fields & FIELD_COLOR_TEMPERATURE) != 0,
+      snapshot.color_temperature_mireds,
+      snapshot.has_cold_warm_white && (fields & FIELD_COLD_WARM_WHITE) != 0,
+      snapshot.cold_white, snapshot.warm_white,
+      (fields & FIELD_EFFECT) != 0, effect,
+      controls.has_any() && (fields & FIELD_CONTROLS) != 0, controls, timing,
+      key, output);
+}
+
 bool CFXSyncPacketCodec::encode_sync_request(
     uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
     const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
-  return encode_(CFXSyncPacketType::SYNC_REQUEST, group_hash, boot_id,
-                 sequence, nullptr, 0, key, output);
+  return encode_vector(
+      REQUEST_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_sync_request(group_hash, boot_id, sequence, key,
+                                   writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_sync_request(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output) {
+  CFXSyncPacketWriter payload;
+  begin_(CFXSyncPacketType::SYNC_REQUEST, 0, group_hash, boot_id, sequence,
+         output, payload);
+  return finish_(payload, key, output);
 }
 
 bool CFXSyncPacketCodec::encode_hello(
     uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
     CFXSyncNodeRole role, uint16_t capabilities,
     const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
+  return encode_vector(
+      HELLO_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_hello(group_hash, boot_id, sequence, role,
+                            capabilities, key, writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_hello(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    CFXSyncNodeRole role, uint16_t capabilities,
+    const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output) {
   switch (role) {
     case CFXSyncNodeRole::LEADER:
     case CFXSyncNodeRole::FOLLOWER:
@@ -394,12 +550,12 @@ bool CFXSyncPacketCodec::encode_hello(
       return false;
   }
 
-  std::vector<uint8_t> payload;
-  payload.reserve(HELLO_PAYLOAD_SIZE);
+  CFXSyncPacketWriter payload;
+  begin_(CFXSyncPacketType::HELLO, 0, group_hash, boot_id, sequence, output,
+         payload);
   payload.push_back(static_cast<uint8_t>(role));
   append_u16_(payload, capabilities);
-  return encode_(CFXSyncPacketType::HELLO, group_hash, boot_id, sequence,
-                 payload.data(), payload.size(), key, output);
+  return finish_(payload, key, output);
 }
 
 bool CFXSyncPacketCodec::encode_state_ack(
@@ -407,6 +563,28 @@ bool CFXSyncPacketCodec::encode_state_ack(
     uint32_t acked_boot_id, uint32_t acked_sequence,
     CFXSyncAckResult result, const std::array<uint8_t, 32> &key,
     std::vector<uint8_t> &output) {
+  return encode_state_ack(group_hash, boot_id, sequence, acked_boot_id,
+                          acked_sequence, result, false, 0, key, output);
+}
+
+bool CFXSyncPacketCodec::encode_state_ack(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    uint32_t acked_boot_id, uint32_t acked_sequence,
+    CFXSyncAckResult result, bool has_hold, uint32_t hold_us,
+    const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
+  return encode_vector(
+      STATE_ACK_TIMED_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_state_ack(group_hash, boot_id, sequence, acked_boot_id,
+                                acked_sequence, result, has_hold, hold_us,
+                                key, writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_state_ack(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    uint32_t acked_boot_id, uint32_t acked_sequence,
+    CFXSyncAckResult result, bool has_hold, uint32_t hold_us,
+    const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output) {
   if (acked_boot_id == 0 || acked_sequence == 0) {
     return false;
   }
@@ -420,19 +598,33 @@ bool CFXSyncPacketCodec::encode_state_ack(
       return false;
   }
 
-  std::vector<uint8_t> payload;
-  payload.reserve(STATE_ACK_PAYLOAD_SIZE);
+  CFXSyncPacketWriter payload;
+  begin_(CFXSyncPacketType::STATE_ACK, 0, group_hash, boot_id, sequence,
+         output, payload);
   append_u32_(payload, acked_boot_id);
   append_u32_(payload, acked_sequence);
   payload.push_back(static_cast<uint8_t>(result));
-  return encode_(CFXSyncPacketType::STATE_ACK, group_hash, boot_id, sequence,
-                 payload.data(), payload.size(), key, output);
+  if (has_hold) {
+    append_u32_(payload, hold_us);
+  }
+  return finish_(payload, key, output);
 }
 
 bool CFXSyncPacketCodec::encode_input_state(
     uint32_t group_hash, uint32_t boot_id, uint32_t sequence, bool pressed,
     bool maintained, bool toggle, CFXSyncInputAction action,
     const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
+  return encode_vector(
+      INPUT_STATE_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_input_state(group_hash, boot_id, sequence, pressed,
+                                  maintained, toggle, action, key, writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_input_state(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence, bool pressed,
+    bool maintained, bool toggle, CFXSyncInputAction action,
+    const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output) {
   switch (action) {
     case CFXSyncInputAction::PRIMARY:
     case CFXSyncInputAction::DIMMER_UP:
@@ -445,14 +637,28 @@ bool CFXSyncPacketCodec::encode_input_state(
                           (maintained ? INPUT_FLAG_MAINTAINED : 0) |
                           (toggle ? INPUT_FLAG_TOGGLE : 0) |
                           (static_cast<uint8_t>(action) << INPUT_ACTION_SHIFT);
-  return encode_(CFXSyncPacketType::INPUT_STATE, group_hash, boot_id,
-                 sequence, &payload, INPUT_STATE_PAYLOAD_SIZE, key, output);
+  CFXSyncPacketWriter writer;
+  begin_(CFXSyncPacketType::INPUT_STATE, 0, group_hash, boot_id, sequence,
+         output, writer);
+  writer.append(&payload, INPUT_STATE_PAYLOAD_SIZE);
+  return finish_(writer, key, output);
 }
 
 bool CFXSyncPacketCodec::encode_light_command(
     uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
     const CFXSyncPacket &command, const std::array<uint8_t, 32> &key,
     std::vector<uint8_t> &output) {
+  return encode_vector(
+      MAX_LIGHT_COMMAND_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_light_command(group_hash, boot_id, sequence, command,
+                                    key, writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_light_command(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+    const CFXSyncPacket &command, const std::array<uint8_t, 32> &key,
+    CFXSyncPacketWriter &output) {
   constexpr uint16_t KNOWN_COMMANDS =
       COMMAND_POWER | COMMAND_TOGGLE | COMMAND_BRIGHTNESS | COMMAND_RAMP |
       COMMAND_RGB | COMMAND_COLOR_BRIGHTNESS | COMMAND_COLOR_TEMPERATURE |
@@ -478,8 +684,9 @@ bool CFXSyncPacketCodec::encode_light_command(
       return false;
   }
 
-  std::vector<uint8_t> payload;
-  payload.reserve(MAX_LIGHT_COMMAND_PAYLOAD_SIZE);
+  CFXSyncPacketWriter payload;
+  begin_(CFXSyncPacketType::LIGHT_COMMAND, 0, group_hash, boot_id,
+         sequence, output, payload);
   append_u16_(payload, command.command_mask);
   payload.push_back(static_cast<uint8_t>(command.command_kind));
   payload.push_back(command.command_flags);
@@ -511,10 +718,57 @@ bool CFXSyncPacketCodec::encode_light_command(
     payload.push_back(command.command_warm_white);
   }
   if (payload.size() > MAX_LIGHT_COMMAND_PAYLOAD_SIZE) {
+    output.clear();
+    return false;
+  }
+  return finish_(payload, key, output);
+}
+
+bool CFXSyncPacketCodec::valid_pixel_chunk_(uint8_t flags, uint16_t led_count,
+                                            uint16_t first_led,
+                                            size_t pixel_bytes) {
+  constexpr uint8_t KNOWN_FLAGS =
+      PIXEL_FLAG_LAST | PIXEL_FLAG_KEYFRAME | PIXEL_FLAG_WHITE;
+  const size_t stride = (flags & PIXEL_FLAG_WHITE) != 0 ? 4 : 3;
+  if ((flags & ~KNOWN_FLAGS) != 0 || pixel_bytes == 0 ||
+      pixel_bytes > MAX_PIXEL_DATA_SIZE || pixel_bytes % stride != 0) {
     return false;
   }
-  return encode_(CFXSyncPacketType::LIGHT_COMMAND, group_hash, boot_id,
-                 sequence, payload.data(), payload.size(), key, output);
+  return static_cast<size_t>(first_led) + pixel_bytes / stride <= led_count;
+}
+
+bool CFXSyncPacketCodec::encode_pixel_frame(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence, uint16_t frame,
+    uint8_t flags, uint16_t led_count, uint16_t first_led,
+    const uint8_t *pixels, size_t pixel_bytes,
+    const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output) {
+  return encode_vector(
+      MAX_PIXEL_FRAME_PACKET_SIZE, output, [&](CFXSyncPacketWriter &writer) {
+        return encode_pixel_frame(group_hash, boot_id, sequence, frame, flags,
+                                  led_count, first_led, pixels, pixel_bytes,
+                                  key, writer);
+      });
+}
+
+bool CFXSyncPacketCodec::encode_pixel_frame(
+    uint32_t group_hash, uint32_t boot_id, uint32_t sequence, uint16_t frame,
+    uint8_t flags, uint16_t led_count, uint16_t first_led,
+    const uint8_t *pixels, size_t pixel_bytes,
+    const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output) {
+  if (pixels == nullptr ||
+      !valid_pixel_chunk_(flags, led_count, first_led, pixel_bytes)) {
+    return false;
+  }
+
+  CFXSyncPacketWriter payload;
+  begin_(CFXSyncPacketType::PIXEL_FRAME, 0, group_hash, boot_id, sequence,
+         output, payload);
+  append_u16_(payload, frame);
+  payload.push_back(flags);
+  append_u16_(payload, led_count);
+  append_u16_(payload, first_led);
+  payload.append(pixels, pixel_bytes);
+  return finish_(payload, key, output);
 }
 
 CFXSyncDecodeResult CFXSyncPacketCodec::peek_group_hash(
@@ -548,6 +802,12 @@ CFXSyncDecodeResult CFXSyncPacketCodec::peek_group_hash(
 CFXSyncDecodeResult CFXSyncPacketCodec::decode(
     const uint8_t *data, size_t size, uint32_t expected_group_hash,
     const std::array<uint8_t, 32> &key, CFXSyncPacket &packet) {
+  return decode(data, size, expected_group_hash, hmac_key_(key), packet);
+}
+
+CFXSyncDecodeResult CFXSyncPacketCodec::decode(
+    const uint8_t *data, size_t size, uint32_t expected_group_hash,
+    const CFXSyncHmacKey &key, CFXSyncPacket &packet) {
   if (data == nullptr || size < sizeof(CFX_SYNC_MAGIC)) {
     return CFXSyncDecodeResult::MALFORMED;
   }
@@ -575,8 +835,8 @@ CFXSyncDecodeResult CFXSyncPacketCodec::decode(
     return CFXSyncDecodeResult::WRONG_GROUP;
   }
 
-  uint8_t expected_tag[AUTH_TAG_SIZE];
-  calculate_tag_(data, authenticated_size, key, expected_tag);
+  uint8_t expected_tag[CFXSyncSha256::DIGEST_SIZE];
+  key.sign(data, authenticated_size, expected_tag);
   if (!tags_equal_(expected_tag, data + authenticated_size, AUTH_TAG_SIZE)) {
     return CFXSyncDecodeResult::BAD_AUTH;
   }
@@ -588,7 +848,8 @@ CFXSyncDecodeResult CFXSyncPacketCodec::decode(
       raw_type != static_cast<uint8_t>(CFXSyncPacketType::HELLO) &&
       raw_type != static_cast<uint8_t>(CFXSyncPacketType::STATE_ACK) &&
       raw_type != static_cast<uint8_t>(CFXSyncPacketType::INPUT_STATE) &&
-      raw_type != static_cast<uint8_t>(CFXSyncPacketType::LIGHT_COMMAND)) {
+      raw_type != static_cast<uint8_t>(CFXSyncPacketType::LIGHT_COMMAND) &&
+      raw_type != static_cast<uint8_t>(CFXSyncPacketType::PIXEL_FRAME)) {
     return CFXSyncDecodeResult::UNSUPPORTED_TYPE;
   }
 
@@ -627,9 +888,14 @@ CFXSyncDecodeResult CFXSyncPacketCodec::decode(
   }
 
   if (packet.type == CFXSyncPacketType::STATE_ACK) {
-    if (payload_size != STATE_ACK_PAYLOAD_SIZE) {
+    if (payload_size != STATE_ACK_PAYLOAD_SIZE &&
+        payload_size != STATE_ACK_TIMED_PAYLOAD_SIZE) {
       return CFXSyncDecodeResult::MALFORMED;
     }
+    if (payload_size == STATE_ACK_TIMED_PAYLOAD_SIZE) {
+      packet.has_ack_hold = true;
+      packet.ack_hold_us = read_u32_(payload + STATE_ACK_PAYLOAD_SIZE);
+    }
     packet.acked_boot_id = read_u32_(payload);
     packet.acked_sequence = read_u32_(payload + 4);
     if (packet.acked_boot_id == 0 || packet.acked_sequence == 0) {
@@ -672,6 +938,24 @@ CFXSyncDecodeResult CFXSyncPacketCodec::decode(
     return CFXSyncDecodeResult::OK;
   }
 
+  if (packet.type == CFXSyncPacketType::PIXEL_FRAME) {
+    if (payload_size <= PIXEL_FRAME_HEADER_SIZE) {
+      return CFXSyncDecodeResult::MALFORMED;
+    }
+    packet.pixel_frame = read_u16_(payload);
+    packet.pixel_flags = payload[2];
+    packet.pixel_led_count = read_u16_(payload + 3);
+    packet.pixel_first_led = read_u16_(payload + 5);
+    packet.pixel_data = payload + PIXEL_FRAME_HEADER_SIZE;
+    packet.pixel_data_size = payload_size - PIXEL_FRAME_HEADER_SIZE;
+    if (!valid_pixel_chunk_(packet.pixel_flags, packet.pixel_led_count,
+                            packet.pixel_first_led,
+                            packet.pixel_data_size)) {
+      return CFXSyncDecodeResult::MALFORMED;
+    }
+    return CFXSyncDecodeResult::OK;
+  }
+
   if (packet.type == CFXSyncPacketType::LIGHT_COMMAND) {
     if (payload_size < MIN_LIGHT_COMMAND_PAYLOAD_SIZE ||
         payload_size > MAX_LIGHT_COMMAND_PAYLOAD_SIZE) {
@@ -979,10 +1263,21 @@ CFXSyncDecodeResult CFXSyncPacketCodec::decode(
     offset += 2;
   }
 
+  if ((packet.field_mask & FIELD_TIMEBASE) != 0) {
+    if (offset + TIMEBASE_VALUE_SIZE > payload_size) {
+      return CFXSyncDecodeResult::MALFORMED;
+    }
+    packet.has_timebase = true;
+    packet.leader_us = read_u64_(payload + offset);
+    packet.delay_us = read_u32_(payload + offset + 8);
+    packet.epoch_us = read_u64_(payload + offset + 12);
+    offset += TIMEBASE_VALUE_SIZE;
+  }
+
   constexpr uint32_t KNOWN_FIELDS =
       FIELD_POWER | FIELD_BRIGHTNESS | FIELD_COLOR | FIELD_COLOR_BRIGHTNESS |
       FIELD_EFFECT | FIELD_CONTROLS | FIELD_TRANSITION | FIELD_RAMP |
-      FIELD_COLOR_TEMPERATURE | FIELD_COLD_WARM_WHITE;
+      FIELD_COLOR_TEMPERATURE | FIELD_COLD_WARM_WHITE | FIELD_TIMEBASE;
   if ((packet.field_mask & ~KNOWN_FIELDS) == 0 && offset != payload_size) {
     return CFXSyncDecodeResult::MALFORMED;
   }
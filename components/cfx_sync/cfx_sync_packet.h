@@ -10,11 +10,12 @@
 
 #include "cfx_sync_color.h"
 #include "cfx_sync_effect.h"
-#include "esphome/components/hmac_sha256/hmac_sha256.h"
+#include "cfx_sync_hmac.h"
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace esphome {
@@ -27,6 +28,7 @@ enum class CFXSyncPacketType : uint8_t {
   STATE_ACK = 4,
   INPUT_STATE = 5,
   LIGHT_COMMAND = 6,
+  PIXEL_FRAME = 7,
 };
 
 enum class CFXSyncNodeRole : uint8_t {
@@ -119,6 +121,13 @@ struct CFXSyncTimingState {
   uint16_t transition_ms{0};
   bool has_ramp{false};
   uint16_t ramp_ms{0};
+  // Leader timebase: its esp_timer at send, the one-way delay it measured
+  // from STATE_ACK round trips, and the effect epoch (0 = none) on that
+  // same clock.
+  bool has_timebase{false};
+  uint64_t leader_us{0};
+  uint32_t delay_us{0};
+  uint64_t epoch_us{0};
 };
 
 struct CFXSyncPacket {
@@ -152,11 +161,18 @@ struct CFXSyncPacket {
   uint16_t transition_ms{0};
   bool has_ramp{false};
   uint16_t ramp_ms{0};
+  bool has_timebase{false};
+  uint64_t leader_us{0};
+  uint32_t delay_us{0};
+  uint64_t epoch_us{0};
   CFXSyncNodeRole node_role{CFXSyncNodeRole::FOLLOWER};
   uint16_t capabilities{0};
   uint32_t acked_boot_id{0};
   uint32_t acked_sequence{0};
   CFXSyncAckResult ack_result{CFXSyncAckResult::APPLIED};
+  // Timed ACKs only: how long the follower held the STATE before acking.
+  bool has_ack_hold{false};
+  uint32_t ack_hold_us{0};
   bool input_pressed{false};
   bool input_maintained{false};
   bool input_toggle{false};
@@ -175,6 +191,60 @@ struct CFXSyncPacket {
   uint16_t command_color_temperature_mireds{0};
   uint8_t command_cold_white{0};
   uint8_t command_warm_white{0};
+  uint16_t pixel_frame{0};
+  uint8_t pixel_flags{0};
+  uint16_t pixel_led_count{0};
+  uint16_t pixel_first_led{0};
+  // Borrowed from the decoded buffer; valid only while it is.
+  const uint8_t *pixel_data{nullptr};
+  size_t pixel_data_size{0};
+};
+
+// Bounded cursor over caller-owned storage. The encoders write header,
+// payload and tag straight into it, so building a packet never allocates;
+// a write past capacity is dropped and fails the encode once at the end.
+class CFXSyncPacketWriter {
+ public:
+  CFXSyncPacketWriter() = default;
+  CFXSyncPacketWriter(uint8_t *data, size_t capacity)
+      : data_(data), capacity_(capacity) {}
+
+  void push_back(uint8_t value) {
+    if (this->size_ < this->capacity_) {
+      this->data_[this->size_++] = value;
+    } else {
+      this->overflowed_ = true;
+    }
+  }
+  void append(const uint8_t *data, size_t size) {
+    if (size > this->capacity_ - this->size_) {
+      this->overflowed_ = true;
+      return;
+    }
+    if (size != 0) {
+      memcpy(this->data_ + this->size_, data, size);
+      this->size_ += size;
+    }
+  }
+  void clear() {
+    this->size_ = 0;
+    this->overflowed_ = false;
+  }
+  void set_size(size_t size) {
+    this->size_ = size <= this->capacity_ ? size : this->capacity_;
+  }
+
+  uint8_t *data() { return this->data_; }
+  const uint8_t *data() const { return this->data_; }
+  size_t size() const { return this->size_; }
+  size_t capacity() const { return this->capacity_; }
+  bool overflowed() const { return this->overflowed_; }
+
+ protected:
+  uint8_t *data_{nullptr};
+  size_t capacity_{0};
+  size_t size_{0};
+  bool overflowed_{false};
 };
 
 class CFXSyncPacketCodec {
@@ -182,6 +252,9 @@ class CFXSyncPacketCodec {
   static constexpr uint8_t VERSION = 1;
   static constexpr size_t HEADER_SIZE = 22;
   static constexpr size_t AUTH_TAG_SIZE = 16;
+  // Header flags. A delta STATE carries only the light fields that changed;
+  // it updates a follower but does not stand in for a full state.
+  static constexpr uint8_t FLAG_STATE_DELTA = 0x01;
   static constexpr uint32_t FIELD_POWER = 0x00000001UL;
   static constexpr uint32_t FIELD_BRIGHTNESS = 0x00000002UL;
   static constexpr uint32_t FIELD_COLOR = 0x00000004UL;
@@ -192,6 +265,7 @@ class CFXSyncPacketCodec {
   static constexpr uint32_t FIELD_RAMP = 0x00000080UL;
   static constexpr uint32_t FIELD_COLOR_TEMPERATURE = 0x00000100UL;
   static constexpr uint32_t FIELD_COLD_WARM_WHITE = 0x00000200UL;
+  static constexpr uint32_t FIELD_TIMEBASE = 0x00000400UL;
   static constexpr uint16_t CONTROL_FORCE_WHITE = 0x0001U;
   static constexpr uint16_t CONTROL_INTRO = 0x0002U;
   static constexpr uint16_t CONTROL_OUTRO = 0x0004U;
@@ -203,6 +277,9 @@ class CFXSyncPacketCodec {
   static constexpr uint16_t CAP_LIGHT_LEADER = 0x0001U;
   static constexpr uint16_t CAP_LIGHT_FOLLOWER = 0x0002U;
   static constexpr uint16_t CAP_BINARY_REMOTE = 0x0004U;
+  static constexpr uint16_t CAP_PIXEL_FOLLOWER = 0x0008U;
+  // Listening on the group's UDP multicast address.
+  static constexpr uint16_t CAP_UDP_GROUP = 0x0010U;
   static constexpr uint8_t COLOR_CAP_WHITE = 0x01;
   static constexpr uint8_t INPUT_FLAG_PRESSED = 0x01;
   static constexpr uint8_t INPUT_FLAG_MAINTAINED = 0x02;
@@ -223,6 +300,9 @@ class CFXSyncPacketCodec {
   static constexpr uint8_t COMMAND_FLAG_RELEASED = 0x02U;
   static constexpr uint8_t COMMAND_FLAG_DIRECTION_UP = 0x04U;
   static constexpr uint8_t COMMAND_FLAG_DIRECTION_DOWN = 0x08U;
+  static constexpr uint8_t PIXEL_FLAG_LAST = 0x01U;
+  static constexpr uint8_t PIXEL_FLAG_KEYFRAME = 0x02U;
+  static constexpr uint8_t PIXEL_FLAG_WHITE = 0x04U;
   static constexpr uint32_t FULL_STATE_MASK =
       FIELD_POWER | FIELD_BRIGHTNESS | FIELD_COLOR | FIELD_COLOR_BRIGHTNESS;
   static constexpr size_t FULL_STATE_PAYLOAD_SIZE = 12;
@@ -232,31 +312,50 @@ class CFXSyncPacketCodec {
   static constexpr size_t MAX_TIMING_VALUE_SIZE = 4;
   static constexpr size_t MAX_COLOR_TEMPERATURE_VALUE_SIZE = 2;
   static constexpr size_t MAX_COLD_WARM_WHITE_VALUE_SIZE = 2;
+  // Leader clock u64, delay u32, epoch u64.
+  static constexpr size_t TIMEBASE_VALUE_SIZE = 20;
   static constexpr size_t MAX_EFFECT_STATE_PACKET_SIZE =
       HEADER_SIZE + FULL_STATE_PAYLOAD_SIZE + MAX_EFFECT_VALUE_SIZE +
       AUTH_TAG_SIZE;
   static constexpr size_t MAX_STATE_PAYLOAD_SIZE =
       FULL_STATE_PAYLOAD_SIZE + MAX_EFFECT_VALUE_SIZE +
       MAX_CONTROLS_VALUE_SIZE + MAX_TIMING_VALUE_SIZE +
-      MAX_COLOR_TEMPERATURE_VALUE_SIZE + MAX_COLD_WARM_WHITE_VALUE_SIZE;
+      MAX_COLOR_TEMPERATURE_VALUE_SIZE + MAX_COLD_WARM_WHITE_VALUE_SIZE +
+      TIMEBASE_VALUE_SIZE;
   static constexpr size_t STATE_PACKET_SIZE =
       HEADER_SIZE + FULL_STATE_PAYLOAD_SIZE + AUTH_TAG_SIZE;
   static constexpr size_t HELLO_PAYLOAD_SIZE = 3;
   static constexpr size_t STATE_ACK_PAYLOAD_SIZE = 9;
+  // STATE_ACK plus the hold time, sent only in reply to a STATE that
+  // carried FIELD_TIMEBASE so older leaders never see it.
+  static constexpr size_t STATE_ACK_TIMED_PAYLOAD_SIZE = 13;
   static constexpr size_t INPUT_STATE_PAYLOAD_SIZE = 1;
   static constexpr size_t MIN_LIGHT_COMMAND_PAYLOAD_SIZE = 4;
   static constexpr size_t MAX_LIGHT_COMMAND_PAYLOAD_SIZE = 17;
   static constexpr size_t MAX_STATE_PACKET_SIZE =
-      HEADER_SIZE + MAX_STATE_PAYLOAD_SIZE + AUTH_TAG_SIZE;  // 136 bytes.
+      HEADER_SIZE + MAX_STATE_PAYLOAD_SIZE + AUTH_TAG_SIZE;  // 156 bytes.
+  // PIXEL_FRAME: frame u16, flags u8, LED count u16, first LED u16, then
+  // RGB or RGBW triplets. 204 bytes is 68 RGB or 51 RGBW pixels.
+  static constexpr size_t PIXEL_FRAME_HEADER_SIZE = 7;
+  static constexpr size_t MAX_PIXEL_DATA_SIZE = 204;
+  static constexpr size_t MAX_PIXEL_FRAME_PACKET_SIZE =
+      HEADER_SIZE + PIXEL_FRAME_HEADER_SIZE + MAX_PIXEL_DATA_SIZE +
+      AUTH_TAG_SIZE;
   static constexpr size_t REQUEST_PACKET_SIZE = HEADER_SIZE + AUTH_TAG_SIZE;
   static constexpr size_t HELLO_PACKET_SIZE =
       HEADER_SIZE + HELLO_PAYLOAD_SIZE + AUTH_TAG_SIZE;
   static constexpr size_t STATE_ACK_PACKET_SIZE =
       HEADER_SIZE + STATE_ACK_PAYLOAD_SIZE + AUTH_TAG_SIZE;
+  static constexpr size_t STATE_ACK_TIMED_PACKET_SIZE =
+      HEADER_SIZE + STATE_ACK_TIMED_PAYLOAD_SIZE + AUTH_TAG_SIZE;
   static constexpr size_t INPUT_STATE_PACKET_SIZE =
       HEADER_SIZE + INPUT_STATE_PAYLOAD_SIZE + AUTH_TAG_SIZE;
   static constexpr size_t MAX_LIGHT_COMMAND_PACKET_SIZE =
       HEADER_SIZE + MAX_LIGHT_COMMAND_PAYLOAD_SIZE + AUTH_TAG_SIZE;
+  // Largest packet of any type: a buffer this size takes every encoder.
+  static constexpr size_t MAX_PACKET_SIZE = MAX_PIXEL_FRAME_PACKET_SIZE;
+  // Distinct group keys whose HMAC schedule is kept.
+  static constexpr uint8_t HMAC_KEY_SLOTS = 4;
 
   static bool encode_state(uint32_t group_hash, uint32_t boot_id,
                            uint32_t sequence, bool power, uint8_t brightness,
@@ -305,43 +404,116 @@ class CFXSyncPacketCodec {
       const CFXSyncEffectState &effect, bool has_controls,
       const CFXSyncControlState &controls, const CFXSyncTimingState &timing,
       const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output);
+  static bool encode_state_snapshot(
+      uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+      const CFXSyncLightSnapshot &snapshot, bool has_effect,
+      const CFXSyncEffectState &effect, bool has_controls,
+      const CFXSyncControlState &controls, const CFXSyncTimingState &timing,
+      const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output);
+
+  // STATE with only the light fields in `fields` (FIELD_POWER through
+  // FIELD_COLD_WARM_WHITE, FIELD_EFFECT, FIELD_CONTROLS), flagged
+  // FLAG_STATE_DELTA. Timing is carried as for a snapshot.
+  static bool encode_state_delta(
+      uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+      const CFXSyncLightSnapshot &snapshot, uint32_t fields,
+      const CFXSyncEffectState &effect, const CFXSyncControlState &controls,
+      const CFXSyncTimingState &timing, const std::array<uint8_t, 32> &key,
+      std::vector<uint8_t> &output);
+  static bool encode_state_delta(
+      uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+      const CFXSyncLightSnapshot &snapshot, uint32_t fields,
+      const CFXSyncEffectState &effect, const CFXSyncControlState &controls,
+      const CFXSyncTimingState &timing, const std::array<uint8_t, 32> &key,
+      CFXSyncPacketWriter &output);
 
   static bool encode_state_with_fields_(
-      uint32_t group_hash, uint32_t boot_id, uint32_t sequence, bool power,
-      uint8_t brightness, bool has_color, bool has_color_brightness,
+      uint32_t group_hash, uint32_t boot_id, uint32_t sequence, uint8_t flags,
+      bool has_power, bool power, bool has_brightness, uint8_t brightness,
+      bool has_color, bool has_color_brightness,
       uint8_t color_brightness, uint8_t red, uint8_t green, uint8_t blue,
       uint8_t white, bool has_white, bool has_color_temperature,
       uint16_t color_temperature_mireds, bool has_cold_warm_white,
       uint8_t cold_white, uint8_t warm_white, bool has_effect,
       const CFXSyncEffectState &effect, bool has_controls,
       const CFXSyncControlState &controls, const CFXSyncTimingState &timing,
-      const std::array<uint8_t, 32> &key, std::vector<uint8_t> &output);
+      const std::array<uint8_t, 32> &key, CFXSyncPacketWriter &output);
   static bool encode_sync_request(uint32_t group_hash, uint32_t boot_id,
                                   uint32_t sequence,
                                   const std::array<uint8_t, 32> &key,
                                   std::vector<uint8_t> &output);
+  static bool encode_sync_request(uint32_t group_hash, uint32_t boot_id,
+                                  uint32_t sequence,
+                                  const std::array<uint8_t, 32> &key,
+                                  CFXSyncPacketWriter &output);
   static bool encode_hello(uint32_t group_hash, uint32_t boot_id,
                            uint32_t sequence, CFXSyncNodeRole role,
                            uint16_t capabilities,
                            const std::array<uint8_t, 32> &key,
                            std::vector<uint8_t> &output);
+  static bool encode_hello(uint32_t group_hash, uint32_t boot_id,
+                           uint32_t sequence, CFXSyncNodeRole role,
+                           uint16_t capabilities,
+                           const std::array<uint8_t, 32> &key,
+                           CFXSyncPacketWriter &output);
   static bool encode_state_ack(uint32_t group_hash, uint32_t boot_id,
                                uint32_t sequence, uint32_t acked_boot_id,
                                uint32_t acked_sequence,
                                CFXSyncAckResult result,
                                const std::array<uint8_t, 32> &key,
                                std::vector<uint8_t> &output);
+  static bool encode_state_ack(uint32_t group_hash, uint32_t boot_id,
+                               uint32_t sequence, uint32_t acked_boot_id,
+                               uint32_t acked_sequence,
+                               CFXSyncAckResult result, bool has_hold,
+                               uint32_t hold_us,
+                               const std::array<uint8_t, 32> &key,
+                               std::vector<uint8_t> &output);
+  static bool encode_state_ack(uint32_t group_hash, uint32_t boot_id,
+                               uint32_t sequence, uint32_t acked_boot_id,
+                               uint32_t acked_sequence,
+                               CFXSyncAckResult result, bool has_hold,
+                               uint32_t hold_us,
+                               const std::array<uint8_t, 32> &key,
+                               CFXSyncPacketWriter &output);
   static bool encode_input_state(uint32_t group_hash, uint32_t boot_id,
                                  uint32_t sequence, bool pressed,
                                  bool maintained, bool toggle,
                                  CFXSyncInputAction action,
                                  const std::array<uint8_t, 32> &key,
                                  std::vector<uint8_t> &output);
+  static bool encode_input_state(uint32_t group_hash, uint32_t boot_id,
+                                 uint32_t sequence, bool pressed,
+                                 bool maintained, bool toggle,
+                                 CFXSyncInputAction action,
+                                 const std::array<uint8_t, 32> &key,
+                                 CFXSyncPacketWriter &output);
   static bool encode_light_command(uint32_t group_hash, uint32_t boot_id,
                                    uint32_t sequence,
                                    const CFXSyncPacket &command,
                                    const std::array<uint8_t, 32> &key,
                                    std::vector<uint8_t> &output);
+  static bool encode_light_command(uint32_t group_hash, uint32_t boot_id,
+                                   uint32_t sequence,
+                                   const CFXSyncPacket &command,
+                                   const std::array<uint8_t, 32> &key,
+                                   CFXSyncPacketWriter &output);
+  // One chunk of a rendered frame. `pixels` holds `pixel_bytes` bytes of
+  // RGB (or RGBW with PIXEL_FLAG_WHITE) for LEDs starting at `first_led`.
+  static bool encode_pixel_frame(uint32_t group_hash, uint32_t boot_id,
+                                 uint32_t sequence, uint16_t frame,
+                                 uint8_t flags, uint16_t led_count,
+                                 uint16_t first_led, const uint8_t *pixels,
+                                 size_t pixel_bytes,
+                                 const std::array<uint8_t, 32> &key,
+                                 std::vector<uint8_t> &output);
+  static bool encode_pixel_frame(uint32_t group_hash, uint32_t boot_id,
+                                 uint32_t sequence, uint16_t frame,
+                                 uint8_t flags, uint16_t led_count,
+                                 uint16_t first_led, const uint8_t *pixels,
+                                 size_t pixel_bytes,
+                                 const std::array<uint8_t, 32> &key,
+                                 CFXSyncPacketWriter &output);
   static CFXSyncDecodeResult peek_group_hash(const uint8_t *data,
                                              size_t size,
                                              uint32_t &group_hash);
@@ -349,23 +521,38 @@ class CFXSyncPacketCodec {
                                     uint32_t expected_group_hash,
                                     const std::array<uint8_t, 32> &key,
                                     CFXSyncPacket &packet);
+  // Same, with a key schedule the caller owns. The key cache behind the
+  // overload above is main-loop only; other tasks decode with this one.
+  static CFXSyncDecodeResult decode(const uint8_t *data, size_t size,
+                                    uint32_t expected_group_hash,
+                                    const CFXSyncHmacKey &key,
+                                    CFXSyncPacket &packet);
 
  protected:
-  static bool encode_(CFXSyncPacketType type, uint32_t group_hash,
-                      uint32_t boot_id, uint32_t sequence,
-                      const uint8_t *payload, size_t payload_size,
+  // Writes the header and points `payload` at the space after it, short
+  // of the tag; finish_() fills in the length and appends the tag.
+  static void begin_(CFXSyncPacketType type, uint8_t flags,
+                     uint32_t group_hash, uint32_t boot_id, uint32_t sequence,
+                     CFXSyncPacketWriter &output,
+                     CFXSyncPacketWriter &payload);
+  static bool finish_(const CFXSyncPacketWriter &payload,
                       const std::array<uint8_t, 32> &key,
-                      std::vector<uint8_t> &output);
-  static void append_u16_(std::vector<uint8_t> &output, uint16_t value);
-  static void append_u32_(std::vector<uint8_t> &output, uint32_t value);
+                      CFXSyncPacketWriter &output);
+  static void append_u16_(CFXSyncPacketWriter &output, uint16_t value);
+  static void append_u32_(CFXSyncPacketWriter &output, uint32_t value);
+  static void append_u64_(CFXSyncPacketWriter &output, uint64_t value);
   static uint16_t read_u16_(const uint8_t *data);
   static uint32_t read_u32_(const uint8_t *data);
+  static uint64_t read_u64_(const uint8_t *data);
+  static const CFXSyncHmacKey &hmac_key_(const std::array<uint8_t, 32> &key);
   static void calculate_tag_(const uint8_t *data, size_t size,
                              const std::array<uint8_t, 32> &key,
                              uint8_t *tag);
   static bool tags_equal_(const uint8_t *left, const uint8_t *right,
                           size_t size);
   static bool is_valid_utf8_(const uint8_t *data, size_t size);
+  static bool valid_pixel_chunk_(uint8_t flags, uint16_t led_count,
+                                 uint16_t first_led, size_t pixel_bytes);
 };
 
 static_assert(CFXSyncPacketCodec::MAX_EFFECT_VALUE_SIZE == 67,
@@ -383,7 +570,9 @@ static_assert(CFXSyncPacketCodec::MAX_COLD_WARM_WHITE_VALUE_SIZE == 2,
               "CFX sync maximum cold/warm white value size changed");
 static_assert(CFXSyncPacketCodec::MAX_EFFECT_STATE_PACKET_SIZE == 117,
               "CFX sync maximum effect state packet size changed");
-static_assert(CFXSyncPacketCodec::MAX_STATE_PACKET_SIZE == 136,
+static_assert(CFXSyncPacketCodec::TIMEBASE_VALUE_SIZE == 20,
+              "CFX sync timebase value size changed");
+static_assert(CFXSyncPacketCodec::MAX_STATE_PACKET_SIZE == 156,
               "CFX sync maximum state packet size changed");
 static_assert(CFXSyncPacketCodec::MAX_STATE_PACKET_SIZE < 250,
               "CFX sync state packet exceeds ESP-NOW V1 payload limit");
@@ -393,10 +582,26 @@ static_assert(CFXSyncPacketCodec::HELLO_PACKET_SIZE == 41,
               "CFX sync hello packet size changed");
 static_assert(CFXSyncPacketCodec::STATE_ACK_PACKET_SIZE == 47,
               "CFX sync state ack packet size changed");
+static_assert(CFXSyncPacketCodec::STATE_ACK_TIMED_PACKET_SIZE == 51,
+              "CFX sync timed state ack packet size changed");
 static_assert(CFXSyncPacketCodec::INPUT_STATE_PACKET_SIZE == 39,
               "CFX sync input state packet size changed");
 static_assert(CFXSyncPacketCodec::MAX_LIGHT_COMMAND_PACKET_SIZE == 55,
               "CFX sync maximum light command packet size changed");
+static_assert(CFXSyncPacketCodec::MAX_PIXEL_DATA_SIZE % 3 == 0 &&
+                  CFXSyncPacketCodec::MAX_PIXEL_DATA_SIZE % 4 == 0,
+              "CFX sync pixel chunks must hold whole RGB and RGBW pixels");
+static_assert(CFXSyncPacketCodec::MAX_PIXEL_FRAME_PACKET_SIZE == 249,
+              "CFX sync maximum pixel frame packet size changed");
+static_assert(CFXSyncPacketCodec::MAX_PIXEL_FRAME_PACKET_SIZE < 250,
+              "CFX sync pixel frame exceeds ESP-NOW V1 payload limit");
+static_assert(CFXSyncPacketCodec::MAX_STATE_PACKET_SIZE <=
+                      CFXSyncPacketCodec::MAX_PACKET_SIZE &&
+                  CFXSyncPacketCodec::MAX_LIGHT_COMMAND_PACKET_SIZE <=
+                      CFXSyncPacketCodec::MAX_PACKET_SIZE &&
+                  CFXSyncPacketCodec::STATE_ACK_TIMED_PACKET_SIZE <=
+                      CFXSyncPacketCodec::MAX_PACKET_SIZE,
+              "CFX sync MAX_PACKET_SIZE must fit every packet type");
 static_assert(CFXSyncPacketCodec::HELLO_PACKET_SIZE < 250,
               "CFX sync hello packet exceeds ESP-NOW V1 payload limit");
 static_assert(CFXSyncPacketCodec::STATE_ACK_PACKET_SIZE < 250,
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * Single-producer, single-consumer ring for received sync packets.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace cfx_sync {
+
+// Slots are filled in place: the producer claims the next free slot,
+// writes it and publishes it; the consumer reads the oldest one and
+// releases it. Nothing is copied in or out and neither side blocks, so a
+// full ring simply makes the producer drop.
+template<typename T, size_t N> class CFXSyncRxRing {
+  static_assert(N != 0 && (N & (N - 1)) == 0,
+                "ring size must be a power of two");
+
+ public:
+  // Producer side.
+  T *claim() {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (head - this->tail_.load(std::memory_order_acquire) >= N) {
+      return nullptr;
+    }
+    return &this->slots_[head & (N - 1)];
+  }
+  void publish() {
+    this->head_.store(this->head_.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_release);
+  }
+
+  // Consumer side.
+  T *front() {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &this->slots_[tail & (N - 1)];
+  }
+  void pop() {
+    this->tail_.store(this->tail_.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_release);
+  }
+
+ protected:
+  T slots_[N]{};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
+
+}  // namespace cfx_sync
+}  // namespace esphome
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * Leader-side STATE pacing and field deltas.
+ */
+
+#pragma once
+
+#if defined(USE_ESP32)
+
+#include "cfx_sync_packet.h"
+
+#include <cstdint>
+
+namespace esphome {
+namespace cfx_sync {
+
+// One slot per broadcast: an update that arrives before the pacing
+// interval is up replaces whatever was waiting (latest wins) and goes out
+// when the interval ends.
+//
+// Deltas are cut against a baseline, the last broadcast every follower
+// acked. Each delta carries every field that differs from it or went out
+// in an earlier delta since, with absolute values, so a follower that
+// missed any of them still lands on the latest state. Until a baseline is
+// confirmed, or after a full snapshot was requested, sends are full.
+class CFXSyncStateTx {
+ public:
+  struct Update {
+    CFXSyncLightSnapshot snapshot;
+    CFXSyncEffectState effect;
+    CFXSyncControlState controls;
+    CFXSyncTimingState timing;
+  };
+
+  void set_interval_ms(uint32_t interval_ms) {
+    this->interval_ms_ = interval_ms;
+  }
+  uint32_t interval_ms() const { return this->interval_ms_; }
+
+  // Milliseconds until the next broadcast may go out; 0 sends now.
+  uint32_t wait_ms(uint32_t now) const {
+    if (!this->has_sent_ || now - this->last_sent_ms_ >= this->interval_ms_) {
+      return 0;
+    }
+    return this->interval_ms_ - (now - this->last_sent_ms_);
+  }
+
+  void hold(const CFXSyncLightSnapshot &snapshot,
+            const CFXSyncEffectState &effect,
+            const CFXSyncControlState &controls,
+            const CFXSyncTimingState &timing) {
+    this->held_.snapshot = snapshot;
+    this->held_.effect = effect;
+    this->held_.controls = controls;
+    // A command ramp that was coalesced away still applies to the state
+    // that replaces it.
+    if (!this->has_held_ || timing.has_transition || timing.has_ramp) {
+      this->held_.timing = timing;
+    }
+    if (this->has_held_) {
+      this->coalesced_++;
+    }
+    this->has_held_ = true;
+  }
+  bool has_held() const { return this->has_held_; }
+  const Update &held() const { return this->held_; }
+  void drop_held() { this->has_held_ = false; }
+
+  void request_full() { this->full_requested_ = true; }
+  // Any STATE outside the broadcast path leaves followers on their own.
+  void invalidate() { this->baseline_valid_ = false; }
+
+  // Light fields for the next broadcast, or FULL when it must be complete.
+  static constexpr uint32_t FULL = 0xFFFFFFFFUL;
+  uint32_t fields_for(const CFXSyncLightSnapshot &snapshot,
+                      const CFXSyncEffectState &effect,
+                      const CFXSyncControlState &controls) const {
+    if (this->full_requested_ || !this->baseline_valid_) {
+      return FULL;
+    }
+    // Power always rides along so followers take (and ACK) every delta.
+    uint32_t fields = this->dirty_ | CFXSyncPacketCodec::FIELD_POWER;
+    const auto &base = this->baseline_;
+    if (snapshot.brightness != base.snapshot.brightness) {
+      fields |= CFXSyncPacketCodec::FIELD_BRIGHTNESS;
+    }
+    // A follower falls back to full color brightness when RGB arrives
+    // alone, so the two travel together.
+    if (snapshot.has_color != base.snapshot.has_color ||
+        snapshot.has_color_brightness != base.snapshot.has_color_brightness ||
+        snapshot.red != base.snapshot.red ||
+        snapshot.green != base.snapshot.green ||
+        snapshot.blue != base.snapshot.blue ||
+        snapshot.white != base.snapshot.white ||
+        snapshot.has_white != base.snapshot.has_white ||
+        snapshot.color_brightness != base.snapshot.color_brightness) {
+      fields |= CFXSyncPacketCodec::FIELD_COLOR |
+                CFXSyncPacketCodec::FIELD_COLOR_BRIGHTNESS;
+    }
+    // Cold/warm white is applied with the color temperature it came with.
+    if (snapshot.has_color_temperature !=
+            base.snapshot.has_color_temperature ||
+        snapshot.color_temperature_mireds !=
+            base.snapshot.color_temperature_mireds ||
+        snapshot.has_cold_warm_white != base.snapshot.has_cold_warm_white ||
+        snapshot.cold_white != base.snapshot.cold_white ||
+        snapshot.warm_white != base.snapshot.warm_white) {
+      fields |= CFXSyncPacketCodec::FIELD_COLOR_TEMPERATURE |
+                CFXSyncPacketCodec::FIELD_COLD_WARM_WHITE;
+    }
+    if (effect != base.effect) {
+      fields |= CFXSyncPacketCodec::FIELD_EFFECT;
+    }
+    if (controls != base.controls) {
+      fields |= CFXSyncPacketCodec::FIELD_CONTROLS;
+    }
+    return fields;
+  }
+
+  void sent(uint32_t now, uint32_t sequence, uint32_t fields,
+            const CFXSyncLightSnapshot &snapshot,
+            const CFXSyncEffectState &effect,
+            const CFXSyncControlState &controls) {
+    this->has_sent_ = true;
+    this->last_sent_ms_ = now;
+    this->sent_sequence_ = sequence;
+    this->sent_.snapshot = snapshot;
+    this->sent_.effect = effect;
+    this->sent_.controls = controls;
+    if (fields == FULL) {
+      // Followers hold either the old baseline plus deltas or this
+      // snapshot; only the ACK round tells which, so deltas wait for it.
+      this->full_requested_ = false;
+      this->baseline_valid_ = false;
+      this->dirty_ = 0;
+      this->full_sent_++;
+    } else {
+      this->dirty_ = fields;
+      this->delta_sent_++;
+    }
+    this->has_held_ = false;
+  }
+
+  // Every follower acked `sequence`.
+  void confirm(uint32_t sequence) {
+    if (!this->has_sent_ || sequence != this->sent_sequence_) {
+      return;
+    }
+    this->baseline_ = this->sent_;
+    this->baseline_valid_ = true;
+    this->dirty_ = 0;
+  }
+
+  uint32_t full_sent() const { return this->full_sent_; }
+  uint32_t delta_sent() const { return this->delta_sent_; }
+  uint32_t coalesced() const { return this->coalesced_; }
+
+ protected:
+  uint32_t interval_ms_{20};
+  bool has_sent_{false};
+  uint32_t last_sent_ms_{0};
+  uint32_t sent_sequence_{0};
+  Update sent_;
+  bool has_held_{false};
+  Update held_;
+  bool full_requested_{true};
+  bool baseline_valid_{false};
+  Update baseline_;
+  uint32_t dirty_{0};
+  uint32_t full_sent_{0};
+  uint32_t delta_sent_{0};
+  uint32_t coalesced_{0};
+};
+
+}  // namespace cfx_sync
+}  // namespace esphome
+
+#endif  // defined(USE_ESP32)
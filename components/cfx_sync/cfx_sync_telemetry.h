@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ *
+ * Per-peer delivery and latency counters.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace cfx_sync {
+
+// Power-of-two buckets from 128 µs to ~4 s, 16-bit counts that halve on
+// overflow so old samples fade. Small enough to keep one per peer; a
+// percentile reports its bucket's upper bound, so it errs slow.
+class CFXSyncLatencyHistogram {
+ public:
+  static constexpr uint8_t BUCKETS = 16;
+  static constexpr uint8_t FIRST_BUCKET_BITS = 7;
+
+  void record(uint32_t value_us) {
+    uint16_t &bin = this->bins_[bucket_for(value_us)];
+    if (bin == UINT16_MAX) {
+      this->count_ = 0;
+      for (uint16_t &bucket : this->bins_) {
+        bucket >>= 1;
+        this->count_ += bucket;
+      }
+    }
+    bin++;
+    this->count_++;
+    if (value_us > this->max_us_) {
+      this->max_us_ = value_us;
+    }
+  }
+
+  void reset() { *this = CFXSyncLatencyHistogram(); }
+  uint32_t count() const { return this->count_; }
+  uint32_t max_us() const { return this->max_us_; }
+
+  // 0 when empty.
+  uint32_t percentile_us(uint8_t percent) const {
+    if (this->count_ == 0) {
+      return 0;
+    }
+    uint32_t target = (this->count_ * (percent > 100 ? 100 : percent) + 99) /
+                      100;
+    if (target == 0) {
+      target = 1;
+    }
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+      seen += this->bins_[i];
+      if (seen >= target) {
+        const uint32_t upper = bucket_upper_us(i);
+        return upper < this->max_us_ ? upper : this->max_us_;
+      }
+    }
+    return this->max_us_;
+  }
+
+  static uint8_t bucket_for(uint32_t value_us) {
+    uint8_t bucket = 0;
+    while (bucket < BUCKETS - 1 &&
+           value_us >= (1UL << (FIRST_BUCKET_BITS + bucket))) {
+      bucket++;
+    }
+    return bucket;
+  }
+  static uint32_t bucket_upper_us(uint8_t bucket) {
+    return (1UL << (FIRST_BUCKET_BITS + bucket)) - 1;
+  }
+
+ protected:
+  uint16_t bins_[BUCKETS]{};
+  uint32_t count_{0};
+  uint32_t max_us_{0};
+};
+
+struct CFXSyncPeerStats {
+  // Leader: STATE send to matching STATE_ACK, less the follower's hold.
+  CFXSyncLatencyHistogram state_rtt;
+  // Leader: input or light command arrival to its local apply.
+  CFXSyncLatencyHistogram input_apply;
+  uint32_t states_sent{0};
+  uint32_t states_acked{0};
+  uint32_t state_retries{0};
+  uint32_t inputs_received{0};
+  uint32_t inputs_applied{0};
+  // Duplicates and out-of-order packets, retries and replays included.
+  uint32_t stale{0};
+
+  // Share of STATE sends that never got their ACK. A send superseded by
+  // the next one before its ACK arrived counts too, so under fast changes
+  // this reads high; compare peers rather than trusting the figure.
+  uint8_t ack_loss_percent() const {
+    if (this->states_sent == 0 || this->states_acked >= this->states_sent) {
+      return 0;
+    }
+    return static_cast<uint8_t>(
+        (static_cast<uint64_t>(this->states_sent - this->states_acked) * 100) /
+        this->states_sent);
+  }
+
+  void reset() { *this = CFXSyncPeerStats(); }
+};
+
+}  // namespace cfx_sync
+}  // namespace esphome
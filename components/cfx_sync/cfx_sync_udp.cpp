@@ -1,10 +1,14 @@
 #include "cfx_sync_udp.h"
 #include "cfx_sync_bus.h"
 
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
+#include <cstring>
+
 #if defined(USE_ESP8266)
 #include <ESP8266WiFi.h>
+#include <lwip/igmp.h>
 #else
 #include <cerrno>
 #include <cstring>
@@ -34,6 +38,9 @@ void CFXSyncUDPTransport::close_() {
   }
 #endif
   this->ready_ = false;
+  for (uint8_t i = 0; i < this->group_count_; i++) {
+    this->groups_[i].joined = false;
+  }
 }
 
 bool CFXSyncUDPTransport::begin(uint16_t port) {
@@ -85,6 +92,9 @@ bool CFXSyncUDPTransport::begin(uint16_t port) {
   this->ready_ = true;
   ESP_LOGI(TAG, "UDP transport listening on port %u",
            static_cast<unsigned>(port));
+  for (uint8_t i = 0; i < this->group_count_; i++) {
+    this->join_(this->groups_[i]);
+  }
   return true;
 }
 
@@ -92,6 +102,7 @@ void CFXSyncUDPTransport::poll(CFXSyncBus *bus) {
   if (!this->ready_ || bus == nullptr) {
     return;
   }
+  this->maintain();
 
   uint8_t buffer[UDP_RX_BUFFER_SIZE];
 #if defined(USE_ESP8266)
@@ -242,5 +253,123 @@ bool CFXSyncUDPTransport::send_broadcast(
   return this->send_broadcast(packet.data(), packet.size());
 }
 
+uint32_t CFXSyncUDPTransport::group_address(uint32_t group_hash) {
+  const uint8_t octets[4] = {239, 192, static_cast<uint8_t>(group_hash >> 8),
+                             static_cast<uint8_t>(group_hash)};
+  uint32_t address;
+  memcpy(&address, octets, sizeof(address));
+  return address;
+}
+
+bool CFXSyncUDPTransport::join_group(uint32_t address) {
+  for (uint8_t i = 0; i < this->group_count_; i++) {
+    if (this->groups_[i].address == address) {
+      return this->groups_[i].joined || this->join_(this->groups_[i]);
+    }
+  }
+  if (this->group_count_ >= MAX_GROUPS) {
+    ESP_LOGW(TAG, "UDP multicast group table full");
+    return false;
+  }
+  Group &group = this->groups_[this->group_count_++];
+  group.address = address;
+  return this->join_(group);
+}
+
+bool CFXSyncUDPTransport::is_group_joined(uint32_t address) const {
+  for (uint8_t i = 0; i < this->group_count_; i++) {
+    if (this->groups_[i].address == address) {
+      return this->groups_[i].joined;
+    }
+  }
+  return false;
+}
+
+bool CFXSyncUDPTransport::join_(Group &group) {
+  if (!this->ready_ || group.joined) {
+    return group.joined;
+  }
+  this->last_join_attempt_ms_ = millis();
+#if defined(USE_ESP8266)
+  ip4_addr_t multicast;
+  multicast.addr = group.address;
+  group.joined = igmp_joingroup(IP4_ADDR_ANY4, &multicast) == ERR_OK;
+#else
+  ip_mreq request{};
+  request.imr_multiaddr.s_addr = group.address;
+  request.imr_interface.s_addr = INADDR_ANY;
+  group.joined = ::setsockopt(this->socket_fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                              &request, sizeof(request)) == 0;
+#endif
+  if (group.joined) {
+    const uint8_t *octets = reinterpret_cast<const uint8_t *>(&group.address);
+    ESP_LOGD(TAG, "Joined UDP multicast group %u.%u.%u.%u", octets[0],
+             octets[1], octets[2], octets[3]);
+  }
+  return group.joined;
+}
+
+void CFXSyncUDPTransport::maintain() {
+  // Joining fails until the station has an address; keep trying slowly.
+  if (millis() - this->last_join_attempt_ms_ < GROUP_JOIN_RETRY_MS) {
+    return;
+  }
+  for (uint8_t i = 0; i < this->group_count_; i++) {
+    if (!this->groups_[i].joined) {
+      this->join_(this->groups_[i]);
+    }
+  }
+}
+
+bool CFXSyncUDPTransport::send_group(uint32_t address, const uint8_t *data,
+                                     size_t size) {
+  return this->send_to_(address, this->port_, data, size);
+}
+
+#if !defined(USE_ESP8266)
+CFXSyncUDPTransport::WaitResult CFXSyncUDPTransport::wait_readable(
+    uint32_t timeout_ms) {
+  if (!this->ready_ || this->socket_fd_ < 0) {
+    return WaitResult::FAILED;
+  }
+  fd_set readable;
+  FD_ZERO(&readable);
+  FD_SET(this->socket_fd_, &readable);
+  timeval timeout{};
+  timeout.tv_sec = timeout_ms / 1000;
+  timeout.tv_usec = (timeout_ms % 1000) * 1000;
+  const int ready = ::select(this->socket_fd_ + 1, &readable, nullptr,
+                             nullptr, &timeout);
+  if (ready > 0) {
+    return WaitResult::READABLE;
+  }
+  return ready == 0 ? WaitResult::TIMEOUT : WaitResult::FAILED;
+}
+
+bool CFXSyncUDPTransport::receive(uint8_t *buffer, size_t capacity,
+                                  size_t &size, CFXSyncSource &source) {
+  if (!this->ready_ || this->socket_fd_ < 0) {
+    return false;
+  }
+  while (true) {
+    sockaddr_in addr{};
+    socklen_t addr_len = sizeof(addr);
+    const ssize_t received =
+        ::recvfrom(this->socket_fd_, buffer, capacity, 0,
+                   reinterpret_cast<sockaddr *>(&addr), &addr_len);
+    if (received <= 0) {
+      return false;
+    }
+    if (received > static_cast<ssize_t>(CFX_SYNC_SHARED_TRANSPORT_MTU)) {
+      continue;
+    }
+    size = static_cast<size_t>(received);
+    source =
+        CFXSyncSource::from_udp(addr.sin_addr.s_addr, ntohs(addr.sin_port));
+    return true;
+  }
+}
+#endif
+
 }  // namespace cfx_sync
 }  // namespace esphome
@@ -35,8 +35,39 @@ class CFXSyncUDPTransport {
                     const std::vector<uint8_t> &packet);
   bool is_ready() const { return this->ready_; }
 
+  // IPv4 multicast: one datagram reaches every member of a sync group,
+  // and nodes outside it never wake for it. The address is derived from
+  // the group hash inside the organization-local 239.192.0.0/14 scope.
+  static uint32_t group_address(uint32_t group_hash);
+  // Membership is retried from poll() until the network accepts it.
+  bool join_group(uint32_t address);
+  bool is_group_joined(uint32_t address) const;
+  bool send_group(uint32_t address, const uint8_t *data, size_t size);
+  // Main-loop housekeeping; poll() runs it too.
+  void maintain();
+
+#if !defined(USE_ESP8266)
+  // For a receive task that owns the socket's read side: wait until a
+  // datagram is queued, then drain them one by one without blocking.
+  // FAILED (socket closed, select() error) returns at once, so the caller
+  // has to back off before waiting again.
+  enum class WaitResult : uint8_t { READABLE, TIMEOUT, FAILED };
+  WaitResult wait_readable(uint32_t timeout_ms);
+  bool receive(uint8_t *buffer, size_t capacity, size_t &size,
+               CFXSyncSource &source);
+#endif
+
  protected:
+  static constexpr size_t MAX_GROUPS = 4;
+  static constexpr uint32_t GROUP_JOIN_RETRY_MS = 5000;
+
+  struct Group {
+    uint32_t address{0};
+    bool joined{false};
+  };
+
   void close_();
+  bool join_(Group &group);
   bool send_to_(uint32_t address, uint16_t port, const uint8_t *data,
                 size_t size);
 
@@ -47,6 +78,9 @@ class CFXSyncUDPTransport {
 #endif
   bool ready_{false};
   uint16_t port_{0};
+  Group groups_[MAX_GROUPS];
+  uint8_t group_count_{0};
+  uint32_t last_join_attempt_ms_{0};
 };
 
 }  // namespace cfx_sync
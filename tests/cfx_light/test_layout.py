@@ -0,0 +1,93 @@
+import unittest
+
+import esphome.config_validation as cv
+
+from components.cfx_light import light as cfx_light_component
+
+
+def validate(leds, **layout):
+    config = cfx_light_component.LAYOUT_SCHEMA(layout)
+    return cfx_light_component._validate_layout(config, leds, "segment 'test'")
+
+
+class CFXLightLayoutValidationTests(unittest.TestCase):
+    def assertRejected(self, message, leds, **layout):
+        with self.assertRaises(cv.Invalid) as ctx:
+            validate(leds, **layout)
+        self.assertIn(message, str(ctx.exception))
+
+    def test_type_is_inferred_from_the_keys(self):
+        self.assertEqual("linear", validate(10)["type"])
+        self.assertEqual("folded", validate(10, folds=2)["type"])
+        self.assertEqual("matrix", validate(10, width=5)["type"])
+        self.assertEqual("map", validate(10, map=[1, 0])["type"])
+
+    def test_fold_must_split_into_equal_legs(self):
+        validate(12, folds=3)
+        self.assertRejected("do not split into 2 equal legs", 9, folds=2)
+
+    def test_fold_counts_only_lit_leds(self):
+        validate(10, folds=2, gaps=[{"start": 4, "count": 2}])
+        self.assertRejected(
+            "do not split", 10, folds=2, gaps=[{"start": 4, "count": 1}]
+        )
+
+    def test_folded_layout_needs_folds(self):
+        self.assertRejected("needs 'folds'", 10, type="folded")
+
+    def test_gap_must_fit_the_run(self):
+        validate(10, gaps=[{"start": 8, "count": 2}])
+        self.assertRejected("runs past the 10 LEDs", 10, gaps=[{"start": 9, "count": 2}])
+
+    def test_gaps_must_not_overlap(self):
+        self.assertRejected(
+            "gaps overlap at LED 3",
+            10,
+            gaps=[{"start": 2, "count": 2}, {"start": 3, "count": 1}],
+        )
+
+    def test_gaps_must_leave_leds_lit(self):
+        self.assertRejected("leave no LEDs lit", 4, gaps=[{"start": 0, "count": 4}])
+
+    def test_serpentine_matrix(self):
+        config = validate(16, width=4, height=4, serpentine=True)
+        self.assertTrue(config["serpentine"])
+        validate(12, height=3, serpentine=True, vertical=True)
+
+    def test_serpentine_only_applies_to_a_matrix(self):
+        self.assertRejected("only apply to a matrix layout", 10, serpentine=True)
+        self.assertRejected("only apply to a matrix layout", 10, folds=2, vertical=True)
+
+    def test_matrix_size_must_match_the_lit_leds(self):
+        self.assertRejected("needs 12 lit LEDs", 10, width=4, height=3)
+        self.assertRejected("not a whole number of 4-LED lines", 10, width=4)
+
+    def test_linear_and_folded_have_no_grid(self):
+        self.assertRejected("has no width or height", 10, type="linear", width=5)
+        self.assertRejected("has no width or height", 10, folds=2, height=2)
+
+    def test_map(self):
+        validate(4, map=[3, 0, 2])
+        validate(4, map=[0, 1, 3, 2], width=2, height=2)
+
+    def test_map_entry_out_of_range(self):
+        self.assertRejected("map entry 4 is outside the 4 LEDs", 4, map=[0, 4])
+
+    def test_map_entries_must_be_unique(self):
+        self.assertRejected("must be unique", 4, map=[1, 1])
+
+    def test_map_grid_must_match_the_entries(self):
+        self.assertRejected("needs both width and height", 4, map=[0, 1], width=2)
+        self.assertRejected("width x height is 4", 4, map=[0, 1, 2], width=2, height=2)
+
+    def test_map_takes_no_gaps(self):
+        self.assertRejected(
+            "drop 'gaps'", 4, map=[0, 1], gaps=[{"start": 2, "count": 1}]
+        )
+
+    def test_map_needs_entries(self):
+        self.assertRejected("needs a 'map' list", 4, type="map")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,44 @@
+from pathlib import Path
+import re
+import unittest
+
+import esphome.config_validation as cv
+
+from components.cfx_light import light as cfx_light_component
+
+
+ROOT = Path(__file__).resolve().parents[2]
+LIMITS_HEADER = ROOT / "components" / "cfx_effect" / "cfx_limits.h"
+ARENA_HEADER = ROOT / "components" / "cfx_effect" / "cfx_data_arena.h"
+
+
+def lights(*segment_counts):
+    return [
+        {"segments": [{} for _ in range(count)]} if count else {}
+        for count in segment_counts
+    ]
+
+
+class CFXLightSegmentLimitTests(unittest.TestCase):
+    def test_node_total_up_to_the_limit_passes(self):
+        cfx_light_component._validate_segment_runners(lights(16, 15, 0))
+
+    def test_node_total_over_the_limit_is_rejected(self):
+        with self.assertRaises(cv.Invalid) as ctx:
+            cfx_light_component._validate_segment_runners(lights(16, 16, 0))
+        self.assertIn("33 segments in total", str(ctx.exception))
+
+    def test_cpp_default_matches_the_python_limit(self):
+        header = LIMITS_HEADER.read_text(encoding="utf-8")
+        match = re.search(r"#define MAX_CFX_SEGMENTS (\d+)", header)
+        self.assertIsNotNone(match)
+        self.assertEqual(int(match.group(1)), cfx_light_component.MAX_CFX_SEGMENTS)
+
+    def test_arena_pool_is_sized_from_the_limit(self):
+        arena = ARENA_HEADER.read_text(encoding="utf-8")
+        self.assertIn('#include "cfx_limits.h"', arena)
+        self.assertIn("POOL_SIZE = CFX_DATA_ARENA_SLOTS", arena)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -16,6 +16,9 @@ PACKET_HEADER = ROOT / "components" / "cfx_sync" / "cfx_sync_packet.h"
 PACKET_SOURCE = ROOT / "components" / "cfx_sync" / "cfx_sync_packet.cpp"
 COLOR_HEADER = ROOT / "components" / "cfx_sync" / "cfx_sync_color.h"
 EFFECT_HEADER = ROOT / "components" / "cfx_sync" / "cfx_sync_effect.h"
+GROUP_CLOCK_HEADER = (
+    ROOT / "components" / "cfx_sync" / "cfx_sync_group_clock.h"
+)
 CFX_BUTTON_PY = ROOT / "components" / "cfx_button" / "__init__.py"
 CFX_BUTTON_SYNC_HEADER = (
     ROOT / "components" / "cfx_button" / "cfx_button_sync_command.h"
@@ -349,7 +352,7 @@ class CFXSyncUDPTransportRuntimeTests(unittest.TestCase):
                 r"bool CFXSyncComponent::send_state_packet_to_followers_"
                 r"\(\s*std::vector<uint8_t> &packet\).*?"
                 r"if \(this->use_udp_transport_\(\)\).*?"
-                r"this->send_udp_packet_\(packet\).*?"
+                r"this->send_udp_follower_packet_\(packet\).*?"
                 r"this->udp_state_sent_\+\+.*?"
                 r"if \(this->use_espnow_transport_\(\)\).*?"
                 r"this->send_espnow_packet_to_\(BROADCAST_MAC, packet\).*?"
@@ -1139,7 +1142,9 @@ class ESPNowAPITests(unittest.TestCase):
         self.assertRegex(
             packet_source,
             re.compile(
-                r"uint32_t field_mask = FIELD_POWER \| FIELD_BRIGHTNESS;"
+                r"uint32_t field_mask = 0;"
+                r"\s*if \(has_power\) \{"
+                r"\s*field_mask \|= FIELD_POWER;"
                 r".*?if \(has_color\) \{"
                 r"\s*field_mask \|= FIELD_COLOR;"
                 r".*?if \(has_color_brightness\) \{"
@@ -1166,7 +1171,7 @@ class ESPNowAPITests(unittest.TestCase):
         self.assertIn("uint8_t warm_white{0};", packet_header)
         self.assertIn("MAX_COLOR_TEMPERATURE_VALUE_SIZE = 2", packet_header)
         self.assertIn("MAX_COLD_WARM_WHITE_VALUE_SIZE = 2", packet_header)
-        self.assertIn("MAX_STATE_PACKET_SIZE == 136", packet_header)
+        self.assertIn("MAX_STATE_PACKET_SIZE == 156", packet_header)
         self.assertIn("encode_state_snapshot", packet_header)
 
     def test_cfx_sync_packet_encodes_cct_fields_in_network_order(self):
@@ -2236,6 +2241,7 @@ class ESPNowAPITests(unittest.TestCase):
             source,
             re.compile(
                 r"bool CFXSyncComponent::send_heartbeat_state_\(\) \{"
+                r"\s*this->state_tx_\.request_full\(\);"
                 r"\s*return this->send_state_\(\);"
                 r"\s*\}",
                 re.DOTALL,
@@ -2275,7 +2281,7 @@ class ESPNowAPITests(unittest.TestCase):
         self.assertIn("FIELD_TRANSITION = 0x00000040UL", header)
         self.assertIn("FIELD_RAMP = 0x00000080UL", header)
         self.assertIn("MAX_TIMING_VALUE_SIZE = 4", header)
-        self.assertIn("MAX_STATE_PACKET_SIZE == 136", header)
+        self.assertIn("MAX_STATE_PACKET_SIZE == 156", header)
         self.assertIn("bool has_transition{false};", header)
         self.assertIn("uint16_t transition_ms{0};", header)
         self.assertIn("bool has_ramp{false};", header)
@@ -2343,6 +2349,225 @@ class ESPNowAPITests(unittest.TestCase):
         self.assertNotIn("#pragma pack", combined)
         self.assertNotIn("__attribute__((packed))", combined)
 
+    def test_packet_codec_encodes_into_fixed_buffers_with_cached_hmac_key(self):
+        header = PACKET_HEADER.read_text(encoding="utf-8")
+        source = PACKET_SOURCE.read_text(encoding="utf-8")
+        hmac_header = (PACKET_HEADER.parent / "cfx_sync_hmac.h").read_text(
+            encoding="utf-8"
+        )
+
+        self.assertIn("class CFXSyncPacketWriter {", header)
+        self.assertIn(
+            "static constexpr size_t MAX_PACKET_SIZE = MAX_PIXEL_FRAME_PACKET_SIZE;",
+            header,
+        )
+        for encoder in (
+            "encode_state_snapshot",
+            "encode_sync_request",
+            "encode_hello",
+            "encode_state_ack",
+            "encode_input_state",
+            "encode_light_command",
+            "encode_pixel_frame",
+        ):
+            self.assertRegex(
+                header,
+                re.compile(
+                    rf"static bool {encoder}\([^;]*CFXSyncPacketWriter &output\);",
+                    re.DOTALL,
+                ),
+            )
+        self.assertNotIn("std::vector<uint8_t> payload;", source)
+        self.assertNotIn("reserve(", source)
+
+        self.assertIn("class CFXSyncHmacKey {", hmac_header)
+        self.assertIn("static Slot slots[HMAC_KEY_SLOTS];", source)
+        self.assertIn("hmac_key_(key).sign(data, size, digest);", source)
+        self.assertNotIn("HmacSHA256", source)
+        self.assertNotIn("init(key", source)
+
+    def test_leader_state_broadcasts_are_paced_field_deltas(self):
+        header = HEADER.read_text(encoding="utf-8")
+        source = SOURCE.read_text(encoding="utf-8")
+        packet_header = PACKET_HEADER.read_text(encoding="utf-8")
+        state_tx = (PACKET_HEADER.parent / "cfx_sync_state_tx.h").read_text(
+            encoding="utf-8"
+        )
+        component = PY_COMPONENT.read_text(encoding="utf-8")
+
+        self.assertIn("static constexpr uint8_t FLAG_STATE_DELTA = 0x01;", packet_header)
+        self.assertIn("static bool encode_state_delta(", packet_header)
+        self.assertIn("class CFXSyncStateTx {", state_tx)
+        self.assertIn("CFXSyncStateTx state_tx_;", header)
+        self.assertRegex(
+            source,
+            re.compile(
+                r"const uint32_t wait_ms = this->state_tx_\.wait_ms\(now\);"
+                r"\s*if \(wait_ms != 0\) \{.*?"
+                r"this->state_tx_\.hold\(snapshot, effect, controls, timing\);"
+                r".*?this->set_timeout\(\"state-tx\", wait_ms,",
+                re.DOTALL,
+            ),
+        )
+        self.assertRegex(
+            source,
+            re.compile(
+                r"const bool full = fields == CFXSyncStateTx::FULL;"
+                r"\s*if \(full && !CFXSyncPacketCodec::encode_state_snapshot\(.*?"
+                r"if \(!full && !CFXSyncPacketCodec::encode_state_delta\(",
+                re.DOTALL,
+            ),
+        )
+        self.assertRegex(
+            source,
+            re.compile(
+                r"if \(\(packet\.flags & CFXSyncPacketCodec::FLAG_STATE_DELTA\) == 0\) \{"
+                r"\s*this->has_valid_state_ = true;",
+                re.DOTALL,
+            ),
+        )
+        self.assertGreaterEqual(
+            source.count("this->state_tx_.request_full();"), 5
+        )
+        self.assertIn('CONF_STATE_INTERVAL = "state_interval"', component)
+        self.assertIn("var.set_state_interval_ms(", component)
+
+    def test_peer_table_is_sized_by_config_and_hash_indexed(self):
+        header = HEADER.read_text(encoding="utf-8")
+        source = SOURCE.read_text(encoding="utf-8")
+        component = PY_COMPONENT.read_text(encoding="utf-8")
+
+        self.assertIn("std::vector<PeerState> peers_", header)
+        self.assertIn("std::array<uint8_t, PEER_INDEX_SIZE> peer_index_{};", header)
+        self.assertNotIn("CFX_SYNC_MAX_PEERS", header)
+        self.assertIn('CONF_MAX_PEERS = "max_peers"', component)
+        self.assertIn("var.set_max_peers(", component)
+        find_body = re.search(
+            r"PeerState \*CFXSyncComponent::find_peer_\(\s*"
+            r"const CFXSyncSource &source\) \{.*?\n\}\n",
+            source,
+            re.DOTALL,
+        )
+        self.assertIsNotNone(find_body)
+        self.assertIn("peer_hash_(source.transport", find_body.group(0))
+        self.assertIn("this->peer_index_[", find_body.group(0))
+        self.assertNotIn("for (auto &peer : this->peers_)", find_body.group(0))
+
+    def test_udp_receive_task_decodes_into_spsc_ring(self):
+        bus_header = BUS_HEADER.read_text(encoding="utf-8")
+        bus_source = BUS_SOURCE.read_text(encoding="utf-8")
+        packet_header = PACKET_HEADER.read_text(encoding="utf-8")
+        source = SOURCE.read_text(encoding="utf-8")
+        component = PY_COMPONENT.read_text(encoding="utf-8")
+        ring = (
+            ROOT / "components" / "cfx_sync" / "cfx_sync_rx_ring.h"
+        ).read_text(encoding="utf-8")
+
+        self.assertIn("template<typename T, size_t N> class CFXSyncRxRing", ring)
+        self.assertIn("std::memory_order_release", ring)
+        self.assertIn("const CFXSyncHmacKey &key,", packet_header)
+        self.assertIn("CFXSyncRxRing<RxSlot, RX_RING_SIZE>", bus_header)
+        self.assertIn('xTaskCreatePinnedToCore(rx_task_fn_, "cfx_sync_rx"', bus_source)
+        self.assertRegex(
+            bus_source,
+            re.compile(
+                r"bool CFXSyncBus::receive_batch_\(\) \{.*?"
+                r"taken < RX_BATCH.*?"
+                r"peek_group_hash.*?"
+                r"this->rx_keys_\[i\].*?"
+                r"this->rx_ring_->publish\(\);",
+                re.DOTALL,
+            ),
+        )
+        self.assertRegex(
+            bus_source,
+            re.compile(
+                r"void CFXSyncBus::rx_task_loop_\(\) \{.*?"
+                r"wait == WaitResult::TIMEOUT.*?"
+                r"RX_BACKOFF_MAX_MS.*?"
+                r"vTaskDelay\(pdMS_TO_TICKS\(backoff_ms\)\);",
+                re.DOTALL,
+            ),
+        )
+        self.assertRegex(
+            bus_source,
+            re.compile(
+                r"void CFXSyncBus::drain_rx_ring_\(\) \{.*?"
+                r"handled < RX_DRAIN_BATCH.*?"
+                r"this->dispatch_packet\(slot->source.*?"
+                r"handle_rx_packet_\(.*?"
+                r"this->rx_ring_->pop\(\);",
+                re.DOTALL,
+            ),
+        )
+        self.assertIn("this->rx_task_received_us_ != 0", source)
+        self.assertIn('CONF_RX_TASK = "rx_task"', component)
+        self.assertIn("var.set_rx_task(True)", component)
+
+    def test_per_peer_telemetry_feeds_sensors_and_services(self):
+        header = HEADER.read_text(encoding="utf-8")
+        source = SOURCE.read_text(encoding="utf-8")
+        component = PY_COMPONENT.read_text(encoding="utf-8")
+        telemetry = (
+            ROOT / "components" / "cfx_sync" / "cfx_sync_telemetry.h"
+        ).read_text(encoding="utf-8")
+
+        self.assertIn("class CFXSyncLatencyHistogram", telemetry)
+        self.assertIn("CFXSyncPeerStats stats;", header)
+        self.assertIn("peer.stats.stale++;", source)
+        self.assertIn("peer.stats.states_acked++;", source)
+        self.assertIn("peer.stats.state_retries++;", source)
+        self.assertRegex(
+            source,
+            re.compile(
+                r"void CFXSyncComponent::record_state_rtt_\(.*?"
+                r"peer\.stats\.state_rtt\.record\(.*?"
+                r"trip_us > TIMEBASE_MAX_RTT_US",
+                re.DOTALL,
+            ),
+        )
+        self.assertEqual(source.count("this->record_input_apply_(*peer,"), 2)
+        self.assertIn('"cfx_sync_peer_stats"', source)
+        self.assertIn('"cfx_sync_peer_stats_reset"', source)
+        self.assertIn('cg.add_define("USE_CFX_SYNC_TELEMETRY")', component)
+        self.assertIn("SERVICE_HANDLER_ID not in CORE.component_ids", component)
+
+    def test_udp_followers_join_group_multicast_and_ack_the_leader(self):
+        source = SOURCE.read_text(encoding="utf-8")
+        udp_header = UDP_HEADER.read_text(encoding="utf-8")
+        udp_source = UDP_SOURCE.read_text(encoding="utf-8")
+        packet_header = PACKET_HEADER.read_text(encoding="utf-8")
+
+        self.assertIn("static constexpr uint16_t CAP_UDP_GROUP = 0x0010U;", packet_header)
+        self.assertIn("static uint32_t group_address(uint32_t group_hash);", udp_header)
+        self.assertIn("IP_ADD_MEMBERSHIP", udp_source)
+        self.assertIn("igmp_joingroup(", udp_source)
+        self.assertIn(
+            "this->bus_->join_udp_group(this->udp_group_address_());", source
+        )
+        self.assertIn("capabilities |= CFXSyncPacketCodec::CAP_UDP_GROUP;", source)
+        self.assertRegex(
+            source,
+            re.compile(
+                r"bool CFXSyncComponent::send_udp_follower_packet_\(.*?"
+                r"if \(!this->followers_join_udp_group_\(\)\) \{"
+                r"\s*return this->send_udp_packet_\(packet\);.*?"
+                r"this->bus_->send_udp_group\(this->udp_group_address_\(\), packet\)",
+                re.DOTALL,
+            ),
+        )
+        self.assertIn("this->udp_group_disabled_ = true;", source)
+        self.assertRegex(
+            source,
+            re.compile(
+                r"bool CFXSyncComponent::send_state_ack_packet_\(.*?"
+                r"peer\.node_role == CFXSyncNodeRole::LEADER &&.*?"
+                r"return this->send_packet_to_peer_\(peer, ack\);.*?"
+                r"return this->send_packet_to_\(BROADCAST_MAC, ack\);",
+                re.DOTALL,
+            ),
+        )
+
     def test_color_helper_is_renderer_independent(self):
         text = COLOR_HEADER.read_text(encoding="utf-8")
 
@@ -2508,6 +2733,7 @@ class ESPNowAPITests(unittest.TestCase):
             source,
             re.compile(
                 r"bool CFXSyncComponent::send_heartbeat_state_\(\) \{"
+                r"\s*this->state_tx_\.request_full\(\);"
                 r"\s*return this->send_state_\(\);"
                 r"\s*\}",
                 re.DOTALL,
@@ -2572,7 +2798,7 @@ class ESPNowAPITests(unittest.TestCase):
                 r"bool CFXSyncComponent::send_state_to_followers_\(.*?"
                 r"CFXSyncPacketCodec::encode_state_snapshot\(.*?"
                 r"snapshot,\s*true,\s*effect,\s*"
-                r"controls\.has_any\(\),\s*controls,\s*timing,\s*"
+                r"controls\.has_any\(\),\s*controls,\s*timed,\s*"
                 r"this->key_,\s*packet",
                 re.DOTALL,
             ),
@@ -2646,9 +2872,12 @@ class ESPNowAPITests(unittest.TestCase):
         snapshot_encode = (
             "CFXSyncPacketCodec::encode_state_snapshot(\n"
             "          this->group_hash_, this->boot_id_, sequence, snapshot, true, effect,\n"
-            "          controls.has_any(), controls, timing, this->key_, packet)"
+            "          controls.has_any(), controls, timed, this->key_, packet)"
         )
         self.assertEqual(source.count(snapshot_encode), 2)
+        self.assertEqual(
+            source.count("const auto timed = this->with_timebase_(timing);"), 2
+        )
 
     def test_hello_and_sync_request_use_broadcast_state_response(self):
         source = SOURCE.read_text(encoding="utf-8")
@@ -2893,13 +3122,14 @@ class ESPNowAPITests(unittest.TestCase):
                 r"const uint32_t delay_ms\s*=\s*ACK_JITTER_MIN_MS \+"
                 r"\s*\(esp_random\(\) % \(ACK_JITTER_SPREAD_MS \+ 1\)\);.*?"
                 r"this->set_timeout\(\s*\"state-ack\",\s*delay_ms,\s*"
-                r"\[this, acked_boot_id, acked_sequence, result\]\(\) \{.*?"
+                r"\[this, acked_boot_id, acked_sequence, result, timed,\s*"
+                r"received_us\]\(\) \{.*?"
                 r"CFXSyncPacketCodec::encode_state_ack\("
                 r"\s*this->group_hash_,\s*this->boot_id_,\s*"
                 r"this->next_sequence_\(\),\s*"
-                r"acked_boot_id,\s*acked_sequence,\s*result,\s*"
-                r"this->key_,\s*ack\).*?"
-                r"this->send_packet_to_\(BROADCAST_MAC, ack\);",
+                r"acked_boot_id,\s*acked_sequence,\s*result,\s*timed,\s*"
+                r"hold_us,\s*this->key_,\s*ack\).*?"
+                r"this->send_state_ack_packet_\(ack\);",
                 re.DOTALL,
             ),
         )
@@ -3878,6 +4108,7 @@ class ESPNowAPITests(unittest.TestCase):
             "const bool manual = this->target_has_effect_(state);",
             dimmer_source,
         )
+        self.assertIn("return light_renders_preview(state);", dimmer_source)
         self.assertIn("this->ramp_manual_.push_back(manual);", dimmer_source)
         self.assertIn("publish_light_ramp_hint(state, now + duration);", dimmer_source)
         self.assertRegex(
@@ -4463,6 +4694,62 @@ class ESPNowAPITests(unittest.TestCase):
         self.assertGreater(register, no_transport)
         self.assertLess(register, discovery)
 
+    def test_pixel_stream_has_its_own_replay_window_and_yields_to_state(self):
+        header = HEADER.read_text(encoding="utf-8")
+        source = SOURCE.read_text(encoding="utf-8")
+        component = PY_COMPONENT.read_text(encoding="utf-8")
+
+        self.assertIn("uint32_t pixel_rx_sequence{0};", header)
+        self.assertRegex(
+            source,
+            re.compile(
+                r"packet\.type == CFXSyncPacketType::PIXEL_FRAME.*?"
+                r"peer->node_role != CFXSyncNodeRole::LEADER.*?"
+                r"accept_pixel_sequence_\(\*peer.*?"
+                r"Ignoring authenticated packet from unknown peer",
+                re.DOTALL,
+            ),
+        )
+        self.assertRegex(
+            source,
+            re.compile(
+                r"void CFXSyncComponent::pump_pixel_stream_\(\) \{.*?"
+                r"this->state_send_deferred_ \|\| "
+                r"this->pending_input_count_ != 0",
+                re.DOTALL,
+            ),
+        )
+        self.assertIn("CFXSyncPacketCodec::CAP_PIXEL_FOLLOWER", source)
+        self.assertIn('CONF_PIXEL_STREAM = "pixel_stream"', component)
+        self.assertIn("var.set_pixel_light(light_index)", component)
+
+    def test_followers_take_effect_epochs_before_applying_state(self):
+        header = HEADER.read_text(encoding="utf-8")
+        source = SOURCE.read_text(encoding="utf-8")
+        clock = GROUP_CLOCK_HEADER.read_text(encoding="utf-8")
+
+        self.assertIn('#include "cfx_sync_group_clock.h"', header)
+        self.assertIn("uint32_t rtt_us{0};", header)
+        self.assertRegex(
+            source,
+            re.compile(
+                r"this->handle_timebase_\(packet\);.*?"
+                r"const bool applied = this->apply_remote_state_\(packet\);",
+                re.DOTALL,
+            ),
+        )
+        self.assertRegex(
+            source,
+            re.compile(
+                r"void CFXSyncComponent::record_state_rtt_\(.*?"
+                r"peer\.last_state_sent_us = 0;.*?"
+                r"TIMEBASE_MAX_RTT_US",
+                re.DOTALL,
+            ),
+        )
+        self.assertIn("mutable portMUX_TYPE lock_", clock)
+        self.assertIn("bool restart(const void *key, uint64_t local_us);", clock)
+
     def test_oversized_udp_datagrams_are_dropped(self):
         source = UDP_SOURCE.read_text(encoding="utf-8")
 
@@ -12,8 +12,10 @@ TYPE_HELLO = 3
 TYPE_STATE_ACK = 4
 TYPE_INPUT_STATE = 5
 TYPE_LIGHT_COMMAND = 6
+TYPE_PIXEL_FRAME = 7
 HEADER_SIZE = 22
 TAG_SIZE = 16
+STATE_FLAG_DELTA = 0x01
 FIELD_POWER = 0x00000001
 FIELD_BRIGHTNESS = 0x00000002
 FIELD_COLOR = 0x00000004
@@ -22,6 +24,7 @@ FIELD_EFFECT = 0x00000010
 FIELD_CONTROLS = 0x00000020
 FIELD_TRANSITION = 0x00000040
 FIELD_RAMP = 0x00000080
+FIELD_TIMEBASE = 0x00000400
 COLOR_CAP_WHITE = 0x01
 EFFECT_NONE = 0
 EFFECT_CHIMERAFX = 1
@@ -63,10 +66,18 @@ COMMAND_FLAG_DIRECTION_DOWN = 0x08
 CAP_LIGHT_LEADER = 0x0001
 CAP_LIGHT_FOLLOWER = 0x0002
 CAP_BINARY_REMOTE = 0x0004
+CAP_PIXEL_FOLLOWER = 0x0008
+PIXEL_FLAG_LAST = 0x01
+PIXEL_FLAG_KEYFRAME = 0x02
+PIXEL_FLAG_WHITE = 0x04
+PIXEL_FRAME_HEADER_SIZE = 7
+MAX_PIXEL_DATA_SIZE = 204
+MAX_PIXEL_FRAME_PACKET_SIZE = 249
 MAX_EFFECT_NAME_BYTES = 64
 MAX_EFFECT_VALUE_SIZE = 67
 MAX_CONTROLS_VALUE_SIZE = 11
 MAX_TIMING_VALUE_SIZE = 4
+TIMEBASE_VALUE_SIZE = 20
 MAX_EFFECT_STATE_PACKET_SIZE = 117
 MAX_STATE_PACKET_SIZE = 132
 FULL_STATE_MASK = (
@@ -88,10 +99,11 @@ def encode(
     sequence=SEQUENCE,
     version=VERSION,
     key=KEY,
+    flags=0,
 ):
     header = (
         MAGIC
-        + bytes((version, packet_type, 0, HEADER_SIZE))
+        + bytes((version, packet_type, flags, HEADER_SIZE))
         + struct.pack(
             ">HIII", len(payload), group_hash, boot_id, sequence
         )
@@ -263,6 +275,7 @@ def decode(packet, expected_group_hash=GROUP_HASH):
 
     result = {
         "type": packet[5],
+        "flags": packet[6],
         "group_hash": group_hash,
         "boot_id": boot_id,
         "sequence": sequence,
@@ -465,6 +478,18 @@ def decode(packet, expected_group_hash=GROUP_HASH):
                 ">H", payload[offset:offset + 2]
             )[0]
             offset += 2
+        if result["field_mask"] & FIELD_TIMEBASE:
+            if offset + TIMEBASE_VALUE_SIZE > payload_size:
+                raise ValueError("timebase")
+            result["has_timebase"] = True
+            (
+                result["leader_us"],
+                result["delay_us"],
+                result["epoch_us"],
+            ) = struct.unpack(
+                ">QIQ", payload[offset:offset + TIMEBASE_VALUE_SIZE]
+            )
+            offset += TIMEBASE_VALUE_SIZE
         known_fields = (
             FIELD_POWER
             | FIELD_BRIGHTNESS
@@ -474,6 +499,7 @@ def decode(packet, expected_group_hash=GROUP_HASH):
             | FIELD_CONTROLS
             | FIELD_TRANSITION
             | FIELD_RAMP
+            | FIELD_TIMEBASE
         )
         if not result["field_mask"] & ~known_fields and offset != payload_size:
             raise ValueError("state-length")
@@ -495,9 +521,11 @@ def decode(packet, expected_group_hash=GROUP_HASH):
         result["node_role"] = role
         result["capabilities"] = struct.unpack(">H", payload[1:3])[0]
     elif packet[5] == TYPE_STATE_ACK:
-        if payload_size != 9:
+        if payload_size not in (9, 13):
             raise ValueError("ack-length")
         payload = packet[HEADER_SIZE:authenticated_size]
+        if payload_size == 13:
+            result["ack_hold_us"] = struct.unpack(">I", payload[9:13])[0]
         acked_boot_id, acked_sequence = struct.unpack(">II", payload[:8])
         ack_result = payload[8]
         if not acked_boot_id or not acked_sequence:
@@ -612,11 +640,40 @@ def decode(packet, expected_group_hash=GROUP_HASH):
             offset += 2
         if offset != len(payload):
             raise ValueError("command")
+    elif packet[5] == TYPE_PIXEL_FRAME:
+        payload = packet[HEADER_SIZE:authenticated_size]
+        if len(payload) <= PIXEL_FRAME_HEADER_SIZE:
+            raise ValueError("pixel")
+        frame, flags, led_count, first_led = struct.unpack(
+            ">HBHH", payload[:PIXEL_FRAME_HEADER_SIZE]
+        )
+        pixels = payload[PIXEL_FRAME_HEADER_SIZE:]
+        stride = 4 if flags & PIXEL_FLAG_WHITE else 3
+        if (
+            flags & ~(PIXEL_FLAG_LAST | PIXEL_FLAG_KEYFRAME | PIXEL_FLAG_WHITE)
+            or len(pixels) > MAX_PIXEL_DATA_SIZE
+            or len(pixels) % stride
+            or first_led + len(pixels) // stride > led_count
+        ):
+            raise ValueError("pixel")
+        result.update(
+            {
+                "pixel_frame": frame,
+                "pixel_flags": flags,
+                "pixel_led_count": led_count,
+                "pixel_first_led": first_led,
+                "pixel_data": pixels,
+            }
+        )
     else:
         raise ValueError("type")
     return result
 
 
+def pixel_frame_payload(frame, flags, led_count, first_led, pixels):
+    return struct.pack(">HBHH", frame, flags, led_count, first_led) + pixels
+
+
 class ReplayState:
     def __init__(self):
         self.boot_id = None
@@ -753,6 +810,58 @@ class ProtocolTests(unittest.TestCase):
                 with self.assertRaisesRegex(ValueError, "command"):
                     decode(encode(TYPE_LIGHT_COMMAND, payload))
 
+    def test_pixel_frame_vector_is_stable(self):
+        payload = pixel_frame_payload(
+            0x0102, PIXEL_FLAG_LAST | PIXEL_FLAG_KEYFRAME, 2, 0,
+            bytes.fromhex("ff0000" "00ff00"),
+        )
+        packet = encode(TYPE_PIXEL_FRAME, payload)
+        self.assertEqual(len(packet), HEADER_SIZE + 13 + TAG_SIZE)
+        self.assertEqual(
+            packet[:HEADER_SIZE + 13].hex(),
+            "434658530107001600"
+            "0d12345678a1b2c3d401020304"
+            "01020300020000ff000000ff00",
+        )
+        decoded = decode(packet)
+        self.assertEqual(decoded["type"], TYPE_PIXEL_FRAME)
+        self.assertEqual(decoded["pixel_frame"], 0x0102)
+        self.assertEqual(decoded["pixel_led_count"], 2)
+        self.assertEqual(decoded["pixel_first_led"], 0)
+        self.assertEqual(decoded["pixel_data"], bytes.fromhex("ff000000ff00"))
+
+    def test_full_pixel_chunk_fits_espnow(self):
+        self.assertEqual(MAX_PIXEL_DATA_SIZE % 3, 0)
+        self.assertEqual(MAX_PIXEL_DATA_SIZE % 4, 0)
+        for flags, stride in ((0, 3), (PIXEL_FLAG_WHITE, 4)):
+            with self.subTest(stride=stride):
+                count = MAX_PIXEL_DATA_SIZE // stride
+                packet = encode(
+                    TYPE_PIXEL_FRAME,
+                    pixel_frame_payload(
+                        1, flags, count * 2, count,
+                        bytes(MAX_PIXEL_DATA_SIZE),
+                    ),
+                )
+                self.assertEqual(len(packet), MAX_PIXEL_FRAME_PACKET_SIZE)
+                self.assertLess(len(packet), 250)
+                self.assertEqual(
+                    decode(packet)["pixel_first_led"], count
+                )
+
+    def test_malformed_pixel_frame_is_rejected(self):
+        for payload in (
+            pixel_frame_payload(1, 0, 4, 0, b""),
+            pixel_frame_payload(1, 0, 4, 0, bytes(4)),
+            pixel_frame_payload(1, PIXEL_FLAG_WHITE, 4, 0, bytes(6)),
+            pixel_frame_payload(1, 0x08, 4, 0, bytes(3)),
+            pixel_frame_payload(1, 0, 4, 3, bytes(6)),
+            pixel_frame_payload(1, 0, 100, 0, bytes(MAX_PIXEL_DATA_SIZE + 3)),
+        ):
+            with self.subTest(payload=payload.hex()):
+                with self.assertRaisesRegex(ValueError, "pixel"):
+                    decode(encode(TYPE_PIXEL_FRAME, payload))
+
     def test_hello_round_trips_role_and_capabilities(self):
         payload = bytes((ROLE_LEADER,)) + struct.pack(
             ">H", CAP_LIGHT_LEADER | CAP_BINARY_REMOTE
@@ -787,6 +896,19 @@ class ProtocolTests(unittest.TestCase):
         self.assertEqual(decoded["acked_sequence"], 0x55667788)
         self.assertEqual(decoded["ack_result"], ACK_IGNORED_UNSUPPORTED)
 
+    def test_timed_state_ack_carries_hold_time(self):
+        payload = struct.pack(
+            ">IIBI", 0x11223344, 0x55667788, ACK_APPLIED, 1850
+        )
+        packet = encode(TYPE_STATE_ACK, payload)
+        self.assertEqual(len(packet), 51)
+        decoded = decode(packet)
+        self.assertEqual(decoded["acked_sequence"], 0x55667788)
+        self.assertEqual(decoded["ack_hold_us"], 1850)
+        self.assertNotIn("ack_hold_us", decode(encode(
+            TYPE_STATE_ACK, payload[:9]
+        )))
+
     def test_hello_wrong_key_is_rejected(self):
         payload = bytes((ROLE_FOLLOWER,)) + struct.pack(
             ">H", CAP_LIGHT_FOLLOWER
@@ -1116,6 +1238,24 @@ class ProtocolTests(unittest.TestCase):
         )
         self.assertFalse(decoded["has_power"])
 
+    def test_state_delta_carries_only_changed_fields(self):
+        payload = struct.pack(
+            ">I", FIELD_POWER | FIELD_COLOR | FIELD_COLOR_BRIGHTNESS
+        ) + bytes((1, 0, 0x10, 0x20, 0x30, 0, 0xC0))
+        decoded = decode(
+            encode(TYPE_STATE, payload, flags=STATE_FLAG_DELTA)
+        )
+        self.assertEqual(decoded["flags"], STATE_FLAG_DELTA)
+        self.assertTrue(decoded["power"])
+        self.assertFalse(decoded["has_brightness"])
+        self.assertEqual(
+            (decoded["red"], decoded["green"], decoded["blue"]),
+            (0x10, 0x20, 0x30),
+        )
+        self.assertEqual(decoded["color_brightness"], 0xC0)
+        self.assertFalse(decoded["has_effect"])
+        self.assertFalse(decoded["has_controls"])
+
     def test_zero_boot_id_and_sequence_are_rejected(self):
         with self.assertRaisesRegex(ValueError, "replay-fields"):
             decode(encode(TYPE_SYNC_REQUEST, boot_id=0))
@@ -1257,6 +1397,28 @@ class ProtocolTests(unittest.TestCase):
                 with self.assertRaisesRegex(ValueError, message):
                     decode(encode(TYPE_STATE, payload))
 
+    def test_timebase_round_trips_after_timing(self):
+        payload = (
+            struct.pack(">I", FIELD_POWER | FIELD_RAMP | FIELD_TIMEBASE)
+            + b"\x01"
+            + struct.pack(">H", 400)
+            + struct.pack(">QIQ", 0x0102030405060708, 1200, 987654321)
+        )
+        decoded = decode(encode(TYPE_STATE, payload))
+        self.assertEqual(decoded["ramp_ms"], 400)
+        self.assertTrue(decoded["has_timebase"])
+        self.assertEqual(decoded["leader_us"], 0x0102030405060708)
+        self.assertEqual(decoded["delay_us"], 1200)
+        self.assertEqual(decoded["epoch_us"], 987654321)
+        self.assertEqual(
+            HEADER_SIZE + len(payload) + TAG_SIZE, 43 + 2 + TIMEBASE_VALUE_SIZE
+        )
+
+    def test_truncated_timebase_is_rejected(self):
+        payload = struct.pack(">I", FIELD_TIMEBASE) + bytes(19)
+        with self.assertRaisesRegex(ValueError, "timebase"):
+            decode(encode(TYPE_STATE, payload))
+
     def test_legacy_packet_without_controls_remains_valid(self):
         decoded = decode(
             encode(
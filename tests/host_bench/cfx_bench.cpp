@@ -0,0 +1,437 @@
+/*
+ * ChimeraFX — Host benchmark harness
+ * Copyright (c) 2026 Federico Leoni (effelle)
+ * Licensed under the EUPL-1.2
+ *
+ * Runs every registered mode through CFXRunner::service() against a mock
+ * AddressableLight and reports render cost (ns/pixel), heap allocations made
+ * while rendering and an FNV-1a checksum of every output frame.
+ *
+ * Time is simulated (one 60 FPS tick per frame) and both esp_random() and the
+ * runner's random stream are re-seeded per run, so checksums are
+ * reproducible: a changed checksum means the effect now draws different
+ * pixels. Timings are wall-clock and host-relative — use
+ * them to compare two builds on the same machine, not to predict ESP32 cost.
+ *
+ * With --repeat, every CFX_MODE_STATELESS mode is instead rendered twice per
+ * tick at the same `now` and the harness counts the ticks whose two frames
+ * differ; a stateless frame is a pure function of (now, params, pixel).
+ *
+ * With --governed, every mode runs twice, with and without the adaptive frame
+ * rate governor, and the harness counts the ticks the governor held and the
+ * rendered ticks whose frame differs from the ungoverned run; a mode that
+ * steps per call instead of by time drifts behind while it is governed.
+ *
+ * With --layout SPEC, the harness compiles one segment layout and prints its
+ * shape and gather table instead. SPEC is
+ * type:flags:width:height:folds:leds:mirror[:gaps[:map]] with gaps as
+ * start+count pairs and the map as LED indices, both '/'-separated.
+ *
+ * Built and driven by host_bench.py; see that file for usage.
+ */
+
+#include "CFXRunner.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using chimera_fx::CFXRunner;
+
+// ── Platform stubs ───────────────────────────────────────────────────────────
+
+static std::mt19937 g_rng(1);
+static int64_t g_fake_us = 0;
+
+uint32_t esp_random() { return g_rng(); }
+int64_t esp_timer_get_time() { return g_fake_us; }
+
+// ── Allocation accounting ────────────────────────────────────────────────────
+//
+// host_bench.py links with -Wl,--wrap=malloc,... on GNU toolchains so that
+// CFXRunner's direct malloc() calls (Segment::allocateData & co.) are seen.
+// operator new is always counted.
+
+static bool g_counting = false;
+// --palette: palette for every run instead of each mode's default.
+static int g_palette = -1;
+static uint32_t g_allocs = 0;
+static uint64_t g_alloc_bytes = 0;
+
+static inline void note_alloc(size_t n) {
+  if (g_counting) {
+    g_allocs++;
+    g_alloc_bytes += n;
+  }
+}
+
+#ifdef CFX_BENCH_WRAP_MALLOC
+extern "C" {
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t c, size_t n);
+void *__real_realloc(void *p, size_t n);
+void *__wrap_malloc(size_t n) {
+  note_alloc(n);
+  return __real_malloc(n);
+}
+void *__wrap_calloc(size_t c, size_t n) {
+  note_alloc(c * n);
+  return __real_calloc(c, n);
+}
+void *__wrap_realloc(void *p, size_t n) {
+  note_alloc(n);
+  return __real_realloc(p, n);
+}
+}
+#endif
+
+void *operator new(size_t n) {
+  note_alloc(n);
+  if (void *p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void *operator new[](size_t n) { return operator new(n); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+// ── Mock output ──────────────────────────────────────────────────────────────
+
+class MockLight : public light::AddressableLight {
+public:
+  explicit MockLight(int n) : buf(n * 4, 0) {}
+  int32_t size() const override { return (int32_t)(buf.size() / 4); }
+  mutable std::vector<uint8_t> buf;
+
+protected:
+  light::ESPColorView get_view_internal(int32_t i) const override {
+    uint8_t *p = &buf[i * 4];
+    return light::ESPColorView(p, p + 1, p + 2, p + 3);
+  }
+};
+
+// The random palette (254) salts its seed with the runner and light
+// addresses. Constructing both in fixed static storage (and linking
+// -no-pie) keeps those addresses, and so the checksums, stable.
+alignas(CFXRunner) static unsigned char g_runner_storage[sizeof(CFXRunner)];
+alignas(MockLight) static unsigned char g_light_storage[sizeof(MockLight)];
+
+// ── Benchmark ────────────────────────────────────────────────────────────────
+
+struct Result {
+  double ns_per_px;
+  uint32_t allocs;
+  uint64_t alloc_bytes;
+  uint64_t checksum;
+};
+
+static Result run_mode(uint8_t mode, int leds, int frames) {
+  const chimera_fx::ModeDescriptor &desc = chimera_fx::getModeDescriptor(mode);
+  g_rng.seed(1);
+  g_fake_us = 0;
+
+  MockLight *light = new (g_light_storage) MockLight(leds);
+  CFXRunner *runner = new (g_runner_storage) CFXRunner(light);
+  runner->seedRandom(1);
+  runner->setMode(mode);
+  runner->setSpeed(desc.default_speed);
+  runner->setIntensity(desc.default_intensity);
+  runner->setPalette(g_palette >= 0 ? (uint8_t)g_palette
+                                    : desc.default_palette);
+
+  Result res{};
+  uint64_t h = 1469598103934665603ull;
+  uint64_t render_ns = 0;
+
+  g_allocs = 0;
+  g_alloc_bytes = 0;
+  for (int f = 0; f < frames; f++) {
+    g_fake_us += 16667;
+    g_counting = true;
+    const auto t0 = std::chrono::steady_clock::now();
+    runner->service();
+    const auto t1 = std::chrono::steady_clock::now();
+    g_counting = false;
+    render_ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     t1 - t0)
+                     .count();
+    for (uint8_t b : light->buf) {
+      h ^= b;
+      h *= 1099511628211ull;
+    }
+  }
+
+  res.ns_per_px = (double)render_ns / ((double)frames * (double)leds);
+  res.allocs = g_allocs;
+  res.alloc_bytes = g_alloc_bytes;
+  res.checksum = h;
+
+  runner->~CFXRunner();
+  light->~MockLight();
+  return res;
+}
+
+// Ticks on which a second service() at the same `now` changed the output.
+static int repeat_mismatches(uint8_t mode, int leds, int frames) {
+  const chimera_fx::ModeDescriptor &desc = chimera_fx::getModeDescriptor(mode);
+  g_rng.seed(1);
+  g_fake_us = 0;
+
+  MockLight *light = new (g_light_storage) MockLight(leds);
+  CFXRunner *runner = new (g_runner_storage) CFXRunner(light);
+  runner->seedRandom(1);
+  runner->setMode(mode);
+  runner->setSpeed(desc.default_speed);
+  runner->setIntensity(desc.default_intensity);
+  runner->setPalette(desc.default_palette);
+
+  int mismatches = 0;
+  std::vector<uint8_t> first;
+  for (int f = 0; f < frames; f++) {
+    g_fake_us += 16667;
+    runner->service();
+    first = light->buf;
+    runner->service();
+    if (light->buf != first)
+      mismatches++;
+  }
+
+  runner->~CFXRunner();
+  light->~MockLight();
+  return mismatches;
+}
+
+// Builds the layout described by `spec` (see the header) and prints
+// "length width height<TAB>lut[0],lut[1],...".
+static int print_layout(const char *spec) {
+  std::vector<std::string> fields;
+  for (const char *s = spec;; s++) {
+    const char *colon = std::strchr(s, ':');
+    fields.emplace_back(s, colon != nullptr ? colon - s : std::strlen(s));
+    if (colon == nullptr)
+      break;
+    s = colon;
+  }
+  if (fields.size() < 7)
+    return 2;
+
+  std::vector<chimera_fx::CFXLayoutGap> gaps;
+  if (fields.size() > 7) {
+    for (const char *s = fields[7].c_str(); *s;) {
+      const char *plus = std::strchr(s, '+');
+      if (plus == nullptr)
+        break;
+      gaps.push_back({(uint16_t)std::atoi(s), (uint16_t)std::atoi(plus + 1)});
+      const char *slash = std::strchr(s, '/');
+      if (slash == nullptr)
+        break;
+      s = slash + 1;
+    }
+  }
+  std::vector<uint16_t> map;
+  if (fields.size() > 8) {
+    for (const char *s = fields[8].c_str(); *s;) {
+      map.push_back((uint16_t)std::atoi(s));
+      const char *slash = std::strchr(s, '/');
+      if (slash == nullptr)
+        break;
+      s = slash + 1;
+    }
+  }
+
+  const chimera_fx::CFXLayout layout = {
+      (uint8_t)std::atoi(fields[0].c_str()),
+      (uint8_t)std::atoi(fields[1].c_str()),
+      (uint16_t)std::atoi(fields[2].c_str()),
+      (uint16_t)std::atoi(fields[3].c_str()),
+      (uint16_t)std::atoi(fields[4].c_str()),
+      gaps.empty() ? nullptr : gaps.data(),
+      (uint16_t)gaps.size(),
+      map.empty() ? nullptr : map.data(),
+      (uint16_t)map.size(),
+  };
+  const uint16_t leds = (uint16_t)std::atoi(fields[5].c_str());
+  const bool mirror = std::atoi(fields[6].c_str()) != 0;
+  std::vector<uint16_t> lut(leds);
+  const chimera_fx::CFXLayoutShape shape =
+      chimera_fx::cfx_layout_build(layout, leds, mirror, lut.data());
+
+  std::printf("%u %u %u\t", shape.length, shape.width, shape.height);
+  for (uint16_t p = 0; p < leds; p++)
+    std::printf(p ? ",%u" : "%u", lut[p]);
+  std::printf("\n");
+  return 0;
+}
+
+struct GovernedResult {
+  int held;
+  int diverged;
+};
+
+// Frames of `mode`, one per tick, with the governor on or off; held ticks
+// are recorded as empty frames.
+static std::vector<std::vector<uint8_t>> governed_frames(uint8_t mode,
+                                                         int leds, int frames,
+                                                         bool governed) {
+  const chimera_fx::ModeDescriptor &desc = chimera_fx::getModeDescriptor(mode);
+  g_rng.seed(1);
+  g_fake_us = 0;
+
+  MockLight *light = new (g_light_storage) MockLight(leds);
+  CFXRunner *runner = new (g_runner_storage) CFXRunner(light);
+  runner->seedRandom(1);
+  runner->setAdaptiveFrameRate(governed);
+  runner->setMode(mode);
+  runner->setSpeed(desc.default_speed);
+  runner->setIntensity(desc.default_intensity);
+  runner->setPalette(desc.default_palette);
+
+  std::vector<std::vector<uint8_t>> out(frames);
+  for (int f = 0; f < frames; f++) {
+    g_fake_us += 16667;
+    runner->service();
+    if (!runner->frameHeld())
+      out[f] = light->buf;
+  }
+
+  runner->~CFXRunner();
+  light->~MockLight();
+  return out;
+}
+
+static GovernedResult governed_drift(uint8_t mode, int leds, int frames) {
+  const auto free_run = governed_frames(mode, leds, frames, false);
+  const auto governed = governed_frames(mode, leds, frames, true);
+  GovernedResult res{};
+  for (int f = 0; f < frames; f++) {
+    if (governed[f].empty())
+      res.held++;
+    else if (governed[f] != free_run[f])
+      res.diverged++;
+  }
+  return res;
+}
+
+static bool is_registered(uint8_t mode) {
+  return std::strcmp(chimera_fx::getModeDescriptor(mode).name, "Unknown") != 0;
+}
+
+static std::vector<int> parse_list(const char *s) {
+  std::vector<int> out;
+  while (*s) {
+    out.push_back(std::atoi(s));
+    const char *comma = std::strchr(s, ',');
+    if (comma == nullptr)
+      break;
+    s = comma + 1;
+  }
+  return out;
+}
+
+static void usage(const char *argv0) {
+  std::fprintf(stderr,
+               "usage: %s [--frames N] [--leds 60,300,...] [--modes 0,1,...] "
+               "[--palette N] [--repeat] [--governed] [--layout SPEC]\n",
+               argv0);
+}
+
+int main(int argc, char **argv) {
+  int frames = 300;
+  std::vector<int> leds = {60, 300, 1200, 3000};
+  std::vector<int> modes;
+  bool repeat = false;
+  bool governed = false;
+
+  for (int i = 1; i < argc; i++) {
+    const bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+      frames = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--leds") == 0 && has_value) {
+      leds = parse_list(argv[++i]);
+    } else if (std::strcmp(argv[i], "--modes") == 0 && has_value) {
+      modes = parse_list(argv[++i]);
+    } else if (std::strcmp(argv[i], "--palette") == 0 && has_value) {
+      g_palette = std::atoi(argv[++i]) & 0xFF;
+    } else if (std::strcmp(argv[i], "--repeat") == 0) {
+      repeat = true;
+    } else if (std::strcmp(argv[i], "--governed") == 0) {
+      governed = true;
+    } else if (std::strcmp(argv[i], "--layout") == 0 && has_value) {
+      return print_layout(argv[++i]);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (frames <= 0 || leds.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (modes.empty()) {
+    for (int m = 0; m < 256; m++) {
+      if (is_registered((uint8_t)m))
+        modes.push_back(m);
+    }
+  }
+
+  if (repeat) {
+    std::printf("mode\tname\tleds\tmismatches\n");
+    for (int m : modes) {
+      if (m < 0 || m > 255 || !is_registered((uint8_t)m))
+        continue;
+      const chimera_fx::ModeDescriptor &desc =
+          chimera_fx::getModeDescriptor((uint8_t)m);
+      if (!(desc.flags & CFX_MODE_STATELESS))
+        continue;
+      for (int n : leds) {
+        std::printf("%d\t%s\t%d\t%d\n", m, desc.name, n,
+                    repeat_mismatches((uint8_t)m, n, frames));
+      }
+    }
+    return 0;
+  }
+
+  if (governed) {
+    std::printf("mode\tname\tleds\theld\tdiverged\n");
+    for (int m : modes) {
+      if (m < 0 || m > 255 || !is_registered((uint8_t)m))
+        continue;
+      for (int n : leds) {
+        const GovernedResult r = governed_drift((uint8_t)m, n, frames);
+        std::printf("%d\t%s\t%d\t%d\t%d\n", m,
+                    chimera_fx::getModeDescriptor((uint8_t)m).name, n, r.held,
+                    r.diverged);
+      }
+    }
+    return 0;
+  }
+
+  // Tab-separated so host_bench.py (and diff) can consume it directly.
+  std::printf("mode\tname\tleds\tns_per_px\tallocs\talloc_bytes\tchecksum\n");
+  for (int m : modes) {
+    if (m < 0 || m > 255 || !is_registered((uint8_t)m)) {
+      std::fprintf(stderr, "unknown mode %d\n", m);
+      return 2;
+    }
+    for (int n : leds) {
+      if (n <= 0 || n > UINT16_MAX) {
+        std::fprintf(stderr, "bad LED count %d\n", n);
+        return 2;
+      }
+      const Result r = run_mode((uint8_t)m, n, frames);
+      std::printf("%d\t%s\t%d\t%.2f\t%u\t%llu\t%016llx\n", m,
+                  chimera_fx::getModeDescriptor((uint8_t)m).name, n,
+                  r.ns_per_px, r.allocs, (unsigned long long)r.alloc_bytes,
+                  (unsigned long long)r.checksum);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,231 @@
+"""Build and run the CFXRunner host benchmark.
+
+    python3 tests/host_bench/host_bench.py                    # full sweep
+    python3 tests/host_bench/host_bench.py --leds 300 --modes 38,64
+    python3 tests/host_bench/host_bench.py --save before.tsv
+    python3 tests/host_bench/host_bench.py --compare before.tsv
+
+--compare reports every checksum change (effect output differs) and every
+ns/pixel regression above --threshold percent. Timings only compare
+meaningfully between runs on the same machine.
+"""
+
+import argparse
+import os
+from pathlib import Path
+import platform
+import shutil
+import subprocess
+import sys
+
+HERE = Path(__file__).resolve().parent
+ROOT = HERE.parents[1]
+EFFECT_DIR = ROOT / "components" / "cfx_effect"
+STUBS_DIR = HERE / "stubs"
+SOURCES = (
+    HERE / "cfx_bench.cpp",
+    EFFECT_DIR / "CFXRunner.cpp",
+    EFFECT_DIR / "FastLED_Stub.cpp",
+    EFFECT_DIR / "cfx_data_arena.cpp",
+    EFFECT_DIR / "cfx_gamma.cpp",
+    EFFECT_DIR / "cfx_layout.cpp",
+    ROOT / "components" / "cfx_sync" / "cfx_sync_group_clock.cpp",
+)
+DEFAULT_BUILD_DIR = ROOT / "_gate_build" / "host_bench"
+
+
+def find_compiler():
+    for cxx in (os.environ.get("CXX"), "g++", "clang++", "c++"):
+        if cxx and shutil.which(cxx):
+            return cxx
+    return None
+
+
+def build(build_dir=DEFAULT_BUILD_DIR, cxx=None, opt="-O2"):
+    """Compile the harness; returns the binary path. Raises on failure."""
+    cxx = cxx or find_compiler()
+    if cxx is None:
+        raise RuntimeError("no C++ compiler found (set CXX)")
+    build_dir = Path(build_dir)
+    build_dir.mkdir(parents=True, exist_ok=True)
+    binary = build_dir / "cfx_bench"
+
+    cmd = [
+        cxx,
+        "-std=gnu++20",
+        opt,
+        "-I", str(STUBS_DIR),
+        "-I", str(EFFECT_DIR),
+        *[str(s) for s in SOURCES],
+        "-o", str(binary),
+    ]
+    if platform.system() == "Linux":
+        # Fixed addresses keep the random palette's seed (and checksums)
+        # stable; --wrap lets the harness count CFXRunner's malloc() calls.
+        cmd += [
+            "-no-pie",
+            "-DCFX_BENCH_WRAP_MALLOC",
+            "-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc",
+        ]
+    subprocess.run(cmd, check=True)
+    return binary
+
+
+def run(binary, frames=None, leds=None, modes=None, palette=None):
+    """Run the harness; returns a list of row dicts. `palette` replaces each
+    mode's default palette."""
+    cmd = [str(binary)]
+    if frames is not None:
+        cmd += ["--frames", str(frames)]
+    if leds:
+        cmd += ["--leds", ",".join(str(n) for n in leds)]
+    if modes:
+        cmd += ["--modes", ",".join(str(m) for m in modes)]
+    if palette is not None:
+        cmd += ["--palette", str(palette)]
+    out = subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+    return parse(out)
+
+
+def run_repeat(binary, frames=None, leds=None):
+    """Render every stateless mode twice per tick; returns row dicts whose
+    "mismatches" counts the ticks where the two frames differed."""
+    cmd = [str(binary), "--repeat"]
+    if frames is not None:
+        cmd += ["--frames", str(frames)]
+    if leds:
+        cmd += ["--leds", ",".join(str(n) for n in leds)]
+    out = subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+    lines = [line for line in out.splitlines() if line.strip()]
+    header = lines[0].split("\t")
+    rows = []
+    for line in lines[1:]:
+        row = dict(zip(header, line.split("\t")))
+        for key in ("mode", "leds", "mismatches"):
+            row[key] = int(row[key])
+        rows.append(row)
+    return rows
+
+
+def run_governed(binary, frames=None, leds=None):
+    """Run every mode with and without the frame governor; returns row dicts
+    with the ticks it held and the rendered ticks that differ."""
+    cmd = [str(binary), "--governed"]
+    if frames is not None:
+        cmd += ["--frames", str(frames)]
+    if leds:
+        cmd += ["--leds", ",".join(str(n) for n in leds)]
+    out = subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+    lines = [line for line in out.splitlines() if line.strip()]
+    header = lines[0].split("\t")
+    rows = []
+    for line in lines[1:]:
+        row = dict(zip(header, line.split("\t")))
+        for key in ("mode", "leds", "held", "diverged"):
+            row[key] = int(row[key])
+        rows.append(row)
+    return rows
+
+
+def run_layout(binary, leds, type=0, flags=0, width=0, height=0, folds=0,
+               mirror=False, gaps=(), mapping=()):
+    """Compile one segment layout; returns ((length, width, height), lut).
+    Arguments mirror the CFXLayout fields (cfx_effect/cfx_layout.h)."""
+    spec = ":".join(
+        str(v) for v in (type, flags, width, height, folds, leds, int(mirror))
+    )
+    spec += ":" + "/".join(f"{start}+{count}" for start, count in gaps)
+    spec += ":" + "/".join(str(led) for led in mapping)
+    out = subprocess.run(
+        [str(binary), "--layout", spec], check=True, capture_output=True, text=True
+    ).stdout
+    shape, lut = out.strip().split("\t")
+    return (
+        tuple(int(v) for v in shape.split()),
+        [int(v) for v in lut.split(",")] if lut else [],
+    )
+
+
+def parse(text):
+    lines = [line for line in text.splitlines() if line.strip()]
+    header = lines[0].split("\t")
+    rows = []
+    for line in lines[1:]:
+        row = dict(zip(header, line.split("\t")))
+        row["mode"] = int(row["mode"])
+        row["leds"] = int(row["leds"])
+        row["ns_per_px"] = float(row["ns_per_px"])
+        row["allocs"] = int(row["allocs"])
+        row["alloc_bytes"] = int(row["alloc_bytes"])
+        rows.append(row)
+    return rows
+
+
+def format_rows(rows):
+    header = "mode\tname\tleds\tns_per_px\tallocs\talloc_bytes\tchecksum"
+    body = [
+        f"{r['mode']}\t{r['name']}\t{r['leds']}\t{r['ns_per_px']:.2f}\t"
+        f"{r['allocs']}\t{r['alloc_bytes']}\t{r['checksum']}"
+        for r in rows
+    ]
+    return "\n".join([header, *body]) + "\n"
+
+
+def compare(baseline, current, threshold):
+    """Returns (checksum_changes, regressions) as lists of strings."""
+    base = {(r["mode"], r["leds"]): r for r in baseline}
+    changed, slower = [], []
+    for r in current:
+        b = base.get((r["mode"], r["leds"]))
+        if b is None:
+            continue
+        label = f"{r['mode']:3d} {r['name']} @{r['leds']}"
+        if b["checksum"] != r["checksum"]:
+            changed.append(f"{label}: {b['checksum']} -> {r['checksum']}")
+        if b["ns_per_px"] > 0:
+            delta = (r["ns_per_px"] - b["ns_per_px"]) / b["ns_per_px"] * 100.0
+            if delta > threshold:
+                slower.append(
+                    f"{label}: {b['ns_per_px']:.2f} -> {r['ns_per_px']:.2f} "
+                    f"ns/px (+{delta:.0f}%)"
+                )
+    return changed, slower
+
+
+def _int_list(value):
+    return [int(v) for v in value.split(",") if v]
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--frames", type=int, default=300)
+    parser.add_argument("--leds", type=_int_list, default=[60, 300, 1200, 3000])
+    parser.add_argument("--modes", type=_int_list, default=None)
+    parser.add_argument("--build-dir", default=str(DEFAULT_BUILD_DIR))
+    parser.add_argument("--save", help="write results as TSV")
+    parser.add_argument("--compare", help="baseline TSV from --save")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="ns/pixel regression to report, in percent")
+    args = parser.parse_args(argv)
+
+    binary = build(args.build_dir)
+    rows = run(binary, args.frames, args.leds, args.modes)
+    text = format_rows(rows)
+    sys.stdout.write(text)
+    if args.save:
+        Path(args.save).write_text(text, encoding="utf-8")
+
+    if args.compare:
+        baseline = parse(Path(args.compare).read_text(encoding="utf-8"))
+        changed, slower = compare(baseline, rows, args.threshold)
+        for line in changed:
+            print(f"CHECKSUM {line}")
+        for line in slower:
+            print(f"SLOWER   {line}")
+        if changed or slower:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
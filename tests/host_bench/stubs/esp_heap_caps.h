@@ -0,0 +1,11 @@
+// Host stub of <esp_heap_caps.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#define MALLOC_CAP_8BIT 1
+#define MALLOC_CAP_INTERNAL 2
+#define MALLOC_CAP_SPIRAM 4
+#define MALLOC_CAP_DMA 8
+inline void *heap_caps_malloc(size_t n, uint32_t) { return malloc(n); }
+inline size_t heap_caps_get_free_size(uint32_t) { return 1 << 20; }
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return 1 << 19; }
@@ -0,0 +1,4 @@
+// Host stub of <esp_random.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include <cstdint>
+uint32_t esp_random();
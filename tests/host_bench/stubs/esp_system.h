@@ -0,0 +1,4 @@
+// Host stub of <esp_system.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include <cstdint>
+inline uint32_t esp_get_free_heap_size() { return 1 << 20; }
@@ -0,0 +1,4 @@
+// Host stub of <esp_timer.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include <cstdint>
+int64_t esp_timer_get_time();
@@ -0,0 +1,23 @@
+// Host stub of <esphome/components/light/addressable_light.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include "esphome/core/color.h"
+#include <cstdint>
+namespace esphome { namespace light {
+class ESPColorView {
+ public:
+  ESPColorView(uint8_t *r, uint8_t *g, uint8_t *b, uint8_t *w) : r_(r), g_(g), b_(b), w_(w) {}
+  ESPColorView &operator=(const Color &c) { *r_ = c.r; *g_ = c.g; *b_ = c.b; if (w_) *w_ = c.w; return *this; }
+  Color get() const { return Color(*r_, *g_, *b_, w_ ? *w_ : 0); }
+  void set_rgbw(uint8_t r, uint8_t g, uint8_t b, uint8_t w) { *this = Color(r, g, b, w); }
+ private:
+  uint8_t *r_, *g_, *b_, *w_;
+};
+class AddressableLight {
+ public:
+  virtual ~AddressableLight() = default;
+  virtual int32_t size() const = 0;
+  ESPColorView operator[](int32_t index) const { return this->get_view_internal(index); }
+ protected:
+  virtual ESPColorView get_view_internal(int32_t index) const = 0;
+};
+}}
@@ -0,0 +1,16 @@
+// Host stub of <esphome/core/color.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include <cstdint>
+namespace esphome {
+struct Color {
+  union { struct { uint8_t r, g, b, w; }; uint8_t raw[4]; uint32_t raw_32; };
+  constexpr Color() : r(0), g(0), b(0), w(0) {}
+  constexpr Color(uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) : r(r), g(g), b(b), w(w) {}
+  bool operator==(const Color &o) const { return raw_32 == o.raw_32; }
+  bool operator!=(const Color &o) const { return raw_32 != o.raw_32; }
+  static const Color BLACK;
+  static const Color WHITE;
+};
+inline const Color Color::BLACK(0, 0, 0, 0);
+inline const Color Color::WHITE(255, 255, 255, 255);
+}
@@ -0,0 +1,13 @@
+// Host stub of <esphome/core/log.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstring>
+#define ESP_LOGE(tag, ...) do { (void)(tag); } while (0)
+#define ESP_LOGW(tag, ...) do { (void)(tag); } while (0)
+#define ESP_LOGI(tag, ...) do { (void)(tag); } while (0)
+#define ESP_LOGD(tag, ...) do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, ...) do { (void)(tag); } while (0)
+#define ESP_LOGVV(tag, ...) do { (void)(tag); } while (0)
+#define ESP_LOGCONFIG(tag, ...) do { (void)(tag); } while (0)
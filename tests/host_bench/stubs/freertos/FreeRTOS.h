@@ -0,0 +1,10 @@
+// Host stub of <freertos/FreeRTOS.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include <cstdint>
+typedef uint32_t TickType_t;
+#define pdMS_TO_TICKS(x) (x)
+inline int xPortGetCoreID() { return 1; }
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(m) ((void)(m))
+#define portEXIT_CRITICAL(m) ((void)(m))
@@ -0,0 +1,5 @@
+// Host stub of <freertos/task.h> for tests/host_bench. Only what CFXRunner uses.
+#pragma once
+#include "FreeRTOS.h"
+inline void vTaskDelay(TickType_t) {}
+#define taskYIELD() do {} while (0)
@@ -0,0 +1,267 @@
+from pathlib import Path
+import sys
+import tempfile
+import unittest
+
+if __package__:
+    from . import host_bench
+else:
+    sys.path.insert(0, str(Path(__file__).resolve().parent))
+    import host_bench
+
+
+GOLDEN = Path(__file__).resolve().parent / "golden_checksums.tsv"
+GOLDEN_FRAMES = 120
+GOLDEN_LEDS = (60, 300)
+# Every mode once more on palette 0 ("Default"), which modes either resolve
+# to their own preset or leave to the rainbow fallback.
+GOLDEN_PALETTE0 = Path(__file__).resolve().parent / "golden_palette0.tsv"
+GOLDEN_PALETTE0_LEDS = (60,)
+RAINBOW_PALETTE = 4
+
+
+_build = None
+
+
+def setUpModule():
+    global _build
+    if host_bench.find_compiler() is None:
+        return
+    _build = tempfile.TemporaryDirectory()
+    _build.binary = host_bench.build(_build.name, opt="-O1")
+
+
+def tearDownModule():
+    if _build is not None:
+        _build.cleanup()
+
+
+def load_golden(path=GOLDEN):
+    golden = {}
+    for line in path.read_text(encoding="utf-8").splitlines()[1:]:
+        mode, leds, checksum = line.split("\t")
+        golden[(int(mode), int(leds))] = checksum
+    return golden
+
+
+@unittest.skipIf(host_bench.find_compiler() is None, "no host C++ compiler")
+class HostBenchGoldenFrameTests(unittest.TestCase):
+    """Every mode must keep drawing the same pixels unless the golden file is
+    regenerated on purpose:
+
+        python3 tests/host_bench/test_host_bench.py --regenerate
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        cls.rows = host_bench.run(_build.binary, GOLDEN_FRAMES, GOLDEN_LEDS)
+
+    def test_every_registered_mode_is_golden(self):
+        golden = load_golden()
+        current = {(r["mode"], r["leds"]) for r in self.rows}
+        self.assertEqual(set(golden), current)
+
+    def test_checksums_match_golden_frames(self):
+        golden = load_golden()
+        changed = [
+            f"{r['mode']} {r['name']} @{r['leds']}: "
+            f"{golden[(r['mode'], r['leds'])]} -> {r['checksum']}"
+            for r in self.rows
+            if golden.get((r["mode"], r["leds"])) not in (None, r["checksum"])
+        ]
+        self.assertEqual([], changed)
+
+
+@unittest.skipIf(host_bench.find_compiler() is None, "no host C++ compiler")
+class HostBenchStatelessModeTests(unittest.TestCase):
+    """A CFX_MODE_STATELESS frame depends only on now, the parameters and the
+    pixel, so rendering it a second time at the same now changes nothing."""
+
+    def test_stateless_modes_repeat_at_the_same_now(self):
+        rows = host_bench.run_repeat(_build.binary, GOLDEN_FRAMES, GOLDEN_LEDS)
+        self.assertTrue(rows)
+        drifting = [
+            f"{r['mode']} {r['name']} @{r['leds']}: {r['mismatches']} frames"
+            for r in rows
+            if r["mismatches"]
+        ]
+        self.assertEqual([], drifting)
+
+
+@unittest.skipIf(host_bench.find_compiler() is None, "no host C++ compiler")
+class HostBenchPaletteZeroTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.rows = host_bench.run(
+            _build.binary, GOLDEN_FRAMES, GOLDEN_PALETTE0_LEDS, palette=0
+        )
+
+    def test_checksums_match_golden_frames(self):
+        golden = load_golden(GOLDEN_PALETTE0)
+        self.assertEqual(set(golden), {(r["mode"], r["leds"]) for r in self.rows})
+        changed = [
+            f"{r['mode']} {r['name']} @{r['leds']}: "
+            f"{golden[(r['mode'], r['leds'])]} -> {r['checksum']}"
+            for r in self.rows
+            if golden.get((r["mode"], r["leds"])) not in (None, r["checksum"])
+        ]
+        self.assertEqual([], changed)
+
+    def test_unresolved_default_palette_falls_back_to_rainbow(self):
+        # Interference samples Segment::color_from_palette() without
+        # resolving palette 0 itself.
+        interference = 180
+        rows = [
+            host_bench.run(
+                _build.binary, GOLDEN_FRAMES, GOLDEN_PALETTE0_LEDS,
+                modes=[interference], palette=palette,
+            )[0]["checksum"]
+            for palette in (0, RAINBOW_PALETTE)
+        ]
+        self.assertEqual(rows[0], rows[1])
+
+
+@unittest.skipIf(host_bench.find_compiler() is None, "no host C++ compiler")
+class HostBenchGovernorTests(unittest.TestCase):
+    """The frame governor may hold ticks, but each frame it renders must be
+    the one the ungoverned runner draws at the same time: a mode that steps
+    per call would fall behind and has to be CFX_MODE_FULL_RATE."""
+
+    FRAMES = 600  # 10 s, long enough for the divisor to reach its maximum
+
+    @classmethod
+    def setUpClass(cls):
+        cls.rows = host_bench.run_governed(_build.binary, cls.FRAMES, GOLDEN_LEDS)
+
+    def test_governor_holds_quiet_modes(self):
+        # Solid and Breathe settle; otherwise the comparison below is empty.
+        held = {r["mode"] for r in self.rows if r["held"]}
+        self.assertTrue({0, 2} <= held)
+
+    def test_governed_frames_match_the_free_running_ones(self):
+        drifting = [
+            f"{r['mode']} {r['name']} @{r['leds']}: {r['diverged']} frames "
+            f"off after {r['held']} held"
+            for r in self.rows
+            if r["held"] and r["diverged"]
+        ]
+        self.assertEqual([], drifting)
+
+    def test_per_call_phase_modes_are_never_held(self):
+        phased, bpm = 105, 68
+        held = {
+            (r["mode"], r["leds"]): r["held"]
+            for r in self.rows
+            if r["mode"] in (phased, bpm)
+        }
+        self.assertEqual(2 * len(GOLDEN_LEDS), len(held))
+        self.assertEqual({0}, set(held.values()))
+
+
+# CFXLayoutType / CFXLayoutFlag (cfx_effect/cfx_layout.h).
+LINEAR, MATRIX, FOLDED, MAP = range(4)
+SERPENTINE, VERTICAL = 1, 2
+
+
+@unittest.skipIf(host_bench.find_compiler() is None, "no host C++ compiler")
+class HostBenchLayoutTests(unittest.TestCase):
+    """cfx_layout_build(): the logical pixel each LED shows, with the blank
+    slot (== length) for LEDs that show nothing."""
+
+    def layout(self, leds, **kwargs):
+        return host_bench.run_layout(_build.binary, leds, **kwargs)
+
+    def test_plain_run_is_identity(self):
+        self.assertEqual(((5, 5, 1), [0, 1, 2, 3, 4]), self.layout(5))
+
+    def test_mirror_reverses_the_row(self):
+        self.assertEqual(((4, 4, 1), [3, 2, 1, 0]), self.layout(4, mirror=True))
+
+    def test_gaps_are_skipped_and_blank(self):
+        shape, lut = self.layout(6, gaps=[(2, 2)])
+        self.assertEqual((4, 4, 1), shape)
+        self.assertEqual([0, 1, 4, 4, 2, 3], lut)
+
+    def test_mirror_skips_gaps(self):
+        _, lut = self.layout(6, gaps=[(2, 2)], mirror=True)
+        self.assertEqual([3, 2, 4, 4, 1, 0], lut)
+
+    def test_gap_past_the_segment_is_clipped(self):
+        shape, lut = self.layout(4, gaps=[(3, 5)])
+        self.assertEqual((3, 3, 1), shape)
+        self.assertEqual([0, 1, 2, 3], lut)
+
+    def test_fold_folds_each_leg_back(self):
+        shape, lut = self.layout(8, type=FOLDED, folds=2)
+        self.assertEqual((4, 4, 1), shape)
+        self.assertEqual([0, 1, 2, 3, 3, 2, 1, 0], lut)
+
+    def test_fold_leftover_leds_are_blank(self):
+        shape, lut = self.layout(7, type=FOLDED, folds=3)
+        self.assertEqual((2, 2, 1), shape)
+        self.assertEqual([0, 1, 1, 0, 0, 1, 2], lut)
+
+    def test_matrix_rows(self):
+        shape, lut = self.layout(6, type=MATRIX, width=3, height=2)
+        self.assertEqual((6, 3, 2), shape)
+        self.assertEqual([0, 1, 2, 3, 4, 5], lut)
+
+    def test_serpentine_matrix_reverses_odd_rows(self):
+        _, lut = self.layout(6, type=MATRIX, flags=SERPENTINE, width=3, height=2)
+        self.assertEqual([0, 1, 2, 5, 4, 3], lut)
+
+    def test_vertical_serpentine_matrix_reverses_odd_columns(self):
+        _, lut = self.layout(
+            6, type=MATRIX, flags=SERPENTINE | VERTICAL, width=2, height=3
+        )
+        self.assertEqual([0, 2, 4, 5, 3, 1], lut)
+
+    def test_matrix_side_from_segment_length(self):
+        shape, _ = self.layout(12, type=MATRIX, width=4)
+        self.assertEqual((12, 4, 3), shape)
+
+    def test_mirrored_matrix_reverses_x_only(self):
+        _, lut = self.layout(6, type=MATRIX, width=3, height=2, mirror=True)
+        self.assertEqual([2, 1, 0, 5, 4, 3], lut)
+
+    def test_map_places_each_pixel(self):
+        shape, lut = self.layout(4, type=MAP, mapping=[3, 0, 2])
+        self.assertEqual((3, 3, 1), shape)
+        self.assertEqual([1, 3, 2, 0], lut)
+
+    def test_map_with_grid(self):
+        shape, lut = self.layout(
+            4, type=MAP, width=2, height=2, mapping=[0, 1, 3, 2]
+        )
+        self.assertEqual((4, 2, 2), shape)
+        self.assertEqual([0, 1, 3, 2], lut)
+
+    def test_map_entries_outside_the_segment_are_dropped(self):
+        shape, lut = self.layout(3, type=MAP, mapping=[5, 0])
+        self.assertEqual((2, 2, 1), shape)
+        self.assertEqual([1, 2, 2], lut)
+
+
+def write_golden(path, rows):
+    lines = ["mode\tleds\tchecksum"]
+    lines += [f"{r['mode']}\t{r['leds']}\t{r['checksum']}" for r in rows]
+    path.write_text("\n".join(lines) + "\n", encoding="utf-8")
+
+
+def regenerate():
+    with tempfile.TemporaryDirectory() as tmp:
+        binary = host_bench.build(tmp, opt="-O1")
+        write_golden(GOLDEN, host_bench.run(binary, GOLDEN_FRAMES, GOLDEN_LEDS))
+        write_golden(
+            GOLDEN_PALETTE0,
+            host_bench.run(
+                binary, GOLDEN_FRAMES, GOLDEN_PALETTE0_LEDS, palette=0
+            ),
+        )
+
+
+if __name__ == "__main__":
+    if "--regenerate" in sys.argv:
+        regenerate()
+    else:
+        unittest.main()